@@ -472,6 +472,7 @@
         'debug/leak_tracker_unittest.cc',
         'debug/proc_maps_linux_unittest.cc',
         'debug/stack_trace_unittest.cc',
+        'debug/trace_event_binary_unittest.cc',
         'debug/trace_event_memory_unittest.cc',
         'debug/trace_event_synthetic_delay_unittest.cc',
         'debug/trace_event_system_stats_monitor_unittest.cc',
@@ -540,6 +541,7 @@
         'message_loop/message_pump_glib_unittest.cc',
         'message_loop/message_pump_io_ios_unittest.cc',
         'message_loop/message_pump_libevent_unittest.cc',
+        'message_loop/timer_wheel_unittest.cc',
         'metrics/sample_map_unittest.cc',
         'metrics/sample_vector_unittest.cc',
         'metrics/bucket_ranges_unittest.cc',
@@ -833,6 +835,22 @@
         'i18n/streaming_utf8_validator_perftest.cc',
       ],
     },
+    {
+      'target_name': 'base_perftests',
+      'type': '<(gtest_target_type)',
+      'dependencies': [
+        'base',
+        'test_support_base',
+        'test_support_perf',
+        '../testing/gtest.gyp:gtest',
+        '../testing/perf/perf_test.gyp:perf_test',
+      ],
+      'sources': [
+        'json/json_perftest.cc',
+        'message_loop/incoming_task_queue_perftest.cc',
+        'threading/sequenced_worker_pool_perftest.cc',
+      ],
+    },
     {
       'target_name': 'test_support_base',
       'type': 'static_library',
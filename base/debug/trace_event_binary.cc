@@ -0,0 +1,512 @@
+// Copyright 2014 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "base/debug/trace_event_binary.h"
+
+#include <string.h>
+
+#include "base/debug/trace_event.h"
+#include "base/debug/trace_event_impl.h"
+#include "base/format_macros.h"
+#include "base/logging.h"
+#include "base/strings/stringprintf.h"
+
+namespace base {
+namespace debug {
+
+namespace {
+
+const char kMagic[] = "TEVB";
+const size_t kMagicLength = arraysize(kMagic) - 1;
+const uint8 kVersion = 1;
+
+const uint8 kStringRecord = 1;
+const uint8 kEventRecord = 2;
+
+// Bits of the <fields> byte of an event record.
+const uint8 kHasThreadTimestamp = 1 << 0;
+const uint8 kHasDuration = 1 << 1;
+const uint8 kHasThreadDuration = 1 << 2;
+const uint8 kHasId = 1 << 3;
+
+void WriteByte(uint8 value, std::string* out) {
+  out->push_back(static_cast<char>(value));
+}
+
+void WriteVarint(uint64 value, std::string* out) {
+  while (value >= 0x80) {
+    out->push_back(static_cast<char>((value & 0x7f) | 0x80));
+    value >>= 7;
+  }
+  out->push_back(static_cast<char>(value));
+}
+
+// Signed values are zigzag encoded, so that small negative numbers also get a
+// short encoding.
+void WriteSignedVarint(int64 value, std::string* out) {
+  WriteVarint((static_cast<uint64>(value) << 1) ^
+                  static_cast<uint64>(value >> 63),
+              out);
+}
+
+void WriteBytes(const char* data, size_t length, std::string* out) {
+  WriteVarint(length, out);
+  out->append(data, length);
+}
+
+bool ReadByte(const char** pos, const char* end, uint8* value) {
+  if (*pos == end)
+    return false;
+  *value = static_cast<uint8>(**pos);
+  ++*pos;
+  return true;
+}
+
+bool ReadVarint(const char** pos, const char* end, uint64* value) {
+  uint64 result = 0;
+  for (int shift = 0; shift < 64; shift += 7) {
+    if (*pos == end)
+      return false;
+    uint8 byte = static_cast<uint8>(**pos);
+    ++*pos;
+    result |= static_cast<uint64>(byte & 0x7f) << shift;
+    if (!(byte & 0x80)) {
+      *value = result;
+      return true;
+    }
+  }
+  return false;
+}
+
+bool ReadSignedVarint(const char** pos, const char* end, int64* value) {
+  uint64 zigzag;
+  if (!ReadVarint(pos, end, &zigzag))
+    return false;
+  *value = static_cast<int64>(zigzag >> 1) ^ -static_cast<int64>(zigzag & 1);
+  return true;
+}
+
+bool ReadBytes(const char** pos, const char* end, StringPiece* bytes) {
+  uint64 length;
+  if (!ReadVarint(pos, end, &length) ||
+      length > static_cast<uint64>(end - *pos)) {
+    return false;
+  }
+  bytes->set(*pos, static_cast<size_t>(length));
+  *pos += length;
+  return true;
+}
+
+}  // namespace
+
+////////////////////////////////////////////////////////////////////////////////
+//
+// TraceEventBinaryWriter
+//
+////////////////////////////////////////////////////////////////////////////////
+
+TraceEventBinaryWriter::TraceEventBinaryWriter(int process_id)
+    : process_id_(process_id),
+      wrote_header_(false),
+      last_timestamp_(0),
+      last_thread_timestamp_(0),
+      next_string_id_(1) {
+}
+
+TraceEventBinaryWriter::~TraceEventBinaryWriter() {
+}
+
+void TraceEventBinaryWriter::AppendChunk(const TraceBufferChunk& chunk,
+                                         std::string* out) {
+  for (size_t i = 0; i < chunk.size(); ++i)
+    AppendEvent(*chunk.GetEventAt(i), out);
+}
+
+void TraceEventBinaryWriter::AppendEvent(const TraceEvent& event,
+                                         std::string* out) {
+  if (!wrote_header_) {
+    out->append(kMagic, kMagicLength);
+    WriteByte(kVersion, out);
+    WriteSignedVarint(process_id_, out);
+    wrote_header_ = true;
+  }
+
+  // The string records have to come before the event record that uses them.
+  bool copy = !!(event.flags_ & TRACE_EVENT_FLAG_COPY);
+  uint32 category_id = InternString(
+      TraceLog::GetCategoryGroupName(event.category_group_enabled_), true, out);
+  uint32 name_id = InternString(event.name_, !copy, out);
+  uint32 arg_name_ids[kTraceMaxNumArgs];
+  int num_args = 0;
+  for (; num_args < kTraceMaxNumArgs && event.arg_names_[num_args]; ++num_args)
+    arg_name_ids[num_args] = InternString(event.arg_names_[num_args], !copy,
+                                          out);
+
+  uint8 fields = 0;
+  if (!event.thread_timestamp_.is_null())
+    fields |= kHasThreadTimestamp;
+  if (event.phase_ == TRACE_EVENT_PHASE_COMPLETE) {
+    if (event.duration_.ToInternalValue() != -1)
+      fields |= kHasDuration;
+    if ((fields & kHasThreadTimestamp) &&
+        event.thread_duration_.ToInternalValue() != -1) {
+      fields |= kHasThreadDuration;
+    }
+  }
+  if (event.flags_ & TRACE_EVENT_FLAG_HAS_ID)
+    fields |= kHasId;
+
+  WriteByte(kEventRecord, out);
+  WriteVarint(category_id, out);
+  WriteVarint(name_id, out);
+  WriteByte(static_cast<uint8>(event.phase_), out);
+  WriteByte(event.flags_, out);
+  WriteByte(fields, out);
+  WriteSignedVarint(event.thread_id_, out);
+
+  int64 timestamp = event.timestamp_.ToInternalValue();
+  WriteSignedVarint(timestamp - last_timestamp_, out);
+  last_timestamp_ = timestamp;
+  if (fields & kHasThreadTimestamp) {
+    int64 thread_timestamp = event.thread_timestamp_.ToInternalValue();
+    WriteSignedVarint(thread_timestamp - last_thread_timestamp_, out);
+    last_thread_timestamp_ = thread_timestamp;
+  }
+  if (fields & kHasDuration)
+    WriteSignedVarint(event.duration_.ToInternalValue(), out);
+  if (fields & kHasThreadDuration)
+    WriteSignedVarint(event.thread_duration_.ToInternalValue(), out);
+  if (fields & kHasId)
+    WriteVarint(event.id_, out);
+
+  WriteByte(static_cast<uint8>(num_args), out);
+  for (int i = 0; i < num_args; ++i) {
+    unsigned char type = event.arg_types_[i];
+    const TraceEvent::TraceValue& value = event.arg_values_[i];
+    WriteVarint(arg_name_ids[i], out);
+    WriteByte(type, out);
+    switch (type) {
+      case TRACE_VALUE_TYPE_BOOL:
+        WriteByte(value.as_bool ? 1 : 0, out);
+        break;
+      case TRACE_VALUE_TYPE_UINT:
+        WriteVarint(value.as_uint, out);
+        break;
+      case TRACE_VALUE_TYPE_INT:
+        WriteSignedVarint(value.as_int, out);
+        break;
+      case TRACE_VALUE_TYPE_DOUBLE:
+        out->append(reinterpret_cast<const char*>(&value.as_double),
+                    sizeof(value.as_double));
+        break;
+      case TRACE_VALUE_TYPE_POINTER:
+        WriteVarint(reinterpret_cast<uintptr_t>(value.as_pointer), out);
+        break;
+      case TRACE_VALUE_TYPE_STRING:
+      case TRACE_VALUE_TYPE_COPY_STRING:
+        // The length is offset by one so that zero can stand for NULL.
+        if (value.as_string) {
+          size_t length = strlen(value.as_string);
+          WriteVarint(length + 1, out);
+          out->append(value.as_string, length);
+        } else {
+          WriteVarint(0, out);
+        }
+        break;
+      case TRACE_VALUE_TYPE_CONVERTABLE: {
+        std::string json;
+        event.convertable_values_[i]->AppendAsTraceFormat(&json);
+        WriteBytes(json.data(), json.size(), out);
+        break;
+      }
+      default:
+        NOTREACHED() << "Don't know how to write this value";
+        break;
+    }
+  }
+}
+
+uint32 TraceEventBinaryWriter::InternString(const char* str,
+                                            bool is_static,
+                                            std::string* out) {
+  if (is_static) {
+    std::map<const char*, uint32>::const_iterator it =
+        static_string_ids_.find(str);
+    if (it != static_string_ids_.end())
+      return it->second;
+  }
+
+  std::pair<hash_map<std::string, uint32>::iterator, bool> inserted =
+      string_ids_.insert(std::make_pair(std::string(str), next_string_id_));
+  uint32 id = inserted.first->second;
+  if (inserted.second) {
+    ++next_string_id_;
+    WriteByte(kStringRecord, out);
+    WriteVarint(id, out);
+    WriteBytes(inserted.first->first.data(), inserted.first->first.size(),
+               out);
+  }
+  if (is_static)
+    static_string_ids_[str] = id;
+  return id;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+//
+// TraceEventBinaryReader
+//
+////////////////////////////////////////////////////////////////////////////////
+
+TraceEventBinaryReader::TraceEventBinaryReader()
+    : read_header_(false),
+      failed_(false),
+      process_id_(0),
+      last_timestamp_(0),
+      last_thread_timestamp_(0),
+      strings_(1) {
+}
+
+TraceEventBinaryReader::~TraceEventBinaryReader() {
+}
+
+bool TraceEventBinaryReader::AppendAsJSON(const StringPiece& data,
+                                          std::string* out) {
+  if (failed_)
+    return false;
+
+  const char* pos = data.data();
+  const char* end = pos + data.size();
+  if (!read_header_ && pos != end) {
+    if (!ReadHeader(&pos, end)) {
+      failed_ = true;
+      return false;
+    }
+    read_header_ = true;
+  }
+
+  bool first_event = true;
+  while (pos != end) {
+    uint8 record_type = 0;
+    ReadByte(&pos, end, &record_type);
+    bool ok = false;
+    if (record_type == kStringRecord) {
+      ok = ReadString(&pos, end);
+    } else if (record_type == kEventRecord) {
+      if (!first_event)
+        out->push_back(',');
+      first_event = false;
+      ok = ReadEvent(&pos, end, out);
+    }
+    if (!ok) {
+      failed_ = true;
+      return false;
+    }
+  }
+  return true;
+}
+
+bool TraceEventBinaryReader::ReadHeader(const char** pos, const char* end) {
+  if (static_cast<size_t>(end - *pos) < kMagicLength ||
+      memcmp(*pos, kMagic, kMagicLength) != 0) {
+    return false;
+  }
+  *pos += kMagicLength;
+
+  uint8 version;
+  int64 process_id;
+  if (!ReadByte(pos, end, &version) || version != kVersion ||
+      !ReadSignedVarint(pos, end, &process_id)) {
+    return false;
+  }
+  process_id_ = static_cast<int>(process_id);
+  return true;
+}
+
+bool TraceEventBinaryReader::ReadString(const char** pos, const char* end) {
+  uint64 id;
+  StringPiece str;
+  // Ids are assigned in order, so each new string simply goes at the end.
+  if (!ReadVarint(pos, end, &id) || id != strings_.size() ||
+      !ReadBytes(pos, end, &str)) {
+    return false;
+  }
+  strings_.push_back(str.as_string());
+  return true;
+}
+
+bool TraceEventBinaryReader::ReadEvent(const char** pos,
+                                       const char* end,
+                                       std::string* out) {
+  uint64 category_id;
+  uint64 name_id;
+  uint8 phase;
+  uint8 flags;
+  uint8 fields;
+  int64 thread_id;
+  int64 timestamp_delta;
+  if (!ReadVarint(pos, end, &category_id) ||
+      !ReadVarint(pos, end, &name_id) ||
+      !ReadByte(pos, end, &phase) ||
+      !ReadByte(pos, end, &flags) ||
+      !ReadByte(pos, end, &fields) ||
+      !ReadSignedVarint(pos, end, &thread_id) ||
+      !ReadSignedVarint(pos, end, &timestamp_delta)) {
+    return false;
+  }
+  const std::string* category = GetString(category_id);
+  const std::string* name = GetString(name_id);
+  if (!category || !name)
+    return false;
+  last_timestamp_ += timestamp_delta;
+
+  int64 duration = 0;
+  int64 thread_duration = 0;
+  uint64 id = 0;
+  if (fields & kHasThreadTimestamp) {
+    int64 thread_timestamp_delta;
+    if (!ReadSignedVarint(pos, end, &thread_timestamp_delta))
+      return false;
+    last_thread_timestamp_ += thread_timestamp_delta;
+  }
+  if (((fields & kHasDuration) && !ReadSignedVarint(pos, end, &duration)) ||
+      ((fields & kHasThreadDuration) &&
+       !ReadSignedVarint(pos, end, &thread_duration)) ||
+      ((fields & kHasId) && !ReadVarint(pos, end, &id))) {
+    return false;
+  }
+
+  StringAppendF(out,
+      "{\"cat\":\"%s\",\"pid\":%i,\"tid\":%i,\"ts\":%" PRId64 ","
+      "\"ph\":\"%c\",\"name\":\"%s\",\"args\":{",
+      category->c_str(),
+      process_id_,
+      static_cast<int>(thread_id),
+      last_timestamp_,
+      phase,
+      name->c_str());
+
+  uint8 num_args;
+  if (!ReadByte(pos, end, &num_args) || num_args > kTraceMaxNumArgs)
+    return false;
+  for (int i = 0; i < num_args; ++i) {
+    uint64 arg_name_id;
+    uint8 type;
+    if (!ReadVarint(pos, end, &arg_name_id) || !ReadByte(pos, end, &type))
+      return false;
+    const std::string* arg_name = GetString(arg_name_id);
+    if (!arg_name)
+      return false;
+    if (i > 0)
+      *out += ",";
+    *out += "\"";
+    *out += *arg_name;
+    *out += "\":";
+
+    TraceEvent::TraceValue value;
+    std::string string_value;
+    switch (type) {
+      case TRACE_VALUE_TYPE_BOOL: {
+        uint8 as_bool;
+        if (!ReadByte(pos, end, &as_bool))
+          return false;
+        value.as_bool = !!as_bool;
+        break;
+      }
+      case TRACE_VALUE_TYPE_UINT: {
+        uint64 as_uint;
+        if (!ReadVarint(pos, end, &as_uint))
+          return false;
+        value.as_uint = as_uint;
+        break;
+      }
+      case TRACE_VALUE_TYPE_INT: {
+        int64 as_int;
+        if (!ReadSignedVarint(pos, end, &as_int))
+          return false;
+        value.as_int = as_int;
+        break;
+      }
+      case TRACE_VALUE_TYPE_DOUBLE:
+        if (static_cast<size_t>(end - *pos) < sizeof(value.as_double))
+          return false;
+        memcpy(&value.as_double, *pos, sizeof(value.as_double));
+        *pos += sizeof(value.as_double);
+        break;
+      case TRACE_VALUE_TYPE_POINTER: {
+        uint64 as_pointer;
+        if (!ReadVarint(pos, end, &as_pointer))
+          return false;
+        value.as_pointer =
+            reinterpret_cast<const void*>(static_cast<uintptr_t>(as_pointer));
+        break;
+      }
+      case TRACE_VALUE_TYPE_STRING:
+      case TRACE_VALUE_TYPE_COPY_STRING: {
+        uint64 length_plus_one;
+        if (!ReadVarint(pos, end, &length_plus_one) ||
+            length_plus_one > static_cast<uint64>(end - *pos) + 1) {
+          return false;
+        }
+        value.as_string = NULL;
+        if (length_plus_one) {
+          string_value.assign(*pos, static_cast<size_t>(length_plus_one - 1));
+          *pos += length_plus_one - 1;
+          value.as_string = string_value.c_str();
+        }
+        break;
+      }
+      case TRACE_VALUE_TYPE_CONVERTABLE: {
+        // Convertable values were already written in the trace format.
+        StringPiece json;
+        if (!ReadBytes(pos, end, &json))
+          return false;
+        json.AppendToString(out);
+        continue;
+      }
+      default:
+        return false;
+    }
+    TraceEvent::AppendValueAsJSON(type, value, out);
+  }
+  *out += "}";
+
+  if (fields & kHasDuration)
+    StringAppendF(out, ",\"dur\":%" PRId64, duration);
+  if (fields & kHasThreadDuration)
+    StringAppendF(out, ",\"tdur\":%" PRId64, thread_duration);
+  if (fields & kHasThreadTimestamp)
+    StringAppendF(out, ",\"tts\":%" PRId64, last_thread_timestamp_);
+  if (fields & kHasId)
+    StringAppendF(out, ",\"id\":\"0x%" PRIx64 "\"", id);
+
+  if (phase == TRACE_EVENT_PHASE_INSTANT) {
+    char scope = '?';
+    switch (flags & TRACE_EVENT_FLAG_SCOPE_MASK) {
+      case TRACE_EVENT_SCOPE_GLOBAL:
+        scope = TRACE_EVENT_SCOPE_NAME_GLOBAL;
+        break;
+
+      case TRACE_EVENT_SCOPE_PROCESS:
+        scope = TRACE_EVENT_SCOPE_NAME_PROCESS;
+        break;
+
+      case TRACE_EVENT_SCOPE_THREAD:
+        scope = TRACE_EVENT_SCOPE_NAME_THREAD;
+        break;
+    }
+    StringAppendF(out, ",\"s\":\"%c\"", scope);
+  }
+
+  *out += "}";
+  return true;
+}
+
+const std::string* TraceEventBinaryReader::GetString(uint64 id) const {
+  if (id == 0 || id >= strings_.size())
+    return NULL;
+  return &strings_[id];
+}
+
+}  // namespace debug
+}  // namespace base
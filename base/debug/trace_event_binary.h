@@ -0,0 +1,115 @@
+// Copyright 2014 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+// A compact binary encoding of trace events, used by TraceLog::Flush() when
+// tracing with TraceLog::BINARY_OUTPUT. It is typically several times smaller
+// than the JSON trace format and much cheaper to produce.
+//
+// A stream starts with a header and is followed by a sequence of records:
+//
+//   header:  "TEVB" <version:u8> <pid:svarint>
+//   string:  kStringRecord <id:varint> <length:varint> <bytes>
+//   event:   kEventRecord <category:varint> <name:varint> <phase:u8>
+//            <flags:u8> <fields:u8> <tid:svarint> <ts delta:svarint>
+//            [<tts delta:svarint>] [<dur:svarint>] [<tdur:svarint>]
+//            [<id:varint>] <num args:u8> { <name:varint> <type:u8> <value> }
+//
+// Category group, event and argument names are interned: each distinct string
+// is written once in a string record, the first time it is used, and events
+// refer to it by id. Timestamps are stored as the difference from the
+// previous event's timestamp, so they usually take two or three bytes. The
+// optional fields are present when the corresponding bit of <fields> is set.
+//
+// The stream written by one TraceEventBinaryWriter has to be read, in order,
+// by one TraceEventBinaryReader, but it may be split between any two records.
+// TraceLog hands it out one TraceBufferChunk at a time.
+
+#ifndef BASE_DEBUG_TRACE_EVENT_BINARY_H_
+#define BASE_DEBUG_TRACE_EVENT_BINARY_H_
+
+#include <map>
+#include <string>
+#include <vector>
+
+#include "base/base_export.h"
+#include "base/basictypes.h"
+#include "base/containers/hash_tables.h"
+#include "base/strings/string_piece.h"
+
+namespace base {
+namespace debug {
+
+class TraceBufferChunk;
+class TraceEvent;
+
+class BASE_EXPORT TraceEventBinaryWriter {
+ public:
+  // |process_id| is written in the header, and is reported for all the events
+  // when they are converted to JSON.
+  explicit TraceEventBinaryWriter(int process_id);
+  ~TraceEventBinaryWriter();
+
+  // Appends the records for the events in |chunk| to |out|, preceded by the
+  // header if nothing has been written yet.
+  void AppendChunk(const TraceBufferChunk& chunk, std::string* out);
+
+  // Appends the records for |event| to |out|, preceded by the header if
+  // nothing has been written yet.
+  void AppendEvent(const TraceEvent& event, std::string* out);
+
+ private:
+  // Returns the id of |str|, first appending a string record for it if it
+  // hasn't been written before. |is_static| means that |str| lives until the
+  // end of the trace, which allows it to be looked up by address.
+  uint32 InternString(const char* str, bool is_static, std::string* out);
+
+  const int process_id_;
+  bool wrote_header_;
+  int64 last_timestamp_;
+  int64 last_thread_timestamp_;
+
+  // Ids of the strings written so far. Most names are string literals, which
+  // are found in |static_string_ids_| by address, without reading them.
+  std::map<const char*, uint32> static_string_ids_;
+  hash_map<std::string, uint32> string_ids_;
+  uint32 next_string_id_;
+
+  DISALLOW_COPY_AND_ASSIGN(TraceEventBinaryWriter);
+};
+
+// Converts a binary trace back to the JSON trace format, as produced by
+// TraceEvent::AppendAsJSON().
+class BASE_EXPORT TraceEventBinaryReader {
+ public:
+  TraceEventBinaryReader();
+  ~TraceEventBinaryReader();
+
+  // Appends the JSON for the events in |data|, which has to be the next part
+  // of the stream and end on a record boundary, to |out|. The events are
+  // separated by commas, as in the fragments that TraceResultBuffer expects.
+  // Returns false if |data| is malformed; the reader can't be used after that.
+  bool AppendAsJSON(const StringPiece& data, std::string* out);
+
+ private:
+  bool ReadHeader(const char** pos, const char* end);
+  bool ReadString(const char** pos, const char* end);
+  bool ReadEvent(const char** pos, const char* end, std::string* out);
+  const std::string* GetString(uint64 id) const;
+
+  bool read_header_;
+  bool failed_;
+  int process_id_;
+  int64 last_timestamp_;
+  int64 last_thread_timestamp_;
+
+  // Indexed by string id. Id 0 is never assigned.
+  std::vector<std::string> strings_;
+
+  DISALLOW_COPY_AND_ASSIGN(TraceEventBinaryReader);
+};
+
+}  // namespace debug
+}  // namespace base
+
+#endif  // BASE_DEBUG_TRACE_EVENT_BINARY_H_
@@ -0,0 +1,195 @@
+// Copyright 2014 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "base/debug/trace_event_binary.h"
+
+#include <limits>
+#include <string>
+
+#include "base/at_exit.h"
+#include "base/debug/trace_event.h"
+#include "base/debug/trace_event_impl.h"
+#include "base/memory/ref_counted.h"
+#include "base/memory/scoped_ptr.h"
+#include "base/time/time.h"
+#include "testing/gtest/include/gtest/gtest.h"
+
+namespace base {
+namespace debug {
+
+namespace {
+
+class TestConvertable : public ConvertableToTraceFormat {
+ public:
+  TestConvertable() {}
+
+  virtual void AppendAsTraceFormat(std::string* out) const OVERRIDE {
+    out->append("{\"nested\":[1,2]}");
+  }
+
+ private:
+  virtual ~TestConvertable() {}
+
+  DISALLOW_COPY_AND_ASSIGN(TestConvertable);
+};
+
+unsigned long long DoubleArg(double value) {
+  TraceEvent::TraceValue trace_value;
+  trace_value.as_uint = 0;
+  trace_value.as_double = value;
+  return trace_value.as_uint;
+}
+
+unsigned long long StringArg(const char* value) {
+  TraceEvent::TraceValue trace_value;
+  trace_value.as_uint = 0;
+  trace_value.as_string = value;
+  return trace_value.as_uint;
+}
+
+class TraceEventBinaryTest : public testing::Test {
+ protected:
+  virtual void SetUp() OVERRIDE {
+    TraceLog::DeleteForTesting();
+    TraceLog::GetInstance()->SetProcessID(1234);
+    category_ = TraceLog::GetCategoryGroupEnabled("binary,test");
+  }
+
+  virtual void TearDown() OVERRIDE {
+    TraceLog::DeleteForTesting();
+  }
+
+  // Fills |chunk| with events covering all the argument types and optional
+  // fields.
+  void FillChunk(TraceBufferChunk* chunk) {
+    TimeTicks now = TimeTicks::FromInternalValue(1000000);
+    const char* arg_names[] = { "a", "b" };
+    size_t index;
+
+    unsigned char int_types[] = { TRACE_VALUE_TYPE_INT,
+                                  TRACE_VALUE_TYPE_UINT };
+    unsigned long long int_values[] = {
+        static_cast<unsigned long long>(-42),
+        std::numeric_limits<unsigned long long>::max() };
+    chunk->AddTraceEvent(&index)->Initialize(
+        7, now, TimeTicks(), TRACE_EVENT_PHASE_BEGIN, category_, "ints", 0,
+        2, arg_names, int_types, int_values, NULL, TRACE_EVENT_FLAG_NONE);
+
+    unsigned char mixed_types[] = { TRACE_VALUE_TYPE_DOUBLE,
+                                    TRACE_VALUE_TYPE_STRING };
+    unsigned long long mixed_values[] = { DoubleArg(-0.25),
+                                          StringArg("quote \" and \xC3\xA9") };
+    chunk->AddTraceEvent(&index)->Initialize(
+        7, now - TimeDelta::FromMicroseconds(5), TimeTicks(),
+        TRACE_EVENT_PHASE_INSTANT, category_, "mixed", 0, 2, arg_names,
+        mixed_types, mixed_values, NULL,
+        TRACE_EVENT_FLAG_COPY | TRACE_EVENT_SCOPE_PROCESS);
+
+    unsigned char other_types[] = { TRACE_VALUE_TYPE_BOOL,
+                                    TRACE_VALUE_TYPE_POINTER };
+    unsigned long long other_values[] = { 1, 0xdeadbeef };
+    chunk->AddTraceEvent(&index)->Initialize(
+        -3, now + TimeDelta::FromSeconds(3), TimeTicks(),
+        TRACE_EVENT_PHASE_ASYNC_BEGIN, category_, "async", 0x1234567890ULL,
+        2, arg_names, other_types, other_values, NULL,
+        TRACE_EVENT_FLAG_HAS_ID);
+
+    unsigned char convertable_types[] = { TRACE_VALUE_TYPE_CONVERTABLE,
+                                          TRACE_VALUE_TYPE_STRING };
+    unsigned long long convertable_values[] = { 0, StringArg(NULL) };
+    scoped_refptr<ConvertableToTraceFormat> convertables[] = {
+        new TestConvertable, NULL };
+    TraceEvent* complete = chunk->AddTraceEvent(&index);
+    complete->Initialize(
+        8, now, TimeTicks::FromInternalValue(500), TRACE_EVENT_PHASE_COMPLETE,
+        category_, "complete", 0, 2, arg_names, convertable_types,
+        convertable_values, convertables, TRACE_EVENT_FLAG_NONE);
+    complete->UpdateDuration(now + TimeDelta::FromMicroseconds(300),
+                             TimeTicks::FromInternalValue(700));
+
+    // A COMPLETE event whose end hasn't been recorded.
+    chunk->AddTraceEvent(&index)->Initialize(
+        8, now, TimeTicks(), TRACE_EVENT_PHASE_COMPLETE, category_, "ints",
+        0, 0, NULL, NULL, NULL, NULL, TRACE_EVENT_FLAG_NONE);
+  }
+
+  static std::string ChunkAsJSON(const TraceBufferChunk& chunk) {
+    std::string json;
+    for (size_t i = 0; i < chunk.size(); ++i) {
+      if (i > 0)
+        json += ",";
+      chunk.GetEventAt(i)->AppendAsJSON(&json);
+    }
+    return json;
+  }
+
+  const unsigned char* category_;
+
+ private:
+  ShadowingAtExitManager at_exit_manager_;
+};
+
+}  // namespace
+
+TEST_F(TraceEventBinaryTest, RoundTrip) {
+  TraceBufferChunk chunk(0);
+  FillChunk(&chunk);
+
+  TraceEventBinaryWriter writer(TraceLog::GetInstance()->process_id());
+  std::string binary;
+  writer.AppendChunk(chunk, &binary);
+
+  TraceEventBinaryReader reader;
+  std::string json;
+  ASSERT_TRUE(reader.AppendAsJSON(binary, &json));
+  EXPECT_EQ(ChunkAsJSON(chunk), json);
+  EXPECT_LT(binary.size(), json.size() / 2);
+}
+
+TEST_F(TraceEventBinaryTest, StringsAreInternedAcrossChunks) {
+  TraceBufferChunk chunk(0);
+  FillChunk(&chunk);
+
+  TraceEventBinaryWriter writer(TraceLog::GetInstance()->process_id());
+  std::string first;
+  writer.AppendChunk(chunk, &first);
+  std::string second;
+  writer.AppendChunk(chunk, &second);
+  // The second copy refers to the strings written with the first one.
+  EXPECT_LT(second.size(), first.size());
+  EXPECT_EQ(std::string::npos, second.find("complete"));
+
+  TraceEventBinaryReader reader;
+  std::string json;
+  ASSERT_TRUE(reader.AppendAsJSON(first, &json));
+  EXPECT_EQ(ChunkAsJSON(chunk), json);
+  json.clear();
+  ASSERT_TRUE(reader.AppendAsJSON(second, &json));
+  EXPECT_EQ(ChunkAsJSON(chunk), json);
+}
+
+TEST_F(TraceEventBinaryTest, MalformedInput) {
+  TraceBufferChunk chunk(0);
+  FillChunk(&chunk);
+  TraceEventBinaryWriter writer(TraceLog::GetInstance()->process_id());
+  std::string binary;
+  writer.AppendChunk(chunk, &binary);
+
+  // Cutting off the last byte leaves the last event record incomplete.
+  {
+    TraceEventBinaryReader reader;
+    std::string json;
+    EXPECT_FALSE(reader.AppendAsJSON(
+        StringPiece(binary.data(), binary.size() - 1), &json));
+  }
+
+  TraceEventBinaryReader reader;
+  std::string json;
+  EXPECT_FALSE(reader.AppendAsJSON("not a trace", &json));
+  // The reader stays failed.
+  EXPECT_FALSE(reader.AppendAsJSON(binary, &json));
+}
+
+}  // namespace debug
+}  // namespace base
@@ -11,6 +11,7 @@
 #include "base/command_line.h"
 #include "base/debug/leak_annotations.h"
 #include "base/debug/trace_event.h"
+#include "base/debug/trace_event_binary.h"
 #include "base/debug/trace_event_synthetic_delay.h"
 #include "base/float_util.h"
 #include "base/format_macros.h"
@@ -113,53 +114,79 @@ TimeTicks ThreadNow() {
       TimeTicks::ThreadNow() : TimeTicks();
 }
 
+// A ring of chunks that threads can take and give back concurrently, without
+// holding TraceLog's lock. The indices of the chunks that aren't in flight are
+// kept in a bounded multi-producer multi-consumer queue, oldest first, so that
+// GetChunk() recycles the oldest chunk.
 class TraceBufferRingBuffer : public TraceBuffer {
  public:
   TraceBufferRingBuffer(size_t max_chunks)
       : max_chunks_(max_chunks),
-        recyclable_chunks_queue_(new size_t[queue_capacity()]),
+        chunks_(new subtle::AtomicWord[max_chunks]),
+        queue_mask_(QueueCapacityFor(max_chunks) - 1),
+        queue_(new QueueCell[queue_mask_ + 1]),
         queue_head_(0),
-        queue_tail_(max_chunks),
-        current_iteration_index_(0),
-        current_chunk_seq_(1) {
-    chunks_.reserve(max_chunks);
+        queue_tail_(0),
+        pinned_chunk_(0),
+        allocated_chunks_(0),
+        current_chunk_seq_(0),
+        iteration_head_(0),
+        current_iteration_position_(0) {
     for (size_t i = 0; i < max_chunks; ++i)
-      recyclable_chunks_queue_[i] = i;
+      chunks_[i] = 0;
+    for (size_t i = 0; i <= queue_mask_; ++i)
+      queue_[i].sequence = static_cast<subtle::AtomicWord>(i);
+    for (size_t i = 0; i < max_chunks; ++i)
+      Enqueue(i);
+  }
+
+  virtual ~TraceBufferRingBuffer() {
+    for (size_t i = 0; i < max_chunks_; ++i)
+      delete reinterpret_cast<TraceBufferChunk*>(chunks_[i]);
   }
 
   virtual scoped_ptr<TraceBufferChunk> GetChunk(size_t* index) OVERRIDE {
     // Because the number of threads is much less than the number of chunks,
     // the queue should never be empty.
-    DCHECK(!QueueIsEmpty());
-
-    *index = recyclable_chunks_queue_[queue_head_];
-    queue_head_ = NextQueueIndex(queue_head_);
-    current_iteration_index_ = queue_head_;
+    if (!Dequeue(index)) {
+      NOTREACHED();
+      return scoped_ptr<TraceBufferChunk>();
+    }
 
-    if (*index >= chunks_.size())
-      chunks_.resize(*index + 1);
+    // Take the chunk out of its slot; NULL marks an in-flight chunk. If
+    // GetEventByHandle() is using the chunk, wait for it to be done.
+    TraceBufferChunk* chunk = reinterpret_cast<TraceBufferChunk*>(
+        subtle::NoBarrier_AtomicExchange(&chunks_[*index], 0));
+    subtle::MemoryBarrier();
+    while (subtle::Acquire_Load(&pinned_chunk_) ==
+           static_cast<subtle::AtomicWord>(*index + 1)) {
+      PlatformThread::YieldCurrentThread();
+    }
 
-    TraceBufferChunk* chunk = chunks_[*index];
-    chunks_[*index] = NULL;  // Put NULL in the slot of a in-flight chunk.
-    if (chunk)
-      chunk->Reset(current_chunk_seq_++);
-    else
-      chunk = new TraceBufferChunk(current_chunk_seq_++);
+    // Zero chunk_seq is not allowed.
+    uint32 seq;
+    do {
+      seq = static_cast<uint32>(
+          subtle::NoBarrier_AtomicIncrement(&current_chunk_seq_, 1));
+    } while (!seq);
 
+    if (chunk) {
+      chunk->Reset(seq);
+    } else {
+      chunk = new TraceBufferChunk(seq);
+      subtle::NoBarrier_AtomicIncrement(&allocated_chunks_, 1);
+    }
     return scoped_ptr<TraceBufferChunk>(chunk);
   }
 
   virtual void ReturnChunk(size_t index,
                            scoped_ptr<TraceBufferChunk> chunk) OVERRIDE {
-    // When this method is called, the queue should not be full because it
-    // can contain all chunks including the one to be returned.
-    DCHECK(!QueueIsFull());
     DCHECK(chunk);
-    DCHECK_LT(index, chunks_.size());
-    DCHECK(!chunks_[index]);
-    chunks_[index] = chunk.release();
-    recyclable_chunks_queue_[queue_tail_] = index;
-    queue_tail_ = NextQueueIndex(queue_tail_);
+    DCHECK_LT(index, max_chunks_);
+    DCHECK(!subtle::NoBarrier_Load(&chunks_[index]));
+    subtle::Release_Store(&chunks_[index],
+                          reinterpret_cast<subtle::AtomicWord>(chunk.release()));
+    Enqueue(index);
   }
 
   virtual bool IsFull() const OVERRIDE {
@@ -168,7 +195,8 @@ class TraceBufferRingBuffer : public TraceBuffer {
 
   virtual size_t Size() const OVERRIDE {
     // This is approximate because not all of the chunks are full.
-    return chunks_.size() * kTraceBufferChunkSize;
+    return static_cast<size_t>(subtle::NoBarrier_Load(&allocated_chunks_)) *
+        kTraceBufferChunkSize;
   }
 
   virtual size_t Capacity() const OVERRIDE {
@@ -176,38 +204,65 @@ class TraceBufferRingBuffer : public TraceBuffer {
   }
 
   virtual TraceEvent* GetEventByHandle(TraceEventHandle handle) OVERRIDE {
-    if (handle.chunk_index >= chunks_.size())
+    if (handle.chunk_index >= max_chunks_)
       return NULL;
-    TraceBufferChunk* chunk = chunks_[handle.chunk_index];
-    if (!chunk || chunk->seq() != handle.chunk_seq)
+    const TraceBufferChunk* chunk = PinChunk(handle.chunk_index);
+    if (!chunk || chunk->seq() != handle.chunk_seq) {
+      UnpinEvent();
       return NULL;
-    return chunk->GetEventAt(handle.event_index);
+    }
+    return const_cast<TraceBufferChunk*>(chunk)->GetEventAt(
+        handle.event_index);
   }
 
-  virtual const TraceBufferChunk* NextChunk() OVERRIDE {
-    if (chunks_.empty())
-      return NULL;
+  virtual void UnpinEvent() OVERRIDE {
+    subtle::Release_Store(&pinned_chunk_, 0);
+  }
 
-    while (current_iteration_index_ != queue_tail_) {
-      size_t chunk_index = recyclable_chunks_queue_[current_iteration_index_];
-      current_iteration_index_ = NextQueueIndex(current_iteration_index_);
-      if (chunk_index >= chunks_.size()) // Skip uninitialized chunks.
-        continue;
-      DCHECK(chunks_[chunk_index]);
-      return chunks_[chunk_index];
+  virtual bool IsLockFree() const OVERRIDE {
+    return true;
+  }
+
+  virtual const TraceBufferChunk* NextChunk() OVERRIDE {
+    // Iteration happens after the buffer was detached from TraceLog, so
+    // nothing else is using the queue. It starts over from the oldest chunk
+    // if one has been taken since the last call.
+    subtle::AtomicWord head = subtle::NoBarrier_Load(&queue_head_);
+    if (head != iteration_head_) {
+      iteration_head_ = head;
+      current_iteration_position_ = head;
+    }
+    subtle::AtomicWord tail = subtle::NoBarrier_Load(&queue_tail_);
+    while (current_iteration_position_ != tail) {
+      size_t chunk_index =
+          queue_[current_iteration_position_ & queue_mask_].chunk_index;
+      current_iteration_position_++;
+      const TraceBufferChunk* chunk = reinterpret_cast<TraceBufferChunk*>(
+          subtle::NoBarrier_Load(&chunks_[chunk_index]));
+      if (chunk)  // Skip uninitialized chunks.
+        return chunk;
     }
     return NULL;
   }
 
   virtual scoped_ptr<TraceBuffer> CloneForIteration() const OVERRIDE {
+    // This may run while other threads are taking and returning chunks. A
+    // chunk that is taken before it is pinned is skipped.
+    TraceBufferRingBuffer* self = const_cast<TraceBufferRingBuffer*>(this);
     scoped_ptr<ClonedTraceBuffer> cloned_buffer(new ClonedTraceBuffer());
-    for (size_t queue_index = queue_head_; queue_index != queue_tail_;
-        queue_index = NextQueueIndex(queue_index)) {
-      size_t chunk_index = recyclable_chunks_queue_[queue_index];
-      if (chunk_index >= chunks_.size()) // Skip uninitialized chunks.
+    subtle::AtomicWord tail = subtle::Acquire_Load(&queue_tail_);
+    for (subtle::AtomicWord position = subtle::Acquire_Load(&queue_head_);
+         position - tail < 0; ++position) {
+      const QueueCell& cell = queue_[position & queue_mask_];
+      if (subtle::Acquire_Load(&cell.sequence) != position + 1)
+        continue;
+      size_t chunk_index = cell.chunk_index;
+      if (subtle::Acquire_Load(&cell.sequence) != position + 1)
         continue;
-      TraceBufferChunk* chunk = chunks_[chunk_index];
-      cloned_buffer->chunks_.push_back(chunk ? chunk->Clone().release() : NULL);
+      const TraceBufferChunk* chunk = self->PinChunk(chunk_index);
+      if (chunk)
+        cloned_buffer->chunks_.push_back(chunk->Clone().release());
+      self->UnpinEvent();
     }
     return cloned_buffer.PassAs<TraceBuffer>();
   }
@@ -237,6 +292,8 @@ class TraceBufferRingBuffer : public TraceBuffer {
     virtual TraceEvent* GetEventByHandle(TraceEventHandle handle) OVERRIDE {
       return NULL;
     }
+    virtual void UnpinEvent() OVERRIDE {}
+    virtual bool IsLockFree() const OVERRIDE { return false; }
     virtual scoped_ptr<TraceBuffer> CloneForIteration() const OVERRIDE {
       NOTIMPLEMENTED();
       return scoped_ptr<TraceBuffer>();
@@ -246,40 +303,96 @@ class TraceBufferRingBuffer : public TraceBuffer {
     ScopedVector<TraceBufferChunk> chunks_;
   };
 
-  bool QueueIsEmpty() const {
-    return queue_head_ == queue_tail_;
-  }
+  // A cell of the queue, after Dmitry Vyukov's bounded MPMC queue. |sequence|
+  // tells whether the cell is ready to be written or read at a position.
+  struct QueueCell {
+    subtle::AtomicWord sequence;
+    size_t chunk_index;
+  };
 
-  size_t QueueSize() const {
-    return queue_tail_ > queue_head_ ? queue_tail_ - queue_head_ :
-        queue_tail_ + queue_capacity() - queue_head_;
+  static size_t QueueCapacityFor(size_t max_chunks) {
+    size_t capacity = 1;
+    while (capacity < max_chunks)
+      capacity <<= 1;
+    return capacity;
+  }
+
+  void Enqueue(size_t chunk_index) {
+    subtle::AtomicWord position = subtle::NoBarrier_Load(&queue_tail_);
+    QueueCell* cell;
+    for (;;) {
+      cell = &queue_[position & queue_mask_];
+      subtle::AtomicWord diff = subtle::Acquire_Load(&cell->sequence) - position;
+      if (diff == 0) {
+        subtle::AtomicWord old_position = subtle::NoBarrier_CompareAndSwap(
+            &queue_tail_, position, position + 1);
+        if (old_position == position)
+          break;
+        position = old_position;
+      } else {
+        // The queue can hold all the chunks, so it is never full, but the
+        // cell may still be finishing a dequeue from the previous lap.
+        position = subtle::NoBarrier_Load(&queue_tail_);
+      }
+    }
+    cell->chunk_index = chunk_index;
+    subtle::Release_Store(&cell->sequence, position + 1);
+  }
+
+  bool Dequeue(size_t* chunk_index) {
+    subtle::AtomicWord position = subtle::NoBarrier_Load(&queue_head_);
+    QueueCell* cell;
+    for (;;) {
+      cell = &queue_[position & queue_mask_];
+      subtle::AtomicWord diff =
+          subtle::Acquire_Load(&cell->sequence) - (position + 1);
+      if (diff == 0) {
+        subtle::AtomicWord old_position = subtle::NoBarrier_CompareAndSwap(
+            &queue_head_, position, position + 1);
+        if (old_position == position)
+          break;
+        position = old_position;
+      } else if (diff < 0) {
+        return false;
+      } else {
+        position = subtle::NoBarrier_Load(&queue_head_);
+      }
+    }
+    *chunk_index = cell->chunk_index;
+    subtle::Release_Store(&cell->sequence,
+                          position + static_cast<subtle::AtomicWord>(
+                                         queue_mask_ + 1));
+    return true;
   }
 
-  bool QueueIsFull() const {
-    return QueueSize() == queue_capacity() - 1;
+  // Keeps GetChunk() from recycling the chunk at |index| until UnpinEvent(),
+  // and returns it, or NULL if it is in flight. Only one chunk can be pinned
+  // at a time; callers hold TraceLog's lock.
+  const TraceBufferChunk* PinChunk(size_t index) {
+    subtle::NoBarrier_Store(&pinned_chunk_,
+                            static_cast<subtle::AtomicWord>(index + 1));
+    subtle::MemoryBarrier();
+    return reinterpret_cast<const TraceBufferChunk*>(
+        subtle::Acquire_Load(&chunks_[index]));
   }
 
-  size_t queue_capacity() const {
-    // One extra space to help distinguish full state and empty state.
-    return max_chunks_ + 1;
-  }
+  const size_t max_chunks_;
+  // The chunks that aren't in flight, as TraceBufferChunk*, by index.
+  scoped_ptr<subtle::AtomicWord[]> chunks_;
 
-  size_t NextQueueIndex(size_t index) const {
-    index++;
-    if (index >= queue_capacity())
-      index = 0;
-    return index;
-  }
+  const size_t queue_mask_;
+  scoped_ptr<QueueCell[]> queue_;
+  subtle::AtomicWord queue_head_;
+  subtle::AtomicWord queue_tail_;
 
-  size_t max_chunks_;
-  ScopedVector<TraceBufferChunk> chunks_;
+  // The index plus one of the chunk pinned by GetEventByHandle(), or zero.
+  subtle::AtomicWord pinned_chunk_;
 
-  scoped_ptr<size_t[]> recyclable_chunks_queue_;
-  size_t queue_head_;
-  size_t queue_tail_;
+  subtle::Atomic32 allocated_chunks_;
+  subtle::Atomic32 current_chunk_seq_;
 
-  size_t current_iteration_index_;
-  uint32 current_chunk_seq_;
+  subtle::AtomicWord iteration_head_;
+  subtle::AtomicWord current_iteration_position_;
 
   DISALLOW_COPY_AND_ASSIGN(TraceBufferRingBuffer);
 };
@@ -336,6 +449,13 @@ class TraceBufferVector : public TraceBuffer {
     return chunk->GetEventAt(handle.event_index);
   }
 
+  virtual void UnpinEvent() OVERRIDE {
+  }
+
+  virtual bool IsLockFree() const OVERRIDE {
+    return false;
+  }
+
   virtual const TraceBufferChunk* NextChunk() OVERRIDE {
     while (current_iteration_index_ < chunks_.size()) {
       // Skip in-flight chunks.
@@ -424,10 +544,13 @@ class TraceLog::OptionalAutoLock {
  public:
   explicit OptionalAutoLock(Lock& lock)
       : lock_(lock),
-        locked_(false) {
+        locked_(false),
+        pinned_buffer_(NULL) {
   }
 
   ~OptionalAutoLock() {
+    if (pinned_buffer_)
+      pinned_buffer_->UnpinEvent();
     if (locked_)
       lock_.Release();
   }
@@ -439,9 +562,16 @@ class TraceLog::OptionalAutoLock {
     }
   }
 
+  // Unpins the event looked up in |buffer| along with releasing the lock.
+  void set_pinned_buffer(TraceBuffer* buffer) {
+    DCHECK(locked_);
+    pinned_buffer_ = buffer;
+  }
+
  private:
   Lock& lock_;
   bool locked_;
+  TraceBuffer* pinned_buffer_;
   DISALLOW_COPY_AND_ASSIGN(OptionalAutoLock);
 };
 
@@ -996,6 +1126,10 @@ class TraceLog::ThreadLocalEventBuffer
 
   void FlushWhileLocked();
 
+  // Returns the current chunk, if any, to the main buffer and takes a new one
+  // without locking, if the main buffer allows it. Returns false otherwise.
+  bool ExchangeChunkWithoutLock();
+
   void CheckThisIsCurrentBuffer() const {
     DCHECK(trace_log_->thread_local_event_buffer_.Get() == this);
   }
@@ -1053,13 +1187,12 @@ TraceEvent* TraceLog::ThreadLocalEventBuffer::AddTraceEvent(
     TraceEventHandle* handle) {
   CheckThisIsCurrentBuffer();
 
-  if (chunk_ && chunk_->IsFull()) {
-    AutoLock lock(trace_log_->lock_);
-    FlushWhileLocked();
-    chunk_.reset();
-  }
-  if (!chunk_) {
+  if ((!chunk_ || chunk_->IsFull()) && !ExchangeChunkWithoutLock()) {
     AutoLock lock(trace_log_->lock_);
+    if (chunk_) {
+      FlushWhileLocked();
+      chunk_.reset();
+    }
     chunk_ = trace_log_->logged_events_->GetChunk(&chunk_index_);
     trace_log_->CheckIfBufferIsFullWhileLocked();
   }
@@ -1118,6 +1251,23 @@ void TraceLog::ThreadLocalEventBuffer::FlushWhileLocked() {
   // find the generation mismatch and delete this buffer soon.
 }
 
+bool TraceLog::ThreadLocalEventBuffer::ExchangeChunkWithoutLock() {
+  TraceBuffer* trace_buffer = trace_log_->AcquireLockFreeTraceBuffer();
+  if (!trace_buffer)
+    return false;
+
+  // On a generation mismatch, leave it to the locked path to drop the chunk.
+  bool exchanged = false;
+  if (trace_log_->CheckGeneration(generation_)) {
+    if (chunk_)
+      trace_buffer->ReturnChunk(chunk_index_, chunk_.Pass());
+    chunk_ = trace_buffer->GetChunk(&chunk_index_);
+    exchanged = true;
+  }
+  trace_log_->ReleaseLockFreeTraceBuffer();
+  return exchanged;
+}
+
 // static
 TraceLog* TraceLog::GetInstance() {
   return Singleton<TraceLog, LeakySingletonTraits<TraceLog> >::get();
@@ -1138,7 +1288,9 @@ TraceLog::TraceLog()
       event_callback_category_filter_(
           CategoryFilter::kDefaultCategoryFilterString),
       thread_shared_chunk_index_(0),
-      generation_(0) {
+      generation_(0),
+      lock_free_trace_buffer_(0),
+      lock_free_trace_buffer_users_(0) {
   // Trace is enabled or disabled on one thread while other threads are
   // accessing the enabled flag. We don't care whether edge-case events are
   // traced or not, so we allow races on the enabled flag to keep the trace
@@ -1174,7 +1326,7 @@ TraceLog::TraceLog()
   }
 #endif
 
-  logged_events_.reset(CreateTraceBuffer());
+  SwapTraceBuffer(scoped_ptr<TraceBuffer>(CreateTraceBuffer()));
 }
 
 TraceLog::~TraceLog() {
@@ -1598,6 +1750,12 @@ void TraceLog::ConvertTraceEventsToTraceFormat(
   if (flush_output_callback.is_null())
     return;
 
+  if (trace_options() & BINARY_OUTPUT) {
+    ConvertTraceEventsToBinaryFormat(logged_events.Pass(),
+                                     flush_output_callback);
+    return;
+  }
+
   // The callback need to be called at least once even if there is no events
   // to let the caller know the completion of flush.
   bool has_more_events = true;
@@ -1622,6 +1780,28 @@ void TraceLog::ConvertTraceEventsToTraceFormat(
   } while (has_more_events);
 }
 
+void TraceLog::ConvertTraceEventsToBinaryFormat(
+    scoped_ptr<TraceBuffer> logged_events,
+    const TraceLog::OutputCallback& flush_output_callback) {
+  // Each chunk is passed on as soon as it has been encoded. The writer keeps
+  // state between chunks, so they must be handed to a single reader in order.
+  TraceEventBinaryWriter writer(process_id_);
+  scoped_refptr<RefCountedString> binary_events_str_ptr =
+      new RefCountedString();
+  while (const TraceBufferChunk* chunk = logged_events->NextChunk()) {
+    if (!chunk->size())
+      continue;
+    if (!binary_events_str_ptr->data().empty()) {
+      flush_output_callback.Run(binary_events_str_ptr, true);
+      binary_events_str_ptr = new RefCountedString();
+    }
+    writer.AppendChunk(*chunk, &binary_events_str_ptr->data());
+  }
+  // The last chunk, or an empty string if there were no events, completes the
+  // flush.
+  flush_output_callback.Run(binary_events_str_ptr, false);
+}
+
 void TraceLog::FinishFlush(int generation) {
   scoped_ptr<TraceBuffer> previous_logged_events;
   OutputCallback flush_output_callback;
@@ -1632,8 +1812,7 @@ void TraceLog::FinishFlush(int generation) {
   {
     AutoLock lock(lock_);
 
-    previous_logged_events.swap(logged_events_);
-    UseNextTraceBuffer();
+    previous_logged_events = UseNextTraceBuffer();
     thread_message_loops_.clear();
 
     flush_message_loop_proxy_ = NULL;
@@ -1708,11 +1887,47 @@ void TraceLog::FlushButLeaveBufferIntact(
                                   flush_output_callback);
 }
 
-void TraceLog::UseNextTraceBuffer() {
-  logged_events_.reset(CreateTraceBuffer());
+scoped_ptr<TraceBuffer> TraceLog::UseNextTraceBuffer() {
+  scoped_ptr<TraceBuffer> previous_logged_events =
+      SwapTraceBuffer(scoped_ptr<TraceBuffer>(CreateTraceBuffer()));
   subtle::NoBarrier_AtomicIncrement(&generation_, 1);
   thread_shared_chunk_.reset();
   thread_shared_chunk_index_ = 0;
+  return previous_logged_events.Pass();
+}
+
+scoped_ptr<TraceBuffer> TraceLog::SwapTraceBuffer(
+    scoped_ptr<TraceBuffer> trace_buffer) {
+  // Send threads that exchange chunks without the lock to the locked path,
+  // which blocks until we are done, and wait for those that are still using
+  // the current buffer.
+  subtle::NoBarrier_Store(&lock_free_trace_buffer_, 0);
+  subtle::MemoryBarrier();
+  while (subtle::Acquire_Load(&lock_free_trace_buffer_users_))
+    PlatformThread::YieldCurrentThread();
+
+  logged_events_.swap(trace_buffer);
+  if (logged_events_ && logged_events_->IsLockFree()) {
+    subtle::Release_Store(
+        &lock_free_trace_buffer_,
+        reinterpret_cast<subtle::AtomicWord>(logged_events_.get()));
+  }
+  return trace_buffer.Pass();
+}
+
+TraceBuffer* TraceLog::AcquireLockFreeTraceBuffer() {
+  // This is a full barrier, so that either SwapTraceBuffer() sees the
+  // increment, or we see that the buffer has been taken away.
+  subtle::Barrier_AtomicIncrement(&lock_free_trace_buffer_users_, 1);
+  TraceBuffer* trace_buffer = reinterpret_cast<TraceBuffer*>(
+      subtle::Acquire_Load(&lock_free_trace_buffer_));
+  if (!trace_buffer)
+    ReleaseLockFreeTraceBuffer();
+  return trace_buffer;
+}
+
+void TraceLog::ReleaseLockFreeTraceBuffer() {
+  subtle::Barrier_AtomicIncrement(&lock_free_trace_buffer_users_, -1);
 }
 
 TraceEventHandle TraceLog::AddTraceEvent(
@@ -2124,7 +2339,14 @@ TraceEvent* TraceLog::GetEventByHandleInternal(TraceEventHandle handle,
         thread_shared_chunk_->GetEventAt(handle.event_index) : NULL;
   }
 
-  return logged_events_->GetEventByHandle(handle);
+  TraceEvent* trace_event = logged_events_->GetEventByHandle(handle);
+  // Without a lock, this is a test looking at an event while nothing else is
+  // being recorded.
+  if (lock)
+    lock->set_pinned_buffer(logged_events_.get());
+  else
+    logged_events_->UnpinEvent();
+  return trace_event;
 }
 
 void TraceLog::SetProcessID(int process_id) {
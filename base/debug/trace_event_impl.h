@@ -158,6 +158,8 @@ class BASE_EXPORT TraceEvent {
 #endif
 
  private:
+  friend class TraceEventBinaryWriter;
+
   // Note: these are ordered by size (largest first) for optimal packing.
   TimeTicks timestamp_;
   TimeTicks thread_timestamp_;
@@ -227,6 +229,13 @@ class BASE_EXPORT TraceBuffer {
   virtual size_t Size() const = 0;
   virtual size_t Capacity() const = 0;
   virtual TraceEvent* GetEventByHandle(TraceEventHandle handle) = 0;
+  // Buffers whose chunks can be recycled while TraceLog's lock is held keep
+  // the chunk of the event returned by GetEventByHandle() until this is called.
+  virtual void UnpinEvent() = 0;
+
+  // Whether GetChunk() and ReturnChunk() may be called from any thread without
+  // holding TraceLog's lock.
+  virtual bool IsLockFree() const = 0;
 
   // For iteration. Each TraceBuffer can only be iterated once.
   virtual const TraceBufferChunk* NextChunk() = 0;
@@ -385,6 +394,11 @@ class BASE_EXPORT TraceLog {
 
     // Echo to console. Events are discarded.
     ECHO_TO_CONSOLE = 1 << 3,
+
+    // Flush the events in the binary format described in
+    // trace_event_binary.h instead of JSON, one TraceBufferChunk per callback.
+    // Use TraceEventBinaryReader to convert the output to JSON.
+    BINARY_OUTPUT = 1 << 4,
   };
 
   // The pointer returned from GetCategoryGroupEnabledInternal() points to a
@@ -600,6 +614,8 @@ class BASE_EXPORT TraceLog {
  private:
   FRIEND_TEST_ALL_PREFIXES(TraceEventTestFixture,
                            TraceBufferRingBufferGetReturnChunk);
+  FRIEND_TEST_ALL_PREFIXES(TraceEventTestFixture,
+                           TraceBufferRingBufferConcurrentGetReturnChunk);
   FRIEND_TEST_ALL_PREFIXES(TraceEventTestFixture,
                            TraceBufferRingBufferHalfIteration);
   FRIEND_TEST_ALL_PREFIXES(TraceEventTestFixture,
@@ -649,6 +665,8 @@ class BASE_EXPORT TraceLog {
   void FlushCurrentThread(int generation);
   void ConvertTraceEventsToTraceFormat(scoped_ptr<TraceBuffer> logged_events,
       const TraceLog::OutputCallback& flush_output_callback);
+  void ConvertTraceEventsToBinaryFormat(scoped_ptr<TraceBuffer> logged_events,
+      const TraceLog::OutputCallback& flush_output_callback);
   void FinishFlush(int generation);
   void OnFlushTimeout(int generation);
 
@@ -658,7 +676,15 @@ class BASE_EXPORT TraceLog {
   bool CheckGeneration(int generation) const {
     return generation == this->generation();
   }
-  void UseNextTraceBuffer();
+  // Returns the previous buffer.
+  scoped_ptr<TraceBuffer> UseNextTraceBuffer();
+  scoped_ptr<TraceBuffer> SwapTraceBuffer(scoped_ptr<TraceBuffer> trace_buffer);
+
+  // Used by ThreadLocalEventBuffer to exchange chunks without taking |lock_|.
+  // Returns NULL if the current buffer isn't lock-free. Otherwise the buffer
+  // stays valid until ReleaseLockFreeTraceBuffer().
+  TraceBuffer* AcquireLockFreeTraceBuffer();
+  void ReleaseLockFreeTraceBuffer();
 
   TimeTicks OffsetNow() const {
     return OffsetTimestamp(TimeTicks::NowFromSystemTraceTime());
@@ -731,6 +757,11 @@ class BASE_EXPORT TraceLog {
   scoped_refptr<MessageLoopProxy> flush_message_loop_proxy_;
   subtle::AtomicWord generation_;
 
+  // |logged_events_| if it is lock-free, and the number of threads that are
+  // using it without holding |lock_|.
+  subtle::AtomicWord /* TraceBuffer* */ lock_free_trace_buffer_;
+  subtle::Atomic32 lock_free_trace_buffer_users_;
+
   DISALLOW_COPY_AND_ASSIGN(TraceLog);
 };
 
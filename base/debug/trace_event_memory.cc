@@ -124,10 +124,13 @@ int GetPseudoStack(int skip_count_ignored, void** stack_out) {
   // If the tracing system isn't fully initialized, just skip this allocation.
   // Attempting to initialize will allocate memory, causing this function to
   // be called recursively from inside the allocator.
-  if (!tls_trace_memory_stack.initialized() || !tls_trace_memory_stack.Get())
+  if (!tls_trace_memory_stack.initialized())
     return 0;
+  // This runs on every allocation while profiling, so read the slot once.
   TraceMemoryStack* stack =
       static_cast<TraceMemoryStack*>(tls_trace_memory_stack.Get());
+  if (!stack)
+    return 0;
   // Copy at most kMaxScopeDepth scope entries.
   const size_t count = std::min(stack->scope_depth, kMaxScopeDepth);
   // Notes that memcpy() works for zero bytes.
@@ -6,10 +6,12 @@
 
 #include <math.h>
 #include <cstdlib>
+#include <set>
 
 #include "base/bind.h"
 #include "base/command_line.h"
 #include "base/debug/trace_event.h"
+#include "base/debug/trace_event_binary.h"
 #include "base/debug/trace_event_synthetic_delay.h"
 #include "base/json/json_reader.h"
 #include "base/json/json_writer.h"
@@ -55,6 +57,11 @@ class TraceEventTestFixture : public testing::Test {
       WaitableEvent* flush_complete_event,
       const scoped_refptr<base::RefCountedString>& events_str,
       bool has_more_events);
+  void OnBinaryTraceDataCollected(
+      TraceEventBinaryReader* reader,
+      WaitableEvent* flush_complete_event,
+      const scoped_refptr<base::RefCountedString>& events_str,
+      bool has_more_events);
   void OnWatchEventMatched() {
     ++event_watch_notification_;
   }
@@ -190,6 +197,18 @@ void TraceEventTestFixture::OnTraceDataCollected(
     flush_complete_event->Signal();
 }
 
+void TraceEventTestFixture::OnBinaryTraceDataCollected(
+    TraceEventBinaryReader* reader,
+    WaitableEvent* flush_complete_event,
+    const scoped_refptr<base::RefCountedString>& events_str,
+    bool has_more_events) {
+  scoped_refptr<RefCountedString> json_events_str = new RefCountedString;
+  EXPECT_TRUE(reader->AppendAsJSON(events_str->data(),
+                                   &json_events_str->data()));
+  OnTraceDataCollected(flush_complete_event, json_events_str,
+                       has_more_events);
+}
+
 static bool CompareJsonValues(const std::string& lhs,
                               const std::string& rhs,
                               CompareOp op) {
@@ -812,6 +831,34 @@ void TraceManyInstantEvents(int thread_id, int num_events,
     task_complete_event->Signal();
 }
 
+// Like TraceManyInstantEvents(), but inside a COMPLETE event so that its
+// duration is filled in after the chunks holding it have been handed back.
+void TraceManyInstantEventsInScope(int thread_id, int num_events,
+                                   WaitableEvent* task_complete_event) {
+  {
+    TRACE_EVENT1("all", "multi thread scope", "thread", thread_id);
+    TraceManyInstantEvents(thread_id, num_events, NULL);
+  }
+  task_complete_event->Signal();
+}
+
+// Repeatedly takes and returns chunks of |buffer| without holding the
+// TraceLog lock. |in_use| has an entry per chunk index, and records a failure
+// if an index is handed out while it is still taken.
+void GetAndReturnChunks(TraceBuffer* buffer, int iterations,
+                        subtle::Atomic32* in_use, subtle::Atomic32* failures,
+                        WaitableEvent* task_complete_event) {
+  for (int i = 0; i < iterations; ++i) {
+    size_t index;
+    scoped_ptr<TraceBufferChunk> chunk = buffer->GetChunk(&index);
+    if (!chunk || subtle::NoBarrier_CompareAndSwap(&in_use[index], 0, 1))
+      subtle::NoBarrier_AtomicIncrement(failures, 1);
+    subtle::NoBarrier_Store(&in_use[index], 0);
+    buffer->ReturnChunk(index, chunk.Pass());
+  }
+  task_complete_event->Signal();
+}
+
 void ValidateInstantEventPresentOnEveryThread(const ListValue& trace_parsed,
                                               int num_threads,
                                               int num_events) {
@@ -1443,6 +1490,56 @@ TEST_F(TraceEventTestFixture, DataCapturedManyThreads) {
   }
 }
 
+// Test that continuous tracing, where the threads swap chunks without taking
+// the TraceLog lock, gathers the data from all of them.
+TEST_F(TraceEventTestFixture, DataCapturedManyThreadsContinuously) {
+  TraceLog::GetInstance()->SetEnabled(CategoryFilter("*"),
+                                      base::debug::TraceLog::RECORDING_MODE,
+                                      TraceLog::RECORD_CONTINUOUSLY);
+
+  const int num_threads = 4;
+  const int num_events = 4000;
+  Thread* threads[num_threads];
+  WaitableEvent* task_complete_events[num_threads];
+  for (int i = 0; i < num_threads; i++) {
+    threads[i] = new Thread(StringPrintf("Thread %d", i).c_str());
+    task_complete_events[i] = new WaitableEvent(false, false);
+    threads[i]->Start();
+    threads[i]->message_loop()->PostTask(
+        FROM_HERE, base::Bind(&TraceManyInstantEventsInScope,
+                              i, num_events, task_complete_events[i]));
+  }
+
+  for (int i = 0; i < num_threads; i++)
+    task_complete_events[i]->Wait();
+
+  EndTraceAndFlushInThreadWithMessageLoop();
+  ValidateInstantEventPresentOnEveryThread(trace_parsed_,
+                                           num_threads, num_events);
+  std::set<int> scopes;
+  for (size_t i = 0; i < trace_parsed_.GetSize(); i++) {
+    const DictionaryValue* dict = NULL;
+    std::string name;
+    std::string phase;
+    int thread = -1;
+    if (!trace_parsed_.GetDictionary(i, &dict) ||
+        !dict->GetString("name", &name) || name != "multi thread scope")
+      continue;
+    EXPECT_TRUE(dict->GetString("ph", &phase));
+    EXPECT_EQ("X", phase);
+    EXPECT_TRUE(dict->HasKey("dur"));
+    EXPECT_TRUE(dict->GetInteger("args.thread", &thread));
+    scopes.insert(thread);
+  }
+  EXPECT_EQ(static_cast<size_t>(num_threads), scopes.size());
+
+  for (int i = 0; i < num_threads; i++) {
+    threads[i]->Stop();
+    delete threads[i];
+    delete task_complete_events[i];
+  }
+}
+
 // Test that thread and process names show up in the trace
 TEST_F(TraceEventTestFixture, ThreadNames) {
   // Create threads before we enable tracing to make sure
@@ -1769,6 +1866,48 @@ TEST_F(TraceEventTestFixture, TraceCategoriesAfterNestedEnable) {
   trace_log->SetDisabled();
 }
 
+TEST_F(TraceEventTestFixture, BinaryOutput) {
+  TraceLog::GetInstance()->SetEnabled(
+      CategoryFilter("*"),
+      base::debug::TraceLog::RECORDING_MODE,
+      TraceLog::Options(TraceLog::RECORD_UNTIL_FULL |
+                        TraceLog::BINARY_OUTPUT));
+
+  // Enough events to fill several chunks.
+  const int kNumEvents = 3 * TraceBufferChunk::kTraceBufferChunkSize;
+  for (int i = 0; i < kNumEvents; ++i)
+    TRACE_EVENT_INSTANT1("binary", "instant", TRACE_EVENT_SCOPE_THREAD,
+                         "i", i);
+  TRACE_EVENT_ASYNC_BEGIN1("binary", "async", kAsyncId, "str", "value");
+  TRACE_EVENT_COPY_BEGIN0("binary", std::string("copied").c_str());
+
+  TraceLog::GetInstance()->SetDisabled();
+  WaitableEvent flush_complete_event(false, false);
+  TraceEventBinaryReader reader;
+  TraceLog::GetInstance()->Flush(
+      Bind(&TraceEventTestFixture::OnBinaryTraceDataCollected,
+           Unretained(this), Unretained(&reader),
+           Unretained(&flush_complete_event)));
+  flush_complete_event.Wait();
+
+  int num_instant_events = 0;
+  for (size_t i = 0; i < trace_parsed_.GetSize(); ++i) {
+    const DictionaryValue* dict = NULL;
+    std::string name;
+    if (trace_parsed_.GetDictionary(i, &dict) &&
+        dict->GetString("name", &name) && name == "instant") {
+      int value = -1;
+      EXPECT_TRUE(dict->GetInteger("args.i", &value));
+      EXPECT_EQ(num_instant_events, value);
+      ++num_instant_events;
+    }
+  }
+  EXPECT_EQ(kNumEvents, num_instant_events);
+  EXPECT_TRUE(FindNamePhaseKeyValue("async", "S", "id", kAsyncIdStr));
+  EXPECT_TRUE(FindNamePhaseKeyValue("async", "S", "args.str", "value"));
+  EXPECT_TRUE(FindNamePhase("copied", "B"));
+}
+
 TEST_F(TraceEventTestFixture, TraceSampling) {
   TraceLog::GetInstance()->SetEnabled(
       CategoryFilter("*"),
@@ -2406,6 +2545,44 @@ TEST_F(TraceEventTestFixture, TraceBufferRingBufferGetReturnChunk) {
   TraceLog::GetInstance()->SetDisabled();
 }
 
+TEST_F(TraceEventTestFixture, TraceBufferRingBufferConcurrentGetReturnChunk) {
+  TraceLog::GetInstance()->SetEnabled(CategoryFilter("*"),
+                                      base::debug::TraceLog::RECORDING_MODE,
+                                      TraceLog::RECORD_CONTINUOUSLY);
+  TraceBuffer* buffer = TraceLog::GetInstance()->trace_buffer();
+  ASSERT_TRUE(buffer->IsLockFree());
+  size_t num_chunks =
+      buffer->Capacity() / TraceBufferChunk::kTraceBufferChunkSize;
+  scoped_ptr<subtle::Atomic32[]> in_use(new subtle::Atomic32[num_chunks]);
+  for (size_t i = 0; i < num_chunks; ++i)
+    in_use[i] = 0;
+  subtle::Atomic32 failures = 0;
+
+  const int num_threads = 4;
+  Thread* threads[num_threads];
+  WaitableEvent* task_complete_events[num_threads];
+  for (int i = 0; i < num_threads; i++) {
+    threads[i] = new Thread(StringPrintf("Thread %d", i).c_str());
+    task_complete_events[i] = new WaitableEvent(false, false);
+    threads[i]->Start();
+    threads[i]->message_loop()->PostTask(
+        FROM_HERE, base::Bind(&GetAndReturnChunks, buffer, 10000,
+                              in_use.get(), &failures,
+                              task_complete_events[i]));
+  }
+  for (int i = 0; i < num_threads; i++) {
+    task_complete_events[i]->Wait();
+    threads[i]->Stop();
+    delete threads[i];
+    delete task_complete_events[i];
+  }
+
+  EXPECT_EQ(0, failures);
+  EXPECT_EQ(num_chunks * TraceBufferChunk::kTraceBufferChunkSize,
+            buffer->Size());
+  TraceLog::GetInstance()->SetDisabled();
+}
+
 TEST_F(TraceEventTestFixture, TraceBufferRingBufferHalfIteration) {
   TraceLog::GetInstance()->SetEnabled(CategoryFilter("*"),
                                       base::debug::TraceLog::RECORDING_MODE,
@@ -139,6 +139,15 @@ bool ReadFileToString(const FilePath& path,
     return false;
   }
 
+  // Reserve room for the whole file up front so that large files are not
+  // reallocated and copied as they grow. The size is only a hint; the read
+  // below still stops at the actual end of the file.
+  int64 file_size = 0;
+  if (contents && GetFileSize(path, &file_size) && file_size > 0 &&
+      static_cast<uint64>(file_size) <= max_size) {
+    contents->reserve(static_cast<size_t>(file_size));
+  }
+
   char buf[1 << 16];
   size_t len;
   size_t size = 0;
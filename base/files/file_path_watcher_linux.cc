@@ -274,10 +274,14 @@ bool InotifyReader::RemoveWatch(Watch watch,
 
   AutoLock auto_lock(lock_);
 
-  watchers_[watch].erase(watcher);
+  hash_map<Watch, WatcherSet>::iterator found = watchers_.find(watch);
+  if (found == watchers_.end())
+    return false;
+
+  found->second.erase(watcher);
 
-  if (watchers_[watch].empty()) {
-    watchers_.erase(watch);
+  if (found->second.empty()) {
+    watchers_.erase(found);
     return (inotify_rm_watch(inotify_fd_, watch) == 0);
   }
 
@@ -291,8 +295,16 @@ void InotifyReader::OnInotifyEvent(const inotify_event* event) {
   FilePath::StringType child(event->len ? event->name : FILE_PATH_LITERAL(""));
   AutoLock auto_lock(lock_);
 
-  for (WatcherSet::iterator watcher = watchers_[event->wd].begin();
-       watcher != watchers_[event->wd].end();
+  // Look the watch up once, and don't add an empty entry for events that
+  // are still queued for a watch that has since been removed.
+  hash_map<Watch, WatcherSet>::const_iterator found =
+      watchers_.find(event->wd);
+  if (found == watchers_.end())
+    return;
+
+  const WatcherSet& watchers = found->second;
+  for (WatcherSet::const_iterator watcher = watchers.begin();
+       watcher != watchers.end();
        ++watcher) {
     (*watcher)->OnFilePathChanged(event->wd,
                                   child,
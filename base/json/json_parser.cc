@@ -4,6 +4,16 @@
 
 #include "base/json/json_parser.h"
 
+#include "build/build_config.h"
+
+#if defined(ARCH_CPU_X86_64) || defined(__SSE2__)
+#include <emmintrin.h>
+#define JSON_PARSER_USE_SSE2
+#elif defined(ARCH_CPU_ARM_FAMILY) && defined(__ARM_NEON__)
+#include <arm_neon.h>
+#define JSON_PARSER_USE_NEON
+#endif
+
 #include "base/float_util.h"
 #include "base/logging.h"
 #include "base/memory/scoped_ptr.h"
@@ -25,6 +35,51 @@ const int kStackMaxDepth = 100;
 
 const int32 kExtendedASCIIStart = 0x80;
 
+// Returns whether |c| can be copied into a string token as-is: it is ASCII,
+// and is neither the closing quote nor the start of an escape sequence.
+inline bool IsPlainStringChar(char c) {
+  return static_cast<uint8>(c) < kExtendedASCIIStart && c != '"' && c != '\\';
+}
+
+// Returns the number of bytes at the start of [|begin|, |end|) for which
+// IsPlainStringChar() holds. Most string tokens consist entirely of such
+// bytes, so they are checked a vector at a time where possible.
+size_t CountPlainStringChars(const char* begin, const char* end) {
+  const char* pos = begin;
+#if defined(JSON_PARSER_USE_SSE2)
+  const __m128i quote = _mm_set1_epi8('"');
+  const __m128i backslash = _mm_set1_epi8('\\');
+  while (end - pos >= 16) {
+    __m128i chunk = _mm_loadu_si128(reinterpret_cast<const __m128i*>(pos));
+    __m128i special = _mm_or_si128(_mm_cmpeq_epi8(chunk, quote),
+                                   _mm_cmpeq_epi8(chunk, backslash));
+    // Non-ASCII bytes have their top bit set, which is what movemask picks.
+    if (_mm_movemask_epi8(_mm_or_si128(special, chunk)))
+      break;
+    pos += 16;
+  }
+#elif defined(JSON_PARSER_USE_NEON)
+  const uint8x16_t quote = vdupq_n_u8('"');
+  const uint8x16_t backslash = vdupq_n_u8('\\');
+  const uint8x16_t extended = vdupq_n_u8(kExtendedASCIIStart);
+  while (end - pos >= 16) {
+    uint8x16_t chunk = vld1q_u8(reinterpret_cast<const uint8*>(pos));
+    uint8x16_t special = vorrq_u8(
+        vorrq_u8(vceqq_u8(chunk, quote), vceqq_u8(chunk, backslash)),
+        vcgeq_u8(chunk, extended));
+    uint8x8_t folded = vorr_u8(vget_low_u8(special), vget_high_u8(special));
+    if (vget_lane_u64(vreinterpret_u64_u8(folded), 0))
+      break;
+    pos += 16;
+  }
+#endif
+  // Finish off the tail, or find the exact position of the special byte in
+  // the vector that stopped the loop above.
+  while (pos < end && IsPlainStringChar(*pos))
+    ++pos;
+  return pos - begin;
+}
+
 // This and the class below are used to own the JSON input string for when
 // string tokens are stored as StringPiece instead of std::string. This
 // optimization avoids about 2/3rds of string memory copies. The constructor
@@ -182,6 +237,17 @@ class StackMarker {
   DISALLOW_COPY_AND_ASSIGN(StackMarker);
 };
 
+// Compacts every dictionary in the tree rooted at |node|.
+void CompactDictionaries(Value* node) {
+  if (node->IsType(Value::TYPE_DICTIONARY)) {
+    static_cast<DictionaryValue*>(node)->Compact();
+  } else if (node->IsType(Value::TYPE_LIST)) {
+    ListValue* list = static_cast<ListValue*>(node);
+    for (ListValue::iterator it = list->begin(); it != list->end(); ++it)
+      CompactDictionaries(*it);
+  }
+}
+
 }  // namespace
 
 JSONParser::JSONParser(int options)
@@ -245,6 +311,11 @@ Value* JSONParser::Parse(const StringPiece& input) {
     }
   }
 
+  // This is done once for the whole tree rather than as each dictionary is
+  // completed, since Compact() visits all the dictionaries below it.
+  if (options_ & JSON_COMPACT_DICTIONARIES)
+    CompactDictionaries(root.get());
+
   // Dictionaries and lists can contain JSONStringValues, so wrap them in a
   // hidden root.
   if (!(options_ & JSON_DETACHABLE_CHILDREN)) {
@@ -307,6 +378,14 @@ void JSONParser::StringBuilder::Append(const char& c) {
     ++length_;
 }
 
+void JSONParser::StringBuilder::AppendPlainChars(const char* str,
+                                                 size_t length) {
+  if (string_)
+    string_->append(str, length);
+  else
+    length_ += length;
+}
+
 void JSONParser::StringBuilder::AppendString(const std::string& str) {
   DCHECK(string_);
   string_->append(str);
@@ -616,6 +695,17 @@ bool JSONParser::ConsumeStringRaw(StringBuilder* out) {
 
   while (CanConsume(1)) {
     pos_ = start_pos_ + index_;  // CBU8_NEXT is postcrement.
+
+    // Skip over the run of characters that need neither decoding nor
+    // unescaping. The last byte of input is left to the code below so that
+    // unterminated strings are reported exactly as before.
+    size_t plain_chars = CountPlainStringChars(pos_, end_pos_ - 1);
+    if (plain_chars) {
+      string.AppendPlainChars(pos_, plain_chars);
+      index_ += plain_chars;
+      pos_ += plain_chars;
+    }
+
     CBU8_NEXT(start_pos_, index_, length, next_char);
     if (next_char < 0 || !IsValidCharacter(next_char)) {
       ReportError(JSONReader::JSON_UNSUPPORTED_ENCODING, 1);
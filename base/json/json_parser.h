@@ -113,6 +113,10 @@ class BASE_EXPORT_PRIVATE JSONParser {
     // AppendString below.
     void Append(const char& c);
 
+    // Like calling Append() for each of the |length| characters at |str|,
+    // which must all be in the basic ASCII plane.
+    void AppendPlainChars(const char* str, size_t length);
+
     // Appends a string to the std::string. Must be Convert()ed to use.
     void AppendString(const std::string& str);
 
@@ -258,6 +262,7 @@ class BASE_EXPORT_PRIVATE JSONParser {
   FRIEND_TEST_ALL_PREFIXES(JSONParserTest, ConsumeDictionary);
   FRIEND_TEST_ALL_PREFIXES(JSONParserTest, ConsumeList);
   FRIEND_TEST_ALL_PREFIXES(JSONParserTest, ConsumeString);
+  FRIEND_TEST_ALL_PREFIXES(JSONParserTest, ConsumeLongString);
   FRIEND_TEST_ALL_PREFIXES(JSONParserTest, ConsumeLiterals);
   FRIEND_TEST_ALL_PREFIXES(JSONParserTest, ConsumeNumbers);
   FRIEND_TEST_ALL_PREFIXES(JSONParserTest, ErrorMessages);
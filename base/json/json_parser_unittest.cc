@@ -55,6 +55,40 @@ TEST_F(JSONParserTest, ConsumeString) {
   EXPECT_EQ("test", str);
 }
 
+// Strings longer than a vector register, with escapes and multi-byte
+// characters on either side of the register boundaries.
+TEST_F(JSONParserTest, ConsumeLongString) {
+  const struct {
+    const char* input;
+    const char* expected;
+  } cases[] = {
+    { "\"0123456789abcdefghijklmnopqrstuvwxyz\",|",
+      "0123456789abcdefghijklmnopqrstuvwxyz" },
+    { "\"0123456789abcde\\nfghijklmnopqrstuvwxyz\",|",
+      "0123456789abcde\nfghijklmnopqrstuvwxyz" },
+    { "\"0123456789abcdefghijklmnopqrstuvwxy\\\"\",|",
+      "0123456789abcdefghijklmnopqrstuvwxy\"" },
+    { "\"0123456789abcdefghijklmn\xc3\xa9opqrstuvwxyz\",|",
+      "0123456789abcdefghijklmn\xc3\xa9opqrstuvwxyz" },
+    { "\"0123456789abcdefghijklmn\\u00e9opqrstuvwxyz0123456789\",|",
+      "0123456789abcdefghijklmn\xc3\xa9opqrstuvwxyz0123456789" },
+  };
+
+  for (size_t i = 0; i < arraysize(cases); ++i) {
+    std::string input(cases[i].input);
+    scoped_ptr<JSONParser> parser(NewTestParser(input));
+    scoped_ptr<Value> value(parser->ConsumeString());
+    EXPECT_EQ('"', *parser->pos_) << i;
+
+    TestLastThree(parser.get());
+
+    ASSERT_TRUE(value.get()) << i;
+    std::string str;
+    EXPECT_TRUE(value->GetAsString(&str));
+    EXPECT_EQ(cases[i].expected, str) << i;
+  }
+}
+
 TEST_F(JSONParserTest, ConsumeList) {
   std::string input("[true, false],|");
   scoped_ptr<JSONParser> parser(NewTestParser(input));
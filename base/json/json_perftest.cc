@@ -0,0 +1,96 @@
+// Copyright 2014 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include <string>
+#include <vector>
+
+#include "base/basictypes.h"
+#include "base/json/json_reader.h"
+#include "base/json/json_writer.h"
+#include "base/memory/scoped_ptr.h"
+#include "base/strings/stringprintf.h"
+#include "base/time/time.h"
+#include "base/values.h"
+#include "testing/gtest/include/gtest/gtest.h"
+#include "testing/perf/perf_test.h"
+
+namespace base {
+
+namespace {
+
+const int kIterations = 10;
+
+// Builds a dictionary shaped like a large Preferences file: per-site content
+// settings, with the odd escaped and non-ASCII string thrown in.
+scoped_ptr<DictionaryValue> BuildPreferences(int num_sites) {
+  scoped_ptr<DictionaryValue> sites(new DictionaryValue);
+  for (int i = 0; i < num_sites; ++i) {
+    scoped_ptr<DictionaryValue> site(new DictionaryValue);
+    site->SetString("last_visit", StringPrintf("13%015d", i * 7919));
+    site->SetInteger("setting", i % 3);
+    site->SetBoolean("per_resource", (i % 5) == 0);
+    site->SetString("title",
+                    StringPrintf("Example page \"%d\" \xC3\xA9t\xC3\xA9", i));
+
+    scoped_ptr<ListValue> resources(new ListValue);
+    for (int j = 0; j < 4; ++j) {
+      resources->AppendString(StringPrintf(
+          "https://cdn%d.example.com/static/js/bundle-%d.min.js", j, i));
+    }
+    site->Set("resources", resources.release());
+
+    sites->SetWithoutPathExpansion(
+        StringPrintf("https://www.site%d.example.com:443,*", i),
+        site.release());
+  }
+
+  scoped_ptr<DictionaryValue> prefs(new DictionaryValue);
+  prefs->Set("profile.content_settings.pattern_pairs", sites.release());
+  prefs->SetString("profile.name", "Person 1");
+  prefs->SetDouble("browser.window_placement.scale", 1.25);
+  return prefs.Pass();
+}
+
+void RunParseTest(const std::string& trace, int num_sites, int options) {
+  scoped_ptr<DictionaryValue> prefs = BuildPreferences(num_sites);
+  std::string json;
+  ASSERT_TRUE(JSONWriter::WriteWithOptions(
+      prefs.get(), JSONWriter::OPTIONS_PRETTY_PRINT, &json));
+
+  std::vector<double> times_ms;
+  TimeDelta elapsed;
+  for (int i = 0; i < kIterations; ++i) {
+    TimeTicks start = TimeTicks::HighResNow();
+    {
+      scoped_ptr<Value> value(JSONReader::Read(json, options));
+      ASSERT_TRUE(value.get());
+    }
+    TimeDelta iteration = TimeTicks::HighResNow() - start;
+    times_ms.push_back(iteration.InMillisecondsF());
+    elapsed += iteration;
+  }
+
+  perf_test::PrintResultSamples("json_parse", "", trace, times_ms, "ms", true);
+  perf_test::PrintResult("json_parse_throughput", "", trace,
+                         json.size() * kIterations /
+                             (elapsed.InSecondsF() * 1024 * 1024),
+                         "MB/s", false);
+}
+
+TEST(JSONPerfTest, ParsePreferencesSmall) {
+  RunParseTest("small_preferences", 500, JSON_PARSE_RFC);
+}
+
+TEST(JSONPerfTest, ParsePreferencesLarge) {
+  RunParseTest("large_preferences", 20000, JSON_PARSE_RFC);
+}
+
+TEST(JSONPerfTest, ParsePreferencesLargeDetachable) {
+  RunParseTest("large_preferences_detachable", 20000,
+               JSON_DETACHABLE_CHILDREN);
+}
+
+}  // namespace
+
+}  // namespace base
@@ -58,6 +58,11 @@ enum JSONParserOptions {
   // if the child is Remove()d from root, it would result in use-after-free
   // unless it is DeepCopy()ed or this option is used.
   JSON_DETACHABLE_CHILDREN = 1 << 1,
+
+  // Returns dictionaries in their compact form; see
+  // DictionaryValue::Compact(). This saves memory for large trees that are
+  // mostly read.
+  JSON_COMPACT_DICTIONARIES = 1 << 2,
 };
 
 class BASE_EXPORT JSONReader {
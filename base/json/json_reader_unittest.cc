@@ -623,6 +623,42 @@ TEST(JSONReaderTest, StringOptimizations) {
   EXPECT_EQ("b", s);
 }
 
+TEST(JSONReaderTest, CompactDictionaries) {
+  scoped_ptr<Value> root(JSONReader::Read(
+      "[{\"b\": {\"c\": 1}, \"a\": [{}]}, [{\"d\": \"e\"}]]",
+      JSON_COMPACT_DICTIONARIES));
+  ASSERT_TRUE(root.get());
+  ListValue* list = NULL;
+  ASSERT_TRUE(root->GetAsList(&list));
+
+  DictionaryValue* dict = NULL;
+  ASSERT_TRUE(list->GetDictionary(0, &dict));
+  EXPECT_TRUE(dict->is_compact());
+  int c = 0;
+  EXPECT_TRUE(dict->GetInteger("b.c", &c));
+  EXPECT_EQ(1, c);
+  DictionaryValue* child = NULL;
+  ASSERT_TRUE(dict->GetDictionary("b", &child));
+  EXPECT_TRUE(child->is_compact());
+  ListValue* child_list = NULL;
+  ASSERT_TRUE(dict->GetList("a", &child_list));
+  ASSERT_TRUE(child_list->GetDictionary(0, &child));
+  EXPECT_TRUE(child->is_compact());
+
+  ASSERT_TRUE(list->GetList(1, &child_list));
+  ASSERT_TRUE(child_list->GetDictionary(0, &child));
+  EXPECT_TRUE(child->is_compact());
+  std::string e;
+  EXPECT_TRUE(child->GetString("d", &e));
+  EXPECT_EQ("e", e);
+
+  // Without the option, dictionaries use the regular representation.
+  root.reset(JSONReader::Read("{\"a\": 1}"));
+  ASSERT_TRUE(root.get());
+  ASSERT_TRUE(root->GetAsDictionary(&dict));
+  EXPECT_FALSE(dict->is_compact());
+}
+
 // A smattering of invalid JSON designed to test specific portions of the
 // parser implementation against buffer overflow. Best run with DCHECKs so
 // that the one in NextChar fires.
@@ -106,6 +106,14 @@ bool JSONWriter::BuildJSONString(const Value* const node, size_t depth) {
     }
 
     case Value::TYPE_STRING: {
+      // Escape the string in place rather than copying it out of |node|.
+      const StringValue* string_value = NULL;
+      if (node->GetAsString(&string_value)) {
+        EscapeJSONString(string_value->GetString(), true, json_string_);
+        return true;
+      }
+
+      // The string values created by JSONParser aren't StringValues.
       std::string value;
       bool result = node->GetAsString(&value);
       DCHECK(result);
@@ -3,6 +3,9 @@
 // found in the LICENSE file.
 
 #include "base/json/json_writer.h"
+
+#include "base/json/json_reader.h"
+#include "base/memory/scoped_ptr.h"
 #include "base/values.h"
 #include "testing/gtest/include/gtest/gtest.h"
 
@@ -171,4 +174,21 @@ TEST(JSONWriterTest, DoublesAsInts) {
   EXPECT_EQ("10000000000", output_js);
 }
 
+TEST(JSONWriterTest, ParsedStrings) {
+  // JSONReader creates its own kind of string values unless the children
+  // are detachable. Both kinds must be written back out.
+  const char kJSON[] = "{\"a\":[\"b\",\"c\\\"d\"],\"e\":\"f\"}";
+  const int kOptions[] = {
+    JSON_PARSE_RFC,
+    JSON_DETACHABLE_CHILDREN,
+  };
+  for (size_t i = 0; i < arraysize(kOptions); ++i) {
+    scoped_ptr<Value> root(JSONReader::Read(kJSON, kOptions[i]));
+    ASSERT_TRUE(root.get());
+    std::string output_js;
+    EXPECT_TRUE(JSONWriter::Write(root.get(), &output_js));
+    EXPECT_EQ(kJSON, output_js);
+  }
+}
+
 }  // namespace base
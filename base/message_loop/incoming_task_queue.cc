@@ -12,9 +12,23 @@
 namespace base {
 namespace internal {
 
+namespace {
+
+// The maximum number of nodes kept for reuse by tasks posted from the thread
+// running the loop.
+const size_t kMaxFreeNodes = 64;
+
+}  // namespace
+
 IncomingTaskQueue::IncomingTaskQueue(MessageLoop* message_loop)
-    : message_loop_(message_loop),
-      next_sequence_num_(0) {
+    : incoming_queue_(0),
+      message_loop_(message_loop),
+      owner_message_loop_(message_loop),
+      message_loop_destroyed_(0),
+      always_schedule_work_(message_loop->AlwaysNotifyPumpForEveryTask()),
+      next_sequence_num_(0),
+      free_nodes_(NULL),
+      free_node_count_(0) {
 }
 
 bool IncomingTaskQueue::AddToIncomingQueue(
@@ -22,10 +36,21 @@ bool IncomingTaskQueue::AddToIncomingQueue(
     const Closure& task,
     TimeDelta delay,
     bool nestable) {
-  AutoLock locked(incoming_queue_lock_);
-  PendingTask pending_task(
-      from_here, task, CalculateDelayedRuntime(delay), nestable);
-  return PostPendingTask(&pending_task);
+  TimeTicks delayed_run_time;
+  {
+#if defined(OS_WIN)
+    // The high resolution timer bookkeeping is still done under the lock.
+    AutoLock locked(incoming_queue_lock_);
+#endif
+    delayed_run_time = CalculateDelayedRuntime(delay);
+  }
+  if (subtle::Acquire_Load(&message_loop_destroyed_))
+    return false;
+
+  // Build the PendingTask in place rather than copying it into the queue.
+  Node* node = AllocateNode();
+  node->task.Init(from_here, task, delayed_run_time, nestable);
+  return PostNode(node);
 }
 
 bool IncomingTaskQueue::IsHighResolutionTimerEnabledForTesting() {
@@ -37,20 +62,28 @@ bool IncomingTaskQueue::IsHighResolutionTimerEnabledForTesting() {
 }
 
 bool IncomingTaskQueue::IsIdleForTesting() {
-  AutoLock lock(incoming_queue_lock_);
-  return incoming_queue_.empty();
+  return subtle::Acquire_Load(&incoming_queue_) == 0;
 }
 
 void IncomingTaskQueue::ReloadWorkQueue(TaskQueue* work_queue) {
   // Make sure no tasks are lost.
   DCHECK(work_queue->empty());
 
-  // Acquire all we can from the inter-thread queue with one lock acquisition.
-  AutoLock lock(incoming_queue_lock_);
-  if (!incoming_queue_.empty())
-    incoming_queue_.Swap(work_queue);  // Constant time
+  // Acquire all we can from the inter-thread queue with one atomic operation.
+  Node* node = TakeAllNodes();
+  while (node) {
+    work_queue->push(*node->task);
+    Node* next = node->next;
+    FreeNode(node);
+    node = next;
+  }
+}
 
-  DCHECK(incoming_queue_.empty());
+uint64 IncomingTaskQueue::GetTaskTraceID(const PendingTask& task) const {
+  // This is mangled with a Process ID hash to reduce the likelyhood of
+  // colliding with pointers on other processes.
+  return (static_cast<uint64>(task.sequence_num) << 32) |
+         ((static_cast<uint64>(reinterpret_cast<intptr_t>(this)) << 32) >> 32);
 }
 
 void IncomingTaskQueue::WillDestroyCurrentMessageLoop() {
@@ -64,6 +97,7 @@ void IncomingTaskQueue::WillDestroyCurrentMessageLoop() {
   }
 #endif
 
+  subtle::Release_Store(&message_loop_destroyed_, 1);
   AutoLock lock(incoming_queue_lock_);
   message_loop_ = NULL;
 }
@@ -71,6 +105,21 @@ void IncomingTaskQueue::WillDestroyCurrentMessageLoop() {
 IncomingTaskQueue::~IncomingTaskQueue() {
   // Verify that WillDestroyCurrentMessageLoop() has been called.
   DCHECK(!message_loop_);
+
+  // Tasks posted after the loop's final DeletePendingTasks() are destroyed
+  // here, as they were when |incoming_queue_| was a TaskQueue.
+  Node* node = TakeAllNodes();
+  while (node) {
+    Node* next = node->next;
+    node->task.Destroy();
+    delete node;
+    node = next;
+  }
+  while (free_nodes_) {
+    Node* next = free_nodes_->next;
+    delete free_nodes_;
+    free_nodes_ = next;
+  }
 }
 
 TimeTicks IncomingTaskQueue::CalculateDelayedRuntime(TimeDelta delay) {
@@ -112,36 +161,93 @@ TimeTicks IncomingTaskQueue::CalculateDelayedRuntime(TimeDelta delay) {
   return delayed_run_time;
 }
 
-bool IncomingTaskQueue::PostPendingTask(PendingTask* pending_task) {
+bool IncomingTaskQueue::PostNode(Node* node) {
   // Warning: Don't try to short-circuit, and handle this thread's tasks more
   // directly, as it could starve handling of foreign threads.  Put every task
   // into this queue.
 
-  // This should only be called while the lock is taken.
-  incoming_queue_lock_.AssertAcquired();
-
-  if (!message_loop_) {
-    pending_task->task.Reset();
-    return false;
-  }
-
   // Initialize the sequence number. The sequence number is used for delayed
   // tasks (to faciliate FIFO sorting when two tasks have the same
   // delayed_run_time value) and for identifying the task in about:tracing.
-  pending_task->sequence_num = next_sequence_num_++;
+  node->task->sequence_num =
+      subtle::NoBarrier_AtomicIncrement(&next_sequence_num_, 1) - 1;
 
   TRACE_EVENT_FLOW_BEGIN0(TRACE_DISABLED_BY_DEFAULT("toplevel.flow"),
       "MessageLoop::PostTask",
-      TRACE_ID_MANGLE(message_loop_->GetTaskTraceID(*pending_task)));
+      TRACE_ID_MANGLE(GetTaskTraceID(*node->task)));
+
+  // Push |node| onto the head of the list. The release barrier publishes the
+  // node's contents to the thread that detaches the list.
+  subtle::AtomicWord old_head = subtle::NoBarrier_Load(&incoming_queue_);
+  while (true) {
+    node->next = reinterpret_cast<Node*>(old_head);
+    subtle::AtomicWord prev = subtle::Release_CompareAndSwap(
+        &incoming_queue_, old_head, reinterpret_cast<subtle::AtomicWord>(node));
+    if (prev == old_head)
+      break;
+    old_head = prev;
+  }
+  bool was_empty = old_head == 0;
+
+  // Wake up the pump. This goes through the lock so that |message_loop_| is
+  // not destroyed while being notified; the pump only needs a nudge when the
+  // queue was empty, since otherwise a wakeup is already pending.
+  if (was_empty || always_schedule_work_) {
+    AutoLock locked(incoming_queue_lock_);
+    if (message_loop_)
+      message_loop_->ScheduleWork(was_empty);
+  }
+
+  return true;
+}
 
-  bool was_empty = incoming_queue_.empty();
-  incoming_queue_.push(*pending_task);
-  pending_task->task.Reset();
+IncomingTaskQueue::Node* IncomingTaskQueue::AllocateNode() {
+  // |free_nodes_| is only ever touched by the thread running the loop, so
+  // check that before looking at it.
+  if (MessageLoop::current() == owner_message_loop_ && free_nodes_) {
+    Node* node = free_nodes_;
+    free_nodes_ = node->next;
+    --free_node_count_;
+    node->next = NULL;
+    return node;
+  }
+  return new Node;
+}
+
+void IncomingTaskQueue::FreeNode(Node* node) {
+  DCHECK_EQ(owner_message_loop_, MessageLoop::current());
+  // Destroy the task right away so that whatever it holds on to is released
+  // before the next task runs, just as it would be without the cache.
+  node->task.Destroy();
+  if (free_node_count_ >= kMaxFreeNodes) {
+    delete node;
+    return;
+  }
+  node->next = free_nodes_;
+  free_nodes_ = node;
+  ++free_node_count_;
+}
 
-  // Wake up the pump.
-  message_loop_->ScheduleWork(was_empty);
+IncomingTaskQueue::Node* IncomingTaskQueue::TakeAllNodes() {
+  subtle::AtomicWord head = subtle::Acquire_Load(&incoming_queue_);
+  while (head) {
+    subtle::AtomicWord prev =
+        subtle::Acquire_CompareAndSwap(&incoming_queue_, head, 0);
+    if (prev == head)
+      break;
+    head = prev;
+  }
 
-  return true;
+  // The list is in reverse posting order, so flip it.
+  Node* reversed = NULL;
+  Node* node = reinterpret_cast<Node*>(head);
+  while (node) {
+    Node* next = node->next;
+    node->next = reversed;
+    reversed = node;
+    node = next;
+  }
+  return reversed;
 }
 
 }  // namespace internal
@@ -5,7 +5,9 @@
 #ifndef BASE_MESSAGE_LOOP_INCOMING_TASK_QUEUE_H_
 #define BASE_MESSAGE_LOOP_INCOMING_TASK_QUEUE_H_
 
+#include "base/atomicops.h"
 #include "base/base_export.h"
+#include "base/memory/manual_constructor.h"
 #include "base/memory/ref_counted.h"
 #include "base/pending_task.h"
 #include "base/synchronization/lock.h"
@@ -21,6 +23,15 @@ namespace internal {
 // Implements a queue of tasks posted to the message loop running on the current
 // thread. This class takes care of synchronizing posting tasks from different
 // threads and together with MessageLoop ensures clean shutdown.
+//
+// Posting does not take a lock in the common case: tasks are pushed onto a
+// lock-free singly linked list and the thread running the loop detaches the
+// whole list at once in ReloadWorkQueue(). The lock is only taken to wake up
+// the pump when the queue goes from empty to non-empty, so that the message
+// loop cannot be destroyed underneath ScheduleWork().
+//
+// The list nodes that tasks are built in are recycled by the thread running
+// the loop, which reuses them for the tasks it posts to itself.
 class BASE_EXPORT IncomingTaskQueue
     : public RefCountedThreadSafe<IncomingTaskQueue> {
  public:
@@ -49,40 +60,80 @@ class BASE_EXPORT IncomingTaskQueue
   // from the thread that is running the loop.
   void ReloadWorkQueue(TaskQueue* work_queue);
 
+  // Creates a process-wide unique ID to represent |task| in trace events.
+  uint64 GetTaskTraceID(const PendingTask& task) const;
+
   // Disconnects |this| from the parent message loop.
   void WillDestroyCurrentMessageLoop();
 
  private:
   friend class RefCountedThreadSafe<IncomingTaskQueue>;
+
+  // A node of the lock-free incoming list. |task| is constructed when the
+  // node is posted and destroyed when it is handed to the work queue, so the
+  // node itself can be reused.
+  struct Node {
+    Node() : next(NULL) {}
+
+    ManualConstructor<PendingTask> task;
+    Node* next;
+  };
+
   virtual ~IncomingTaskQueue();
 
   // Calculates the time at which a PendingTask should run.
   TimeTicks CalculateDelayedRuntime(TimeDelta delay);
 
-  // Adds a task to |incoming_queue_|. The caller retains ownership of
-  // |pending_task|, but this function will reset the value of
-  // |pending_task->task|. This is needed to ensure that the posting call stack
-  // does not retain |pending_task->task| beyond this function call.
-  bool PostPendingTask(PendingTask* pending_task);
+  // Adds |node|, whose task has been constructed, to |incoming_queue_| and
+  // takes ownership of it.
+  bool PostNode(Node* node);
+
+  // Returns a node with an unconstructed task, reusing a free node when called
+  // on the thread running the loop.
+  Node* AllocateNode();
+
+  // Destroys the task of |node| and keeps the node for reuse if there is room.
+  // Must be called on the thread running the loop.
+  void FreeNode(Node* node);
+
+  // Atomically detaches all the nodes of |incoming_queue_| and returns them
+  // in posting order.
+  Node* TakeAllNodes();
 
 #if defined(OS_WIN)
+  // Guarded by |incoming_queue_lock_|.
   TimeTicks high_resolution_timer_expiration_;
 #endif
 
-  // The lock that protects access to |incoming_queue_|, |message_loop_| and
-  // |next_sequence_num_|.
+  // The lock that protects access to |message_loop_|. Posting threads take it
+  // only when they need to wake up the pump.
   base::Lock incoming_queue_lock_;
 
-  // An incoming queue of tasks that are acquired under a mutex for processing
-  // on this instance's thread. These tasks have not yet been been pushed to
-  // |message_loop_|.
-  TaskQueue incoming_queue_;
+  // The head of a lock-free list of tasks that have not yet been pushed to
+  // |message_loop_|, most recently posted first. Holds a Node*.
+  subtle::AtomicWord incoming_queue_;
 
   // Points to the message loop that owns |this|.
   MessageLoop* message_loop_;
 
+  // Same as |message_loop_|, but never cleared. Only compared against
+  // MessageLoop::current() to tell whether we are on the loop's thread.
+  const MessageLoop* const owner_message_loop_;
+
+  // Set to nonzero once |message_loop_| is going away. Checked without the
+  // lock so that posting to a dead loop fails fast.
+  subtle::Atomic32 message_loop_destroyed_;
+
+  // True if the pump must be notified of every task rather than only when
+  // the queue was empty. See MessageLoop::AlwaysNotifyPumpForEveryTask().
+  const bool always_schedule_work_;
+
   // The next sequence number to use for delayed tasks.
-  int next_sequence_num_;
+  subtle::Atomic32 next_sequence_num_;
+
+  // Nodes available for reuse. Only accessed on the thread running the loop.
+  Node* free_nodes_;
+  size_t free_node_count_;
 
   DISALLOW_COPY_AND_ASSIGN(IncomingTaskQueue);
 };
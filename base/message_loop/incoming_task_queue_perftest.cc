@@ -0,0 +1,129 @@
+// Copyright 2014 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "base/message_loop/incoming_task_queue.h"
+
+#include "base/atomicops.h"
+#include "base/basictypes.h"
+#include "base/bind.h"
+#include "base/memory/scoped_vector.h"
+#include "base/message_loop/message_loop.h"
+#include "base/message_loop/message_loop_proxy.h"
+#include "base/strings/stringprintf.h"
+#include "base/synchronization/waitable_event.h"
+#include "base/threading/simple_thread.h"
+#include "base/threading/thread.h"
+#include "base/time/time.h"
+#include "testing/gtest/include/gtest/gtest.h"
+#include "testing/perf/perf_test.h"
+
+namespace base {
+
+namespace {
+
+// The total number of tasks posted for each producer count.
+const int kNumTasks = 1 << 20;
+
+// Counts down the tasks that have run on the target loop and signals once
+// they are all done.
+class TaskCounter {
+ public:
+  explicit TaskCounter(int count) : remaining_(count), done_(false, false) {}
+
+  void RunTask() {
+    if (subtle::NoBarrier_AtomicIncrement(&remaining_, -1) == 0)
+      done_.Signal();
+  }
+
+  void Wait() { done_.Wait(); }
+
+ private:
+  subtle::Atomic32 remaining_;
+  WaitableEvent done_;
+
+  DISALLOW_COPY_AND_ASSIGN(TaskCounter);
+};
+
+// Posts |num_tasks| tasks to |task_runner| once |start| is signaled.
+class Producer : public DelegateSimpleThread::Delegate {
+ public:
+  Producer(const scoped_refptr<MessageLoopProxy>& task_runner,
+           TaskCounter* counter,
+           WaitableEvent* start,
+           int num_tasks)
+      : task_runner_(task_runner),
+        counter_(counter),
+        start_(start),
+        num_tasks_(num_tasks) {}
+
+  virtual void Run() OVERRIDE {
+    start_->Wait();
+    Closure task = Bind(&TaskCounter::RunTask, Unretained(counter_));
+    for (int i = 0; i < num_tasks_; ++i)
+      task_runner_->PostTask(FROM_HERE, task);
+  }
+
+ private:
+  scoped_refptr<MessageLoopProxy> task_runner_;
+  TaskCounter* counter_;
+  WaitableEvent* start_;
+  const int num_tasks_;
+
+  DISALLOW_COPY_AND_ASSIGN(Producer);
+};
+
+void RunPostTaskTest(int num_producers) {
+  Thread target("IncomingTaskQueuePerfTarget");
+  ASSERT_TRUE(target.StartWithOptions(Thread::Options(MessageLoop::TYPE_IO,
+                                                      0)));
+
+  const int tasks_per_producer = kNumTasks / num_producers;
+  TaskCounter counter(tasks_per_producer * num_producers);
+  WaitableEvent start(true, false);
+
+  ScopedVector<Producer> producers;
+  ScopedVector<DelegateSimpleThread> threads;
+  for (int i = 0; i < num_producers; ++i) {
+    producers.push_back(new Producer(target.message_loop_proxy(), &counter,
+                                     &start, tasks_per_producer));
+    threads.push_back(new DelegateSimpleThread(
+        producers.back(), StringPrintf("Producer%d", i)));
+    threads.back()->Start();
+  }
+
+  TimeTicks begin = TimeTicks::HighResNow();
+  start.Signal();
+  for (size_t i = 0; i < threads.size(); ++i)
+    threads[i]->Join();
+  TimeDelta post_time = TimeTicks::HighResNow() - begin;
+  counter.Wait();
+  TimeDelta total_time = TimeTicks::HighResNow() - begin;
+  target.Stop();
+
+  const std::string modifier = StringPrintf("_%d_producers", num_producers);
+  perf_test::PrintResult("post_task", modifier, "posts_per_second",
+                         tasks_per_producer * num_producers /
+                             post_time.InSecondsF(),
+                         "posts/s", true);
+  perf_test::PrintResult("post_task", modifier, "runs_per_second",
+                         tasks_per_producer * num_producers /
+                             total_time.InSecondsF(),
+                         "runs/s", false);
+}
+
+TEST(IncomingTaskQueuePerfTest, PostTaskOneProducer) {
+  RunPostTaskTest(1);
+}
+
+TEST(IncomingTaskQueuePerfTest, PostTaskFourProducers) {
+  RunPostTaskTest(4);
+}
+
+TEST(IncomingTaskQueuePerfTest, PostTaskSixteenProducers) {
+  RunPostTaskTest(16);
+}
+
+}  // namespace
+
+}  // namespace base
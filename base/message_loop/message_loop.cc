@@ -115,6 +115,7 @@ MessageLoop::DestructionObserver::~DestructionObserver() {
 
 MessageLoop::MessageLoop(Type type)
     : type_(type),
+      next_delayed_entry_sequence_num_(0),
       nestable_tasks_allowed_(true),
 #if defined(OS_WIN)
       os_modal_loop_(false),
@@ -129,6 +130,7 @@ MessageLoop::MessageLoop(Type type)
 MessageLoop::MessageLoop(scoped_ptr<MessagePump> pump)
     : pump_(pump.Pass()),
       type_(TYPE_CUSTOM),
+      next_delayed_entry_sequence_num_(0),
       nestable_tasks_allowed_(true),
 #if defined(OS_WIN)
       os_modal_loop_(false),
@@ -285,6 +287,32 @@ void MessageLoop::PostNonNestableDelayedTask(
   incoming_task_queue_->AddToIncomingQueue(from_here, task, delay, false);
 }
 
+void MessageLoop::AddDelayedEntry(TimerWheel::Entry* entry) {
+  DCHECK_EQ(this, current());
+  PendingTask* pending_task = entry->mutable_pending_task();
+  DCHECK(!pending_task->task.is_null())
+      << pending_task->posted_from.ToString();
+  pending_task->sequence_num = next_delayed_entry_sequence_num_++;
+
+  bool is_first = delayed_work_queue_.empty() ||
+      pending_task->delayed_run_time < delayed_work_queue_.NextRunTime();
+  delayed_work_queue_.AddEntry(entry);
+  if (!is_first)
+    return;
+  // The pump only expects to be told about delayed work while it's running,
+  // as in DoWork(). Before that, wake it up as a posted task would.
+  if (run_loop_)
+    pump_->ScheduleDelayedWork(pending_task->delayed_run_time);
+  else
+    pump_->ScheduleWork();
+}
+
+void MessageLoop::RemoveDelayedEntry(TimerWheel::Entry* entry) {
+  DCHECK_EQ(this, current());
+  // The pump may wake up for nothing, but it finds out the next run time then.
+  delayed_work_queue_.RemoveEntry(entry);
+}
+
 void MessageLoop::Run() {
   RunLoop run_loop;
   run_loop.Run();
@@ -470,7 +498,7 @@ bool MessageLoop::DeferOrRunPendingTask(const PendingTask& pending_task) {
 
 void MessageLoop::AddToDelayedWorkQueue(const PendingTask& pending_task) {
   // Move to the delayed work queue.
-  delayed_work_queue_.push(pending_task);
+  delayed_work_queue_.AddTask(pending_task);
 }
 
 bool MessageLoop::DeletePendingTasks() {
@@ -496,15 +524,12 @@ bool MessageLoop::DeletePendingTasks() {
   // code is replicating legacy behavior, and should not be considered
   // absolutely "correct" behavior.  See TODO above about deleting all tasks
   // when it's safe.
-  while (!delayed_work_queue_.empty()) {
-    delayed_work_queue_.pop();
-  }
+  delayed_work_queue_.Clear();
   return did_work;
 }
 
 uint64 MessageLoop::GetTaskTraceID(const PendingTask& task) {
-  return (static_cast<uint64>(task.sequence_num) << 32) |
-         ((static_cast<uint64>(reinterpret_cast<intptr_t>(this)) << 32) >> 32);
+  return incoming_task_queue_->GetTaskTraceID(task);
 }
 
 void MessageLoop::ReloadWorkQueue() {
@@ -523,6 +548,10 @@ void MessageLoop::ScheduleWork(bool was_empty) {
     pump_->ScheduleWork();
 }
 
+bool MessageLoop::AlwaysNotifyPumpForEveryTask() const {
+  return AlwaysNotifyPump(type_);
+}
+
 //------------------------------------------------------------------------------
 // Method and data for histogramming events and actions taken by each instance
 // on each thread.
@@ -565,9 +594,11 @@ bool MessageLoop::DoWork() {
       PendingTask pending_task = work_queue_.front();
       work_queue_.pop();
       if (!pending_task.delayed_run_time.is_null()) {
-        AddToDelayedWorkQueue(pending_task);
         // If we changed the topmost task, then it is time to reschedule.
-        if (delayed_work_queue_.top().task.Equals(pending_task.task))
+        bool is_first = delayed_work_queue_.empty() ||
+            pending_task.delayed_run_time < delayed_work_queue_.NextRunTime();
+        AddToDelayedWorkQueue(pending_task);
+        if (is_first)
           pump_->ScheduleDelayedWork(pending_task.delayed_run_time);
       } else {
         if (DeferOrRunPendingTask(pending_task))
@@ -593,7 +624,7 @@ bool MessageLoop::DoDelayedWork(TimeTicks* next_delayed_work_time) {
   // fall behind (and have a lot of ready-to-run delayed tasks), the more
   // efficient we'll be at handling the tasks.
 
-  TimeTicks next_run_time = delayed_work_queue_.top().delayed_run_time;
+  TimeTicks next_run_time = delayed_work_queue_.NextRunTime();
   if (next_run_time > recent_time_) {
     recent_time_ = TimeTicks::Now();  // Get a better view of Now();
     if (next_run_time > recent_time_) {
@@ -602,11 +633,10 @@ bool MessageLoop::DoDelayedWork(TimeTicks* next_delayed_work_time) {
     }
   }
 
-  PendingTask pending_task = delayed_work_queue_.top();
-  delayed_work_queue_.pop();
+  PendingTask pending_task = delayed_work_queue_.PopDueTask(recent_time_);
 
   if (!delayed_work_queue_.empty())
-    *next_delayed_work_time = delayed_work_queue_.top().delayed_run_time;
+    *next_delayed_work_time = delayed_work_queue_.NextRunTime();
 
   return DeferOrRunPendingTask(pending_task);
 }
@@ -18,6 +18,7 @@
 #include "base/message_loop/message_loop_proxy.h"
 #include "base/message_loop/message_loop_proxy_impl.h"
 #include "base/message_loop/message_pump.h"
+#include "base/message_loop/timer_wheel.h"
 #include "base/observer_list.h"
 #include "base/pending_task.h"
 #include "base/sequenced_task_runner_helpers.h"
@@ -223,6 +224,17 @@ class BASE_EXPORT MessageLoop : public MessagePump::Delegate {
                                   const Closure& task,
                                   TimeDelta delay);
 
+  // Schedules the task of |entry| to run at its delayed_run_time, on this
+  // loop's thread. Unlike a task posted with PostDelayedTask(), it can be
+  // cancelled with RemoveDelayedEntry() in constant time, leaving nothing
+  // behind in the queue; this is how base::Timer is implemented. |entry| is
+  // owned by the caller. It must stay alive until its task runs, it's removed,
+  // or its OnDropped() method is called by the loop's destructor.
+  //
+  // NOTE: These methods must be called on the thread that runs the loop.
+  void AddDelayedEntry(TimerWheel::Entry* entry);
+  void RemoveDelayedEntry(TimerWheel::Entry* entry);
+
   // A variant on PostTask that deletes the given object.  This is useful
   // if the object needs to live until the next run of the MessageLoop (for
   // example, deleting a RenderProcessHost from within an IPC callback is not
@@ -457,8 +469,8 @@ class BASE_EXPORT MessageLoop : public MessagePump::Delegate {
   bool DeletePendingTasks();
 
   // Creates a process-wide unique ID to represent this task in trace events.
-  // This will be mangled with a Process ID hash to reduce the likelyhood of
-  // colliding with MessageLoop pointers on other processes.
+  // This must match the ID used when the task was posted, so it is computed
+  // by |incoming_task_queue_|.
   uint64 GetTaskTraceID(const PendingTask& task);
 
   // Loads tasks from the incoming queue to |work_queue_| if the latter is
@@ -469,6 +481,10 @@ class BASE_EXPORT MessageLoop : public MessagePump::Delegate {
   // responsible for synchronizing ScheduleWork() calls.
   void ScheduleWork(bool was_empty);
 
+  // Returns true if ScheduleWork() must be called for every posted task, not
+  // only when the incoming queue was empty.
+  bool AlwaysNotifyPumpForEveryTask() const;
+
   // Start recording histogram info about events and action IF it was enabled
   // and IF the statistics recorder can accept a registration of our histogram.
   void StartHistogrammer();
@@ -492,7 +508,11 @@ class BASE_EXPORT MessageLoop : public MessagePump::Delegate {
   TaskQueue work_queue_;
 
   // Contains delayed tasks, sorted by their 'delayed_run_time' property.
-  DelayedTaskQueue delayed_work_queue_;
+  TimerWheel delayed_work_queue_;
+
+  // Sequence numbers for the entries added with AddDelayedEntry(). They only
+  // order these entries among themselves if they have the same run time.
+  int next_delayed_entry_sequence_num_;
 
   // A recent snapshot of Time::Now(), used to check delayed_work_queue_.
   TimeTicks recent_time_;
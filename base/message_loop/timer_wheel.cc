@@ -0,0 +1,307 @@
+// Copyright 2014 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "base/message_loop/timer_wheel.h"
+
+#include <string.h>
+
+#include <algorithm>
+
+#include "base/logging.h"
+
+namespace base {
+
+namespace {
+
+uint64 TickForTime(TimeTicks time) {
+  int64 us = time.ToInternalValue();
+  return us > 0 ? static_cast<uint64>(us) / Time::kMicrosecondsPerMillisecond
+                : 0;
+}
+
+int FindFirstSetBit(uint64 word) {
+  DCHECK(word);
+#if defined(COMPILER_GCC)
+  return __builtin_ctzll(word);
+#else
+  int bit = 0;
+  while (!(word & 1)) {
+    word >>= 1;
+    ++bit;
+  }
+  return bit;
+#endif
+}
+
+}  // namespace
+
+TimerWheel::Entry::Entry(const PendingTask& pending_task)
+    : pending_task_(pending_task),
+      wheel_(NULL),
+      prev_(NULL),
+      next_(NULL),
+      tick_(0),
+      level_(kReadyLevel),
+      owned_by_wheel_(false) {
+}
+
+TimerWheel::Entry::~Entry() {
+  DCHECK(!wheel_);
+}
+
+TimerWheel::TimerWheel()
+    : ready_head_(NULL),
+      ready_tail_(NULL),
+      current_tick_(TickForTime(TimeTicks::Now())),
+      size_(0),
+      next_run_time_valid_(true) {
+  memset(buckets_, 0, sizeof(buckets_));
+  memset(occupied_buckets_, 0, sizeof(occupied_buckets_));
+}
+
+TimerWheel::~TimerWheel() {
+  Clear();
+}
+
+void TimerWheel::AddTask(const PendingTask& pending_task) {
+  Entry* entry = new Entry(pending_task);
+  entry->owned_by_wheel_ = true;
+  AddEntry(entry);
+}
+
+void TimerWheel::AddEntry(Entry* entry) {
+  DCHECK(!entry->wheel_);
+  DCHECK(!entry->pending_task_.delayed_run_time.is_null());
+  entry->wheel_ = this;
+  entry->tick_ = TickForTime(entry->pending_task_.delayed_run_time);
+  Link(entry);
+
+  TimeTicks run_time = entry->pending_task_.delayed_run_time;
+  if (size_++ == 0) {
+    next_run_time_ = run_time;
+    next_run_time_valid_ = true;
+  } else if (next_run_time_valid_ && run_time < next_run_time_) {
+    next_run_time_ = run_time;
+  }
+}
+
+void TimerWheel::RemoveEntry(Entry* entry) {
+  DCHECK_EQ(this, entry->wheel_);
+  Unlink(entry);
+  entry->wheel_ = NULL;
+  --size_;
+  // The entry may have been the first one.
+  if (entry->pending_task_.delayed_run_time <= next_run_time_)
+    next_run_time_valid_ = false;
+}
+
+TimeTicks TimerWheel::NextRunTime() const {
+  if (next_run_time_valid_)
+    return next_run_time_;
+
+  next_run_time_valid_ = true;
+  if (ready_head_) {
+    next_run_time_ = ready_head_->pending_task_.delayed_run_time;
+    return next_run_time_;
+  }
+
+  int level;
+  int bucket;
+  if (!FindNextBucket(&level, &bucket)) {
+    next_run_time_ = TimeTicks();
+    return next_run_time_;
+  }
+  // The bucket isn't sorted. Its entries are close together in the lowest
+  // levels, which is where this is usually called, and when the first entry
+  // is in a wider bucket the result is cached until that entry goes away.
+  const Entry* first = buckets_[level][bucket];
+  for (const Entry* entry = first->next_; entry; entry = entry->next_) {
+    if (RunsBefore(entry, first))
+      first = entry;
+  }
+  next_run_time_ = first->pending_task_.delayed_run_time;
+  return next_run_time_;
+}
+
+PendingTask TimerWheel::PopDueTask(TimeTicks now) {
+  uint64 tick = TickForTime(now);
+  while (!ready_head_ && AdvanceOneStep(tick)) {
+  }
+  CHECK(ready_head_);
+  DCHECK(ready_head_->pending_task_.delayed_run_time <= now);
+
+  Entry* entry = TakeFirstReadyEntry();
+  PendingTask pending_task = entry->pending_task_;
+  if (entry->owned_by_wheel_)
+    delete entry;
+  return pending_task;
+}
+
+void TimerWheel::Clear() {
+  while (size_) {
+    while (!ready_head_)
+      AdvanceOneStep(kuint64max);
+
+    Entry* entry = TakeFirstReadyEntry();
+    // Either of these may add or remove other entries.
+    if (entry->owned_by_wheel_)
+      delete entry;
+    else
+      entry->OnDropped();
+  }
+}
+
+// static
+bool TimerWheel::RunsBefore(const Entry* a, const Entry* b) {
+  // PendingTask's ordering is reversed, for std::priority_queue.
+  return b->pending_task_ < a->pending_task_;
+}
+
+void TimerWheel::Link(Entry* entry) {
+  if (entry->tick_ <= current_tick_) {
+    InsertIntoReadyList(entry);
+    return;
+  }
+
+  // The level is given by the highest bits in which the entry's tick differs
+  // from the current one.
+  uint64 difference = entry->tick_ ^ current_tick_;
+  int level = 0;
+  while (level < kNumLevels - 1 &&
+         (difference >> (kBitsPerLevel * (level + 1))) != 0) {
+    ++level;
+  }
+  int bucket = static_cast<int>(entry->tick_ >> (kBitsPerLevel * level)) &
+               (kBucketsPerLevel - 1);
+
+  entry->level_ = level;
+  entry->prev_ = NULL;
+  entry->next_ = buckets_[level][bucket];
+  if (entry->next_)
+    entry->next_->prev_ = entry;
+  buckets_[level][bucket] = entry;
+  occupied_buckets_[level] |= GG_UINT64_C(1) << bucket;
+}
+
+void TimerWheel::Unlink(Entry* entry) {
+  if (entry->level_ == kReadyLevel) {
+    if (entry->prev_)
+      entry->prev_->next_ = entry->next_;
+    else
+      ready_head_ = entry->next_;
+    if (entry->next_)
+      entry->next_->prev_ = entry->prev_;
+    else
+      ready_tail_ = entry->prev_;
+  } else {
+    int bucket = static_cast<int>(entry->tick_ >>
+                                  (kBitsPerLevel * entry->level_)) &
+                 (kBucketsPerLevel - 1);
+    if (entry->prev_) {
+      entry->prev_->next_ = entry->next_;
+    } else {
+      buckets_[entry->level_][bucket] = entry->next_;
+      if (!entry->next_)
+        occupied_buckets_[entry->level_] &= ~(GG_UINT64_C(1) << bucket);
+    }
+    if (entry->next_)
+      entry->next_->prev_ = entry->prev_;
+  }
+  entry->prev_ = NULL;
+  entry->next_ = NULL;
+}
+
+void TimerWheel::InsertIntoReadyList(Entry* entry) {
+  // Tasks are mostly added in the order they run, so search from the end.
+  Entry* previous = ready_tail_;
+  while (previous && RunsBefore(entry, previous))
+    previous = previous->prev_;
+
+  entry->level_ = kReadyLevel;
+  entry->prev_ = previous;
+  entry->next_ = previous ? previous->next_ : ready_head_;
+  if (entry->next_)
+    entry->next_->prev_ = entry;
+  else
+    ready_tail_ = entry;
+  if (previous)
+    previous->next_ = entry;
+  else
+    ready_head_ = entry;
+}
+
+void TimerWheel::AppendToReadyList(Entry* entry) {
+  entry->level_ = kReadyLevel;
+  entry->prev_ = ready_tail_;
+  entry->next_ = NULL;
+  if (ready_tail_)
+    ready_tail_->next_ = entry;
+  else
+    ready_head_ = entry;
+  ready_tail_ = entry;
+}
+
+bool TimerWheel::FindNextBucket(int* level, int* bucket) const {
+  for (int i = 0; i < kNumLevels; ++i) {
+    if (occupied_buckets_[i]) {
+      *level = i;
+      *bucket = FindFirstSetBit(occupied_buckets_[i]);
+      return true;
+    }
+  }
+  return false;
+}
+
+uint64 TimerWheel::BucketStart(int level, int bucket) const {
+  int shift = kBitsPerLevel * level;
+  int prefix_shift = shift + kBitsPerLevel;
+  uint64 prefix = prefix_shift < 64 ?
+      (current_tick_ >> prefix_shift) << prefix_shift : 0;
+  return prefix | (static_cast<uint64>(bucket) << shift);
+}
+
+bool TimerWheel::AdvanceOneStep(uint64 tick) {
+  int level;
+  int bucket;
+  if (!FindNextBucket(&level, &bucket) || BucketStart(level, bucket) > tick) {
+    current_tick_ = std::max(current_tick_, tick);
+    return false;
+  }
+
+  uint64 start = BucketStart(level, bucket);
+  DCHECK_GT(start, current_tick_);
+  current_tick_ = start;
+
+  Entry* entry = buckets_[level][bucket];
+  buckets_[level][bucket] = NULL;
+  occupied_buckets_[level] &= ~(GG_UINT64_C(1) << bucket);
+
+  // The entries due at the new tick run after everything already in the
+  // ready list, and the others all go to lower levels.
+  sort_buffer_.clear();
+  while (entry) {
+    Entry* next = entry->next_;
+    if (entry->tick_ <= current_tick_)
+      sort_buffer_.push_back(entry);
+    else
+      Link(entry);
+    entry = next;
+  }
+  std::sort(sort_buffer_.begin(), sort_buffer_.end(), &TimerWheel::RunsBefore);
+  for (size_t i = 0; i < sort_buffer_.size(); ++i)
+    AppendToReadyList(sort_buffer_[i]);
+  return true;
+}
+
+TimerWheel::Entry* TimerWheel::TakeFirstReadyEntry() {
+  Entry* entry = ready_head_;
+  DCHECK(entry);
+  Unlink(entry);
+  entry->wheel_ = NULL;
+  --size_;
+  next_run_time_valid_ = false;
+  return entry;
+}
+
+}  // namespace base
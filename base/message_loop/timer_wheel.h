@@ -0,0 +1,162 @@
+// Copyright 2014 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef BASE_MESSAGE_LOOP_TIMER_WHEEL_H_
+#define BASE_MESSAGE_LOOP_TIMER_WHEEL_H_
+
+#include <vector>
+
+#include "base/base_export.h"
+#include "base/basictypes.h"
+#include "base/pending_task.h"
+#include "base/time/time.h"
+
+namespace base {
+
+// The store for MessageLoop's delayed tasks. It's a hierarchical timing wheel:
+// tasks are hashed by their run time, in milliseconds, into buckets of
+// increasing width, so adding or removing a task takes constant time however
+// many of them are pending. As time goes by, the tasks in the buckets that
+// are about to expire are moved down to narrower ones, and finally into a
+// short list sorted by run time and sequence number, from which they're
+// popped in exactly the order a priority queue would give them.
+//
+// Besides the tasks posted to the MessageLoop, which the wheel owns, it holds
+// Entry objects owned by their users. These can be removed from the wheel or
+// moved to a new run time in constant time, so that base::Timer doesn't leave
+// an abandoned task behind each time it is stopped or reset.
+//
+// This class is not thread safe.
+class BASE_EXPORT TimerWheel {
+ public:
+  class BASE_EXPORT Entry {
+   public:
+    explicit Entry(const PendingTask& pending_task);
+    virtual ~Entry();
+
+    // The task to run. It can only be changed while the entry isn't in a
+    // wheel; its |delayed_run_time| is the time it's scheduled for.
+    PendingTask* mutable_pending_task() { return &pending_task_; }
+    const PendingTask& pending_task() const { return pending_task_; }
+
+    bool IsScheduled() const { return wheel_ != NULL; }
+
+   protected:
+    // Called when the wheel is cleared before the task could run. The entry
+    // has been removed from the wheel, and may be deleted.
+    virtual void OnDropped() {}
+
+   private:
+    friend class TimerWheel;
+
+    PendingTask pending_task_;
+
+    // The wheel this entry is in, or NULL.
+    TimerWheel* wheel_;
+
+    // Links in the list for the entry's bucket, or in the ready list.
+    Entry* prev_;
+    Entry* next_;
+
+    // |delayed_run_time| in milliseconds, and the level of the bucket holding
+    // the entry, or kReadyLevel.
+    uint64 tick_;
+    int level_;
+
+    // True for the entries that the wheel allocated in AddTask().
+    bool owned_by_wheel_;
+
+    DISALLOW_COPY_AND_ASSIGN(Entry);
+  };
+
+  TimerWheel();
+  ~TimerWheel();
+
+  bool empty() const { return size_ == 0; }
+  size_t size() const { return size_; }
+
+  // Adds a copy of |pending_task|, which has to have a delayed_run_time.
+  void AddTask(const PendingTask& pending_task);
+
+  // Adds |entry|, which must not be in a wheel, to be run at its task's
+  // delayed_run_time. It stays owned by the caller, and has to be removed
+  // before it is deleted.
+  void AddEntry(Entry* entry);
+
+  // Removes |entry|, which has to be in this wheel.
+  void RemoveEntry(Entry* entry);
+
+  // Returns the run time of the task that will run first, or a null TimeTicks
+  // if the wheel is empty.
+  TimeTicks NextRunTime() const;
+
+  // Removes the first task from the wheel and returns it. It has to be due at
+  // |now|, i.e. NextRunTime() must not be later than |now|.
+  PendingTask PopDueTask(TimeTicks now);
+
+  // Removes all the tasks, in the order in which they would run. The ones the
+  // wheel owns are deleted, and the other entries are notified through
+  // Entry::OnDropped(). Entries added meanwhile are removed as well.
+  void Clear();
+
+ private:
+  // Each level has 64 buckets, each 64 times wider than those in the level
+  // below. With 1ms ticks that's enough to cover any 64-bit time.
+  static const int kBitsPerLevel = 6;
+  static const int kBucketsPerLevel = 1 << kBitsPerLevel;
+  static const int kNumLevels = (64 + kBitsPerLevel - 1) / kBitsPerLevel;
+  static const int kReadyLevel = -1;
+
+  // Returns true if |a| should run before |b|.
+  static bool RunsBefore(const Entry* a, const Entry* b);
+
+  // Links |entry| into the bucket for its tick relative to |current_tick_|,
+  // or into the ready list if that tick has been reached.
+  void Link(Entry* entry);
+  void Unlink(Entry* entry);
+  void InsertIntoReadyList(Entry* entry);
+  void AppendToReadyList(Entry* entry);
+
+  // Finds the first non-empty bucket. Returns false if there's none.
+  bool FindNextBucket(int* level, int* bucket) const;
+
+  // Returns the first tick covered by |bucket| of |level|.
+  uint64 BucketStart(int level, int bucket) const;
+
+  // Moves |current_tick_| forward to |tick|, or to the start of the first
+  // non-empty bucket if that's earlier, and redistributes the entries of that
+  // bucket. Returns false if |current_tick_| reached |tick|.
+  bool AdvanceOneStep(uint64 tick);
+
+  // Removes the first entry of the ready list, which must not be empty.
+  Entry* TakeFirstReadyEntry();
+
+  // Entries whose tick is at most |current_tick_|, sorted with RunsBefore().
+  Entry* ready_head_;
+  Entry* ready_tail_;
+
+  // buckets_[level][i] is a list of the entries that share all the bits of
+  // |current_tick_| above the ones for |level|, and have i in these bits.
+  // Since i is always greater than the corresponding bits of |current_tick_|,
+  // every entry in a level runs before those in the levels above, and the
+  // buckets of a level are in the same order as their indices.
+  Entry* buckets_[kNumLevels][kBucketsPerLevel];
+  uint64 occupied_buckets_[kNumLevels];
+
+  uint64 current_tick_;
+  size_t size_;
+
+  // The result of NextRunTime(), computed lazily.
+  mutable TimeTicks next_run_time_;
+  mutable bool next_run_time_valid_;
+
+  // Scratch space for sorting the entries moved to the ready list.
+  std::vector<Entry*> sort_buffer_;
+
+  DISALLOW_COPY_AND_ASSIGN(TimerWheel);
+};
+
+}  // namespace base
+
+#endif  // BASE_MESSAGE_LOOP_TIMER_WHEEL_H_
@@ -0,0 +1,181 @@
+// Copyright 2014 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "base/message_loop/timer_wheel.h"
+
+#include <queue>
+#include <vector>
+
+#include "base/bind.h"
+#include "base/bind_helpers.h"
+#include "base/rand_util.h"
+#include "testing/gtest/include/gtest/gtest.h"
+
+namespace base {
+
+namespace {
+
+void RecordRun(std::vector<int>* order, int id) {
+  order->push_back(id);
+}
+
+PendingTask MakeTask(std::vector<int>* order,
+                     int id,
+                     TimeTicks run_time,
+                     int sequence_num) {
+  PendingTask pending_task(FROM_HERE, Bind(&RecordRun, order, id), run_time,
+                           true);
+  pending_task.sequence_num = sequence_num;
+  return pending_task;
+}
+
+// Runs all the tasks in |wheel| in order, regardless of their run time.
+void RunAll(TimerWheel* wheel) {
+  while (!wheel->empty()) {
+    TimeTicks next_run_time = wheel->NextRunTime();
+    PendingTask pending_task = wheel->PopDueTask(next_run_time);
+    EXPECT_EQ(next_run_time, pending_task.delayed_run_time);
+    pending_task.task.Run();
+  }
+}
+
+class TestEntry : public TimerWheel::Entry {
+ public:
+  TestEntry(std::vector<int>* order, int id, TimeTicks run_time)
+      : TimerWheel::Entry(MakeTask(order, id, run_time, id)),
+        dropped_(false) {
+  }
+
+  bool dropped() const { return dropped_; }
+
+ private:
+  virtual void OnDropped() OVERRIDE {
+    dropped_ = true;
+  }
+
+  bool dropped_;
+};
+
+class DeletionFlag {
+ public:
+  explicit DeletionFlag(bool* deleted) : deleted_(deleted) {}
+  ~DeletionFlag() { *deleted_ = true; }
+
+ private:
+  bool* deleted_;
+};
+
+void IgnoreFlag(DeletionFlag* flag) {
+}
+
+}  // namespace
+
+TEST(TimerWheelTest, RunsInPriorityQueueOrder) {
+  TimeTicks now = TimeTicks::Now();
+  TimerWheel wheel;
+  DelayedTaskQueue queue;
+  std::vector<int> order;
+  std::vector<int> expected_order;
+
+  // Delays from a fraction of a millisecond to a few weeks, with some equal
+  // run times and some in the past.
+  for (int i = 0; i < 5000; ++i) {
+    int64 max_delay_us = GG_INT64_C(1) << RandInt(0, 41);
+    TimeTicks run_time = now + TimeDelta::FromMicroseconds(
+        RandInt(0, 9) == 0 ? 0 : RandGenerator(max_delay_us) - 1000);
+    PendingTask pending_task = MakeTask(&order, i, run_time, i);
+    wheel.AddTask(pending_task);
+    queue.push(pending_task);
+  }
+  EXPECT_EQ(5000u, wheel.size());
+
+  while (!queue.empty()) {
+    queue.top().task.Run();
+    queue.pop();
+  }
+  expected_order.swap(order);
+  RunAll(&wheel);
+  EXPECT_EQ(expected_order, order);
+}
+
+TEST(TimerWheelTest, OnlyDueTasksArePopped) {
+  TimeTicks now = TimeTicks::Now();
+  TimerWheel wheel;
+  std::vector<int> order;
+  EXPECT_TRUE(wheel.NextRunTime().is_null());
+
+  TimeTicks later = now + TimeDelta::FromMilliseconds(150);
+  TimeTicks soon = now + TimeDelta::FromMicroseconds(300);
+  wheel.AddTask(MakeTask(&order, 1, later, 1));
+  EXPECT_EQ(later, wheel.NextRunTime());
+  wheel.AddTask(MakeTask(&order, 2, soon, 2));
+  EXPECT_EQ(soon, wheel.NextRunTime());
+
+  wheel.PopDueTask(soon).task.Run();
+  EXPECT_EQ(later, wheel.NextRunTime());
+  EXPECT_EQ(1u, wheel.size());
+
+  // A task added behind the wheel's position still comes first.
+  wheel.AddTask(MakeTask(&order, 3, now, 3));
+  EXPECT_EQ(now, wheel.NextRunTime());
+  RunAll(&wheel);
+  ASSERT_EQ(3u, order.size());
+  EXPECT_EQ(2, order[0]);
+  EXPECT_EQ(3, order[1]);
+  EXPECT_EQ(1, order[2]);
+}
+
+TEST(TimerWheelTest, RemoveAndReaddEntries) {
+  TimeTicks now = TimeTicks::Now();
+  TimerWheel wheel;
+  std::vector<int> order;
+
+  TestEntry first(&order, 1, now + TimeDelta::FromSeconds(10));
+  TestEntry second(&order, 2, now + TimeDelta::FromSeconds(20));
+  wheel.AddEntry(&first);
+  wheel.AddEntry(&second);
+  wheel.AddTask(MakeTask(&order, 3, now + TimeDelta::FromSeconds(15), 3));
+  EXPECT_TRUE(first.IsScheduled());
+  EXPECT_EQ(first.pending_task().delayed_run_time, wheel.NextRunTime());
+
+  // Move the first entry after the others.
+  wheel.RemoveEntry(&first);
+  EXPECT_FALSE(first.IsScheduled());
+  EXPECT_EQ(now + TimeDelta::FromSeconds(15), wheel.NextRunTime());
+  first.mutable_pending_task()->delayed_run_time = now + TimeDelta::FromSeconds(30);
+  wheel.AddEntry(&first);
+
+  wheel.RemoveEntry(&second);
+  EXPECT_EQ(2u, wheel.size());
+
+  RunAll(&wheel);
+  ASSERT_EQ(2u, order.size());
+  EXPECT_EQ(3, order[0]);
+  EXPECT_EQ(1, order[1]);
+  EXPECT_FALSE(first.IsScheduled());
+  EXPECT_FALSE(first.dropped());
+}
+
+TEST(TimerWheelTest, Clear) {
+  TimeTicks now = TimeTicks::Now();
+  std::vector<int> order;
+  bool task_deleted = false;
+  TestEntry entry(&order, 1, now + TimeDelta::FromDays(1));
+  {
+    TimerWheel wheel;
+    wheel.AddEntry(&entry);
+    wheel.AddTask(PendingTask(
+        FROM_HERE, Bind(&IgnoreFlag, Owned(new DeletionFlag(&task_deleted))),
+        now + TimeDelta::FromMilliseconds(1), true));
+    wheel.Clear();
+    EXPECT_TRUE(wheel.empty());
+    EXPECT_TRUE(wheel.NextRunTime().is_null());
+  }
+  EXPECT_TRUE(task_deleted);
+  EXPECT_TRUE(entry.dropped());
+  EXPECT_FALSE(entry.IsScheduled());
+  EXPECT_TRUE(order.empty());
+}
+
+}  // namespace base
@@ -14,8 +14,10 @@
 #include <algorithm>
 #include <string>
 
+#include "base/atomic_sequence_num.h"
 #include "base/compiler_specific.h"
 #include "base/debug/alias.h"
+#include "base/lazy_instance.h"
 #include "base/logging.h"
 #include "base/metrics/sample_vector.h"
 #include "base/metrics/statistics_recorder.h"
@@ -23,6 +25,7 @@
 #include "base/strings/string_util.h"
 #include "base/strings/stringprintf.h"
 #include "base/synchronization/lock.h"
+#include "base/threading/thread_local.h"
 #include "base/values.h"
 
 using std::string;
@@ -32,6 +35,22 @@ namespace base {
 
 namespace {
 
+// The sample shard used by each thread, plus one so that zero means that none
+// has been picked yet. Threads are handed the shards in turn.
+LazyInstance<ThreadLocalPointer<void> >::Leaky g_sample_shard_for_thread =
+    LAZY_INSTANCE_INITIALIZER;
+StaticAtomicSequenceNumber g_next_sample_shard;
+
+size_t GetSampleShardForCurrentThread(size_t shard_count) {
+  ThreadLocalPointer<void>* tls = g_sample_shard_for_thread.Pointer();
+  intptr_t shard_plus_one = reinterpret_cast<intptr_t>(tls->Get());
+  if (!shard_plus_one) {
+    shard_plus_one = g_next_sample_shard.GetNext() % shard_count + 1;
+    tls->Set(reinterpret_cast<void*>(shard_plus_one));
+  }
+  return shard_plus_one - 1;
+}
+
 bool ReadHistogramArguments(PickleIterator* iter,
                             string* histogram_name,
                             int* flags,
@@ -262,7 +281,7 @@ void Histogram::Add(int value) {
     value = kSampleType_MAX - 1;
   if (value < 0)
     value = 0;
-  samples_->Accumulate(value, 1);
+  GetSamplesForCurrentThread()->Accumulate(value, 1);
 }
 
 scoped_ptr<HistogramSamples> Histogram::SnapshotSamples() const {
@@ -309,9 +328,13 @@ Histogram::Histogram(const string& name,
     declared_max_(maximum) {
   if (ranges)
     samples_.reset(new SampleVector(ranges));
+  for (size_t i = 0; i < arraysize(sample_shards_); ++i)
+    sample_shards_[i] = 0;
 }
 
 Histogram::~Histogram() {
+  for (size_t i = 0; i < arraysize(sample_shards_); ++i)
+    delete reinterpret_cast<SampleVector*>(sample_shards_[i]);
 }
 
 bool Histogram::PrintEmptyBucket(size_t index) const {
@@ -367,9 +390,36 @@ HistogramBase* Histogram::DeserializeInfoImpl(PickleIterator* iter) {
 scoped_ptr<SampleVector> Histogram::SnapshotSampleVector() const {
   scoped_ptr<SampleVector> samples(new SampleVector(bucket_ranges()));
   samples->Add(*samples_);
+  for (size_t i = 0; i < arraysize(sample_shards_); ++i) {
+    const SampleVector* shard = reinterpret_cast<const SampleVector*>(
+        subtle::Acquire_Load(&sample_shards_[i]));
+    if (shard)
+      samples->Add(*shard);
+  }
   return samples.Pass();
 }
 
+SampleVector* Histogram::GetSamplesForCurrentThread() {
+  size_t shard_index = GetSampleShardForCurrentThread(kSampleShardCount);
+  if (shard_index == 0)
+    return samples_.get();
+
+  subtle::AtomicWord* slot = &sample_shards_[shard_index - 1];
+  SampleVector* shard =
+      reinterpret_cast<SampleVector*>(subtle::Acquire_Load(slot));
+  if (shard)
+    return shard;
+
+  shard = new SampleVector(bucket_ranges());
+  if (subtle::Release_CompareAndSwap(
+          slot, 0, reinterpret_cast<subtle::AtomicWord>(shard)) != 0) {
+    // Another thread sharing the slot got there first.
+    delete shard;
+    shard = reinterpret_cast<SampleVector*>(subtle::Acquire_Load(slot));
+  }
+  return shard;
+}
+
 void Histogram::WriteAsciiImpl(bool graph_it,
                                const string& newline,
                                string* output) const {
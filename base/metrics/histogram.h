@@ -507,6 +507,10 @@ class BASE_EXPORT Histogram : public HistogramBase {
   // Implementation of SnapshotSamples function.
   scoped_ptr<SampleVector> SnapshotSampleVector() const;
 
+  // Returns the samples that Add() should record into on the current thread,
+  // creating them if needed.
+  SampleVector* GetSamplesForCurrentThread();
+
   //----------------------------------------------------------------------------
   // Helpers for emitting Ascii graphic.  Each method appends data to output.
 
@@ -545,6 +549,13 @@ class BASE_EXPORT Histogram : public HistogramBase {
   // sample.
   scoped_ptr<SampleVector> samples_;
 
+  // Threads are spread over |samples_| and these additional SampleVectors, so
+  // that a histogram recorded from several threads doesn't have them all
+  // writing to the same cache lines. They are created on first use, and are
+  // only combined when a snapshot is taken. Each entry is a SampleVector*.
+  static const size_t kSampleShardCount = 8;
+  subtle::AtomicWord sample_shards_[kSampleShardCount - 1];
+
   DISALLOW_COPY_AND_ASSIGN(Histogram);
 };
 
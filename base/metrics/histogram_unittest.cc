@@ -15,6 +15,7 @@
 #include "base/metrics/sample_vector.h"
 #include "base/metrics/statistics_recorder.h"
 #include "base/pickle.h"
+#include "base/threading/simple_thread.h"
 #include "base/time/time.h"
 #include "testing/gtest/include/gtest/gtest.h"
 
@@ -74,6 +75,59 @@ TEST_F(HistogramTest, BasicTest) {
   HISTOGRAM_ENUMERATION("Test6Histogram", 129, 130);
 }
 
+namespace {
+
+// Adds |count| samples of |value| to |histogram|.
+class HistogramAdder : public DelegateSimpleThread::Delegate {
+ public:
+  HistogramAdder(HistogramBase* histogram, int value, int count)
+      : histogram_(histogram), value_(value), count_(count) {}
+
+  virtual void Run() OVERRIDE {
+    for (int i = 0; i < count_; ++i)
+      histogram_->Add(value_);
+  }
+
+ private:
+  HistogramBase* histogram_;
+  const int value_;
+  const int count_;
+
+  DISALLOW_COPY_AND_ASSIGN(HistogramAdder);
+};
+
+}  // namespace
+
+// Samples recorded on different threads must all show up in snapshots. The
+// threads run one after the other, since concurrent Add() calls that land on
+// the same bucket may lose counts.
+TEST_F(HistogramTest, SamplesFromManyThreads) {
+  HistogramBase* histogram = LinearHistogram::FactoryGet(
+      "ManyThreads", 1, 20, 21, HistogramBase::kNoFlags);
+  histogram->Add(0);
+
+  const int kNumThreads = 20;
+  for (int i = 1; i < kNumThreads; ++i) {
+    HistogramAdder adder(histogram, i, i);
+    DelegateSimpleThread thread(&adder, "HistogramAdder");
+    thread.Start();
+    thread.Join();
+  }
+
+  scoped_ptr<HistogramSamples> samples = histogram->SnapshotSamples();
+  EXPECT_EQ(1, samples->GetCount(0));
+  int total = 1;
+  int64 sum = 0;
+  for (int i = 1; i < kNumThreads; ++i) {
+    EXPECT_EQ(i, samples->GetCount(i));
+    total += i;
+    sum += i * i;
+  }
+  EXPECT_EQ(total, samples->TotalCount());
+  EXPECT_EQ(total, samples->redundant_count());
+  EXPECT_EQ(sum, samples->sum());
+}
+
 // Check that the macro correctly matches histograms by name and records their
 // data together.
 TEST_F(HistogramTest, NameMatchTest) {
@@ -5,7 +5,9 @@
 #include "base/metrics/statistics_recorder.h"
 
 #include "base/at_exit.h"
+#include "base/atomicops.h"
 #include "base/debug/leak_annotations.h"
+#include "base/hash.h"
 #include "base/json/string_escape.h"
 #include "base/logging.h"
 #include "base/memory/scoped_ptr.h"
@@ -21,6 +23,32 @@ namespace {
 // Initialize histogram statistics gathering system.
 base::LazyInstance<base::StatisticsRecorder>::Leaky g_statistics_recorder_ =
     LAZY_INSTANCE_INITIALIZER;
+
+// FindHistogram() runs every time a histogram whose name isn't known at
+// compile time is recorded, so registered histograms are also kept in this
+// table, which is read without taking the lock. Each slot holds the most
+// recently found histogram whose name hashes to it. Registered histograms are
+// never deleted, so a pointer read from here always stays valid.
+const size_t kLookupCacheSize = 1024;
+base::subtle::AtomicWord g_lookup_cache[kLookupCacheSize];
+
+base::subtle::AtomicWord* GetLookupCacheSlot(const std::string& name) {
+  return &g_lookup_cache[base::Hash(name) % kLookupCacheSize];
+}
+
+// Callers must hold StatisticsRecorder's lock, so that a histogram from before
+// a reset of the recorder (in tests) can't be stored after ClearLookupCache().
+void AddToLookupCache(base::HistogramBase* histogram) {
+  base::subtle::Release_Store(
+      GetLookupCacheSlot(histogram->histogram_name()),
+      reinterpret_cast<base::subtle::AtomicWord>(histogram));
+}
+
+void ClearLookupCache() {
+  for (size_t i = 0; i < kLookupCacheSize; ++i)
+    base::subtle::Release_Store(&g_lookup_cache[i], 0);
+}
+
 }  // namespace
 
 namespace base {
@@ -65,6 +93,7 @@ HistogramBase* StatisticsRecorder::RegisterOrDeleteDuplicate(
       if (histograms_->end() == it) {
         (*histograms_)[name] = histogram;
         ANNOTATE_LEAKING_OBJECT_PTR(histogram);  // see crbug.com/79322
+        AddToLookupCache(histogram);
         histogram_to_return = histogram;
       } else if (histogram == it->second) {
         // The histogram was registered before.
@@ -236,6 +265,12 @@ void StatisticsRecorder::GetBucketRanges(
 HistogramBase* StatisticsRecorder::FindHistogram(const std::string& name) {
   if (lock_ == NULL)
     return NULL;
+
+  HistogramBase* cached = reinterpret_cast<HistogramBase*>(
+      subtle::Acquire_Load(GetLookupCacheSlot(name)));
+  if (cached && cached->histogram_name() == name)
+    return cached;
+
   base::AutoLock auto_lock(*lock_);
   if (histograms_ == NULL)
     return NULL;
@@ -243,6 +278,7 @@ HistogramBase* StatisticsRecorder::FindHistogram(const std::string& name) {
   HistogramMap::iterator it = histograms_->find(name);
   if (histograms_->end() == it)
     return NULL;
+  AddToLookupCache(it->second);
   return it->second;
 }
 
@@ -309,6 +345,7 @@ StatisticsRecorder::~StatisticsRecorder() {
     ranges_deleter.reset(ranges_);
     histograms_ = NULL;
     ranges_ = NULL;
+    ClearLookupCache();
   }
   // We are going to leak the histograms and the ranges.
 }
@@ -151,6 +151,25 @@ TEST_F(StatisticsRecorderTest, FindHistogram) {
   EXPECT_TRUE(StatisticsRecorder::FindHistogram("TestHistogram") == NULL);
 }
 
+// Histograms from before a reset must not be found afterwards, even though the
+// lookups that found them were cached.
+TEST_F(StatisticsRecorderTest, FindHistogramAfterReset) {
+  HistogramBase* histogram = Histogram::FactoryGet(
+      "TestHistogram", 1, 1000, 10, HistogramBase::kNoFlags);
+  EXPECT_EQ(histogram, StatisticsRecorder::FindHistogram("TestHistogram"));
+  EXPECT_EQ(histogram, StatisticsRecorder::FindHistogram("TestHistogram"));
+
+  UninitializeStatisticsRecorder();
+  EXPECT_TRUE(StatisticsRecorder::FindHistogram("TestHistogram") == NULL);
+
+  InitializeStatisticsRecorder();
+  EXPECT_TRUE(StatisticsRecorder::FindHistogram("TestHistogram") == NULL);
+  HistogramBase* new_histogram = Histogram::FactoryGet(
+      "TestHistogram", 1, 1000, 10, HistogramBase::kNoFlags);
+  EXPECT_NE(histogram, new_histogram);
+  EXPECT_EQ(new_histogram, StatisticsRecorder::FindHistogram("TestHistogram"));
+}
+
 TEST_F(StatisticsRecorderTest, GetSnapshot) {
   Histogram::FactoryGet("TestHistogram1", 1, 1000, 10, Histogram::kNoFlags);
   Histogram::FactoryGet("TestHistogram2", 1, 1000, 10, Histogram::kNoFlags);
@@ -6,7 +6,7 @@
 
 #include <stdlib.h>
 
-#include <algorithm>  // for max()
+#include <algorithm>  // for max() and min()
 
 //------------------------------------------------------------------------------
 
@@ -18,9 +18,50 @@ const int Pickle::kPayloadUnit = 64;
 
 static const size_t kCapacityReadOnly = static_cast<size_t>(-1);
 
+namespace {
+
+// Appends up to |*remaining| bytes of |data| to |buffers|.
+void AppendBuffer(const char* data,
+                  size_t size,
+                  size_t* remaining,
+                  std::vector<Pickle::Buffer>* buffers) {
+  size = std::min(size, *remaining);
+  if (!size)
+    return;
+  Pickle::Buffer buffer = { data, size };
+  buffers->push_back(buffer);
+  *remaining -= size;
+}
+
+}  // namespace
+
+PickleExternalSegment::PickleExternalSegment() : offset(0) {
+}
+
+PickleExternalSegment::PickleExternalSegment(
+    size_t offset,
+    const scoped_refptr<base::RefCountedMemory>& data)
+    : offset(offset),
+      data(data) {
+}
+
+PickleExternalSegment::~PickleExternalSegment() {
+}
+
 PickleIterator::PickleIterator(const Pickle& pickle)
     : read_ptr_(pickle.payload()),
-      read_end_ptr_(pickle.end_of_payload()) {
+      read_end_ptr_(pickle.end_of_payload()),
+      payload_ptr_(pickle.payload()),
+      segments_(pickle.segments_.empty() ? NULL : &pickle.segments_),
+      next_segment_(0) {
+}
+
+inline const char* PickleIterator::GetInlineReadEnd() const {
+  if (segments_ && next_segment_ < segments_->size()) {
+    return std::min(read_end_ptr_,
+                    payload_ptr_ + (*segments_)[next_segment_].offset);
+  }
+  return read_end_ptr_;
 }
 
 template <typename Type>
@@ -38,7 +79,7 @@ inline bool PickleIterator::ReadBuiltinType(Type* result) {
 template<typename Type>
 inline const char* PickleIterator::GetReadPointerAndAdvance() {
   const char* current_read_ptr = read_ptr_;
-  if (read_ptr_ + sizeof(Type) > read_end_ptr_)
+  if (read_ptr_ + sizeof(Type) > GetInlineReadEnd())
     return NULL;
   if (sizeof(Type) < sizeof(uint32))
     read_ptr_ += AlignInt(sizeof(Type), sizeof(uint32));
@@ -48,7 +89,20 @@ inline const char* PickleIterator::GetReadPointerAndAdvance() {
 }
 
 const char* PickleIterator::GetReadPointerAndAdvance(int num_bytes) {
-  if (num_bytes < 0 || read_end_ptr_ - read_ptr_ < num_bytes)
+  if (num_bytes < 0)
+    return NULL;
+  if (segments_ && next_segment_ < segments_->size()) {
+    const PickleExternalSegment& segment = (*segments_)[next_segment_];
+    if (read_ptr_ == payload_ptr_ + segment.offset) {
+      // The read lands on an external segment, which must be read whole. The
+      // Pickle's own buffer picks up again at the same offset.
+      if (static_cast<size_t>(num_bytes) != segment.data->size())
+        return NULL;
+      ++next_segment_;
+      return segment.data->front_as<char>();
+    }
+  }
+  if (GetInlineReadEnd() - read_ptr_ < num_bytes)
     return NULL;
   const char* current_read_ptr = read_ptr_;
   read_ptr_ += AlignInt(num_bytes, sizeof(uint32));
@@ -165,7 +219,8 @@ Pickle::Pickle()
     : header_(NULL),
       header_size_(sizeof(Header)),
       capacity_after_header_(0),
-      write_offset_(0) {
+      write_offset_(0),
+      external_size_(0) {
   Resize(kPayloadUnit);
   header_->payload_size = 0;
 }
@@ -174,7 +229,8 @@ Pickle::Pickle(int header_size)
     : header_(NULL),
       header_size_(AlignInt(header_size, sizeof(uint32))),
       capacity_after_header_(0),
-      write_offset_(0) {
+      write_offset_(0),
+      external_size_(0) {
   DCHECK_GE(static_cast<size_t>(header_size), sizeof(Header));
   DCHECK_LE(header_size, kPayloadUnit);
   Resize(kPayloadUnit);
@@ -185,7 +241,8 @@ Pickle::Pickle(const char* data, int data_len)
     : header_(reinterpret_cast<Header*>(const_cast<char*>(data))),
       header_size_(0),
       capacity_after_header_(kCapacityReadOnly),
-      write_offset_(0) {
+      write_offset_(0),
+      external_size_(0) {
   if (data_len >= static_cast<int>(sizeof(Header)))
     header_size_ = data_len - header_->payload_size;
 
@@ -204,8 +261,10 @@ Pickle::Pickle(const Pickle& other)
     : header_(NULL),
       header_size_(other.header_size_),
       capacity_after_header_(0),
-      write_offset_(other.write_offset_) {
-  size_t payload_size = header_size_ + other.header_->payload_size;
+      write_offset_(other.write_offset_),
+      segments_(other.segments_),
+      external_size_(other.external_size_) {
+  size_t payload_size = header_size_ + other.inline_payload_size();
   Resize(payload_size);
   memcpy(header_, other.header_, payload_size);
 }
@@ -229,13 +288,69 @@ Pickle& Pickle::operator=(const Pickle& other) {
     header_ = NULL;
     header_size_ = other.header_size_;
   }
-  Resize(other.header_->payload_size);
+  Resize(other.inline_payload_size());
   memcpy(header_, other.header_,
-         other.header_size_ + other.header_->payload_size);
+         other.header_size_ + other.inline_payload_size());
   write_offset_ = other.write_offset_;
+  segments_ = other.segments_;
+  external_size_ = other.external_size_;
   return *this;
 }
 
+void Pickle::GetBuffers(std::vector<Buffer>* buffers) const {
+  static const char kPadding[sizeof(uint32)] = { 0 };
+
+  // The pieces are clipped to size(), since the padding after the last field
+  // is not part of the payload.
+  size_t remaining = size();
+  const char* inline_data = reinterpret_cast<const char*>(header_);
+  size_t inline_offset = 0;
+  for (size_t i = 0; i < segments_.size(); ++i) {
+    const PickleExternalSegment& segment = segments_[i];
+    size_t segment_start = header_size_ + segment.offset;
+    AppendBuffer(inline_data + inline_offset, segment_start - inline_offset,
+                 &remaining, buffers);
+    inline_offset = segment_start;
+
+    size_t length = segment.data->size();
+    AppendBuffer(segment.data->front_as<char>(), length, &remaining, buffers);
+    AppendBuffer(kPadding, AlignInt(length, sizeof(uint32)) - length,
+                 &remaining, buffers);
+  }
+  AppendBuffer(inline_data + inline_offset,
+               header_size_ + inline_payload_size() - inline_offset,
+               &remaining, buffers);
+  DCHECK_EQ(0u, remaining);
+}
+
+void Pickle::Flatten() {
+  if (segments_.empty())
+    return;
+
+  std::vector<Buffer> buffers;
+  GetBuffers(&buffers);
+
+  size_t new_write_offset = write_offset_ + external_size_;
+  size_t new_capacity = AlignInt(new_write_offset, kPayloadUnit);
+  char* new_data = static_cast<char*>(malloc(header_size_ + new_capacity));
+  CHECK(new_data);
+  char* dest = new_data;
+  for (size_t i = 0; i < buffers.size(); ++i) {
+    memcpy(dest, buffers[i].data, buffers[i].size);
+    dest += buffers[i].size;
+  }
+  // Zero the padding after the last field so that later writes don't pick up
+  // uninitialized bytes.
+  memset(dest, 0, new_data + header_size_ + new_write_offset - dest);
+
+  free(header_);
+  header_ = reinterpret_cast<Header*>(new_data);
+  capacity_after_header_ = new_capacity;
+  write_offset_ = new_write_offset;
+  segments_.clear();
+  external_size_ = 0;
+}
+
 bool Pickle::WriteString(const std::string& value) {
   if (!WriteInt(static_cast<int>(value.size())))
     return false;
@@ -268,6 +383,37 @@ bool Pickle::WriteBytes(const void* data, int length) {
   return true;
 }
 
+bool Pickle::WriteExternalData(
+    const scoped_refptr<base::RefCountedMemory>& data) {
+  DCHECK_NE(kCapacityReadOnly, capacity_after_header_)
+      << "oops: pickle is readonly";
+  size_t length = data->size();
+  if (length > static_cast<size_t>(kint32max))
+    return false;
+  if (!WriteInt(static_cast<int>(length)))
+    return false;
+  // An empty blob is just its length.
+  if (!length)
+    return true;
+
+  size_t data_len = AlignInt(length, sizeof(uint32));
+  DCHECK_LE(write_offset_ + external_size_, kuint32max - data_len);
+  segments_.push_back(PickleExternalSegment(write_offset_, data));
+  header_->payload_size =
+      static_cast<uint32>(external_size_ + write_offset_ + length);
+  external_size_ += data_len;
+  return true;
+}
+
+size_t Pickle::inline_payload_size() const {
+  if (segments_.empty())
+    return header_->payload_size;
+  // If an external segment was written last, nothing follows it inline.
+  if (segments_.back().offset == write_offset_)
+    return write_offset_;
+  return header_->payload_size - external_size_;
+}
+
 void Pickle::Reserve(size_t length) {
   size_t data_len = AlignInt(length, sizeof(uint32));
   DCHECK_GE(data_len, length);
@@ -332,6 +478,7 @@ inline void Pickle::WriteBytesCommon(const void* data, size_t length) {
   char* write = mutable_payload() + write_offset_;
   memcpy(write, data, length);
   memset(write + length, 0, data_len - length);
-  header_->payload_size = static_cast<uint32>(write_offset_ + length);
+  header_->payload_size =
+      static_cast<uint32>(external_size_ + write_offset_ + length);
   write_offset_ = new_size;
 }
@@ -6,21 +6,46 @@
 #define BASE_PICKLE_H__
 
 #include <string>
+#include <vector>
 
 #include "base/base_export.h"
 #include "base/basictypes.h"
 #include "base/compiler_specific.h"
 #include "base/gtest_prod_util.h"
 #include "base/logging.h"
+#include "base/memory/ref_counted.h"
+#include "base/memory/ref_counted_memory.h"
 #include "base/strings/string16.h"
 
 class Pickle;
 
+// A block of memory that a Pickle refers to rather than copies. |offset| is
+// the position in the Pickle's own payload buffer at which the block
+// logically starts.
+struct BASE_EXPORT PickleExternalSegment {
+  PickleExternalSegment();
+  PickleExternalSegment(size_t offset,
+                        const scoped_refptr<base::RefCountedMemory>& data);
+  ~PickleExternalSegment();
+
+  size_t offset;
+  scoped_refptr<base::RefCountedMemory> data;
+};
+
 // PickleIterator reads data from a Pickle. The Pickle object must remain valid
 // while the PickleIterator object is in use.
+//
+// If the Pickle holds external segments (see Pickle::WriteExternalData()),
+// ReadData() and ReadBytes() return pointers into those segments when the
+// read lands on one. Built-in types never straddle a segment boundary.
 class BASE_EXPORT PickleIterator {
  public:
-  PickleIterator() : read_ptr_(NULL), read_end_ptr_(NULL) {}
+  PickleIterator()
+      : read_ptr_(NULL),
+        read_end_ptr_(NULL),
+        payload_ptr_(NULL),
+        segments_(NULL),
+        next_segment_(0) {}
   explicit PickleIterator(const Pickle& pickle);
 
   // Methods for reading the payload of the Pickle. To read from the start of
@@ -67,6 +92,10 @@ class BASE_EXPORT PickleIterator {
   template<typename Type>
   inline const char* GetReadPointerAndAdvance();
 
+  // Returns the end of the bytes that can be read from the Pickle's own
+  // buffer before reaching the next external segment.
+  inline const char* GetInlineReadEnd() const;
+
   // Get read pointer for |num_bytes| and advance read pointer. This method
   // checks num_bytes for negativity and wrapping.
   const char* GetReadPointerAndAdvance(int num_bytes);
@@ -80,6 +109,12 @@ class BASE_EXPORT PickleIterator {
   const char* read_ptr_;
   const char* read_end_ptr_;
 
+  // The start of the Pickle's payload, and its external segments (if any)
+  // along with the index of the next one to be read.
+  const char* payload_ptr_;
+  const std::vector<PickleExternalSegment>* segments_;
+  size_t next_segment_;
+
   FRIEND_TEST_ALL_PREFIXES(PickleTest, GetReadPointerAndAdvance);
 };
 
@@ -100,8 +135,19 @@ class BASE_EXPORT PickleIterator {
 // space is controlled by the header_size parameter passed to the Pickle
 // constructor.
 //
+// Large blobs can be added with WriteExternalData(), which keeps a reference
+// to the caller's memory instead of copying it. Such a Pickle is made up of
+// several segments: use GetBuffers() to get at its data, or Flatten() to
+// copy everything into a single buffer before calling data().
+//
 class BASE_EXPORT Pickle {
  public:
+  // A contiguous piece of a Pickle's serialized data.
+  struct Buffer {
+    const char* data;
+    size_t size;
+  };
+
   // Initialize a Pickle object using the default header size.
   Pickle();
 
@@ -132,8 +178,23 @@ class BASE_EXPORT Pickle {
   // Returns the size of the Pickle's data.
   size_t size() const { return header_size_ + header_->payload_size; }
 
-  // Returns the data for this Pickle.
-  const void* data() const { return header_; }
+  // Returns the data for this Pickle. Must not be called while the Pickle has
+  // external segments; see Flatten().
+  const void* data() const {
+    DCHECK(segments_.empty()) << "Flatten() the Pickle first";
+    return header_;
+  }
+
+  // Appends the pieces that make up this Pickle's serialized data, in order,
+  // to |buffers|. Their sizes add up to size().
+  void GetBuffers(std::vector<Buffer>* buffers) const;
+
+  // Returns true if WriteExternalData() has been used on this Pickle.
+  bool has_external_segments() const { return !segments_.empty(); }
+
+  // Copies all external segments into the Pickle's own buffer and drops the
+  // references to them. Afterwards data() may be used again.
+  void Flatten();
 
   // For compatibility, these older style read methods pass through to the
   // PickleIterator methods.
@@ -251,6 +312,11 @@ class BASE_EXPORT Pickle {
   // when reading and writing. It is normally used to serialize PoD types of a
   // known size. See also WriteData.
   bool WriteBytes(const void* data, int length);
+  // Like WriteData, but instead of copying it, keeps a reference to |data|,
+  // which must not be modified afterwards. The serialized form is identical to
+  // WriteData's, so the reading side can't tell the difference. Intended for
+  // large blobs; small ones are cheaper to copy.
+  bool WriteExternalData(const scoped_refptr<base::RefCountedMemory>& data);
 
   // Reserves space for upcoming writes when multiple writes will be made and
   // their sizes are computed in advance. It can be significantly faster to call
@@ -284,10 +350,11 @@ class BASE_EXPORT Pickle {
   }
 
   // Returns the address of the byte immediately following the currently valid
-  // header + payload.
+  // header + payload. If the Pickle has external segments, this is the end of
+  // the part of the payload held in its own buffer.
   const char* end_of_payload() const {
     // This object may be invalid.
-    return header_ ? payload() + payload_size() : NULL;
+    return header_ ? payload() + inline_payload_size() : NULL;
   }
 
  protected:
@@ -328,6 +395,14 @@ class BASE_EXPORT Pickle {
   // The offset at which we will write the next field. Note: this doesn't count
   // the header.
   size_t write_offset_;
+  // Memory referenced by WriteExternalData(), in payload order.
+  std::vector<PickleExternalSegment> segments_;
+  // The number of payload bytes held in |segments_|, including the padding
+  // after each of them.
+  size_t external_size_;
+
+  // Returns the number of payload bytes stored in the Pickle's own buffer.
+  size_t inline_payload_size() const;
 
   // Just like WriteBytes, but with a compile-time size, for performance.
   template<size_t length> void WriteBytesStatic(const void* data);
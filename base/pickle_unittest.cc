@@ -3,8 +3,10 @@
 // found in the LICENSE file.
 
 #include <string>
+#include <vector>
 
 #include "base/basictypes.h"
+#include "base/memory/ref_counted_memory.h"
 #include "base/memory/scoped_ptr.h"
 #include "base/pickle.h"
 #include "base/strings/string16.h"
@@ -362,3 +364,149 @@ TEST(PickleTest, ReadBytes) {
   memcpy(&outdata, outdata_char, sizeof(outdata));
   EXPECT_EQ(data, outdata);
 }
+
+namespace {
+
+// Returns the serialized bytes of |pickle|, stitched together from its
+// buffers.
+std::string GetPickleBytes(const Pickle& pickle) {
+  std::vector<Pickle::Buffer> buffers;
+  pickle.GetBuffers(&buffers);
+  std::string bytes;
+  for (size_t i = 0; i < buffers.size(); ++i)
+    bytes.append(buffers[i].data, buffers[i].size);
+  return bytes;
+}
+
+scoped_refptr<base::RefCountedMemory> MakeExternalData(
+    const std::string& contents) {
+  std::string copy(contents);
+  return base::RefCountedString::TakeString(&copy);
+}
+
+}  // namespace
+
+// Check that external data reads back without being copied, and that the
+// serialized form matches WriteData's.
+TEST(PickleTest, ExternalData) {
+  const std::string blob1("external blob");  // note non-aligned length
+  const std::string blob2(1000, 'x');
+  scoped_refptr<base::RefCountedMemory> external1 = MakeExternalData(blob1);
+  scoped_refptr<base::RefCountedMemory> external2 = MakeExternalData(blob2);
+
+  Pickle pickle;
+  EXPECT_TRUE(pickle.WriteInt(testint));
+  EXPECT_TRUE(pickle.WriteExternalData(external1));
+  EXPECT_TRUE(pickle.WriteString(teststr));
+  EXPECT_TRUE(pickle.WriteExternalData(external2));
+  EXPECT_TRUE(pickle.WriteExternalData(MakeExternalData(std::string())));
+  EXPECT_TRUE(pickle.has_external_segments());
+
+  Pickle copied;
+  EXPECT_TRUE(copied.WriteInt(testint));
+  EXPECT_TRUE(copied.WriteData(blob1.data(), blob1.size()));
+  EXPECT_TRUE(copied.WriteString(teststr));
+  EXPECT_TRUE(copied.WriteData(blob2.data(), blob2.size()));
+  EXPECT_TRUE(copied.WriteData(NULL, 0));
+
+  EXPECT_EQ(copied.size(), pickle.size());
+  std::string bytes = GetPickleBytes(pickle);
+  EXPECT_EQ(std::string(static_cast<const char*>(copied.data()),
+                        copied.size()),
+            bytes);
+
+  PickleIterator iter(pickle);
+  int outint;
+  EXPECT_TRUE(pickle.ReadInt(&iter, &outint));
+  EXPECT_EQ(testint, outint);
+  const char* outdata;
+  int outdatalen;
+  EXPECT_TRUE(pickle.ReadData(&iter, &outdata, &outdatalen));
+  EXPECT_EQ(external1->front_as<char>(), outdata);
+  EXPECT_EQ(blob1, std::string(outdata, outdatalen));
+  std::string outstr;
+  EXPECT_TRUE(pickle.ReadString(&iter, &outstr));
+  EXPECT_EQ(teststr, outstr);
+  EXPECT_TRUE(pickle.ReadData(&iter, &outdata, &outdatalen));
+  EXPECT_EQ(external2->front_as<char>(), outdata);
+  EXPECT_EQ(blob2, std::string(outdata, outdatalen));
+  EXPECT_TRUE(pickle.ReadData(&iter, &outdata, &outdatalen));
+  EXPECT_EQ(0, outdatalen);
+  EXPECT_FALSE(pickle.ReadInt(&iter, &outint));
+
+  // The serialized bytes are an ordinary Pickle.
+  Pickle received(bytes.data(), static_cast<int>(bytes.size()));
+  PickleIterator received_iter(received);
+  EXPECT_TRUE(received.ReadInt(&received_iter, &outint));
+  EXPECT_TRUE(received.ReadData(&received_iter, &outdata, &outdatalen));
+  EXPECT_EQ(blob1, std::string(outdata, outdatalen));
+}
+
+// Check that a read can't run past the start of an external segment, or read
+// only part of one.
+TEST(PickleTest, ExternalDataBadReads) {
+  Pickle pickle;
+  EXPECT_TRUE(pickle.WriteExternalData(MakeExternalData("abcdefgh")));
+
+  PickleIterator iter(pickle);
+  int outint;
+  EXPECT_TRUE(pickle.ReadInt(&iter, &outint));
+  EXPECT_EQ(8, outint);
+  EXPECT_FALSE(pickle.ReadInt(&iter, &outint));
+  const char* outdata;
+  EXPECT_FALSE(pickle.ReadBytes(&iter, &outdata, 4));
+  EXPECT_TRUE(pickle.ReadBytes(&iter, &outdata, 8));
+  EXPECT_EQ("abcdefgh", std::string(outdata, 8));
+}
+
+// Check Flatten(), and that writes after it land in the right place.
+TEST(PickleTest, ExternalDataFlatten) {
+  const std::string blob("external");
+  Pickle pickle;
+  EXPECT_TRUE(pickle.WriteString(teststr));
+  EXPECT_TRUE(pickle.WriteExternalData(MakeExternalData(blob)));
+  EXPECT_TRUE(pickle.WriteExternalData(MakeExternalData(teststr)));
+  std::string bytes = GetPickleBytes(pickle);
+
+  pickle.Flatten();
+  EXPECT_FALSE(pickle.has_external_segments());
+  EXPECT_EQ(bytes,
+            std::string(static_cast<const char*>(pickle.data()),
+                        pickle.size()));
+
+  EXPECT_TRUE(pickle.WriteInt(testint));
+  PickleIterator iter(pickle);
+  std::string outstr;
+  EXPECT_TRUE(pickle.ReadString(&iter, &outstr));
+  EXPECT_EQ(teststr, outstr);
+  EXPECT_TRUE(pickle.ReadString(&iter, &outstr));
+  EXPECT_EQ(blob, outstr);
+  EXPECT_TRUE(pickle.ReadString(&iter, &outstr));
+  EXPECT_EQ(teststr, outstr);
+  int outint;
+  EXPECT_TRUE(pickle.ReadInt(&iter, &outint));
+  EXPECT_EQ(testint, outint);
+}
+
+// Check that copies of a Pickle share its external segments.
+TEST(PickleTest, ExternalDataCopy) {
+  scoped_refptr<base::RefCountedMemory> external = MakeExternalData(teststr);
+  Pickle pickle;
+  EXPECT_TRUE(pickle.WriteExternalData(external));
+  EXPECT_TRUE(pickle.WriteInt(testint));
+
+  Pickle copy(pickle);
+  Pickle assigned;
+  assigned = pickle;
+  EXPECT_EQ(GetPickleBytes(pickle), GetPickleBytes(copy));
+  EXPECT_EQ(GetPickleBytes(pickle), GetPickleBytes(assigned));
+
+  PickleIterator iter(assigned);
+  const char* outdata;
+  int outdatalen;
+  EXPECT_TRUE(assigned.ReadData(&iter, &outdata, &outdatalen));
+  EXPECT_EQ(external->front_as<char>(), outdata);
+  int outint;
+  EXPECT_TRUE(assigned.ReadInt(&iter, &outint));
+  EXPECT_EQ(testint, outint);
+}
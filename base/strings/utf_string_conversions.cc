@@ -14,6 +14,13 @@ namespace {
 
 // Generalized Unicode converter -----------------------------------------------
 
+// Returns true if |c| is a 7-bit ASCII code unit, which every supported
+// encoding represents as itself.
+template<typename CHAR>
+inline bool IsASCIICodeUnit(CHAR c) {
+  return static_cast<uint32>(c) < 0x80;
+}
+
 // Converts the given source Unicode character type to the given destination
 // Unicode character type as a STL string. The given input buffer and size
 // determine the source, and the given output STL string will be replaced by
@@ -26,6 +33,17 @@ bool ConvertUnicode(const SRC_CHAR* src,
   bool success = true;
   int32 src_len32 = static_cast<int32>(src_len);
   for (int32 i = 0; i < src_len32; i++) {
+    // Copy runs of ASCII across in bulk; they are by far the most common
+    // input and don't need to be decoded.
+    if (IsASCIICodeUnit(src[i])) {
+      int32 run_end = i + 1;
+      while (run_end < src_len32 && IsASCIICodeUnit(src[run_end]))
+        run_end++;
+      output->append(src + i, src + run_end);
+      i = run_end - 1;
+      continue;
+    }
+
     uint32 code_point;
     if (ReadUnicodeCharacter(src, src_len32, &i, &code_point)) {
       WriteUnicodeCharacter(code_point, output);
@@ -4,6 +4,7 @@
 
 #include "base/threading/sequenced_worker_pool.h"
 
+#include <deque>
 #include <list>
 #include <map>
 #include <set>
@@ -11,6 +12,7 @@
 #include <vector>
 
 #include "base/atomic_sequence_num.h"
+#include "base/atomicops.h"
 #include "base/callback.h"
 #include "base/compiler_specific.h"
 #include "base/critical_closure.h"
@@ -222,6 +224,12 @@ base::LazyInstance<base::ThreadLocalPointer<
     SequencedWorkerPool::SequenceToken> >::Leaky g_lazy_tls_ptr =
         LAZY_INSTANCE_INITIALIZER;
 
+// In SCHEDULE_WORK_STEALING mode, the maximum number of tasks a worker takes
+// from the stealable queues before going back through the pool lock. This
+// keeps sequenced and delayed tasks from being starved by a flood of
+// unsequenced ones.
+const int kMaxStealableTasksPerIteration = 32;
+
 }  // namespace
 
 // Worker ---------------------------------------------------------------------
@@ -252,8 +260,19 @@ class SequencedWorkerPool::Worker : public SimpleThread {
     return running_shutdown_behavior_;
   }
 
+  // Returns the Worker running on the current thread, or NULL if the current
+  // thread is not a SequencedWorkerPool worker.
+  static Worker* GetForCurrentThread();
+
+  SequencedWorkerPool* worker_pool() const { return worker_pool_.get(); }
+
+  int thread_number() const { return thread_number_; }
+
  private:
+  static LazyInstance<ThreadLocalPointer<Worker> >::Leaky lazy_tls_ptr_;
+
   scoped_refptr<SequencedWorkerPool> worker_pool_;
+  const int thread_number_;
   SequenceToken running_sequence_;
   WorkerShutdown running_shutdown_behavior_;
 
@@ -268,6 +287,7 @@ class SequencedWorkerPool::Inner {
   // by it).
   Inner(SequencedWorkerPool* worker_pool, size_t max_threads,
         const std::string& thread_name_prefix,
+        SchedulingMode scheduling_mode,
         TestingObserver* observer);
 
   ~Inner();
@@ -318,6 +338,35 @@ class SequencedWorkerPool::Inner {
     CLEANUP_DONE,
   };
 
+  // A queue of unsequenced, non-delayed tasks owned by one worker in
+  // SCHEDULE_WORK_STEALING mode. Each queue has its own lock, which is never
+  // held while acquiring |lock_|.
+  struct StealableQueue {
+    Lock lock;
+    std::deque<SequencedTask> tasks;
+  };
+
+  // Pushes |task| onto a stealable queue without taking |lock_|. Returns false
+  // if the task must go through the regular locked path instead, e.g.
+  // because a new thread may need to be started or shutdown has begun.
+  bool TryPostStealableTask(const SequencedTask& task);
+
+  // Pops a task from the stealable queues, trying the queue at
+  // |preferred_index| first. Returns false if all queues are empty. May be
+  // called with or without |lock_| held.
+  bool TakeStealableTask(size_t preferred_index, SequencedTask* task);
+
+  // Returns true if any of the stealable queues may have a task in it.
+  bool HasStealableTasks() const;
+
+  // Runs up to kMaxStealableTasksPerIteration tasks from the stealable
+  // queues. Must be called outside |lock_|.
+  void RunStealableTasks(Worker* this_worker);
+
+  // Runs or discards a single task taken by RunStealableTasks(), doing all
+  // the shutdown accounting with atomic operations rather than |lock_|.
+  void RunStealableTask(Worker* this_worker, SequencedTask* task);
+
   // Called from within the lock, this converts the given token name into a
   // token ID, creating a new one if necessary.
   int LockedGetNamedTokenID(const std::string& name);
@@ -415,6 +464,8 @@ class SequencedWorkerPool::Inner {
 
   const std::string thread_name_prefix_;
 
+  const SchedulingMode scheduling_mode_;
+
   // Associates all known sequence token names with their IDs.
   std::map<std::string, int> named_sequence_tokens_;
 
@@ -431,6 +482,38 @@ class SequencedWorkerPool::Inner {
   // Number of threads currently waiting for work.
   size_t waiting_thread_count_;
 
+  // The following are only used in SCHEDULE_WORK_STEALING mode. They are
+  // accessed with atomic operations so that stealable tasks can be posted
+  // and run without taking |lock_|.
+
+  // One queue per potential worker thread, indexed by thread number - 1.
+  // The vector itself is never resized after construction.
+  std::vector<linked_ptr<StealableQueue> > stealable_queues_;
+
+  // Mirrors |waiting_thread_count_| so that posting threads can tell whether
+  // they need to take |lock_| to wake up a worker.
+  subtle::Atomic32 atomic_waiting_thread_count_;
+
+  // Mirrors |threads_.size()|.
+  subtle::Atomic32 atomic_thread_count_;
+
+  // Mirrors |shutdown_called_|.
+  subtle::Atomic32 atomic_shutdown_called_;
+
+  // Round-robin cursor used to pick a queue for tasks posted from threads
+  // that are not workers of this pool.
+  subtle::Atomic32 next_stealable_queue_;
+
+  // Number of tasks currently in the stealable queues.
+  subtle::Atomic32 stealable_task_count_;
+
+  // Number of BLOCK_SHUTDOWN tasks currently in the stealable queues.
+  subtle::Atomic32 stealable_blocking_task_count_;
+
+  // Number of threads currently running a stealable task with the
+  // BLOCK_SHUTDOWN or SKIP_ON_SHUTDOWN flag set outside of |lock_|.
+  subtle::Atomic32 stealable_blocking_thread_count_;
+
   // Number of threads currently running tasks that have the BLOCK_SHUTDOWN
   // or SKIP_ON_SHUTDOWN flag set.
   size_t blocking_shutdown_thread_count_;
@@ -454,7 +537,7 @@ class SequencedWorkerPool::Inner {
   std::set<int> current_sequences_;
 
   // An ID for each posted task to distinguish the task from others in traces.
-  int trace_id_;
+  AtomicSequenceNumber trace_id_;
 
   // Set when Shutdown is called and no further tasks should be
   // allowed, though we may still be running existing tasks.
@@ -483,6 +566,7 @@ SequencedWorkerPool::Worker::Worker(
     : SimpleThread(
           prefix + StringPrintf("Worker%d", thread_number).c_str()),
       worker_pool_(worker_pool),
+      thread_number_(thread_number),
       running_shutdown_behavior_(CONTINUE_ON_SHUTDOWN) {
   Start();
 }
@@ -490,10 +574,20 @@ SequencedWorkerPool::Worker::Worker(
 SequencedWorkerPool::Worker::~Worker() {
 }
 
+// static
+SequencedWorkerPool::Worker*
+SequencedWorkerPool::Worker::GetForCurrentThread() {
+  // Don't construct lazy instance on check.
+  if (lazy_tls_ptr_ == NULL)
+    return NULL;
+  return lazy_tls_ptr_.Get().Get();
+}
+
 void SequencedWorkerPool::Worker::Run() {
   // Store a pointer to the running sequence in thread local storage for
   // static function access.
   g_lazy_tls_ptr.Get().Set(&running_sequence_);
+  lazy_tls_ptr_.Get().Set(this);
 
   // Just jump back to the Inner object to run the thread, since it has all the
   // tracking information and queues. It might be more natural to implement
@@ -505,12 +599,17 @@ void SequencedWorkerPool::Worker::Run() {
   worker_pool_ = NULL;
 }
 
+// static
+LazyInstance<ThreadLocalPointer<SequencedWorkerPool::Worker> >::Leaky
+    SequencedWorkerPool::Worker::lazy_tls_ptr_ = LAZY_INSTANCE_INITIALIZER;
+
 // Inner definitions ---------------------------------------------------------
 
 SequencedWorkerPool::Inner::Inner(
     SequencedWorkerPool* worker_pool,
     size_t max_threads,
     const std::string& thread_name_prefix,
+    SchedulingMode scheduling_mode,
     TestingObserver* observer)
     : worker_pool_(worker_pool),
       lock_(),
@@ -518,18 +617,30 @@ SequencedWorkerPool::Inner::Inner(
       can_shutdown_cv_(&lock_),
       max_threads_(max_threads),
       thread_name_prefix_(thread_name_prefix),
+      scheduling_mode_(scheduling_mode),
       thread_being_created_(false),
       waiting_thread_count_(0),
+      atomic_waiting_thread_count_(0),
+      atomic_thread_count_(0),
+      atomic_shutdown_called_(0),
+      next_stealable_queue_(0),
+      stealable_task_count_(0),
+      stealable_blocking_task_count_(0),
+      stealable_blocking_thread_count_(0),
       blocking_shutdown_thread_count_(0),
       next_sequence_task_number_(0),
       blocking_shutdown_pending_task_count_(0),
-      trace_id_(0),
       shutdown_called_(false),
       max_blocking_tasks_after_shutdown_(0),
       cleanup_state_(CLEANUP_DONE),
       cleanup_idlers_(0),
       cleanup_cv_(&lock_),
-      testing_observer_(observer) {}
+      testing_observer_(observer) {
+  if (scheduling_mode_ == SCHEDULE_WORK_STEALING) {
+    for (size_t i = 0; i < max_threads_; ++i)
+      stealable_queues_.push_back(make_linked_ptr(new StealableQueue));
+  }
+}
 
 SequencedWorkerPool::Inner::~Inner() {
   // You must call Shutdown() before destroying the pool.
@@ -575,6 +686,12 @@ bool SequencedWorkerPool::Inner::PostTask(
       base::MakeCriticalClosure(task) : task;
   sequenced.time_to_run = TimeTicks::Now() + delay;
 
+  if (scheduling_mode_ == SCHEDULE_WORK_STEALING &&
+      !optional_token_name && !sequence_token.IsValid() &&
+      delay == TimeDelta() && TryPostStealableTask(sequenced)) {
+    return true;
+  }
+
   int create_thread_id = 0;
   {
     AutoLock lock(lock_);
@@ -591,7 +708,7 @@ bool SequencedWorkerPool::Inner::PostTask(
     }
 
     // The trace_id is used for identifying the task in about:tracing.
-    sequenced.trace_id = trace_id_++;
+    sequenced.trace_id = trace_id_.GetNext();
 
     TRACE_EVENT_FLOW_BEGIN0(TRACE_DISABLED_BY_DEFAULT("toplevel.flow"),
         "SequencedWorkerPool::PostTask",
@@ -642,7 +759,8 @@ void SequencedWorkerPool::Inner::CleanupForTesting() {
   CHECK_EQ(CLEANUP_DONE, cleanup_state_);
   if (shutdown_called_)
     return;
-  if (pending_tasks_.empty() && waiting_thread_count_ == threads_.size())
+  if (pending_tasks_.empty() && !HasStealableTasks() &&
+      waiting_thread_count_ == threads_.size())
     return;
   cleanup_state_ = CLEANUP_REQUESTED;
   cleanup_idlers_ = 0;
@@ -665,6 +783,7 @@ void SequencedWorkerPool::Inner::Shutdown(
     if (shutdown_called_)
       return;
     shutdown_called_ = true;
+    subtle::Barrier_AtomicIncrement(&atomic_shutdown_called_, 1);
     max_blocking_tasks_after_shutdown_ = max_new_blocking_tasks_after_shutdown;
 
     // Tickle the threads. This will wake up a waiting one so it will know that
@@ -712,6 +831,8 @@ void SequencedWorkerPool::Inner::ThreadLoop(Worker* this_worker) {
         threads_.insert(
             std::make_pair(this_worker->tid(), make_linked_ptr(this_worker)));
     DCHECK(result.second);
+    subtle::Release_Store(&atomic_thread_count_,
+                          static_cast<subtle::Atomic32>(threads_.size()));
 
     while (true) {
 #if defined(OS_MACOSX)
@@ -769,6 +890,11 @@ void SequencedWorkerPool::Inner::ThreadLoop(Worker* this_worker) {
               SequenceToken(), CONTINUE_ON_SHUTDOWN);
         }
         DidRunWorkerTask(task);  // Must be done inside the lock.
+
+        if (scheduling_mode_ == SCHEDULE_WORK_STEALING) {
+          AutoUnlock unlock(lock_);
+          RunStealableTasks(this_worker);
+        }
       } else if (cleanup_state_ == CLEANUP_RUNNING) {
         switch (status) {
           case GET_WORK_WAIT: {
@@ -794,20 +920,29 @@ void SequencedWorkerPool::Inner::ThreadLoop(Worker* this_worker) {
         // ones with the same sequence token, but additional threads won't
         // help this case.
         if (shutdown_called_ &&
-            blocking_shutdown_pending_task_count_ == 0)
+            blocking_shutdown_pending_task_count_ == 0 &&
+            subtle::Acquire_Load(&stealable_blocking_task_count_) == 0)
           break;
         waiting_thread_count_++;
-
-        switch (status) {
-          case GET_WORK_NOT_FOUND:
-            has_work_cv_.Wait();
-            break;
-          case GET_WORK_WAIT:
-            has_work_cv_.TimedWait(wait_time);
-            break;
-          default:
-            NOTREACHED();
+        subtle::Barrier_AtomicIncrement(&atomic_waiting_thread_count_, 1);
+
+        // Stealable tasks are posted without |lock_|, and the posting thread
+        // only signals |has_work_cv_| if it sees a waiting thread. Now that
+        // this thread is counted as waiting, check once more so that a task
+        // posted after GetWork() looked at the queues isn't missed.
+        if (!HasStealableTasks()) {
+          switch (status) {
+            case GET_WORK_NOT_FOUND:
+              has_work_cv_.Wait();
+              break;
+            case GET_WORK_WAIT:
+              has_work_cv_.TimedWait(wait_time);
+              break;
+            default:
+              NOTREACHED();
+          }
         }
+        subtle::Barrier_AtomicIncrement(&atomic_waiting_thread_count_, -1);
         waiting_thread_count_--;
       }
     }
@@ -877,6 +1012,163 @@ int SequencedWorkerPool::Inner::LockedGetNamedTokenID(
   return result.id_;
 }
 
+bool SequencedWorkerPool::Inner::TryPostStealableTask(
+    const SequencedTask& task) {
+  DCHECK_EQ(SCHEDULE_WORK_STEALING, scheduling_mode_);
+
+  // Until every worker has been started, only bypass the lock if there is an
+  // idle worker to wake up. Otherwise the locked path has to decide whether
+  // another thread would help.
+  if (subtle::Acquire_Load(&atomic_waiting_thread_count_) == 0 &&
+      static_cast<size_t>(subtle::Acquire_Load(&atomic_thread_count_)) <
+          max_threads_) {
+    return false;
+  }
+
+  // Count the task before checking for shutdown. Shutdown() sets the flag
+  // before looking at the counts in CanShutdown(), so either we see the flag
+  // here or Shutdown() sees the task and waits for it.
+  const bool blocks_shutdown = task.shutdown_behavior == BLOCK_SHUTDOWN;
+  if (blocks_shutdown)
+    subtle::Barrier_AtomicIncrement(&stealable_blocking_task_count_, 1);
+  if (subtle::Acquire_Load(&atomic_shutdown_called_)) {
+    if (blocks_shutdown) {
+      // Shutdown() may already be waiting on this task, so wake it up.
+      AutoLock lock(lock_);
+      subtle::Barrier_AtomicIncrement(&stealable_blocking_task_count_, -1);
+      can_shutdown_cv_.Signal();
+    }
+    return false;
+  }
+
+  SequencedTask stealable(task);
+  stealable.trace_id = trace_id_.GetNext();
+  TRACE_EVENT_FLOW_BEGIN0(TRACE_DISABLED_BY_DEFAULT("toplevel.flow"),
+      "SequencedWorkerPool::PostTask",
+      TRACE_ID_MANGLE(GetTaskTraceID(stealable, static_cast<void*>(this))));
+
+  // Tasks posted from one of our own workers go onto that worker's queue so
+  // they are likely to run on the same thread; others are spread out.
+  size_t index;
+  Worker* current_worker = Worker::GetForCurrentThread();
+  if (current_worker && current_worker->worker_pool() == worker_pool_) {
+    index = static_cast<size_t>(current_worker->thread_number() - 1);
+  } else {
+    index = static_cast<uint32>(
+        subtle::NoBarrier_AtomicIncrement(&next_stealable_queue_, 1)) %
+        stealable_queues_.size();
+  }
+  DCHECK_LT(index, stealable_queues_.size());
+
+  StealableQueue* queue = stealable_queues_[index].get();
+  {
+    AutoLock queue_lock(queue->lock);
+    queue->tasks.push_back(stealable);
+  }
+  subtle::Barrier_AtomicIncrement(&stealable_task_count_, 1);
+
+  // See the matching comment in ThreadLoop() for why this is race-free.
+  if (subtle::Acquire_Load(&atomic_waiting_thread_count_) > 0) {
+    AutoLock lock(lock_);
+    SignalHasWork();
+  }
+  return true;
+}
+
+bool SequencedWorkerPool::Inner::TakeStealableTask(size_t preferred_index,
+                                                   SequencedTask* task) {
+  if (!HasStealableTasks())
+    return false;
+
+  const size_t queue_count = stealable_queues_.size();
+  for (size_t i = 0; i < queue_count; ++i) {
+    StealableQueue* queue = stealable_queues_[(preferred_index + i) %
+                                              queue_count].get();
+    AutoLock queue_lock(queue->lock);
+    if (queue->tasks.empty())
+      continue;
+
+    // Take the most recently posted task from our own queue since its data
+    // is most likely to still be in cache, and the oldest one when stealing.
+    if (i == 0) {
+      *task = queue->tasks.back();
+      queue->tasks.pop_back();
+    } else {
+      *task = queue->tasks.front();
+      queue->tasks.pop_front();
+    }
+    subtle::Barrier_AtomicIncrement(&stealable_task_count_, -1);
+    return true;
+  }
+  return false;
+}
+
+bool SequencedWorkerPool::Inner::HasStealableTasks() const {
+  return subtle::Acquire_Load(&stealable_task_count_) > 0;
+}
+
+void SequencedWorkerPool::Inner::RunStealableTasks(Worker* this_worker) {
+  const size_t preferred_index =
+      static_cast<size_t>(this_worker->thread_number() - 1);
+  for (int i = 0; i < kMaxStealableTasksPerIteration; ++i) {
+#if defined(OS_MACOSX)
+    base::mac::ScopedNSAutoreleasePool autorelease_pool;
+#endif
+    SequencedTask task;
+    if (!TakeStealableTask(preferred_index, &task))
+      return;
+    RunStealableTask(this_worker, &task);
+  }
+}
+
+void SequencedWorkerPool::Inner::RunStealableTask(Worker* this_worker,
+                                                  SequencedTask* task) {
+  // This mirrors WillRunWorkerTask() and DidRunWorkerTask(). The running
+  // count is bumped before the pending count is dropped, and CanShutdown()
+  // reads them in the opposite order, so the task is never invisible to it.
+  const bool blocks_shutdown = task->shutdown_behavior != CONTINUE_ON_SHUTDOWN;
+  if (blocks_shutdown)
+    subtle::Barrier_AtomicIncrement(&stealable_blocking_thread_count_, 1);
+  if (task->shutdown_behavior == BLOCK_SHUTDOWN)
+    subtle::Barrier_AtomicIncrement(&stealable_blocking_task_count_, -1);
+
+  // Tasks that aren't BLOCK_SHUTDOWN are deleted rather than run once
+  // shutdown has started, just like GetWork() does.
+  if (task->shutdown_behavior == BLOCK_SHUTDOWN ||
+      !subtle::Acquire_Load(&atomic_shutdown_called_)) {
+    TRACE_EVENT_FLOW_END0(TRACE_DISABLED_BY_DEFAULT("toplevel.flow"),
+        "SequencedWorkerPool::PostTask",
+        TRACE_ID_MANGLE(GetTaskTraceID(*task, static_cast<void*>(this))));
+    TRACE_EVENT2("toplevel", "SequencedWorkerPool::ThreadLoop",
+                 "src_file", task->posted_from.file_name(),
+                 "src_func", task->posted_from.function_name());
+
+    this_worker->set_running_task_info(SequenceToken(),
+                                       task->shutdown_behavior);
+
+    tracked_objects::TrackedTime start_time =
+        tracked_objects::ThreadData::NowForStartOfRun(task->birth_tally);
+
+    task->task.Run();
+
+    tracked_objects::ThreadData::TallyRunOnNamedThreadIfTracking(*task,
+        start_time, tracked_objects::ThreadData::NowForEndOfRun());
+  }
+
+  // As in ThreadLoop(), destroy the task before clearing the running info.
+  task->task = Closure();
+  this_worker->set_running_task_info(SequenceToken(), CONTINUE_ON_SHUTDOWN);
+
+  if (blocks_shutdown) {
+    subtle::Barrier_AtomicIncrement(&stealable_blocking_thread_count_, -1);
+    if (subtle::Acquire_Load(&atomic_shutdown_called_)) {
+      // Possibly unblock shutdown.
+      AutoLock lock(lock_);
+      can_shutdown_cv_.Signal();
+    }
+  }
+}
+
 int64 SequencedWorkerPool::Inner::LockedGetNextSequenceTaskNumber() {
   lock_.AssertAcquired();
   // We assume that we never create enough tasks to wrap around.
@@ -983,6 +1275,25 @@ SequencedWorkerPool::Inner::GetWorkStatus SequencedWorkerPool::Inner::GetWork(
     break;
   }
 
+  // Tasks on the stealable queues are always runnable, so pick one up if
+  // nothing in |pending_tasks_| can run right now.
+  if (status != GET_WORK_FOUND && scheduling_mode_ == SCHEDULE_WORK_STEALING) {
+    SequencedTask stealable;
+    while (TakeStealableTask(0, &stealable)) {
+      if (stealable.shutdown_behavior == BLOCK_SHUTDOWN)
+        subtle::Barrier_AtomicIncrement(&stealable_blocking_task_count_, -1);
+      if (shutdown_called_ && stealable.shutdown_behavior != BLOCK_SHUTDOWN) {
+        // See above for why this isn't deleted inside the lock.
+        delete_these_outside_lock->push_back(stealable.task);
+        stealable.task = Closure();
+        continue;
+      }
+      *task = stealable;
+      status = GET_WORK_FOUND;
+      break;
+    }
+  }
+
   // Track the number of tasks we had to skip over to see if we should be
   // making this more efficient. If this number ever becomes large or is
   // frequently "some", we should consider the optimization above.
@@ -1081,6 +1392,10 @@ int SequencedWorkerPool::Inner::PrepareToStartAdditionalThreadIfHelpful() {
       threads_.size() < max_threads_ &&
       waiting_thread_count_ == 0) {
     // We could use an additional thread if there's work to be done.
+    if (HasStealableTasks()) {
+      thread_being_created_ = true;
+      return static_cast<int>(threads_.size() + 1);
+    }
     for (PendingTaskSet::const_iterator i = pending_tasks_.begin();
          i != pending_tasks_.end(); ++i) {
       if (IsSequenceTokenRunnable(i->sequence_token_id)) {
@@ -1113,9 +1428,13 @@ void SequencedWorkerPool::Inner::SignalHasWork() {
 bool SequencedWorkerPool::Inner::CanShutdown() const {
   lock_.AssertAcquired();
   // See PrepareToStartAdditionalThreadIfHelpful for how thread creation works.
+  // The stealable pending count must be read before the stealable running
+  // count; see RunStealableTask().
   return !thread_being_created_ &&
          blocking_shutdown_thread_count_ == 0 &&
-         blocking_shutdown_pending_task_count_ == 0;
+         blocking_shutdown_pending_task_count_ == 0 &&
+         subtle::Acquire_Load(&stealable_blocking_task_count_) == 0 &&
+         subtle::Acquire_Load(&stealable_blocking_thread_count_) == 0;
 }
 
 base::StaticAtomicSequenceNumber
@@ -1140,7 +1459,8 @@ SequencedWorkerPool::SequencedWorkerPool(
     size_t max_threads,
     const std::string& thread_name_prefix)
     : constructor_message_loop_(MessageLoopProxy::current()),
-      inner_(new Inner(this, max_threads, thread_name_prefix, NULL)) {
+      inner_(new Inner(this, max_threads, thread_name_prefix,
+                       SCHEDULE_SINGLE_QUEUE, NULL)) {
 }
 
 SequencedWorkerPool::SequencedWorkerPool(
@@ -1148,7 +1468,17 @@ SequencedWorkerPool::SequencedWorkerPool(
     const std::string& thread_name_prefix,
     TestingObserver* observer)
     : constructor_message_loop_(MessageLoopProxy::current()),
-      inner_(new Inner(this, max_threads, thread_name_prefix, observer)) {
+      inner_(new Inner(this, max_threads, thread_name_prefix,
+                       SCHEDULE_SINGLE_QUEUE, observer)) {
+}
+
+SequencedWorkerPool::SequencedWorkerPool(
+    size_t max_threads,
+    const std::string& thread_name_prefix,
+    SchedulingMode scheduling_mode)
+    : constructor_message_loop_(MessageLoopProxy::current()),
+      inner_(new Inner(this, max_threads, thread_name_prefix,
+                       scheduling_mode, NULL)) {
 }
 
 SequencedWorkerPool::~SequencedWorkerPool() {}
@@ -118,6 +118,25 @@ class BASE_EXPORT SequencedWorkerPool : public TaskRunner {
     BLOCK_SHUTDOWN,
   };
 
+  // Defines how unsequenced tasks are handed to the worker threads.
+  enum SchedulingMode {
+    // Every task goes through a single queue guarded by the pool's lock.
+    SCHEDULE_SINGLE_QUEUE,
+
+    // Unsequenced tasks posted without a delay are placed on per-worker
+    // queues that are not guarded by the pool's lock. Workers drain their own
+    // queue first and steal from the other workers' queues when it is empty.
+    // Sequenced and delayed tasks are scheduled exactly as in
+    // SCHEDULE_SINGLE_QUEUE mode, and the shutdown behaviors are honored the
+    // same way in both modes.
+    //
+    // This reduces lock contention for pools with many threads that run
+    // lots of small unsequenced tasks. Unsequenced tasks may run in a
+    // different order than in SCHEDULE_SINGLE_QUEUE mode, which is allowed
+    // since their relative order is unspecified.
+    SCHEDULE_WORK_STEALING,
+  };
+
   // Opaque identifier that defines sequencing of tasks posted to the worker
   // pool.
   class SequenceToken {
@@ -171,6 +190,12 @@ class BASE_EXPORT SequencedWorkerPool : public TaskRunner {
                       const std::string& thread_name_prefix,
                       TestingObserver* observer);
 
+  // Like the first constructor, but allows the scheduling mode to be chosen.
+  // The two-argument constructor uses SCHEDULE_SINGLE_QUEUE.
+  SequencedWorkerPool(size_t max_threads,
+                      const std::string& thread_name_prefix,
+                      SchedulingMode scheduling_mode);
+
   // Returns a unique token that can be used to sequence tasks posted to
   // PostSequencedWorkerTask(). Valid tokens are always nonzero.
   SequenceToken GetSequenceToken();
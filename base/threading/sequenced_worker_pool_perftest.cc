@@ -0,0 +1,131 @@
+// Copyright 2014 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "base/threading/sequenced_worker_pool.h"
+
+#include <string>
+
+#include "base/atomicops.h"
+#include "base/basictypes.h"
+#include "base/bind.h"
+#include "base/format_macros.h"
+#include "base/memory/ref_counted.h"
+#include "base/message_loop/message_loop.h"
+#include "base/strings/stringprintf.h"
+#include "base/synchronization/waitable_event.h"
+#include "base/time/time.h"
+#include "testing/gtest/include/gtest/gtest.h"
+#include "testing/perf/perf_test.h"
+
+namespace base {
+
+namespace {
+
+const int kNumTasks = 100000;
+
+// The worker thread counts to measure.
+const size_t kThreadCounts[] = {1, 2, 4, 8, 16, 32};
+
+// Counts down the number of outstanding tasks and signals |done_| once the
+// last one has run.
+class TaskCounter : public RefCountedThreadSafe<TaskCounter> {
+ public:
+  explicit TaskCounter(int count)
+      : remaining_(count),
+        done_(false, false) {}
+
+  void RunTask() {
+    if (subtle::Barrier_AtomicIncrement(&remaining_, -1) == 0)
+      done_.Signal();
+  }
+
+  // Posts another task and counts down, so that tasks are posted from the
+  // worker threads as well as from the main thread.
+  void RunTaskAndRepost(SequencedWorkerPool* pool, int reposts_left) {
+    if (reposts_left > 0) {
+      pool->PostWorkerTask(FROM_HERE,
+                           Bind(&TaskCounter::RunTaskAndRepost, this,
+                                Unretained(pool), reposts_left - 1));
+    }
+    RunTask();
+  }
+
+  void Wait() { done_.Wait(); }
+
+ private:
+  friend class RefCountedThreadSafe<TaskCounter>;
+  ~TaskCounter() {}
+
+  subtle::Atomic32 remaining_;
+  WaitableEvent done_;
+
+  DISALLOW_COPY_AND_ASSIGN(TaskCounter);
+};
+
+class SequencedWorkerPoolPerfTest : public testing::Test {
+ protected:
+  // Runs |kNumTasks| trivial unsequenced tasks on a pool with |num_threads|
+  // workers and reports the throughput. If |repost_depth| is nonzero, only
+  // kNumTasks / (repost_depth + 1) tasks are posted from the main thread and
+  // each of them posts a chain of |repost_depth| follow-up tasks.
+  void RunTest(const std::string& trace,
+               SequencedWorkerPool::SchedulingMode mode,
+               int repost_depth) {
+    for (size_t i = 0; i < arraysize(kThreadCounts); ++i) {
+      const size_t num_threads = kThreadCounts[i];
+      scoped_refptr<SequencedWorkerPool> pool(
+          new SequencedWorkerPool(num_threads, "PerfTest", mode));
+
+      // Warm up so that all the worker threads exist before measuring.
+      scoped_refptr<TaskCounter> warm_up(
+          new TaskCounter(static_cast<int>(num_threads) * 16));
+      for (size_t j = 0; j < num_threads * 16; ++j)
+        pool->PostWorkerTask(FROM_HERE, Bind(&TaskCounter::RunTask, warm_up));
+      warm_up->Wait();
+
+      const int chains = kNumTasks / (repost_depth + 1);
+      scoped_refptr<TaskCounter> counter(
+          new TaskCounter(chains * (repost_depth + 1)));
+      TimeTicks start = TimeTicks::HighResNow();
+      for (int j = 0; j < chains; ++j) {
+        pool->PostWorkerTask(FROM_HERE,
+                             Bind(&TaskCounter::RunTaskAndRepost, counter,
+                                  Unretained(pool.get()), repost_depth));
+      }
+      counter->Wait();
+      TimeDelta elapsed = TimeTicks::HighResNow() - start;
+      pool->Shutdown();
+
+      perf_test::PrintResult(
+          "tasks_per_second", StringPrintf("_%" PRIuS "_threads", num_threads),
+          trace, chains * (repost_depth + 1) / elapsed.InSecondsF(),
+          "tasks/s", true);
+    }
+  }
+
+ private:
+  MessageLoop message_loop_;
+};
+
+TEST_F(SequencedWorkerPoolPerfTest, SingleQueue) {
+  RunTest("single_queue", SequencedWorkerPool::SCHEDULE_SINGLE_QUEUE, 0);
+}
+
+TEST_F(SequencedWorkerPoolPerfTest, WorkStealing) {
+  RunTest("work_stealing", SequencedWorkerPool::SCHEDULE_WORK_STEALING, 0);
+}
+
+TEST_F(SequencedWorkerPoolPerfTest, SingleQueueReposting) {
+  RunTest("single_queue_reposting",
+          SequencedWorkerPool::SCHEDULE_SINGLE_QUEUE, 9);
+}
+
+TEST_F(SequencedWorkerPoolPerfTest, WorkStealingReposting) {
+  RunTest("work_stealing_reposting",
+          SequencedWorkerPool::SCHEDULE_WORK_STEALING, 9);
+}
+
+}  // namespace
+
+}  // namespace base
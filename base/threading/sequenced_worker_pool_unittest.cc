@@ -808,6 +808,42 @@ TEST(SequencedWorkerPoolRefPtrTest, ShutsDownCleanWithContinueOnShutdown) {
   pool->Shutdown();
 }
 
+// Tests that every BLOCK_SHUTDOWN task posted to a work-stealing pool runs
+// before Shutdown() returns, and that sequenced tasks keep their order.
+TEST(SequencedWorkerPoolWorkStealingTest, BlockShutdownAndSequencing) {
+  MessageLoop loop;
+  scoped_refptr<TestTracker> tracker(new TestTracker);
+  scoped_refptr<SequencedWorkerPool> pool(new SequencedWorkerPool(
+      kNumWorkerThreads, "WorkStealing",
+      SequencedWorkerPool::SCHEDULE_WORK_STEALING));
+
+  SequencedWorkerPool::SequenceToken token = pool->GetSequenceToken();
+  const int kNumTasks = 200;
+  for (int i = 0; i < kNumTasks; ++i) {
+    EXPECT_TRUE(pool->PostWorkerTask(
+        FROM_HERE, base::Bind(&TestTracker::FastTask, tracker, -1)));
+    EXPECT_TRUE(pool->PostSequencedWorkerTask(
+        token, FROM_HERE, base::Bind(&TestTracker::FastTask, tracker, i)));
+  }
+  pool->Shutdown();
+
+  std::vector<int> result = tracker->WaitUntilTasksComplete(2 * kNumTasks);
+  ASSERT_EQ(static_cast<size_t>(2 * kNumTasks), result.size());
+  int last_sequenced = -1;
+  for (size_t i = 0; i < result.size(); ++i) {
+    if (result[i] == -1)
+      continue;
+    EXPECT_EQ(last_sequenced + 1, result[i]);
+    last_sequenced = result[i];
+  }
+  EXPECT_EQ(kNumTasks - 1, last_sequenced);
+
+  // Posting after shutdown must fail in this mode too.
+  EXPECT_FALSE(pool->PostWorkerTaskWithShutdownBehavior(
+      FROM_HERE, base::Bind(&TestTracker::FastTask, tracker, -1),
+      SequencedWorkerPool::SKIP_ON_SHUTDOWN));
+}
+
 class SequencedWorkerPoolTaskRunnerTestDelegate {
  public:
   SequencedWorkerPoolTaskRunnerTestDelegate() {}
@@ -878,6 +914,38 @@ INSTANTIATE_TYPED_TEST_CASE_P(
     SequencedWorkerPoolTaskRunner, TaskRunnerTest,
     SequencedWorkerPoolTaskRunnerWithShutdownBehaviorTestDelegate);
 
+class SequencedWorkerPoolWorkStealingTestDelegate {
+ public:
+  SequencedWorkerPoolWorkStealingTestDelegate() {}
+
+  ~SequencedWorkerPoolWorkStealingTestDelegate() {}
+
+  void StartTaskRunner() {
+    pool_ = new SequencedWorkerPool(
+        10, "SequencedWorkerPoolWorkStealingTest",
+        SequencedWorkerPool::SCHEDULE_WORK_STEALING);
+  }
+
+  scoped_refptr<SequencedWorkerPool> GetTaskRunner() {
+    return pool_;
+  }
+
+  void StopTaskRunner() {
+    // Make sure all tasks are run before shutting down. Delayed tasks are
+    // not run, they're simply deleted.
+    pool_->FlushForTesting();
+    pool_->Shutdown();
+  }
+
+ private:
+  MessageLoop message_loop_;
+  scoped_refptr<SequencedWorkerPool> pool_;
+};
+
+INSTANTIATE_TYPED_TEST_CASE_P(
+    SequencedWorkerPoolWorkStealing, TaskRunnerTest,
+    SequencedWorkerPoolWorkStealingTestDelegate);
+
 class SequencedWorkerPoolSequencedTaskRunnerTestDelegate {
  public:
   SequencedWorkerPoolSequencedTaskRunnerTestDelegate() {}
@@ -8,6 +8,8 @@
 
 #include "base/logging.h"
 #include "base/memory/ref_counted.h"
+#include "base/message_loop/message_loop.h"
+#include "base/message_loop/timer_wheel.h"
 #include "base/single_thread_task_runner.h"
 #include "base/thread_task_runner_handle.h"
 #include "base/threading/platform_thread.h"
@@ -59,6 +61,27 @@ class BaseTimerTaskInternal {
   Timer* timer_;
 };
 
+// BaseTimerWheelEntry holds Timer's task in the delayed work queue of the
+// thread's MessageLoop. Unlike BaseTimerTaskInternal it's owned by Timer,
+// which removes it from the queue when the timer is stopped or reset.
+class BaseTimerWheelEntry : public TimerWheel::Entry {
+ public:
+  BaseTimerWheelEntry(Timer* timer, const PendingTask& pending_task)
+      : TimerWheel::Entry(pending_task),
+        timer_(timer) {
+  }
+
+ private:
+  virtual void OnDropped() OVERRIDE {
+    // The MessageLoop is being destroyed, so the task will never run.
+    timer_->StopAndAbandon();
+  }
+
+  Timer* timer_;
+
+  DISALLOW_COPY_AND_ASSIGN(BaseTimerWheelEntry);
+};
+
 Timer::Timer(bool retain_user_task, bool is_repeating)
     : scheduled_task_(NULL),
       thread_id_(0),
@@ -94,6 +117,7 @@ void Timer::Start(const tracked_objects::Location& posted_from,
 
 void Timer::Stop() {
   is_running_ = false;
+  CancelWheelEntry();
   if (!retain_user_task_)
     user_task_.Reset();
 }
@@ -101,6 +125,9 @@ void Timer::Stop() {
 void Timer::Reset() {
   DCHECK(!user_task_.is_null());
 
+  // A task in the MessageLoop's delayed work queue can simply be moved.
+  CancelWheelEntry();
+
   // If there's no pending task, start one up and return.
   if (!scheduled_task_) {
     PostNewScheduledTask(delay_);
@@ -136,13 +163,33 @@ void Timer::SetTaskInfo(const tracked_objects::Location& posted_from,
 void Timer::PostNewScheduledTask(TimeDelta delay) {
   DCHECK(scheduled_task_ == NULL);
   is_running_ = true;
-  scheduled_task_ = new BaseTimerTaskInternal(this);
-  if (delay > TimeDelta::FromMicroseconds(0)) {
+  if (MessageLoop* message_loop = MessageLoop::current()) {
+    if (!wheel_entry_) {
+      wheel_entry_.reset(new BaseTimerWheelEntry(this, PendingTask(
+          posted_from_, base::Bind(&Timer::RunScheduledTask,
+                                   base::Unretained(this)),
+          TimeTicks(), true)));
+    }
+    DCHECK(!wheel_entry_->IsScheduled());
+    TimeTicks now = TimeTicks::Now();
+    PendingTask* pending_task = wheel_entry_->mutable_pending_task();
+    pending_task->posted_from = posted_from_;
+    if (delay > TimeDelta::FromMicroseconds(0)) {
+      pending_task->delayed_run_time = now + delay;
+      scheduled_run_time_ = desired_run_time_ = now + delay;
+    } else {
+      pending_task->delayed_run_time = now;
+      scheduled_run_time_ = desired_run_time_ = TimeTicks();
+    }
+    message_loop->AddDelayedEntry(wheel_entry_.get());
+  } else if (delay > TimeDelta::FromMicroseconds(0)) {
+    scheduled_task_ = new BaseTimerTaskInternal(this);
     ThreadTaskRunnerHandle::Get()->PostDelayedTask(posted_from_,
         base::Bind(&BaseTimerTaskInternal::Run, base::Owned(scheduled_task_)),
         delay);
     scheduled_run_time_ = desired_run_time_ = TimeTicks::Now() + delay;
   } else {
+    scheduled_task_ = new BaseTimerTaskInternal(this);
     ThreadTaskRunnerHandle::Get()->PostTask(posted_from_,
         base::Bind(&BaseTimerTaskInternal::Run, base::Owned(scheduled_task_)));
     scheduled_run_time_ = desired_run_time_ = TimeTicks();
@@ -153,6 +200,11 @@ void Timer::PostNewScheduledTask(TimeDelta delay) {
     thread_id_ = static_cast<int>(PlatformThread::CurrentId());
 }
 
+void Timer::CancelWheelEntry() {
+  if (wheel_entry_ && wheel_entry_->IsScheduled())
+    MessageLoop::current()->RemoveDelayedEntry(wheel_entry_.get());
+}
+
 void Timer::AbandonScheduledTask() {
   DCHECK(thread_id_ == 0 ||
          thread_id_ == static_cast<int>(PlatformThread::CurrentId()));
@@ -55,17 +55,23 @@
 #include "base/bind_helpers.h"
 #include "base/callback.h"
 #include "base/location.h"
+#include "base/memory/scoped_ptr.h"
 #include "base/time/time.h"
 
 namespace base {
 
 class BaseTimerTaskInternal;
+class BaseTimerWheelEntry;
 
 //-----------------------------------------------------------------------------
 // This class wraps MessageLoop::PostDelayedTask to manage delayed and repeating
 // tasks. It must be destructed on the same thread that starts tasks. There are
 // DCHECKs in place to verify this.
 //
+// On a MessageLoop thread the task is scheduled with
+// MessageLoop::AddDelayedEntry() instead, so that Stop() and Reset() take
+// constant time and don't leave an abandoned task in the loop.
+//
 class BASE_EXPORT Timer {
  public:
   // Construct a timer in repeating or one-shot mode. Start or SetTaskInfo must
@@ -117,12 +123,17 @@ class BASE_EXPORT Timer {
 
  private:
   friend class BaseTimerTaskInternal;
+  friend class BaseTimerWheelEntry;
 
   // Allocates a new scheduled_task_ and posts it on the current MessageLoop
-  // with the given |delay|. scheduled_task_ must be NULL. scheduled_run_time_
-  // and desired_run_time_ are reset to Now() + delay.
+  // with the given |delay|, or adds wheel_entry_ to the MessageLoop's delayed
+  // work queue. scheduled_task_ must be NULL and wheel_entry_ not scheduled.
+  // scheduled_run_time_ and desired_run_time_ are reset to Now() + delay.
   void PostNewScheduledTask(TimeDelta delay);
 
+  // Removes wheel_entry_ from the MessageLoop if it's there.
+  void CancelWheelEntry();
+
   // Disable scheduled_task_ and abandon it so that it no longer refers back to
   // this object.
   void AbandonScheduledTask();
@@ -140,6 +151,10 @@ class BASE_EXPORT Timer {
   // RunScheduledTask() at scheduled_run_time_.
   BaseTimerTaskInternal* scheduled_task_;
 
+  // Used instead of scheduled_task_ when the timer runs on a MessageLoop. It
+  // is created the first time the timer starts, and reused afterwards.
+  scoped_ptr<BaseTimerWheelEntry> wheel_entry_;
+
   // Location in user code.
   tracked_objects::Location posted_from_;
   // Delay requested by user.
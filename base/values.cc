@@ -63,6 +63,26 @@ Value* CopyWithoutEmptyChildren(const Value* node) {
   }
 }
 
+// Compacts every dictionary in the tree rooted at |node|.
+void CompactDictionaries(Value* node) {
+  if (node->IsType(Value::TYPE_DICTIONARY)) {
+    static_cast<DictionaryValue*>(node)->Compact();
+  } else if (node->IsType(Value::TYPE_LIST)) {
+    ListValue* list = static_cast<ListValue*>(node);
+    for (ListValue::iterator it = list->begin(); it != list->end(); ++it)
+      CompactDictionaries(*it);
+  }
+}
+
+// Orders the entries of a compact DictionaryValue against a key, for
+// std::lower_bound.
+struct CompactEntryKeyLess {
+  bool operator()(const std::pair<std::string, Value*>& entry,
+                  const std::string& key) const {
+    return entry.first < key;
+  }
+};
+
 // A small functor for comparing Values for std::find_if and similar.
 class ValueEquals {
  public:
@@ -360,7 +380,8 @@ bool BinaryValue::Equals(const Value* other) const {
 ///////////////////// DictionaryValue ////////////////////
 
 DictionaryValue::DictionaryValue()
-    : Value(TYPE_DICTIONARY) {
+    : Value(TYPE_DICTIONARY),
+      compact_(false) {
 }
 
 DictionaryValue::~DictionaryValue() {
@@ -381,9 +402,7 @@ bool DictionaryValue::GetAsDictionary(const DictionaryValue** out_value) const {
 
 bool DictionaryValue::HasKey(const std::string& key) const {
   DCHECK(IsStringUTF8(key));
-  ValueMap::const_iterator current_entry = dictionary_.find(key);
-  DCHECK((current_entry == dictionary_.end()) || current_entry->second);
-  return current_entry != dictionary_.end();
+  return FindValue(key) != NULL;
 }
 
 void DictionaryValue::Clear() {
@@ -394,6 +413,13 @@ void DictionaryValue::Clear() {
   }
 
   dictionary_.clear();
+
+  for (CompactValueMap::iterator it = compact_dictionary_.begin();
+       it != compact_dictionary_.end(); ++it) {
+    delete it->second;
+  }
+  CompactValueMap().swap(compact_dictionary_);
+  compact_ = false;
 }
 
 void DictionaryValue::Set(const std::string& path, Value* in_value) {
@@ -444,6 +470,19 @@ void DictionaryValue::SetString(const std::string& path,
 
 void DictionaryValue::SetWithoutPathExpansion(const std::string& key,
                                               Value* in_value) {
+  if (compact_) {
+    CompactValueMap::iterator entry =
+        std::lower_bound(compact_dictionary_.begin(),
+                         compact_dictionary_.end(), key, CompactEntryKeyLess());
+    if (entry != compact_dictionary_.end() && entry->first == key) {
+      DCHECK_NE(entry->second, in_value);  // This would be bogus
+      delete entry->second;
+      entry->second = in_value;
+      return;
+    }
+    Expand();
+  }
+
   // If there's an existing value here, we need to delete it, because
   // we own all our children.
   std::pair<ValueMap::iterator, bool> ins_res =
@@ -628,11 +667,10 @@ bool DictionaryValue::GetList(const std::string& path, ListValue** out_value) {
 bool DictionaryValue::GetWithoutPathExpansion(const std::string& key,
                                               const Value** out_value) const {
   DCHECK(IsStringUTF8(key));
-  ValueMap::const_iterator entry_iterator = dictionary_.find(key);
-  if (entry_iterator == dictionary_.end())
+  const Value* entry = FindValue(key);
+  if (!entry)
     return false;
 
-  const Value* entry = entry_iterator->second;
   if (out_value)
     *out_value = entry;
   return true;
@@ -757,6 +795,12 @@ bool DictionaryValue::Remove(const std::string& path,
 bool DictionaryValue::RemoveWithoutPathExpansion(const std::string& key,
                                                  scoped_ptr<Value>* out_value) {
   DCHECK(IsStringUTF8(key));
+  if (compact_) {
+    if (!FindValue(key))
+      return false;
+    Expand();
+  }
+
   ValueMap::iterator entry_iterator = dictionary_.find(key);
   if (entry_iterator == dictionary_.end())
     return false;
@@ -814,17 +858,78 @@ void DictionaryValue::MergeDictionary(const DictionaryValue* dictionary) {
 
 void DictionaryValue::Swap(DictionaryValue* other) {
   dictionary_.swap(other->dictionary_);
+  compact_dictionary_.swap(other->compact_dictionary_);
+  std::swap(compact_, other->compact_);
+}
+
+void DictionaryValue::Compact() {
+  if (!compact_) {
+    CompactValueMap compact_dictionary;
+    // ValueMap is already sorted by key.
+    compact_dictionary.assign(dictionary_.begin(), dictionary_.end());
+    dictionary_.clear();
+    compact_dictionary_.swap(compact_dictionary);
+    compact_ = true;
+  }
+
+  for (CompactValueMap::iterator it = compact_dictionary_.begin();
+       it != compact_dictionary_.end(); ++it) {
+    CompactDictionaries(it->second);
+  }
+}
+
+Value* DictionaryValue::FindValue(const std::string& key) const {
+  if (compact_) {
+    CompactValueMap::const_iterator entry =
+        std::lower_bound(compact_dictionary_.begin(),
+                         compact_dictionary_.end(), key, CompactEntryKeyLess());
+    if (entry == compact_dictionary_.end() || entry->first != key)
+      return NULL;
+    DCHECK(entry->second);
+    return entry->second;
+  }
+
+  ValueMap::const_iterator entry = dictionary_.find(key);
+  if (entry == dictionary_.end())
+    return NULL;
+  DCHECK(entry->second);
+  return entry->second;
+}
+
+void DictionaryValue::Expand() {
+  DCHECK(compact_);
+  DCHECK(dictionary_.empty());
+  for (CompactValueMap::const_iterator it = compact_dictionary_.begin();
+       it != compact_dictionary_.end(); ++it) {
+    // The entries are sorted, so each one goes at the end.
+    dictionary_.insert(dictionary_.end(), *it);
+  }
+  CompactValueMap().swap(compact_dictionary_);
+  compact_ = false;
 }
 
 DictionaryValue::Iterator::Iterator(const DictionaryValue& target)
     : target_(target),
-      it_(target.dictionary_.begin()) {}
+      it_(target.dictionary_.begin()),
+      compact_it_(target.compact_dictionary_.begin()) {}
 
 DictionaryValue::Iterator::~Iterator() {}
 
 DictionaryValue* DictionaryValue::DeepCopy() const {
   DictionaryValue* result = new DictionaryValue;
 
+  if (compact_) {
+    // Copies of compact dictionaries are compact too.
+    result->compact_dictionary_.reserve(compact_dictionary_.size());
+    for (CompactValueMap::const_iterator it = compact_dictionary_.begin();
+         it != compact_dictionary_.end(); ++it) {
+      result->compact_dictionary_.push_back(
+          std::make_pair(it->first, it->second->DeepCopy()));
+    }
+    result->compact_ = true;
+    return result;
+  }
+
   for (ValueMap::const_iterator current_entry(dictionary_.begin());
        current_entry != dictionary_.end(); ++current_entry) {
     result->SetWithoutPathExpansion(current_entry->first,
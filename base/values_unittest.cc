@@ -809,4 +809,89 @@ TEST(ValuesTest, DictionaryIterator) {
   EXPECT_TRUE(seen2);
 }
 
+TEST(ValuesTest, CompactDictionary) {
+  DictionaryValue dict;
+  dict.SetString("b", "value_b");
+  dict.SetInteger("a", 1);
+  dict.SetBoolean("c.d", true);
+  ListValue* list = new ListValue;
+  list->Append(new DictionaryValue);
+  dict.Set("e", list);
+  scoped_ptr<DictionaryValue> original(dict.DeepCopy());
+
+  dict.Compact();
+  EXPECT_TRUE(dict.is_compact());
+  DictionaryValue* child = NULL;
+  ASSERT_TRUE(dict.GetDictionary("c", &child));
+  EXPECT_TRUE(child->is_compact());
+  ASSERT_TRUE(list->GetDictionary(0, &child));
+  EXPECT_TRUE(child->is_compact());
+  EXPECT_TRUE(dict.Equals(original.get()));
+  EXPECT_TRUE(original->Equals(&dict));
+
+  EXPECT_EQ(4U, dict.size());
+  EXPECT_TRUE(dict.HasKey("a"));
+  EXPECT_FALSE(dict.HasKey("aa"));
+  std::string string_value;
+  EXPECT_TRUE(dict.GetString("b", &string_value));
+  EXPECT_EQ("value_b", string_value);
+  bool bool_value = false;
+  EXPECT_TRUE(dict.GetBoolean("c.d", &bool_value));
+  EXPECT_TRUE(bool_value);
+
+  // Iteration is in key order, just like for the regular representation.
+  DictionaryValue::Iterator it(dict);
+  EXPECT_EQ("a", it.key());
+  it.Advance();
+  EXPECT_EQ("b", it.key());
+  it.Advance();
+  EXPECT_EQ("c", it.key());
+  it.Advance();
+  EXPECT_EQ("e", it.key());
+  it.Advance();
+  EXPECT_TRUE(it.IsAtEnd());
+
+  // Copies stay compact.
+  scoped_ptr<DictionaryValue> copy(dict.DeepCopy());
+  EXPECT_TRUE(copy->is_compact());
+  EXPECT_TRUE(copy->Equals(original.get()));
+
+  // Replacing a value leaves the dictionary compact, adding one doesn't.
+  dict.SetInteger("a", 2);
+  EXPECT_TRUE(dict.is_compact());
+  int int_value = 0;
+  EXPECT_TRUE(dict.GetInteger("a", &int_value));
+  EXPECT_EQ(2, int_value);
+  dict.SetInteger("f", 3);
+  EXPECT_FALSE(dict.is_compact());
+  EXPECT_EQ(5U, dict.size());
+  EXPECT_TRUE(dict.GetInteger("a", &int_value));
+  EXPECT_EQ(2, int_value);
+  EXPECT_TRUE(dict.GetString("b", &string_value));
+
+  // Failing to remove a key leaves the dictionary compact, removing one
+  // doesn't.
+  copy->Compact();
+  EXPECT_FALSE(copy->RemoveWithoutPathExpansion("z", NULL));
+  EXPECT_TRUE(copy->is_compact());
+  scoped_ptr<Value> removed;
+  EXPECT_TRUE(copy->RemoveWithoutPathExpansion("b", &removed));
+  EXPECT_FALSE(copy->is_compact());
+  EXPECT_TRUE(removed->GetAsString(&string_value));
+  EXPECT_EQ("value_b", string_value);
+  EXPECT_EQ(3U, copy->size());
+
+  // Swap() exchanges the representations along with the contents.
+  DictionaryValue other;
+  original->Compact();
+  other.Swap(original.get());
+  EXPECT_TRUE(other.is_compact());
+  EXPECT_FALSE(original->is_compact());
+  EXPECT_TRUE(original->empty());
+
+  other.Clear();
+  EXPECT_FALSE(other.is_compact());
+  EXPECT_TRUE(other.empty());
+}
+
 }  // namespace base
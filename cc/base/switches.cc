@@ -151,6 +151,15 @@ const char kDisable4444Textures[] = "disable-4444-textures";
 const char kDisableCompositorTouchHitTesting[] =
     "disable-compositor-touch-hit-testing";
 
+// Keep the main thread pipelined a frame behind the impl thread, instead of
+// skipping a BeginMainFrame to recover low latency when it has become fast
+// enough to commit and activate before the impl frame deadline.
+const char kDisableLowLatencyRecovery[] = "disable-low-latency-recovery";
+
+// Rasterize the tiles hidden behind opaque layers too.
+const char kDisableOcclusionForTilePrioritization[] =
+    "disable-occlusion-for-tile-prioritization";
+
 bool IsLCDTextEnabled() {
   const CommandLine* command_line = CommandLine::ForCurrentProcess();
   if (command_line->HasSwitch(switches::kDisableLCDText))
@@ -0,0 +1,41 @@
+// Copyright 2014 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "cc/debug/layer_tree_dump_benchmark.h"
+
+#include "base/bind.h"
+#include "base/message_loop/message_loop_proxy.h"
+#include "base/values.h"
+#include "cc/debug/layer_tree_dump_benchmark_impl.h"
+
+namespace cc {
+
+LayerTreeDumpBenchmark::LayerTreeDumpBenchmark(scoped_ptr<base::Value> value,
+                                               const DoneCallback& callback)
+    : MicroBenchmark(callback),
+      weak_ptr_factory_(this) {}
+
+LayerTreeDumpBenchmark::~LayerTreeDumpBenchmark() {
+  weak_ptr_factory_.InvalidateWeakPtrs();
+}
+
+void LayerTreeDumpBenchmark::DidUpdateLayers(LayerTreeHost* host) {
+  // The tree is dumped on the impl side, where the draw properties it
+  // includes are computed.
+}
+
+void LayerTreeDumpBenchmark::RecordImplResults(
+    scoped_ptr<base::Value> results) {
+  NotifyDone(results.Pass());
+}
+
+scoped_ptr<MicroBenchmarkImpl> LayerTreeDumpBenchmark::CreateBenchmarkImpl(
+    scoped_refptr<base::MessageLoopProxy> origin_loop) {
+  return scoped_ptr<MicroBenchmarkImpl>(new LayerTreeDumpBenchmarkImpl(
+      origin_loop,
+      base::Bind(&LayerTreeDumpBenchmark::RecordImplResults,
+                 weak_ptr_factory_.GetWeakPtr())));
+}
+
+}  // namespace cc
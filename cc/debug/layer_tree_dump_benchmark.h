@@ -0,0 +1,37 @@
+// Copyright 2014 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef CC_DEBUG_LAYER_TREE_DUMP_BENCHMARK_H_
+#define CC_DEBUG_LAYER_TREE_DUMP_BENCHMARK_H_
+
+#include "base/memory/weak_ptr.h"
+#include "cc/debug/micro_benchmark.h"
+
+namespace cc {
+
+// Captures the layer tree of the page as JSON, in the format read by
+// ParseTreeFromJson(), so that it can be saved to cc/test/data and replayed
+// by the layer tree perftests.
+class CC_EXPORT LayerTreeDumpBenchmark : public MicroBenchmark {
+ public:
+  LayerTreeDumpBenchmark(scoped_ptr<base::Value> value,
+                         const DoneCallback& callback);
+  virtual ~LayerTreeDumpBenchmark();
+
+  // Implements MicroBenchmark interface.
+  virtual void DidUpdateLayers(LayerTreeHost* host) OVERRIDE;
+
+ protected:
+  virtual scoped_ptr<MicroBenchmarkImpl> CreateBenchmarkImpl(
+      scoped_refptr<base::MessageLoopProxy> origin_loop) OVERRIDE;
+
+ private:
+  void RecordImplResults(scoped_ptr<base::Value> results);
+
+  base::WeakPtrFactory<LayerTreeDumpBenchmark> weak_ptr_factory_;
+};
+
+}  // namespace cc
+
+#endif  // CC_DEBUG_LAYER_TREE_DUMP_BENCHMARK_H_
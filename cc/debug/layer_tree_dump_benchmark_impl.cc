@@ -0,0 +1,36 @@
+// Copyright 2014 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "cc/debug/layer_tree_dump_benchmark_impl.h"
+
+#include "base/message_loop/message_loop_proxy.h"
+#include "base/values.h"
+#include "cc/layers/layer_impl.h"
+#include "cc/trees/layer_tree_host_impl.h"
+#include "cc/trees/layer_tree_impl.h"
+
+namespace cc {
+
+LayerTreeDumpBenchmarkImpl::LayerTreeDumpBenchmarkImpl(
+    scoped_refptr<base::MessageLoopProxy> origin_loop,
+    const DoneCallback& callback)
+    : MicroBenchmarkImpl(callback, origin_loop) {}
+
+LayerTreeDumpBenchmarkImpl::~LayerTreeDumpBenchmarkImpl() {}
+
+void LayerTreeDumpBenchmarkImpl::DidCompleteCommit(LayerTreeHostImpl* host) {
+  scoped_ptr<base::DictionaryValue> result(new base::DictionaryValue());
+
+  LayerTreeImpl* active_tree = host->active_tree();
+  if (active_tree->root_layer()) {
+    // The dump includes the draw transforms, so have them up to date.
+    if (active_tree->needs_update_draw_properties())
+      active_tree->UpdateDrawProperties();
+    result->Set("layer_tree", active_tree->root_layer()->LayerTreeAsJson());
+  }
+
+  NotifyDone(result.PassAs<base::Value>());
+}
+
+}  // namespace cc
@@ -0,0 +1,29 @@
+// Copyright 2014 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef CC_DEBUG_LAYER_TREE_DUMP_BENCHMARK_IMPL_H_
+#define CC_DEBUG_LAYER_TREE_DUMP_BENCHMARK_IMPL_H_
+
+#include "cc/debug/micro_benchmark_impl.h"
+
+namespace base {
+class MessageLoopProxy;
+}
+
+namespace cc {
+
+class LayerTreeHostImpl;
+class CC_EXPORT LayerTreeDumpBenchmarkImpl : public MicroBenchmarkImpl {
+ public:
+  LayerTreeDumpBenchmarkImpl(scoped_refptr<base::MessageLoopProxy> origin_loop,
+                             const DoneCallback& callback);
+  virtual ~LayerTreeDumpBenchmarkImpl();
+
+  // Implements MicroBenchmarkImpl interface.
+  virtual void DidCompleteCommit(LayerTreeHostImpl* host) OVERRIDE;
+};
+
+}  // namespace cc
+
+#endif  // CC_DEBUG_LAYER_TREE_DUMP_BENCHMARK_IMPL_H_
@@ -4,9 +4,11 @@
 
 #include "base/callback.h"
 #include "base/memory/scoped_ptr.h"
+#include "base/values.h"
 #include "cc/debug/micro_benchmark.h"
 #include "cc/debug/micro_benchmark_controller.h"
 #include "cc/layers/layer.h"
+#include "cc/layers/layer_impl.h"
 #include "cc/resources/resource_update_queue.h"
 #include "cc/test/fake_layer_tree_host.h"
 #include "cc/test/fake_layer_tree_host_impl.h"
@@ -46,6 +48,11 @@ void IncrementCallCount(int* count, scoped_ptr<base::Value> value) {
   ++(*count);
 }
 
+void SaveResult(scoped_ptr<base::Value>* result,
+                scoped_ptr<base::Value> value) {
+  *result = value.Pass();
+}
+
 TEST_F(MicroBenchmarkControllerTest, ScheduleFail) {
   bool result = layer_tree_host_->ScheduleMicroBenchmark(
       "non_existant_benchmark", scoped_ptr<base::Value>(), base::Bind(&Noop));
@@ -137,5 +144,36 @@ TEST_F(MicroBenchmarkControllerTest, BenchmarkImplRan) {
   EXPECT_EQ(1, run_count);
 }
 
+TEST_F(MicroBenchmarkControllerTest, LayerTreeDumpBenchmark) {
+  layer_tree_host_impl_->active_tree()->SetRootLayer(
+      LayerImpl::Create(layer_tree_host_impl_->active_tree(), 1));
+
+  scoped_ptr<base::Value> result;
+  bool scheduled = layer_tree_host_->ScheduleMicroBenchmark(
+      "layer_tree_dump_benchmark",
+      scoped_ptr<base::Value>(),
+      base::Bind(&SaveResult, base::Unretained(&result)));
+  EXPECT_TRUE(scheduled);
+
+  scoped_ptr<ResourceUpdateQueue> queue(new ResourceUpdateQueue);
+  layer_tree_host_->SetOutputSurfaceLostForTesting(false);
+  layer_tree_host_->UpdateLayers(queue.get());
+  EXPECT_FALSE(result);
+
+  layer_tree_host_->GetMicroBenchmarkController()->ScheduleImplBenchmarks(
+      layer_tree_host_impl_.get());
+  layer_tree_host_impl_->CommitComplete();
+  base::MessageLoop::current()->RunUntilIdle();
+
+  ASSERT_TRUE(result);
+  base::DictionaryValue* dictionary = NULL;
+  ASSERT_TRUE(result->GetAsDictionary(&dictionary));
+  base::DictionaryValue* layer_tree = NULL;
+  ASSERT_TRUE(dictionary->GetDictionary("layer_tree", &layer_tree));
+  std::string layer_type;
+  EXPECT_TRUE(layer_tree->GetString("LayerType", &layer_type));
+  EXPECT_EQ("cc::LayerImpl", layer_type);
+}
+
 }  // namespace
 }  // namespace cc
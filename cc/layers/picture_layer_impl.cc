@@ -22,6 +22,7 @@
 #include "cc/quads/tile_draw_quad.h"
 #include "cc/resources/tile_manager.h"
 #include "cc/trees/layer_tree_impl.h"
+#include "cc/trees/occlusion_tracker.h"
 #include "ui/gfx/quad_f.h"
 #include "ui/gfx/rect_conversions.h"
 #include "ui/gfx/size_conversions.h"
@@ -106,6 +107,8 @@ void PictureLayerImpl::PushPropertiesTo(LayerImpl* base_layer) {
   layer_impl->low_res_raster_contents_scale_ = low_res_raster_contents_scale_;
 
   layer_impl->UpdateLCDTextStatus(is_using_lcd_text_);
+  // The tilings that were swapped were made for this mode.
+  layer_impl->should_use_gpu_rasterization_ = should_use_gpu_rasterization_;
   layer_impl->needs_post_commit_initialization_ = false;
 
   // The invalidation on this soon-to-be-recycled layer must be cleared to
@@ -303,7 +306,8 @@ void PictureLayerImpl::AppendQuads(QuadSink* quad_sink,
   CleanUpTilingsOnActiveLayer(seen_tilings);
 }
 
-void PictureLayerImpl::UpdateTilePriorities() {
+void PictureLayerImpl::UpdateTilePriorities(
+    const OcclusionTrackerImpl* occlusion_tracker) {
   DCHECK(!needs_post_commit_initialization_);
   CHECK(should_update_tile_priorities_);
 
@@ -355,6 +359,14 @@ void PictureLayerImpl::UpdateTilePriorities() {
                                  contents_scale_x(),
                                  current_frame_time_in_seconds);
 
+  if (occlusion_tracker) {
+    tilings_->UpdateTileOcclusion(tree,
+                                  *occlusion_tracker,
+                                  render_target(),
+                                  draw_transform(),
+                                  contents_scale_x());
+  }
+
   if (layer_tree_impl()->IsPendingTree())
     MarkVisibleResourcesAsRequired();
 
@@ -573,6 +585,12 @@ void PictureLayerImpl::SyncFromActiveLayer(const PictureLayerImpl* other) {
 
   UpdateLCDTextStatus(other->is_using_lcd_text_);
 
+  // Once some of the content turned out to be much slower to rasterize on the
+  // GPU, don't switch back to it.
+  if (!other->should_use_gpu_rasterization() ||
+      !other->pile_->is_suitable_for_gpu_rasterization())
+    SetShouldUseGpuRasterization(false);
+
   if (!DrawsContent()) {
     RemoveAllTilings();
     return;
@@ -635,7 +653,7 @@ void PictureLayerImpl::SyncTiling(
   // we can create tiles for this tiling immediately.
   if (!layer_tree_impl()->needs_update_draw_properties() &&
       should_update_tile_priorities_)
-    UpdateTilePriorities();
+    UpdateTilePriorities(NULL);
 }
 
 void PictureLayerImpl::SetIsMask(bool is_mask) {
@@ -794,6 +812,11 @@ bool PictureLayerImpl::MarkVisibleTilesAsRequired(
     if (!missing_region.Intersects(iter.geometry_rect()))
       continue;
 
+    // An occluded tile is hidden by the layers in front, so it doesn't need
+    // to be ready either.
+    if (tile->is_occluded(PENDING_TREE))
+      continue;
+
     // If the twin tile doesn't exist (i.e. missing recording or so far away
     // that it is outside the visible tile rect) or this tile is shared between
     // with the twin, then this tile isn't required to prevent flashing.
@@ -311,7 +311,7 @@ TEST_F(PictureLayerImplTest, SuppressUpdateTilePriorities) {
                                         &dummy_content_bounds);
 
   EXPECT_TRUE(host_impl_.manage_tiles_needed());
-  active_layer_->UpdateTilePriorities();
+  active_layer_->UpdateTilePriorities(NULL);
   host_impl_.ManageTiles();
   EXPECT_FALSE(host_impl_.manage_tiles_needed());
 
@@ -324,7 +324,7 @@ TEST_F(PictureLayerImplTest, SuppressUpdateTilePriorities) {
                                         gfx::Rect(layer_bounds),
                                         gfx::Rect(layer_bounds),
                                         valid_for_tile_management);
-  active_layer_->UpdateTilePriorities();
+  active_layer_->UpdateTilePriorities(NULL);
   EXPECT_FALSE(host_impl_.manage_tiles_needed());
 
   time_ticks += base::TimeDelta::FromMilliseconds(200);
@@ -335,7 +335,7 @@ TEST_F(PictureLayerImplTest, SuppressUpdateTilePriorities) {
                                         gfx::Rect(layer_bounds),
                                         gfx::Rect(layer_bounds),
                                         valid_for_tile_management);
-  active_layer_->UpdateTilePriorities();
+  active_layer_->UpdateTilePriorities(NULL);
   EXPECT_TRUE(host_impl_.manage_tiles_needed());
 }
 
@@ -1445,6 +1445,45 @@ TEST_F(PictureLayerImplTest, TilingGpuRasterization) {
   ASSERT_EQ(1u, pending_layer_->tilings()->num_tilings());
 }
 
+class GpuRasterizationSettings : public ImplSidePaintingSettings {
+ public:
+  GpuRasterizationSettings() { gpu_rasterization = true; }
+};
+
+class GpuRasterizationPictureLayerImplTest : public PictureLayerImplTest {
+ public:
+  GpuRasterizationPictureLayerImplTest()
+      : PictureLayerImplTest(GpuRasterizationSettings()) {}
+};
+
+TEST_F(GpuRasterizationPictureLayerImplTest, FallBackToCpuRasterization) {
+  gfx::Size tile_size(100, 100);
+  gfx::Size layer_bounds(400, 400);
+  scoped_refptr<FakePicturePileImpl> pending_pile =
+      FakePicturePileImpl::CreateFilledPile(tile_size, layer_bounds);
+  scoped_refptr<FakePicturePileImpl> active_pile =
+      FakePicturePileImpl::CreateFilledPile(tile_size, layer_bounds);
+  SetupTrees(pending_pile, active_pile);
+  EXPECT_TRUE(pending_layer_->should_use_gpu_rasterization());
+
+  // Some content of the pending pile was found slow to rasterize on the GPU.
+  pending_pile->set_is_suitable_for_gpu_rasterization(false);
+  ActivateTree();
+  EXPECT_TRUE(active_layer_->should_use_gpu_rasterization());
+
+  // The next commit falls back to CPU rasterization.
+  SetupPendingTree(
+      FakePicturePileImpl::CreateFilledPile(tile_size, layer_bounds));
+  EXPECT_FALSE(pending_layer_->should_use_gpu_rasterization());
+  ActivateTree();
+  EXPECT_FALSE(active_layer_->should_use_gpu_rasterization());
+
+  // And the layer doesn't switch back.
+  SetupPendingTree(
+      FakePicturePileImpl::CreateFilledPile(tile_size, layer_bounds));
+  EXPECT_FALSE(pending_layer_->should_use_gpu_rasterization());
+}
+
 TEST_F(PictureLayerImplTest, NoTilingIfDoesNotDrawContent) {
   // Set up layers with tilings.
   SetupDefaultTrees(gfx::Size(10, 10));
@@ -250,16 +250,16 @@ void DirectRenderer::DrawFrame(RenderPassList* render_passes_in_draw_order,
 }
 
 gfx::RectF DirectRenderer::ComputeScissorRectForRenderPass(
-    const DrawingFrame* frame) {
-  gfx::RectF render_pass_scissor = frame->current_render_pass->output_rect;
+    const DrawingFrame* frame,
+    const RenderPass* render_pass) {
+  gfx::RectF render_pass_scissor = render_pass->output_rect;
 
   if (frame->root_damage_rect == frame->root_render_pass->output_rect ||
-      !frame->current_render_pass->copy_requests.empty())
+      !render_pass->copy_requests.empty())
     return render_pass_scissor;
 
   gfx::Transform inverse_transform(gfx::Transform::kSkipInitialization);
-  if (frame->current_render_pass->transform_to_root_target.GetInverse(
-          &inverse_transform)) {
+  if (render_pass->transform_to_root_target.GetInverse(&inverse_transform)) {
     // Only intersect inverse-projected damage if the transform is invertible.
     gfx::RectF damage_rect_in_render_pass_space =
         MathUtil::ProjectClippedRect(inverse_transform,
@@ -334,12 +334,22 @@ void DirectRenderer::DrawRenderPass(DrawingFrame* frame,
                                     const RenderPass* render_pass,
                                     bool allow_partial_swap) {
   TRACE_EVENT0("cc", "DirectRenderer::DrawRenderPass");
-  if (!UseRenderPass(frame, render_pass))
-    return;
-
   bool using_scissor_as_optimization =
       Capabilities().using_partial_swap && allow_partial_swap;
   gfx::RectF render_pass_scissor;
+  if (using_scissor_as_optimization) {
+    render_pass_scissor = ComputeScissorRectForRenderPass(frame, render_pass);
+    // The damage doesn't reach this render pass, so its texture keeps its
+    // contents from the last frame and nothing needs to be drawn into it, or
+    // even bound.
+    if (render_pass != frame->root_render_pass &&
+        render_pass_scissor.IsEmpty())
+      return;
+  }
+
+  if (!UseRenderPass(frame, render_pass))
+    return;
+
   bool draw_rect_covers_full_surface = true;
   if (frame->current_render_pass == frame->root_render_pass &&
       !frame->device_viewport_rect.Contains(
@@ -347,7 +357,6 @@ void DirectRenderer::DrawRenderPass(DrawingFrame* frame,
     draw_rect_covers_full_surface = false;
 
   if (using_scissor_as_optimization) {
-    render_pass_scissor = ComputeScissorRectForRenderPass(frame);
     SetScissorTestRectInDrawSpace(frame, render_pass_scissor);
     if (!render_pass_scissor.Contains(frame->current_render_pass->output_rect))
       draw_rect_covers_full_surface = false;
@@ -80,7 +80,9 @@ class CC_EXPORT DirectRenderer : public Renderer {
 
   bool NeedDeviceClip(const DrawingFrame* frame) const;
   gfx::Rect DeviceClipRectInWindowSpace(const DrawingFrame* frame) const;
-  static gfx::RectF ComputeScissorRectForRenderPass(const DrawingFrame* frame);
+  static gfx::RectF ComputeScissorRectForRenderPass(
+      const DrawingFrame* frame,
+      const RenderPass* render_pass);
   void SetScissorStateForQuad(const DrawingFrame* frame, const DrawQuad& quad);
   void SetScissorStateForQuadWithRenderPassScissor(
       const DrawingFrame* frame,
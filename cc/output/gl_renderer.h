@@ -162,6 +162,10 @@ class CC_EXPORT GLRenderer : public DirectRenderer {
   void EnqueueTextureQuad(const DrawingFrame* frame,
                           const TextureDrawQuad* quad);
   void FlushTextureQuadCache();
+  void EnqueueSolidColorQuad(const DrawingFrame* frame,
+                             const SolidColorDrawQuad* quad,
+                             float alpha);
+  void FlushSolidColorQuadCache();
   void DrawIOSurfaceQuad(const DrawingFrame* frame,
                          const IOSurfaceDrawQuad* quad);
   void DrawTileQuad(const DrawingFrame* frame, const TileDrawQuad* quad);
@@ -294,10 +298,10 @@ class CC_EXPORT GLRenderer : public DirectRenderer {
   // Special purpose / effects shaders.
   typedef ProgramBinding<VertexShaderPos, FragmentShaderColor>
       DebugBorderProgram;
-  typedef ProgramBinding<VertexShaderQuad, FragmentShaderColor>
-      SolidColorProgram;
   typedef ProgramBinding<VertexShaderQuadAA, FragmentShaderColorAA>
       SolidColorProgramAA;
+  typedef ProgramBinding<VertexShaderPosColorTransform,
+                         FragmentShaderVaryingColor> BatchedSolidColorProgram;
 
   const TileProgram* GetTileProgram(
       TexCoordPrecision precision, SamplerType sampler);
@@ -350,8 +354,8 @@ class CC_EXPORT GLRenderer : public DirectRenderer {
       TexCoordPrecision precision);
 
   const DebugBorderProgram* GetDebugBorderProgram();
-  const SolidColorProgram* GetSolidColorProgram();
   const SolidColorProgramAA* GetSolidColorProgramAA();
+  const BatchedSolidColorProgram* GetBatchedSolidColorProgram();
 
   TileProgram tile_program_[NumTexCoordPrecisions][NumSamplerTypes];
   TileProgramOpaque
@@ -393,8 +397,8 @@ class CC_EXPORT GLRenderer : public DirectRenderer {
       video_stream_texture_program_[NumTexCoordPrecisions];
 
   DebugBorderProgram debug_border_program_;
-  SolidColorProgram solid_color_program_;
   SolidColorProgramAA solid_color_program_aa_;
+  BatchedSolidColorProgram batched_solid_color_program_;
 
   gpu::gles2::GLES2Interface* gl_;
   gpu::ContextSupport* context_support_;
@@ -416,6 +420,7 @@ class CC_EXPORT GLRenderer : public DirectRenderer {
   bool blend_shadow_;
   unsigned program_shadow_;
   TexturedQuadDrawCache draw_cache_;
+  SolidColorQuadDrawCache solid_color_draw_cache_;
   int highp_threshold_min_;
   int highp_threshold_cache_;
 
@@ -63,8 +63,8 @@ class GLRendererShaderPixelTest : public GLRendererPixelTest {
     ASSERT_FALSE(renderer()->IsContextLost());
     EXPECT_PROGRAM_VALID(renderer()->GetTileCheckerboardProgram());
     EXPECT_PROGRAM_VALID(renderer()->GetDebugBorderProgram());
-    EXPECT_PROGRAM_VALID(renderer()->GetSolidColorProgram());
     EXPECT_PROGRAM_VALID(renderer()->GetSolidColorProgramAA());
+    EXPECT_PROGRAM_VALID(renderer()->GetBatchedSolidColorProgram());
     TestShadersWithTexCoordPrecision(TexCoordPrecisionMedium);
     TestShadersWithTexCoordPrecision(TexCoordPrecisionHigh);
     ASSERT_FALSE(renderer()->IsContextLost());
@@ -1245,6 +1245,96 @@ TEST_F(GLRendererTest, NoDiscardOnPartialUpdates) {
   }
 }
 
+class OffscreenBindCountingContext : public TestWebGraphicsContext3D {
+ public:
+  OffscreenBindCountingContext() : offscreen_binds_(0) {
+    set_have_post_sub_buffer(true);
+  }
+
+  virtual void bindFramebuffer(GLenum target, GLuint framebuffer) OVERRIDE {
+    if (framebuffer)
+      ++offscreen_binds_;
+    TestWebGraphicsContext3D::bindFramebuffer(target, framebuffer);
+  }
+
+  int offscreen_binds() const { return offscreen_binds_; }
+  void reset() { offscreen_binds_ = 0; }
+
+ private:
+  int offscreen_binds_;
+};
+
+TEST_F(GLRendererTest, NoDrawIntoRenderPassOutsideDamage) {
+  scoped_ptr<OffscreenBindCountingContext> context_owned(
+      new OffscreenBindCountingContext);
+  OffscreenBindCountingContext* context = context_owned.get();
+
+  FakeOutputSurfaceClient output_surface_client;
+  scoped_ptr<OutputSurface> output_surface(FakeOutputSurface::Create3d(
+      context_owned.PassAs<TestWebGraphicsContext3D>()));
+  CHECK(output_surface->BindToClient(&output_surface_client));
+
+  scoped_ptr<ResourceProvider> resource_provider(
+      ResourceProvider::Create(output_surface.get(), NULL, 0, false, 1));
+
+  LayerTreeSettings settings;
+  settings.partial_swap_enabled = true;
+  FakeRendererClient renderer_client;
+  FakeRendererGL renderer(&renderer_client,
+                          &settings,
+                          output_surface.get(),
+                          resource_provider.get());
+  EXPECT_TRUE(renderer.Capabilities().using_partial_swap);
+  context->reset();
+
+  gfx::Rect viewport_rect(100, 100);
+  gfx::Rect child_rect(20, 20);
+  gfx::Transform transform_to_root;
+  transform_to_root.Translate(50.0, 50.0);
+
+  for (int i = 0; i < 3; ++i) {
+    RenderPass::Id child_pass_id(2, 0);
+    TestRenderPass* child_pass = AddRenderPass(&render_passes_in_draw_order_,
+                                               child_pass_id,
+                                               child_rect,
+                                               transform_to_root);
+    AddQuad(child_pass, child_rect, SK_ColorBLUE);
+
+    RenderPass::Id root_pass_id(1, 0);
+    TestRenderPass* root_pass = AddRenderPass(&render_passes_in_draw_order_,
+                                              root_pass_id,
+                                              viewport_rect,
+                                              gfx::Transform());
+    AddQuad(root_pass, viewport_rect, SK_ColorGREEN);
+    AddRenderPassQuad(root_pass, child_pass);
+
+    int expected_offscreen_binds = 0;
+    if (i == 0) {
+      // The first frame is fully damaged.
+      root_pass->damage_rect = gfx::RectF(viewport_rect);
+      expected_offscreen_binds = 1;
+    } else if (i == 1) {
+      // The damage doesn't reach the child pass, so it isn't drawn.
+      root_pass->damage_rect = gfx::RectF(2.f, 2.f, 3.f, 3.f);
+    } else {
+      // The damage overlaps the child pass.
+      root_pass->damage_rect = gfx::RectF(45.f, 45.f, 10.f, 10.f);
+      expected_offscreen_binds = 1;
+    }
+
+    renderer.DecideRenderPassAllocationsForFrame(render_passes_in_draw_order_);
+    renderer.DrawFrame(&render_passes_in_draw_order_,
+                       NULL,
+                       1.f,
+                       viewport_rect,
+                       viewport_rect,
+                       true,
+                       false);
+    EXPECT_EQ(expected_offscreen_binds, context->offscreen_binds()) << i;
+    context->reset();
+  }
+}
+
 class FlippedScissorAndViewportContext : public TestWebGraphicsContext3D {
  public:
   FlippedScissorAndViewportContext()
@@ -1647,6 +1737,58 @@ TEST_F(GLRendererShaderTest, DrawSolidColorShader) {
   TestSolidColorProgramAA();
 }
 
+class DrawElementsMockContext : public TestWebGraphicsContext3D {
+ public:
+  MOCK_METHOD4(drawElements,
+               void(GLenum mode, GLsizei count, GLenum type, GLintptr offset));
+};
+
+TEST_F(GLRendererTest, BatchesSolidColorQuads) {
+  scoped_ptr<DrawElementsMockContext> context_owned(
+      new DrawElementsMockContext);
+  DrawElementsMockContext* context = context_owned.get();
+
+  FakeOutputSurfaceClient output_surface_client;
+  scoped_ptr<OutputSurface> output_surface(FakeOutputSurface::Create3d(
+      context_owned.PassAs<TestWebGraphicsContext3D>()));
+  CHECK(output_surface->BindToClient(&output_surface_client));
+
+  scoped_ptr<ResourceProvider> resource_provider(
+      ResourceProvider::Create(output_surface.get(), NULL, 0, false, 1));
+
+  LayerTreeSettings settings;
+  FakeRendererClient renderer_client;
+  FakeRendererGL renderer(&renderer_client,
+                          &settings,
+                          output_surface.get(),
+                          resource_provider.get());
+
+  gfx::Rect viewport_rect(100, 100);
+  TestRenderPass* root_pass = AddRenderPass(&render_passes_in_draw_order_,
+                                            RenderPass::Id(1, 0),
+                                            viewport_rect,
+                                            gfx::Transform());
+  // Ten quads are drawn in batches of at most eight.
+  for (int i = 0; i < 10; ++i)
+    AddQuad(root_pass, gfx::Rect(i * 10, 0, 10, 10), SK_ColorRED);
+
+  {
+    InSequence sequence;
+    EXPECT_CALL(*context, drawElements(GL_TRIANGLES, 6 * 8, _, _));
+    EXPECT_CALL(*context, drawElements(GL_TRIANGLES, 6 * 2, _, _));
+  }
+
+  renderer.DecideRenderPassAllocationsForFrame(render_passes_in_draw_order_);
+  renderer.DrawFrame(&render_passes_in_draw_order_,
+                     NULL,
+                     1.f,
+                     viewport_rect,
+                     viewport_rect,
+                     true,
+                     false);
+  Mock::VerifyAndClearExpectations(context);
+}
+
 class OutputSurfaceMockContext : public TestWebGraphicsContext3D {
  public:
   OutputSurfaceMockContext() { test_capabilities_.gpu.post_sub_buffer = true; }
@@ -137,6 +137,25 @@ class VertexShaderPosTexTransform {
   DISALLOW_COPY_AND_ASSIGN(VertexShaderPosTexTransform);
 };
 
+class VertexShaderPosColorTransform {
+ public:
+  VertexShaderPosColorTransform();
+
+  void Init(gpu::gles2::GLES2Interface* context,
+            unsigned program,
+            int* base_uniform_index);
+  std::string GetShaderString() const;
+
+  int matrix_location() const { return matrix_location_; }
+  int color_location() const { return color_location_; }
+
+ private:
+  int matrix_location_;
+  int color_location_;
+
+  DISALLOW_COPY_AND_ASSIGN(VertexShaderPosColorTransform);
+};
+
 class VertexShaderQuad {
  public:
   VertexShaderQuad();
@@ -688,6 +707,16 @@ class FragmentShaderColor {
   DISALLOW_COPY_AND_ASSIGN(FragmentShaderColor);
 };
 
+class FragmentShaderVaryingColor {
+ public:
+  std::string GetShaderString(
+      TexCoordPrecision precision, SamplerType sampler) const;
+
+  void Init(gpu::gles2::GLES2Interface* context,
+            unsigned program,
+            int* base_uniform_index) {}
+};
+
 class FragmentShaderColorAA {
  public:
   FragmentShaderColorAA();
@@ -16,6 +16,7 @@
 #include "cc/debug/traced_picture.h"
 #include "cc/debug/traced_value.h"
 #include "cc/layers/content_layer_client.h"
+#include "skia/ext/analysis_canvas.h"
 #include "skia/ext/pixel_ref_utils.h"
 #include "third_party/skia/include/core/SkCanvas.h"
 #include "third_party/skia/include/core/SkData.h"
@@ -92,6 +93,7 @@ scoped_refptr<Picture> Picture::Create(
   picture->Record(client, tile_grid_info);
   if (gather_pixel_refs)
     picture->GatherPixelRefs(tile_grid_info);
+  picture->AnalyzeSolidColor();
   picture->CloneForDrawing(num_raster_threads);
 
   return picture;
@@ -99,7 +101,9 @@ scoped_refptr<Picture> Picture::Create(
 
 Picture::Picture(const gfx::Rect& layer_rect)
   : layer_rect_(layer_rect),
-    cell_size_(layer_rect.size()) {
+    cell_size_(layer_rect.size()),
+    is_solid_color_(false),
+    solid_color_(SK_ColorTRANSPARENT) {
   // Instead of recording a trace event for object creation here, we wait for
   // the picture to be recorded in Picture::Record.
 }
@@ -169,7 +173,9 @@ Picture::Picture(SkPicture* picture,
     layer_rect_(layer_rect),
     opaque_rect_(opaque_rect),
     picture_(skia::AdoptRef(picture)),
-    cell_size_(layer_rect.size()) {
+    cell_size_(layer_rect.size()),
+    is_solid_color_(false),
+    solid_color_(SK_ColorTRANSPARENT) {
 }
 
 Picture::Picture(const skia::RefPtr<SkPicture>& picture,
@@ -180,7 +186,9 @@ Picture::Picture(const skia::RefPtr<SkPicture>& picture,
     opaque_rect_(opaque_rect),
     picture_(picture),
     pixel_refs_(pixel_refs),
-    cell_size_(layer_rect.size()) {
+    cell_size_(layer_rect.size()),
+    is_solid_color_(false),
+    solid_color_(SK_ColorTRANSPARENT) {
 }
 
 Picture::~Picture() {
@@ -214,6 +222,8 @@ void Picture::CloneForDrawing(int num_threads) {
                       layer_rect_,
                       opaque_rect_,
                       pixel_refs_));
+      clone->is_solid_color_ = is_solid_color_;
+      clone->solid_color_ = solid_color_;
       clones_.push_back(clone);
 
       clone->EmitTraceSnapshotAlias(this);
@@ -260,6 +270,22 @@ void Picture::Record(ContentLayerClient* painter,
   EmitTraceSnapshot();
 }
 
+void Picture::AnalyzeSolidColor() {
+  TRACE_EVENT2("cc", "Picture::AnalyzeSolidColor",
+               "width", layer_rect_.width(),
+               "height", layer_rect_.height());
+
+  DCHECK(picture_);
+  SkBitmap empty_bitmap;
+  empty_bitmap.setConfig(SkBitmap::kNo_Config,
+                         layer_rect_.width(),
+                         layer_rect_.height());
+  skia::AnalysisDevice device(empty_bitmap);
+  skia::AnalysisCanvas canvas(&device);
+  picture_->draw(&canvas, &canvas);
+  is_solid_color_ = canvas.GetColorIfSolid(&solid_color_);
+}
+
 void Picture::GatherPixelRefs(
     const SkTileGridPicture::TileGridInfo& tile_grid_info) {
   TRACE_EVENT2("cc", "Picture::GatherPixelRefs",
@@ -335,16 +361,22 @@ int Picture::Raster(
   for (Region::Iterator it(negated_content_region); it.has_rect(); it.next())
     canvas->clipRect(gfx::RectToSkRect(it.rect()), SkRegion::kDifference_Op);
 
-  canvas->scale(contents_scale, contents_scale);
-  canvas->translate(layer_rect_.x(), layer_rect_.y());
-  picture_->draw(canvas, callback);
-  SkIRect bounds;
-  canvas->getClipDeviceBounds(&bounds);
+  // The pile chunks around a tile often end up entirely clipped out, and
+  // there is nothing to play back for them then.
+  int rasterized_pixel_count = 0;
+  if (!canvas->isClipEmpty()) {
+    canvas->scale(contents_scale, contents_scale);
+    canvas->translate(layer_rect_.x(), layer_rect_.y());
+    picture_->draw(canvas, callback);
+    SkIRect bounds;
+    canvas->getClipDeviceBounds(&bounds);
+    rasterized_pixel_count = bounds.width() * bounds.height();
+  }
   canvas->restore();
   TRACE_EVENT_END1(
       "cc", "Picture::Raster",
-      "num_pixels_rasterized", bounds.width() * bounds.height());
-  return bounds.width() * bounds.height();
+      "num_pixels_rasterized", rasterized_pixel_count);
+  return rasterized_pixel_count;
 }
 
 void Picture::Replay(SkCanvas* canvas) {
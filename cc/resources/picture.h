@@ -20,6 +20,7 @@
 #include "cc/base/cc_export.h"
 #include "cc/base/region.h"
 #include "skia/ext/refptr.h"
+#include "third_party/skia/include/core/SkColor.h"
 #include "third_party/skia/include/core/SkTileGridPicture.h"
 #include "ui/gfx/rect.h"
 
@@ -113,6 +114,16 @@ class CC_EXPORT Picture
 
   bool WillPlayBackBitmaps() const { return picture_->willPlayBackBitmaps(); }
 
+  // Returns true and sets |color| if the whole layer rect of the picture was
+  // found to be drawn with a single color, possibly transparent, when it was
+  // recorded.
+  bool GetColorIfSolid(SkColor* color) const {
+    if (!is_solid_color_)
+      return false;
+    *color = solid_color_;
+    return true;
+  }
+
  private:
   explicit Picture(const gfx::Rect& layer_rect);
   // This constructor assumes SkPicture is already ref'd and transfers
@@ -138,6 +149,10 @@ class CC_EXPORT Picture
   // Gather pixel refs from recording.
   void GatherPixelRefs(const SkTileGridPicture::TileGridInfo& tile_grid_info);
 
+  // Replay the recording once into an analysis canvas, so that tiles of
+  // solid color pictures don't need to replay it again before raster.
+  void AnalyzeSolidColor();
+
   gfx::Rect layer_rect_;
   gfx::Rect opaque_rect_;
   skia::RefPtr<SkPicture> picture_;
@@ -150,6 +165,9 @@ class CC_EXPORT Picture
   gfx::Point max_pixel_cell_;
   gfx::Size cell_size_;
 
+  bool is_solid_color_;
+  SkColor solid_color_;
+
   scoped_refptr<base::debug::ConvertableToTraceFormat>
     AsTraceableRasterData(float scale) const;
   scoped_refptr<base::debug::ConvertableToTraceFormat>
@@ -10,6 +10,7 @@
 
 #include "base/debug/trace_event.h"
 #include "cc/base/math_util.h"
+#include "cc/trees/occlusion_tracker.h"
 #include "ui/gfx/point_conversions.h"
 #include "ui/gfx/rect_conversions.h"
 #include "ui/gfx/safe_integer_conversions.h"
@@ -489,6 +490,38 @@ void PictureLayerTiling::UpdateTilePriorities(
   }
 }
 
+void PictureLayerTiling::UpdateTileOcclusion(
+    WhichTree tree,
+    const OcclusionTrackerBase<LayerImpl, RenderSurfaceImpl>&
+        occlusion_tracker,
+    const LayerImpl* render_target,
+    const gfx::Transform& draw_transform,
+    float layer_contents_scale) {
+  float tiling_to_layer_content_scale = layer_contents_scale / contents_scale_;
+  for (TilingData::Iterator iter(&tiling_data_,
+                                 last_visible_rect_in_content_space_);
+       iter;
+       ++iter) {
+    TileMap::iterator find = tiles_.find(iter.index());
+    if (find == tiles_.end())
+      continue;
+    Tile* tile = find->second.get();
+
+    gfx::Rect visible_tile_rect =
+        gfx::IntersectRects(tile->content_rect(),
+                            last_visible_rect_in_content_space_);
+    gfx::Rect visible_tile_rect_in_layer_content_space =
+        gfx::ScaleToEnclosingRect(visible_tile_rect,
+                                  tiling_to_layer_content_scale);
+    tile->SetIsOccluded(
+        tree,
+        occlusion_tracker.Occluded(render_target,
+                                   visible_tile_rect_in_layer_content_space,
+                                   draw_transform,
+                                   false));
+  }
+}
+
 void PictureLayerTiling::SetLiveTilesRect(
     const gfx::Rect& new_live_tiles_rect) {
   DCHECK(new_live_tiles_rect.IsEmpty() ||
@@ -532,6 +565,7 @@ void PictureLayerTiling::DidBecomeRecycled() {
   // due to a pending invalidation).
   for (TileMap::const_iterator it = tiles_.begin(); it != tiles_.end(); ++it) {
     it->second->SetPriority(ACTIVE_TREE, TilePriority());
+    it->second->SetIsOccluded(ACTIVE_TREE, false);
   }
 }
 
@@ -539,6 +573,9 @@ void PictureLayerTiling::DidBecomeActive() {
   for (TileMap::const_iterator it = tiles_.begin(); it != tiles_.end(); ++it) {
     it->second->SetPriority(ACTIVE_TREE, it->second->priority(PENDING_TREE));
     it->second->SetPriority(PENDING_TREE, TilePriority());
+    it->second->SetIsOccluded(ACTIVE_TREE,
+                              it->second->is_occluded(PENDING_TREE));
+    it->second->SetIsOccluded(PENDING_TREE, false);
 
     // Tile holds a ref onto a picture pile. If the tile never gets invalidated
     // and recreated, then that picture pile ref could exist indefinitely.  To
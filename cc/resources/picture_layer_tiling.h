@@ -18,9 +18,16 @@
 #include "cc/resources/tile_priority.h"
 #include "ui/gfx/rect.h"
 
+namespace gfx {
+class Transform;
+}
+
 namespace cc {
 
+class LayerImpl;
 class PictureLayerTiling;
+class RenderSurfaceImpl;
+template <typename LayerType, typename SurfaceType> class OcclusionTrackerBase;
 
 class CC_EXPORT PictureLayerTilingClient {
  public:
@@ -141,6 +148,18 @@ class CC_EXPORT PictureLayerTiling {
                             float layer_contents_scale,
                             double current_frame_time_in_seconds);
 
+  // Marks the visible tiles from the last UpdateTilePriorities() whose visible
+  // part |occlusion_tracker| finds hidden as occluded on |tree|, and the other
+  // ones as not occluded. |draw_transform| maps the content space of the layer,
+  // at |layer_contents_scale|, to its |render_target|.
+  void UpdateTileOcclusion(
+      WhichTree tree,
+      const OcclusionTrackerBase<LayerImpl, RenderSurfaceImpl>&
+          occlusion_tracker,
+      const LayerImpl* render_target,
+      const gfx::Transform& draw_transform,
+      float layer_contents_scale);
+
   // Copies the src_tree priority into the dst_tree priority for all tiles.
   // The src_tree priority is reset to the lowest priority possible.  This
   // also updates the pile on each tile to be the current client's pile.
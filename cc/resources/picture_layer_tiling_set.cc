@@ -317,6 +317,22 @@ void PictureLayerTilingSet::UpdateTilePriorities(
   }
 }
 
+void PictureLayerTilingSet::UpdateTileOcclusion(
+    WhichTree tree,
+    const OcclusionTrackerBase<LayerImpl, RenderSurfaceImpl>&
+        occlusion_tracker,
+    const LayerImpl* render_target,
+    const gfx::Transform& draw_transform,
+    float layer_contents_scale) {
+  for (size_t i = 0; i < tilings_.size(); ++i) {
+    tilings_[i]->UpdateTileOcclusion(tree,
+                                     occlusion_tracker,
+                                     render_target,
+                                     draw_transform,
+                                     layer_contents_scale);
+  }
+}
+
 void PictureLayerTilingSet::DidBecomeActive() {
   for (size_t i = 0; i < tilings_.size(); ++i)
     tilings_[i]->DidBecomeActive();
@@ -59,6 +59,14 @@ class CC_EXPORT PictureLayerTilingSet {
                             float layer_contents_scale,
                             double current_frame_time_in_seconds);
 
+  void UpdateTileOcclusion(
+      WhichTree tree,
+      const OcclusionTrackerBase<LayerImpl, RenderSurfaceImpl>&
+          occlusion_tracker,
+      const LayerImpl* render_target,
+      const gfx::Transform& draw_transform,
+      float layer_contents_scale);
+
   void DidBecomeActive();
   void DidBecomeRecycled();
 
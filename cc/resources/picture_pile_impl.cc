@@ -46,11 +46,13 @@ scoped_refptr<PicturePileImpl> PicturePileImpl::CreateCloneForDrawing(
 }
 
 PicturePileImpl::PicturePileImpl()
-    : clones_for_drawing_(ClonesForDrawing(this, 0)) {
+    : is_suitable_for_gpu_rasterization_(true),
+      clones_for_drawing_(ClonesForDrawing(this, 0)) {
 }
 
 PicturePileImpl::PicturePileImpl(const PicturePileBase* other)
     : PicturePileBase(other),
+      is_suitable_for_gpu_rasterization_(true),
       clones_for_drawing_(ClonesForDrawing(
                               this, RasterWorkerPool::GetNumRasterThreads())) {
 }
@@ -58,6 +60,7 @@ PicturePileImpl::PicturePileImpl(const PicturePileBase* other)
 PicturePileImpl::PicturePileImpl(
     const PicturePileImpl* other, unsigned thread_index)
     : PicturePileBase(other, thread_index),
+      is_suitable_for_gpu_rasterization_(true),
       clones_for_drawing_(ClonesForDrawing(this, 0)) {
 }
 
@@ -330,6 +333,15 @@ void PicturePileImpl::AnalyzeInRect(
 
   layer_rect.Intersect(gfx::Rect(tiling_.total_size()));
 
+  // Most solid color tiles are in solid color pictures, which don't need to
+  // be replayed again.
+  if (GetRecordedColorIfSolid(layer_rect, &analysis->solid_color)) {
+    analysis->is_solid_color = true;
+    analysis->has_text = false;
+    analysis->is_suitable_for_gpu_rasterization = true;
+    return;
+  }
+
   SkBitmap empty_bitmap;
   empty_bitmap.setConfig(SkBitmap::kNo_Config,
                          layer_rect.width(),
@@ -341,11 +353,37 @@ void PicturePileImpl::AnalyzeInRect(
 
   analysis->is_solid_color = canvas.GetColorIfSolid(&analysis->solid_color);
   analysis->has_text = canvas.HasText();
+  analysis->is_suitable_for_gpu_rasterization =
+      canvas.IsSuitableForGpuRasterization();
+}
+
+bool PicturePileImpl::GetRecordedColorIfSolid(const gfx::Rect& layer_rect,
+                                              SkColor* color) const {
+  bool found_picture = false;
+  for (TilingData::Iterator tile_iter(&tiling_, layer_rect);
+       tile_iter; ++tile_iter) {
+    PictureMap::const_iterator map_iter = picture_map_.find(tile_iter.index());
+    if (map_iter == picture_map_.end())
+      return false;
+    const Picture* picture = map_iter->second.GetPicture();
+    if (!picture)
+      return false;
+
+    SkColor picture_color;
+    if (!picture->GetColorIfSolid(&picture_color))
+      return false;
+    if (found_picture && picture_color != *color)
+      return false;
+    *color = picture_color;
+    found_picture = true;
+  }
+  return found_picture;
 }
 
 PicturePileImpl::Analysis::Analysis()
     : is_solid_color(false),
-      has_text(false) {
+      has_text(false),
+      is_suitable_for_gpu_rasterization(true) {
 }
 
 PicturePileImpl::Analysis::~Analysis() {
@@ -68,6 +68,7 @@ class CC_EXPORT PicturePileImpl : public PicturePileBase {
 
     bool is_solid_color;
     bool has_text;
+    bool is_suitable_for_gpu_rasterization;
     SkColor solid_color;
   };
 
@@ -104,6 +105,15 @@ class CC_EXPORT PicturePileImpl : public PicturePileBase {
 
   void DidBeginTracing();
 
+  // Cleared once a tile rasterized on the GPU from this pile turned out to
+  // have content that is much slower to rasterize there than on the CPU.
+  bool is_suitable_for_gpu_rasterization() const {
+    return is_suitable_for_gpu_rasterization_;
+  }
+  void set_is_suitable_for_gpu_rasterization(bool is_suitable) {
+    is_suitable_for_gpu_rasterization_ = is_suitable;
+  }
+
  protected:
   friend class PicturePile;
   friend class PixelRefIterator;
@@ -129,6 +139,12 @@ class CC_EXPORT PicturePileImpl : public PicturePileBase {
 
  private:
   typedef std::map<Picture*, Region> PictureRegionMap;
+
+  // Returns true and sets |color| if all the pictures covering |layer_rect|
+  // were found to be of the same solid color when they were recorded.
+  bool GetRecordedColorIfSolid(const gfx::Rect& layer_rect,
+                               SkColor* color) const;
+
   void CoalesceRasters(const gfx::Rect& canvas_rect,
                        const gfx::Rect& content_rect,
                        float contents_scale,
@@ -142,6 +158,8 @@ class CC_EXPORT PicturePileImpl : public PicturePileBase {
       RenderingStatsInstrumentation* rendering_stats_instrumentation,
       bool is_analysis);
 
+  bool is_suitable_for_gpu_rasterization_;
+
   // Once instantiated, |clones_for_drawing_| can't be modified.  This
   // guarantees thread-safe access during the life time of a PicturePileImpl
   // instance.  This member variable must be last so that other member
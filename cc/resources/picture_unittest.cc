@@ -7,6 +7,7 @@
 #include "base/memory/ref_counted.h"
 #include "base/memory/scoped_ptr.h"
 #include "base/values.h"
+#include "cc/base/region.h"
 #include "cc/test/fake_content_layer_client.h"
 #include "cc/test/skia_common.h"
 #include "testing/gtest/include/gtest/gtest.h"
@@ -98,6 +99,43 @@ TEST(PictureTest, AsBase64String) {
       memcmp(two_rect_buffer, two_rect_buffer_check, 4 * 100 * 100) == 0);
 }
 
+TEST(PictureTest, AnalyzesSolidColorWhenRecorded) {
+  gfx::Rect layer_rect(100, 100);
+
+  SkTileGridPicture::TileGridInfo tile_grid_info;
+  tile_grid_info.fTileInterval = SkISize::Make(100, 100);
+  tile_grid_info.fMargin.setEmpty();
+  tile_grid_info.fOffset.setZero();
+
+  FakeContentLayerClient content_layer_client;
+  SkColor color;
+
+  // Nothing drawn is transparent.
+  scoped_refptr<Picture> empty_picture = Picture::Create(
+      layer_rect, &content_layer_client, tile_grid_info, false, 0);
+  EXPECT_TRUE(empty_picture->GetColorIfSolid(&color));
+  EXPECT_EQ(SK_ColorTRANSPARENT, color);
+
+  SkPaint red_paint;
+  red_paint.setColor(SK_ColorRED);
+  content_layer_client.add_draw_rect(layer_rect, red_paint);
+  scoped_refptr<Picture> red_picture = Picture::Create(
+      layer_rect, &content_layer_client, tile_grid_info, false, 2);
+  EXPECT_TRUE(red_picture->GetColorIfSolid(&color));
+  EXPECT_EQ(SK_ColorRED, color);
+  // The clones for the raster threads share the analysis.
+  EXPECT_TRUE(red_picture->GetCloneForDrawingOnThread(0)->GetColorIfSolid(
+      &color));
+  EXPECT_EQ(SK_ColorRED, color);
+
+  SkPaint green_paint;
+  green_paint.setColor(SK_ColorGREEN);
+  content_layer_client.add_draw_rect(gfx::Rect(10, 10, 1, 1), green_paint);
+  scoped_refptr<Picture> two_color_picture = Picture::Create(
+      layer_rect, &content_layer_client, tile_grid_info, false, 0);
+  EXPECT_FALSE(two_color_picture->GetColorIfSolid(&color));
+}
+
 TEST(PictureTest, PixelRefIterator) {
   gfx::Rect layer_rect(2048, 2048);
 
@@ -416,5 +454,41 @@ TEST(PictureTest, CreateFromSkpValue) {
   EXPECT_EQ(100, one_rect_picture_check->OpaqueRect().width());
   EXPECT_EQ(200, one_rect_picture_check->OpaqueRect().height());
 }
+
+TEST(PictureTest, RasterClippedOut) {
+  SkGraphics::Init();
+
+  gfx::Rect layer_rect(100, 100);
+
+  SkTileGridPicture::TileGridInfo tile_grid_info;
+  tile_grid_info.fTileInterval = SkISize::Make(100, 100);
+  tile_grid_info.fMargin.setEmpty();
+  tile_grid_info.fOffset.setZero();
+
+  FakeContentLayerClient content_layer_client;
+  SkPaint red_paint;
+  red_paint.setColor(SkColorSetARGB(255, 255, 0, 0));
+  content_layer_client.add_draw_rect(layer_rect, red_paint);
+  scoped_refptr<Picture> picture = Picture::Create(
+      layer_rect, &content_layer_client, tile_grid_info, false, 0);
+
+  SkBitmap bitmap;
+  bitmap.setConfig(SkBitmap::kARGB_8888_Config, 100, 100);
+  bitmap.allocPixels();
+  SkCanvas canvas(bitmap);
+  canvas.clear(SK_ColorTRANSPARENT);
+
+  // Only the top half of the canvas is clipped out.
+  EXPECT_EQ(100 * 50,
+            picture->Raster(&canvas, NULL, Region(gfx::Rect(100, 50)), 1.f));
+  EXPECT_EQ(SK_ColorTRANSPARENT, bitmap.getColor(50, 25));
+  EXPECT_EQ(SK_ColorRED, bitmap.getColor(50, 75));
+
+  // All of it is.
+  canvas.clear(SK_ColorTRANSPARENT);
+  EXPECT_EQ(0, picture->Raster(&canvas, NULL, Region(layer_rect), 1.f));
+  EXPECT_EQ(SK_ColorTRANSPARENT, bitmap.getColor(50, 75));
+}
+
 }  // namespace
 }  // namespace cc
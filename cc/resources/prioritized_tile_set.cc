@@ -34,7 +34,11 @@ class BinComparator {
     gfx::Rect b_rect = b->content_rect();
     if (a_rect.y() != b_rect.y())
       return a_rect.y() < b_rect.y();
-    return a_rect.x() < b_rect.x();
+    if (a_rect.x() != b_rect.x())
+      return a_rect.x() < b_rect.x();
+    // Break the ties, so that the order doesn't depend on how far bins were
+    // sorted when tiles were inserted.
+    return a->id() < b->id();
   }
 };
 
@@ -42,21 +46,24 @@ namespace {
 
 typedef std::vector<Tile*> TileVector;
 
-void SortBinTiles(ManagedTileBin bin, TileVector* tiles) {
+// The number of tiles that are sorted at once at least.
+const size_t kMinSortedTiles = 16;
+
+bool BinNeedsSorting(ManagedTileBin bin) {
   switch (bin) {
     case NOW_AND_READY_TO_DRAW_BIN:
     case NEVER_BIN:
-      break;
+      return false;
     case NOW_BIN:
     case SOON_BIN:
     case EVENTUALLY_AND_ACTIVE_BIN:
     case EVENTUALLY_BIN:
     case AT_LAST_AND_ACTIVE_BIN:
     case AT_LAST_BIN:
-      std::sort(tiles->begin(), tiles->end(), BinComparator());
-      break;
+      return true;
     default:
       NOTREACHED();
+      return false;
   }
 }
 
@@ -64,39 +71,58 @@ void SortBinTiles(ManagedTileBin bin, TileVector* tiles) {
 
 PrioritizedTileSet::PrioritizedTileSet() {
   for (int bin = 0; bin < NUM_BINS; ++bin)
-    bin_sorted_[bin] = true;
+    sorted_count_[bin] = 0;
 }
 
 PrioritizedTileSet::~PrioritizedTileSet() {}
 
 void PrioritizedTileSet::InsertTile(Tile* tile, ManagedTileBin bin) {
   tiles_[bin].push_back(tile);
-  bin_sorted_[bin] = false;
+  sorted_count_[bin] = 0;
 }
 
 void PrioritizedTileSet::Clear() {
   for (int bin = 0; bin < NUM_BINS; ++bin) {
     tiles_[bin].clear();
-    bin_sorted_[bin] = true;
+    sorted_count_[bin] = 0;
   }
 }
 
-void PrioritizedTileSet::SortBinIfNeeded(ManagedTileBin bin) {
-  if (!bin_sorted_[bin]) {
-    SortBinTiles(bin, &tiles_[bin]);
-    bin_sorted_[bin] = true;
+void PrioritizedTileSet::SortBinUpTo(ManagedTileBin bin, size_t index) {
+  TileVector& tiles = tiles_[bin];
+  size_t& sorted_count = sorted_count_[bin];
+  if (index < sorted_count || index >= tiles.size())
+    return;
+
+  if (!BinNeedsSorting(bin)) {
+    sorted_count = tiles.size();
+    return;
   }
+
+  // Sort at least as many tiles again as are sorted already, so that the
+  // number of passes over the rest of the bin stays logarithmic.
+  size_t new_sorted_count =
+      std::max(index + 1, sorted_count + std::max(sorted_count,
+                                                  kMinSortedTiles));
+  new_sorted_count = std::min(new_sorted_count, tiles.size());
+
+  TileVector::iterator first = tiles.begin() + sorted_count;
+  TileVector::iterator middle = tiles.begin() + new_sorted_count;
+  if (middle != tiles.end())
+    std::nth_element(first, middle, tiles.end(), BinComparator());
+  std::sort(first, middle, BinComparator());
+  sorted_count = new_sorted_count;
 }
 
 PrioritizedTileSet::Iterator::Iterator(
     PrioritizedTileSet* tile_set, bool use_priority_ordering)
     : tile_set_(tile_set),
       current_bin_(NOW_AND_READY_TO_DRAW_BIN),
+      index_(0),
       use_priority_ordering_(use_priority_ordering) {
   if (use_priority_ordering_)
-    tile_set_->SortBinIfNeeded(current_bin_);
-  iterator_ = tile_set->tiles_[current_bin_].begin();
-  if (iterator_ == tile_set_->tiles_[current_bin_].end())
+    tile_set_->SortBinUpTo(current_bin_, index_);
+  if (index_ == tile_set_->tiles_[current_bin_].size())
     AdvanceList();
 }
 
@@ -109,30 +135,33 @@ void PrioritizedTileSet::Iterator::DisablePriorityOrdering() {
 PrioritizedTileSet::Iterator&
 PrioritizedTileSet::Iterator::operator++() {
   // We can't increment past the end of the tiles.
-  DCHECK(iterator_ != tile_set_->tiles_[current_bin_].end());
+  DCHECK_LT(index_, tile_set_->tiles_[current_bin_].size());
 
-  ++iterator_;
-  if (iterator_ == tile_set_->tiles_[current_bin_].end())
+  ++index_;
+  if (index_ == tile_set_->tiles_[current_bin_].size()) {
     AdvanceList();
+  } else if (use_priority_ordering_) {
+    tile_set_->SortBinUpTo(current_bin_, index_);
+  }
   return *this;
 }
 
 Tile* PrioritizedTileSet::Iterator::operator*() {
-  DCHECK(iterator_ != tile_set_->tiles_[current_bin_].end());
-  return *iterator_;
+  DCHECK_LT(index_, tile_set_->tiles_[current_bin_].size());
+  return tile_set_->tiles_[current_bin_][index_];
 }
 
 void PrioritizedTileSet::Iterator::AdvanceList() {
-  DCHECK(iterator_ == tile_set_->tiles_[current_bin_].end());
+  DCHECK_EQ(index_, tile_set_->tiles_[current_bin_].size());
 
   while (current_bin_ != NEVER_BIN) {
     current_bin_ = static_cast<ManagedTileBin>(current_bin_ + 1);
+    index_ = 0;
 
     if (use_priority_ordering_)
-      tile_set_->SortBinIfNeeded(current_bin_);
+      tile_set_->SortBinUpTo(current_bin_, index_);
 
-    iterator_ = tile_set_->tiles_[current_bin_].begin();
-    if (iterator_ != tile_set_->tiles_[current_bin_].end())
+    if (index_ != tile_set_->tiles_[current_bin_].size())
       break;
   }
 }
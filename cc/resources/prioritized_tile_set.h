@@ -13,6 +13,12 @@
 namespace cc {
 class Tile;
 
+// Holds tiles by bin, and iterates over them in priority order.
+//
+// Bins are sorted lazily, and only as far as they are iterated: as the
+// iteration usually stops once the memory budget is spent, the cost of sorting
+// scales with the number of tiles that fit in it rather than with the number
+// of tiles.
 class CC_EXPORT PrioritizedTileSet {
  public:
   PrioritizedTileSet();
@@ -33,7 +39,7 @@ class CC_EXPORT PrioritizedTileSet {
     Tile* operator->() { return *(*this); }
     Tile* operator*();
     operator bool() const {
-      return iterator_ != tile_set_->tiles_[current_bin_].end();
+      return index_ < tile_set_->tiles_[current_bin_].size();
     }
 
    private:
@@ -41,17 +47,20 @@ class CC_EXPORT PrioritizedTileSet {
 
     PrioritizedTileSet* tile_set_;
     ManagedTileBin current_bin_;
-    std::vector<Tile*>::iterator iterator_;
+    size_t index_;
     bool use_priority_ordering_;
   };
 
  private:
   friend class Iterator;
 
-  void SortBinIfNeeded(ManagedTileBin bin);
+  // Makes sure that the tiles of |bin| are sorted up to |index|, included.
+  void SortBinUpTo(ManagedTileBin bin, size_t index);
 
   std::vector<Tile*> tiles_[NUM_BINS];
-  bool bin_sorted_[NUM_BINS];
+  // The number of tiles at the start of each bin that are sorted, and come
+  // before all the other tiles of the bin.
+  size_t sorted_count_[NUM_BINS];
 };
 
 }  // namespace cc
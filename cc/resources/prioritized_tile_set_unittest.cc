@@ -41,7 +41,9 @@ class BinComparator {
     gfx::Rect b_rect = b->content_rect();
     if (a_rect.y() != b_rect.y())
       return a_rect.y() < b_rect.y();
-    return a_rect.x() < b_rect.x();
+    if (a_rect.x() != b_rect.x())
+      return a_rect.x() < b_rect.x();
+    return a->id() < b->id();
   }
 };
 
@@ -525,6 +527,42 @@ TEST_F(PrioritizedTileSetTest, ManyTilesForEachBin) {
   EXPECT_FALSE(it);
 }
 
+TEST_F(PrioritizedTileSetTest, PartiallyIteratedBin) {
+  // Ensure that bins that are sorted as far as they are iterated still yield
+  // all their tiles in BinComparator order, also after more tiles are
+  // inserted.
+
+  PrioritizedTileSet set;
+  std::vector<scoped_refptr<Tile> > tiles;
+  for (int i = 0; i < 100; ++i)
+    tiles.push_back(CreateTile());
+  for (int i = 99; i >= 0; --i)
+    set.InsertTile(tiles[i], EVENTUALLY_BIN);
+
+  std::sort(tiles.begin(), tiles.end(), BinComparator());
+  PrioritizedTileSet::Iterator it(&set, true);
+  for (int i = 0; i < 10; ++i) {
+    ASSERT_TRUE(it);
+    EXPECT_TRUE(*it == tiles[i].get());
+    ++it;
+  }
+
+  for (int i = 0; i < 100; ++i) {
+    scoped_refptr<Tile> tile = CreateTile();
+    tiles.push_back(tile);
+    set.InsertTile(tile, EVENTUALLY_BIN);
+  }
+
+  std::sort(tiles.begin(), tiles.end(), BinComparator());
+  size_t i = 0;
+  for (PrioritizedTileSet::Iterator it(&set, true); it; ++it) {
+    ASSERT_LT(i, tiles.size());
+    EXPECT_TRUE(*it == tiles[i].get());
+    ++i;
+  }
+  EXPECT_EQ(tiles.size(), i);
+}
+
 TEST_F(PrioritizedTileSetTest, ManyTilesForEachBinDisablePriority) {
   // Aggregate test with many tiles for each of the bins. Tiles should
   // appear in order, until DisablePriorityOrdering is called. After that
@@ -17,6 +17,7 @@
 #include "testing/gtest/include/gtest/gtest.h"
 #include "testing/perf/perf_test.h"
 #include "third_party/khronos/GLES2/gl2.h"
+#include "third_party/skia/include/core/SkCanvas.h"
 
 namespace cc {
 namespace {
@@ -63,19 +64,21 @@ class PerfRasterWorkerPoolTaskImpl : public internal::RasterWorkerPoolTask {
   PerfRasterWorkerPoolTaskImpl(scoped_ptr<ScopedResource> resource,
                                internal::WorkerPoolTask::Vector* dependencies)
       : internal::RasterWorkerPoolTask(resource.get(), dependencies),
-        resource_(resource.Pass()) {}
+        resource_(resource.Pass()),
+        canvas_(NULL) {}
 
   // Overridden from internal::Task:
-  virtual void RunOnWorkerThread(unsigned thread_index) OVERRIDE {}
+  virtual void RunOnWorkerThread(unsigned thread_index) OVERRIDE { Raster(); }
 
   // Overridden from internal::WorkerPoolTask:
   virtual void ScheduleOnOriginThread(internal::WorkerPoolTaskClient* client)
       OVERRIDE {
-    client->AcquireCanvasForRaster(this);
+    canvas_ = client->AcquireCanvasForRaster(this);
   }
-  virtual void RunOnOriginThread() OVERRIDE {}
+  virtual void RunOnOriginThread() OVERRIDE { Raster(); }
   virtual void CompleteOnOriginThread(internal::WorkerPoolTaskClient* client)
       OVERRIDE {
+    canvas_ = NULL;
     client->OnRasterCompleted(this, PicturePileImpl::Analysis());
   }
   virtual void RunReplyOnOriginThread() OVERRIDE { Reset(); }
@@ -89,7 +92,14 @@ class PerfRasterWorkerPoolTaskImpl : public internal::RasterWorkerPoolTask {
   virtual ~PerfRasterWorkerPoolTaskImpl() {}
 
  private:
+  // Writes every pixel of the resource, as rasterizing a tile does.
+  void Raster() {
+    if (canvas_)
+      canvas_->clear(SK_ColorWHITE);
+  }
+
   scoped_ptr<ScopedResource> resource_;
+  SkCanvas* canvas_;
 
   DISALLOW_COPY_AND_ASSIGN(PerfRasterWorkerPoolTaskImpl);
 };
@@ -196,10 +206,9 @@ class RasterWorkerPoolPerfTest
 
   void CreateRasterTasks(
       unsigned num_raster_tasks,
+      const gfx::Size& size,
       const internal::WorkerPoolTask::Vector& image_decode_tasks,
       RasterTaskVector* raster_tasks) {
-    const gfx::Size size(1, 1);
-
     for (unsigned i = 0; i < num_raster_tasks; ++i) {
       scoped_ptr<ScopedResource> resource(
           ScopedResource::Create(resource_provider_.get()));
@@ -225,7 +234,8 @@ class RasterWorkerPoolPerfTest
     internal::WorkerPoolTask::Vector image_decode_tasks;
     RasterTaskVector raster_tasks;
     CreateImageDecodeTasks(num_image_decode_tasks, &image_decode_tasks);
-    CreateRasterTasks(num_raster_tasks, image_decode_tasks, &raster_tasks);
+    CreateRasterTasks(
+        num_raster_tasks, gfx::Size(1, 1), image_decode_tasks, &raster_tasks);
 
     // Avoid unnecessary heap allocations by reusing the same queue.
     RasterTaskQueue queue;
@@ -259,8 +269,10 @@ class RasterWorkerPoolPerfTest
     RasterTaskVector raster_tasks[kNumVersions];
     for (size_t i = 0; i < kNumVersions; ++i) {
       CreateImageDecodeTasks(num_image_decode_tasks, &image_decode_tasks[i]);
-      CreateRasterTasks(
-          num_raster_tasks, image_decode_tasks[i], &raster_tasks[i]);
+      CreateRasterTasks(num_raster_tasks,
+                        gfx::Size(1, 1),
+                        image_decode_tasks[i],
+                        &raster_tasks[i]);
     }
 
     // Avoid unnecessary heap allocations by reusing the same queue.
@@ -295,7 +307,8 @@ class RasterWorkerPoolPerfTest
     internal::WorkerPoolTask::Vector image_decode_tasks;
     RasterTaskVector raster_tasks;
     CreateImageDecodeTasks(num_image_decode_tasks, &image_decode_tasks);
-    CreateRasterTasks(num_raster_tasks, image_decode_tasks, &raster_tasks);
+    CreateRasterTasks(
+        num_raster_tasks, gfx::Size(1, 1), image_decode_tasks, &raster_tasks);
 
     // Avoid unnecessary heap allocations by reusing the same queue.
     RasterTaskQueue queue;
@@ -321,6 +334,39 @@ class RasterWorkerPoolPerfTest
                            true);
   }
 
+  void RunRasterTasksTest(const std::string& test_name,
+                          unsigned num_raster_tasks,
+                          const gfx::Size& tile_size) {
+    RasterTaskVector raster_tasks;
+    CreateRasterTasks(num_raster_tasks,
+                      tile_size,
+                      internal::WorkerPoolTask::Vector(),
+                      &raster_tasks);
+
+    // Avoid unnecessary heap allocations by reusing the same queue.
+    RasterTaskQueue queue;
+
+    timer_.Reset();
+    do {
+      queue.Reset();
+      BuildTaskQueue(&queue, raster_tasks);
+      raster_worker_pool_->ScheduleTasks(&queue);
+      RunMessageLoopUntilAllTasksHaveCompleted();
+      timer_.NextLap();
+    } while (!timer_.HasTimeLimitExpired());
+
+    RasterTaskQueue empty;
+    raster_worker_pool_->ScheduleTasks(&empty);
+    RunMessageLoopUntilAllTasksHaveCompleted();
+
+    perf_test::PrintResult("raster_tasks",
+                           TestModifierString(),
+                           test_name,
+                           timer_.LapsPerSecond(),
+                           "runs/s",
+                           true);
+  }
+
  private:
   std::string TestModifierString() const {
     switch (GetParam()) {
@@ -371,6 +417,13 @@ TEST_P(RasterWorkerPoolPerfTest, ScheduleAndExecuteTasks) {
   RunScheduleAndExecuteTasksTest("32_4", 32, 4);
 }
 
+TEST_P(RasterWorkerPoolPerfTest, RasterTasks) {
+  RunRasterTasksTest("1_256x256", 1, gfx::Size(256, 256));
+  RunRasterTasksTest("32_256x256", 32, gfx::Size(256, 256));
+  RunRasterTasksTest("1_512x512", 1, gfx::Size(512, 512));
+  RunRasterTasksTest("32_512x512", 32, gfx::Size(512, 512));
+}
+
 INSTANTIATE_TEST_CASE_P(RasterWorkerPoolPerfTests,
                         RasterWorkerPoolPerfTest,
                         ::testing::Values(RASTER_WORKER_POOL_TYPE_PIXEL_BUFFER,
@@ -4,6 +4,7 @@
 
 #include "cc/resources/resource_pool.h"
 
+#include "base/bind.h"
 #include "cc/resources/resource_provider.h"
 #include "cc/resources/scoped_resource.h"
 
@@ -20,7 +21,9 @@ ResourcePool::ResourcePool(ResourceProvider* resource_provider,
       max_resource_count_(0),
       memory_usage_bytes_(0),
       unused_memory_usage_bytes_(0),
-      resource_count_(0) {}
+      resource_count_(0),
+      memory_pressure_listener_(base::Bind(&ResourcePool::OnMemoryPressure,
+                                           base::Unretained(this))) {}
 
 ResourcePool::~ResourcePool() {
   while (!busy_resources_.empty()) {
@@ -37,8 +40,10 @@ ResourcePool::~ResourcePool() {
 
 scoped_ptr<ScopedResource> ResourcePool::AcquireResource(
     const gfx::Size& size) {
-  for (ResourceList::iterator it = unused_resources_.begin();
-       it != unused_resources_.end();
+  // Reuse the most recently used resource of the right size, so that the
+  // resources that are not needed anymore age and get evicted first.
+  for (ResourceList::reverse_iterator it = unused_resources_.rbegin();
+       it != unused_resources_.rend();
        ++it) {
     ScopedResource* resource = *it;
     DCHECK(resource_provider_->CanLockForWrite(resource->id()));
@@ -46,7 +51,7 @@ scoped_ptr<ScopedResource> ResourcePool::AcquireResource(
     if (resource->size() != size)
       continue;
 
-    unused_resources_.erase(it);
+    unused_resources_.erase(--it.base());
     unused_memory_usage_bytes_ -= resource->bytes();
     return make_scoped_ptr(resource);
   }
@@ -94,10 +99,7 @@ void ResourcePool::ReduceResourceUsage() {
     // memory is necessarily returned to the OS.
     ScopedResource* resource = unused_resources_.front();
     unused_resources_.pop_front();
-    memory_usage_bytes_ -= resource->bytes();
-    unused_memory_usage_bytes_ -= resource->bytes();
-    --resource_count_;
-    delete resource;
+    DeleteUnusedResource(resource);
   }
 }
 
@@ -131,4 +133,21 @@ void ResourcePool::DidFinishUsingResource(ScopedResource* resource) {
   unused_resources_.push_back(resource);
 }
 
+void ResourcePool::DeleteUnusedResource(ScopedResource* resource) {
+  memory_usage_bytes_ -= resource->bytes();
+  unused_memory_usage_bytes_ -= resource->bytes();
+  --resource_count_;
+  delete resource;
+}
+
+void ResourcePool::OnMemoryPressure(
+    base::MemoryPressureListener::MemoryPressureLevel memory_pressure_level) {
+  // Unused resources are only kept around to save allocations, and are the
+  // first thing to give up when memory gets tight.
+  while (!unused_resources_.empty()) {
+    DeleteUnusedResource(unused_resources_.front());
+    unused_resources_.pop_front();
+  }
+}
+
 }  // namespace cc
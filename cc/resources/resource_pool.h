@@ -7,6 +7,7 @@
 
 #include <list>
 
+#include "base/memory/memory_pressure_listener.h"
 #include "base/memory/scoped_ptr.h"
 #include "cc/base/cc_export.h"
 #include "cc/output/renderer.h"
@@ -53,6 +54,9 @@ class CC_EXPORT ResourcePool {
 
  private:
   void DidFinishUsingResource(ScopedResource* resource);
+  void DeleteUnusedResource(ScopedResource* resource);
+  void OnMemoryPressure(
+      base::MemoryPressureListener::MemoryPressureLevel memory_pressure_level);
 
   ResourceProvider* resource_provider_;
   const GLenum target_;
@@ -64,10 +68,13 @@ class CC_EXPORT ResourcePool {
   size_t unused_memory_usage_bytes_;
   size_t resource_count_;
 
+  // Unused resources are ordered from least to most recently used.
   typedef std::list<ScopedResource*> ResourceList;
   ResourceList unused_resources_;
   ResourceList busy_resources_;
 
+  base::MemoryPressureListener memory_pressure_listener_;
+
   DISALLOW_COPY_AND_ASSIGN(ResourcePool);
 };
 
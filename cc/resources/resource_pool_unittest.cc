@@ -0,0 +1,85 @@
+// Copyright 2014 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "cc/resources/resource_pool.h"
+
+#include "base/message_loop/message_loop.h"
+#include "base/run_loop.h"
+#include "cc/resources/scoped_resource.h"
+#include "cc/test/fake_output_surface.h"
+#include "cc/test/fake_output_surface_client.h"
+#include "testing/gtest/include/gtest/gtest.h"
+
+namespace cc {
+namespace {
+
+class ResourcePoolTest : public testing::Test {
+ public:
+  virtual void SetUp() OVERRIDE {
+    output_surface_ = FakeOutputSurface::Create3d();
+    CHECK(output_surface_->BindToClient(&output_surface_client_));
+    resource_provider_ =
+        ResourceProvider::Create(output_surface_.get(), NULL, 0, false, 1);
+    resource_pool_ = ResourcePool::Create(
+        resource_provider_.get(), GL_TEXTURE_2D, RGBA_8888);
+    resource_pool_->SetResourceUsageLimits(
+        100 * 100 * 4 * 10, 100 * 100 * 4 * 10, 10);
+  }
+
+ protected:
+  base::MessageLoop message_loop_;
+  FakeOutputSurfaceClient output_surface_client_;
+  scoped_ptr<FakeOutputSurface> output_surface_;
+  scoped_ptr<ResourceProvider> resource_provider_;
+  scoped_ptr<ResourcePool> resource_pool_;
+};
+
+TEST_F(ResourcePoolTest, ReusesMostRecentlyUsedResource) {
+  gfx::Size size(100, 100);
+  scoped_ptr<ScopedResource> first = resource_pool_->AcquireResource(size);
+  scoped_ptr<ScopedResource> second = resource_pool_->AcquireResource(size);
+  ResourceProvider::ResourceId second_id = second->id();
+
+  resource_pool_->ReleaseResource(first.Pass());
+  resource_pool_->ReleaseResource(second.Pass());
+  resource_pool_->CheckBusyResources();
+  EXPECT_EQ(0u, resource_pool_->acquired_resource_count());
+
+  scoped_ptr<ScopedResource> resource = resource_pool_->AcquireResource(size);
+  EXPECT_EQ(second_id, resource->id());
+  EXPECT_EQ(1u, resource_pool_->acquired_resource_count());
+  EXPECT_EQ(2u * 100 * 100 * 4, resource_pool_->total_memory_usage_bytes());
+
+  // Resources of other sizes are not reused.
+  scoped_ptr<ScopedResource> other =
+      resource_pool_->AcquireResource(gfx::Size(50, 50));
+  EXPECT_EQ(2u, resource_pool_->acquired_resource_count());
+  EXPECT_EQ(2u * 100 * 100 * 4 + 50 * 50 * 4,
+            resource_pool_->total_memory_usage_bytes());
+
+  resource_pool_->ReleaseResource(resource.Pass());
+  resource_pool_->ReleaseResource(other.Pass());
+}
+
+TEST_F(ResourcePoolTest, FreesUnusedResourcesOnMemoryPressure) {
+  gfx::Size size(100, 100);
+  scoped_ptr<ScopedResource> unused = resource_pool_->AcquireResource(size);
+  scoped_ptr<ScopedResource> used = resource_pool_->AcquireResource(size);
+  resource_pool_->ReleaseResource(unused.Pass());
+  resource_pool_->CheckBusyResources();
+  EXPECT_EQ(2u * 100 * 100 * 4, resource_pool_->total_memory_usage_bytes());
+
+  base::MemoryPressureListener::NotifyMemoryPressure(
+      base::MemoryPressureListener::MEMORY_PRESSURE_MODERATE);
+  base::RunLoop().RunUntilIdle();
+
+  EXPECT_EQ(100u * 100 * 4, resource_pool_->total_memory_usage_bytes());
+  EXPECT_EQ(100u * 100 * 4, resource_pool_->acquired_memory_usage_bytes());
+  EXPECT_EQ(1u, resource_pool_->acquired_resource_count());
+
+  resource_pool_->ReleaseResource(used.Pass());
+}
+
+}  // namespace
+}  // namespace cc
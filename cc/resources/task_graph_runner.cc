@@ -14,12 +14,32 @@ namespace cc {
 namespace internal {
 namespace {
 
-// Helper class for iterating over all dependents of a task.
+// Orders edges by task, so that the edges from a task are contiguous and can
+// be found by binary search.
+class EdgeTaskComparator {
+ public:
+  bool operator()(const TaskGraph::Edge& a, const TaskGraph::Edge& b) const {
+    return std::less<const Task*>()(a.task, b.task);
+  }
+  bool operator()(const TaskGraph::Edge& edge, const Task* task) const {
+    return std::less<const Task*>()(edge.task, task);
+  }
+};
+
+// Helper class for iterating over all dependents of a task, in a graph with
+// edges sorted by EdgeTaskComparator.
 class DependentIterator {
  public:
   DependentIterator(TaskGraph* graph, const Task* task)
-      : graph_(graph), task_(task), current_index_(-1), current_node_(NULL) {
-    ++(*this);
+      : graph_(graph),
+        task_(task),
+        current_index_(std::lower_bound(graph->edges.begin(),
+                                        graph->edges.end(),
+                                        task,
+                                        EdgeTaskComparator()) -
+                       graph->edges.begin()),
+        current_node_(NULL) {
+    FindCurrentNode();
   }
 
   TaskGraph::Node& operator->() const {
@@ -36,16 +56,23 @@ class DependentIterator {
     return *current_node_;
   }
 
-  // Note: Performance can be improved by keeping edges sorted.
   DependentIterator& operator++() {
-    // Find next dependency edge for |task_|.
-    do {
-      ++current_index_;
-      if (current_index_ == graph_->edges.size())
-        return *this;
-    } while (graph_->edges[current_index_].task != task_);
-
-    // Now find the node for the dependent of this edge.
+    ++current_index_;
+    FindCurrentNode();
+    return *this;
+  }
+
+  operator bool() const { return current_node_ != NULL; }
+
+ private:
+  // Finds the node for the dependent of the current edge, if it is an edge
+  // from |task_|.
+  void FindCurrentNode() {
+    current_node_ = NULL;
+    if (current_index_ == graph_->edges.size() ||
+        graph_->edges[current_index_].task != task_)
+      return;
+
     TaskGraph::Node::Vector::iterator it =
         std::find_if(graph_->nodes.begin(),
                      graph_->nodes.end(),
@@ -53,13 +80,8 @@ class DependentIterator {
                          graph_->edges[current_index_].dependent));
     DCHECK(it != graph_->nodes.end());
     current_node_ = &(*it);
-
-    return *this;
   }
 
-  operator bool() const { return current_index_ < graph_->edges.size(); }
-
- private:
   TaskGraph* graph_;
   const Task* task_;
   size_t current_index_;
@@ -223,6 +245,10 @@ void TaskGraphRunner::SetTaskGraph(NamespaceToken token, TaskGraph* graph) {
                       DependencyMismatchComparator(graph)) ==
          graph->nodes.end());
 
+  // Sort the edges before taking |lock_|, so that finding the dependents of
+  // a task while holding it doesn't require a scan of all the edges.
+  std::sort(graph->edges.begin(), graph->edges.end(), EdgeTaskComparator());
+
   {
     base::AutoLock lock(lock_);
 
@@ -147,7 +147,7 @@ class CC_EXPORT TaskGraphRunner : public base::DelegateSimpleThread::Delegate {
     TaskNamespace();
     ~TaskNamespace();
 
-    // Current task graph.
+    // Current task graph, with its edges sorted by task.
     TaskGraph graph;
 
     // Ordered set of tasks that are ready to run.
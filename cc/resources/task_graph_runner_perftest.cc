@@ -291,6 +291,8 @@ TEST_F(TaskGraphRunnerPerfTest, BuildTaskGraph) {
   RunBuildTaskGraphTest("2_32_0", 2, 32, 0);
   RunBuildTaskGraphTest("2_1_1", 2, 1, 1);
   RunBuildTaskGraphTest("2_32_1", 2, 32, 1);
+  RunBuildTaskGraphTest("0_256_0", 0, 256, 0);
+  RunBuildTaskGraphTest("2_256_1", 2, 256, 1);
 }
 
 TEST_F(TaskGraphRunnerPerfTest, ScheduleTasks) {
@@ -300,6 +302,8 @@ TEST_F(TaskGraphRunnerPerfTest, ScheduleTasks) {
   RunScheduleTasksTest("2_32_0", 2, 32, 0);
   RunScheduleTasksTest("2_1_1", 2, 1, 1);
   RunScheduleTasksTest("2_32_1", 2, 32, 1);
+  RunScheduleTasksTest("0_256_0", 0, 256, 0);
+  RunScheduleTasksTest("2_256_1", 2, 256, 1);
 }
 
 TEST_F(TaskGraphRunnerPerfTest, ScheduleAlternateTasks) {
@@ -309,6 +313,8 @@ TEST_F(TaskGraphRunnerPerfTest, ScheduleAlternateTasks) {
   RunScheduleAlternateTasksTest("2_32_0", 2, 32, 0);
   RunScheduleAlternateTasksTest("2_1_1", 2, 1, 1);
   RunScheduleAlternateTasksTest("2_32_1", 2, 32, 1);
+  RunScheduleAlternateTasksTest("0_256_0", 0, 256, 0);
+  RunScheduleAlternateTasksTest("2_256_1", 2, 256, 1);
 }
 
 TEST_F(TaskGraphRunnerPerfTest, ScheduleAndExecuteTasks) {
@@ -318,6 +324,8 @@ TEST_F(TaskGraphRunnerPerfTest, ScheduleAndExecuteTasks) {
   RunScheduleAndExecuteTasksTest("2_32_0", 2, 32, 0);
   RunScheduleAndExecuteTasksTest("2_1_1", 2, 1, 1);
   RunScheduleAndExecuteTasksTest("2_32_1", 2, 32, 1);
+  RunScheduleAndExecuteTasksTest("0_256_0", 0, 256, 0);
+  RunScheduleAndExecuteTasksTest("2_256_1", 2, 256, 1);
 }
 
 }  // namespace
@@ -33,6 +33,8 @@ Tile::Tile(TileManager* tile_manager,
     flags_(flags),
     id_(s_next_id_++) {
   set_picture_pile(picture_pile);
+  for (int i = 0; i < NUM_TREES; ++i)
+    is_occluded_[i] = false;
 }
 
 Tile::~Tile() {
@@ -49,6 +51,14 @@ void Tile::SetPriority(WhichTree tree, const TilePriority& priority) {
   tile_manager_->DidChangeTilePriority(this);
 }
 
+void Tile::SetIsOccluded(WhichTree tree, bool is_occluded) {
+  if (is_occluded == is_occluded_[tree])
+    return;
+
+  is_occluded_[tree] = is_occluded;
+  tile_manager_->DidChangeTilePriority(this);
+}
+
 void Tile::MarkRequiredForActivation() {
   if (priority_[PENDING_TREE].required_for_activation)
     return;
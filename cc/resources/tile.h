@@ -51,6 +51,11 @@ class CC_EXPORT Tile : public RefCountedManaged<Tile> {
 
   void SetPriority(WhichTree tree, const TilePriority& priority);
 
+  // Whether the visible part of the tile is hidden behind opaque content on
+  // |tree|, in which case it needn't be rasterized for that tree.
+  bool is_occluded(WhichTree tree) const { return is_occluded_[tree]; }
+  void SetIsOccluded(WhichTree tree, bool is_occluded);
+
   void MarkRequiredForActivation();
 
   bool required_for_activation() const {
@@ -155,6 +160,7 @@ class CC_EXPORT Tile : public RefCountedManaged<Tile> {
   gfx::Rect opaque_rect_;
 
   TilePriority priority_[NUM_TREES];
+  bool is_occluded_[NUM_TREES];
   ManagedTileState managed_state_;
   int layer_id_;
   int source_frame_number_;
@@ -392,6 +392,17 @@ void TileManager::GetTilesWithAssignedBins(PrioritizedTileSet* tiles) {
     if (!tile_is_ready_to_draw && pending_is_non_ideal)
       pending_bin = NEVER_BIN;
 
+    // Nor do we want to paint visible tiles that are hidden behind opaque
+    // content, as they would not be drawn.
+    if (!tile_is_ready_to_draw &&
+        active_priority.priority_bin == TilePriority::NOW &&
+        tile->is_occluded(ACTIVE_TREE))
+      active_bin = NEVER_BIN;
+    if (!tile_is_ready_to_draw &&
+        pending_priority.priority_bin == TilePriority::NOW &&
+        tile->is_occluded(PENDING_TREE))
+      pending_bin = NEVER_BIN;
+
     // Compute combined bin.
     ManagedTileBin combined_bin = std::min(active_bin, pending_bin);
 
@@ -957,6 +968,9 @@ void TileManager::OnRasterTaskCompleted(
   ++update_visible_tiles_stats_.completed_count;
 
   tile_version.set_has_text(analysis.has_text);
+  if (tile->use_gpu_rasterization() &&
+      !analysis.is_suitable_for_gpu_rasterization)
+    tile->picture_pile()->set_is_suitable_for_gpu_rasterization(false);
   if (analysis.is_solid_color) {
     tile_version.set_solid_color(analysis.solid_color);
     resource_pool_->ReleaseResource(resource.Pass());
@@ -229,6 +229,36 @@ TEST_P(TileManagerTest, EnoughMemoryAllowNothing) {
   EXPECT_EQ(0, AssignedMemoryCount(never_bin));
 }
 
+TEST_P(TileManagerTest, OccludedTilesAreNotRasterized) {
+  // Visible tiles hidden behind opaque content on the tree they are visible on
+  // get no memory, even when there is enough for all tiles.
+
+  Initialize(10, ALLOW_ANYTHING, SAME_PRIORITY_FOR_BOTH_TREES);
+  TileVector occluded_active_now =
+      CreateTiles(3, TilePriorityForNowBin(), TilePriority());
+  TileVector occluded_pending_now =
+      CreateTiles(3, TilePriority(), TilePriorityForNowBin());
+  TileVector occluded_on_other_tree =
+      CreateTiles(3, TilePriorityForNowBin(), TilePriority());
+  TileVector occluded_soon =
+      CreateTiles(3, TilePriorityForSoonBin(), TilePriorityForSoonBin());
+  for (size_t i = 0; i < 3; ++i) {
+    occluded_active_now[i]->SetIsOccluded(ACTIVE_TREE, true);
+    occluded_pending_now[i]->SetIsOccluded(PENDING_TREE, true);
+    occluded_on_other_tree[i]->SetIsOccluded(PENDING_TREE, true);
+    // Occlusion is only known for the visible tiles.
+    occluded_soon[i]->SetIsOccluded(ACTIVE_TREE, true);
+    occluded_soon[i]->SetIsOccluded(PENDING_TREE, true);
+  }
+
+  tile_manager()->AssignMemoryToTiles(global_state_);
+
+  EXPECT_EQ(0, AssignedMemoryCount(occluded_active_now));
+  EXPECT_EQ(0, AssignedMemoryCount(occluded_pending_now));
+  EXPECT_EQ(3, AssignedMemoryCount(occluded_on_other_tree));
+  EXPECT_EQ(3, AssignedMemoryCount(occluded_soon));
+}
+
 TEST_P(TileManagerTest, PartialOOMMemoryToPending) {
   // 5 tiles on active tree eventually bin, 5 tiles on pending tree that are
   // required for activation, but only enough memory for 8 tiles. The result
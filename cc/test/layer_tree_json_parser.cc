@@ -4,6 +4,7 @@
 
 #include "cc/test/layer_tree_json_parser.h"
 
+#include "base/strings/string_util.h"
 #include "base/test/values_test_util.h"
 #include "base/values.h"
 #include "cc/layers/content_layer.h"
@@ -17,6 +18,25 @@ namespace cc {
 
 namespace {
 
+// Layer trees dumped on the impl side, like by the layer_tree_dump_benchmark,
+// name the types of the LayerImpls instead, e.g. "cc::PictureLayerImpl".
+std::string LayerTypeFromImplLayerType(const std::string& impl_layer_type) {
+  const char kPrefix[] = "cc::";
+  const char kSuffix[] = "Impl";
+  if (!StartsWithASCII(impl_layer_type, kPrefix, true) ||
+      !EndsWith(impl_layer_type, kSuffix, true))
+    return impl_layer_type;
+
+  std::string layer_type = impl_layer_type.substr(
+      arraysize(kPrefix) - 1,
+      impl_layer_type.size() - (arraysize(kPrefix) - 1) -
+          (arraysize(kSuffix) - 1));
+  // TiledLayerImpl is the impl side of ContentLayer.
+  if (layer_type == "TiledLayer")
+    return "ContentLayer";
+  return layer_type;
+}
+
 scoped_refptr<Layer> ParseTreeFromValue(base::Value* val,
                                         ContentLayerClient* content_client) {
   base::DictionaryValue* dict;
@@ -24,6 +44,7 @@ scoped_refptr<Layer> ParseTreeFromValue(base::Value* val,
   success &= val->GetAsDictionary(&dict);
   std::string layer_type;
   success &= dict->GetString("LayerType", &layer_type);
+  layer_type = LayerTypeFromImplLayerType(layer_type);
   base::ListValue* list;
   success &= dict->GetList("Bounds", &list);
   int width, height;
@@ -1414,15 +1414,6 @@ static void CalculateDrawPropertiesInternal(
   DCHECK(globals.page_scale_application_layer ||
          (globals.page_scale_factor == 1.f));
 
-  DataForRecursion<LayerType> data_for_children;
-  typename LayerType::RenderSurfaceType*
-      nearest_occlusion_immune_ancestor_surface =
-          data_from_ancestor.nearest_occlusion_immune_ancestor_surface;
-  data_for_children.in_subtree_of_page_scale_application_layer =
-      data_from_ancestor.in_subtree_of_page_scale_application_layer;
-  data_for_children.subtree_can_use_lcd_text =
-      data_from_ancestor.subtree_can_use_lcd_text;
-
   // Layers that are marked as hidden will hide themselves and their subtree.
   // Exception: Layers with copy requests, whether hidden or not, must be drawn
   // anyway.  In this case, we will inform their subtree they are visible to get
@@ -1439,6 +1430,17 @@ static void CalculateDrawPropertiesInternal(
     return;
   }
 
+  // Only set up the data for the children once the subtree is known not to be
+  // skipped, so that skipped subtrees don't pay for initializing its matrices.
+  DataForRecursion<LayerType> data_for_children;
+  typename LayerType::RenderSurfaceType*
+      nearest_occlusion_immune_ancestor_surface =
+          data_from_ancestor.nearest_occlusion_immune_ancestor_surface;
+  data_for_children.in_subtree_of_page_scale_application_layer =
+      data_from_ancestor.in_subtree_of_page_scale_application_layer;
+  data_for_children.subtree_can_use_lcd_text =
+      data_from_ancestor.subtree_can_use_lcd_text;
+
   // We need to circumvent the normal recursive flow of information for clip
   // children (they don't inherit their direct ancestor's clip information).
   // This is unfortunate, and would be unnecessary if we were to formally
@@ -17,6 +17,7 @@
 #include "cc/resources/ui_resource_request.h"
 #include "cc/trees/layer_tree_host_common.h"
 #include "cc/trees/layer_tree_host_impl.h"
+#include "cc/trees/occlusion_tracker.h"
 #include "ui/gfx/size_conversions.h"
 #include "ui/gfx/vector2d_conversions.h"
 
@@ -479,24 +480,42 @@ void LayerTreeImpl::UpdateDrawProperties() {
                  IsActiveTree(),
                  "SourceFrameNumber",
                  source_frame_number_);
+    // When occlusion is used, it is tracked through the same front-to-back
+    // walk as when drawing, so that tiles hidden behind opaque layers are
+    // never rasterized.
+    scoped_ptr<OcclusionTrackerImpl> occlusion_tracker;
+    if (settings().use_occlusion_for_tile_prioritization) {
+      occlusion_tracker.reset(new OcclusionTrackerImpl(
+          root_layer()->render_surface()->content_rect(), false));
+      occlusion_tracker->set_minimum_tracking_size(
+          settings().minimum_occlusion_tracking_size);
+    }
+
     // LayerIterator is used here instead of CallFunctionForSubtree to only
     // UpdateTilePriorities on layers that will be visible (and thus have valid
-    // draw properties) and not because any ordering is required.
+    // draw properties), and in the order needed to track occlusion.
     typedef LayerIterator<LayerImpl> LayerIteratorType;
     LayerIteratorType end = LayerIteratorType::End(&render_surface_layer_list_);
     for (LayerIteratorType it =
              LayerIteratorType::Begin(&render_surface_layer_list_);
          it != end;
          ++it) {
-      if (!it.represents_itself())
-        continue;
-      LayerImpl* layer = *it;
+      if (occlusion_tracker)
+        occlusion_tracker->EnterLayer(it);
 
-      layer->UpdateTilePriorities();
-      if (layer->mask_layer())
-        layer->mask_layer()->UpdateTilePriorities();
-      if (layer->replica_layer() && layer->replica_layer()->mask_layer())
-        layer->replica_layer()->mask_layer()->UpdateTilePriorities();
+      LayerImpl* layer = *it;
+      if (it.represents_itself()) {
+        layer->UpdateTilePriorities(occlusion_tracker.get());
+        // Mask layers have their own content space, so occlusion isn't used
+        // for them.
+        if (layer->mask_layer())
+          layer->mask_layer()->UpdateTilePriorities(NULL);
+        if (layer->replica_layer() && layer->replica_layer()->mask_layer())
+          layer->replica_layer()->mask_layer()->UpdateTilePriorities(NULL);
+      }
+
+      if (occlusion_tracker)
+        occlusion_tracker->LeaveLayer(it);
     }
   }
 
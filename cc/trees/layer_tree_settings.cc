@@ -34,6 +34,7 @@ LayerTreeSettings::LayerTreeSettings()
       use_memory_management(true),
       timeout_and_draw_when_animation_checkerboards(true),
       maximum_number_of_failed_draws_before_draw_is_forced_(3),
+      switch_to_low_latency_if_possible(false),
       layer_transforms_should_scale_layer_contents(false),
       minimum_contents_scale(0.0625f),
       low_res_contents_scale_factor(0.25f),
@@ -45,6 +46,7 @@ LayerTreeSettings::LayerTreeSettings()
       default_tile_size(gfx::Size(256, 256)),
       max_untiled_layer_size(gfx::Size(512, 512)),
       minimum_occlusion_tracking_size(gfx::Size(160, 160)),
+      use_occlusion_for_tile_prioritization(false),
       use_pinch_zoom_scrollbars(false),
       use_pinch_virtual_viewport(false),
       // At 256x256 tiles, 128 tiles cover an area of 2048x4096 pixels.
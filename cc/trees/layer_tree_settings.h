@@ -45,6 +45,7 @@ class CC_EXPORT LayerTreeSettings {
   bool use_memory_management;
   bool timeout_and_draw_when_animation_checkerboards;
   int maximum_number_of_failed_draws_before_draw_is_forced_;
+  bool switch_to_low_latency_if_possible;
   bool layer_transforms_should_scale_layer_contents;
   float minimum_contents_scale;
   float low_res_contents_scale_factor;
@@ -56,6 +57,7 @@ class CC_EXPORT LayerTreeSettings {
   gfx::Size default_tile_size;
   gfx::Size max_untiled_layer_size;
   gfx::Size minimum_occlusion_tracking_size;
+  bool use_occlusion_for_tile_prioritization;
   bool use_pinch_zoom_scrollbars;
   bool use_pinch_virtual_viewport;
   size_t max_tiles_for_interest_area;
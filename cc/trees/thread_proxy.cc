@@ -1475,6 +1475,8 @@ void ThreadProxy::InitializeImplOnImplThread(CompletionEvent* completion) {
       settings.timeout_and_draw_when_animation_checkerboards;
   scheduler_settings.maximum_number_of_failed_draws_before_draw_is_forced_ =
       settings.maximum_number_of_failed_draws_before_draw_is_forced_;
+  scheduler_settings.switch_to_low_latency_if_possible =
+      settings.switch_to_low_latency_if_possible;
   scheduler_settings.using_synchronous_renderer_compositor =
       settings.using_synchronous_renderer_compositor;
   scheduler_settings.throttle_frame_production =
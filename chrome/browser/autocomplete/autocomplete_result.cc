@@ -165,23 +165,36 @@ void AutocompleteResult::SortAndCull(const AutocompleteInput& input,
   const bool preserve_top_match = !matches_.empty() &&
       (undemotable_top_types.count(matches_.begin()->type) != 0);
 
-  // Sort and trim to the most relevant kMaxMatches matches.
+  // Sort and trim to the most relevant kMaxMatches matches.  Only the matches
+  // that are kept need to be in order, and matches are expensive to copy, so
+  // the rest are left unsorted.
   size_t max_num_matches = std::min(kMaxMatches, matches_.size());
   CompareWithDemoteByType comparing_object(input.current_page_classification());
-  std::sort(matches_.begin() + (preserve_top_match ? 1 : 0), matches_.end(),
-            comparing_object);
+  const ACMatches::iterator sort_begin =
+      matches_.begin() + (preserve_top_match ? 1 : 0);
+  const ACMatches::iterator sorted_end =
+      std::max(sort_begin, matches_.begin() + max_num_matches);
+  std::partial_sort(sort_begin, sorted_end, matches_.end(), comparing_object);
   if (!matches_.empty() && !matches_.begin()->allowed_to_be_default_match &&
       OmniboxFieldTrial::ReorderForLegalDefaultMatch(
           input.current_page_classification())) {
     // Top match is not allowed to be the default match.  Find the most
-    // relevant legal match and shift it to the front.
+    // relevant legal match and shift it to the front.  It is the first legal
+    // one among the sorted matches, if there is any, or else the most
+    // relevant legal one among the unsorted rest.
+    AutocompleteResult::iterator legal_match = matches_.end();
     for (AutocompleteResult::iterator it = matches_.begin() + 1;
          it != matches_.end(); ++it) {
-      if (it->allowed_to_be_default_match) {
-        std::rotate(matches_.begin(), it, it + 1);
-        break;
+      if (it->allowed_to_be_default_match &&
+          (legal_match == matches_.end() ||
+           comparing_object(*it, *legal_match))) {
+        legal_match = it;
+        if (it < sorted_end)
+          break;
       }
     }
+    if (legal_match != matches_.end())
+      std::rotate(matches_.begin(), legal_match, legal_match + 1);
   }
   // In the process of trimming, drop all matches with a demoted relevance
   // score of 0.
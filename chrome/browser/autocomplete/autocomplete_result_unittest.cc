@@ -494,6 +494,45 @@ TEST_F(AutocompleteResultTest, SortAndCullReorderForDefaultMatch) {
   }
 }
 
+TEST_F(AutocompleteResultTest, SortAndCullReorderForDefaultMatchPastMax) {
+  // More matches than are kept, in no particular order.
+  TestData data[] = {
+    { 7, 0, 600 },
+    { 2, 0, 1100 },
+    { 5, 0, 800 },
+    { 0, 0, 1300 },
+    { 6, 0, 700 },
+    { 3, 0, 1000 },
+    { 1, 0, 1200 },
+    { 4, 0, 900 }
+  };
+  ASSERT_GT(arraysize(data), AutocompleteResult::kMaxMatches);
+
+  // Only matches that would otherwise be culled are legal default matches.
+  // The most relevant of them is moved to the front.
+  ACMatches matches;
+  PopulateAutocompleteMatches(data, arraysize(data), &matches);
+  for (ACMatches::iterator it = matches.begin(); it != matches.end(); ++it) {
+    it->allowed_to_be_default_match =
+        it->destination_url == GURL("http://g/") ||
+        it->destination_url == GURL("http://h/");
+  }
+  AutocompleteResult result;
+  result.AppendMatches(matches);
+  AutocompleteInput input(base::string16(), base::string16::npos,
+                          base::string16(), GURL(),
+                          AutocompleteInput::HOME_PAGE, false, false, false,
+                          AutocompleteInput::ALL_MATCHES);
+  result.SortAndCull(input, test_util_.profile());
+  ASSERT_EQ(AutocompleteResult::kMaxMatches, result.size());
+  EXPECT_EQ("http://g/", result.match_at(0)->destination_url.spec());
+  EXPECT_EQ("http://a/", result.match_at(1)->destination_url.spec());
+  EXPECT_EQ("http://b/", result.match_at(2)->destination_url.spec());
+  EXPECT_EQ("http://c/", result.match_at(3)->destination_url.spec());
+  EXPECT_EQ("http://d/", result.match_at(4)->destination_url.spec());
+  EXPECT_EQ("http://e/", result.match_at(5)->destination_url.spec());
+}
+
 TEST_F(AutocompleteResultTest, ShouldHideTopMatch) {
   base::FieldTrialList::CreateFieldTrial("InstantExtended",
                                          "Group1 hide_verbatim:1");
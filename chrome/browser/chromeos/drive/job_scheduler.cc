@@ -136,10 +136,12 @@ google_apis::CancelCallback RunResumeUploadFile(
 
 }  // namespace
 
-// Metadata jobs are cheap, so we run them concurrently. File jobs run serially.
+// Metadata jobs are cheap, so we run them concurrently. A single file transfer
+// rarely saturates the link, so two of them run at a time, but no more, so
+// that they don't starve each other on slow connections.
 const int JobScheduler::kMaxJobCount[] = {
   5,  // METADATA_QUEUE
-  1,  // FILE_QUEUE
+  2,  // FILE_QUEUE
 };
 
 JobScheduler::JobEntry::JobEntry(JobType type)
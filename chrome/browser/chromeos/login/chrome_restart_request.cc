@@ -166,7 +166,9 @@ std::string DeriveCommandLine(const GURL& start_url,
       cc::switches::kDisableCompositorTouchHitTesting,
       cc::switches::kDisableGPURasterization,
       cc::switches::kDisableImplSidePainting,
+      cc::switches::kDisableLowLatencyRecovery,
       cc::switches::kDisableMapImage,
+      cc::switches::kDisableOcclusionForTilePrioritization,
       cc::switches::kDisableThreadedAnimation,
       cc::switches::kEnableGpuBenchmarking,
       cc::switches::kEnableGPURasterization,
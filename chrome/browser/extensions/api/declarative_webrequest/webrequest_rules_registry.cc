@@ -87,14 +87,17 @@ std::list<LinkedPtrEventResponseDelta> WebRequestRulesRegistry::CreateDeltas(
   std::set<const WebRequestRule*> matches = GetMatches(request_data);
 
   // Sort all matching rules by their priority so that they can be processed
-  // in decreasing order.
+  // in decreasing order. The rules are kept next to their keys, so that they
+  // need not be looked up again in |webrequest_rules_|.
   typedef std::pair<WebRequestRule::Priority, WebRequestRule::GlobalRuleId>
       PriorityRuleIdPair;
-  std::vector<PriorityRuleIdPair> ordered_matches;
+  typedef std::pair<PriorityRuleIdPair, const WebRequestRule*> OrderedMatch;
+  std::vector<OrderedMatch> ordered_matches;
   ordered_matches.reserve(matches.size());
   for (std::set<const WebRequestRule*>::iterator i = matches.begin();
        i != matches.end(); ++i) {
-    ordered_matches.push_back(make_pair((*i)->priority(), (*i)->id()));
+    ordered_matches.push_back(
+        make_pair(make_pair((*i)->priority(), (*i)->id()), *i));
   }
   // Sort from rbegin to rend in order to get descending priority order.
   std::sort(ordered_matches.rbegin(), ordered_matches.rend());
@@ -108,22 +111,21 @@ std::list<LinkedPtrEventResponseDelta> WebRequestRulesRegistry::CreateDeltas(
   typedef std::map<ExtensionId, std::set<std::string> > IgnoreTags;
   MinPriorities min_priorities;
   IgnoreTags ignore_tags;
-  for (std::vector<PriorityRuleIdPair>::iterator i = ordered_matches.begin();
+  for (std::vector<OrderedMatch>::iterator i = ordered_matches.begin();
        i != ordered_matches.end(); ++i) {
-    const WebRequestRule::GlobalRuleId& rule_id = i->second;
+    const WebRequestRule::GlobalRuleId& rule_id = i->first.second;
     const ExtensionId& extension_id = rule_id.first;
     min_priorities[extension_id] = std::numeric_limits<int>::min();
   }
 
   // Create deltas until we have passed the minimum priority.
   std::list<LinkedPtrEventResponseDelta> result;
-  for (std::vector<PriorityRuleIdPair>::iterator i = ordered_matches.begin();
+  for (std::vector<OrderedMatch>::iterator i = ordered_matches.begin();
        i != ordered_matches.end(); ++i) {
-    const WebRequestRule::Priority priority_of_rule = i->first;
-    const WebRequestRule::GlobalRuleId& rule_id = i->second;
+    const WebRequestRule::Priority priority_of_rule = i->first.first;
+    const WebRequestRule::GlobalRuleId& rule_id = i->first.second;
     const ExtensionId& extension_id = rule_id.first;
-    const WebRequestRule* rule =
-        webrequest_rules_[rule_id.first][rule_id.second].get();
+    const WebRequestRule* rule = i->second;
     CHECK(rule);
 
     // Skip rule if a previous rule of this extension instructed to ignore
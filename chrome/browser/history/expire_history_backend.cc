@@ -14,6 +14,7 @@
 #include "base/files/file_enumerator.h"
 #include "base/logging.h"
 #include "base/message_loop/message_loop.h"
+#include "base/metrics/histogram.h"
 #include "chrome/browser/bookmarks/bookmark_service.h"
 #include "chrome/browser/chrome_notification_types.h"
 #include "chrome/browser/history/archived_database.h"
@@ -616,6 +617,8 @@ bool ExpireHistoryBackend::ArchiveSomeOldHistory(
   if (!main_db_)
     return false;
 
+  base::TimeTicks start_time = base::TimeTicks::Now();
+
   // Add an extra time unit to given end time, because
   // GetAllVisitsInRange, et al. queries' end value is non-inclusive.
   Time effective_end_time =
@@ -667,6 +670,13 @@ bool ExpireHistoryBackend::ArchiveSomeOldHistory(
   // to not do anything if nothing was deleted.
   BroadcastDeleteNotifications(&deleted_dependencies, DELETION_ARCHIVED);
 
+  // Expiring runs on the history thread, so its duration delays the queries
+  // queued behind it.
+  UMA_HISTOGRAM_TIMES("History.ExpireIterationTime",
+                      base::TimeTicks::Now() - start_time);
+  UMA_HISTOGRAM_COUNTS_100("History.ExpiredVisitsPerIteration",
+                           affected_visits.size());
+
   return more_to_expire;
 }
 
@@ -59,6 +59,7 @@
 #include "net/cert/multi_threaded_cert_verifier.h"
 #include "net/cookies/cookie_store.h"
 #include "net/dns/host_cache.h"
+#include "net/dns/host_cache_persister.h"
 #include "net/dns/host_resolver.h"
 #include "net/dns/mapped_host_resolver.h"
 #include "net/dns/mapped_ip_resolver.h"
@@ -411,7 +412,8 @@ IOThread::Globals::Globals()
       http_pipelining_enabled(false),
       testing_fixed_http_port(0),
       testing_fixed_https_port(0),
-      enable_user_alternate_protocol_ports(false) {
+      enable_user_alternate_protocol_ports(false),
+      host_cache_used_off_the_record(false) {
 }
 
 IOThread::Globals::~Globals() {}
@@ -975,6 +977,8 @@ void IOThread::ClearHostCache() {
   net::HostCache* host_cache = globals_->host_resolver->GetHostCache();
   if (host_cache)
     host_cache->clear();
+  if (globals_->host_cache_persister)
+    globals_->host_cache_persister->ScheduleWrite();
 }
 
 void IOThread::InitializeNetworkSessionParams(
@@ -42,6 +42,7 @@ class CertVerifier;
 class CookieStore;
 class CTVerifier;
 class FtpTransactionFactory;
+class HostCachePersister;
 class HostMappingRules;
 class HostResolver;
 class HttpAuthHandlerFactory;
@@ -111,6 +112,9 @@ class IOThread : public content::BrowserThreadDelegate {
     // The "system" NetworkDelegate, used for Profile-agnostic network events.
     scoped_ptr<net::NetworkDelegate> system_network_delegate;
     scoped_ptr<net::HostResolver> host_resolver;
+    // Saves the cache of |host_resolver| across restarts, in the directory of
+    // the first regular profile that is initialized. NULL until then.
+    scoped_ptr<net::HostCachePersister> host_cache_persister;
     scoped_ptr<net::CertVerifier> cert_verifier;
     // The ServerBoundCertService must outlive the HttpTransactionFactory.
     scoped_ptr<net::ServerBoundCertService> system_server_bound_cert_service;
@@ -170,6 +174,9 @@ class IOThread : public content::BrowserThreadDelegate {
     Optional<net::QuicVersionVector> quic_supported_versions;
     Optional<net::HostPortPair> origin_to_force_quic_on;
     bool enable_user_alternate_protocol_ports;
+    // Set once an off-the-record profile uses |host_resolver|. From then on
+    // its cache is not written to disk.
+    bool host_cache_used_off_the_record;
     // NetErrorTabHelper uses |dns_probe_service| to send DNS probes when a
     // main frame load fails with a DNS error in order to provide more useful
     // information to the renderer so it can show a more specific error page.
@@ -4,9 +4,9 @@
 
 #include "chrome/browser/metrics/compression_utils.h"
 
-#include <vector>
-
 #include "base/basictypes.h"
+#include "base/logging.h"
+#include "base/stl_util.h"
 #include "third_party/zlib/zlib.h"
 
 namespace {
@@ -75,18 +75,22 @@ int GzipCompressHelper(Bytef* dest,
 namespace chrome {
 
 bool GzipCompress(const std::string& input, std::string* output) {
-  std::vector<Bytef> compressed_data(kGzipZlibHeaderDifferenceBytes +
-                                     compressBound(input.size()));
+  DCHECK_NE(&input, output);
+
+  // Compress straight into |output| instead of through a temporary buffer,
+  // so that a large log isn't held in memory one extra time.
+  output->resize(kGzipZlibHeaderDifferenceBytes + compressBound(input.size()));
 
-  uLongf compressed_size = compressed_data.size();
-  if (GzipCompressHelper(&compressed_data.front(),
+  uLongf compressed_size = output->size();
+  if (GzipCompressHelper(bit_cast<Bytef*>(string_as_array(output)),
                          &compressed_size,
                          bit_cast<const Bytef*>(input.data()),
-                         input.size()) != Z_OK)
+                         input.size()) != Z_OK) {
+    output->clear();
     return false;
+  }
 
-  compressed_data.resize(compressed_size);
-  output->assign(compressed_data.begin(), compressed_data.end());
+  output->resize(compressed_size);
   return true;
 }
 }  // namespace chrome
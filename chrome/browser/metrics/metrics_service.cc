@@ -1621,7 +1621,7 @@ void MetricsService::PrepareFetchWithStagedLog() {
     current_fetch_->SetRequestContext(
         g_browser_process->system_request_context());
 
-    std::string log_text = log_manager_.staged_log_text();
+    const std::string& log_text = log_manager_.staged_log_text();
     std::string compressed_log_text;
     bool compression_successful = chrome::GzipCompress(log_text,
                                                        &compressed_log_text);
@@ -4,7 +4,6 @@
 
 #include "chrome/browser/net/sqlite_server_bound_cert_store.h"
 
-#include <list>
 #include <set>
 
 #include "base/basictypes.h"
@@ -24,12 +23,14 @@
 #include "sql/meta_table.h"
 #include "sql/statement.h"
 #include "sql/transaction.h"
+#include "sql/write_behind_batch.h"
 #include "third_party/sqlite/sqlite3.h"
 #include "url/gurl.h"
 #include "webkit/browser/quota/special_storage_policy.h"
 
 // This class is designed to be shared between any calling threads and the
-// background task runner. It batches operations and commits them on a timer.
+// background task runner. It batches operations in a sql::WriteBehindBatch,
+// which commits them on a timer.
 class SQLiteServerBoundCertStore::Backend
     : public base::RefCountedThreadSafe<SQLiteServerBoundCertStore::Backend> {
  public:
@@ -38,7 +39,6 @@ class SQLiteServerBoundCertStore::Backend
       const scoped_refptr<base::SequencedTaskRunner>& background_task_runner,
       quota::SpecialStoragePolicy* special_storage_policy)
       : path_(path),
-        num_pending_(0),
         force_keep_session_state_(false),
         background_task_runner_(background_task_runner),
         special_storage_policy_(special_storage_policy),
@@ -70,41 +70,21 @@ class SQLiteServerBoundCertStore::Backend
   // You should call Close() before destructing this object.
   ~Backend() {
     DCHECK(!db_.get()) << "Close should have already been called.";
-    DCHECK(num_pending_ == 0 && pending_.empty());
+    DCHECK(!write_batch_.get());
   }
 
   // Database upgrade statements.
   bool EnsureDatabaseVersion();
 
-  class PendingOperation {
-   public:
-    typedef enum {
-      CERT_ADD,
-      CERT_DELETE
-    } OperationType;
-
-    PendingOperation(
-        OperationType op,
-        const net::DefaultServerBoundCertStore::ServerBoundCert& cert)
-        : op_(op), cert_(cert) {}
-
-    OperationType op() const { return op_; }
-    const net::DefaultServerBoundCertStore::ServerBoundCert& cert() const {
-        return cert_;
-    }
-
-   private:
-    OperationType op_;
-    net::DefaultServerBoundCertStore::ServerBoundCert cert_;
-  };
-
- private:
-  // Batch a server bound cert operation (add or delete).
-  void BatchOperation(
-      PendingOperation::OperationType op,
+  // Queues a server bound cert addition in |write_batch_|.
+  void BatchAddOnDBThread(
       const net::DefaultServerBoundCertStore::ServerBoundCert& cert);
-  // Commit our pending operations to the database.
-  void Commit();
+  // Queues a server bound cert deletion in |write_batch_|.
+  void BatchDeleteOnDBThread(const std::string& server_identifier);
+  // The writes queued by the two methods above.
+  bool AddToDB(const net::DefaultServerBoundCertStore::ServerBoundCert& cert,
+               sql::Connection* db);
+  bool DeleteFromDB(const std::string& server_identifier, sql::Connection* db);
   // Close() executed on the background thread.
   void InternalBackgroundClose();
 
@@ -117,12 +97,11 @@ class SQLiteServerBoundCertStore::Backend
   scoped_ptr<sql::Connection> db_;
   sql::MetaTable meta_table_;
 
-  typedef std::list<PendingOperation*> PendingOperationsList;
-  PendingOperationsList pending_;
-  PendingOperationsList::size_type num_pending_;
+  // The pending writes to |db_|. Only exists while |db_| is open.
+  scoped_ptr<sql::WriteBehindBatch> write_batch_;
   // True if the persistent store should skip clear on exit rules.
   bool force_keep_session_state_;
-  // Guard |pending_|, |num_pending_| and |force_keep_session_state_|.
+  // Guard |force_keep_session_state_|.
   base::Lock lock_;
 
   // Cache of origins we have certificates stored for.
@@ -144,6 +123,11 @@ static const int kCompatibleVersionNumber = 1;
 
 namespace {
 
+// Commit every 30 seconds.
+const int kCommitIntervalMs = 30 * 1000;
+// Commit right away if we have more than 512 outstanding operations.
+const size_t kCommitAfterBatchSize = 512;
+
 // Initializes the certs table, returning true on success.
 bool InitTable(sql::Connection* db) {
   // The table is named "origin_bound_certs" for backwards compatability before
@@ -258,6 +242,11 @@ void SQLiteServerBoundCertStore::Backend::LoadOnDBThread(
     certs->push_back(cert.release());
   }
 
+  write_batch_.reset(new sql::WriteBehindBatch(
+      db_.get(), background_task_runner_,
+      base::TimeDelta::FromMilliseconds(kCommitIntervalMs),
+      kCommitAfterBatchSize));
+
   UMA_HISTOGRAM_COUNTS_10000("DomainBoundCerts.DBLoadedCount", certs->size());
   base::TimeDelta load_time = base::TimeTicks::Now() - start;
   UMA_HISTOGRAM_CUSTOM_TIMES("DomainBoundCerts.DBLoadTime",
@@ -427,119 +416,95 @@ void SQLiteServerBoundCertStore::Backend::KillDatabase() {
     bool success = db_->RazeAndClose();
     UMA_HISTOGRAM_BOOLEAN("DomainBoundCerts.KillDatabaseResult", success);
     meta_table_.Reset();
+    // The pending writes are dropped, as |db_| is closed.
+    write_batch_.reset();
     db_.reset();
   }
 }
 
 void SQLiteServerBoundCertStore::Backend::AddServerBoundCert(
     const net::DefaultServerBoundCertStore::ServerBoundCert& cert) {
-  BatchOperation(PendingOperation::CERT_ADD, cert);
+  // We do a full copy of the cert here, and hopefully just here.
+  background_task_runner_->PostTask(
+      FROM_HERE, base::Bind(&Backend::BatchAddOnDBThread, this, cert));
 }
 
 void SQLiteServerBoundCertStore::Backend::DeleteServerBoundCert(
     const net::DefaultServerBoundCertStore::ServerBoundCert& cert) {
-  BatchOperation(PendingOperation::CERT_DELETE, cert);
+  background_task_runner_->PostTask(
+      FROM_HERE, base::Bind(&Backend::BatchDeleteOnDBThread, this,
+                            cert.server_identifier()));
 }
 
-void SQLiteServerBoundCertStore::Backend::BatchOperation(
-    PendingOperation::OperationType op,
+void SQLiteServerBoundCertStore::Backend::BatchAddOnDBThread(
     const net::DefaultServerBoundCertStore::ServerBoundCert& cert) {
-  // Commit every 30 seconds.
-  static const int kCommitIntervalMs = 30 * 1000;
-  // Commit right away if we have more than 512 outstanding operations.
-  static const size_t kCommitAfterBatchSize = 512;
-
-  // We do a full copy of the cert here, and hopefully just here.
-  scoped_ptr<PendingOperation> po(new PendingOperation(op, cert));
+  DCHECK(background_task_runner_->RunsTasksOnCurrentThread());
 
-  PendingOperationsList::size_type num_pending;
-  {
-    base::AutoLock locked(lock_);
-    pending_.push_back(po.release());
-    num_pending = ++num_pending_;
-  }
+  // Maybe the database failed to load or we are already Close()'ed.
+  if (!write_batch_.get())
+    return;
 
-  if (num_pending == 1) {
-    // We've gotten our first entry for this batch, fire off the timer.
-    background_task_runner_->PostDelayedTask(
-        FROM_HERE,
-        base::Bind(&Backend::Commit, this),
-        base::TimeDelta::FromMilliseconds(kCommitIntervalMs));
-  } else if (num_pending == kCommitAfterBatchSize) {
-    // We've reached a big enough batch, fire off a commit now.
-    background_task_runner_->PostTask(FROM_HERE,
-                                      base::Bind(&Backend::Commit, this));
-  }
+  // Unretained, since |write_batch_| is owned by this.
+  write_batch_->Write(cert.server_identifier(),
+                      base::Bind(&Backend::AddToDB, base::Unretained(this),
+                                 cert));
 }
 
-void SQLiteServerBoundCertStore::Backend::Commit() {
+void SQLiteServerBoundCertStore::Backend::BatchDeleteOnDBThread(
+    const std::string& server_identifier) {
   DCHECK(background_task_runner_->RunsTasksOnCurrentThread());
 
-  PendingOperationsList ops;
-  {
-    base::AutoLock locked(lock_);
-    pending_.swap(ops);
-    num_pending_ = 0;
-  }
-
-  // Maybe an old timer fired or we are already Close()'ed.
-  if (!db_.get() || ops.empty())
+  if (!write_batch_.get())
     return;
 
-  sql::Statement add_smt(db_->GetCachedStatement(SQL_FROM_HERE,
-      "INSERT INTO origin_bound_certs (origin, private_key, cert, cert_type, "
-      "expiration_time, creation_time) VALUES (?,?,?,?,?,?)"));
+  write_batch_->Write(server_identifier,
+                      base::Bind(&Backend::DeleteFromDB,
+                                 base::Unretained(this), server_identifier));
+}
+
+bool SQLiteServerBoundCertStore::Backend::AddToDB(
+    const net::DefaultServerBoundCertStore::ServerBoundCert& cert,
+    sql::Connection* db) {
+  // An add can replace a delete of the same origin in |write_batch_|, so the
+  // origin may still have a row.
+  sql::Statement add_smt(db->GetCachedStatement(SQL_FROM_HERE,
+      "INSERT OR REPLACE INTO origin_bound_certs (origin, private_key, cert, "
+      "cert_type, expiration_time, creation_time) VALUES (?,?,?,?,?,?)"));
   if (!add_smt.is_valid())
-    return;
+    return false;
 
-  sql::Statement del_smt(db_->GetCachedStatement(SQL_FROM_HERE,
+  cert_origins_.insert(cert.server_identifier());
+  add_smt.BindString(0, cert.server_identifier());
+  const std::string& private_key = cert.private_key();
+  add_smt.BindBlob(1, private_key.data(), private_key.size());
+  const std::string& cert_data = cert.cert();
+  add_smt.BindBlob(2, cert_data.data(), cert_data.size());
+  add_smt.BindInt(3, net::CLIENT_CERT_ECDSA_SIGN);
+  add_smt.BindInt64(4, cert.expiration_time().ToInternalValue());
+  add_smt.BindInt64(5, cert.creation_time().ToInternalValue());
+  // As before, a failure doesn't roll back the other certs.
+  if (!add_smt.Run())
+    NOTREACHED() << "Could not add a server bound cert to the DB.";
+  return true;
+}
+
+bool SQLiteServerBoundCertStore::Backend::DeleteFromDB(
+    const std::string& server_identifier,
+    sql::Connection* db) {
+  sql::Statement del_smt(db->GetCachedStatement(SQL_FROM_HERE,
                              "DELETE FROM origin_bound_certs WHERE origin=?"));
   if (!del_smt.is_valid())
-    return;
-
-  sql::Transaction transaction(db_.get());
-  if (!transaction.Begin())
-    return;
+    return false;
 
-  for (PendingOperationsList::iterator it = ops.begin();
-       it != ops.end(); ++it) {
-    // Free the certs as we commit them to the database.
-    scoped_ptr<PendingOperation> po(*it);
-    switch (po->op()) {
-      case PendingOperation::CERT_ADD: {
-        cert_origins_.insert(po->cert().server_identifier());
-        add_smt.Reset(true);
-        add_smt.BindString(0, po->cert().server_identifier());
-        const std::string& private_key = po->cert().private_key();
-        add_smt.BindBlob(1, private_key.data(), private_key.size());
-        const std::string& cert = po->cert().cert();
-        add_smt.BindBlob(2, cert.data(), cert.size());
-        add_smt.BindInt(3, net::CLIENT_CERT_ECDSA_SIGN);
-        add_smt.BindInt64(4, po->cert().expiration_time().ToInternalValue());
-        add_smt.BindInt64(5, po->cert().creation_time().ToInternalValue());
-        if (!add_smt.Run())
-          NOTREACHED() << "Could not add a server bound cert to the DB.";
-        break;
-      }
-      case PendingOperation::CERT_DELETE:
-        cert_origins_.erase(po->cert().server_identifier());
-        del_smt.Reset(true);
-        del_smt.BindString(0, po->cert().server_identifier());
-        if (!del_smt.Run())
-          NOTREACHED() << "Could not delete a server bound cert from the DB.";
-        break;
-
-      default:
-        NOTREACHED();
-        break;
-    }
-  }
-  transaction.Commit();
+  cert_origins_.erase(server_identifier);
+  del_smt.BindString(0, server_identifier);
+  if (!del_smt.Run())
+    NOTREACHED() << "Could not delete a server bound cert from the DB.";
+  return true;
 }
 
-// Fire off a close message to the background thread. We could still have a
-// pending commit timer that will be holding a reference on us, but if/when
-// this fires we will already have been cleaned up and it will be ignored.
+// Fire off a close message to the background thread. The pending commit timer,
+// if any, belongs to |write_batch_| and is cancelled along with it there.
 void SQLiteServerBoundCertStore::Backend::Close() {
   // Must close the backend on the background thread.
   background_task_runner_->PostTask(
@@ -549,7 +514,7 @@ void SQLiteServerBoundCertStore::Backend::Close() {
 void SQLiteServerBoundCertStore::Backend::InternalBackgroundClose() {
   DCHECK(background_task_runner_->RunsTasksOnCurrentThread());
   // Commit any pending operations
-  Commit();
+  write_batch_.reset();
 
   if (!force_keep_session_state_ &&
       special_storage_policy_.get() &&
@@ -158,6 +158,53 @@ TEST_F(SQLiteServerBoundCertStoreTest, TestPersistence) {
   ASSERT_EQ(0U, certs.size());
 }
 
+// Test that operations on the same origin between two commits leave the
+// database as if each of them had been committed.
+TEST_F(SQLiteServerBoundCertStoreTest, TestReplaceBeforeCommit) {
+  // Write google.com to disk first.
+  ScopedVector<net::DefaultServerBoundCertStore::ServerBoundCert> certs;
+  store_ = NULL;
+  base::RunLoop().RunUntilIdle();
+  store_ = new SQLiteServerBoundCertStore(
+      temp_dir_.path().Append(chrome::kOBCertFilename),
+      base::MessageLoopProxy::current(),
+      NULL);
+  Load(&certs);
+  ASSERT_EQ(1U, certs.size());
+
+  // Replace the existing google.com cert, and add and then remove foo.com.
+  store_->DeleteServerBoundCert(*certs[0]);
+  store_->AddServerBoundCert(
+      net::DefaultServerBoundCertStore::ServerBoundCert(
+          "google.com",
+          base::Time::FromInternalValue(5),
+          base::Time::FromInternalValue(6),
+          "e", "f"));
+  net::DefaultServerBoundCertStore::ServerBoundCert foo_cert(
+      "foo.com",
+      base::Time::FromInternalValue(3),
+      base::Time::FromInternalValue(4),
+      "c", "d");
+  store_->AddServerBoundCert(foo_cert);
+  store_->DeleteServerBoundCert(foo_cert);
+
+  store_ = NULL;
+  base::RunLoop().RunUntilIdle();
+  certs.clear();
+  store_ = new SQLiteServerBoundCertStore(
+      temp_dir_.path().Append(chrome::kOBCertFilename),
+      base::MessageLoopProxy::current(),
+      NULL);
+
+  Load(&certs);
+  ASSERT_EQ(1U, certs.size());
+  ASSERT_EQ("google.com", certs[0]->server_identifier());
+  ASSERT_STREQ("e", certs[0]->private_key().c_str());
+  ASSERT_STREQ("f", certs[0]->cert().c_str());
+  ASSERT_EQ(5, certs[0]->creation_time().ToInternalValue());
+  ASSERT_EQ(6, certs[0]->expiration_time().ToInternalValue());
+}
+
 TEST_F(SQLiteServerBoundCertStoreTest, TestUpgradeV1) {
   // Reset the store.  We'll be using a different database for this test.
   store_ = NULL;
@@ -28,6 +28,7 @@
 #include "content/public/browser/resource_context.h"
 #include "extensions/common/constants.h"
 #include "extensions/common/extension.h"
+#include "net/dns/host_cache_persister.h"
 #include "net/ftp/ftp_network_layer.h"
 #include "net/http/http_cache.h"
 #include "net/http/http_network_session.h"
@@ -178,6 +179,10 @@ void OffTheRecordProfileIOData::InitializeInternal(
 
   main_context->set_host_resolver(
       io_thread_globals->host_resolver.get());
+  // The hosts resolved for this profile must not be saved to disk.
+  io_thread_globals->host_cache_used_off_the_record = true;
+  if (io_thread_globals->host_cache_persister)
+    io_thread_globals->host_cache_persister->StopWriting();
   main_context->set_http_auth_handler_factory(
       io_thread_globals->http_auth_handler_factory.get());
   main_context->set_fraudulent_certificate_reporter(
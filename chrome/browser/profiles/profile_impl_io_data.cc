@@ -40,6 +40,9 @@
 #include "content/public/browser/storage_partition.h"
 #include "extensions/common/constants.h"
 #include "net/base/cache_type.h"
+#include "net/dns/host_cache.h"
+#include "net/dns/host_cache_persister.h"
+#include "net/dns/host_resolver.h"
 #include "net/ftp/ftp_network_layer.h"
 #include "net/http/http_cache.h"
 #include "net/ssl/server_bound_cert_service.h"
@@ -371,6 +374,13 @@ void ProfileImplIOData::InitializeInternal(
 
   main_context->set_host_resolver(
       io_thread_globals->host_resolver.get());
+  net::HostCache* host_cache = io_thread_globals->host_resolver->GetHostCache();
+  if (host_cache && !io_thread_globals->host_cache_persister &&
+      !io_thread_globals->host_cache_used_off_the_record) {
+    io_thread_globals->host_cache_persister.reset(new net::HostCachePersister(
+        host_cache, profile_params->path,
+        BrowserThread::GetMessageLoopProxyForThread(BrowserThread::FILE)));
+  }
   main_context->set_cert_transparency_verifier(
       io_thread_globals->cert_transparency_verifier.get());
   main_context->set_http_auth_handler_factory(
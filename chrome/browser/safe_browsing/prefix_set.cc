@@ -79,6 +79,13 @@ PrefixSet::PrefixSet(const std::vector<SBPrefix>& sorted_prefixes) {
       prev_prefix = sorted_prefixes[i];
     }
 
+    // The set stays in memory for the whole session, so release the excess
+    // capacity left by the estimates above.  |index_| grew past its
+    // reservation by doubling, and |deltas_| reserved room for the
+    // duplicates and the forced breaks.
+    IndexVector(index_).swap(index_);
+    std::vector<uint16>(deltas_).swap(deltas_);
+
     // Send up some memory-usage stats.  Bits because fractional bytes
     // are weird.
     const size_t bits_used = index_.size() * sizeof(index_[0]) * CHAR_BIT +
@@ -189,6 +189,11 @@ bool MatchAddPrefixes(SafeBrowsingStore* store,
   return found_match;
 }
 
+// For |std::lower_bound()| to find a prefix in a vector of full hashes.
+bool SBAddFullHashPrefixBefore(const SBAddFullHash& hash, SBPrefix prefix) {
+  return hash.full_hash.prefix < prefix;
+}
+
 // Find the entries in |full_hashes| with prefix in |prefix_hits|, and
 // add them to |full_hits| if not expired.  "Not expired" is when
 // either |last_update| was recent enough, or the item has been
@@ -211,7 +216,10 @@ void GetCachedFullHashesForBrowse(const std::vector<SBPrefix>& prefix_hits,
     if (*piter < hiter->full_hash.prefix) {
       ++piter;
     } else if (hiter->full_hash.prefix < *piter) {
-      ++hiter;
+      // |full_hashes| is usually far larger than |prefix_hits|, so skip ahead
+      // with a binary search rather than one entry at a time.
+      hiter = std::lower_bound(hiter, full_hashes.end(), *piter,
+                               SBAddFullHashPrefixBefore);
     } else {
       if (expire_time < last_update ||
           expire_time.ToTimeT() < hiter->received) {
@@ -221,11 +229,11 @@ void GetCachedFullHashesForBrowse(const std::vector<SBPrefix>& prefix_hits,
                list_bit == safe_browsing_util::PHISH);
         const safe_browsing_util::ListType list_id =
             static_cast<safe_browsing_util::ListType>(list_bit);
-        if (!safe_browsing_util::GetListName(list_id, &result.list_name))
-          continue;
-        result.add_chunk_id = DecodeChunkId(hiter->chunk_id);
-        result.hash = hiter->full_hash;
-        full_hits->push_back(result);
+        if (safe_browsing_util::GetListName(list_id, &result.list_name)) {
+          result.add_chunk_id = DecodeChunkId(hiter->chunk_id);
+          result.hash = hiter->full_hash;
+          full_hits->push_back(result);
+        }
       }
 
       // Only increment |hiter|, |piter| might have multiple hits.
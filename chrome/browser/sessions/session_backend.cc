@@ -198,6 +198,22 @@ static const char* kLastTabSessionFileName = "Last Tabs";
 static const char* kCurrentSessionFileName = "Current Session";
 static const char* kLastSessionFileName = "Last Session";
 
+// Commands are written to the file in batches of at least this many bytes,
+// rather than with several writes per command.
+static const size_t kFileWriteBufferSize = 64 * 1024;
+
+// Writes all of |data| to |file|. Returns false on error.
+static bool WriteBufferToFile(net::FileStream* file, const std::string& data) {
+  if (data.empty())
+    return true;
+  int wrote = file->WriteSync(data.data(), static_cast<int>(data.size()));
+  if (wrote != static_cast<int>(data.size())) {
+    NOTREACHED() << "error writing";
+    return false;
+  }
+  return true;
+}
+
 // static
 const int SessionBackend::kFileReadBufferSize = 1024;
 
@@ -306,42 +322,39 @@ bool SessionBackend::ReadCurrentSessionCommandsImpl(
 
 bool SessionBackend::AppendCommandsToFile(net::FileStream* file,
     const std::vector<SessionCommand*>& commands) {
+  // Rewriting a session with many tabs produces thousands of small commands,
+  // so they are serialized into a buffer that is written out in large chunks.
+  std::string data;
+  data.reserve(kFileWriteBufferSize);
   for (std::vector<SessionCommand*>::const_iterator i = commands.begin();
        i != commands.end(); ++i) {
-    int wrote;
     const size_type content_size = static_cast<size_type>((*i)->size());
     const size_type total_size =  content_size + sizeof(id_type);
     if (type_ == BaseSessionService::TAB_RESTORE)
       UMA_HISTOGRAM_COUNTS("TabRestore.command_size", total_size);
     else
       UMA_HISTOGRAM_COUNTS("SessionRestore.command_size", total_size);
-    wrote = file->WriteSync(reinterpret_cast<const char*>(&total_size),
-                            sizeof(total_size));
-    if (wrote != sizeof(total_size)) {
-      NOTREACHED() << "error writing";
-      return false;
-    }
+    data.append(reinterpret_cast<const char*>(&total_size),
+                sizeof(total_size));
     id_type command_id = (*i)->id();
-    wrote = file->WriteSync(reinterpret_cast<char*>(&command_id),
-                            sizeof(command_id));
-    if (wrote != sizeof(command_id)) {
-      NOTREACHED() << "error writing";
-      return false;
-    }
-    if (content_size > 0) {
-      wrote = file->WriteSync(reinterpret_cast<char*>((*i)->contents()),
-                              content_size);
-      if (wrote != content_size) {
-        NOTREACHED() << "error writing";
+    data.append(reinterpret_cast<const char*>(&command_id),
+                sizeof(command_id));
+    if (content_size > 0)
+      data.append((*i)->contents(), content_size);
+
+    if (data.size() >= kFileWriteBufferSize) {
+      if (!WriteBufferToFile(file, data))
         return false;
-      }
+      data.clear();
     }
+  }
+  if (!WriteBufferToFile(file, data))
+    return false;
 #if defined(OS_CHROMEOS)
-    // TODO(gspencer): Remove this once we find a better place to do it.
-    // See issue http://crbug.com/245015
-    file->FlushSync();
+  // TODO(gspencer): Remove this once we find a better place to do it.
+  // See issue http://crbug.com/245015
+  file->FlushSync();
 #endif
-  }
   return true;
 }
 
@@ -322,6 +322,18 @@ void TabLoader::Observe(int type,
       RenderWidgetHost* render_widget_host = GetRenderWidgetHost(tab);
       DCHECK(render_widget_host);
       render_widget_hosts_loading_.insert(render_widget_host);
+
+      // A tab can start loading before its turn, e.g. when the user selects
+      // it. Track it as loading so that LoadNextTab() doesn't spend a turn
+      // (and a force load delay) on it later.
+      TabsToLoad::iterator queued =
+          std::find(tabs_to_load_.begin(), tabs_to_load_.end(), tab);
+      if (queued != tabs_to_load_.end()) {
+        tabs_to_load_.erase(queued);
+        tabs_loading_.insert(tab);
+        if (tabs_loading_.size() > max_parallel_tab_loads_)
+          max_parallel_tab_loads_ = tabs_loading_.size();
+      }
       break;
     }
     case content::NOTIFICATION_WEB_CONTENTS_DESTROYED: {
@@ -7,6 +7,8 @@
 #include <errno.h>
 #include <stdlib.h>
 
+#include <set>
+
 #if defined(OS_POSIX)
 #include <unistd.h>
 #endif
@@ -16,6 +18,7 @@
 #include "base/memory/scoped_ptr.h"
 #include "base/message_loop/message_loop.h"
 #include "base/rand_util.h"
+#include "base/synchronization/lock.h"
 #include "components/nacl/common/nacl_messages.h"
 #include "components/nacl/loader/nacl_ipc_adapter.h"
 #include "components/nacl/loader/nacl_validation_db.h"
@@ -140,6 +143,15 @@ class BrowserValidationDBProxy : public NaClValidationDB {
   }
 
   virtual bool QueryKnownToValidate(const std::string& signature) OVERRIDE {
+    // The same code is often validated more than once per process, e.g. when
+    // a shared library is mapped again.  Answer those queries locally instead
+    // of blocking on a round trip to the browser.
+    {
+      base::AutoLock lock(known_to_validate_lock_);
+      if (known_to_validate_.count(signature))
+        return true;
+    }
+
     // Initialize to false so that if the Send fails to write to the return
     // value we're safe.  For example if the message is (for some reason)
     // dispatched as an async message the return parameter will not be written.
@@ -149,10 +161,13 @@ class BrowserValidationDBProxy : public NaClValidationDB {
       LOG(ERROR) << "Failed to query NaCl validation cache.";
       result = false;
     }
+    if (result)
+      RememberKnownToValidate(signature);
     return result;
   }
 
   virtual void SetKnownToValidate(const std::string& signature) OVERRIDE {
+    RememberKnownToValidate(signature);
     // Caching is optional: NaCl will still work correctly if the IPC fails.
     if (!listener_->Send(new NaClProcessMsg_SetKnownToValidate(signature))) {
       LOG(ERROR) << "Failed to update NaCl validation cache.";
@@ -192,8 +207,18 @@ class BrowserValidationDBProxy : public NaClValidationDB {
   }
 
  private:
+  void RememberKnownToValidate(const std::string& signature) {
+    base::AutoLock lock(known_to_validate_lock_);
+    known_to_validate_.insert(signature);
+  }
+
   // The listener never dies, otherwise this might be a dangling reference.
   NaClListener* listener_;
+
+  // Signatures this process has already found or marked valid.  Queries can
+  // come from any thread that maps code, so the set is guarded by a lock.
+  base::Lock known_to_validate_lock_;
+  std::set<std::string> known_to_validate_;
 };
 
 
@@ -60,6 +60,16 @@ void AsyncPolicyLoader::Reload(bool force) {
   // Filter out mismatching policies.
   schema_map_->FilterBundle(bundle.get());
 
+  // Periodic reloads and change notifications usually find the same policies.
+  // Don't make the provider merge and broadcast them again in that case.
+  // Forced reloads always go through, since RefreshPolicies() promises an
+  // update notification.
+  if (!force && last_bundle_ && bundle->Equals(*last_bundle_)) {
+    ScheduleNextReload(TimeDelta::FromSeconds(kReloadIntervalSeconds));
+    return;
+  }
+  RememberBundle(*bundle);
+
   update_callback_.Run(bundle.Pass());
   ScheduleNextReload(TimeDelta::FromSeconds(kReloadIntervalSeconds));
 }
@@ -74,6 +84,7 @@ scoped_ptr<PolicyBundle> AsyncPolicyLoader::InitialLoad(
   scoped_ptr<PolicyBundle> bundle(Load());
   // Filter out mismatching policies.
   schema_map_->FilterBundle(bundle.get());
+  RememberBundle(*bundle);
   return bundle.Pass();
 }
 
@@ -100,6 +111,12 @@ void AsyncPolicyLoader::RefreshPolicies(scoped_refptr<SchemaMap> schema_map) {
   Reload(true);
 }
 
+void AsyncPolicyLoader::RememberBundle(const PolicyBundle& bundle) {
+  if (!last_bundle_)
+    last_bundle_.reset(new PolicyBundle);
+  last_bundle_->CopyFrom(bundle);
+}
+
 void AsyncPolicyLoader::ScheduleNextReload(TimeDelta delay) {
   DCHECK(task_runner_->RunsTasksOnCurrentThread());
   weak_factory_.InvalidateWeakPtrs();
@@ -84,6 +84,9 @@ class POLICY_EXPORT AsyncPolicyLoader {
   // Used by the AsyncPolicyProvider to reload with an updated SchemaMap.
   void RefreshPolicies(scoped_refptr<SchemaMap> schema_map);
 
+  // Keeps a copy of |bundle| as the last policies passed to the provider.
+  void RememberBundle(const PolicyBundle& bundle);
+
   // Cancels any pending periodic reload and posts one |delay| time units from
   // now.
   void ScheduleNextReload(base::TimeDelta delay);
@@ -114,6 +117,10 @@ class POLICY_EXPORT AsyncPolicyLoader {
   // The current policy schemas that this provider should load.
   scoped_refptr<SchemaMap> schema_map_;
 
+  // The policies last passed to the provider, used to skip reloads that
+  // didn't change anything.
+  scoped_ptr<PolicyBundle> last_bundle_;
+
   DISALLOW_COPY_AND_ASSIGN(AsyncPolicyLoader);
 };
 
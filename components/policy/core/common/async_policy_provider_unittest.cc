@@ -203,6 +203,34 @@ TEST_F(AsyncPolicyProviderTest, RefreshPoliciesDuringReload) {
   provider_->RemoveObserver(&observer);
 }
 
+TEST_F(AsyncPolicyProviderTest, UnchangedReloadIsNotPropagated) {
+  PolicyBundle reloaded_bundle;
+  SetPolicy(&reloaded_bundle, "policy", "reloaded");
+
+  Sequence load_sequence;
+  EXPECT_CALL(*loader_, MockLoad()).InSequence(load_sequence)
+                                   .WillOnce(Return(&initial_bundle_));
+  EXPECT_CALL(*loader_, MockLoad()).InSequence(load_sequence)
+                                   .WillOnce(Return(&reloaded_bundle));
+
+  MockConfigurationPolicyObserver observer;
+  provider_->AddObserver(&observer);
+
+  // Reloading the same policies doesn't notify again.
+  EXPECT_CALL(observer, OnUpdatePolicy(provider_.get())).Times(0);
+  loader_->Reload(false);
+  loop_.RunUntilIdle();
+  Mock::VerifyAndClearExpectations(&observer);
+
+  // A change is still propagated.
+  EXPECT_CALL(observer, OnUpdatePolicy(provider_.get())).Times(1);
+  loader_->Reload(false);
+  loop_.RunUntilIdle();
+  EXPECT_TRUE(provider_->policies().Equals(reloaded_bundle));
+  Mock::VerifyAndClearExpectations(&observer);
+  provider_->RemoveObserver(&observer);
+}
+
 TEST_F(AsyncPolicyProviderTest, Shutdown) {
   EXPECT_CALL(*loader_, MockLoad()).WillRepeatedly(Return(&initial_bundle_));
 
@@ -122,6 +122,8 @@ PrecacheFetcher::Fetcher::Fetcher(
   url_fetcher_.reset(URLFetcher::Create(url, URLFetcher::GET, this));
   url_fetcher_->SetRequestContext(request_context);
   url_fetcher_->SetLoadFlags(net::LOAD_DO_NOT_PROMPT_FOR_LOGIN);
+  // Precaching must not slow down the loads of the user.
+  url_fetcher_->SetPriority(net::IDLE);
   url_fetcher_->Start();
 }
 
@@ -81,6 +81,9 @@ void LogUploader::StartScheduledUpload() {
   // client-side as well.
   current_fetch_->SetLoadFlags(net::LOAD_DO_NOT_SAVE_COOKIES |
                                net::LOAD_DO_NOT_SEND_COOKIES);
+  // Uploads are background work, and must not slow down the loads of the
+  // user.
+  current_fetch_->SetPriority(net::IDLE);
   current_fetch_->Start();
 }
 
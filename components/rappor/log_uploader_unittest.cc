@@ -138,6 +138,20 @@ TEST_F(LogUploaderTest, Failure) {
   EXPECT_EQ(uploader.last_interval_set(), base::TimeDelta());
 }
 
+// Uploads are background work, and should yield to the loads of the user.
+TEST(LogUploaderPriorityTest, UploadsAtIdlePriority) {
+  base::MessageLoopForUI loop;
+  scoped_refptr<net::TestURLRequestContextGetter> request_context(
+      new net::TestURLRequestContextGetter(base::MessageLoopProxy::current()));
+  net::TestURLFetcherFactory factory;
+  TestLogUploader uploader(request_context);
+
+  uploader.QueueLog("log1");
+  net::TestURLFetcher* fetcher = factory.GetFetcherByID(0);
+  ASSERT_TRUE(fetcher);
+  EXPECT_EQ(net::IDLE, fetcher->priority());
+}
+
 TEST_F(LogUploaderTest, Backoff) {
   base::TimeDelta current = base::TimeDelta();
   base::TimeDelta next = base::TimeDelta::FromSeconds(1);
@@ -25,6 +25,11 @@
 
 namespace {
 
+// The maximum number of characters of the page text given to CLD. Its result
+// is settled well before that, and the rest of the text would only add to the
+// time spent on the renderer main thread.
+const size_t kMaxDetectionChars = 16 * 1024;
+
 // Similar language code list. Some languages are very similar and difficult
 // for CLD to distinguish.
 struct SimilarLanguageCode {
@@ -85,8 +90,16 @@ int GetCLDMajorVersion() {
 // Returns the ISO 639 language code of the specified |text|, or 'unknown' if it
 // failed.
 // |is_cld_reliable| will be set as true if CLD says the detection is reliable.
-std::string DetermineTextLanguage(const base::string16& text,
+std::string DetermineTextLanguage(const base::string16& full_text,
                                   bool* is_cld_reliable) {
+  // Only look at the beginning of long texts, ending at a word boundary.
+  base::string16 text(full_text, 0, kMaxDetectionChars);
+  if (text.size() < full_text.size()) {
+    size_t last_space_index = text.find_last_of(base::kWhitespaceUTF16);
+    if (last_space_index != base::string16::npos)
+      text.resize(last_space_index);
+  }
+
   std::string language = translate::kUnknownLanguageCode;
   int text_bytes = 0;
   bool is_reliable = false;
@@ -171,3 +171,28 @@ TEST_F(LanguageDetectionUtilTest, AdoptHtmlLang) {
   EXPECT_EQ("en", cld_language);
   EXPECT_TRUE(is_cld_reliable);
 }
+
+// Tests that only the beginning of a long text is given to CLD: a text that
+// starts with more English than CLD looks at, followed by much more German, is
+// detected as English.
+TEST_F(LanguageDetectionUtilTest, LongText) {
+  base::string16 english = base::ASCIIToUTF16(
+      "This is a page apparently written in English, and it is very long. ");
+  base::string16 german = base::ASCIIToUTF16(
+      "Dies ist eine Seite, die offenbar auf Deutsch geschrieben wurde. ");
+  base::string16 contents;
+  while (contents.size() < 16 * 1024)
+    contents += english;
+  while (contents.size() < 64 * 1024)
+    contents += german;
+  std::string cld_language;
+  bool is_cld_reliable;
+  std::string language = translate::DeterminePageLanguage(std::string(),
+                                                          std::string(),
+                                                          contents,
+                                                          &cld_language,
+                                                          &is_cld_reliable);
+  EXPECT_EQ("en", language);
+  EXPECT_EQ("en", cld_language);
+  EXPECT_TRUE(is_cld_reliable);
+}
@@ -115,11 +115,11 @@ bool SubstringSetMatcher::Match(const std::string& text,
 
   uint32 current_node = 0;
   for (std::string::const_iterator i = text.begin(); i != text.end(); ++i) {
-    uint32 edge_from_current = tree_[current_node].GetEdge(*i);
+    uint32 edge_from_current = GetEdge(current_node, *i);
     while (edge_from_current == AhoCorasickNode::kNoSuchEdge &&
            current_node != 0) {
       current_node = tree_[current_node].failure();
-      edge_from_current = tree_[current_node].GetEdge(*i);
+      edge_from_current = GetEdge(current_node, *i);
     }
     if (edge_from_current != AhoCorasickNode::kNoSuchEdge) {
       current_node = edge_from_current;
@@ -155,6 +155,7 @@ void SubstringSetMatcher::RebuildAhoCorasickTree(
   }
 
   CreateFailureEdges();
+  CreateRootEdges();
 }
 
 void SubstringSetMatcher::InsertPatternIntoAhoCorasickTree(
@@ -229,6 +230,16 @@ void SubstringSetMatcher::CreateFailureEdges() {
   }
 }
 
+void SubstringSetMatcher::CreateRootEdges() {
+  typedef AhoCorasickNode::Edges Edges;
+
+  std::fill(root_edges_, root_edges_ + arraysize(root_edges_),
+            AhoCorasickNode::kNoSuchEdge);
+  const Edges& edges = tree_[0].edges();
+  for (Edges::const_iterator e = edges.begin(); e != edges.end(); ++e)
+    root_edges_[static_cast<unsigned char>(e->first)] = e->second;
+}
+
 const uint32 SubstringSetMatcher::AhoCorasickNode::kNoSuchEdge = ~0;
 
 SubstringSetMatcher::AhoCorasickNode::AhoCorasickNode()
@@ -126,6 +126,16 @@ class URL_MATCHER_EXPORT SubstringSetMatcher {
   void InsertPatternIntoAhoCorasickTree(const StringPattern* pattern);
   void CreateFailureEdges();
 
+  // Fills |root_edges_| from the edges of the root node.
+  void CreateRootEdges();
+
+  // Returns the node that the edge labeled |c| leads to from |node|, or
+  // AhoCorasickNode::kNoSuchEdge.
+  uint32 GetEdge(uint32 node, char c) const {
+    return node == 0 ? root_edges_[static_cast<unsigned char>(c)]
+                     : tree_[node].GetEdge(c);
+  }
+
   // Set of all registered StringPatterns. Used to regenerate the
   // Aho-Corasick tree in case patterns are registered or unregistered.
   SubstringPatternMap patterns_;
@@ -133,6 +143,11 @@ class URL_MATCHER_EXPORT SubstringSetMatcher {
   // The nodes of a Aho-Corasick tree.
   std::vector<AhoCorasickNode> tree_;
 
+  // The edges of the root node, indexed by their label. Matching falls back
+  // to the root for most characters of a text, so they are looked up without
+  // searching the map of edges.
+  uint32 root_edges_[256];
+
   DISALLOW_COPY_AND_ASSIGN(SubstringSetMatcher);
 };
 
@@ -167,4 +167,13 @@ TEST(SubstringSetMatcherTest, TestEmptyMatcher) {
   EXPECT_TRUE(matches.empty());
 }
 
+TEST(SubstringSetMatcherTest, TestNonASCIIPatterns) {
+  // Characters with the high bit set are looked up from the root like any
+  // other.
+  TestOnePattern("a\xc3\xa9b", "\xc3\xa9", true);
+  TestOnePattern("\xc3\xa9", "\xc3\xa8", false);
+  TestOnePattern("\xff\xff", "\xff", true);
+  TestTwoPatterns("x\x80y\xffz", "\x80y", "\xffz", true, true);
+}
+
 }  // namespace url_matcher
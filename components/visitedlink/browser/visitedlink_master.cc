@@ -19,6 +19,7 @@
 #include "base/file_util.h"
 #include "base/logging.h"
 #include "base/message_loop/message_loop.h"
+#include "base/metrics/histogram.h"
 #include "base/path_service.h"
 #include "base/rand_util.h"
 #include "base/strings/string_util.h"
@@ -762,6 +763,10 @@ void VisitedLinkMaster::ResizeTable(int32 new_size) {
   DebugValidate();
 #endif
 
+  // Every insertion is blocked while the table is rebuilt, and every renderer
+  // has to map the new table afterwards, so keep track of how long it takes.
+  base::TimeTicks start_time = base::TimeTicks::Now();
+
   base::SharedMemory* old_shared_memory = shared_memory_;
   Fingerprint* old_hash_table = hash_table_;
   int32 old_table_length = table_length_;
@@ -780,6 +785,10 @@ void VisitedLinkMaster::ResizeTable(int32 new_size) {
   // else to release it.
   delete old_shared_memory;
 
+  UMA_HISTOGRAM_TIMES("History.VisitedLinkResizeTableTime",
+                      base::TimeTicks::Now() - start_time);
+  UMA_HISTOGRAM_COUNTS("History.VisitedLinkResizedTableLength", new_size);
+
   // Send an update notification to all child processes so they read the new
   // table.
   listener_->NewTable(shared_memory_);
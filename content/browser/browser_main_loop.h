@@ -16,6 +16,7 @@ class CommandLine;
 namespace base {
 class FilePath;
 class HighResolutionTimerManager;
+class MemoryPressureListener;
 class MessageLoop;
 class PowerMonitor;
 class SystemMonitor;
@@ -137,6 +138,7 @@ class CONTENT_EXPORT BrowserMainLoop {
   scoped_ptr<base::PowerMonitor> power_monitor_;
   scoped_ptr<base::HighResolutionTimerManager> hi_res_timer_manager_;
   scoped_ptr<net::NetworkChangeNotifier> network_change_notifier_;
+  scoped_ptr<base::MemoryPressureListener> memory_pressure_listener_;
   // user_input_monitor_ has to outlive audio_manager_, so declared first.
   scoped_ptr<media::UserInputMonitor> user_input_monitor_;
   scoped_ptr<media::AudioManager> audio_manager_;
@@ -76,9 +76,12 @@ void BrowserGpuChannelHostFactory::EstablishRequest::EstablishOnIO() {
     reused_gpu_process_ = true;
   }
 
+  // The browser compositor preempts the renderers.
   host->EstablishGpuChannel(
       gpu_client_id_,
       true,
+      true,
+      false,
       base::Bind(
           &BrowserGpuChannelHostFactory::EstablishRequest::OnEstablishedOnIO,
           this));
@@ -100,9 +100,12 @@ class GpuProcessHost : public BrowserChildProcessHostDelegate,
 
   // Tells the GPU process to create a new channel for communication with a
   // client. Once the GPU process responds asynchronously with the IPC handle
-  // and GPUInfo, we call the callback.
+  // and GPUInfo, we call the callback. The channel preempts the ones created
+  // with |preempted| if |preempts| is true.
   void EstablishGpuChannel(int client_id,
                            bool share_context,
+                           bool preempts,
+                           bool preempted,
                            const EstablishChannelCallback& callback);
 
   // Tells the GPU process to create a new command buffer that draws into the
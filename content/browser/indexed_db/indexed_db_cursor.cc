@@ -132,10 +132,11 @@ void IndexedDBCursor::CursorPrefetchIterationOperation(
         found_values.push_back(std::string());
         break;
       case indexed_db::CURSOR_KEY_AND_VALUE: {
-        std::string value;
-        value.swap(*cursor_->value());
-        size_estimate += value.size();
-        found_values.push_back(value);
+        // Move the value out of the cursor rather than copying it, since it
+        // will be overwritten by the next Continue() anyway.
+        found_values.push_back(std::string());
+        found_values.back().swap(*cursor_->value());
+        size_estimate += found_values.back().size();
         break;
       }
       default:
@@ -4,10 +4,12 @@
 
 #include "content/browser/indexed_db/leveldb/leveldb_database.h"
 
+#include <algorithm>
 #include <cerrno>
 
 #include "base/basictypes.h"
 #include "base/files/file.h"
+#include "base/lazy_instance.h"
 #include "base/logging.h"
 #include "base/memory/scoped_ptr.h"
 #include "base/metrics/histogram.h"
@@ -22,6 +24,7 @@
 #include "third_party/leveldatabase/env_chromium.h"
 #include "third_party/leveldatabase/env_idb.h"
 #include "third_party/leveldatabase/src/helpers/memenv/memenv.h"
+#include "third_party/leveldatabase/src/include/leveldb/cache.h"
 #include "third_party/leveldatabase/src/include/leveldb/comparator.h"
 #include "third_party/leveldatabase/src/include/leveldb/db.h"
 #include "third_party/leveldatabase/src/include/leveldb/env.h"
@@ -47,6 +50,36 @@ static const bool kSyncWrites = true;
 static const bool kSyncWrites = true;
 #endif
 
+namespace {
+
+// The block cache is shared by all the databases, so that the memory used to
+// cache blocks is bounded however many origins use IndexedDB, while a single
+// busy database can use more than the 8MB that leveldb caches by default.
+class SharedBlockCache {
+ public:
+  SharedBlockCache() : cache_(leveldb::NewLRUCache(GetCapacity())) {}
+
+  leveldb::Cache* get() const { return cache_.get(); }
+
+ private:
+  static size_t GetCapacity() {
+    const int64 kMinCapacity = 8 * 1024 * 1024;
+    const int64 kMaxCapacity = 64 * 1024 * 1024;
+    int64 capacity = base::SysInfo::AmountOfPhysicalMemory() / 256;
+    return static_cast<size_t>(
+        std::max(kMinCapacity, std::min(kMaxCapacity, capacity)));
+  }
+
+  scoped_ptr<leveldb::Cache> cache_;
+
+  DISALLOW_COPY_AND_ASSIGN(SharedBlockCache);
+};
+
+base::LazyInstance<SharedBlockCache>::Leaky g_block_cache =
+    LAZY_INSTANCE_INITIALIZER;
+
+}  // namespace
+
 static leveldb::Slice MakeSlice(const StringPiece& s) {
   return leveldb::Slice(s.begin(), s.size());
 }
@@ -105,6 +138,7 @@ static leveldb::Status OpenDB(leveldb::Comparator* comparator,
   // https://code.google.com/p/chromium/issues/detail?id=227313#c11
   options.max_open_files = 80;
   options.env = env;
+  options.block_cache = g_block_cache.Get().get();
 
   // ChromiumEnv assumes UTF8, converts back to FilePath before using.
   return leveldb::DB::Open(options, path.AsUTF8Unsafe(), db);
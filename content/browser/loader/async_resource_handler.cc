@@ -123,14 +123,18 @@ void AsyncResourceHandler::OnFollowRedirect(
   ResumeIfDeferred();
 }
 
-void AsyncResourceHandler::OnDataReceivedACK(int request_id) {
-  if (pending_data_count_) {
-    --pending_data_count_;
+void AsyncResourceHandler::OnDataReceivedACK(int request_id, int count) {
+  if (count <= 0 || !pending_data_count_)
+    return;
 
+  // Each DataReceived message holds one allocation of the buffer, which are
+  // recycled in order.
+  count = std::min(count, pending_data_count_);
+  pending_data_count_ -= count;
+  while (count--)
     buffer_->RecycleLeastRecentlyAllocated();
-    if (buffer_->CanAllocate())
-      ResumeIfDeferred();
-  }
+  if (buffer_->CanAllocate())
+    ResumeIfDeferred();
 }
 
 bool AsyncResourceHandler::OnUploadProgress(int request_id,
@@ -71,7 +71,7 @@ class AsyncResourceHandler : public ResourceHandler,
   void OnFollowRedirect(int request_id,
                         bool has_new_first_party_for_cookies,
                         const GURL& new_first_party_for_cookies);
-  void OnDataReceivedACK(int request_id);
+  void OnDataReceivedACK(int request_id, int count);
 
   bool EnsureResourceBufferIsInitialized();
   void ResumeIfDeferred();
@@ -760,7 +760,7 @@ class ResourceDispatcherHostTest : public testing::Test,
     bool result = PickleIterator(msg).ReadInt(&request_id);
     DCHECK(result);
     scoped_ptr<IPC::Message> ack(
-        new ResourceHostMsg_DataReceived_ACK(request_id));
+        new ResourceHostMsg_DataReceived_ACK(request_id, 1));
 
     base::MessageLoop::current()->PostTask(
         FROM_HERE,
@@ -2647,7 +2647,7 @@ TEST_F(ResourceDispatcherHostTest, DelayedDataReceivedACKs) {
 
       EXPECT_EQ(ResourceMsg_DataReceived::ID, msgs[0][i].type());
 
-      ResourceHostMsg_DataReceived_ACK msg(1);
+      ResourceHostMsg_DataReceived_ACK msg(1, 1);
       bool msg_was_ok;
       host_.OnMessageReceived(msg, filter_.get(), &msg_was_ok);
     }
@@ -2659,6 +2659,49 @@ TEST_F(ResourceDispatcherHostTest, DelayedDataReceivedACKs) {
   }
 }
 
+// Tests that a single ACK can release the space of several DataReceived
+// messages.
+TEST_F(ResourceDispatcherHostTest, CoalescedDataReceivedACKs) {
+  EXPECT_EQ(0, host_.pending_requests());
+
+  HandleScheme("big-job");
+  MakeTestRequest(0, 1, GURL("big-job:0123456789,1000000"));
+
+  ResourceIPCAccumulator::ClassifiedMessages msgs;
+  accum_.GetClassifiedMessages(&msgs);
+
+  EXPECT_EQ(ResourceMsg_ReceivedResponse::ID, msgs[0][0].type());
+  EXPECT_EQ(ResourceMsg_SetDataBuffer::ID, msgs[0][1].type());
+  msgs[0].erase(msgs[0].begin());
+  msgs[0].erase(msgs[0].begin());
+
+  // ACK all the DataReceived messages of each round at once until we find a
+  // RequestComplete message.
+  bool complete = false;
+  while (!complete) {
+    int count = 0;
+    for (size_t i = 0; i < msgs[0].size(); ++i) {
+      if (msgs[0][i].type() == ResourceMsg_RequestComplete::ID) {
+        complete = true;
+        break;
+      }
+
+      EXPECT_EQ(ResourceMsg_DataReceived::ID, msgs[0][i].type());
+      ++count;
+    }
+    ASSERT_TRUE(complete || count > 0);
+
+    ResourceHostMsg_DataReceived_ACK msg(1, count);
+    bool msg_was_ok;
+    host_.OnMessageReceived(msg, filter_.get(), &msg_was_ok);
+
+    base::MessageLoop::current()->RunUntilIdle();
+
+    msgs.clear();
+    accum_.GetClassifiedMessages(&msgs);
+  }
+}
+
 // Flakyness of this test might indicate memory corruption issues with
 // for example the ResourceBuffer of AsyncResourceHandler.
 TEST_F(ResourceDispatcherHostTest, DataReceivedUnexpectedACKs) {
@@ -2682,7 +2725,7 @@ TEST_F(ResourceDispatcherHostTest, DataReceivedUnexpectedACKs) {
 
   // Send some unexpected ACKs.
   for (size_t i = 0; i < 128; ++i) {
-    ResourceHostMsg_DataReceived_ACK msg(1);
+    ResourceHostMsg_DataReceived_ACK msg(1, 1);
     bool msg_was_ok;
     host_.OnMessageReceived(msg, filter_.get(), &msg_was_ok);
   }
@@ -2701,7 +2744,7 @@ TEST_F(ResourceDispatcherHostTest, DataReceivedUnexpectedACKs) {
 
       EXPECT_EQ(ResourceMsg_DataReceived::ID, msgs[0][i].type());
 
-      ResourceHostMsg_DataReceived_ACK msg(1);
+      ResourceHostMsg_DataReceived_ACK msg(1, 1);
       bool msg_was_ok;
       host_.OnMessageReceived(msg, filter_.get(), &msg_was_ok);
     }
@@ -4,7 +4,9 @@
 
 #include "content/browser/loader/resource_scheduler.h"
 
+#include "base/metrics/histogram.h"
 #include "base/stl_util.h"
+#include "base/time/time.h"
 #include "content/common/resource_messages.h"
 #include "content/browser/loader/resource_message_delegate.h"
 #include "content/public/browser/resource_controller.h"
@@ -118,6 +120,7 @@ class ResourceScheduler::ScheduledResourceRequest
       : ResourceMessageDelegate(request),
         client_id_(client_id),
         request_(request),
+        host_port_pair_(net::HostPortPair::FromURL(request->url())),
         ready_(false),
         deferred_(false),
         scheduler_(scheduler) {
@@ -131,6 +134,10 @@ class ResourceScheduler::ScheduledResourceRequest
 
   void Start() {
     TRACE_EVENT_ASYNC_STEP_PAST0("net", "URLRequest", request_, "Queued");
+    if (!queued_time_.is_null()) {
+      UMA_HISTOGRAM_TIMES("ResourceScheduler.QueueingTime",
+                          base::TimeTicks::Now() - queued_time_);
+    }
     ready_ = true;
     if (deferred_ && request_->status().is_success()) {
       deferred_ = false;
@@ -138,10 +145,19 @@ class ResourceScheduler::ScheduledResourceRequest
     }
   }
 
+  // Called when the request is put in its client's pending queue rather than
+  // started right away.
+  void MarkQueued() { queued_time_ = base::TimeTicks::Now(); }
+
   const ClientId& client_id() const { return client_id_; }
   net::URLRequest* url_request() { return request_; }
   const net::URLRequest* url_request() const { return request_; }
 
+  // The host and port of the request's current URL. This is kept here as the
+  // scheduler counts the requests in flight to each host every time it
+  // considers starting another request.
+  const net::HostPortPair& host_port_pair() const { return host_port_pair_; }
+
  private:
   // ResourceMessageDelegate interface:
   virtual bool OnMessageReceived(const IPC::Message& message,
@@ -159,6 +175,10 @@ class ResourceScheduler::ScheduledResourceRequest
     deferred_ = *defer = !ready_;
   }
 
+  virtual void WillRedirectRequest(const GURL& new_url, bool* defer) OVERRIDE {
+    host_port_pair_ = net::HostPortPair::FromURL(new_url);
+  }
+
   virtual const char* GetNameForLogging() const OVERRIDE {
     return "ResourceScheduler";
   }
@@ -169,8 +189,10 @@ class ResourceScheduler::ScheduledResourceRequest
 
   ClientId client_id_;
   net::URLRequest* request_;
+  net::HostPortPair host_port_pair_;
   bool ready_;
   bool deferred_;
+  base::TimeTicks queued_time_;
   ResourceScheduler* scheduler_;
 
   DISALLOW_COPY_AND_ASSIGN(ScheduledResourceRequest);
@@ -219,6 +241,7 @@ scoped_ptr<ResourceThrottle> ResourceScheduler::ScheduleRequest(
   if (ShouldStartRequest(request.get(), client) == START_REQUEST) {
     StartRequest(request.get(), client);
   } else {
+    request->MarkQueued();
     client->pending_requests.Insert(request.get(), url_request->priority());
   }
   return request.PassAs<ResourceThrottle>();
@@ -418,8 +441,7 @@ void ResourceScheduler::GetNumDelayableRequestsInFlight(
   size_t same_host_count = 0;
   for (RequestSet::iterator it = client->in_flight_requests.begin();
        it != client->in_flight_requests.end(); ++it) {
-    net::HostPortPair host_port_pair =
-        net::HostPortPair::FromURL((*it)->url_request()->url());
+    const net::HostPortPair& host_port_pair = (*it)->host_port_pair();
 
     if (active_request_host.Equals(host_port_pair)) {
       same_host_count++;
@@ -480,8 +502,7 @@ ResourceScheduler::ShouldStartReqResult ResourceScheduler::ShouldStartRequest(
     return START_REQUEST;
   }
 
-  net::HostPortPair host_port_pair =
-      net::HostPortPair::FromURL(url_request.url());
+  const net::HostPortPair& host_port_pair = request->host_port_pair();
 
   // TODO(willchan): We should really improve this algorithm as described in
   // crbug.com/164101. Also, theoretically we should not count a SPDY request
@@ -51,6 +51,12 @@ class TestRequest : public ResourceController {
     started_ = !deferred;
   }
 
+  void Redirect(const GURL& new_url) {
+    bool deferred = false;
+    throttle_->WillRedirectRequest(new_url, &deferred);
+    EXPECT_FALSE(deferred);
+  }
+
   const net::URLRequest* url_request() const { return url_request_.get(); }
 
  protected:
@@ -357,6 +363,29 @@ TEST_F(ResourceSchedulerTest, LimitedNumberOfDelayableRequestsInFlight) {
   EXPECT_FALSE(last_differenthost->started());
 }
 
+TEST_F(ResourceSchedulerTest, RedirectedRequestsCountForTheirNewHost) {
+  scheduler_.OnWillInsertBody(kChildId, kRouteId);
+
+  const int kMaxNumDelayableRequestsPerHost = 6;  // Should match the .cc.
+  ScopedVector<TestRequest> lows;
+  for (int i = 0; i < kMaxNumDelayableRequestsPerHost; ++i) {
+    string url = "http://host/low" + base::IntToString(i);
+    lows.push_back(NewRequest(url.c_str(), net::LOWEST));
+    EXPECT_TRUE(lows[i]->started());
+  }
+  scoped_ptr<TestRequest> other_host(NewRequest("http://otherhost/low1",
+                                                net::LOWEST));
+  EXPECT_TRUE(other_host->started());
+
+  // |host| is at its limit, until one of its requests is redirected away.
+  scoped_ptr<TestRequest> queued(NewRequest("http://host/queued",
+                                            net::LOWEST));
+  EXPECT_FALSE(queued->started());
+  lows[0]->Redirect(GURL("http://otherhost/low0"));
+  scoped_ptr<TestRequest> last(NewRequest("http://host/last", net::LOWEST));
+  EXPECT_TRUE(last->started());
+}
+
 TEST_F(ResourceSchedulerTest, RaisePriorityAndStart) {
   // Dummies to enforce scheduling.
   scoped_ptr<TestRequest> high(NewRequest("http://host/high", net::HIGHEST));
@@ -4,6 +4,9 @@
 
 #include "content/browser/net/sqlite_persistent_cookie_store.h"
 
+#include <algorithm>
+#include <deque>
+#include <functional>
 #include <list>
 #include <map>
 #include <set>
@@ -53,9 +56,11 @@ namespace content {
 // delegates to Backend::Load, which posts a Backend::LoadAndNotifyOnDBThread
 // task to the background runner.  This task calls Backend::ChainLoadCookies(),
 // which repeatedly posts itself to the BG runner to load each eTLD+1's cookies
-// in separate tasks.  When this is complete, Backend::CompleteLoadOnIOThread is
-// posted to the client runner, which notifies the caller of
-// SQLitePersistentCookieStore::Load that the load is complete.
+// in separate tasks, starting with the most recently accessed ones, as they
+// are the most likely to be requested first.  When this is complete,
+// Backend::CompleteLoadOnIOThread is posted to the client runner, which
+// notifies the caller of SQLitePersistentCookieStore::Load that the load is
+// complete.
 //
 // If a priority load request is invoked via SQLitePersistentCookieStore::
 // LoadCookiesForKey, it is delegated to Backend::LoadCookiesForKey, which posts
@@ -233,6 +238,11 @@ class SQLitePersistentCookieStore::Backend
   // Map of domain keys(eTLD+1) to domains/hosts that are to be loaded from DB.
   std::map<std::string, std::set<std::string> > keys_to_load_;
 
+  // The domain keys of |keys_to_load_| in the order they are chain-loaded,
+  // most recently accessed first. Keys loaded by a priority request are left
+  // in here, and skipped.
+  std::deque<std::string> chain_load_order_;
+
   // Map of (domain keys(eTLD+1), is secure cookie) to number of cookies in the
   // database.
   typedef std::pair<std::string, bool> CookieOrigin;
@@ -604,9 +614,9 @@ bool SQLitePersistentCookieStore::Backend::InitializeDatabase() {
 
   start = base::Time::Now();
 
-  // Retrieve all the domains
+  // Retrieve all the domains, with the time their cookies were last accessed.
   sql::Statement smt(db_->GetUniqueStatement(
-    "SELECT DISTINCT host_key FROM cookies"));
+    "SELECT host_key, MAX(last_access_utc) FROM cookies GROUP BY host_key"));
 
   if (!smt.is_valid()) {
     if (corruption_detected_)
@@ -617,8 +627,11 @@ bool SQLitePersistentCookieStore::Backend::InitializeDatabase() {
   }
 
   std::vector<std::string> host_keys;
-  while (smt.Step())
+  std::vector<int64> last_access_times;
+  while (smt.Step()) {
     host_keys.push_back(smt.ColumnString(0));
+    last_access_times.push_back(smt.ColumnInt64(1));
+  }
 
   UMA_HISTOGRAM_CUSTOM_TIMES(
       "Cookie.TimeLoadDomains",
@@ -628,7 +641,9 @@ bool SQLitePersistentCookieStore::Backend::InitializeDatabase() {
 
   base::Time start_parse = base::Time::Now();
 
-  // Build a map of domain keys (always eTLD+1) to domains.
+  // Build a map of domain keys (always eTLD+1) to domains, and find when the
+  // cookies of each key were last accessed.
+  std::map<std::string, int64> key_last_access_times;
   for (size_t idx = 0; idx < host_keys.size(); ++idx) {
     const std::string& domain = host_keys[idx];
     std::string key =
@@ -637,8 +652,24 @@ bool SQLitePersistentCookieStore::Backend::InitializeDatabase() {
             net::registry_controlled_domains::INCLUDE_PRIVATE_REGISTRIES);
 
     keys_to_load_[key].insert(domain);
+    int64& key_last_access_time = key_last_access_times[key];
+    key_last_access_time =
+        std::max(key_last_access_time, last_access_times[idx]);
   }
 
+  // Chain-load the most recently accessed keys first.
+  std::vector<std::pair<int64, std::string> > keys_by_last_access;
+  keys_by_last_access.reserve(key_last_access_times.size());
+  for (std::map<std::string, int64>::const_iterator it =
+           key_last_access_times.begin();
+       it != key_last_access_times.end(); ++it) {
+    keys_by_last_access.push_back(std::make_pair(it->second, it->first));
+  }
+  std::sort(keys_by_last_access.begin(), keys_by_last_access.end(),
+            std::greater<std::pair<int64, std::string> >());
+  for (size_t idx = 0; idx < keys_by_last_access.size(); ++idx)
+    chain_load_order_.push_back(keys_by_last_access[idx].second);
+
   UMA_HISTOGRAM_CUSTOM_TIMES(
       "Cookie.TimeParseDomains",
       base::Time::Now() - start_parse,
@@ -666,9 +697,15 @@ void SQLitePersistentCookieStore::Backend::ChainLoadCookies(
     // Close() has been called on this store.
     load_success = false;
   } else if (keys_to_load_.size() > 0) {
-    // Load cookies for the first domain key.
+    // Load cookies for the next domain key that hasn't been loaded by a
+    // priority request yet.
     std::map<std::string, std::set<std::string> >::iterator
-      it = keys_to_load_.begin();
+      it = keys_to_load_.end();
+    while (it == keys_to_load_.end()) {
+      DCHECK(!chain_load_order_.empty());
+      it = keys_to_load_.find(chain_load_order_.front());
+      chain_load_order_.pop_front();
+    }
     load_success = LoadCookiesForDomains(it->second);
     keys_to_load_.erase(it);
   }
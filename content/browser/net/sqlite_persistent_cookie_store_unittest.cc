@@ -332,6 +332,41 @@ TEST_F(SQLitePersistentCookieStoreTest, TestLoadCookiesForKey) {
   STLDeleteElements(&cookies_);
 }
 
+// Test that the domain keys are chain-loaded most recently accessed first,
+// rather than in alphabetical order.
+TEST_F(SQLitePersistentCookieStoreTest, TestChainLoadOrder) {
+  InitializeStore(false, false);
+  base::Time t = base::Time::Now();
+  AddCookie("A", "B", "www.bbb.com", "/", t);
+  t += base::TimeDelta::FromInternalValue(10);
+  AddCookie("A", "B", "www.ccc.com", "/", t);
+  t += base::TimeDelta::FromInternalValue(10);
+  AddCookie("A", "B", "www.aaa.com", "/", t);
+  t += base::TimeDelta::FromInternalValue(10);
+  // The most recent access to any host of a key counts for the whole key.
+  AddCookie("A", "B", "travel.bbb.com", "/", t);
+  DestroyStore();
+
+  CanonicalCookieVector cookies;
+  CreateAndLoad(false, false, &cookies);
+  ASSERT_EQ(4U, cookies.size());
+
+  // The cookies are handed out in the order they were loaded in.
+  std::vector<std::string> keys_loaded;
+  for (CanonicalCookieVector::const_iterator it = cookies.begin();
+       it != cookies.end();
+       ++it) {
+    std::string key = (*it)->Domain().substr((*it)->Domain().find('.') + 1);
+    if (keys_loaded.empty() || keys_loaded.back() != key)
+      keys_loaded.push_back(key);
+  }
+  STLDeleteElements(&cookies);
+  ASSERT_EQ(3U, keys_loaded.size());
+  EXPECT_EQ("bbb.com", keys_loaded[0]);
+  EXPECT_EQ("aaa.com", keys_loaded[1]);
+  EXPECT_EQ("ccc.com", keys_loaded[2]);
+}
+
 // Test that we can force the database to be written by calling Flush().
 TEST_F(SQLitePersistentCookieStoreTest, TestFlush) {
   InitializeStore(false, false);
@@ -149,6 +149,8 @@ void GpuMessageFilter::OnEstablishGpuChannel(
   host->EstablishGpuChannel(
       render_process_id_,
       share_contexts_,
+      false,
+      true,
       base::Bind(&GpuMessageFilter::EstablishChannelCallback,
                  weak_ptr_factory_.GetWeakPtr(),
                  base::Passed(&reply)));
@@ -29,7 +29,10 @@ AudioSyncReader::AudioSyncReader(base::SharedMemory* shared_memory,
       maximum_wait_time_(params.GetBufferDuration() / 2),
 #else
       // TODO(dalecurtis): Investigate if we can reduce this on all platforms.
-      maximum_wait_time_(base::TimeDelta::FromMilliseconds(20)),
+      // Waiting longer than a buffer for a late renderer would also make the
+      // next device callback late, so small buffers wait for less.
+      maximum_wait_time_(std::min(base::TimeDelta::FromMilliseconds(20),
+                                  params.GetBufferDuration())),
 #endif
       buffer_index_(0) {
   DCHECK_EQ(packet_size_, AudioBus::CalculateMemorySize(params));
@@ -51,9 +54,10 @@ AudioSyncReader::~AudioSyncReader() {
 
 // media::AudioOutputController::SyncReader implementations.
 void AudioSyncReader::UpdatePendingBytes(uint32 bytes) {
-  // Zero out the entire output buffer to avoid stuttering/repeating-buffers
-  // in the anomalous case if the renderer is unable to keep up with real-time.
-  output_bus_->Zero();
+  // The renderer zeroes whatever it doesn't render, and Read() outputs silence
+  // if the renderer is unable to keep up with real-time.  So the buffer isn't
+  // zeroed here, which would write all of the shared memory from this process
+  // every period.
   socket_->Send(&bytes, sizeof(bytes));
   ++buffer_index_;
 }
@@ -1096,7 +1096,9 @@ void RenderProcessHostImpl::PropagateBrowserCommandLineToRenderer(
     cc::switches::kDisableGPURasterization,
     cc::switches::kDisableImplSidePainting,
     cc::switches::kDisableLCDText,
+    cc::switches::kDisableLowLatencyRecovery,
     cc::switches::kDisableMapImage,
+    cc::switches::kDisableOcclusionForTilePrioritization,
     cc::switches::kDisableThreadedAnimation,
     cc::switches::kEnableGpuBenchmarking,
     cc::switches::kEnableGPURasterization,
@@ -456,8 +456,32 @@ void ResourceDispatcher::OnReceivedData(int request_id,
                         base::TimeTicks::Now() - time_start);
   }
 
-  // Acknowledge the reception of this data.
-  message_sender()->Send(new ResourceHostMsg_DataReceived_ACK(request_id));
+  // The peer may have cancelled the request, which frees |request_info|.
+  request_info = GetPendingRequestInfo(request_id);
+  if (!request_info) {
+    message_sender()->Send(new ResourceHostMsg_DataReceived_ACK(request_id, 1));
+    return;
+  }
+
+  // Acknowledge the reception of this data once the messages that are already
+  // queued have been handled, so that a burst of them gets a single ack.
+  if (request_info->pending_data_acks++ == 0) {
+    base::MessageLoop::current()->PostTask(
+        FROM_HERE,
+        base::Bind(&ResourceDispatcher::SendPendingDataAcks,
+                   weak_factory_.GetWeakPtr(),
+                   request_id));
+  }
+}
+
+void ResourceDispatcher::SendPendingDataAcks(int request_id) {
+  PendingRequestInfo* request_info = GetPendingRequestInfo(request_id);
+  if (!request_info || !request_info->pending_data_acks)
+    return;
+
+  message_sender()->Send(new ResourceHostMsg_DataReceived_ACK(
+      request_id, request_info->pending_data_acks));
+  request_info->pending_data_acks = 0;
 }
 
 void ResourceDispatcher::OnDownloadedData(int request_id,
@@ -627,7 +651,8 @@ ResourceDispatcher::PendingRequestInfo::PendingRequestInfo()
     : peer(NULL),
       resource_type(ResourceType::SUB_RESOURCE),
       is_deferred(false),
-      buffer_size(0) {
+      buffer_size(0),
+      pending_data_acks(0) {
 }
 
 ResourceDispatcher::PendingRequestInfo::PendingRequestInfo(
@@ -643,7 +668,8 @@ ResourceDispatcher::PendingRequestInfo::PendingRequestInfo(
       url(request_url),
       frame_origin(frame_origin),
       response_url(request_url),
-      request_start(base::TimeTicks::Now()) {
+      request_start(base::TimeTicks::Now()),
+      pending_data_acks(0) {
 }
 
 ResourceDispatcher::PendingRequestInfo::~PendingRequestInfo() {}
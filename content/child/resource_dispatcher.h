@@ -115,6 +115,8 @@ class CONTENT_EXPORT ResourceDispatcher : public IPC::Listener {
     base::TimeTicks completion_time;
     linked_ptr<base::SharedMemory> buffer;
     int buffer_size;
+    // The number of DataReceived messages handled since the last ack.
+    int pending_data_acks;
   };
   typedef base::hash_map<int, PendingRequestInfo> PendingRequestList;
 
@@ -146,6 +148,10 @@ class CONTENT_EXPORT ResourceDispatcher : public IPC::Listener {
       int data_offset,
       int data_length,
       int encoded_data_length);
+
+  // Acknowledges the DataReceived messages handled for |request_id| since the
+  // last call, which lets the browser reuse their part of the shared buffer.
+  void SendPendingDataAcks(int request_id);
   void OnDownloadedData(
       int request_id,
       int data_len,
@@ -95,6 +95,26 @@ class TestRequestCallback : public ResourceLoaderBridge::Peer {
 };
 
 
+// Deletes its bridge, which cancels the request, when it receives data.
+class CancelingRequestCallback : public TestRequestCallback {
+ public:
+  CancelingRequestCallback() : bridge_(NULL) {}
+
+  void set_bridge(ResourceLoaderBridge* bridge) { bridge_ = bridge; }
+
+  virtual void OnReceivedData(const char* data,
+                              int data_length,
+                              int encoded_data_length) OVERRIDE {
+    TestRequestCallback::OnReceivedData(data, data_length,
+                                        encoded_data_length);
+    delete bridge_;
+    bridge_ = NULL;
+  }
+
+ private:
+  ResourceLoaderBridge* bridge_;
+};
+
 // Sets up the message sender override for the unit test
 class ResourceDispatcherTest : public testing::Test, public IPC::Sender {
  public:
@@ -142,12 +162,17 @@ class ResourceDispatcherTest : public testing::Test, public IPC::Sender {
 
       message_queue_.erase(message_queue_.begin());
 
+      // The ack is sent once the pending messages have been handled.
+      EXPECT_TRUE(message_queue_.empty());
+      base::MessageLoop::current()->RunUntilIdle();
+
       // read the ack message.
-      Tuple1<int> request_ack;
+      Tuple2<int, int> request_ack;
       ASSERT_TRUE(ResourceHostMsg_DataReceived_ACK::Read(
           &message_queue_[0], &request_ack));
 
       ASSERT_EQ(request_ack.a, request_id);
+      ASSERT_EQ(1, request_ack.b);
 
       message_queue_.erase(message_queue_.begin());
     }
@@ -193,6 +218,7 @@ scoped_ptr<ResourceDispatcher> ResourceDispatcherTest::dispatcher_;
 
 // Does a simple request and tests that the correct data is received.
 TEST_F(ResourceDispatcherTest, RoundTrip) {
+  base::MessageLoop message_loop;
   TestRequestCallback callback;
   ResourceLoaderBridge* bridge = CreateBridge();
 
@@ -209,6 +235,88 @@ TEST_F(ResourceDispatcherTest, RoundTrip) {
   delete bridge;
 }
 
+// Tests that the DataReceived messages handled in a row are acked at once.
+TEST_F(ResourceDispatcherTest, CoalescesDataReceivedACKs) {
+  base::MessageLoop message_loop;
+  TestRequestCallback callback;
+  ResourceLoaderBridge* bridge = CreateBridge();
+  bridge->Start(&callback);
+
+  ASSERT_EQ(1U, message_queue_.size());
+  int request_id;
+  ResourceHostMsg_Request request;
+  ASSERT_TRUE(ResourceHostMsg_RequestResource::Read(
+      &message_queue_[0], &request_id, &request));
+  message_queue_.clear();
+
+  dispatcher_->OnReceivedResponse(request_id, ResourceResponseHead());
+
+  base::SharedMemory shared_mem;
+  EXPECT_TRUE(shared_mem.CreateAndMapAnonymous(test_page_contents_len));
+  memcpy(shared_mem.memory(), test_page_contents, test_page_contents_len);
+  base::SharedMemoryHandle dup_handle;
+  EXPECT_TRUE(shared_mem.GiveToProcess(
+      base::Process::Current().handle(), &dup_handle));
+  dispatcher_->OnSetDataBuffer(request_id, dup_handle,
+                               test_page_contents_len, 0);
+  dispatcher_->OnReceivedData(request_id, 0, 10, 10);
+  dispatcher_->OnReceivedData(request_id, 10, 10, 10);
+  dispatcher_->OnReceivedData(request_id, 20, 10, 10);
+  EXPECT_TRUE(message_queue_.empty());
+
+  base::MessageLoop::current()->RunUntilIdle();
+  ASSERT_EQ(1U, message_queue_.size());
+  Tuple2<int, int> request_ack;
+  ASSERT_TRUE(ResourceHostMsg_DataReceived_ACK::Read(
+      &message_queue_[0], &request_ack));
+  EXPECT_EQ(request_id, request_ack.a);
+  EXPECT_EQ(3, request_ack.b);
+  EXPECT_EQ(std::string(test_page_contents, 30), callback.data());
+
+  delete bridge;
+}
+
+// Tests that the data is acked right away when the peer cancels the request
+// while handling it.
+TEST_F(ResourceDispatcherTest, CancelWhileReceivingData) {
+  base::MessageLoop message_loop;
+  CancelingRequestCallback callback;
+  ResourceLoaderBridge* bridge = CreateBridge();
+  callback.set_bridge(bridge);
+  bridge->Start(&callback);
+
+  ASSERT_EQ(1U, message_queue_.size());
+  int request_id;
+  ResourceHostMsg_Request request;
+  ASSERT_TRUE(ResourceHostMsg_RequestResource::Read(
+      &message_queue_[0], &request_id, &request));
+  message_queue_.clear();
+
+  dispatcher_->OnReceivedResponse(request_id, ResourceResponseHead());
+
+  base::SharedMemory shared_mem;
+  EXPECT_TRUE(shared_mem.CreateAndMapAnonymous(test_page_contents_len));
+  memcpy(shared_mem.memory(), test_page_contents, test_page_contents_len);
+  base::SharedMemoryHandle dup_handle;
+  EXPECT_TRUE(shared_mem.GiveToProcess(
+      base::Process::Current().handle(), &dup_handle));
+  dispatcher_->OnSetDataBuffer(request_id, dup_handle,
+                               test_page_contents_len, 0);
+  dispatcher_->OnReceivedData(request_id, 0, 10, 10);
+
+  ASSERT_EQ(1U, message_queue_.size());
+  Tuple2<int, int> request_ack;
+  ASSERT_TRUE(ResourceHostMsg_DataReceived_ACK::Read(
+      &message_queue_[0], &request_ack));
+  EXPECT_EQ(request_id, request_ack.a);
+  EXPECT_EQ(1, request_ack.b);
+  message_queue_.clear();
+
+  // No other ack follows.
+  base::MessageLoop::current()->RunUntilIdle();
+  EXPECT_TRUE(message_queue_.empty());
+}
+
 // Tests that the request IDs are straight when there are multiple requests.
 TEST_F(ResourceDispatcherTest, MultipleRequests) {
   // FIXME
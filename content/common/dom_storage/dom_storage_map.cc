@@ -64,11 +64,15 @@ base::NullableString16 DOMStorageMap::GetItem(const base::string16& key) const {
 bool DOMStorageMap::SetItem(
     const base::string16& key, const base::string16& value,
     base::NullableString16* old_value) {
-  DOMStorageValuesMap::const_iterator found = values_.find(key);
-  if (found == values_.end())
-    *old_value = base::NullableString16();
-  else
+  // Look the key up once, and use the position found both to replace the
+  // existing value and as the hint to insert a new one.
+  DOMStorageValuesMap::iterator found = values_.lower_bound(key);
+  const bool exists =
+      found != values_.end() && !values_.key_comp()(key, found->first);
+  if (exists)
     *old_value = found->second;
+  else
+    *old_value = base::NullableString16();
 
   size_t old_item_size = old_value->is_null() ?
       0 : size_of_item(key, old_value->string());
@@ -80,7 +84,12 @@ bool DOMStorageMap::SetItem(
   if (new_item_size > old_item_size && new_bytes_used > quota_)
     return false;
 
-  values_[key] = base::NullableString16(value, false);
+  if (exists) {
+    found->second = base::NullableString16(value, false);
+  } else {
+    values_.insert(found,
+                   std::make_pair(key, base::NullableString16(value, false)));
+  }
   ResetKeyIterator();
   bytes_used_ = new_bytes_used;
   return true;
@@ -669,16 +669,20 @@ void GpuChannel::RemoveRoute(int32 route_id) {
 }
 
 gpu::PreemptionFlag* GpuChannel::GetPreemptionFlag() {
-  if (!preempting_flag_.get()) {
-    preempting_flag_ = new gpu::PreemptionFlag;
-    io_message_loop_->PostTask(
-        FROM_HERE, base::Bind(
-            &GpuChannelMessageFilter::SetPreemptingFlagAndSchedulingState,
-            filter_, preempting_flag_, num_stubs_descheduled_ > 0));
-  }
+  if (!preempting_flag_.get())
+    SetPreemptingFlag(new gpu::PreemptionFlag);
   return preempting_flag_.get();
 }
 
+void GpuChannel::SetPreemptingFlag(gpu::PreemptionFlag* preempting_flag) {
+  DCHECK(!preempting_flag_.get());
+  preempting_flag_ = preempting_flag;
+  io_message_loop_->PostTask(
+      FROM_HERE, base::Bind(
+          &GpuChannelMessageFilter::SetPreemptingFlagAndSchedulingState,
+          filter_, preempting_flag_, num_stubs_descheduled_ > 0));
+}
+
 void GpuChannel::SetPreemptByFlag(
     scoped_refptr<gpu::PreemptionFlag> preempted_flag) {
   preempted_flag_ = preempted_flag;
@@ -134,6 +134,10 @@ class GpuChannel : public IPC::Listener,
 
   gpu::PreemptionFlag* GetPreemptionFlag();
 
+  // Makes this channel set |preempting_flag| while its IPCs are stalled.
+  // Must be called at most once, before GetPreemptionFlag().
+  void SetPreemptingFlag(gpu::PreemptionFlag* preempting_flag);
+
   bool handle_messages_scheduled() const { return handle_messages_scheduled_; }
   uint64 messages_processed() const { return messages_processed_; }
 
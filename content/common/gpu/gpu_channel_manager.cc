@@ -12,6 +12,7 @@
 #include "content/common/gpu/gpu_messages.h"
 #include "content/common/gpu/sync_point_manager.h"
 #include "gpu/command_buffer/service/feature_info.h"
+#include "gpu/command_buffer/service/gpu_scheduler.h"
 #include "gpu/command_buffer/service/gpu_switches.h"
 #include "gpu/command_buffer/service/mailbox_manager.h"
 #include "gpu/command_buffer/service/memory_program_cache.h"
@@ -37,6 +38,7 @@ GpuChannelManager::GpuChannelManager(ChildThread* gpu_child_thread,
       io_message_loop_(io_message_loop),
       shutdown_event_(shutdown_event),
       gpu_child_thread_(gpu_child_thread),
+      preemption_flag_(new gpu::PreemptionFlag),
       gpu_memory_manager_(
           this,
           GpuMemoryManager::kDefaultMaxSurfacesWithFrontbufferSoftLimit),
@@ -113,7 +115,10 @@ bool GpuChannelManager::Send(IPC::Message* msg) {
   return gpu_child_thread_->Send(msg);
 }
 
-void GpuChannelManager::OnEstablishChannel(int client_id, bool share_context) {
+void GpuChannelManager::OnEstablishChannel(int client_id,
+                                           bool share_context,
+                                           bool preempts,
+                                           bool preempted) {
   IPC::ChannelHandle channel_handle;
 
   gfx::GLShareGroup* share_group = NULL;
@@ -135,6 +140,10 @@ void GpuChannelManager::OnEstablishChannel(int client_id, bool share_context) {
                                                      client_id,
                                                      false);
   if (channel->Init(io_message_loop_.get(), shutdown_event_)) {
+    if (preempts)
+      channel->SetPreemptingFlag(preemption_flag_.get());
+    if (preempted)
+      channel->SetPreemptByFlag(preemption_flag_);
     gpu_channels_[client_id] = channel;
     channel_handle.name = channel->GetChannelName();
 
@@ -31,6 +31,7 @@ class GLShareGroup;
 }
 
 namespace gpu {
+class PreemptionFlag;
 namespace gles2 {
 class MailboxManager;
 class ProgramCache;
@@ -114,7 +115,10 @@ class GpuChannelManager : public IPC::Listener,
   typedef std::deque<ImageOperation*> ImageOperationQueue;
 
   // Message handlers.
-  void OnEstablishChannel(int client_id, bool share_context);
+  void OnEstablishChannel(int client_id,
+                          bool share_context,
+                          bool preempts,
+                          bool preempted);
   void OnCloseChannel(const IPC::ChannelHandle& channel_handle);
   void OnVisibilityChanged(
       int32 render_view_id, int32 client_id, bool visible);
@@ -146,6 +150,8 @@ class GpuChannelManager : public IPC::Listener,
   GpuChannelMap gpu_channels_;
   scoped_refptr<gfx::GLShareGroup> share_group_;
   scoped_refptr<gpu::gles2::MailboxManager> mailbox_manager_;
+  // Set by the channels that preempt, checked by the ones preempted.
+  scoped_refptr<gpu::PreemptionFlag> preemption_flag_;
   GpuMemoryManager gpu_memory_manager_;
   GpuEventsDispatcher gpu_devtools_events_dispatcher_;
   GpuWatchdog* watchdog_;
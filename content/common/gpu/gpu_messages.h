@@ -248,9 +248,13 @@ IPC_MESSAGE_CONTROL0(GpuMsg_Initialize)
 // GpuHostMsg_ChannelEstablished message.  The client ID is passed so that
 // the GPU process reuses an existing channel to that process if it exists.
 // This ID is a unique opaque identifier generated by the browser process.
-IPC_MESSAGE_CONTROL2(GpuMsg_EstablishChannel,
+// The channels created with |preempts| make the ones created with |preempted|
+// yield when their own messages have been waiting for too long.
+IPC_MESSAGE_CONTROL4(GpuMsg_EstablishChannel,
                      int /* client_id */,
-                     bool /* share_context */)
+                     bool /* share_context */,
+                     bool /* preempts */,
+                     bool /* preempted */)
 
 // Tells the GPU process to close the channel identified by IPC channel
 // handle.  If no channel can be identified, do nothing.
@@ -24,8 +24,9 @@ uint32 SyncPointManager::GenerateSyncPoint() {
   // crash the GPU process than risk worse.
   // For normal operation (at most a few per frame), it would take ~a year to
   // wrap.
-  CHECK(sync_point_map_.find(sync_point) == sync_point_map_.end());
-  sync_point_map_.insert(std::make_pair(sync_point, ClosureList()));
+  bool inserted =
+      sync_point_map_.insert(std::make_pair(sync_point, ClosureList())).second;
+  CHECK(inserted);
   return sync_point;
 }
 
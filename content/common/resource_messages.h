@@ -323,10 +323,11 @@ IPC_SYNC_MESSAGE_ROUTED2_1(ResourceHostMsg_SyncLoad,
                            ResourceHostMsg_Request,
                            content::SyncLoadResult)
 
-// Sent when the renderer process is done processing a DataReceived
-// message.
-IPC_MESSAGE_CONTROL1(ResourceHostMsg_DataReceived_ACK,
-                     int /* request_id */)
+// Sent when the renderer process is done processing |count| DataReceived
+// messages. The acks of the messages handled in a row are coalesced.
+IPC_MESSAGE_CONTROL2(ResourceHostMsg_DataReceived_ACK,
+                     int /* request_id */,
+                     int /* count */)
 
 // Sent when the renderer has processed a DataDownloaded message.
 IPC_MESSAGE_CONTROL1(ResourceHostMsg_DataDownloaded_ACK,
@@ -96,6 +96,10 @@ scoped_ptr<RenderWidgetCompositor> RenderWidgetCompositor::Create(
       !cmd->HasSwitch(cc::switches::kDisableThreadedAnimation);
   settings.touch_hit_testing =
       !cmd->HasSwitch(cc::switches::kDisableCompositorTouchHitTesting);
+  settings.switch_to_low_latency_if_possible =
+      !cmd->HasSwitch(cc::switches::kDisableLowLatencyRecovery);
+  settings.use_occlusion_for_tile_prioritization =
+      !cmd->HasSwitch(cc::switches::kDisableOcclusionForTilePrioritization);
 
   int default_tile_width = settings.default_tile_size.width();
   if (cmd->HasSwitch(switches::kDefaultTileWidth)) {
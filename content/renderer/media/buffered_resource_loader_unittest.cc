@@ -521,6 +521,26 @@ TEST_F(BufferedResourceLoaderTest, ReadOutsideBuffer) {
   loader_->didFinishLoading(url_loader_, 0, -1);
 }
 
+// Tests that reads further ahead are waited for when the bitrate calls for a
+// larger forward buffer window.
+TEST_F(BufferedResourceLoaderTest, ReadAheadWithHighBitrate) {
+  Initialize(kHttpUrl, 10, 0x00FFFFFF);
+  Start();
+  PartialResponse(10, 0x00FFFFFF, 0x01000000);
+
+  uint8 buffer[10];
+
+  // At the default bitrate, reading 3MB ahead gets a cache miss.
+  EXPECT_CALL(*this, ReadCallback(BufferedResourceLoader::kCacheMiss, 0));
+  ReadLoader(0x00300000, 1, buffer);
+
+  // With a 20MB forward window the same read waits for data to arrive.
+  loader_->SetBitrate(100 * 1024 * 1024 * 8);  // 100 Mbps.
+  ReadLoader(0x00300000, 1, buffer);
+
+  StopWhenLoad();
+}
+
 TEST_F(BufferedResourceLoaderTest, RequestFailedWhenRead) {
   Initialize(kHttpUrl, 10, 29);
   Start();
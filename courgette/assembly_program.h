@@ -20,7 +20,7 @@ namespace courgette {
 class EncodedProgram;
 class Instruction;
 
-typedef NoThrowBuffer<Instruction*> InstructionVector;
+typedef NoThrowChunkedBuffer<Instruction*> InstructionVector;
 
 // A Label is a symbolic reference to an address.  Unlike a conventional
 // assembly language, we always know the address.  The address will later be
@@ -107,6 +107,44 @@ TEST_F(BSDiffMemoryTest, TestNearPageArrayPageSize) {
   GenerateAndTestPatch(file1c, file2);
 }
 
+TEST_F(BSDiffMemoryTest, TestReusedSuffixArray) {
+  std::string old_text = GenerateSyntheticInput(10000, 0);
+  courgette::SourceStream old_stream;
+  old_stream.Init(old_text.c_str(), old_text.length());
+  courgette::BSDiffSuffixArray old_suffixes;
+  EXPECT_EQ(courgette::OK, old_suffixes.Init(&old_stream));
+
+  // Patches against the same suffix array are the same as without it.
+  for (int seed = 1;  seed < 4;  ++seed) {
+    std::string new_text = old_text.substr(0, 3000 * seed) +
+                           GenerateSyntheticInput(1000, seed) +
+                           old_text.substr(3000 * seed + 500);
+    courgette::SourceStream new_stream;
+    new_stream.Init(new_text.c_str(), new_text.length());
+    courgette::SinkStream cached_patch;
+    EXPECT_EQ(courgette::OK,
+              CreateBinaryPatch(old_suffixes, &old_stream, &new_stream,
+                                &cached_patch));
+
+    courgette::SinkStream patch;
+    EXPECT_EQ(courgette::OK,
+              CreateBinaryPatch(&old_stream, &new_stream, &patch));
+    ASSERT_EQ(patch.Length(), cached_patch.Length());
+    EXPECT_EQ(0, memcmp(patch.Buffer(), cached_patch.Buffer(),
+                        patch.Length()));
+  }
+
+  // The suffix array can't be used with a different old file.
+  courgette::SourceStream other_stream;
+  other_stream.Init(old_text.c_str(), old_text.length() - 1);
+  courgette::SourceStream new_stream;
+  new_stream.Init(old_text.c_str(), old_text.length());
+  courgette::SinkStream patch;
+  EXPECT_EQ(courgette::UNEXPECTED_ERROR,
+            CreateBinaryPatch(old_suffixes, &other_stream, &new_stream,
+                              &patch));
+}
+
 TEST_F(BSDiffMemoryTest, TestIndenticalDlls) {
   std::string file1 = FileContents("en-US.dll");
   GenerateAndTestPatch(file1, file1);
@@ -80,15 +80,17 @@ DifferenceEstimator::~DifferenceEstimator() {
 }
 
 DifferenceEstimator::Base* DifferenceEstimator::MakeBase(const Region& region) {
-  Base* base = new Base(region);
-  base->Init();
-  owned_bases_.push_back(base);
-  return base;
+  Base* new_base = new Base(region);
+  new_base->Init();
+  base::AutoLock lock(lock_);
+  owned_bases_.push_back(new_base);
+  return new_base;
 }
 
 DifferenceEstimator::Subject* DifferenceEstimator::MakeSubject(
     const Region& region) {
   Subject* subject = new Subject(region);
+  base::AutoLock lock(lock_);
   owned_subjects_.push_back(subject);
   return subject;
 }
@@ -10,6 +10,7 @@
 
 #include <vector>
 
+#include "base/synchronization/lock.h"
 #include "courgette/region.h"
 
 namespace courgette {
@@ -28,6 +29,8 @@ namespace courgette {
 // comparisons to be more efficient by precomputing information used in the
 // comparison.
 //
+// MakeBase, MakeSubject and Measure can be called from several threads at once.
+//
 class DifferenceEstimator {
  public:
   DifferenceEstimator();
@@ -48,6 +51,7 @@ class DifferenceEstimator {
   size_t Measure(Base* base,  Subject* subject);
 
  private:
+  base::Lock lock_;  // Protects the following members.
   std::vector<Base*> owned_bases_;
   std::vector<Subject*> owned_subjects_;
   DISALLOW_COPY_AND_ASSIGN(DifferenceEstimator);
@@ -118,13 +118,18 @@ static CheckBool ReadU32Delta(V* set, SourceStream* buffer) {
 // the possibility of a greater size for experiments comparing Varint32 encoding
 // of a vector of larger integrals vs a plain form.)
 //
+// The vector doesn't have to be contiguous: it's written one run of contiguous
+// elements (as given by |DataAt()|) at a time.
+//
 template<typename V>
 CheckBool WriteVectorU8(const V& items, SinkStream* buffer) {
   size_t count = items.size();
   bool ok = buffer->WriteSizeVarint32(count);
-  if (count != 0 && ok) {
-    size_t byte_count = count * sizeof(typename V::value_type);
-    ok = buffer->Write(static_cast<const void*>(&items[0]), byte_count);
+  for (size_t i = 0;  ok && i < count;) {
+    size_t run_count;
+    const void* data = items.DataAt(i, &run_count);
+    ok = buffer->Write(data, run_count * sizeof(typename V::value_type));
+    i += run_count;
   }
   return ok;
 }
@@ -137,9 +142,11 @@ bool ReadVectorU8(V* items, SourceStream* buffer) {
 
   items->clear();
   bool ok = items->resize(count, 0);
-  if (ok && count != 0) {
-    size_t byte_count = count * sizeof(typename V::value_type);
-    return buffer->Read(static_cast<void*>(&((*items)[0])), byte_count);
+  for (size_t i = 0;  ok && i < count;) {
+    size_t run_count;
+    void* data = items->DataAt(i, &run_count);
+    ok = buffer->Read(data, run_count * sizeof(typename V::value_type));
+    i += run_count;
   }
   return ok;
 }
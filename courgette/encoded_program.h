@@ -86,10 +86,12 @@ class EncodedProgram {
     LAST_ARM    = 0x5FFF,
   };
 
-  typedef NoThrowBuffer<RVA> RvaVector;
-  typedef NoThrowBuffer<uint32> UInt32Vector;
-  typedef NoThrowBuffer<uint8> UInt8Vector;
-  typedef NoThrowBuffer<OP> OPVector;
+  // The tables can get very large for big executables, and are only appended
+  // to, so they're chunked buffers that don't reallocate as they grow.
+  typedef NoThrowChunkedBuffer<RVA> RvaVector;
+  typedef NoThrowChunkedBuffer<uint32> UInt32Vector;
+  typedef NoThrowChunkedBuffer<uint8> UInt8Vector;
+  typedef NoThrowChunkedBuffer<OP> OPVector;
 
   void DebuggingSummary();
   CheckBool GeneratePeRelocations(SinkStream *buffer,
@@ -115,8 +117,9 @@ class EncodedProgram {
   UInt32Vector abs32_ix_;
 
   // Table of the addresses containing abs32 relocations; computed during
-  // assembly, used to generate base relocation table.
-  UInt32Vector abs32_relocs_;
+  // assembly, used to generate base relocation table.  It's sorted, so it
+  // has to be contiguous.
+  NoThrowBuffer<uint32> abs32_relocs_;
 
   DISALLOW_COPY_AND_ASSIGN(EncodedProgram);
 };
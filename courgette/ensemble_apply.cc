@@ -6,10 +6,13 @@
 
 #include "courgette/ensemble.h"
 
+#include <algorithm>
+
 #include "base/basictypes.h"
 #include "base/file_util.h"
 #include "base/files/memory_mapped_file.h"
 #include "base/logging.h"
+#include "base/metrics/histogram.h"
 #include "courgette/crc.h"
 #include "courgette/region.h"
 #include "courgette/streams.h"
@@ -53,12 +56,18 @@ class EnsemblePatchApplication {
                              SourceStream* correction,
                              SinkStream* corrected_ensemble);
 
+  // The largest number of bytes held at once in the intermediate buffers of
+  // the patch application (not counting the mapped inputs).
+  size_t peak_buffer_bytes() const { return peak_buffer_bytes_; }
+
  private:
   Status SubpatchStreamSets(SinkStreamSet* predicted_items,
                             SourceStream* correction,
                             SourceStreamSet* corrected_items,
                             SinkStream* corrected_items_storage);
 
+  void RecordBufferBytes(size_t bytes);
+
   Region base_region_;       // Location of in-memory copy of 'old' version.
 
   uint32 source_checksum_;
@@ -70,12 +79,15 @@ class EnsemblePatchApplication {
   SinkStream corrected_parameters_storage_;
   SinkStream corrected_elements_storage_;
 
+  size_t peak_buffer_bytes_;
+
   DISALLOW_COPY_AND_ASSIGN(EnsemblePatchApplication);
 };
 
 EnsemblePatchApplication::EnsemblePatchApplication()
     : source_checksum_(0), target_checksum_(0),
-      final_patch_input_size_prediction_(0) {
+      final_patch_input_size_prediction_(0),
+      peak_buffer_bytes_(0) {
 }
 
 EnsemblePatchApplication::~EnsemblePatchApplication() {
@@ -216,6 +228,10 @@ Status EnsemblePatchApplication::TransformUp(
 
   if (!parameters->Empty())
     return C_STREAM_NOT_CONSUMED;
+  // We have totally consumed parameters, so can free the storage to which it
+  // referred.
+  corrected_parameters_storage_.Retire();
+
   return C_OK;
 }
 
@@ -256,6 +272,8 @@ Status EnsemblePatchApplication::TransformDown(
 
   if (!transformed_elements->Empty())
     return C_STREAM_NOT_CONSUMED;
+  RecordBufferBytes(basic_elements->Length() +
+                    corrected_elements_storage_.Length());
   // We have totally consumed transformed_elements, so can free the
   // storage to which it referred.
   corrected_elements_storage_.Retire();
@@ -271,6 +289,7 @@ Status EnsemblePatchApplication::SubpatchFinalOutput(
                                          corrected_ensemble);
   if (delta_status != C_OK)
     return delta_status;
+  RecordBufferBytes(original->OriginalLength() + corrected_ensemble->Length());
 
   if (CalculateCrc(corrected_ensemble->Buffer(),
                    corrected_ensemble->Length()) != target_checksum_)
@@ -296,6 +315,9 @@ Status EnsemblePatchApplication::SubpatchStreamSets(
                                    corrected_items_storage);
   if (status != C_OK)
     return status;
+  RecordBufferBytes(linearized_predicted_items.Length() +
+                    corrected_parameters_storage_.Length() +
+                    corrected_elements_storage_.Length());
 
   if (!corrected_items->Init(corrected_items_storage->Buffer(),
                              corrected_items_storage->Length()))
@@ -304,6 +326,10 @@ Status EnsemblePatchApplication::SubpatchStreamSets(
   return C_OK;
 }
 
+void EnsemblePatchApplication::RecordBufferBytes(size_t bytes) {
+  peak_buffer_bytes_ = std::max(peak_buffer_bytes_, bytes);
+}
+
 Status ApplyEnsemblePatch(SourceStream* base,
                           SourceStream* patch,
                           SinkStream* output) {
@@ -375,6 +401,8 @@ Status ApplyEnsemblePatch(SourceStream* base,
   if (status != C_OK)
     return status;
 
+  UMA_HISTOGRAM_MEMORY_KB("Courgette.ApplyPatchPeakBufferKB",
+                          patch_process.peak_buffer_bytes() / 1024);
   return C_OK;
 }
 
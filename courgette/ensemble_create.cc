@@ -18,7 +18,12 @@
 #include <vector>
 
 #include "base/basictypes.h"
+#include "base/bind.h"
+#include "base/callback.h"
 #include "base/logging.h"
+#include "base/memory/scoped_vector.h"
+#include "base/sys_info.h"
+#include "base/threading/simple_thread.h"
 #include "base/time/time.h"
 
 #include "courgette/crc.h"
@@ -33,6 +38,63 @@
 
 namespace courgette {
 
+namespace {
+
+class ClosureDelegate : public base::DelegateSimpleThread::Delegate {
+ public:
+  explicit ClosureDelegate(const base::Closure& closure) : closure_(closure) {}
+  virtual void Run() OVERRIDE { closure_.Run(); }
+
+ private:
+  base::Closure closure_;
+  DISALLOW_COPY_AND_ASSIGN(ClosureDelegate);
+};
+
+// Runs all the |tasks|, which must be independent of each other, on a pool of
+// worker threads, and returns when they are all done.  The elements of an
+// ensemble are processed this way, and their results are then used in their
+// original order, so the patch doesn't depend on the scheduling.
+void RunTasks(const std::vector<base::Closure>& tasks) {
+  int num_threads = std::min(static_cast<int>(tasks.size()),
+                             base::SysInfo::NumberOfProcessors());
+  if (num_threads <= 1) {
+    for (size_t i = 0;  i < tasks.size();  ++i)
+      tasks[i].Run();
+    return;
+  }
+
+  ScopedVector<ClosureDelegate> delegates;
+  base::DelegateSimpleThreadPool pool("CourgetteWorker", num_threads);
+  for (size_t i = 0;  i < tasks.size();  ++i) {
+    delegates.push_back(new ClosureDelegate(tasks[i]));
+    pool.AddWork(delegates.back());
+  }
+  pool.Start();
+  pool.JoinAll();
+}
+
+void FindEmbeddedElements(Ensemble* ensemble) {
+  ensemble->FindEmbeddedElements();
+}
+
+void MakeBase(DifferenceEstimator* difference_estimator,
+              Element* element,
+              DifferenceEstimator::Base** base) {
+  *base = difference_estimator->MakeBase(element->region());
+}
+
+void Transform(TransformationPatchGenerator* generator,
+               SourceStreamSet* corrected_parameters,
+               SinkStreamSet* predicted_transformed_element,
+               SinkStreamSet* corrected_transformed_element,
+               Status* status) {
+  *status = generator->Transform(corrected_parameters,
+                                 predicted_transformed_element,
+                                 corrected_transformed_element);
+}
+
+}  // namespace
+
 TransformationPatchGenerator::TransformationPatchGenerator(
     Element* old_element,
     Element* new_element,
@@ -133,6 +195,67 @@ bool UnsafeDifference(Element* old_element, Element* new_element) {
   return true;
 }
 
+namespace {
+
+// Finds the element of |old_elements| that is the closest match to
+// |new_element|, and sets |*best_old_element| to it, or to NULL if there is no
+// suitable match (or if |new_element| is identical to one of them).
+void FindBestMatch(DifferenceEstimator* difference_estimator,
+                   const std::vector<Element*>* old_elements,
+                   const std::vector<DifferenceEstimator::Base*>* bases,
+                   Element* new_element,
+                   Element** best_old_element,
+                   size_t* best_difference) {
+  DifferenceEstimator::Subject* new_subject =
+      difference_estimator->MakeSubject(new_element->region());
+
+  // Search through old elements to find the best match.
+  //
+  // TODO(sra): This is O(N x M), i.e. O(N^2) since old_ensemble and
+  // new_ensemble probably have a very similar structure.  We can make the
+  // search faster by making the comparison provided by DifferenceEstimator
+  // more nuanced, returning early if the measured difference is greater than
+  // the current best.  This will be most effective if we can arrange that the
+  // first elements we try to match are likely the 'right' ones.  We could
+  // prioritize elements that are of a similar size or similar position in the
+  // sequence of elements.
+  //
+  *best_old_element = NULL;
+  *best_difference = std::numeric_limits<size_t>::max();
+  for (size_t old_index = 0;  old_index < old_elements->size();  ++old_index) {
+    Element* old_element = (*old_elements)[old_index];
+    // Elements of different kinds are incompatible.
+    if (old_element->kind() != new_element->kind())
+      continue;
+
+    if (UnsafeDifference(old_element, new_element))
+      continue;
+
+    base::Time start_compare = base::Time::Now();
+    DifferenceEstimator::Base* old_base = (*bases)[old_index];
+    size_t difference = difference_estimator->Measure(old_base, new_subject);
+
+    VLOG(1) << "Compare " << old_element->Name()
+            << " to " << new_element->Name()
+            << " --> " << difference
+            << " in " << (base::Time::Now() - start_compare).InSecondsF()
+            << "s";
+    if (difference == 0) {
+      VLOG(1) << "Skip " << new_element->Name()
+              << " - identical to " << old_element->Name();
+      *best_difference = 0;
+      *best_old_element = NULL;
+      break;
+    }
+    if (difference < *best_difference) {
+      *best_difference = difference;
+      *best_old_element = old_element;
+    }
+  }
+}
+
+}  // namespace
+
 // FindGenerators finds TransformationPatchGenerators for the elements of
 // |new_ensemble|.  For each element of |new_ensemble| we find the closest
 // matching element from |old_ensemble| and use that as the basis for
@@ -142,8 +265,10 @@ bool UnsafeDifference(Element* old_element, Element* new_element) {
 Status FindGenerators(Ensemble* old_ensemble, Ensemble* new_ensemble,
                       std::vector<TransformationPatchGenerator*>* generators) {
   base::Time start_find_time = base::Time::Now();
-  old_ensemble->FindEmbeddedElements();
-  new_ensemble->FindEmbeddedElements();
+  std::vector<base::Closure> find_tasks;
+  find_tasks.push_back(base::Bind(&FindEmbeddedElements, old_ensemble));
+  find_tasks.push_back(base::Bind(&FindEmbeddedElements, new_ensemble));
+  RunTasks(find_tasks);
   VLOG(1) << "done FindEmbeddedElements "
           << (base::Time::Now() - start_find_time).InSecondsF();
 
@@ -154,69 +279,37 @@ Status FindGenerators(Ensemble* old_ensemble, Ensemble* new_ensemble,
   VLOG(1) << "new has " << new_elements.size() << " elements";
 
   DifferenceEstimator difference_estimator;
-  std::vector<DifferenceEstimator::Base*> bases;
+  std::vector<DifferenceEstimator::Base*> bases(old_elements.size());
 
   base::Time start_bases_time = base::Time::Now();
+  std::vector<base::Closure> base_tasks;
   for (size_t i = 0;  i < old_elements.size();  ++i) {
-    bases.push_back(
-        difference_estimator.MakeBase(old_elements[i]->region()));
+    base_tasks.push_back(base::Bind(&MakeBase, &difference_estimator,
+                                    old_elements[i], &bases[i]));
   }
+  RunTasks(base_tasks);
   VLOG(1) << "done make bases "
           << (base::Time::Now() - start_bases_time).InSecondsF() << "s";
 
+  std::vector<Element*> best_old_elements(new_elements.size());
+  std::vector<size_t> best_differences(new_elements.size());
+  std::vector<base::Closure> match_tasks;
   for (size_t new_index = 0;  new_index < new_elements.size();  ++new_index) {
-    Element* new_element = new_elements[new_index];
-    DifferenceEstimator::Subject* new_subject =
-        difference_estimator.MakeSubject(new_element->region());
-
-    // Search through old elements to find the best match.
-    //
-    // TODO(sra): This is O(N x M), i.e. O(N^2) since old_ensemble and
-    // new_ensemble probably have a very similar structure.  We can make the
-    // search faster by making the comparison provided by DifferenceEstimator
-    // more nuanced, returning early if the measured difference is greater than
-    // the current best.  This will be most effective if we can arrange that the
-    // first elements we try to match are likely the 'right' ones.  We could
-    // prioritize elements that are of a similar size or similar position in the
-    // sequence of elements.
-    //
-    Element* best_old_element = NULL;
-    size_t best_difference = std::numeric_limits<size_t>::max();
-    for (size_t old_index = 0;  old_index < old_elements.size();  ++old_index) {
-      Element* old_element = old_elements[old_index];
-      // Elements of different kinds are incompatible.
-      if (old_element->kind() != new_element->kind())
-        continue;
-
-      if (UnsafeDifference(old_element, new_element))
-        continue;
-
-      base::Time start_compare = base::Time::Now();
-      DifferenceEstimator::Base* old_base = bases[old_index];
-      size_t difference = difference_estimator.Measure(old_base, new_subject);
-
-      VLOG(1) << "Compare " << old_element->Name()
-              << " to " << new_element->Name()
-              << " --> " << difference
-              << " in " << (base::Time::Now() - start_compare).InSecondsF()
-              << "s";
-      if (difference == 0) {
-        VLOG(1) << "Skip " << new_element->Name()
-                << " - identical to " << old_element->Name();
-        best_difference = 0;
-        best_old_element = NULL;
-        break;
-      }
-      if (difference < best_difference) {
-        best_difference = difference;
-        best_old_element = old_element;
-      }
-    }
+    match_tasks.push_back(base::Bind(&FindBestMatch, &difference_estimator,
+                                     &old_elements, &bases,
+                                     new_elements[new_index],
+                                     &best_old_elements[new_index],
+                                     &best_differences[new_index]));
+  }
+  RunTasks(match_tasks);
 
+  for (size_t new_index = 0;  new_index < new_elements.size();  ++new_index) {
+    Element* new_element = new_elements[new_index];
+    Element* best_old_element = best_old_elements[new_index];
     if (best_old_element) {
       VLOG(1) << "Matched " << best_old_element->Name()
               << " to " << new_element->Name()
-              << " --> " << best_difference;
+              << " --> " << best_differences[new_index];
       TransformationPatchGenerator* generator =
           MakeGenerator(best_old_element, new_element);
       if (generator)
@@ -335,27 +428,42 @@ Status GenerateEnsemblePatch(SourceStream* base,
   SinkStreamSet predicted_transformed_elements;
   SinkStreamSet corrected_transformed_elements;
 
+  // Transforming an element (disassembling, adjusting and encoding it) is by
+  // far the most expensive step, and is independent for each element, so all
+  // of them are transformed concurrently.
+  ScopedVector<SourceStreamSet> all_parameters;
+  ScopedVector<SinkStreamSet> all_predicted_transformed_elements;
+  ScopedVector<SinkStreamSet> all_corrected_transformed_elements;
+  std::vector<Status> transform_statuses(number_of_transformations, C_OK);
+  std::vector<base::Closure> transform_tasks;
   for (size_t i = 0;  i < number_of_transformations;  ++i) {
-    SourceStreamSet single_parameters;
-    if (!corrected_parameters_source_set.ReadSet(&single_parameters))
+    all_parameters.push_back(new SourceStreamSet());
+    if (!corrected_parameters_source_set.ReadSet(all_parameters[i]))
       return C_STREAM_ERROR;
-    SinkStreamSet single_predicted_transformed_element;
-    SinkStreamSet single_corrected_transformed_element;
-    Status status = generators[i]->Transform(
-        &single_parameters,
-        &single_predicted_transformed_element,
-        &single_corrected_transformed_element);
-    if (status != C_OK)
-      return status;
-    if (!single_parameters.Empty())
+    all_predicted_transformed_elements.push_back(new SinkStreamSet());
+    all_corrected_transformed_elements.push_back(new SinkStreamSet());
+    transform_tasks.push_back(
+        base::Bind(&Transform, generators[i], all_parameters[i],
+                   all_predicted_transformed_elements[i],
+                   all_corrected_transformed_elements[i],
+                   &transform_statuses[i]));
+  }
+  RunTasks(transform_tasks);
+
+  for (size_t i = 0;  i < number_of_transformations;  ++i) {
+    if (transform_statuses[i] != C_OK)
+      return transform_statuses[i];
+    if (!all_parameters[i]->Empty())
       return C_STREAM_NOT_CONSUMED;
     if (!predicted_transformed_elements.WriteSet(
-            &single_predicted_transformed_element))
+            all_predicted_transformed_elements[i]))
       return C_STREAM_ERROR;
     if (!corrected_transformed_elements.WriteSet(
-            &single_corrected_transformed_element))
+            all_corrected_transformed_elements[i]))
       return C_STREAM_ERROR;
   }
+  all_predicted_transformed_elements.clear();
+  all_corrected_transformed_elements.clear();
 
   if (!corrected_parameters_source_set.Empty())
     return C_STREAM_NOT_CONSUMED;
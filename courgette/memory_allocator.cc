@@ -5,9 +5,77 @@
 #include "courgette/memory_allocator.h"
 
 #include <map>
+#include <vector>
 
 #include "base/file_util.h"
+#include "base/lazy_instance.h"
 #include "base/strings/stringprintf.h"
+#include "base/synchronization/lock.h"
+
+namespace courgette {
+
+namespace {
+
+// The chunks are allocated as arrays of this type, for their alignment.
+typedef uint64 ChunkUnit;
+const size_t kChunkUnits = ChunkPool::kChunkSize / sizeof(ChunkUnit);
+
+struct FreeChunks {
+  base::Lock lock;
+  std::vector<void*> chunks;
+};
+
+base::LazyInstance<FreeChunks>::Leaky g_free_chunks =
+    LAZY_INSTANCE_INITIALIZER;
+
+}  // namespace
+
+// ChunkPool
+
+// static
+void* ChunkPool::AllocateChunk() {
+  FreeChunks* free_chunks = g_free_chunks.Pointer();
+  {
+    base::AutoLock lock(free_chunks->lock);
+    if (!free_chunks->chunks.empty()) {
+      void* chunk = free_chunks->chunks.back();
+      free_chunks->chunks.pop_back();
+      return chunk;
+    }
+  }
+  return MemoryAllocator<ChunkUnit>().allocate(kChunkUnits);
+}
+
+// static
+void ChunkPool::FreeChunk(void* chunk) {
+  DCHECK(chunk);
+  FreeChunks* free_chunks = g_free_chunks.Pointer();
+  {
+    base::AutoLock lock(free_chunks->lock);
+    if (free_chunks->chunks.size() < kMaxPooledChunks) {
+      free_chunks->chunks.push_back(chunk);
+      return;
+    }
+  }
+  MemoryAllocator<ChunkUnit>().deallocate(static_cast<ChunkUnit*>(chunk),
+                                          kChunkUnits);
+}
+
+// static
+void ChunkPool::ReleaseFreeChunks() {
+  std::vector<void*> chunks;
+  {
+    FreeChunks* free_chunks = g_free_chunks.Pointer();
+    base::AutoLock lock(free_chunks->lock);
+    chunks.swap(free_chunks->chunks);
+  }
+  for (size_t i = 0; i < chunks.size(); ++i) {
+    MemoryAllocator<ChunkUnit>().deallocate(static_cast<ChunkUnit*>(chunks[i]),
+                                            kChunkUnits);
+  }
+}
+
+}  // namespace courgette
 
 #if defined(OS_WIN)
 
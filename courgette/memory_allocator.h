@@ -5,6 +5,9 @@
 #ifndef COURGETTE_MEMORY_ALLOCATOR_H_
 #define COURGETTE_MEMORY_ALLOCATOR_H_
 
+#include <string.h>
+
+#include <algorithm>
 #include <memory>
 
 #include "base/basictypes.h"
@@ -315,6 +318,30 @@ class MemoryAllocator {
 
 #endif  // OS_WIN
 
+// Hands out the fixed size chunks of memory that NoThrowChunkedBuffer is made
+// of.  Released chunks are kept, up to |kMaxPooledChunks| of them, so that the
+// buffers of the next program being assembled or encoded reuse them instead of
+// going back to the heap (or to a new temp file mapping).  This class is
+// thread safe.
+class ChunkPool {
+ public:
+  static const size_t kChunkSize = 256 * 1024;
+  static const size_t kMaxPooledChunks = 256;
+
+  // Returns a chunk of |kChunkSize| bytes, aligned for any type the buffers
+  // hold, or NULL on allocation failure.
+  static void* AllocateChunk();
+
+  // Gives |chunk| back to the pool.
+  static void FreeChunk(void* chunk);
+
+  // Frees all the chunks the pool is holding on to.
+  static void ReleaseFreeChunks();
+
+ private:
+  DISALLOW_IMPLICIT_CONSTRUCTORS(ChunkPool);
+};
+
 // Manages a growable buffer.  The buffer allocation is done by the
 // MemoryAllocator class.  This class will not throw exceptions so call sites
 // must be prepared to handle memory allocation failures.
@@ -485,6 +512,163 @@ class NoThrowBuffer {
   Allocator alloc_;
 };
 
+// A growable buffer with the same interface as NoThrowBuffer (except for
+// begin() and end()), made of chunks from ChunkPool.  Growing it never moves
+// the elements already in it, so unlike NoThrowBuffer it doesn't need twice
+// its size while it grows, and doesn't spend time copying itself over and over
+// as it's filled.  The elements aren't contiguous though: DataAt() gives the
+// contiguous runs.  Like NoThrowBuffer, this is meant for plain data types.
+template<typename T>
+class NoThrowChunkedBuffer {
+ public:
+  typedef T value_type;
+  static const size_t kChunkLength = ChunkPool::kChunkSize / sizeof(T);
+
+  NoThrowChunkedBuffer() : size_(0), failed_(false) {
+  }
+
+  ~NoThrowChunkedBuffer() {
+    clear();
+  }
+
+  void clear() {
+    for (size_t i = 0; i < chunks_.size(); ++i)
+      ChunkPool::FreeChunk(chunks_[i]);
+    chunks_.clear();
+    size_ = 0;
+    failed_ = false;
+  }
+
+  bool empty() const {
+    return size_ == 0;
+  }
+
+  // Since growing is cheap, this only makes room for the chunk pointers; the
+  // chunks themselves are added as elements are.
+  CheckBool reserve(size_t size) WARN_UNUSED_RESULT {
+    if (failed())
+      return false;
+
+    if (!chunks_.reserve(size / kChunkLength + 1)) {
+      clear();
+      failed_ = true;
+      return false;
+    }
+    return true;
+  }
+
+  CheckBool append(const T* data, size_t size) WARN_UNUSED_RESULT {
+    if (failed())
+      return false;
+
+    while (size) {
+      if (size_ == capacity() && !AddChunk())
+        return false;
+      size_t offset = size_ % kChunkLength;
+      size_t count = std::min(size, kChunkLength - offset);
+      memcpy(chunks_[size_ / kChunkLength] + offset, data, count * sizeof(T));
+      data += count;
+      size -= count;
+      size_ += count;
+    }
+
+    return true;
+  }
+
+  CheckBool resize(size_t size, const T& init_value) WARN_UNUSED_RESULT {
+    if (failed())
+      return false;
+
+    while (size_ < size) {
+      if (size_ == capacity() && !AddChunk())
+        return false;
+      size_t offset = size_ % kChunkLength;
+      size_t count = std::min(size - size_, kChunkLength - offset);
+      std::fill_n(chunks_[size_ / kChunkLength] + offset, count, init_value);
+      size_ += count;
+    }
+
+    size_ = size;
+
+    return true;
+  }
+
+  CheckBool push_back(const T& item) WARN_UNUSED_RESULT {
+    if (size_ == capacity() && !AddChunk())
+      return false;
+    chunks_[size_ / kChunkLength][size_ % kChunkLength] = item;
+    ++size_;
+    return true;
+  }
+
+  const T& back() const {
+    return (*this)[size_ - 1];
+  }
+
+  T& back() {
+    return (*this)[size_ - 1];
+  }
+
+  const T& operator[](size_t index) const {
+    DCHECK(index < size_);
+    return chunks_[index / kChunkLength][index % kChunkLength];
+  }
+
+  T& operator[](size_t index) {
+    DCHECK(index < size_);
+    return chunks_[index / kChunkLength][index % kChunkLength];
+  }
+
+  // Returns a pointer to the element at |index|, and sets |*count| to the
+  // number of elements stored contiguously from there.
+  const T* DataAt(size_t index, size_t* count) const {
+    DCHECK(index < size_);
+    *count = std::min(size_ - index, kChunkLength - index % kChunkLength);
+    return &(*this)[index];
+  }
+
+  T* DataAt(size_t index, size_t* count) {
+    DCHECK(index < size_);
+    *count = std::min(size_ - index, kChunkLength - index % kChunkLength);
+    return &(*this)[index];
+  }
+
+  size_t size() const {
+    return size_;
+  }
+
+  // Returns true if an allocation failure has ever occurred for this object.
+  bool failed() const {
+    return failed_;
+  }
+
+ private:
+  size_t capacity() const {
+    return chunks_.size() * kChunkLength;
+  }
+
+  bool AddChunk() {
+    void* chunk = ChunkPool::AllocateChunk();
+    if (!chunk || !chunks_.push_back(static_cast<T*>(chunk))) {
+      if (chunk)
+        ChunkPool::FreeChunk(chunk);
+      clear();
+      failed_ = true;
+      return false;
+    }
+    return true;
+  }
+
+  NoThrowBuffer<T*> chunks_;
+  size_t size_;
+  bool failed_;
+
+  DISALLOW_COPY_AND_ASSIGN(NoThrowChunkedBuffer);
+};
+
+template<typename T>
+const size_t NoThrowChunkedBuffer<T>::kChunkLength;
+
 }  // namespace courgette
 
 #endif  // COURGETTE_MEMORY_ALLOCATOR_H_
@@ -0,0 +1,78 @@
+// Copyright 2014 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "courgette/memory_allocator.h"
+
+#include "testing/gtest/include/gtest/gtest.h"
+
+TEST(MemoryAllocatorTest, ChunkedBufferGrowsInPlace) {
+  typedef courgette::NoThrowChunkedBuffer<uint32> Buffer;
+  const size_t kCount = 3 * Buffer::kChunkLength + 10;
+
+  Buffer buffer;
+  EXPECT_TRUE(buffer.empty());
+  EXPECT_TRUE(buffer.reserve(kCount));
+  EXPECT_TRUE(buffer.push_back(0));
+  const uint32* first = &buffer[0];
+  for (uint32 i = 1; i < kCount; ++i)
+    EXPECT_TRUE(buffer.push_back(i));
+
+  // The elements didn't move as the buffer grew.
+  EXPECT_EQ(first, &buffer[0]);
+  ASSERT_EQ(kCount, buffer.size());
+  for (uint32 i = 0; i < kCount; ++i)
+    EXPECT_EQ(i, buffer[i]);
+  EXPECT_EQ(kCount - 1, buffer.back());
+  EXPECT_FALSE(buffer.failed());
+
+  // The contiguous runs end at the chunk boundaries, and at the end.
+  size_t count = 0;
+  EXPECT_EQ(first, buffer.DataAt(0, &count));
+  EXPECT_EQ(Buffer::kChunkLength, count);
+  EXPECT_EQ(&buffer[5], buffer.DataAt(5, &count));
+  EXPECT_EQ(Buffer::kChunkLength - 5, count);
+  buffer.DataAt(3 * Buffer::kChunkLength, &count);
+  EXPECT_EQ(10U, count);
+
+  buffer.clear();
+  EXPECT_TRUE(buffer.empty());
+}
+
+TEST(MemoryAllocatorTest, ChunkedBufferAppendAndResize) {
+  typedef courgette::NoThrowChunkedBuffer<uint8> Buffer;
+  const size_t kLength = Buffer::kChunkLength + 100;
+
+  uint8 data[300];
+  for (size_t i = 0; i < sizeof(data); ++i)
+    data[i] = static_cast<uint8>(i);
+
+  // Appends that straddle chunks.
+  Buffer buffer;
+  EXPECT_TRUE(buffer.resize(kLength - 100, 7));
+  EXPECT_TRUE(buffer.append(data, sizeof(data)));
+  ASSERT_EQ(kLength + 200, buffer.size());
+  EXPECT_EQ(7, buffer[0]);
+  EXPECT_EQ(7, buffer[kLength - 101]);
+  for (size_t i = 0; i < sizeof(data); ++i)
+    EXPECT_EQ(data[i], buffer[kLength - 100 + i]);
+
+  // Shrinking keeps the first elements, and growing again initializes the new
+  // ones.
+  EXPECT_TRUE(buffer.resize(10, 0));
+  EXPECT_EQ(10U, buffer.size());
+  EXPECT_TRUE(buffer.resize(kLength, 3));
+  EXPECT_EQ(7, buffer[9]);
+  EXPECT_EQ(3, buffer[10]);
+  EXPECT_EQ(3, buffer[kLength - 1]);
+}
+
+TEST(MemoryAllocatorTest, ChunkPoolReusesChunks) {
+  courgette::ChunkPool::ReleaseFreeChunks();
+  void* chunk = courgette::ChunkPool::AllocateChunk();
+  ASSERT_TRUE(chunk != NULL);
+  courgette::ChunkPool::FreeChunk(chunk);
+  EXPECT_EQ(chunk, courgette::ChunkPool::AllocateChunk());
+  courgette::ChunkPool::FreeChunk(chunk);
+  courgette::ChunkPool::ReleaseFreeChunks();
+}
@@ -32,6 +32,8 @@
  *                --Stephen Adams <sra@chromium.org>
  * 2013-04-10 - Added wrapper to apply a patch directly to files.
  *                --Joshua Pawlicki <waffles@chromium.org>
+ * 2014-06-02 - Added BSDiffSuffixArray, so that the suffix array of an 'old'
+ *              file can be reused to create many patches.
  */
 
 #ifndef COURGETTE_BSDIFF_H_
@@ -39,6 +41,7 @@
 
 #include "base/basictypes.h"
 #include "base/file_util.h"
+#include "courgette/third_party/paged_array.h"
 
 namespace courgette {
 
@@ -54,12 +57,46 @@ enum BSDiffStatus {
 class SourceStream;
 class SinkStream;
 
+// The sorted suffixes of an 'old' file.  Sorting them is most of the work of
+// creating a patch, so when patching the same 'old' file to many 'new' files,
+// the BSDiffSuffixArray can be built once and passed to each
+// CreateBinaryPatch().
+class BSDiffSuffixArray {
+ public:
+  BSDiffSuffixArray();
+  ~BSDiffSuffixArray();
+
+  // Sorts the suffixes of the remaining bytes of |old_stream|, which is not
+  // consumed.
+  BSDiffStatus Init(SourceStream* old_stream);
+
+  // The size of the 'old' file.
+  int size() const { return size_; }
+
+  // |suffixes()[i]| is the position of the i-th smallest suffix, for i in
+  // [0, size()].  The empty suffix, at |size()|, is first.
+  const PagedArray<int>& suffixes() const { return suffixes_; }
+
+ private:
+  int size_;
+  PagedArray<int> suffixes_;
+
+  DISALLOW_COPY_AND_ASSIGN(BSDiffSuffixArray);
+};
+
 // Creates a binary patch.
 //
 BSDiffStatus CreateBinaryPatch(SourceStream* old_stream,
                                SourceStream* new_stream,
                                SinkStream* patch_stream);
 
+// As above, but uses the already sorted suffixes of |old_stream|, which must
+// have been initialized from the same bytes.
+BSDiffStatus CreateBinaryPatch(const BSDiffSuffixArray& old_suffixes,
+                               SourceStream* old_stream,
+                               SourceStream* new_stream,
+                               SinkStream* patch_stream);
+
 // Applies the given patch file to a given source file. This method validates
 // the CRC of the original file stored in the patch file, before applying the
 // patch to it.
@@ -20,12 +20,16 @@
   2010-05-26 - Use a paged array for V and I. The address space may be too
                fragmented for these big arrays to be contiguous.
                  --Stephen Adams <sra@chromium.org>
+  2014-06-02 - Sort the suffixes with SA-IS instead of qsufsort, and search
+               them skipping the prefix already known to match.  Allow the
+               suffix array of the old file to be reused for many patches.
 */
 
 #include "courgette/third_party/bsdiff.h"
 
 #include <stdlib.h>
 #include <algorithm>
+#include <vector>
 
 #include "base/logging.h"
 #include "base/memory/scoped_ptr.h"
@@ -40,155 +44,234 @@ namespace courgette {
 
 // ------------------------------------------------------------------------
 //
-// The following code is taken verbatim from 'bsdiff.c'. Please keep all the
-// code formatting and variable names.  The changes from the original are (1)
-// replacing tabs with spaces, (2) indentation, (3) using 'const', and (4)
-// changing the V and I parameters from int* to PagedArray<int>&.
+// The suffixes of the 'old' file are sorted with SA-IS, from "Two Efficient
+// Algorithms for Linear Time Suffix Array Construction" by Ge Nong, Sen Zhang
+// and Wai Hong Chan.  This replaces the O(N log N) qsufsort of the original
+// bsdiff.c, and produces the same suffix array.
 //
-// The code appears to be a rewritten version of the suffix array algorithm
-// presented in "Faster Suffix Sorting" by N. Jesper Larsson and Kunihiko
-// Sadakane, special cased for bytes.
+// The strings being sorted are terminated by a virtual sentinel which is
+// smaller than any character, so a string of |n| characters has |n| suffixes to
+// sort (the empty suffix is implicitly the smallest).  A suffix is 'S-type' if
+// it is smaller than the following suffix, and 'L-type' otherwise.  An
+// S-type suffix after an L-type one is 'left-most S-type', or 'LMS'.
+
+namespace {
+
+// An array of ints starting at |offset| in a PagedArray<int>.  The recursive
+// steps of SA-IS use parts of the suffix array for their strings and suffix
+// arrays.
+class PagedArraySlice {
+ public:
+  PagedArraySlice(PagedArray<int>* array, size_t offset)
+      : array_(array), offset_(offset) {}
+
+  int& operator[](size_t i) const { return (*array_)[offset_ + i]; }
+
+  PagedArraySlice Slice(size_t offset) const {
+    return PagedArraySlice(array_, offset_ + offset);
+  }
 
-static void
-split(PagedArray<int>& I,PagedArray<int>& V,int start,int len,int h)
-{
-  int i,j,k,x,tmp,jj,kk;
-
-  if(len<16) {
-    for(k=start;k<start+len;k+=j) {
-      j=1;x=V[I[k]+h];
-      for(i=1;k+i<start+len;i++) {
-        if(V[I[k+i]+h]<x) {
-          x=V[I[k+i]+h];
-          j=0;
-        };
-        if(V[I[k+i]+h]==x) {
-          tmp=I[k+j];I[k+j]=I[k+i];I[k+i]=tmp;
-          j++;
-        };
-      };
-      for(i=0;i<j;i++) V[I[k+i]]=k+j-1;
-      if(j==1) I[k]=-1;
-    };
-    return;
-  };
-
-  x=V[I[start+len/2]+h];
-  jj=0;kk=0;
-  for(i=start;i<start+len;i++) {
-    if(V[I[i]+h]<x) jj++;
-    if(V[I[i]+h]==x) kk++;
-  };
-  jj+=start;kk+=jj;
-
-  i=start;j=0;k=0;
-  while(i<jj) {
-    if(V[I[i]+h]<x) {
-      i++;
-    } else if(V[I[i]+h]==x) {
-      tmp=I[i];I[i]=I[jj+j];I[jj+j]=tmp;
-      j++;
-    } else {
-      tmp=I[i];I[i]=I[kk+k];I[kk+k]=tmp;
-      k++;
-    };
-  };
-
-  while(jj+j<kk) {
-    if(V[I[jj+j]+h]==x) {
-      j++;
-    } else {
-      tmp=I[jj+j];I[jj+j]=I[kk+k];I[kk+k]=tmp;
-      k++;
-    };
-  };
+ private:
+  PagedArray<int>* array_;
+  size_t offset_;
+};
 
-  if(jj>start) split(I,V,start,jj-start,h);
+bool IsLMS(const std::vector<bool>& is_s, int i) {
+  return i > 0 && is_s[i] && !is_s[i - 1];
+}
 
-  for(i=0;i<kk-jj;i++) V[I[jj+i]]=kk-1;
-  if(jj==kk-1) I[jj]=-1;
+void SetBucketStarts(const std::vector<int>& counts, std::vector<int>* bucket) {
+  int sum = 0;
+  for (size_t c = 0;  c < counts.size();  ++c) {
+    (*bucket)[c] = sum;
+    sum += counts[c];
+  }
+}
 
-  if(start+len>kk) split(I,V,kk,start+len-kk,h);
+void SetBucketEnds(const std::vector<int>& counts, std::vector<int>* bucket) {
+  int sum = 0;
+  for (size_t c = 0;  c < counts.size();  ++c) {
+    sum += counts[c];
+    (*bucket)[c] = sum;
+  }
 }
 
-static void
-qsufsort(PagedArray<int>& I, PagedArray<int>& V,const unsigned char *old,int oldsize)
-{
-  int buckets[256];
-  int i,h,len;
-
-  for(i=0;i<256;i++) buckets[i]=0;
-  for(i=0;i<oldsize;i++) buckets[old[i]]++;
-  for(i=1;i<256;i++) buckets[i]+=buckets[i-1];
-  for(i=255;i>0;i--) buckets[i]=buckets[i-1];
-  buckets[0]=0;
-
-  for(i=0;i<oldsize;i++) I[++buckets[old[i]]]=i;
-  I[0]=oldsize;
-  for(i=0;i<oldsize;i++) V[i]=buckets[old[i]];
-  V[oldsize]=0;
-  for(i=1;i<256;i++) if(buckets[i]==buckets[i-1]+1) I[buckets[i]]=-1;
-  I[0]=-1;
-
-  for(h=1;I[0]!=-(oldsize+1);h+=h) {
-    len=0;
-    for(i=0;i<oldsize+1;) {
-      if(I[i]<0) {
-        len-=I[i];
-        i-=I[i];
-      } else {
-        if(len) I[i-len]=-len;
-        len=V[I[i]]+1-i;
-        split(I,V,i,len,h);
-        i+=len;
-        len=0;
-      };
-    };
-    if(len) I[i-len]=-len;
-  };
+// Given the LMS suffixes in their buckets of |sa|, and the other entries set to
+// -1, sorts all the suffixes by inducing the order of the L-type suffixes from
+// the LMS suffixes, then the order of the S-type suffixes from the L-type ones.
+template <typename Text>
+void InduceSort(const Text& text, int n, const std::vector<bool>& is_s,
+                const std::vector<int>& counts, std::vector<int>* bucket,
+                const PagedArraySlice& sa) {
+  SetBucketStarts(counts, bucket);
+  // The suffix before the (virtual) empty suffix is L-type, and comes first.
+  sa[(*bucket)[text[n - 1]]++] = n - 1;
+  for (int i = 0;  i < n;  ++i) {
+    int j = sa[i] - 1;
+    if (j >= 0 && !is_s[j])
+      sa[(*bucket)[text[j]]++] = j;
+  }
 
-  for(i=0;i<oldsize+1;i++) I[V[i]]=i;
+  SetBucketEnds(counts, bucket);
+  for (int i = n - 1;  i >= 0;  --i) {
+    int j = sa[i] - 1;
+    if (j >= 0 && is_s[j])
+      sa[--(*bucket)[text[j]]] = j;
+  }
 }
 
-static int
-matchlen(const unsigned char *old,int oldsize,const unsigned char *newbuf,int newsize)
-{
-  int i;
+// Returns true if the LMS substrings (the characters from an LMS position to
+// the next one) at |a| and |b| are equal.
+template <typename Text>
+bool EqualLMSSubstrings(const Text& text, int n, const std::vector<bool>& is_s,
+                        int a, int b) {
+  for (int i = 0;  ;  ++i) {
+    // Only one substring ends with the sentinel.
+    if (a + i == n || b + i == n)
+      return false;
+    if (text[a + i] != text[b + i] || is_s[a + i] != is_s[b + i])
+      return false;
+    if (i > 0 && IsLMS(is_s, a + i))
+      return true;
+  }
+}
 
-  for(i=0;(i<oldsize)&&(i<newsize);i++)
-    if(old[i]!=newbuf[i]) break;
+// Sorts the |n| suffixes of |text|, whose characters are in
+// [0, |alphabet_size|), into |sa|.
+template <typename Text>
+void SuffixSort(const Text& text, int n, int alphabet_size,
+                const PagedArraySlice& sa) {
+  if (n == 0)
+    return;
 
-  return i;
-}
+  // |is_s[n]| is for the sentinel.
+  std::vector<bool> is_s(n + 1);
+  is_s[n] = true;
+  for (int i = n - 2;  i >= 0;  --i) {
+    is_s[i] = text[i] < text[i + 1] ||
+              (text[i] == text[i + 1] && is_s[i + 1]);
+  }
 
-static int
-search(PagedArray<int>& I,const unsigned char *old,int oldsize,
-       const unsigned char *newbuf,int newsize,int st,int en,int *pos)
-{
-  int x,y;
+  std::vector<int> counts(alphabet_size, 0);
+  std::vector<int> bucket(alphabet_size);
+  for (int i = 0;  i < n;  ++i)
+    ++counts[text[i]];
+
+  // Sort the LMS substrings, by inducing from the LMS suffixes in any order.
+  for (int i = 0;  i < n;  ++i)
+    sa[i] = -1;
+  SetBucketEnds(counts, &bucket);
+  for (int i = 1;  i < n;  ++i) {
+    if (IsLMS(is_s, i))
+      sa[--bucket[text[i]]] = i;
+  }
+  InduceSort(text, n, is_s, counts, &bucket, sa);
+
+  // Move the sorted LMS positions to the first |lms_count| entries, and name
+  // the LMS substrings by their rank.  LMS positions are at least two apart,
+  // so there are at most n / 2 of them, and the names can be stored at
+  // |sa[lms_count + position / 2]|.
+  int lms_count = 0;
+  for (int i = 0;  i < n;  ++i) {
+    if (IsLMS(is_s, sa[i]))
+      sa[lms_count++] = sa[i];
+  }
+  for (int i = lms_count;  i < n;  ++i)
+    sa[i] = -1;
+  int name_count = 0;
+  for (int i = 0;  i < lms_count;  ++i) {
+    if (i == 0 || !EqualLMSSubstrings(text, n, is_s, sa[i - 1], sa[i]))
+      ++name_count;
+    sa[lms_count + sa[i] / 2] = name_count - 1;
+  }
+
+  // The names, in the order of their positions, are the reduced string, kept
+  // in the last |lms_count| entries.  Its suffixes sort like the LMS suffixes.
+  for (int i = n - 1, j = n - 1;  i >= lms_count;  --i) {
+    if (sa[i] >= 0)
+      sa[j--] = sa[i];
+  }
+  const PagedArraySlice reduced_text = sa.Slice(n - lms_count);
+  if (name_count < lms_count) {
+    SuffixSort(reduced_text, lms_count, name_count, sa);
+  } else {
+    for (int i = 0;  i < lms_count;  ++i)
+      sa[reduced_text[i]] = i;
+  }
 
-  if(en-st<2) {
-    x=matchlen(old+I[st],oldsize-I[st],newbuf,newsize);
-    y=matchlen(old+I[en],oldsize-I[en],newbuf,newsize);
+  // Sort all the suffixes, by inducing from the sorted LMS suffixes.
+  for (int i = 1, j = 0;  i < n;  ++i) {
+    if (IsLMS(is_s, i))
+      reduced_text[j++] = i;
+  }
+  for (int i = 0;  i < lms_count;  ++i)
+    sa[i] = reduced_text[sa[i]];
+  for (int i = lms_count;  i < n;  ++i)
+    sa[i] = -1;
+  SetBucketEnds(counts, &bucket);
+  for (int i = lms_count - 1;  i >= 0;  --i) {
+    int position = sa[i];
+    sa[i] = -1;
+    sa[--bucket[text[position]]] = position;
+  }
+  InduceSort(text, n, is_s, counts, &bucket, sa);
+}
 
-    if(x>y) {
-      *pos=I[st];
-      return x;
+// Returns the length of the common prefix of |old| and |newbuf|, comparing a
+// word at a time.
+int matchlen(const unsigned char* old, int oldsize,
+             const unsigned char* newbuf, int newsize) {
+  int size = std::min(oldsize, newsize);
+  int i = 0;
+  for ( ;  i + static_cast<int>(sizeof(uint64)) <= size;
+       i += sizeof(uint64)) {
+    uint64 old_word;
+    uint64 new_word;
+    memcpy(&old_word, old + i, sizeof(old_word));
+    memcpy(&new_word, newbuf + i, sizeof(new_word));
+    if (old_word != new_word)
+      break;
+  }
+  while (i < size && old[i] == newbuf[i])
+    ++i;
+  return i;
+}
+
+// Finds the longest match of |newbuf| in |old| by binary search of the
+// suffixes in [st, en] of |I|.  The suffixes between two others share their
+// common prefix with |newbuf|, so each comparison skips it.
+int search(const PagedArray<int>& I, const unsigned char* old, int oldsize,
+           const unsigned char* newbuf, int newsize, int st, int en,
+           int* pos) {
+  int st_length = matchlen(old + I[st], oldsize - I[st], newbuf, newsize);
+  int en_length = matchlen(old + I[en], oldsize - I[en], newbuf, newsize);
+
+  while (en - st >= 2) {
+    int x = st + (en - st) / 2;
+    int skip = std::min(st_length, en_length);
+    int x_length = skip + matchlen(old + I[x] + skip, oldsize - I[x] - skip,
+                                   newbuf + skip, newsize - skip);
+    if (x_length < oldsize - I[x] && x_length < newsize &&
+        old[I[x] + x_length] < newbuf[x_length]) {
+      st = x;
+      st_length = x_length;
     } else {
-      *pos=I[en];
-      return y;
+      en = x;
+      en_length = x_length;
     }
   }
 
-  x=st+(en-st)/2;
-  if(memcmp(old+I[x],newbuf,std::min(oldsize-I[x],newsize))<0) {
-    return search(I,old,oldsize,newbuf,newsize,x,en,pos);
+  if (st_length > en_length) {
+    *pos = I[st];
+    return st_length;
   } else {
-    return search(I,old,oldsize,newbuf,newsize,st,x,pos);
+    *pos = I[en];
+    return en_length;
   }
 }
 
-//  End of 'verbatim' code.
+}  // namespace
+
 // ------------------------------------------------------------------------
 
 static CheckBool WriteHeader(SinkStream* stream, MBSPatchHeader* header) {
@@ -199,7 +282,42 @@ static CheckBool WriteHeader(SinkStream* stream, MBSPatchHeader* header) {
   return ok;
 }
 
+BSDiffSuffixArray::BSDiffSuffixArray() : size_(0) {
+}
+
+BSDiffSuffixArray::~BSDiffSuffixArray() {
+}
+
+BSDiffStatus BSDiffSuffixArray::Init(SourceStream* old_stream) {
+  const uint8* old = old_stream->Buffer();
+  size_ = static_cast<int>(old_stream->Remaining());
+
+  if (!suffixes_.Allocate(size_ + 1)) {
+    LOG(ERROR) << "Could not allocate I[], " << ((size_ + 1) * sizeof(int))
+               << " bytes";
+    return MEM_ERROR;
+  }
+
+  base::Time sort_start_time = base::Time::Now();
+  suffixes_[0] = size_;
+  SuffixSort(old, size_, 256, PagedArraySlice(&suffixes_, 1));
+  VLOG(1) << " done SuffixSort "
+          << (base::Time::Now() - sort_start_time).InSecondsF();
+  return OK;
+}
+
 BSDiffStatus CreateBinaryPatch(SourceStream* old_stream,
+                               SourceStream* new_stream,
+                               SinkStream* patch_stream) {
+  BSDiffSuffixArray old_suffixes;
+  BSDiffStatus status = old_suffixes.Init(old_stream);
+  if (status != OK)
+    return status;
+  return CreateBinaryPatch(old_suffixes, old_stream, new_stream, patch_stream);
+}
+
+BSDiffStatus CreateBinaryPatch(const BSDiffSuffixArray& old_suffixes,
+                               SourceStream* old_stream,
                                SourceStream* new_stream,
                                SinkStream* patch_stream)
 {
@@ -220,26 +338,11 @@ BSDiffStatus CreateBinaryPatch(SourceStream* old_stream,
 
   uint32 pending_diff_zeros = 0;
 
-  PagedArray<int> I;
-  PagedArray<int> V;
-
-  if (!I.Allocate(oldsize + 1)) {
-    LOG(ERROR) << "Could not allocate I[], " << ((oldsize + 1) * sizeof(int))
-               << " bytes";
-    return MEM_ERROR;
+  if (oldsize != old_suffixes.size()) {
+    LOG(ERROR) << "Suffix array is for a different old file";
+    return UNEXPECTED_ERROR;
   }
-
-  if (!V.Allocate(oldsize + 1)) {
-    LOG(ERROR) << "Could not allocate V[], " << ((oldsize + 1) * sizeof(int))
-               << " bytes";
-    return MEM_ERROR;
-  }
-
-  base::Time q_start_time = base::Time::Now();
-  qsufsort(I, V, old, oldsize);
-  VLOG(1) << " done qsufsort "
-          << (base::Time::Now() - q_start_time).InSecondsF();
-  V.clear();
+  const PagedArray<int>& I = old_suffixes.suffixes();
 
   const uint8* newbuf = new_stream->Buffer();
   const int newsize = static_cast<int>(new_stream->Remaining());
@@ -420,8 +523,6 @@ BSDiffStatus CreateBinaryPatch(SourceStream* old_stream,
   if (!diff_skips->WriteVarint32(pending_diff_zeros))
     return MEM_ERROR;
 
-  I.clear();
-
   MBSPatchHeader header;
   // The string will have a null terminator that we don't use, hence '-1'.
   COMPILE_ASSERT(sizeof(MBS_PATCH_HEADER_TAG) - 1 == sizeof(header.tag),
@@ -39,6 +39,12 @@ class PagedArray {
     return pages_[page][offset];
   }
 
+  const T& operator[](size_t i) const {
+    size_t page = i >> kLogPageSize;
+    size_t offset = i & (kPageSize - 1);
+    return pages_[page][offset];
+  }
+
   // Allocates storage for |size| elements. Returns true on success and false if
   // allocation fails.
   bool Allocate(size_t size) {
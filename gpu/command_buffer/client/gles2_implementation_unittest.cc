@@ -2845,6 +2845,24 @@ TEST_F(GLES2ImplementationTest, Enable) {
   EXPECT_TRUE(NoCommandsWritten());
 }
 
+TEST_F(GLES2ImplementationTest, ActiveTexture) {
+  struct Cmds {
+    cmds::ActiveTexture cmd;
+  };
+  Cmds expected;
+  expected.cmd.Init(GL_TEXTURE1);
+
+  // GL_TEXTURE0 is the default, so it is not sent.
+  gl_->ActiveTexture(GL_TEXTURE0);
+  EXPECT_TRUE(NoCommandsWritten());
+  gl_->ActiveTexture(GL_TEXTURE1);
+  EXPECT_EQ(0, memcmp(&expected, commands_, sizeof(expected)));
+  // Check it's cached and not called again.
+  ClearCommands();
+  gl_->ActiveTexture(GL_TEXTURE1);
+  EXPECT_TRUE(NoCommandsWritten());
+}
+
 TEST_F(GLES2ImplementationTest, ConsumeTextureCHROMIUM) {
   struct Cmds {
     cmds::ConsumeTextureCHROMIUMImmediate cmd;
@@ -25,6 +25,11 @@ SafeSharedMemoryPool* safe_shared_memory_pool() {
 
 static uint64 g_next_pixel_transfer_state_id = 1;
 
+// The time ProcessMorePendingTransfers() can keep uploading textures for.
+// Small uploads are batched up to this, so that they don't each pay for a
+// round trip through the message loop.
+const int64 kProcessTransfersTimeSliceUs = 1000;
+
 void PerformNotifyCompletion(
     AsyncMemoryParams mem_params,
     ScopedSafeSharedMemory* safe_shared_memory,
@@ -319,12 +324,19 @@ void AsyncPixelTransferManagerIdle::ProcessMorePendingTransfers() {
   if (shared_state_.tasks.empty())
     return;
 
-  // First task should always be a pixel transfer task.
-  DCHECK(shared_state_.tasks.front().transfer_id);
-  shared_state_.tasks.front().task.Run();
-  shared_state_.tasks.pop_front();
-
-  shared_state_.ProcessNotificationTasks();
+  TRACE_EVENT0("gpu",
+               "AsyncPixelTransferManagerIdle::ProcessMorePendingTransfers");
+  base::TimeTicks deadline = base::TimeTicks::HighResNow() +
+      base::TimeDelta::FromMicroseconds(kProcessTransfersTimeSliceUs);
+  do {
+    // First task should always be a pixel transfer task.
+    DCHECK(shared_state_.tasks.front().transfer_id);
+    shared_state_.tasks.front().task.Run();
+    shared_state_.tasks.pop_front();
+
+    shared_state_.ProcessNotificationTasks();
+  } while (!shared_state_.tasks.empty() &&
+           base::TimeTicks::HighResNow() < deadline);
 }
 
 bool AsyncPixelTransferManagerIdle::NeedsProcessMorePendingTransfers() {
@@ -80,6 +80,20 @@ error::Error CommandParser::ProcessCommand() {
   return result;
 }
 
+error::Error CommandParser::ProcessCommands(int num_commands) {
+  int num_entries = put_ < get_ ? entry_count_ - get_ : put_ - get_;
+  int entries_processed = 0;
+
+  error::Error result = handler_->DoCommands(
+      num_commands, buffer_ + get_, num_entries, &entries_processed);
+
+  get_ += entries_processed;
+  if (get_ == entry_count_)
+    get_ = 0;
+
+  return result;
+}
+
 void CommandParser::ReportError(unsigned int command_id,
                                 error::Error result) {
   DVLOG(1) << "Error: " << result << " for Command "
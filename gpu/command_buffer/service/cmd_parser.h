@@ -15,6 +15,9 @@ namespace gpu {
 
 class AsyncAPIInterface;
 
+// The number of commands the scheduler hands to the decoder at once.
+const int kParseCommandsSlice = 20;
+
 // Command parser class. This class parses commands from a shared memory
 // buffer, to implement some asynchronous RPC mechanism.
 class GPU_EXPORT CommandParser {
@@ -57,6 +60,11 @@ class GPU_EXPORT CommandParser {
   // if there are no commands in the buffer.
   error::Error ProcessCommand();
 
+  // Processes up to |num_commands| commands in one call to the handler,
+  // updating the get pointer. Stops early on errors, deferred commands, or
+  // when the handler is asked to exit command processing early.
+  error::Error ProcessCommands(int num_commands);
+
   // Processes all commands until get == put.
   error::Error ProcessAllCommands();
 
@@ -91,6 +99,23 @@ class AsyncAPIInterface {
       unsigned int arg_count,
       const void* cmd_data) = 0;
 
+  // Executes up to |num_commands| commands from |buffer|, and sets
+  // |entries_processed| to the number of CommandBufferEntry consumed. The
+  // commands must fit in the |num_entries| entries of |buffer| and are
+  // validated like in DoCommand, but implementations can dispatch them
+  // without going back to the parser between commands.
+  // Returns:
+  //   error::kNoError if no error was found, the error of the command that
+  //   stopped the processing otherwise.
+  virtual error::Error DoCommands(unsigned int num_commands,
+                                  const void* buffer,
+                                  int num_entries,
+                                  int* entries_processed) = 0;
+
+  // Makes the DoCommands call in progress, if any, return after the current
+  // command. Used when the scheduler gets descheduled by a command.
+  virtual void ExitCommandProcessingEarly() = 0;
+
   // Returns a name for a command. Useful for logging / debuging.
   virtual const char* GetCommandName(unsigned int command_id) const = 0;
 };
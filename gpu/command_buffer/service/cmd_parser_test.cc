@@ -169,6 +169,51 @@ TEST_F(CommandParserTest, TestMultipleCommands) {
   Mock::VerifyAndClearExpectations(api_mock());
 }
 
+// Tests processing several commands in one batch.
+TEST_F(CommandParserTest, TestProcessCommands) {
+  scoped_ptr<CommandParser> parser(MakeParser(10));
+  CommandBufferOffset put = parser->put();
+  CommandHeader header;
+
+  // add 3 commands, process 2 of them in one batch.
+  header.size = 2;
+  header.command = 789;
+  buffer()[put++].value_header = header;
+  buffer()[put++].value_int32 = 5151;
+
+  header.size = 1;
+  header.command = 876;
+  buffer()[put++].value_header = header;
+
+  CommandBufferOffset put_cmd3 = put;
+  header.size = 2;
+  header.command = 123;
+  buffer()[put++].value_header = header;
+  buffer()[put++].value_int32 = 5656;
+
+  parser->set_put(put);
+
+  CommandBufferEntry param_array[2];
+  param_array[0].value_int32 = 5151;
+  AddDoCommandExpect(error::kNoError, 789, 1, param_array);
+  AddDoCommandExpect(error::kNoError, 876, 0, NULL);
+  EXPECT_EQ(error::kNoError, parser->ProcessCommands(2));
+  EXPECT_EQ(put_cmd3, parser->get());
+  Mock::VerifyAndClearExpectations(api_mock());
+
+  // a deferred command stops the batch and is not skipped.
+  param_array[1].value_int32 = 5656;
+  AddDoCommandExpect(error::kDeferCommandUntilLater, 123, 1, param_array + 1);
+  EXPECT_EQ(error::kDeferCommandUntilLater, parser->ProcessCommands(2));
+  EXPECT_EQ(put_cmd3, parser->get());
+  Mock::VerifyAndClearExpectations(api_mock());
+
+  AddDoCommandExpect(error::kNoError, 123, 1, param_array + 1);
+  EXPECT_EQ(error::kNoError, parser->ProcessCommands(2));
+  EXPECT_EQ(put, parser->get());
+  Mock::VerifyAndClearExpectations(api_mock());
+}
+
 // Tests that the parser will wrap correctly at the end of the buffer.
 TEST_F(CommandParserTest, TestWrap) {
   scoped_ptr<CommandParser> parser(MakeParser(5));
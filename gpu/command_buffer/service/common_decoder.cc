@@ -3,6 +3,8 @@
 // found in the LICENSE file.
 
 #include "gpu/command_buffer/service/common_decoder.h"
+
+#include "base/debug/trace_event.h"
 #include "gpu/command_buffer/service/cmd_buffer_engine.h"
 
 namespace gpu {
@@ -56,10 +58,59 @@ bool CommonDecoder::Bucket::GetAsString(std::string* str) {
   return true;
 }
 
-CommonDecoder::CommonDecoder() : engine_(NULL) {}
+CommonDecoder::CommonDecoder() : commands_to_process_(0), engine_(NULL) {}
 
 CommonDecoder::~CommonDecoder() {}
 
+error::Error CommonDecoder::DoCommands(unsigned int num_commands,
+                                       const void* buffer,
+                                       int num_entries,
+                                       int* entries_processed) {
+  const CommandBufferEntry* cmd_data =
+      static_cast<const CommandBufferEntry*>(buffer);
+  int process_pos = 0;
+  error::Error result = error::kNoError;
+  commands_to_process_ = num_commands;
+
+  while (process_pos < num_entries && result == error::kNoError &&
+         commands_to_process_--) {
+    CommandHeader header = cmd_data->value_header;
+    if (header.size == 0) {
+      DVLOG(1) << "Error: zero sized command in command buffer";
+      result = error::kInvalidSize;
+      break;
+    }
+
+    if (static_cast<int>(header.size) + process_pos > num_entries) {
+      DVLOG(1) << "Error: get offset out of bounds";
+      result = error::kOutOfBounds;
+      break;
+    }
+
+    TRACE_EVENT0(TRACE_DISABLED_BY_DEFAULT("cb_command"),
+                 GetCommandName(header.command));
+
+    result = DoCommand(header.command, header.size - 1, cmd_data);
+    if (error::IsError(result)) {
+      DVLOG(1) << "Error: " << result << " for Command "
+               << GetCommandName(header.command);
+    }
+
+    if (result != error::kDeferCommandUntilLater) {
+      process_pos += header.size;
+      cmd_data += header.size;
+    }
+  }
+
+  if (entries_processed)
+    *entries_processed = process_pos;
+  return result;
+}
+
+void CommonDecoder::ExitCommandProcessingEarly() {
+  commands_to_process_ = 0;
+}
+
 void* CommonDecoder::GetAddressAndCheckSize(unsigned int shm_id,
                                             unsigned int offset,
                                             unsigned int size) {
@@ -8,6 +8,7 @@
 #include <map>
 #include <stack>
 #include <string>
+#include "base/compiler_specific.h"
 #include "base/memory/linked_ptr.h"
 #include "base/memory/scoped_ptr.h"
 #include "gpu/command_buffer/common/buffer.h"
@@ -134,7 +135,18 @@ class GPU_EXPORT CommonDecoder : NON_EXPORTED_BASE(public AsyncAPIInterface) {
   // Get the actual shared memory buffer.
   Buffer GetSharedMemoryBuffer(unsigned int shm_id);
 
+  // AsyncAPIInterface implementation. DoCommands forwards each command to
+  // DoCommand.
+  virtual error::Error DoCommands(unsigned int num_commands,
+                                  const void* buffer,
+                                  int num_entries,
+                                  int* entries_processed) OVERRIDE;
+  virtual void ExitCommandProcessingEarly() OVERRIDE;
+
  protected:
+  // The number of commands left to process in the current DoCommands call.
+  unsigned int commands_to_process_;
+
   // Executes a common command.
   // Parameters:
   //    command: the command index.
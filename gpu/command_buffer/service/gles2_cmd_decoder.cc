@@ -518,6 +518,26 @@ class GLES2DecoderImpl : public GLES2Decoder,
                           unsigned int arg_count,
                           const void* args) OVERRIDE;
 
+  // Overridden from AsyncAPIInterface.
+  virtual Error DoCommands(unsigned int num_commands,
+                           const void* buffer,
+                           int num_entries,
+                           int* entries_processed) OVERRIDE;
+
+  // Executes one command. The DebugImpl instantiation honors the command
+  // logging, GPU tracing and GL error checking flags, the other one skips
+  // them so that they are not checked once per command.
+  template <bool DebugImpl>
+  Error DoCommandImpl(unsigned int command,
+                      unsigned int arg_count,
+                      const void* cmd_data);
+
+  template <bool DebugImpl>
+  Error DoCommandsImpl(unsigned int num_commands,
+                       const void* buffer,
+                       int num_entries,
+                       int* entries_processed);
+
   // Overridden from AsyncAPIInterface.
   virtual const char* GetCommandName(unsigned int command_id) const OVERRIDE;
 
@@ -3524,12 +3544,12 @@ const char* GLES2DecoderImpl::GetCommandName(unsigned int command_id) const {
 // Note: args is a pointer to the command buffer. As such, it could be changed
 // by a (malicious) client at any time, so if validation has to happen, it
 // should operate on a copy of them.
-error::Error GLES2DecoderImpl::DoCommand(
-    unsigned int command,
-    unsigned int arg_count,
-    const void* cmd_data) {
+template <bool DebugImpl>
+error::Error GLES2DecoderImpl::DoCommandImpl(unsigned int command,
+                                             unsigned int arg_count,
+                                             const void* cmd_data) {
   error::Error result = error::kNoError;
-  if (log_commands()) {
+  if (DebugImpl && log_commands()) {
     // TODO(notme): Change this to a LOG/VLOG that works in release. Tried
     // VLOG(1), no luck.
     LOG(ERROR) << "[" << logger_.GetLogPrefix() << "]" << "cmd: "
@@ -3542,7 +3562,7 @@ error::Error GLES2DecoderImpl::DoCommand(
     if ((info.arg_flags == cmd::kFixed && arg_count == info_arg_count) ||
         (info.arg_flags == cmd::kAtLeastN && arg_count >= info_arg_count)) {
       bool doing_gpu_trace = false;
-      if (gpu_trace_commands_) {
+      if (DebugImpl && gpu_trace_commands_) {
         if (CMD_FLAG_GET_TRACE_LEVEL(info.cmd_flags) <= gpu_trace_level_) {
           doing_gpu_trace = true;
           gpu_tracer_->Begin(GetCommandName(command), kTraceDecoder);
@@ -3566,7 +3586,7 @@ error::Error GLES2DecoderImpl::DoCommand(
       if (doing_gpu_trace)
         gpu_tracer_->End(kTraceDecoder);
 
-      if (debug()) {
+      if (DebugImpl && debug()) {
         GLenum error;
         while ((error = glGetError()) != GL_NO_ERROR) {
           LOG(ERROR) << "[" << logger_.GetLogPrefix() << "] "
@@ -3588,6 +3608,84 @@ error::Error GLES2DecoderImpl::DoCommand(
   return result;
 }
 
+error::Error GLES2DecoderImpl::DoCommand(unsigned int command,
+                                         unsigned int arg_count,
+                                         const void* cmd_data) {
+  return DoCommandImpl<true>(command, arg_count, cmd_data);
+}
+
+template <bool DebugImpl>
+error::Error GLES2DecoderImpl::DoCommandsImpl(unsigned int num_commands,
+                                              const void* buffer,
+                                              int num_entries,
+                                              int* entries_processed) {
+  const CommandBufferEntry* cmd_data =
+      static_cast<const CommandBufferEntry*>(buffer);
+  int process_pos = 0;
+  error::Error result = error::kNoError;
+  commands_to_process_ = num_commands;
+
+  while (process_pos < num_entries && result == error::kNoError &&
+         commands_to_process_--) {
+    CommandHeader header = cmd_data->value_header;
+    if (header.size == 0) {
+      DVLOG(1) << "Error: zero sized command in command buffer";
+      result = error::kInvalidSize;
+      break;
+    }
+
+    if (static_cast<int>(header.size) + process_pos > num_entries) {
+      DVLOG(1) << "Error: get offset out of bounds";
+      result = error::kOutOfBounds;
+      break;
+    }
+
+    if (DebugImpl) {
+      TRACE_EVENT_BEGIN0(TRACE_DISABLED_BY_DEFAULT("cb_command"),
+                         GetCommandName(header.command));
+    }
+
+    result = DoCommandImpl<DebugImpl>(
+        header.command, header.size - 1, cmd_data);
+
+    if (DebugImpl) {
+      TRACE_EVENT_END0(TRACE_DISABLED_BY_DEFAULT("cb_command"),
+                       GetCommandName(header.command));
+    }
+
+    if (error::IsError(result)) {
+      DVLOG(1) << "Error: " << result << " for Command "
+               << GetCommandName(header.command);
+    }
+
+    if (result != error::kDeferCommandUntilLater) {
+      process_pos += header.size;
+      cmd_data += header.size;
+    }
+  }
+
+  if (entries_processed)
+    *entries_processed = process_pos;
+  return result;
+}
+
+error::Error GLES2DecoderImpl::DoCommands(unsigned int num_commands,
+                                          const void* buffer,
+                                          int num_entries,
+                                          int* entries_processed) {
+  // Pick the dispatch loop once per batch rather than checking the debugging
+  // flags for every command.
+  bool trace_commands = false;
+  TRACE_EVENT_CATEGORY_GROUP_ENABLED(TRACE_DISABLED_BY_DEFAULT("cb_command"),
+                                     &trace_commands);
+  if (trace_commands || log_commands() || debug() || gpu_trace_commands_) {
+    return DoCommandsImpl<true>(
+        num_commands, buffer, num_entries, entries_processed);
+  }
+  return DoCommandsImpl<false>(
+      num_commands, buffer, num_entries, entries_processed);
+}
+
 void GLES2DecoderImpl::RemoveBuffer(GLuint client_id) {
   buffer_manager()->RemoveBuffer(client_id);
 }
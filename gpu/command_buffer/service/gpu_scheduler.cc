@@ -78,18 +78,18 @@ void GpuScheduler::PutChanged() {
     DCHECK(IsScheduled());
     DCHECK(unschedule_fences_.empty());
 
-    error = parser_->ProcessCommand();
-
-    if (error == error::kDeferCommandUntilLater) {
-      DCHECK_GT(unscheduled_count_, 0);
-      break;
-    }
+    error = parser_->ProcessCommands(kParseCommandsSlice);
 
     // TODO(piman): various classes duplicate various pieces of state, leading
     // to needlessly complex update logic. It should be possible to simply
     // share the state across all of them.
     command_buffer_->SetGetOffset(static_cast<int32>(parser_->get()));
 
+    if (error == error::kDeferCommandUntilLater) {
+      DCHECK_GT(unscheduled_count_, 0);
+      break;
+    }
+
     if (error::IsError(error)) {
       LOG(ERROR) << "[" << decoder_ << "] "
                  << "GPU PARSE ERROR: " << error;
@@ -144,6 +144,8 @@ void GpuScheduler::SetScheduled(bool scheduled) {
         scheduling_changed_callback_.Run(true);
     }
   } else {
+    // Don't run the rest of the batch of commands being processed, if any.
+    handler_->ExitCommandProcessingEarly();
     ++unscheduled_count_;
     if (unscheduled_count_ == 1) {
       TRACE_EVENT_ASYNC_BEGIN1("gpu", "ProcessingSwap", this,
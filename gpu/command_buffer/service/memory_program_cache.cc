@@ -156,6 +156,10 @@ ProgramCache::ProgramLoadResult MemoryProgramCache::LoadLinkedProgram(
   GLint success = 0;
   glGetProgramiv(program, GL_LINK_STATUS, &success);
   if (success == GL_FALSE) {
+    // The binary was likely produced by another driver, as the ones loaded
+    // from the disk cache can be. Forget it so that the next links of the
+    // program don't try to load it again before it gets saved anew.
+    store_.Erase(found);
     return PROGRAM_LOAD_FAILURE;
   }
   shader_a->set_attrib_map(value->attrib_map_0());
@@ -223,16 +227,7 @@ void MemoryProgramCache::SaveLinkedProgram(
   UMA_HISTOGRAM_COUNTS("GPU.ProgramCache.MemorySizeBeforeKb",
                        curr_size_bytes_ / 1024);
 
-  // Evict any cached program with the same key in favor of the least recently
-  // accessed.
-  ProgramMRUCache::iterator existing = store_.Peek(sha_string);
-  if(existing != store_.end())
-    store_.Erase(existing);
-
-  while (curr_size_bytes_ + length > max_size_bytes_) {
-    DCHECK(!store_.empty());
-    store_.Erase(store_.rbegin());
-  }
+  MakeRoomFor(sha_string, length);
 
   if (!shader_callback.is_null() &&
       !CommandLine::ForCurrentProcess()->HasSwitch(
@@ -270,6 +265,11 @@ void MemoryProgramCache::SaveLinkedProgram(
 void MemoryProgramCache::LoadProgram(const std::string& program) {
   scoped_ptr<GpuProgramProto> proto(GpuProgramProto::default_instance().New());
   if (proto->ParseFromString(program)) {
+    // The disk cache can hold more programs than fit in memory.
+    if (proto->program().length() > max_size_bytes_)
+      return;
+    MakeRoomFor(proto->sha(), proto->program().length());
+
     ShaderTranslator::VariableMap vertex_attribs;
     ShaderTranslator::VariableMap vertex_uniforms;
     ShaderTranslator::VariableMap vertex_varyings;
@@ -330,6 +330,22 @@ void MemoryProgramCache::LoadProgram(const std::string& program) {
   }
 }
 
+void MemoryProgramCache::MakeRoomFor(const std::string& program_hash,
+                                     size_t length) {
+  DCHECK_LE(length, max_size_bytes_);
+
+  // Evict any cached program with the same key in favor of the least recently
+  // accessed.
+  ProgramMRUCache::iterator existing = store_.Peek(program_hash);
+  if (existing != store_.end())
+    store_.Erase(existing);
+
+  while (curr_size_bytes_ + length > max_size_bytes_) {
+    DCHECK(!store_.empty());
+    store_.Erase(store_.rbegin());
+  }
+}
+
 MemoryProgramCache::ProgramCacheValue::ProgramCacheValue(
     GLsizei length,
     GLenum format,
@@ -48,6 +48,10 @@ class GPU_EXPORT MemoryProgramCache : public ProgramCache {
  private:
   virtual void ClearBackend() OVERRIDE;
 
+  // Evicts the program cached for |program_hash|, if any, and the least
+  // recently used programs until |length| more bytes fit in the cache.
+  void MakeRoomFor(const std::string& program_hash, size_t length);
+
   class ProgramCacheValue : public base::RefCounted<ProgramCacheValue> {
    public:
     ProgramCacheValue(GLsizei length,
@@ -9,13 +9,52 @@
 
 namespace gpu {
 
-AsyncAPIMock::AsyncAPIMock() {
+AsyncAPIMock::AsyncAPIMock() : engine_(NULL), commands_to_process_(0) {
   testing::DefaultValue<error::Error>::Set(
       error::kNoError);
 }
 
 AsyncAPIMock::~AsyncAPIMock() {}
 
+error::Error AsyncAPIMock::DoCommands(unsigned int num_commands,
+                                      const void* buffer,
+                                      int num_entries,
+                                      int* entries_processed) {
+  const CommandBufferEntry* cmd_data =
+      static_cast<const CommandBufferEntry*>(buffer);
+  int process_pos = 0;
+  error::Error result = error::kNoError;
+  commands_to_process_ = num_commands;
+
+  while (process_pos < num_entries && result == error::kNoError &&
+         commands_to_process_--) {
+    CommandHeader header = cmd_data->value_header;
+    if (header.size == 0) {
+      result = error::kInvalidSize;
+      break;
+    }
+    if (static_cast<int>(header.size) + process_pos > num_entries) {
+      result = error::kOutOfBounds;
+      break;
+    }
+
+    result = DoCommand(header.command, header.size - 1, cmd_data);
+
+    if (result != error::kDeferCommandUntilLater) {
+      process_pos += header.size;
+      cmd_data += header.size;
+    }
+  }
+
+  if (entries_processed)
+    *entries_processed = process_pos;
+  return result;
+}
+
+void AsyncAPIMock::ExitCommandProcessingEarly() {
+  commands_to_process_ = 0;
+}
+
 void AsyncAPIMock::SetToken(unsigned int command,
                             unsigned int arg_count,
                             const void* _args) {
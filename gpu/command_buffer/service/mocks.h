@@ -13,6 +13,7 @@
 #include <string>
 #include <vector>
 
+#include "base/compiler_specific.h"
 #include "base/logging.h"
 #include "gpu/command_buffer/service/cmd_parser.h"
 #include "gpu/command_buffer/service/cmd_buffer_engine.h"
@@ -56,6 +57,14 @@ class AsyncAPIMock : public AsyncAPIInterface {
       unsigned int arg_count,
       const void* cmd_data));
 
+  // Forwards each command to DoCommand.
+  virtual error::Error DoCommands(unsigned int num_commands,
+                                  const void* buffer,
+                                  int num_entries,
+                                  int* entries_processed) OVERRIDE;
+
+  virtual void ExitCommandProcessingEarly() OVERRIDE;
+
   const char* GetCommandName(unsigned int command_id) const {
     return "";
   };
@@ -70,6 +79,7 @@ class AsyncAPIMock : public AsyncAPIInterface {
 
  private:
   CommandBufferEngine *engine_;
+  unsigned int commands_to_process_;
 };
 
 namespace gles2 {
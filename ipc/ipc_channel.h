@@ -51,6 +51,9 @@ class IPC_EXPORT Channel : public Sender {
     MODE_NAMED_FLAG = 0x4,
 #if defined(OS_POSIX)
     MODE_OPEN_ACCESS_FLAG = 0x8, // Don't restrict access based on client UID.
+    // Move message bytes through shared memory rather than the socket, once
+    // the client has connected. Only servers set it; clients follow them.
+    MODE_SHARED_MEMORY_FLAG = 0x10,
 #endif
   };
 
@@ -71,7 +74,10 @@ class IPC_EXPORT Channel : public Sender {
     // The caller must then implement their own access-control based on the
     // client process' user Id.
     MODE_OPEN_NAMED_SERVER = MODE_OPEN_ACCESS_FLAG | MODE_SERVER_FLAG |
-                             MODE_NAMED_FLAG
+                             MODE_NAMED_FLAG,
+    // A server for busy channels, e.g. to renderers. Falls back to the socket
+    // if the shared memory can't be set up.
+    MODE_SHARED_MEMORY_SERVER = MODE_SHARED_MEMORY_FLAG | MODE_SERVER_FLAG
 #endif
   };
 
@@ -90,15 +96,23 @@ class IPC_EXPORT Channel : public Sender {
     // The client will return the message with hops = 1, *after* it
     // has received the message that contains the FD. When we
     // receive it again on the sender side, we close the FD.
-    CLOSE_FD_MESSAGE_TYPE = HELLO_MESSAGE_TYPE - 1
+    CLOSE_FD_MESSAGE_TYPE = HELLO_MESSAGE_TYPE - 1,
+    // The SHARED_MEMORY_RING_MESSAGE_TYPE is used on POSIX with
+    // MODE_SHARED_MEMORY_FLAG. The server sends it with the shared memory,
+    // and the client sends it back. Each is the last message its sender
+    // writes to the socket; the following ones go through the shared memory.
+    SHARED_MEMORY_RING_MESSAGE_TYPE = HELLO_MESSAGE_TYPE - 2
   };
 
   // The maximum message size in bytes. Attempting to receive a message of this
   // size or bigger results in a channel error.
   static const size_t kMaximumMessageSize = 128 * 1024 * 1024;
 
-  // Amount of data to read at once from the pipe.
+  // Amount of data to read at once from the pipe. The read buffer starts at
+  // this size, and grows up to kMaximumReadBufferSize when the channel carries
+  // larger messages or bursts of them.
   static const size_t kReadBufferSize = 4 * 1024;
+  static const size_t kMaximumReadBufferSize = 64 * 1024;
 
   // Initialize a Channel.
   //
@@ -193,6 +193,9 @@ bool Channel::ChannelImpl::Send(Message* message) {
   Logging::GetInstance()->OnSendMessage(message_ptr.get(), "");
 #endif  // IPC_MESSAGE_LOG_ENABLED
 
+  // imc_sendmsg() is handed the whole message as a single buffer.
+  message->Flatten();
+
   message->TraceMessageBegin();
   output_queue_.push_back(linked_ptr<Message>(message_ptr.release()));
   if (!waiting_connect_)
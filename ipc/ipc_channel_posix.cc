@@ -6,6 +6,7 @@
 
 #include <errno.h>
 #include <fcntl.h>
+#include <limits.h>
 #include <stddef.h>
 #include <sys/socket.h>
 #include <sys/stat.h>
@@ -19,6 +20,7 @@
 
 #include <map>
 #include <string>
+#include <vector>
 
 #include "base/command_line.h"
 #include "base/file_util.h"
@@ -158,6 +160,38 @@ bool SocketWriteErrorIsRecoverable() {
 #endif  // OS_MACOSX
 }
 
+// The size of each of the two shared memory rings.
+const size_t kSharedMemoryRingCapacity = 256 * 1024;
+
+// Fills |iovs| with the pieces of |msg| that follow its first |bytes_written|
+// bytes, up to IOV_MAX of them, and returns the number of bytes they cover.
+size_t GetMessageIOVecs(const Message& msg,
+                        size_t bytes_written,
+                        std::vector<struct iovec>* iovs) {
+  std::vector<Pickle::Buffer> buffers;
+  msg.GetBuffers(&buffers);
+
+  size_t total = 0;
+  for (size_t i = 0;
+       i < buffers.size() && iovs->size() < static_cast<size_t>(IOV_MAX);
+       ++i) {
+    const char* data = buffers[i].data;
+    size_t size = buffers[i].size;
+    if (bytes_written >= size) {
+      bytes_written -= size;
+      continue;
+    }
+    data += bytes_written;
+    size -= bytes_written;
+    bytes_written = 0;
+
+    struct iovec iov = {const_cast<char*>(data), size};
+    iovs->push_back(iov);
+    total += size;
+  }
+  return total;
+}
+
 }  // namespace
 //------------------------------------------------------------------------------
 
@@ -181,7 +215,13 @@ Channel::ChannelImpl::ChannelImpl(const IPC::ChannelHandle& channel_handle,
       remote_fd_pipe_(-1),
 #endif  // IPC_USES_READWRITE
       pipe_name_(channel_handle.name),
-      must_unlink_(false) {
+      must_unlink_(false),
+      reading_from_ring_(false),
+      writing_to_ring_(false),
+      ring_failed_(false),
+      blocked_on_output_ring_(false),
+      output_fds_sent_(false),
+      wakeup_pending_(false) {
   memset(input_cmsg_buf_, 0, sizeof(input_cmsg_buf_));
   if (!CreatePipe(channel_handle)) {
     // The pipe may have been closed already.
@@ -377,20 +417,37 @@ bool Channel::ChannelImpl::ProcessOutgoingMessages() {
   if (pipe_ == -1)
     return false;
 
+  if (writing_to_ring_)
+    return ProcessOutgoingMessagesToRing();
+
   // Write out all the messages we can till the write blocks or there are no
   // more outgoing messages.
   while (!output_queue_.empty()) {
     Message* msg = output_queue_.front();
 
-    size_t amt_to_write = msg->size() - message_send_bytes_written_;
-    DCHECK_NE(0U, amt_to_write);
-    const char* out_bytes = reinterpret_cast<const char*>(msg->data()) +
-        message_send_bytes_written_;
+    const size_t amt_remaining = msg->size() - message_send_bytes_written_;
+    DCHECK_NE(0U, amt_remaining);
+
+    // Messages that refer to external memory are sent straight from it with a
+    // vectored write rather than being copied into one buffer first.
+    size_t amt_to_write = amt_remaining;
+    const char* out_bytes = NULL;
+    struct iovec iov = {0};
+    std::vector<struct iovec> iovs;
+    if (msg->has_external_segments()) {
+      amt_to_write =
+          GetMessageIOVecs(*msg, message_send_bytes_written_, &iovs);
+    } else {
+      out_bytes = reinterpret_cast<const char*>(msg->data()) +
+          message_send_bytes_written_;
+      iov.iov_base = const_cast<char*>(out_bytes);
+      iov.iov_len = amt_to_write;
+    }
 
     struct msghdr msgh = {0};
-    struct iovec iov = {const_cast<char*>(out_bytes), amt_to_write};
-    msgh.msg_iov = &iov;
-    msgh.msg_iovlen = 1;
+    struct iovec* msg_iov = iovs.empty() ? &iov : &iovs[0];
+    msgh.msg_iov = msg_iov;
+    msgh.msg_iovlen = iovs.empty() ? 1 : iovs.size();
     char buf[CMSG_SPACE(
         sizeof(int) * FileDescriptorSet::kMaxDescriptorsPerMessage)];
 
@@ -437,7 +494,7 @@ bool Channel::ChannelImpl::ProcessOutgoingMessages() {
         msgh.msg_iov = &fd_pipe_iov;
         fd_written = fd_pipe_;
         bytes_written = HANDLE_EINTR(sendmsg(fd_pipe_, &msgh, MSG_DONTWAIT));
-        msgh.msg_iov = &iov;
+        msgh.msg_iov = msg_iov;
         msgh.msg_controllen = 0;
         if (bytes_written > 0) {
           CloseFileDescriptors(msg);
@@ -453,6 +510,8 @@ bool Channel::ChannelImpl::ProcessOutgoingMessages() {
         DCHECK_EQ(msg->file_descriptor_set()->size(), 1U);
       }
       if (!msgh.msg_controllen) {
+        // Send() flattens every message in this mode.
+        DCHECK(out_bytes);
         bytes_written = HANDLE_EINTR(write(pipe_, out_bytes, amt_to_write));
       } else
 #endif  // IPC_USES_READWRITE
@@ -501,16 +560,146 @@ bool Channel::ChannelImpl::ProcessOutgoingMessages() {
           &write_watcher_,
           this);
       return true;
+    } else if (amt_to_write != amt_remaining) {
+      // The message had more pieces than fit in one sendmsg() call.
+      message_send_bytes_written_ += bytes_written;
     } else {
       message_send_bytes_written_ = 0;
 
       // Message sent OK!
       DVLOG(2) << "sent message @" << msg << " on channel @" << this
                << " with type " << msg->type() << " on fd " << pipe_;
+      bool ends_socket_output = output_ring_ && IsSharedMemoryRingMessage(*msg);
       delete output_queue_.front();
       output_queue_.pop();
+
+      if (ends_socket_output) {
+        writing_to_ring_ = true;
+        if (wakeup_pending_)
+          WakePeer();
+        return ProcessOutgoingMessagesToRing();
+      }
+    }
+  }
+  return true;
+}
+
+bool Channel::ChannelImpl::ProcessOutgoingMessagesToRing() {
+  bool wrote_data = false;
+  std::vector<struct iovec> iovs;
+  while (!output_queue_.empty()) {
+    Message* msg = output_queue_.front();
+
+    if (!output_fds_sent_ && !msg->file_descriptor_set()->empty()) {
+      bool blocked = false;
+      if (!SendFileDescriptorsAheadOfRing(msg, &blocked))
+        return false;
+      if (blocked)
+        break;
+      output_fds_sent_ = true;
+    }
+
+    bool ring_full = false;
+    while (message_send_bytes_written_ < msg->size() && !ring_full) {
+      iovs.clear();
+      if (msg->has_external_segments()) {
+        GetMessageIOVecs(*msg, message_send_bytes_written_, &iovs);
+      } else {
+        struct iovec iov = {
+            const_cast<char*>(static_cast<const char*>(msg->data())) +
+                message_send_bytes_written_,
+            msg->size() - message_send_bytes_written_};
+        iovs.push_back(iov);
+      }
+      for (size_t i = 0; i < iovs.size(); ++i) {
+        size_t bytes_written = 0;
+        if (!output_ring_->Write(iovs[i].iov_base, iovs[i].iov_len,
+                                 &bytes_written)) {
+          return false;
+        }
+        message_send_bytes_written_ += bytes_written;
+        wrote_data |= bytes_written > 0;
+        if (bytes_written != iovs[i].iov_len) {
+          ring_full = true;
+          break;
+        }
+      }
+    }
+
+    if (ring_full) {
+      if (!output_ring_->PrepareToWaitForSpace())
+        continue;
+      // The reader wakes us up through the socket once it has made room.
+      blocked_on_output_ring_ = true;
+      is_blocked_on_write_ = true;
+      break;
     }
+
+    message_send_bytes_written_ = 0;
+    output_fds_sent_ = false;
+    DVLOG(2) << "sent message @" << msg << " on channel @" << this
+             << " with type " << msg->type() << " through shared memory";
+    delete output_queue_.front();
+    output_queue_.pop();
   }
+
+  if (wrote_data && output_ring_->ShouldWakeReader())
+    WakePeer();
+  return true;
+}
+
+bool Channel::ChannelImpl::SendFileDescriptorsAheadOfRing(Message* msg,
+                                                          bool* blocked) {
+  // They go through the socket, or the fd_pipe_, before the message is
+  // written to the ring. The reader thus finds them waiting there when it
+  // reads the message.
+  const unsigned num_fds = msg->file_descriptor_set()->size();
+  DCHECK(num_fds <= FileDescriptorSet::kMaxDescriptorsPerMessage);
+  if (msg->file_descriptor_set()->ContainsDirectoryDescriptor()) {
+    LOG(FATAL) << "Panic: attempting to transport directory descriptor over"
+                  " IPC. Aborting to maintain sandbox isolation.";
+  }
+
+  char buf[CMSG_SPACE(
+      sizeof(int) * FileDescriptorSet::kMaxDescriptorsPerMessage)];
+  struct iovec iov = { const_cast<char*>(""), 1 };
+  struct msghdr msgh = {0};
+  msgh.msg_iov = &iov;
+  msgh.msg_iovlen = 1;
+  msgh.msg_control = buf;
+  msgh.msg_controllen = CMSG_SPACE(sizeof(int) * num_fds);
+  struct cmsghdr* cmsg = CMSG_FIRSTHDR(&msgh);
+  cmsg->cmsg_level = SOL_SOCKET;
+  cmsg->cmsg_type = SCM_RIGHTS;
+  cmsg->cmsg_len = CMSG_LEN(sizeof(int) * num_fds);
+  msg->file_descriptor_set()->GetDescriptors(
+      reinterpret_cast<int*>(CMSG_DATA(cmsg)));
+  msgh.msg_controllen = cmsg->cmsg_len;
+  msg->header()->num_fds = static_cast<uint16>(num_fds);
+
+  int fd = pipe_;
+#if defined(IPC_USES_READWRITE)
+  if (fd_pipe_ != -1)
+    fd = fd_pipe_;
+#endif  // IPC_USES_READWRITE
+  ssize_t bytes_written = HANDLE_EINTR(sendmsg(fd, &msgh, MSG_DONTWAIT));
+  if (bytes_written < 0) {
+    if (!SocketWriteErrorIsRecoverable()) {
+      if (errno != EPIPE)
+        PLOG(ERROR) << "pipe error on " << fd;
+      return false;
+    }
+    *blocked = true;
+    is_blocked_on_write_ = true;
+    base::MessageLoopForIO::current()->WatchFileDescriptor(
+        pipe_,
+        false,  // One shot
+        base::MessageLoopForIO::WATCH_WRITE,
+        &write_watcher_,
+        this);
+    return true;
+  }
+  CloseFileDescriptors(msg);
   return true;
 }
 
@@ -523,6 +712,11 @@ bool Channel::ChannelImpl::Send(Message* message) {
   Logging::GetInstance()->OnSendMessage(message, "");
 #endif  // IPC_MESSAGE_LOG_ENABLED
 
+#if defined(IPC_USES_READWRITE)
+  // Messages may be sent with a plain write(), which needs a single buffer.
+  message->Flatten();
+#endif  // IPC_USES_READWRITE
+
   message->TraceMessageBegin();
   output_queue_.push(message);
   if (!is_blocked_on_write_ && !waiting_connect_) {
@@ -598,6 +792,16 @@ void Channel::ChannelImpl::ResetToAcceptingConnectionState() {
     delete m;
   }
 
+  input_ring_.reset();
+  output_ring_.reset();
+  ring_memory_.reset();
+  reading_from_ring_ = false;
+  writing_to_ring_ = false;
+  ring_failed_ = false;
+  blocked_on_output_ring_ = false;
+  output_fds_sent_ = false;
+  wakeup_pending_ = false;
+
   // Close any outstanding, received file descriptors.
   ClearInputFDs();
 
@@ -681,6 +885,13 @@ void Channel::ChannelImpl::OnFileCanReadWithoutBlocking(int fd) {
     NOTREACHED() << "Unknown pipe " << fd;
   }
 
+  // Data read from the socket in shared memory mode may be a wakeup from the
+  // reader of our ring, so try writing to it again.
+  if (blocked_on_output_ring_) {
+    blocked_on_output_ring_ = false;
+    is_blocked_on_write_ = false;
+  }
+
   // If we're a server and handshaking, then we want to make sure that we
   // only send our handshake message after we've processed the client's.
   // This gives us a chance to kill the client if the incoming handshake
@@ -771,9 +982,12 @@ Channel::ChannelImpl::ReadState Channel::ChannelImpl::ReadData(
     char* buffer,
     int buffer_len,
     int* bytes_read) {
-  if (pipe_ == -1)
+  if (pipe_ == -1 || ring_failed_)
     return READ_FAILED;
 
+  if (reading_from_ring_)
+    return ReadDataFromRing(buffer, buffer_len, bytes_read);
+
   struct msghdr msg = {0};
 
   struct iovec iov = {buffer, static_cast<size_t>(buffer_len)};
@@ -824,6 +1038,152 @@ Channel::ChannelImpl::ReadState Channel::ChannelImpl::ReadData(
   return READ_SUCCEEDED;
 }
 
+Channel::ChannelImpl::ReadState Channel::ChannelImpl::ReadDataFromRing(
+    char* buffer,
+    int buffer_len,
+    int* bytes_read) {
+  // The socket is drained first: a wakeup that arrives later is left for
+  // the next call, and the ring may still have data from a closed peer.
+  bool socket_open = DrainSocket();
+  while (true) {
+    size_t ring_bytes_read = 0;
+    if (!input_ring_->Read(buffer, buffer_len, &ring_bytes_read))
+      return READ_FAILED;
+    if (ring_bytes_read) {
+      *bytes_read = static_cast<int>(ring_bytes_read);
+      if (input_ring_->ShouldWakeWriter())
+        WakePeer();
+      return READ_SUCCEEDED;
+    }
+    if (!socket_open)
+      return READ_FAILED;
+    if (input_ring_->PrepareToWaitForData())
+      return READ_PENDING;
+  }
+}
+
+bool Channel::ChannelImpl::DrainSocket() {
+  char buffer[64];
+  while (true) {
+    ssize_t bytes_read;
+#if defined(IPC_USES_READWRITE)
+    if (fd_pipe_ >= 0) {
+      bytes_read = HANDLE_EINTR(read(pipe_, buffer, sizeof(buffer)));
+    } else
+#endif  // IPC_USES_READWRITE
+    {
+      struct iovec iov = {buffer, sizeof(buffer)};
+      struct msghdr msg = {0};
+      msg.msg_iov = &iov;
+      msg.msg_iovlen = 1;
+      msg.msg_control = input_cmsg_buf_;
+      msg.msg_controllen = sizeof(input_cmsg_buf_);
+      bytes_read = HANDLE_EINTR(recvmsg(pipe_, &msg, MSG_DONTWAIT));
+      if (bytes_read > 0 && !ExtractFileDescriptorsFromMsghdr(&msg))
+        return false;
+    }
+    if (bytes_read > 0)
+      continue;
+    return bytes_read < 0 && errno == EAGAIN;
+  }
+}
+
+void Channel::ChannelImpl::WakePeer() {
+  if (!writing_to_ring_) {
+    wakeup_pending_ = true;
+    return;
+  }
+  wakeup_pending_ = false;
+
+  // If the socket is full, the peer has wakeups to read already.
+  char wakeup = 0;
+  if (HANDLE_EINTR(write(pipe_, &wakeup, 1)) < 0 && errno != EAGAIN &&
+      errno != EPIPE) {
+    DPLOG(ERROR) << "write " << pipe_name_;
+  }
+}
+
+bool Channel::ChannelImpl::IsSharedMemoryRingMessage(const Message& msg) const {
+  return msg.routing_id() == MSG_ROUTING_NONE &&
+      msg.type() == SHARED_MEMORY_RING_MESSAGE_TYPE;
+}
+
+void Channel::ChannelImpl::QueueSharedMemoryRingMessage() {
+  scoped_ptr<base::SharedMemory> memory(new base::SharedMemory);
+  size_t ring_size =
+      internal::SharedMemoryRing::RequiredMemorySize(kSharedMemoryRingCapacity);
+  base::SharedMemoryHandle handle;
+  if (!memory->CreateAndMapAnonymous(2 * ring_size) ||
+      !memory->ShareToProcess(base::GetCurrentProcessHandle(), &handle)) {
+    // Keep using the socket.
+    LOG(WARNING) << "Unable to set up shared memory for " << pipe_name_;
+    return;
+  }
+
+  scoped_ptr<Message> msg(new Message(MSG_ROUTING_NONE,
+                                      SHARED_MEMORY_RING_MESSAGE_TYPE,
+                                      IPC::Message::PRIORITY_NORMAL));
+  if (!msg->WriteFileDescriptor(handle)) {
+    NOTREACHED() << "Unable to pickle shared memory descriptor";
+    return;
+  }
+  SetUpSharedMemoryRings(memory.Pass());
+  output_queue_.push(msg.release());
+}
+
+void Channel::ChannelImpl::HandleSharedMemoryRingMessage(const Message& msg) {
+  if (mode_ & MODE_SERVER_FLAG) {
+    // The client's reply: the rest of the socket data is wakeups.
+    if (!output_ring_ || reading_from_ring_) {
+      LOG(ERROR) << "Unexpected shared memory message on " << pipe_name_;
+      ring_failed_ = true;
+    }
+    reading_from_ring_ = true;
+    DiscardRemainingInputData();
+    return;
+  }
+
+  // Whatever happens, the server's messages now go through the ring.
+  reading_from_ring_ = true;
+  DiscardRemainingInputData();
+
+  PickleIterator iter(msg);
+  base::FileDescriptor descriptor;
+  if (ring_memory_ || !msg.ReadFileDescriptor(&iter, &descriptor)) {
+    LOG(ERROR) << "Invalid shared memory message on " << pipe_name_;
+    ring_failed_ = true;
+    return;
+  }
+  scoped_ptr<base::SharedMemory> memory(
+      new base::SharedMemory(descriptor, false));
+  size_t ring_size =
+      internal::SharedMemoryRing::RequiredMemorySize(kSharedMemoryRingCapacity);
+  if (!memory->Map(2 * ring_size)) {
+    LOG(ERROR) << "Unable to map shared memory for " << pipe_name_;
+    ring_failed_ = true;
+    return;
+  }
+  SetUpSharedMemoryRings(memory.Pass());
+
+  output_queue_.push(new Message(MSG_ROUTING_NONE,
+                                 SHARED_MEMORY_RING_MESSAGE_TYPE,
+                                 IPC::Message::PRIORITY_NORMAL));
+}
+
+void Channel::ChannelImpl::SetUpSharedMemoryRings(
+    scoped_ptr<base::SharedMemory> memory) {
+  // The server writes to the first ring, and the client to the second one.
+  char* server_ring = static_cast<char*>(memory->memory());
+  char* client_ring = server_ring +
+      internal::SharedMemoryRing::RequiredMemorySize(kSharedMemoryRingCapacity);
+  bool is_server = (mode_ & MODE_SERVER_FLAG) != 0;
+  output_ring_.reset(new internal::SharedMemoryRing(
+      is_server ? server_ring : client_ring, kSharedMemoryRingCapacity));
+  input_ring_.reset(new internal::SharedMemoryRing(
+      is_server ? client_ring : server_ring, kSharedMemoryRingCapacity));
+  ring_memory_ = memory.Pass();
+}
+
 #if defined(IPC_USES_READWRITE)
 bool Channel::ChannelImpl::ReadFileDescriptorsFromFDPipe() {
   char dummy;
@@ -863,8 +1223,13 @@ bool Channel::ChannelImpl::WillDispatchInputMessage(Message* msg) {
 #if defined(IPC_USES_READWRITE)
     if (!ReadFileDescriptorsFromFDPipe())
       return false;
-    if (header_fds > input_fds_.size())
 #endif  // IPC_USES_READWRITE
+    // With shared memory, they were sent on the socket ahead of the message,
+    // and may have been left there by the last read. A closed socket is
+    // noticed by the next read.
+    if (header_fds > input_fds_.size() && reading_from_ring_)
+      DrainSocket();
+    if (header_fds > input_fds_.size())
       error = "Message needs unreceived descriptors";
   }
 
@@ -893,7 +1258,10 @@ bool Channel::ChannelImpl::WillDispatchInputMessage(Message* msg) {
 bool Channel::ChannelImpl::DidEmptyInputBuffers() {
   // When the input data buffer is empty, the fds should be too. If this is
   // not the case, we probably have a rogue renderer which is trying to fill
-  // our descriptor table.
+  // our descriptor table. With shared memory, the descriptors for messages
+  // that are still in the ring may already be there.
+  if (reading_from_ring_)
+    return input_fds_.size() <= kMaxReadFDs;
   return input_fds_.empty();
 }
 
@@ -988,9 +1356,15 @@ void Channel::ChannelImpl::HandleInternalMessage(const Message& msg) {
       }
 #endif  // IPC_USES_READWRITE
       peer_pid_ = pid;
+      if ((mode_ & MODE_SERVER_FLAG) && (mode_ & MODE_SHARED_MEMORY_FLAG))
+        QueueSharedMemoryRingMessage();
       listener()->OnChannelConnected(pid);
       break;
 
+    case Channel::SHARED_MEMORY_RING_MESSAGE_TYPE:
+      HandleSharedMemoryRingMessage(msg);
+      break;
+
 #if defined(OS_MACOSX)
     case Channel::CLOSE_FD_MESSAGE_TYPE:
       int fd, hops;
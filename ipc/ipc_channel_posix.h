@@ -14,10 +14,13 @@
 #include <string>
 #include <vector>
 
+#include "base/memory/scoped_ptr.h"
+#include "base/memory/shared_memory.h"
 #include "base/message_loop/message_loop.h"
 #include "base/process/process.h"
 #include "ipc/file_descriptor_set_posix.h"
 #include "ipc/ipc_channel_reader.h"
+#include "ipc/ipc_shared_memory_ring.h"
 
 #if !defined(OS_MACOSX)
 // On Linux, the seccomp sandbox makes it very expensive to call
@@ -84,6 +87,24 @@ class Channel::ChannelImpl : public internal::ChannelReader,
   void CloseFileDescriptors(Message* msg);
   void QueueCloseFDMessage(int fd, int hops);
 
+  // The shared memory transport, used with MODE_SHARED_MEMORY_FLAG. Once a
+  // direction has switched to its ring, the socket only carries wakeups, and
+  // the file descriptors for the messages in the ring when IPC_USES_READWRITE
+  // doesn't send them on the fd_pipe_.
+  bool IsSharedMemoryRingMessage(const Message& msg) const;
+  void QueueSharedMemoryRingMessage();
+  void HandleSharedMemoryRingMessage(const Message& msg);
+  void SetUpSharedMemoryRings(scoped_ptr<base::SharedMemory> memory);
+  bool ProcessOutgoingMessagesToRing();
+  // Sends the descriptors of |msg| ahead of its bytes. Returns false on
+  // error; |*blocked| is set if the socket is full.
+  bool SendFileDescriptorsAheadOfRing(Message* msg, bool* blocked);
+  ReadState ReadDataFromRing(char* buffer, int buffer_len, int* bytes_read);
+  // Reads the wakeups, and any descriptors, waiting on the socket. Returns
+  // false if the socket has been closed or failed.
+  bool DrainSocket();
+  void WakePeer();
+
   // ChannelReader implementation.
   virtual ReadState ReadData(char* buffer,
                              int buffer_len,
@@ -160,7 +181,10 @@ class Channel::ChannelImpl : public internal::ChannelReader,
   std::queue<Message*> output_queue_;
 
   // We assume a worst case: kReadBufferSize bytes of messages, where each
-  // message has no payload and a full complement of descriptors.
+  // message has no payload and a full complement of descriptors. The read
+  // buffer may grow past kReadBufferSize, but recvmsg() doesn't coalesce data
+  // that carries descriptors, and truncated control data is still detected
+  // through MSG_CTRUNC.
   static const size_t kMaxReadFDs =
       (Channel::kReadBufferSize / sizeof(IPC::Message::Header)) *
       FileDescriptorSet::kMaxDescriptorsPerMessage;
@@ -197,6 +221,30 @@ class Channel::ChannelImpl : public internal::ChannelReader,
   // True if we are responsible for unlinking the unix domain socket file.
   bool must_unlink_;
 
+  // The shared memory holding both rings, and the rings this side reads from
+  // and writes to. The flags are set when the corresponding direction stops
+  // using the socket for message data.
+  scoped_ptr<base::SharedMemory> ring_memory_;
+  scoped_ptr<internal::SharedMemoryRing> input_ring_;
+  scoped_ptr<internal::SharedMemoryRing> output_ring_;
+  bool reading_from_ring_;
+  bool writing_to_ring_;
+
+  // Set if the shared memory handshake failed after the peer switched, which
+  // leaves no way to read its messages.
+  bool ring_failed_;
+
+  // Set when the shared memory ring is full, until the reader frees space.
+  bool blocked_on_output_ring_;
+
+  // Set when the descriptors of the message at the front of output_queue_
+  // have been sent ahead of it.
+  bool output_fds_sent_;
+
+  // Set if the peer needs a wakeup that can't be sent until writing_to_ring_
+  // is set, since before that the socket still carries message data.
+  bool wakeup_pending_;
+
 #if defined(OS_LINUX)
   // If non-zero, overrides the process ID sent in the hello message.
   static int global_pid_;
@@ -45,6 +45,7 @@ ChannelProxy::Context::Context(Listener* listener,
     : listener_task_runner_(base::ThreadTaskRunnerHandle::Get()),
       listener_(listener),
       ipc_task_runner_(ipc_task_runner),
+      dispatch_task_pending_(false),
       channel_connected_called_(false),
       peer_pid_(base::kNullProcessId) {
   DCHECK(ipc_task_runner_.get());
@@ -93,11 +94,27 @@ bool ChannelProxy::Context::OnMessageReceived(const Message& message) {
 
 // Called on the IPC::Channel thread
 bool ChannelProxy::Context::OnMessageReceivedNoFilter(const Message& message) {
-  listener_task_runner_->PostTask(
-      FROM_HERE, base::Bind(&Context::OnDispatchMessage, this, message));
+  incoming_messages_.push_back(message);
   return true;
 }
 
+// Called on the IPC::Channel thread
+void ChannelProxy::Context::OnMessageBatchEnd() {
+  FlushIncomingMessages();
+}
+
+// Called on the IPC::Channel thread
+void ChannelProxy::Context::FlushIncomingMessages() {
+  if (incoming_messages_.empty())
+    return;
+
+  std::vector<Message>* messages = new std::vector<Message>;
+  messages->swap(incoming_messages_);
+  listener_task_runner_->PostTask(
+      FROM_HERE, base::Bind(&Context::OnDispatchMessages, this,
+                            base::Owned(messages)));
+}
+
 // Called on the IPC::Channel thread
 void ChannelProxy::Context::OnChannelConnected(int32 peer_pid) {
   // Add any pending filters.  This avoids a race condition where someone
@@ -105,6 +122,7 @@ void ChannelProxy::Context::OnChannelConnected(int32 peer_pid) {
   // peer process.  The IO thread could receive a message before the task to add
   // the filter is run on the IO thread.
   OnAddFilter();
+  FlushIncomingMessages();
 
   // We cache off the peer_pid so it can be safely accessed from both threads.
   peer_pid_ = channel_->peer_pid();
@@ -118,6 +136,7 @@ void ChannelProxy::Context::OnChannelConnected(int32 peer_pid) {
 
 // Called on the IPC::Channel thread
 void ChannelProxy::Context::OnChannelError() {
+  FlushIncomingMessages();
   for (size_t i = 0; i < filters_.size(); ++i)
     filters_[i]->OnChannelError();
 
@@ -150,6 +169,8 @@ void ChannelProxy::Context::OnChannelClosed() {
   if (!channel_.get())
     return;
 
+  FlushIncomingMessages();
+
   for (size_t i = 0; i < filters_.size(); ++i) {
     filters_[i]->OnChannelClosing();
     filters_[i]->OnFilterRemoved();
@@ -224,6 +245,30 @@ void ChannelProxy::Context::AddFilter(MessageFilter* filter) {
       FROM_HERE, base::Bind(&Context::OnAddFilter, this));
 }
 
+// Called on the listener's thread
+void ChannelProxy::Context::OnDispatchMessages(std::vector<Message>* messages) {
+  dispatch_queue_.insert(dispatch_queue_.end(), messages->begin(),
+                         messages->end());
+  DispatchQueuedMessages();
+}
+
+// Called on the listener's thread
+void ChannelProxy::Context::DispatchQueuedMessages() {
+  dispatch_task_pending_ = false;
+  while (!dispatch_queue_.empty()) {
+    // If this message runs a nested message loop, the rest of the queue has
+    // to be dispatched from there, as if each message had its own task.
+    if (dispatch_queue_.size() > 1 && !dispatch_task_pending_) {
+      dispatch_task_pending_ = true;
+      listener_task_runner_->PostTask(
+          FROM_HERE, base::Bind(&Context::DispatchQueuedMessages, this));
+    }
+    Message message = dispatch_queue_.front();
+    dispatch_queue_.pop_front();
+    OnDispatchMessage(message);
+  }
+}
+
 // Called on the listener's thread
 void ChannelProxy::Context::OnDispatchMessage(const Message& message) {
 #ifdef IPC_MESSAGE_LOG_ENABLED
@@ -5,6 +5,7 @@
 #ifndef IPC_IPC_CHANNEL_PROXY_H_
 #define IPC_IPC_CHANNEL_PROXY_H_
 
+#include <deque>
 #include <vector>
 
 #include "base/memory/ref_counted.h"
@@ -183,12 +184,19 @@ class IPC_EXPORT ChannelProxy : public Sender, public base::NonThreadSafe {
 
     // IPC::Listener methods:
     virtual bool OnMessageReceived(const Message& message) OVERRIDE;
+    virtual void OnMessageBatchEnd() OVERRIDE;
     virtual void OnChannelConnected(int32 peer_pid) OVERRIDE;
     virtual void OnChannelError() OVERRIDE;
 
-    // Like OnMessageReceived but doesn't try the filters.
+    // Like OnMessageReceived but doesn't try the filters. The message is
+    // queued, and sent to the listener thread with the rest of its batch.
     bool OnMessageReceivedNoFilter(const Message& message);
 
+    // Posts the messages queued by OnMessageReceivedNoFilter to the listener
+    // thread. Subclasses that hand messages to the listener thread by other
+    // means call this first, to keep them in order.
+    void FlushIncomingMessages();
+
     // Gives the filters a chance at processing |message|.
     // Returns true if the message was processed, false otherwise.
     bool TryFilters(const Message& message);
@@ -217,12 +225,26 @@ class IPC_EXPORT ChannelProxy : public Sender, public base::NonThreadSafe {
 
     // Methods called on the listener thread.
     void AddFilter(MessageFilter* filter);
+    void OnDispatchMessages(std::vector<Message>* messages);
+    void DispatchQueuedMessages();
     void OnDispatchConnected();
     void OnDispatchError();
 
     scoped_refptr<base::SingleThreadTaskRunner> listener_task_runner_;
     Listener* listener_;
 
+    // Messages received during the current read of the channel, waiting to be
+    // posted to the listener thread in one task. Only accessed on the IPC
+    // thread.
+    std::vector<Message> incoming_messages_;
+
+    // Messages posted to the listener thread that haven't been dispatched yet.
+    // A message may start a nested message loop, so the rest of the queue is
+    // left to a separate task rather than dispatched after it returns. Only
+    // accessed on the listener thread.
+    std::deque<Message> dispatch_queue_;
+    bool dispatch_task_pending_;
+
     // List of filters.  This is only accessed on the IPC thread.
     std::vector<scoped_refptr<MessageFilter> > filters_;
     scoped_refptr<base::SingleThreadTaskRunner> ipc_task_runner_;
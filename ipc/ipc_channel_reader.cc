@@ -4,6 +4,8 @@
 
 #include "ipc/ipc_channel_reader.h"
 
+#include <algorithm>
+
 #include "ipc/ipc_listener.h"
 #include "ipc/ipc_logging.h"
 #include "ipc/ipc_message_macros.h"
@@ -11,8 +13,20 @@
 namespace IPC {
 namespace internal {
 
-ChannelReader::ChannelReader(Listener* listener) : listener_(listener) {
-  memset(input_buf_, 0, sizeof(input_buf_));
+namespace {
+
+const int kReadsBeforeShrinking = 64;
+
+}  // namespace
+
+ChannelReader::ChannelReader(Listener* listener)
+    : listener_(listener),
+      input_buf_(new char[Channel::kReadBufferSize]),
+      input_buf_size_(Channel::kReadBufferSize),
+      next_input_buf_size_(Channel::kReadBufferSize),
+      small_reads_(0),
+      discard_remaining_input_(false) {
+  memset(input_buf_.get(), 0, input_buf_size_);
 }
 
 ChannelReader::~ChannelReader() {
@@ -20,8 +34,10 @@ ChannelReader::~ChannelReader() {
 
 bool ChannelReader::ProcessIncomingMessages() {
   while (true) {
+    ResizeInputBufferIfNeeded();
     int bytes_read = 0;
-    ReadState read_state = ReadData(input_buf_, Channel::kReadBufferSize,
+    ReadState read_state = ReadData(input_buf_.get(),
+                                    static_cast<int>(input_buf_size_),
                                     &bytes_read);
     if (read_state == READ_FAILED)
       return false;
@@ -29,18 +45,18 @@ bool ChannelReader::ProcessIncomingMessages() {
       return true;
 
     DCHECK(bytes_read > 0);
-    if (!DispatchInputData(input_buf_, bytes_read))
+    if (!DispatchInputData(input_buf_.get(), bytes_read))
       return false;
   }
 }
 
 bool ChannelReader::AsyncReadComplete(int bytes_read) {
-  return DispatchInputData(input_buf_, bytes_read);
+  return DispatchInputData(input_buf_.get(), bytes_read);
 }
 
 bool ChannelReader::IsInternalMessage(const Message& m) const {
   return m.routing_id() == MSG_ROUTING_NONE &&
-      m.type() >= Channel::CLOSE_FD_MESSAGE_TYPE &&
+      m.type() >= Channel::SHARED_MEMORY_RING_MESSAGE_TYPE &&
       m.type() <= Channel::HELLO_MESSAGE_TYPE;
 }
 
@@ -54,6 +70,16 @@ bool ChannelReader::DispatchInputData(const char* input_data,
   const char* p;
   const char* end;
 
+  // A full buffer means there's probably more data waiting, which a larger
+  // buffer would have picked up in the same read.
+  if (static_cast<size_t>(input_data_len) == input_buf_size_) {
+    next_input_buf_size_ = std::max(next_input_buf_size_, input_buf_size_ * 2);
+  } else if (static_cast<size_t>(input_data_len) <= input_buf_size_ / 4) {
+    ++small_reads_;
+  } else {
+    small_reads_ = 0;
+  }
+
   // Possibly combine with the overflow buffer to make a larger buffer.
   if (input_overflow_buf_.empty()) {
     p = input_data;
@@ -75,6 +101,9 @@ bool ChannelReader::DispatchInputData(const char* input_data,
     const char* message_tail = Message::FindNext(p, end);
     if (message_tail) {
       int len = static_cast<int>(message_tail - p);
+      // Make room for messages like this one to be read in one go.
+      while (next_input_buf_size_ < static_cast<size_t>(len))
+        next_input_buf_size_ *= 2;
       Message m(p, len);
       if (!WillDispatchInputMessage(&m))
         return false;
@@ -96,6 +125,10 @@ bool ChannelReader::DispatchInputData(const char* input_data,
       else
         listener_->OnMessageReceived(m);
       p = message_tail;
+      if (discard_remaining_input_) {
+        discard_remaining_input_ = false;
+        p = end;
+      }
     } else {
       // Last message is partial.
       break;
@@ -105,11 +138,30 @@ bool ChannelReader::DispatchInputData(const char* input_data,
   // Save any partial data in the overflow buffer.
   input_overflow_buf_.assign(p, end - p);
 
+  listener_->OnMessageBatchEnd();
+
   if (input_overflow_buf_.empty() && !DidEmptyInputBuffers())
     return false;
   return true;
 }
 
+void ChannelReader::ResizeInputBufferIfNeeded() {
+  if (small_reads_ >= kReadsBeforeShrinking) {
+    small_reads_ = 0;
+    if (next_input_buf_size_ == input_buf_size_ &&
+        input_buf_size_ > Channel::kReadBufferSize) {
+      next_input_buf_size_ = input_buf_size_ / 2;
+    }
+  }
+  if (next_input_buf_size_ > Channel::kMaximumReadBufferSize)
+    next_input_buf_size_ = Channel::kMaximumReadBufferSize;
+  if (next_input_buf_size_ == input_buf_size_)
+    return;
+
+  input_buf_.reset(new char[next_input_buf_size_]);
+  input_buf_size_ = next_input_buf_size_;
+  small_reads_ = 0;
+}
 
 }  // namespace internal
 }  // namespace IPC
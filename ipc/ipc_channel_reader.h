@@ -6,6 +6,7 @@
 #define IPC_IPC_CHANNEL_READER_H_
 
 #include "base/basictypes.h"
+#include "base/memory/scoped_ptr.h"
 #include "ipc/ipc_channel.h"
 
 namespace IPC {
@@ -83,6 +84,11 @@ class ChannelReader {
   // Handles internal messages, like the hello message sent on channel startup.
   virtual void HandleInternalMessage(const Message& msg) = 0;
 
+  // Called from HandleInternalMessage when the rest of the data read along
+  // with the message isn't made of messages, e.g. because the peer has moved
+  // to another transport. That data is dropped.
+  void DiscardRemainingInputData() { discard_remaining_input_ = true; }
+
  private:
   // Takes the given data received from the IPC channel and dispatches any
   // fully completed messages.
@@ -90,16 +96,31 @@ class ChannelReader {
   // Returns true on success. False means channel error.
   bool DispatchInputData(const char* input_data, int input_data_len);
 
+  // Reallocates input_buf_ if the reads so far call for a different size.
+  // This is only done right before reading, since the buffer must not move
+  // while an asynchronous read into it may be pending.
+  void ResizeInputBufferIfNeeded();
+
   Listener* listener_;
 
   // We read from the pipe into this buffer. Managed by DispatchInputData, do
   // not access directly outside that function.
-  char input_buf_[Channel::kReadBufferSize];
+  scoped_ptr<char[]> input_buf_;
+  size_t input_buf_size_;
+
+  // The size input_buf_ should have for the next read. It doubles, up to
+  // Channel::kMaximumReadBufferSize, when a read fills the buffer or a message
+  // doesn't fit in it, and halves after kReadsBeforeShrinking reads that used
+  // at most a quarter of the buffer.
+  size_t next_input_buf_size_;
+  int small_reads_;
 
   // Large messages that span multiple pipe buffers, get built-up using
   // this buffer.
   std::string input_overflow_buf_;
 
+  bool discard_remaining_input_;
+
   DISALLOW_COPY_AND_ASSIGN(ChannelReader);
 };
 
@@ -142,6 +142,30 @@ TEST_F(IPCChannelTest, ChannelTest) {
   DestroyChannel();
 }
 
+#if defined(OS_POSIX)
+TEST_F(IPCChannelTest, SharedMemoryChannelTest) {
+  Init("GenericClient");
+
+  // Set up IPC channel and start client.
+  GenericChannelListener listener;
+  CreateChannelWithMode(&listener, IPC::Channel::MODE_SHARED_MEMORY_SERVER);
+  listener.Init(sender());
+  ASSERT_TRUE(ConnectChannel());
+  ASSERT_TRUE(StartClient());
+
+  Send(sender(), "hello from parent");
+
+  // Run message loop.
+  base::MessageLoop::current()->Run();
+
+  // Close the channel so the client's OnChannelError() gets fired.
+  channel()->Close();
+
+  EXPECT_TRUE(WaitForClientShutdown());
+  DestroyChannel();
+}
+#endif  // defined(OS_POSIX)
+
 // TODO(viettrungluu): Move to a separate IPCChannelWinTest.
 #if defined(OS_WIN)
 TEST_F(IPCChannelTest, ChannelTestExistingPipe) {
@@ -249,6 +273,168 @@ TEST_F(IPCChannelTest, MAYBE_SendMessageInChannelConnected) {
   DestroyChannel();
 }
 
+const int kBurstMessageCount = 200;
+
+// Messages of these sizes exercise both the reads that find many small
+// messages and the ones that find a part of a large one.
+size_t BurstMessagePayloadSize(int index) {
+  return (index % 7) * 10000 + index;
+}
+
+void SendBurst(IPC::Sender* sender) {
+  for (int i = 0; i < kBurstMessageCount; ++i) {
+    IPC::Message* message = new IPC::Message(0,
+                                             2,
+                                             IPC::Message::PRIORITY_NORMAL);
+    message->WriteInt(i);
+    message->WriteString(std::string(BurstMessagePayloadSize(i), 'b'));
+    sender->Send(message);
+  }
+}
+
+// Checks that the messages sent by SendBurst() arrive complete and in
+// order, and quits after the last one.
+class BurstListener : public IPC::Listener {
+ public:
+  BurstListener() : next_index_(0) {}
+  virtual ~BurstListener() {}
+
+  virtual bool OnMessageReceived(const IPC::Message& message) OVERRIDE {
+    PickleIterator iter(message);
+
+    int index;
+    EXPECT_TRUE(iter.ReadInt(&index));
+    EXPECT_EQ(next_index_, index);
+    std::string payload;
+    EXPECT_TRUE(iter.ReadString(&payload));
+    EXPECT_EQ(BurstMessagePayloadSize(index), payload.length());
+
+    if (++next_index_ == kBurstMessageCount)
+      base::MessageLoop::current()->Quit();
+    return true;
+  }
+
+  virtual void OnChannelError() OVERRIDE {
+    EXPECT_EQ(kBurstMessageCount, next_index_);
+    base::MessageLoop::current()->Quit();
+  }
+
+ private:
+  int next_index_;
+};
+
+TEST_F(IPCChannelTest, ChannelProxyMessageBurstTest) {
+  Init("BurstClient");
+
+  base::Thread thread("ChannelProxyTestServer");
+  base::Thread::Options options;
+  options.message_loop_type = base::MessageLoop::TYPE_IO;
+  thread.StartWithOptions(options);
+
+  BurstListener listener;
+  CreateChannelProxy(&listener, thread.message_loop_proxy().get());
+
+  ASSERT_TRUE(StartClient());
+
+  // Run message loop until all the messages have arrived.
+  base::MessageLoop::current()->Run();
+
+  // Destroying the channel proxy makes the client exit.
+  DestroyChannelProxy();
+  EXPECT_TRUE(WaitForClientShutdown());
+  thread.Stop();
+}
+
+#if defined(OS_POSIX)
+class ConnectionWaitingBurstListener : public BurstListener {
+ public:
+  virtual void OnChannelConnected(int32 peer_pid) OVERRIDE {
+    base::MessageLoop::current()->Quit();
+  }
+};
+
+// The burst is larger than the shared memory, so both sides have to wait for
+// the other one to make room.
+TEST_F(IPCChannelTest, SharedMemoryMessageBurstTest) {
+  Init("EchoClient");
+
+  ConnectionWaitingBurstListener listener;
+  CreateChannelWithMode(&listener, IPC::Channel::MODE_SHARED_MEMORY_SERVER);
+  ASSERT_TRUE(ConnectChannel());
+  ASSERT_TRUE(StartClient());
+
+  // Wait for the client, so that the messages go through shared memory.
+  base::MessageLoop::current()->Run();
+  SendBurst(sender());
+  base::MessageLoop::current()->Run();
+
+  // Close the channel so the client's OnChannelError() gets fired.
+  channel()->Close();
+
+  EXPECT_TRUE(WaitForClientShutdown());
+  DestroyChannel();
+}
+#endif  // defined(OS_POSIX)
+
+class QuitOnErrorListener : public IPC::Listener {
+ public:
+  virtual bool OnMessageReceived(const IPC::Message& message) OVERRIDE {
+    return false;
+  }
+
+  virtual void OnChannelError() OVERRIDE {
+    base::MessageLoop::current()->Quit();
+  }
+};
+
+MULTIPROCESS_IPC_TEST_CLIENT_MAIN(BurstClient) {
+  base::MessageLoopForIO main_message_loop;
+  QuitOnErrorListener listener;
+
+  IPC::Channel channel(IPCTestBase::GetChannelName("BurstClient"),
+                       IPC::Channel::MODE_CLIENT,
+                       &listener);
+  CHECK(channel.Connect());
+  SendBurst(&channel);
+
+  base::MessageLoop::current()->Run();
+  return 0;
+}
+
+#if defined(OS_POSIX)
+// Sends every message back.
+class EchoListener : public QuitOnErrorListener {
+ public:
+  EchoListener() : sender_(NULL) {}
+
+  void Init(IPC::Sender* sender) {
+    sender_ = sender;
+  }
+
+  virtual bool OnMessageReceived(const IPC::Message& message) OVERRIDE {
+    sender_->Send(new IPC::Message(message));
+    return true;
+  }
+
+ private:
+  IPC::Sender* sender_;
+};
+
+MULTIPROCESS_IPC_TEST_CLIENT_MAIN(EchoClient) {
+  base::MessageLoopForIO main_message_loop;
+  EchoListener listener;
+
+  IPC::Channel channel(IPCTestBase::GetChannelName("EchoClient"),
+                       IPC::Channel::MODE_CLIENT,
+                       &listener);
+  CHECK(channel.Connect());
+  listener.Init(&channel);
+
+  base::MessageLoop::current()->Run();
+  return 0;
+}
+#endif  // defined(OS_POSIX)
+
 MULTIPROCESS_IPC_TEST_CLIENT_MAIN(GenericClient) {
   base::MessageLoopForIO main_message_loop;
   GenericChannelListener listener;
@@ -90,6 +90,9 @@ bool Channel::ChannelImpl::Send(Message* message) {
   Logging::GetInstance()->OnSendMessage(message, "");
 #endif
 
+  // WriteFile() sends each message from one contiguous buffer.
+  message->Flatten();
+
   message->TraceMessageBegin();
   output_queue_.push(message);
   // ensure waiting to write
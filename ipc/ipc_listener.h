@@ -20,6 +20,11 @@ class IPC_EXPORT Listener {
   // handled.
   virtual bool OnMessageReceived(const Message& message) = 0;
 
+  // Called after the messages from a single read of the channel have been
+  // passed to OnMessageReceived(), so that a listener that forwards them
+  // elsewhere can do so in one batch.
+  virtual void OnMessageBatchEnd() {}
+
   // Called when the channel is connected and we have received the internal
   // Hello message from the peer.
   virtual void OnChannelConnected(int32 peer_pid) {}
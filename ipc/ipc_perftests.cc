@@ -29,8 +29,23 @@ namespace {
 // TODO(brettw): Make this test run by default.
 
 class IPCChannelPerfTest : public IPCTestBase {
+ protected:
+  // Times the roundtrip of messages of growing sizes over a channel in
+  // |mode|.
+  void RunPingPong(IPC::Channel::Mode mode, const char* test_name_prefix);
+
+  // Times sending batches of messages without waiting for the replies.
+  void RunThroughput(IPC::Channel::Mode mode, const char* test_name_prefix);
 };
 
+IPC::Message* CreateTestMessage(int msgid, const std::string& payload) {
+  IPC::Message* msg = new IPC::Message(0, 2, IPC::Message::PRIORITY_NORMAL);
+  msg->WriteInt64(base::TimeTicks::Now().ToInternalValue());
+  msg->WriteInt(msgid);
+  msg->WriteString(payload);
+  return msg;
+}
+
 // This class simply collects stats about abstract "events" (each of which has a
 // start time and an end time).
 class EventTimeTracker {
@@ -122,11 +137,7 @@ class ChannelReflectorListener : public IPC::Listener {
           base::TimeTicks::FromInternalValue(time_internal), now);
     }
 
-    IPC::Message* msg = new IPC::Message(0, 2, IPC::Message::PRIORITY_NORMAL);
-    msg->WriteInt64(base::TimeTicks::Now().ToInternalValue());
-    msg->WriteInt(msgid);
-    msg->WriteString(payload);
-    channel_->Send(msg);
+    channel_->Send(CreateTestMessage(msgid, payload));
     return true;
   }
 
@@ -137,8 +148,9 @@ class ChannelReflectorListener : public IPC::Listener {
 
 class PerformanceChannelListener : public IPC::Listener {
  public:
-  PerformanceChannelListener()
-      : channel_(NULL),
+  explicit PerformanceChannelListener(const char* test_name_prefix)
+      : test_name_prefix_(test_name_prefix),
+        channel_(NULL),
         msg_count_(0),
         msg_size_(0),
         count_down_(0),
@@ -183,7 +195,8 @@ class PerformanceChannelListener : public IPC::Listener {
       latency_tracker_.Reset();
       DCHECK(!perf_logger_.get());
       std::string test_name = base::StringPrintf(
-          "IPC_Perf_%dx_%u", msg_count_, static_cast<unsigned>(msg_size_));
+          "%s_%dx_%u", test_name_prefix_, msg_count_,
+          static_cast<unsigned>(msg_size_));
       perf_logger_.reset(new base::PerfTimeLogger(test_name.c_str()));
     } else {
       DCHECK_EQ(payload_.size(), reflected_payload.size());
@@ -201,15 +214,12 @@ class PerformanceChannelListener : public IPC::Listener {
       }
     }
 
-    IPC::Message* msg = new IPC::Message(0, 2, IPC::Message::PRIORITY_NORMAL);
-    msg->WriteInt64(base::TimeTicks::Now().ToInternalValue());
-    msg->WriteInt(count_down_);
-    msg->WriteString(payload_);
-    channel_->Send(msg);
+    channel_->Send(CreateTestMessage(count_down_, payload_));
     return true;
   }
 
  private:
+  const char* test_name_prefix_;
   IPC::Channel* channel_;
   int msg_count_;
   size_t msg_size_;
@@ -220,12 +230,77 @@ class PerformanceChannelListener : public IPC::Listener {
   scoped_ptr<base::PerfTimeLogger> perf_logger_;
 };
 
-TEST_F(IPCChannelPerfTest, Performance) {
+// Sends a batch of messages when the reply to its "hello" message arrives,
+// and stops the timer once they have all been reflected back.
+class ThroughputChannelListener : public IPC::Listener {
+ public:
+  explicit ThroughputChannelListener(const char* test_name_prefix)
+      : test_name_prefix_(test_name_prefix),
+        channel_(NULL),
+        msg_count_(0),
+        replies_left_(0) {
+  }
+
+  void Init(IPC::Channel* channel) {
+    DCHECK(!channel_);
+    channel_ = channel;
+  }
+
+  // Call this before running the message loop.
+  void SetTestParams(int msg_count, size_t msg_size) {
+    DCHECK_EQ(0, replies_left_);
+    msg_count_ = msg_count;
+    replies_left_ = msg_count;
+    payload_ = std::string(msg_size, 'a');
+  }
+
+  virtual bool OnMessageReceived(const IPC::Message& message) OVERRIDE {
+    CHECK(channel_);
+
+    PickleIterator iter(message);
+    int64 time_internal;
+    EXPECT_TRUE(iter.ReadInt64(&time_internal));
+    int msgid;
+    EXPECT_TRUE(iter.ReadInt(&msgid));
+    std::string reflected_payload;
+    EXPECT_TRUE(iter.ReadString(&reflected_payload));
+
+    if (reflected_payload == "hello") {
+      DCHECK(!perf_logger_.get());
+      std::string test_name = base::StringPrintf(
+          "%s_%dx_%u", test_name_prefix_, msg_count_,
+          static_cast<unsigned>(payload_.size()));
+      perf_logger_.reset(new base::PerfTimeLogger(test_name.c_str()));
+      for (int i = 0; i < msg_count_; ++i)
+        channel_->Send(CreateTestMessage(i, payload_));
+      return true;
+    }
+
+    DCHECK_EQ(payload_.size(), reflected_payload.size());
+    CHECK(replies_left_ > 0);
+    if (--replies_left_ == 0) {
+      perf_logger_.reset();  // Stop the perf timer now.
+      base::MessageLoop::current()->QuitWhenIdle();
+    }
+    return true;
+  }
+
+ private:
+  const char* test_name_prefix_;
+  IPC::Channel* channel_;
+  int msg_count_;
+  int replies_left_;
+  std::string payload_;
+  scoped_ptr<base::PerfTimeLogger> perf_logger_;
+};
+
+void IPCChannelPerfTest::RunPingPong(IPC::Channel::Mode mode,
+                                     const char* test_name_prefix) {
   Init("PerformanceClient");
 
   // Set up IPC channel and start client.
-  PerformanceChannelListener listener;
-  CreateChannel(&listener);
+  PerformanceChannelListener listener(test_name_prefix);
+  CreateChannelWithMode(&listener, mode);
   listener.Init(channel());
   ASSERT_TRUE(ConnectChannel());
   ASSERT_TRUE(StartClient());
@@ -238,12 +313,7 @@ TEST_F(IPCChannelPerfTest, Performance) {
     listener.SetTestParams(msg_count, msg_size);
 
     // This initial message will kick-start the ping-pong of messages.
-    IPC::Message* message =
-        new IPC::Message(0, 2, IPC::Message::PRIORITY_NORMAL);
-    message->WriteInt64(base::TimeTicks::Now().ToInternalValue());
-    message->WriteInt(-1);
-    message->WriteString("hello");
-    sender()->Send(message);
+    sender()->Send(CreateTestMessage(-1, "hello"));
 
     // Run message loop.
     base::MessageLoop::current()->Run();
@@ -252,16 +322,67 @@ TEST_F(IPCChannelPerfTest, Performance) {
   }
 
   // Send quit message.
-  IPC::Message* message = new IPC::Message(0, 2, IPC::Message::PRIORITY_NORMAL);
-  message->WriteInt64(base::TimeTicks::Now().ToInternalValue());
-  message->WriteInt(-1);
-  message->WriteString("quit");
-  sender()->Send(message);
+  sender()->Send(CreateTestMessage(-1, "quit"));
 
   EXPECT_TRUE(WaitForClientShutdown());
   DestroyChannel();
 }
 
+void IPCChannelPerfTest::RunThroughput(IPC::Channel::Mode mode,
+                                       const char* test_name_prefix) {
+  Init("PerformanceClient");
+
+  // Set up IPC channel and start client.
+  ThroughputChannelListener listener(test_name_prefix);
+  CreateChannelWithMode(&listener, mode);
+  listener.Init(channel());
+  ASSERT_TRUE(ConnectChannel());
+  ASSERT_TRUE(StartClient());
+
+  const size_t kMsgSizeBase = 12;
+  const int kMsgSizeMaxExp = 4;
+  int msg_count = 10000;
+  size_t msg_size = kMsgSizeBase;
+  for (int i = 1; i <= kMsgSizeMaxExp; i++) {
+    listener.SetTestParams(msg_count, msg_size);
+
+    // The batch is sent once this has been reflected, which also makes sure
+    // the channel is fully set up before the timing starts.
+    sender()->Send(CreateTestMessage(-1, "hello"));
+
+    // Run message loop.
+    base::MessageLoop::current()->Run();
+
+    msg_size *= kMsgSizeBase;
+  }
+
+  // Send quit message.
+  sender()->Send(CreateTestMessage(-1, "quit"));
+
+  EXPECT_TRUE(WaitForClientShutdown());
+  DestroyChannel();
+}
+
+TEST_F(IPCChannelPerfTest, Performance) {
+  RunPingPong(IPC::Channel::MODE_SERVER, "IPC_Perf");
+}
+
+TEST_F(IPCChannelPerfTest, Throughput) {
+  RunThroughput(IPC::Channel::MODE_SERVER, "IPC_Throughput");
+}
+
+#if defined(OS_POSIX)
+TEST_F(IPCChannelPerfTest, SharedMemoryPerformance) {
+  RunPingPong(IPC::Channel::MODE_SHARED_MEMORY_SERVER,
+              "IPC_SharedMemory_Perf");
+}
+
+TEST_F(IPCChannelPerfTest, SharedMemoryThroughput) {
+  RunThroughput(IPC::Channel::MODE_SHARED_MEMORY_SERVER,
+                "IPC_SharedMemory_Throughput");
+}
+#endif  // defined(OS_POSIX)
+
 // This message loop bounces all messages back to the sender.
 MULTIPROCESS_IPC_TEST_CLIENT_MAIN(PerformanceClient) {
   base::MessageLoopForIO main_message_loop;
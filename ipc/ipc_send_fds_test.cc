@@ -92,15 +92,19 @@ class MyChannelDescriptorListener : public MyChannelDescriptorListenerBase {
 };
 
 
+// Also quits the message loop once the channel is connected.
+class ConnectionWaitingDescriptorListener : public MyChannelDescriptorListener {
+ public:
+  ConnectionWaitingDescriptorListener() : MyChannelDescriptorListener(-1) {}
+
+  virtual void OnChannelConnected(int32 peer_pid) OVERRIDE {
+    base::MessageLoop::current()->Quit();
+  }
+};
+
 class IPCSendFdsTest : public IPCTestBase {
  protected:
-  void RunServer() {
-    // Set up IPC channel and start client.
-    MyChannelDescriptorListener listener(-1);
-    CreateChannel(&listener);
-    ASSERT_TRUE(ConnectChannel());
-    ASSERT_TRUE(StartClient());
-
+  void SendDescriptors() {
     for (unsigned i = 0; i < kNumFDsToSend; ++i) {
       const int fd = open(kDevZeroPath, O_RDONLY);
       ASSERT_GE(fd, 0);
@@ -111,6 +115,16 @@ class IPCSendFdsTest : public IPCTestBase {
       IPC::ParamTraits<base::FileDescriptor>::Write(message, descriptor);
       ASSERT_TRUE(sender()->Send(message));
     }
+  }
+
+  void RunServer() {
+    // Set up IPC channel and start client.
+    MyChannelDescriptorListener listener(-1);
+    CreateChannel(&listener);
+    ASSERT_TRUE(ConnectChannel());
+    ASSERT_TRUE(StartClient());
+
+    SendDescriptors();
 
     // Run message loop.
     base::MessageLoop::current()->Run();
@@ -128,6 +142,26 @@ TEST_F(IPCSendFdsTest, DescriptorTest) {
   RunServer();
 }
 
+TEST_F(IPCSendFdsTest, DescriptorTestSharedMemory) {
+  Init("SendFdsClient");
+
+  ConnectionWaitingDescriptorListener listener;
+  CreateChannelWithMode(&listener, IPC::Channel::MODE_SHARED_MEMORY_SERVER);
+  ASSERT_TRUE(ConnectChannel());
+  ASSERT_TRUE(StartClient());
+
+  // Wait for the client, so that the messages go through shared memory.
+  base::MessageLoop::current()->Run();
+  SendDescriptors();
+  base::MessageLoop::current()->Run();
+
+  // Close the channel so the client's OnChannelError() gets fired.
+  channel()->Close();
+
+  EXPECT_TRUE(WaitForClientShutdown());
+  DestroyChannel();
+}
+
 int SendFdsClientCommon(const std::string& test_client_name,
                         ino_t expected_inode_num) {
   base::MessageLoopForIO main_message_loop;
@@ -0,0 +1,148 @@
+// Copyright 2014 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "ipc/ipc_shared_memory_ring.h"
+
+#include <string.h>
+
+#include <algorithm>
+
+#include "base/logging.h"
+
+namespace IPC {
+namespace internal {
+
+namespace {
+
+// The positions are updated by different processes, so they're kept on
+// separate cache lines.
+const size_t kCacheLineSize = 64;
+
+}  // namespace
+
+// The positions count the bytes written and read so far, modulo 2^32; the
+// ring's capacity is a power of two, so they also give the offsets in it.
+struct SharedMemoryRing::Header {
+  volatile base::subtle::Atomic32 write_position;
+  volatile base::subtle::Atomic32 reader_waiting;
+  char padding1[kCacheLineSize - 2 * sizeof(base::subtle::Atomic32)];
+  volatile base::subtle::Atomic32 read_position;
+  volatile base::subtle::Atomic32 writer_waiting;
+  char padding2[kCacheLineSize - 2 * sizeof(base::subtle::Atomic32)];
+};
+
+// static
+size_t SharedMemoryRing::RequiredMemorySize(size_t capacity) {
+  return sizeof(Header) + capacity;
+}
+
+SharedMemoryRing::SharedMemoryRing(void* memory, size_t capacity)
+    : header_(static_cast<Header*>(memory)),
+      data_(static_cast<char*>(memory) + sizeof(Header)),
+      capacity_(static_cast<uint32>(capacity)),
+      position_(0) {
+  DCHECK(capacity > 0 && (capacity & (capacity - 1)) == 0);
+  DCHECK_LE(capacity, static_cast<size_t>(kint32max));
+}
+
+SharedMemoryRing::~SharedMemoryRing() {
+}
+
+bool SharedMemoryRing::Write(const void* data,
+                             size_t size,
+                             size_t* bytes_written) {
+  *bytes_written = 0;
+  uint32 read_position = static_cast<uint32>(
+      base::subtle::Acquire_Load(&header_->read_position));
+  int64 used = BytesInRing(read_position, position_);
+  if (used < 0)
+    return false;
+
+  size_t amount = std::min(size, static_cast<size_t>(capacity_ - used));
+  const char* bytes = static_cast<const char*>(data);
+  size_t offset = position_ & (capacity_ - 1);
+  size_t first_part = std::min(amount, capacity_ - offset);
+  memcpy(data_ + offset, bytes, first_part);
+  memcpy(data_, bytes + first_part, amount - first_part);
+
+  position_ += static_cast<uint32>(amount);
+  base::subtle::Release_Store(&header_->write_position,
+                              static_cast<base::subtle::Atomic32>(position_));
+  *bytes_written = amount;
+  return true;
+}
+
+bool SharedMemoryRing::PrepareToWaitForSpace() {
+  base::subtle::NoBarrier_Store(&header_->writer_waiting, 1);
+  // Pairs with the barrier in ShouldWakeWriter(): either the reader sees the
+  // flag, or this sees the space it freed.
+  base::subtle::MemoryBarrier();
+  uint32 read_position = static_cast<uint32>(
+      base::subtle::NoBarrier_Load(&header_->read_position));
+  int64 used = BytesInRing(read_position, position_);
+  // A corrupt state is reported by the next Write().
+  return used >= 0 && used == capacity_;
+}
+
+bool SharedMemoryRing::ShouldWakeReader() {
+  base::subtle::MemoryBarrier();
+  return TakeFlag(&header_->reader_waiting);
+}
+
+bool SharedMemoryRing::Read(void* buffer, size_t size, size_t* bytes_read) {
+  *bytes_read = 0;
+  uint32 write_position = static_cast<uint32>(
+      base::subtle::Acquire_Load(&header_->write_position));
+  int64 available = BytesInRing(position_, write_position);
+  if (available < 0)
+    return false;
+
+  size_t amount = std::min(size, static_cast<size_t>(available));
+  char* bytes = static_cast<char*>(buffer);
+  size_t offset = position_ & (capacity_ - 1);
+  size_t first_part = std::min(amount, capacity_ - offset);
+  memcpy(bytes, data_ + offset, first_part);
+  memcpy(bytes + first_part, data_, amount - first_part);
+
+  position_ += static_cast<uint32>(amount);
+  base::subtle::Release_Store(&header_->read_position,
+                              static_cast<base::subtle::Atomic32>(position_));
+  *bytes_read = amount;
+  return true;
+}
+
+bool SharedMemoryRing::PrepareToWaitForData() {
+  base::subtle::NoBarrier_Store(&header_->reader_waiting, 1);
+  // Pairs with the barrier in ShouldWakeReader().
+  base::subtle::MemoryBarrier();
+  uint32 write_position = static_cast<uint32>(
+      base::subtle::NoBarrier_Load(&header_->write_position));
+  return write_position == position_;
+}
+
+bool SharedMemoryRing::ShouldWakeWriter() {
+  base::subtle::MemoryBarrier();
+  return TakeFlag(&header_->writer_waiting);
+}
+
+// static
+bool SharedMemoryRing::TakeFlag(volatile base::subtle::Atomic32* flag) {
+  // Check first, so that the common case doesn't write to the shared line.
+  if (!base::subtle::NoBarrier_Load(flag))
+    return false;
+  return base::subtle::NoBarrier_AtomicExchange(flag, 0) != 0;
+}
+
+int64 SharedMemoryRing::BytesInRing(uint32 read_position,
+                                    uint32 write_position) const {
+  uint32 bytes = write_position - read_position;
+  if (bytes > capacity_) {
+    LOG(ERROR) << "Invalid shared memory ring positions";
+    return -1;
+  }
+  return bytes;
+}
+
+}  // namespace internal
+}  // namespace IPC
@@ -0,0 +1,96 @@
+// Copyright 2014 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef IPC_IPC_SHARED_MEMORY_RING_H_
+#define IPC_IPC_SHARED_MEMORY_RING_H_
+
+#include "base/atomicops.h"
+#include "base/basictypes.h"
+#include "ipc/ipc_export.h"
+
+namespace IPC {
+namespace internal {
+
+// A single-producer, single-consumer byte ring in memory shared by two
+// processes, used by the POSIX channel to move message bytes without going
+// through the socket. Each process wraps the same memory in its own
+// SharedMemoryRing and uses it either as the writer or as the reader.
+//
+// The ring doesn't block. When the reader finds it empty, or the writer finds
+// it full, they flag that they're about to wait, and the other side is told
+// by ShouldWakeReader() or ShouldWakeWriter() that it has to wake them up,
+// which the channel does by writing to its socket.
+//
+// The other process may be compromised, so everything read from the shared
+// header is checked, and Read() and Write() fail rather than go out of
+// bounds when it doesn't make sense.
+class IPC_EXPORT SharedMemoryRing {
+ public:
+  // Returns the number of bytes of shared memory needed for a ring holding
+  // |capacity| bytes, which has to be a power of two.
+  static size_t RequiredMemorySize(size_t capacity);
+
+  // |memory| must be RequiredMemorySize(capacity) bytes, suitably aligned, and
+  // zero-filled before either side starts using it. It has to outlive this
+  // object.
+  SharedMemoryRing(void* memory, size_t capacity);
+  ~SharedMemoryRing();
+
+  // Writer side.
+
+  // Copies as many of the |size| bytes at |data| as fit into the ring, and
+  // sets |bytes_written| to their number. Returns false if the shared state
+  // is corrupt.
+  bool Write(const void* data, size_t size, size_t* bytes_written);
+
+  // Called after Write() couldn't write everything. Returns true if the
+  // writer should wait for ShouldWakeWriter() on the reader's side, or false
+  // if some space has been freed meanwhile.
+  bool PrepareToWaitForSpace();
+
+  // Called after writing some bytes. Returns true if the reader was waiting
+  // for them, and has to be woken up.
+  bool ShouldWakeReader();
+
+  // Reader side.
+
+  // Copies up to |size| bytes out of the ring into |buffer|, and sets
+  // |bytes_read| to their number. Returns false if the shared state is
+  // corrupt.
+  bool Read(void* buffer, size_t size, size_t* bytes_read);
+
+  // Called after Read() found the ring empty. Returns true if the reader
+  // should wait for ShouldWakeReader() on the writer's side, or false if some
+  // data has arrived meanwhile.
+  bool PrepareToWaitForData();
+
+  // Called after reading some bytes. Returns true if the writer was waiting
+  // for space, and has to be woken up.
+  bool ShouldWakeWriter();
+
+ private:
+  struct Header;
+
+  // Clears |*flag| and returns true if it was set.
+  static bool TakeFlag(volatile base::subtle::Atomic32* flag);
+
+  // Returns the number of bytes between the read and write positions, or -1
+  // if that doesn't fit in the ring.
+  int64 BytesInRing(uint32 read_position, uint32 write_position) const;
+
+  Header* header_;
+  char* data_;
+  const uint32 capacity_;
+
+  // This side's own position. Only the other side's position is loaded from
+  // the shared header, since this one can't be trusted once stored.
+  uint32 position_;
+
+  DISALLOW_COPY_AND_ASSIGN(SharedMemoryRing);
+};
+
+}  // namespace internal
+}  // namespace IPC
+
+#endif  // IPC_IPC_SHARED_MEMORY_RING_H_
@@ -0,0 +1,174 @@
+// Copyright 2014 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "ipc/ipc_shared_memory_ring.h"
+
+#include <string.h>
+
+#include <algorithm>
+#include <vector>
+
+#include "base/threading/platform_thread.h"
+#include "base/threading/simple_thread.h"
+#include "testing/gtest/include/gtest/gtest.h"
+
+namespace IPC {
+namespace internal {
+
+namespace {
+
+const size_t kCapacity = 1024;
+
+class SharedMemoryRingTest : public testing::Test {
+ protected:
+  SharedMemoryRingTest()
+      : memory_(SharedMemoryRing::RequiredMemorySize(kCapacity)),
+        writer_(&memory_[0], kCapacity),
+        reader_(&memory_[0], kCapacity) {
+  }
+
+  std::vector<char> memory_;
+  SharedMemoryRing writer_;
+  SharedMemoryRing reader_;
+};
+
+// Writes |total| bytes with a known pattern, in chunks of various sizes,
+// waiting whenever the ring is full.
+class WriterThread : public base::SimpleThread {
+ public:
+  WriterThread(SharedMemoryRing* ring, size_t total)
+      : base::SimpleThread("SharedMemoryRingWriter"),
+        ring_(ring),
+        total_(total) {
+  }
+
+  virtual void Run() OVERRIDE {
+    char chunk[300];
+    size_t written = 0;
+    while (written < total_) {
+      size_t size = std::min(total_ - written, 1 + written % sizeof(chunk));
+      for (size_t i = 0; i < size; ++i)
+        chunk[i] = static_cast<char>(written + i);
+      size_t offset = 0;
+      while (offset < size) {
+        size_t bytes_written = 0;
+        ASSERT_TRUE(ring_->Write(chunk + offset, size - offset,
+                                 &bytes_written));
+        offset += bytes_written;
+        if (offset < size && ring_->PrepareToWaitForSpace())
+          base::PlatformThread::YieldCurrentThread();
+      }
+      written += size;
+      ring_->ShouldWakeReader();
+    }
+  }
+
+ private:
+  SharedMemoryRing* ring_;
+  size_t total_;
+};
+
+}  // namespace
+
+TEST_F(SharedMemoryRingTest, ReadAndWrite) {
+  size_t bytes_read = 0;
+  char buffer[kCapacity];
+  EXPECT_TRUE(reader_.Read(buffer, sizeof(buffer), &bytes_read));
+  EXPECT_EQ(0u, bytes_read);
+
+  size_t bytes_written = 0;
+  EXPECT_TRUE(writer_.Write("hello", 5, &bytes_written));
+  EXPECT_EQ(5u, bytes_written);
+  EXPECT_TRUE(reader_.Read(buffer, 3, &bytes_read));
+  EXPECT_EQ(3u, bytes_read);
+  EXPECT_EQ(0, memcmp(buffer, "hel", 3));
+  EXPECT_TRUE(reader_.Read(buffer, sizeof(buffer), &bytes_read));
+  EXPECT_EQ(2u, bytes_read);
+  EXPECT_EQ(0, memcmp(buffer, "lo", 2));
+}
+
+TEST_F(SharedMemoryRingTest, WrapsAround) {
+  std::vector<char> data(kCapacity - 100, 'a');
+  std::vector<char> buffer(kCapacity);
+  size_t bytes_written = 0;
+  size_t bytes_read = 0;
+  EXPECT_TRUE(writer_.Write(&data[0], data.size(), &bytes_written));
+  EXPECT_TRUE(reader_.Read(&buffer[0], buffer.size(), &bytes_read));
+  EXPECT_EQ(data.size(), bytes_read);
+
+  // Only the capacity is accepted, in two parts that wrap around.
+  for (size_t i = 0; i < data.size(); ++i)
+    data[i] = static_cast<char>(i);
+  data.resize(kCapacity + 10);
+  EXPECT_TRUE(writer_.Write(&data[0], data.size(), &bytes_written));
+  EXPECT_EQ(kCapacity, bytes_written);
+  EXPECT_TRUE(writer_.Write(&data[0], data.size(), &bytes_written));
+  EXPECT_EQ(0u, bytes_written);
+
+  EXPECT_TRUE(reader_.Read(&buffer[0], buffer.size(), &bytes_read));
+  ASSERT_EQ(kCapacity, bytes_read);
+  EXPECT_EQ(0, memcmp(&buffer[0], &data[0], kCapacity));
+}
+
+TEST_F(SharedMemoryRingTest, Wakeups) {
+  char buffer[kCapacity];
+  size_t bytes_read = 0;
+  size_t bytes_written = 0;
+  EXPECT_FALSE(writer_.ShouldWakeReader());
+
+  // The reader waits on an empty ring, and has to be woken up once.
+  EXPECT_TRUE(reader_.PrepareToWaitForData());
+  EXPECT_TRUE(writer_.Write("x", 1, &bytes_written));
+  EXPECT_TRUE(writer_.ShouldWakeReader());
+  EXPECT_FALSE(writer_.ShouldWakeReader());
+  EXPECT_FALSE(reader_.PrepareToWaitForData());
+  EXPECT_TRUE(reader_.Read(buffer, sizeof(buffer), &bytes_read));
+
+  // Same for the writer on a full ring.
+  std::vector<char> data(kCapacity, 'a');
+  EXPECT_TRUE(writer_.Write(&data[0], data.size(), &bytes_written));
+  EXPECT_TRUE(writer_.PrepareToWaitForSpace());
+  EXPECT_TRUE(reader_.Read(buffer, 10, &bytes_read));
+  EXPECT_TRUE(reader_.ShouldWakeWriter());
+  EXPECT_FALSE(reader_.ShouldWakeWriter());
+  EXPECT_FALSE(writer_.PrepareToWaitForSpace());
+}
+
+TEST_F(SharedMemoryRingTest, RejectsCorruptPositions) {
+  size_t bytes_written = 0;
+  EXPECT_TRUE(writer_.Write("data", 4, &bytes_written));
+
+  // A write position beyond the capacity, as a compromised peer could store.
+  std::vector<char> corrupt(memory_);
+  corrupt[0] = 0x7f;
+  corrupt[1] = 0x7f;
+  SharedMemoryRing reader(&corrupt[0], kCapacity);
+  char buffer[kCapacity];
+  size_t bytes_read = 1;
+  EXPECT_FALSE(reader.Read(buffer, sizeof(buffer), &bytes_read));
+  EXPECT_EQ(0u, bytes_read);
+}
+
+TEST_F(SharedMemoryRingTest, Threads) {
+  const size_t kTotal = 1000 * 1000;
+  WriterThread writer_thread(&writer_, kTotal);
+  writer_thread.Start();
+
+  char buffer[500];
+  size_t total_read = 0;
+  while (total_read < kTotal) {
+    size_t bytes_read = 0;
+    ASSERT_TRUE(reader_.Read(buffer, sizeof(buffer), &bytes_read));
+    for (size_t i = 0; i < bytes_read; ++i)
+      ASSERT_EQ(static_cast<char>(total_read + i), buffer[i]);
+    total_read += bytes_read;
+    if (!bytes_read && reader_.PrepareToWaitForData())
+      base::PlatformThread::YieldCurrentThread();
+    reader_.ShouldWakeWriter();
+  }
+  writer_thread.Join();
+}
+
+}  // namespace internal
+}  // namespace IPC
@@ -330,6 +330,10 @@ bool SyncChannel::SyncContext::OnMessageReceived(const Message& msg) {
   if (TryFilters(msg))
     return true;
 
+  // The messages below bypass the queue in Context, so the ones before them
+  // have to be posted first.
+  FlushIncomingMessages();
+
   if (TryToUnblockListener(&msg))
     return true;
 
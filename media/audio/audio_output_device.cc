@@ -320,7 +320,13 @@ void AudioOutputDevice::AudioThreadCallback::Process(int pending_data) {
     render_callback_->RenderIO(
         input_bus_.get(), output_bus_.get(), audio_delay_milliseconds);
   } else {
-    render_callback_->Render(output_bus_.get(), audio_delay_milliseconds);
+    const int frames =
+        render_callback_->Render(output_bus_.get(), audio_delay_milliseconds);
+
+    // Zero the frames the client didn't render, rather than letting the
+    // browser side zero the whole shared buffer before every request.
+    if (frames < output_bus_->frames())
+      output_bus_->ZeroFramesPartial(frames, output_bus_->frames() - frames);
   }
 }
 
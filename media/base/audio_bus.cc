@@ -6,10 +6,16 @@
 
 #include "base/logging.h"
 #include "base/numerics/safe_conversions.h"
+#include "build/build_config.h"
 #include "media/audio/audio_parameters.h"
 #include "media/base/limits.h"
 #include "media/base/vector_math.h"
 
+#if defined(ARCH_CPU_X86_FAMILY) && defined(__SSE2__) && !defined(OS_NACL)
+#include <emmintrin.h>
+#define USE_SSE2_INTERLEAVE
+#endif
+
 namespace media {
 
 static const uint8 kUint8Bias = 128;
@@ -83,6 +89,42 @@ static void ToInterleavedInternal(const AudioBus* source, int start_frame,
   }
 }
 
+#if defined(USE_SSE2_INTERLEAVE)
+// Converts 4 samples to int16 like ToInterleavedInternal<int16, int16, 0>().
+static inline __m128i ConvertToInt16_SSE2(__m128 v) {
+  v = _mm_max_ps(_mm_min_ps(v, _mm_set1_ps(1.0f)), _mm_set1_ps(-1.0f));
+  const __m128 scale = _mm_or_ps(
+      _mm_and_ps(_mm_cmplt_ps(v, _mm_setzero_ps()), _mm_set1_ps(-kint16min)),
+      _mm_andnot_ps(_mm_cmplt_ps(v, _mm_setzero_ps()),
+                    _mm_set1_ps(kint16max)));
+  return _mm_cvttps_epi32(_mm_mul_ps(v, scale));
+}
+
+// Stereo int16 is what most audio devices take, so interleave it 8 frames at
+// a time. Returns the number of frames written, the rest is left to
+// ToInterleavedInternal().
+static int ToInterleavedStereoInt16_SSE2(const AudioBus* source,
+                                         int start_frame,
+                                         int frames,
+                                         int16* dest) {
+  const float* left = source->channel(0) + start_frame;
+  const float* right = source->channel(1) + start_frame;
+  const int last_frame = frames - frames % 8;
+  for (int i = 0; i < last_frame; i += 8) {
+    const __m128i l = _mm_packs_epi32(
+        ConvertToInt16_SSE2(_mm_loadu_ps(left + i)),
+        ConvertToInt16_SSE2(_mm_loadu_ps(left + i + 4)));
+    const __m128i r = _mm_packs_epi32(
+        ConvertToInt16_SSE2(_mm_loadu_ps(right + i)),
+        ConvertToInt16_SSE2(_mm_loadu_ps(right + i + 4)));
+    __m128i* out = reinterpret_cast<__m128i*>(dest + 2 * i);
+    _mm_storeu_si128(out, _mm_unpacklo_epi16(l, r));
+    _mm_storeu_si128(out + 1, _mm_unpackhi_epi16(l, r));
+  }
+  return last_frame;
+}
+#endif
+
 static void ValidateConfig(int channels, int frames) {
   CHECK_GT(frames, 0);
   CHECK_GT(channels, 0);
@@ -288,10 +330,20 @@ void AudioBus::ToInterleavedPartial(int start_frame, int frames,
       ToInterleavedInternal<uint8, int16, kUint8Bias>(
           this, start_frame, frames, dest, kint8min, kint8max);
       break;
-    case 2:
+    case 2: {
+      int frames_done = 0;
+#if defined(USE_SSE2_INTERLEAVE)
+      if (channels() == 2) {
+        frames_done = ToInterleavedStereoInt16_SSE2(
+            this, start_frame, frames, static_cast<int16*>(dest));
+      }
+#endif
       ToInterleavedInternal<int16, int16, 0>(
-          this, start_frame, frames, dest, kint16min, kint16max);
+          this, start_frame + frames_done, frames - frames_done,
+          static_cast<int16*>(dest) + frames_done * channels(), kint16min,
+          kint16max);
       break;
+    }
     case 4:
       ToInterleavedInternal<int32, int32, 0>(
           this, start_frame, frames, dest, kint32min, kint32max);
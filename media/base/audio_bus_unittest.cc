@@ -382,6 +382,43 @@ TEST_F(AudioBusTest, ToInterleavedPartial) {
       kPartialFrames * sizeof(*kTestVectorInt16) * kTestVectorChannels), 0);
 }
 
+// Verify that stereo int16 interleaving of long buffers, which has a fast
+// path, matches the interleaving of each channel on its own.
+TEST_F(AudioBusTest, ToInterleavedStereoInt16) {
+  static const int kFrames = 67;
+  scoped_ptr<AudioBus> bus = AudioBus::Create(2, kFrames);
+  scoped_ptr<AudioBus> left = AudioBus::Create(1, kFrames);
+  scoped_ptr<AudioBus> right = AudioBus::Create(1, kFrames);
+  for (int i = 0; i < kFrames; ++i) {
+    // Cover the [-1.5, 1.5] range to exercise clipping.
+    left->channel(0)[i] = bus->channel(0)[i] = 3.0f * i / kFrames - 1.5f;
+    right->channel(0)[i] = bus->channel(1)[i] = 1.5f - 3.0f * i / kFrames;
+  }
+  bus->channel(0)[0] = left->channel(0)[0] = -1;
+  bus->channel(0)[1] = left->channel(0)[1] = 1;
+  bus->channel(0)[2] = left->channel(0)[2] = 0;
+
+  int16 test_array[2 * kFrames];
+  int16 left_array[kFrames];
+  int16 right_array[kFrames];
+  bus->ToInterleaved(kFrames, sizeof(*test_array), test_array);
+  left->ToInterleaved(kFrames, sizeof(*left_array), left_array);
+  right->ToInterleaved(kFrames, sizeof(*right_array), right_array);
+  for (int i = 0; i < kFrames; ++i) {
+    SCOPED_TRACE(i);
+    EXPECT_EQ(left_array[i], test_array[2 * i]);
+    EXPECT_EQ(right_array[i], test_array[2 * i + 1]);
+  }
+
+  // Partial interleaves go through the same path.
+  static const int kPartialStart = 3;
+  int16 partial_array[2 * kFrames];
+  bus->ToInterleavedPartial(kPartialStart, kFrames - kPartialStart,
+                            sizeof(*partial_array), partial_array);
+  EXPECT_EQ(0, memcmp(partial_array, test_array + 2 * kPartialStart,
+                      2 * (kFrames - kPartialStart) * sizeof(*partial_array)));
+}
+
 TEST_F(AudioBusTest, Scale) {
   scoped_ptr<AudioBus> bus = AudioBus::Create(kChannels, kFrameCount);
 
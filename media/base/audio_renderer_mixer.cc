@@ -32,11 +32,12 @@ AudioRendererMixer::~AudioRendererMixer() {
   // Ensures that all mixer inputs have stopped themselves prior to destruction
   // and have called RemoveMixerInput().
   DCHECK_EQ(mixer_inputs_.size(), 0U);
+  DCHECK_EQ(pending_inputs_.size(), 0U);
 }
 
 void AudioRendererMixer::AddMixerInput(AudioConverter::InputCallback* input,
                                        const base::Closure& error_cb) {
-  base::AutoLock auto_lock(mixer_inputs_lock_);
+  base::AutoLock auto_lock(pending_inputs_lock_);
 
   if (!playing_) {
     playing_ = true;
@@ -44,13 +45,20 @@ void AudioRendererMixer::AddMixerInput(AudioConverter::InputCallback* input,
     audio_sink_->Play();
   }
 
-  DCHECK(mixer_inputs_.find(input) == mixer_inputs_.end());
-  mixer_inputs_[input] = error_cb;
-  audio_converter_.AddInput(input);
+  DCHECK(pending_inputs_.find(input) == pending_inputs_.end());
+  pending_inputs_[input] = error_cb;
 }
 
 void AudioRendererMixer::RemoveMixerInput(
     AudioConverter::InputCallback* input) {
+  {
+    base::AutoLock auto_lock(pending_inputs_lock_);
+    if (pending_inputs_.erase(input))
+      return;
+  }
+
+  // |input| was added by a previous Render(), so wait for any mix in progress
+  // to finish before removing it; the caller may destroy it right after.
   base::AutoLock auto_lock(mixer_inputs_lock_);
   audio_converter_.RemoveInput(input);
 
@@ -62,15 +70,20 @@ int AudioRendererMixer::Render(AudioBus* audio_bus,
                                int audio_delay_milliseconds) {
   base::AutoLock auto_lock(mixer_inputs_lock_);
 
-  // If there are no mixer inputs and we haven't seen one for a while, pause the
-  // sink to avoid wasting resources when media elements are present but remain
-  // in the pause state.
-  const base::TimeTicks now = base::TimeTicks::Now();
-  if (!mixer_inputs_.empty()) {
-    last_play_time_ = now;
-  } else if (now - last_play_time_ >= pause_delay_ && playing_) {
-    audio_sink_->Pause();
-    playing_ = false;
+  {
+    base::AutoLock pending_auto_lock(pending_inputs_lock_);
+    AddPendingInputs_Locked();
+
+    // If there are no mixer inputs and we haven't seen one for a while, pause
+    // the sink to avoid wasting resources when media elements are present but
+    // remain in the pause state.
+    const base::TimeTicks now = base::TimeTicks::Now();
+    if (!mixer_inputs_.empty()) {
+      last_play_time_ = now;
+    } else if (now - last_play_time_ >= pause_delay_ && playing_) {
+      audio_sink_->Pause();
+      playing_ = false;
+    }
   }
 
   audio_converter_.ConvertWithDelay(
@@ -80,6 +93,10 @@ int AudioRendererMixer::Render(AudioBus* audio_bus,
 
 void AudioRendererMixer::OnRenderError() {
   base::AutoLock auto_lock(mixer_inputs_lock_);
+  {
+    base::AutoLock pending_auto_lock(pending_inputs_lock_);
+    AddPendingInputs_Locked();
+  }
 
   // Call each mixer input and signal an error.
   for (AudioRendererMixerInputSet::iterator it = mixer_inputs_.begin();
@@ -88,4 +105,17 @@ void AudioRendererMixer::OnRenderError() {
   }
 }
 
+void AudioRendererMixer::AddPendingInputs_Locked() {
+  mixer_inputs_lock_.AssertAcquired();
+  pending_inputs_lock_.AssertAcquired();
+
+  for (AudioRendererMixerInputSet::iterator it = pending_inputs_.begin();
+       it != pending_inputs_.end(); ++it) {
+    DCHECK(mixer_inputs_.find(it->first) == mixer_inputs_.end());
+    audio_converter_.AddInput(it->first);
+  }
+  mixer_inputs_.insert(pending_inputs_.begin(), pending_inputs_.end());
+  pending_inputs_.clear();
+}
+
 }  // namespace media
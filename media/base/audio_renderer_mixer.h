@@ -40,21 +40,35 @@ class MEDIA_EXPORT AudioRendererMixer
                      int audio_delay_milliseconds) OVERRIDE;
   virtual void OnRenderError() OVERRIDE;
 
+  // Moves the inputs added since the last Render() into |mixer_inputs_| and
+  // |audio_converter_|.  Must be called with both locks held.
+  void AddPendingInputs_Locked();
+
   // Output sink for this mixer.
   scoped_refptr<AudioRendererSink> audio_sink_;
 
   // Set of mixer inputs to be mixed by this mixer.  Access is thread-safe
-  // through |mixer_inputs_lock_|.
+  // through |mixer_inputs_lock_|, which is held for the whole of Render().
   typedef std::map<AudioConverter::InputCallback*, base::Closure>
       AudioRendererMixerInputSet;
   AudioRendererMixerInputSet mixer_inputs_;
   base::Lock mixer_inputs_lock_;
 
+  // Inputs added since the last Render().  They are only handed to
+  // |audio_converter_| by the next Render(), so that AddMixerInput() doesn't
+  // have to wait for a mix in progress.  Access is thread-safe through
+  // |pending_inputs_lock_|, which is only held briefly and, when both are
+  // held, is always acquired after |mixer_inputs_lock_|.
+  AudioRendererMixerInputSet pending_inputs_;
+  base::Lock pending_inputs_lock_;
+
   // Handles mixing and resampling between input and output parameters.
   AudioConverter audio_converter_;
 
   // Handles physical stream pause when no inputs are playing.  For latency
-  // reasons we don't want to immediately pause the physical stream.
+  // reasons we don't want to immediately pause the physical stream.  Access
+  // to |last_play_time_| and |playing_| is thread-safe through
+  // |pending_inputs_lock_|.
   base::TimeDelta pause_delay_;
   base::TimeTicks last_play_time_;
   bool playing_;
@@ -445,6 +445,78 @@ TEST_P(AudioRendererMixerBehavioralTest, MixerPausesStream) {
   mixer_inputs_[0]->Stop();
 }
 
+// A mixer input that counts how often it is asked for data, and runs a
+// closure the first time, i.e. in the middle of a mix.
+class CountingMixerInput : public AudioConverter::InputCallback {
+ public:
+  CountingMixerInput() : provide_input_calls_(0) {}
+  virtual ~CountingMixerInput() {}
+
+  // AudioConverter::InputCallback implementation.
+  virtual double ProvideInput(AudioBus* audio_bus,
+                              base::TimeDelta buffer_delay) OVERRIDE {
+    ++provide_input_calls_;
+    if (!during_mix_cb_.is_null()) {
+      base::Closure during_mix_cb = during_mix_cb_;
+      during_mix_cb_.Reset();
+      during_mix_cb.Run();
+    }
+    audio_bus->Zero();
+    return 1;
+  }
+
+  void set_during_mix_cb(const base::Closure& during_mix_cb) {
+    during_mix_cb_ = during_mix_cb;
+  }
+
+  int provide_input_calls() const { return provide_input_calls_; }
+
+ private:
+  int provide_input_calls_;
+  base::Closure during_mix_cb_;
+
+  DISALLOW_COPY_AND_ASSIGN(CountingMixerInput);
+};
+
+static void AddAndRemoveMixerInput(AudioRendererMixer* mixer,
+                                   AudioConverter::InputCallback* input) {
+  mixer->AddMixerInput(input, base::Bind(&base::DoNothing));
+  mixer->RemoveMixerInput(input);
+}
+
+// Ensure inputs can be added and removed while a mix is in progress.  The mix
+// holds its lock, so this would deadlock if adding an input, or removing one
+// that was never mixed, had to wait for it.
+TEST_P(AudioRendererMixerBehavioralTest, AddRemoveInputDuringRender) {
+  CountingMixerInput playing_input;
+  CountingMixerInput added_input;
+  mixer_->AddMixerInput(&playing_input, base::Bind(&base::DoNothing));
+
+  // An input added and removed again during a mix is never asked for data.
+  playing_input.set_during_mix_cb(base::Bind(
+      &AddAndRemoveMixerInput, mixer_.get(), &added_input));
+  mixer_callback_->Render(audio_bus_.get(), 0);
+  EXPECT_EQ(1, playing_input.provide_input_calls());
+  EXPECT_EQ(0, added_input.provide_input_calls());
+
+  // An input added during a mix is used by the next one.  The inputs are only
+  // asked for data when the mixer runs out of buffered input, so this takes
+  // two more mixes: one to add |added_input| and one to use it.
+  playing_input.set_during_mix_cb(base::Bind(
+      &AudioRendererMixer::AddMixerInput, base::Unretained(mixer_.get()),
+      &added_input, base::Bind(&base::DoNothing)));
+  const int kMaxRenders = 3 * kHighLatencyBufferSize / kLowLatencyBufferSize;
+  for (int i = 0; i < kMaxRenders && added_input.provide_input_calls() == 0;
+       ++i) {
+    mixer_callback_->Render(audio_bus_.get(), 0);
+  }
+  EXPECT_EQ(3, playing_input.provide_input_calls());
+  EXPECT_EQ(1, added_input.provide_input_calls());
+
+  mixer_->RemoveMixerInput(&playing_input);
+  mixer_->RemoveMixerInput(&added_input);
+}
+
 INSTANTIATE_TEST_CASE_P(
     AudioRendererMixerTest, AudioRendererMixerTest, testing::Values(
         // No resampling.
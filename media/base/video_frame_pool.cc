@@ -61,12 +61,17 @@ scoped_refptr<VideoFrame> VideoFramePool::PoolImpl::CreateFrame(
     const gfx::Rect& visible_rect,
     const gfx::Size& natural_size,
     base::TimeDelta timestamp) {
-  base::AutoLock auto_lock(lock_);
-  DCHECK(!is_shutdown_);
-
   scoped_refptr<VideoFrame> frame;
 
-  while (!frame && !frames_.empty()) {
+  // Frames that don't match are released, and a new frame allocated, outside
+  // of |lock_|: both touch several megabytes for large frames, and
+  // FrameReleased() is called from the compositor thread.
+  std::list<scoped_refptr<VideoFrame> > unusable_frames;
+  {
+    base::AutoLock auto_lock(lock_);
+    DCHECK(!is_shutdown_);
+
+    while (!frames_.empty()) {
       scoped_refptr<VideoFrame> pool_frame = frames_.front();
       frames_.pop_front();
 
@@ -78,7 +83,10 @@ scoped_refptr<VideoFrame> VideoFramePool::PoolImpl::CreateFrame(
         frame->SetTimestamp(kNoTimestamp());
         break;
       }
+      unusable_frames.push_back(pool_frame);
+    }
   }
+  unusable_frames.clear();
 
   if (!frame) {
     frame = VideoFrame::CreateFrame(
@@ -90,9 +98,12 @@ scoped_refptr<VideoFrame> VideoFramePool::PoolImpl::CreateFrame(
 }
 
 void VideoFramePool::PoolImpl::Shutdown() {
-  base::AutoLock auto_lock(lock_);
-  is_shutdown_ = true;
-  frames_.clear();
+  std::list<scoped_refptr<VideoFrame> > frames;
+  {
+    base::AutoLock auto_lock(lock_);
+    is_shutdown_ = true;
+    frames.swap(frames_);
+  }
 }
 
 void VideoFramePool::PoolImpl::FrameReleased(
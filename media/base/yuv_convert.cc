@@ -304,7 +304,6 @@ void ScaleYUVToRGB32(const uint8* y_buf,
     const uint8* u_ptr = NULL;
     const uint8* v_ptr = NULL;
     // Apply vertical filtering if necessary.
-    // TODO(fbarchard): Remove memcpy when not necessary.
     if (filter & media::FILTER_BILINEAR_V) {
       int source_y = source_y_subpixel >> kFractionBits;
       y_ptr = y_buf + source_y * y_pitch;
@@ -313,6 +312,18 @@ void ScaleYUVToRGB32(const uint8* y_buf,
 
       // Vertical scaler uses 16.8 fixed point.
       int source_y_fraction = (source_y_subpixel & kFractionMask) >> 8;
+
+      // Rows which need no interpolation can be converted straight from the
+      // source when they aren't scaled either.  The copies below are only
+      // there to duplicate the last pixel for the horizontal scalers, which
+      // read one pixel past the end.  This is the common case of painting
+      // unscaled frames, where every row has a zero fraction.
+      if (source_y_fraction == 0 && source_dx == kFractionMax) {
+        g_convert_yuv_to_rgb32_row_proc_(
+            y_ptr, u_ptr, v_ptr, dest_pixel, width);
+        continue;
+      }
+
       if (source_y_fraction != 0) {
         g_filter_yuv_rows_proc_(
             ybuf, y_ptr, y_ptr + y_pitch, source_width, source_y_fraction);
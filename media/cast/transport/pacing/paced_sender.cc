@@ -5,6 +5,7 @@
 #include "media/cast/transport/pacing/paced_sender.h"
 
 #include "base/bind.h"
+#include "base/logging.h"
 #include "base/message_loop/message_loop.h"
 
 namespace media {
@@ -43,7 +44,7 @@ bool PacedSender::ResendPackets(const PacketList& packets) {
 }
 
 bool PacedSender::SendPacketsToTransport(const PacketList& packets,
-                                         PacketList* packets_not_sent) {
+                                         PacketQueue* packets_not_sent) {
   UpdateBurstSize(packets.size());
 
   if (!packets_not_sent->empty()) {
@@ -52,26 +53,18 @@ bool PacedSender::SendPacketsToTransport(const PacketList& packets,
     return true;
   }
 
-  PacketList packets_to_send;
-  PacketList::const_iterator first_to_store_it = packets.begin();
-
   size_t max_packets_to_send_now = burst_size_ - packets_sent_in_burst_;
-
-  if (max_packets_to_send_now > 0) {
-    size_t packets_to_send_now =
-        std::min(max_packets_to_send_now, packets.size());
-
-    std::advance(first_to_store_it, packets_to_send_now);
-    packets_to_send.insert(
-        packets_to_send.begin(), packets.begin(), first_to_store_it);
-  }
-  packets_not_sent->insert(
-      packets_not_sent->end(), first_to_store_it, packets.end());
-  packets_sent_in_burst_ = packets_to_send.size();
-  if (packets_to_send.empty())
+  size_t packets_to_send_now =
+      std::min(max_packets_to_send_now, packets.size());
+
+  packets_not_sent->insert(packets_not_sent->end(),
+                           packets.begin() + packets_to_send_now,
+                           packets.end());
+  packets_sent_in_burst_ = packets_to_send_now;
+  if (packets_to_send_now == 0)
     return true;
 
-  return TransmitPackets(packets_to_send);
+  return TransmitPackets(packets, packets_to_send_now);
 }
 
 bool PacedSender::SendRtcpPacket(const Packet& packet) {
@@ -103,45 +96,43 @@ void PacedSender::SendStoredPackets() {
     return;
 
   size_t packets_to_send = burst_size_;
-  PacketList packets_to_resend;
 
   // Send our re-send packets first.
-  if (!resend_packet_list_.empty()) {
-    PacketList::iterator it = resend_packet_list_.begin();
-    size_t packets_to_send_now =
-        std::min(packets_to_send, resend_packet_list_.size());
-    std::advance(it, packets_to_send_now);
-    packets_to_resend.insert(
-        packets_to_resend.begin(), resend_packet_list_.begin(), it);
-    resend_packet_list_.erase(resend_packet_list_.begin(), it);
-    packets_to_send -= packets_to_resend.size();
-  }
+  packets_to_send -= TransmitQueuedPackets(&resend_packet_list_,
+                                           packets_to_send);
   if (!packet_list_.empty() && packets_to_send > 0) {
-    PacketList::iterator it = packet_list_.begin();
-    size_t packets_to_send_now = std::min(packets_to_send, packet_list_.size());
-
-    std::advance(it, packets_to_send_now);
-    packets_to_resend.insert(packets_to_resend.end(), packet_list_.begin(), it);
-    packet_list_.erase(packet_list_.begin(), it);
+    packets_to_send -= TransmitQueuedPackets(&packet_list_, packets_to_send);
 
     if (packet_list_.empty()) {
       burst_size_ = 1;  // Reset burst size after we sent the last stored packet
       packets_sent_in_burst_ = 0;
     } else {
-      packets_sent_in_burst_ = packets_to_resend.size();
+      packets_sent_in_burst_ = burst_size_ - packets_to_send;
     }
   }
-  TransmitPackets(packets_to_resend);
 }
 
-bool PacedSender::TransmitPackets(const PacketList& packets) {
+bool PacedSender::TransmitPackets(const PacketList& packets,
+                                  size_t num_packets) {
+  DCHECK_LE(num_packets, packets.size());
   bool ret = true;
-  for (size_t i = 0; i < packets.size(); i++) {
+  for (size_t i = 0; i < num_packets; i++) {
     ret &= transport_->SendPacket(packets[i]);
   }
   return ret;
 }
 
+size_t PacedSender::TransmitQueuedPackets(PacketQueue* packets,
+                                          size_t max_packets) {
+  size_t packets_sent = 0;
+  while (packets_sent < max_packets && !packets->empty()) {
+    transport_->SendPacket(packets->front());
+    packets->pop_front();
+    ++packets_sent;
+  }
+  return packets_sent;
+}
+
 void PacedSender::UpdateBurstSize(size_t packets_to_send) {
   packets_to_send = std::max(packets_to_send,
                              resend_packet_list_.size() + packet_list_.size());
@@ -5,6 +5,7 @@
 #ifndef MEDIA_CAST_TRANSPORT_PACING_PACED_SENDER_H_
 #define MEDIA_CAST_TRANSPORT_PACING_PACED_SENDER_H_
 
+#include <deque>
 #include <list>
 #include <vector>
 
@@ -65,11 +66,19 @@ class PacedSender : public PacedPacketSender,
   void SendNextPacketBurst();
 
  private:
+  // Packets waiting for a later burst.  A deque, since they are sent from the
+  // front and copying the remaining packets on each burst is costly.
+  typedef std::deque<Packet> PacketQueue;
+
   bool SendPacketsToTransport(const PacketList& packets,
-                              PacketList* packets_not_sent);
+                              PacketQueue* packets_not_sent);
+
+  // Actually sends the first |num_packets| of |packets| to the transport.
+  bool TransmitPackets(const PacketList& packets, size_t num_packets);
 
-  // Actually sends the packets to the transport.
-  bool TransmitPackets(const PacketList& packets);
+  // Sends up to |max_packets| from the front of |packets| to the transport,
+  // removing them from |packets|.  Returns the number of packets sent.
+  size_t TransmitQueuedPackets(PacketQueue* packets, size_t max_packets);
   void SendStoredPackets();
   void UpdateBurstSize(size_t num_of_packets);
 
@@ -82,8 +91,8 @@ class PacedSender : public PacedPacketSender,
   base::TimeTicks time_last_process_;
   // Note: We can't combine the |packet_list_| and the |resend_packet_list_|
   // since then we might get reordering of the retransmitted packets.
-  PacketList packet_list_;
-  PacketList resend_packet_list_;
+  PacketQueue packet_list_;
+  PacketQueue resend_packet_list_;
 
   base::WeakPtrFactory<PacedSender> weak_factory_;
 
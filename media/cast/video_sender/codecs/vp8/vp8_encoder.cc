@@ -103,8 +103,14 @@ void Vp8Encoder::InitEncode(int number_of_cores) {
     config_->g_error_resilient = 1;
   }
 
-  if (cast_config_.width * cast_config_.height > 640 * 480 &&
-      number_of_cores >= 2) {
+  // Larger frames can use more encoder threads, while leaving a core for
+  // capture and the rest of the pipeline on machines that have enough.
+  const int frame_size = cast_config_.width * cast_config_.height;
+  if (frame_size > 1280 * 720 && number_of_cores >= 6) {
+    config_->g_threads = 4;  // 4 threads for full HD and above.
+  } else if (frame_size > 1280 * 720 && number_of_cores >= 4) {
+    config_->g_threads = 3;  // 3 threads for full HD on quad cores.
+  } else if (frame_size > 640 * 480 && number_of_cores >= 2) {
     config_->g_threads = 2;  // 2 threads for qHD/HD.
   } else {
     config_->g_threads = 1;  // 1 thread for VGA or less.
@@ -295,11 +295,17 @@ static bool IsRangeListSorted(
   return true;
 }
 
-// Comparison function for two Buffers based on timestamp.
-static bool BufferComparator(
-    const scoped_refptr<media::StreamParserBuffer>& first,
-    const scoped_refptr<media::StreamParserBuffer>& second) {
-  return first->GetDecodeTimestamp() < second->GetDecodeTimestamp();
+// Comparators for searching a BufferQueue by decode timestamp.
+static bool BufferIsBeforeTimestamp(
+    const scoped_refptr<media::StreamParserBuffer>& buffer,
+    base::TimeDelta timestamp) {
+  return buffer->GetDecodeTimestamp() < timestamp;
+}
+
+static bool TimestampIsBeforeBuffer(
+    base::TimeDelta timestamp,
+    const scoped_refptr<media::StreamParserBuffer>& buffer) {
+  return timestamp < buffer->GetDecodeTimestamp();
 }
 
 // Returns an estimate of how far from the beginning or end of a range a buffer
@@ -1692,18 +1698,14 @@ SourceBufferRange* SourceBufferRange::SplitRange(
 
 SourceBufferRange::BufferQueue::iterator SourceBufferRange::GetBufferItrAt(
     base::TimeDelta timestamp, bool skip_given_timestamp) {
-  // Need to make a dummy buffer with timestamp |timestamp| in order to search
-  // the |buffers_| container.
-  scoped_refptr<StreamParserBuffer> dummy_buffer =
-      StreamParserBuffer::CopyFrom(NULL, 0, false, DemuxerStream::UNKNOWN, 0);
-  dummy_buffer->SetDecodeTimestamp(timestamp);
-
+  // Compare against |timestamp| directly rather than a dummy buffer, since
+  // this runs for every range touched by each append.
   if (skip_given_timestamp) {
     return std::upper_bound(
-        buffers_.begin(), buffers_.end(), dummy_buffer, BufferComparator);
+        buffers_.begin(), buffers_.end(), timestamp, TimestampIsBeforeBuffer);
   }
   return std::lower_bound(
-      buffers_.begin(), buffers_.end(), dummy_buffer, BufferComparator);
+      buffers_.begin(), buffers_.end(), timestamp, BufferIsBeforeTimestamp);
 }
 
 SourceBufferRange::KeyframeMap::iterator
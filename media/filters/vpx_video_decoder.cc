@@ -15,6 +15,7 @@
 #include "base/single_thread_task_runner.h"
 #include "base/strings/string_number_conversions.h"
 #include "base/sys_byteorder.h"
+#include "base/sys_info.h"
 #include "media/base/bind_to_current_loop.h"
 #include "media/base/decoder_buffer.h"
 #include "media/base/demuxer_stream.h"
@@ -57,6 +58,10 @@ static int GetThreadCount(const VideoDecoderConfig& config) {
         decode_threads = 8;
       else if (config.coded_size().width() >= 1024)
         decode_threads = 4;
+      // Threads beyond the number of cores only add contention.
+      decode_threads = std::max(
+          kDecodeThreads,
+          std::min(decode_threads, base::SysInfo::NumberOfProcessors()));
     }
 
     return decode_threads;
@@ -13,12 +13,45 @@
 
 #include "base/logging.h"
 #include "base/memory/scoped_ptr.h"
+#include "build/build_config.h"
 #include "media/base/audio_bus.h"
 
+#if defined(ARCH_CPU_X86_FAMILY) && defined(__SSE__) && !defined(OS_NACL)
+#include <xmmintrin.h>
+#define USE_SSE_DOT_PRODUCT
+#endif
+
 namespace media {
 
 namespace internal {
 
+namespace {
+
+// Returns the dot product of the first |len| elements of |a| and |b|, which
+// need not be aligned since search offsets are arbitrary.  Summed into a
+// local rather than through the output pointer, which could alias the inputs
+// and so forced a store per sample.
+float DotProduct(const float* a, const float* b, int len) {
+  int n = 0;
+  float sum = 0.0f;
+#if defined(USE_SSE_DOT_PRODUCT)
+  const int kFloatsPerVector = 4;
+  __m128 m_sum = _mm_setzero_ps();
+  for (; n + kFloatsPerVector <= len; n += kFloatsPerVector) {
+    m_sum = _mm_add_ps(
+        m_sum, _mm_mul_ps(_mm_loadu_ps(a + n), _mm_loadu_ps(b + n)));
+  }
+  // Sum the four partial sums.
+  m_sum = _mm_add_ps(_mm_movehl_ps(m_sum, m_sum), m_sum);
+  _mm_store_ss(&sum, _mm_add_ss(m_sum, _mm_shuffle_ps(m_sum, m_sum, 1)));
+#endif
+  for (; n < len; ++n)
+    sum += a[n] * b[n];
+  return sum;
+}
+
+}  // namespace
+
 bool InInterval(int n, Interval q) {
   return n >= q.first && n <= q.second;
 }
@@ -48,13 +81,9 @@ void MultiChannelDotProduct(const AudioBus* a,
   DCHECK_LE(frame_offset_a + num_frames, a->frames());
   DCHECK_LE(frame_offset_b + num_frames, b->frames());
 
-  memset(dot_product, 0, sizeof(*dot_product) * a->channels());
   for (int k = 0; k < a->channels(); ++k) {
-    const float* ch_a = a->channel(k) + frame_offset_a;
-    const float* ch_b = b->channel(k) + frame_offset_b;
-    for (int n = 0; n < num_frames; ++n) {
-      dot_product[k] += *ch_a++ * *ch_b++;
-    }
+    dot_product[k] = DotProduct(a->channel(k) + frame_offset_a,
+                                b->channel(k) + frame_offset_b, num_frames);
   }
 }
 
@@ -67,12 +96,8 @@ void MultiChannelMovingBlockEnergies(const AudioBus* input,
   for (int k = 0; k < input->channels(); ++k) {
     const float* input_channel = input->channel(k);
 
-    energy[k] = 0;
-
     // First block of channel |k|.
-    for (int m = 0; m < frames_per_block; ++m) {
-      energy[k] += input_channel[m] * input_channel[m];
-    }
+    energy[k] = DotProduct(input_channel, input_channel, frames_per_block);
 
     const float* slide_out = input_channel;
     const float* slide_in = input_channel + frames_per_block;
@@ -158,6 +158,13 @@ class CompareMinTrackRunDataOffset {
 bool TrackRunIterator::Init(const MovieFragment& moof) {
   runs_.clear();
 
+  // TrackRunInfos hold a SampleInfo per sample, so they are built in place and
+  // |runs_| is never reallocated while filling it.
+  size_t run_count = 0;
+  for (size_t i = 0; i < moof.tracks.size(); i++)
+    run_count += moof.tracks[i].runs.size();
+  runs_.reserve(run_count);
+
   for (size_t i = 0; i < moof.tracks.size(); i++) {
     const TrackFragment& traf = moof.tracks[i];
 
@@ -209,7 +216,8 @@ bool TrackRunIterator::Init(const MovieFragment& moof) {
         trak->media.information.sample_table.sync_sample.is_present;
     for (size_t j = 0; j < traf.runs.size(); j++) {
       const TrackFragmentRun& trun = traf.runs[j];
-      TrackRunInfo tri;
+      runs_.push_back(TrackRunInfo());
+      TrackRunInfo& tri = runs_.back();
       tri.track_id = traf.header.track_id;
       tri.timescale = trak->media.header.timescale;
       tri.start_dts = run_start_dts;
@@ -278,12 +286,18 @@ bool TrackRunIterator::Init(const MovieFragment& moof) {
         if (!is_sync_sample_box_present)
           tri.samples[k].is_keyframe = true;
       }
-      runs_.push_back(tri);
       sample_count_sum += trun.sample_count;
     }
   }
 
-  std::sort(runs_.begin(), runs_.end(), CompareMinTrackRunDataOffset());
+  // Runs are usually stored in order already; sorting copies them around.
+  CompareMinTrackRunDataOffset compare;
+  for (size_t i = 1; i < runs_.size(); i++) {
+    if (compare(runs_[i], runs_[i - 1])) {
+      std::sort(runs_.begin(), runs_.end(), compare);
+      break;
+    }
+  }
   run_itr_ = runs_.begin();
   ResetRun();
   return true;
@@ -293,13 +293,14 @@ bool WebMClusterParser::OnBlock(bool is_simple_block, int track_num,
 
   Track* track = NULL;
   StreamParserBuffer::Type buffer_type = DemuxerStream::AUDIO;
-  std::string encryption_key_id;
+  // Points at the key ID rather than copying it, since this runs per block.
+  const std::string* encryption_key_id = NULL;
   if (track_num == audio_.track_num()) {
     track = &audio_;
-    encryption_key_id = audio_encryption_key_id_;
+    encryption_key_id = &audio_encryption_key_id_;
   } else if (track_num == video_.track_num()) {
     track = &video_;
-    encryption_key_id = video_encryption_key_id_;
+    encryption_key_id = &video_encryption_key_id_;
     buffer_type = DemuxerStream::VIDEO;
   } else if (ignored_tracks_.find(track_num) != ignored_tracks_.end()) {
     return true;
@@ -334,11 +335,11 @@ bool WebMClusterParser::OnBlock(bool is_simple_block, int track_num,
     // http://wiki.webmproject.org/encryption/webm-encryption-rfc
     scoped_ptr<DecryptConfig> decrypt_config;
     int data_offset = 0;
-    if (!encryption_key_id.empty() &&
+    if (!encryption_key_id->empty() &&
         !WebMCreateDecryptConfig(
              data, size,
-             reinterpret_cast<const uint8*>(encryption_key_id.data()),
-             encryption_key_id.size(),
+             reinterpret_cast<const uint8*>(encryption_key_id->data()),
+             encryption_key_id->size(),
              &decrypt_config, &data_offset)) {
       return false;
     }
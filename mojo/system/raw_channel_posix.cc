@@ -6,6 +6,7 @@
 
 #include <errno.h>
 #include <string.h>
+#include <sys/uio.h>
 #include <unistd.h>
 
 #include <algorithm>
@@ -32,6 +33,11 @@ namespace {
 
 const size_t kReadSize = 4096;
 
+// Queued messages are written together, with a single |writev()|, up to these
+// limits. (A larger front message is still written in one go.)
+const size_t kMaxWriteMessages = 64;
+const size_t kMaxWriteBytes = 256 * 1024;
+
 class RawChannelPosix : public RawChannel,
                         public base::MessageLoopForIO::Watcher {
  public:
@@ -57,11 +63,12 @@ class RawChannelPosix : public RawChannel,
   // thread WITHOUT |write_lock_| held.
   void CallOnFatalError(Delegate::FatalError fatal_error);
 
-  // Writes the message at the front of |write_message_queue_|, starting at
-  // |write_message_offset_|. It removes and destroys if the write completes and
-  // otherwise updates |write_message_offset_|. Returns true on success. Must be
-  // called under |write_lock_|.
-  bool WriteFrontMessageNoLock();
+  // Writes the messages at the front of |write_message_queue_|, starting at
+  // |write_message_offset_| in the first one, with a single |writev()| bounded
+  // by |kMaxWriteMessages| and |kMaxWriteBytes|. It removes and destroys the
+  // messages that were completely written and updates |write_message_offset_|.
+  // Returns true on success. Must be called under |write_lock_|.
+  bool WriteQueuedMessagesNoLock();
 
   // Cancels all pending writes and destroys the contents of
   // |write_message_queue_|. Should only be called if |write_stopped_| is false;
@@ -176,7 +183,7 @@ bool RawChannelPosix::WriteMessage(MessageInTransit* message) {
 
   write_message_queue_.push_front(message);
   DCHECK_EQ(write_message_offset_, 0u);
-  bool result = WriteFrontMessageNoLock();
+  bool result = WriteQueuedMessagesNoLock();
   DCHECK(result || write_message_queue_.empty());
 
   if (!result) {
@@ -228,10 +235,14 @@ void RawChannelPosix::OnFileCanReadWithoutBlocking(int fd) {
       read_buffer_.resize(new_size, 0);
     }
 
+    // Read as much as fits in the buffer (at least |kReadSize|), so that a
+    // burst of messages is picked up in one go.
+    size_t read_size = read_buffer_.size() -
+        (read_buffer_start + read_buffer_num_valid_bytes_);
     ssize_t bytes_read = HANDLE_EINTR(
         read(fd_.get().fd,
              &read_buffer_[read_buffer_start + read_buffer_num_valid_bytes_],
-             kReadSize));
+             read_size));
     if (bytes_read < 0) {
       if (errno != EAGAIN && errno != EWOULDBLOCK) {
         PLOG(ERROR) << "read";
@@ -290,8 +301,8 @@ void RawChannelPosix::OnFileCanReadWithoutBlocking(int fd) {
     if (did_dispatch_message)
       break;
 
-    // If we didn't max out |kReadSize|, stop reading for now.
-    if (static_cast<size_t>(bytes_read) < kReadSize)
+    // If we didn't fill the buffer, stop reading for now.
+    if (static_cast<size_t>(bytes_read) < read_size)
       break;
 
     // Else try to read some more....
@@ -321,7 +332,7 @@ void RawChannelPosix::OnFileCanWriteWithoutBlocking(int fd) {
       return;
     }
 
-    bool result = WriteFrontMessageNoLock();
+    bool result = WriteQueuedMessagesNoLock();
     DCHECK(result || write_message_queue_.empty());
 
     if (!result) {
@@ -351,23 +362,38 @@ void RawChannelPosix::CallOnFatalError(Delegate::FatalError fatal_error) {
   delegate()->OnFatalError(fatal_error);
 }
 
-bool RawChannelPosix::WriteFrontMessageNoLock() {
+bool RawChannelPosix::WriteQueuedMessagesNoLock() {
   write_lock_.AssertAcquired();
 
   DCHECK(!write_stopped_);
   DCHECK(!write_message_queue_.empty());
 
-  MessageInTransit* message = write_message_queue_.front();
-  DCHECK_LT(write_message_offset_, message->main_buffer_size());
-  size_t bytes_to_write = message->main_buffer_size() - write_message_offset_;
+  struct iovec iov[kMaxWriteMessages];
+  size_t num_iov = 0;
+  size_t bytes_to_write = 0;
+  for (std::deque<MessageInTransit*>::const_iterator it =
+           write_message_queue_.begin();
+       it != write_message_queue_.end() && num_iov < kMaxWriteMessages;
+       ++it) {
+    const MessageInTransit* message = *it;
+    size_t offset = num_iov == 0 ? write_message_offset_ : 0;
+    DCHECK_LT(offset, message->main_buffer_size());
+    size_t size = message->main_buffer_size() - offset;
+    if (num_iov > 0 && bytes_to_write + size > kMaxWriteBytes)
+      break;
+
+    iov[num_iov].iov_base = const_cast<char*>(
+        static_cast<const char*>(message->main_buffer()) + offset);
+    iov[num_iov].iov_len = size;
+    num_iov++;
+    bytes_to_write += size;
+  }
+
   ssize_t bytes_written = HANDLE_EINTR(
-      write(fd_.get().fd,
-            static_cast<const char*>(message->main_buffer()) +
-                write_message_offset_,
-            bytes_to_write));
+      writev(fd_.get().fd, iov, static_cast<int>(num_iov)));
   if (bytes_written < 0) {
     if (errno != EAGAIN && errno != EWOULDBLOCK) {
-      PLOG(ERROR) << "write of size " << bytes_to_write;
+      PLOG(ERROR) << "writev of size " << bytes_to_write;
       CancelPendingWritesNoLock();
       return false;
     }
@@ -378,12 +404,18 @@ bool RawChannelPosix::WriteFrontMessageNoLock() {
   }
 
   DCHECK_GE(bytes_written, 0);
-  if (static_cast<size_t>(bytes_written) < bytes_to_write) {
-    // Partial (or no) write.
-    write_message_offset_ += static_cast<size_t>(bytes_written);
-  } else {
+  DCHECK_LE(static_cast<size_t>(bytes_written), bytes_to_write);
+  size_t bytes_left = static_cast<size_t>(bytes_written);
+  for (size_t i = 0; i < num_iov; i++) {
+    if (bytes_left < iov[i].iov_len) {
+      // Partial (or no) write of this message.
+      write_message_offset_ += bytes_left;
+      break;
+    }
+
     // Complete write.
-    DCHECK_EQ(static_cast<size_t>(bytes_written), bytes_to_write);
+    bytes_left -= iov[i].iov_len;
+    MessageInTransit* message = write_message_queue_.front();
     write_message_queue_.pop_front();
     write_message_offset_ = 0;
     message->Destroy();
@@ -224,6 +224,35 @@ TEST_F(RawChannelPosixTest, WriteMessage) {
                                    base::Unretained(rc.get())));
 }
 
+// RawChannelPosixTest.WriteManySmallMessages ----------------------------------
+
+// Tests that lots of small messages queued behind each other (and so written
+// together) all arrive intact and in order.
+TEST_F(RawChannelPosixTest, WriteManySmallMessages) {
+  static const uint32_t kNumMessages = 20000;
+
+  WriteOnlyRawChannelDelegate delegate;
+  scoped_ptr<RawChannel> rc(RawChannel::Create(handles[0].Pass(),
+                                               &delegate,
+                                               io_thread_message_loop()));
+
+  TestMessageReaderAndChecker checker(handles[1].get());
+
+  test::PostTaskAndWait(io_thread_task_runner(),
+                        FROM_HERE,
+                        base::Bind(&InitOnIOThread, rc.get()));
+
+  for (uint32_t i = 0; i < kNumMessages; i++)
+    EXPECT_TRUE(rc->WriteMessage(MakeTestMessage(i % 100 + 1)));
+  for (uint32_t i = 0; i < kNumMessages; i++)
+    EXPECT_TRUE(checker.ReadAndCheckNextMessage(i % 100 + 1)) << i;
+
+  test::PostTaskAndWait(io_thread_task_runner(),
+                        FROM_HERE,
+                        base::Bind(&RawChannel::Shutdown,
+                                   base::Unretained(rc.get())));
+}
+
 // RawChannelPosixTest.OnReadMessage -------------------------------------------
 
 class ReadCheckerRawChannelDelegate : public RawChannel::Delegate {
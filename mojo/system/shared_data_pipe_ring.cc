@@ -0,0 +1,169 @@
+// Copyright 2014 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "mojo/system/shared_data_pipe_ring.h"
+
+#include <algorithm>
+
+#include "base/logging.h"
+#include "mojo/system/constants.h"
+
+namespace mojo {
+namespace system {
+
+namespace {
+
+// The producer's and consumer's positions are updated by different processes,
+// so they're kept on separate cache lines.
+const size_t kCacheLineSize = 64;
+
+}  // namespace
+
+struct SharedDataPipeRing::Header {
+  volatile base::subtle::Atomic32 write_position;
+  char padding1[kCacheLineSize - sizeof(base::subtle::Atomic32)];
+  volatile base::subtle::Atomic32 read_position;
+  char padding2[kCacheLineSize - sizeof(base::subtle::Atomic32)];
+};
+
+// static
+size_t SharedDataPipeRing::RequiredMemorySize(size_t capacity_num_bytes) {
+  return sizeof(Header) + capacity_num_bytes;
+}
+
+SharedDataPipeRing::SharedDataPipeRing(void* memory, size_t capacity_num_bytes)
+    : header_(static_cast<Header*>(memory)),
+      data_(static_cast<char*>(memory) + sizeof(Header)),
+      capacity_num_bytes_(static_cast<uint32_t>(capacity_num_bytes)),
+      position_(0),
+      two_phase_max_num_bytes_(0) {
+  COMPILE_ASSERT(sizeof(Header) % kDataPipeBufferAlignmentBytes == 0,
+                 header_breaks_buffer_alignment);
+  COMPILE_ASSERT(kMaxDataPipeCapacityBytes <= (1u << 30),
+                 positions_would_overflow);
+  DCHECK_GT(capacity_num_bytes, 0u);
+  DCHECK_LE(capacity_num_bytes, kMaxDataPipeCapacityBytes);
+  DCHECK_EQ(reinterpret_cast<uintptr_t>(memory) %
+                kDataPipeBufferAlignmentBytes, 0u);
+}
+
+SharedDataPipeRing::~SharedDataPipeRing() {
+}
+
+bool SharedDataPipeRing::ProducerBeginWrite(void** buffer,
+                                            uint32_t* buffer_num_bytes) {
+  int64_t used = BytesInRing(LoadReadPosition(), position_);
+  if (used < 0)
+    return false;
+
+  uint32_t offset = OffsetOf(position_);
+  *buffer = data_ + offset;
+  uint32_t free_num_bytes = capacity_num_bytes_ - static_cast<uint32_t>(used);
+  *buffer_num_bytes = std::min(free_num_bytes, capacity_num_bytes_ - offset);
+  two_phase_max_num_bytes_ = *buffer_num_bytes;
+  return true;
+}
+
+bool SharedDataPipeRing::ProducerEndWrite(uint32_t num_bytes_written) {
+  // The buffer handed out can only have shrunk from the producer's point of
+  // view (the consumer only frees space), so this is enough to stay in the
+  // ring.
+  DCHECK_LE(num_bytes_written, two_phase_max_num_bytes_);
+  if (num_bytes_written > two_phase_max_num_bytes_)
+    return false;
+
+  two_phase_max_num_bytes_ = 0;
+  position_ = Advance(position_, num_bytes_written);
+  base::subtle::Release_Store(&header_->write_position,
+                              static_cast<base::subtle::Atomic32>(position_));
+  return true;
+}
+
+bool SharedDataPipeRing::ProducerQueryFreeSpace(uint32_t* num_bytes) {
+  int64_t used = BytesInRing(LoadReadPosition(), position_);
+  if (used < 0)
+    return false;
+
+  *num_bytes = capacity_num_bytes_ - static_cast<uint32_t>(used);
+  return true;
+}
+
+bool SharedDataPipeRing::ConsumerBeginRead(const void** buffer,
+                                           uint32_t* buffer_num_bytes) {
+  int64_t available = BytesInRing(position_, LoadWritePosition());
+  if (available < 0)
+    return false;
+
+  uint32_t offset = OffsetOf(position_);
+  *buffer = data_ + offset;
+  *buffer_num_bytes = std::min(static_cast<uint32_t>(available),
+                               capacity_num_bytes_ - offset);
+  two_phase_max_num_bytes_ = *buffer_num_bytes;
+  return true;
+}
+
+bool SharedDataPipeRing::ConsumerEndRead(uint32_t num_bytes_read) {
+  DCHECK_LE(num_bytes_read, two_phase_max_num_bytes_);
+  if (num_bytes_read > two_phase_max_num_bytes_)
+    return false;
+
+  two_phase_max_num_bytes_ = 0;
+  position_ = Advance(position_, num_bytes_read);
+  base::subtle::Release_Store(&header_->read_position,
+                              static_cast<base::subtle::Atomic32>(position_));
+  return true;
+}
+
+bool SharedDataPipeRing::ConsumerQueryData(uint32_t* num_bytes) {
+  int64_t available = BytesInRing(position_, LoadWritePosition());
+  if (available < 0)
+    return false;
+
+  *num_bytes = static_cast<uint32_t>(available);
+  return true;
+}
+
+int64_t SharedDataPipeRing::BytesInRing(uint32_t read_position,
+                                        uint32_t write_position) const {
+  if (read_position >= 2 * capacity_num_bytes_ ||
+      write_position >= 2 * capacity_num_bytes_) {
+    LOG(ERROR) << "Invalid data pipe position";
+    return -1;
+  }
+
+  uint32_t num_bytes = write_position >= read_position ?
+      write_position - read_position :
+      write_position + 2 * capacity_num_bytes_ - read_position;
+  if (num_bytes > capacity_num_bytes_) {
+    LOG(ERROR) << "Invalid data pipe positions";
+    return -1;
+  }
+  return num_bytes;
+}
+
+uint32_t SharedDataPipeRing::OffsetOf(uint32_t position) const {
+  return position < capacity_num_bytes_ ? position :
+                                          position - capacity_num_bytes_;
+}
+
+uint32_t SharedDataPipeRing::Advance(uint32_t position,
+                                     uint32_t num_bytes) const {
+  position += num_bytes;
+  if (position >= 2 * capacity_num_bytes_)
+    position -= 2 * capacity_num_bytes_;
+  return position;
+}
+
+uint32_t SharedDataPipeRing::LoadReadPosition() const {
+  return static_cast<uint32_t>(
+      base::subtle::Acquire_Load(&header_->read_position));
+}
+
+uint32_t SharedDataPipeRing::LoadWritePosition() const {
+  return static_cast<uint32_t>(
+      base::subtle::Acquire_Load(&header_->write_position));
+}
+
+}  // namespace system
+}  // namespace mojo
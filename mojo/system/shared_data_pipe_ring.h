@@ -0,0 +1,98 @@
+// Copyright 2014 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef MOJO_SYSTEM_SHARED_DATA_PIPE_RING_H_
+#define MOJO_SYSTEM_SHARED_DATA_PIPE_RING_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "base/atomicops.h"
+#include "base/macros.h"
+#include "mojo/system/system_impl_export.h"
+
+namespace mojo {
+namespace system {
+
+// |SharedDataPipeRing| is the circular buffer of a data pipe whose producer
+// and consumer are in different processes, laid out in memory mapped by both.
+// Each process wraps the same memory in its own |SharedDataPipeRing| and uses
+// only the producer or only the consumer methods. Two-phase writes and reads
+// hand out pointers directly into the shared memory, so the data is never
+// copied on its way from one process to the other; the other side only has to
+// be told (over the |Channel|) that the ring's state changed so that it can
+// awake its waiters.
+//
+// Only the state that each side owns is ever written by it, so the producer
+// and consumer don't need a lock. The other process may be compromised, so
+// what it wrote is validated before being used, and the methods fail rather
+// than hand out a buffer that isn't inside the ring.
+//
+// Each instance is not thread-safe (the owning |DataPipe|'s lock is expected
+// to protect it).
+class MOJO_SYSTEM_IMPL_EXPORT SharedDataPipeRing {
+ public:
+  // Returns the number of bytes of shared memory needed for a ring holding
+  // |capacity_num_bytes| bytes (which must be at most
+  // |kMaxDataPipeCapacityBytes|).
+  static size_t RequiredMemorySize(size_t capacity_num_bytes);
+
+  // |memory| must be |RequiredMemorySize(capacity_num_bytes)| bytes, aligned
+  // on a |kDataPipeBufferAlignmentBytes| boundary, and zero-filled before
+  // either side starts using it. It must outlive this object.
+  SharedDataPipeRing(void* memory, size_t capacity_num_bytes);
+  ~SharedDataPipeRing();
+
+  // Producer side. These return false if the shared state is invalid.
+  //
+  // Gets the largest contiguous free part of the ring (which may be empty).
+  bool ProducerBeginWrite(void** buffer, uint32_t* buffer_num_bytes);
+  // Makes |num_bytes_written| bytes from the start of the buffer obtained
+  // from |ProducerBeginWrite()| available to the consumer.
+  bool ProducerEndWrite(uint32_t num_bytes_written);
+  // Gets the total free space.
+  bool ProducerQueryFreeSpace(uint32_t* num_bytes);
+
+  // Consumer side. These return false if the shared state is invalid.
+  //
+  // Gets the largest contiguous readable part of the ring (which may be
+  // empty).
+  bool ConsumerBeginRead(const void** buffer, uint32_t* buffer_num_bytes);
+  // Frees |num_bytes_read| bytes from the start of the buffer obtained from
+  // |ConsumerBeginRead()|.
+  bool ConsumerEndRead(uint32_t num_bytes_read);
+  // Gets the total amount of data.
+  bool ConsumerQueryData(uint32_t* num_bytes);
+
+ private:
+  struct Header;
+
+  // Positions are in [0, 2 * |capacity_num_bytes_|), which distinguishes a
+  // full ring from an empty one. Returns the number of bytes between them, or
+  // -1 if they're invalid.
+  int64_t BytesInRing(uint32_t read_position, uint32_t write_position) const;
+  uint32_t OffsetOf(uint32_t position) const;
+  uint32_t Advance(uint32_t position, uint32_t num_bytes) const;
+
+  // Loads the position that's owned by the other side.
+  uint32_t LoadReadPosition() const;
+  uint32_t LoadWritePosition() const;
+
+  Header* const header_;
+  char* const data_;
+  const uint32_t capacity_num_bytes_;
+
+  // This side's own position (which is never loaded back from the shared
+  // header), and the size of the buffer handed out by the current two-phase
+  // write or read.
+  uint32_t position_;
+  uint32_t two_phase_max_num_bytes_;
+
+  DISALLOW_COPY_AND_ASSIGN(SharedDataPipeRing);
+};
+
+}  // namespace system
+}  // namespace mojo
+
+#endif  // MOJO_SYSTEM_SHARED_DATA_PIPE_RING_H_
@@ -0,0 +1,229 @@
+// Copyright 2014 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "mojo/system/shared_data_pipe_ring.h"
+
+#include <string.h>
+
+#include <algorithm>
+
+#include "base/basictypes.h"
+#include "base/memory/aligned_memory.h"
+#include "base/memory/scoped_ptr.h"
+#include "base/threading/platform_thread.h"
+#include "base/threading/simple_thread.h"
+#include "mojo/system/constants.h"
+#include "testing/gtest/include/gtest/gtest.h"
+
+namespace mojo {
+namespace system {
+namespace {
+
+const uint32_t kCapacity = 1000;
+
+// Allocates zero-filled memory for a ring of |kCapacity| bytes (standing in
+// for the shared memory), and a producer and a consumer using it.
+class SharedDataPipeRingTest : public testing::Test {
+ public:
+  SharedDataPipeRingTest()
+      : memory_size_(SharedDataPipeRing::RequiredMemorySize(kCapacity)),
+        memory_(static_cast<char*>(
+            base::AlignedAlloc(memory_size_, kDataPipeBufferAlignmentBytes))) {
+    memset(memory_.get(), 0, memory_size_);
+    producer_.reset(new SharedDataPipeRing(memory_.get(), kCapacity));
+    consumer_.reset(new SharedDataPipeRing(memory_.get(), kCapacity));
+  }
+  virtual ~SharedDataPipeRingTest() {}
+
+ protected:
+  // Writes |num_bytes| bytes with values starting at |first_value|, in as many
+  // two-phase writes as needed. Returns the number of bytes written.
+  uint32_t Write(uint32_t num_bytes, uint32_t first_value) {
+    uint32_t written = 0;
+    while (written < num_bytes) {
+      void* buffer = NULL;
+      uint32_t buffer_num_bytes = 0;
+      EXPECT_TRUE(producer_->ProducerBeginWrite(&buffer, &buffer_num_bytes));
+      if (!buffer_num_bytes)
+        break;
+      buffer_num_bytes = std::min(buffer_num_bytes, num_bytes - written);
+      for (uint32_t i = 0; i < buffer_num_bytes; i++) {
+        static_cast<unsigned char*>(buffer)[i] =
+            static_cast<unsigned char>(first_value + written + i);
+      }
+      EXPECT_TRUE(producer_->ProducerEndWrite(buffer_num_bytes));
+      written += buffer_num_bytes;
+    }
+    return written;
+  }
+
+  // Reads (and checks) up to |num_bytes| bytes written by |Write()|. Returns
+  // the number of bytes read.
+  uint32_t ReadAndCheck(uint32_t num_bytes, uint32_t first_value) {
+    uint32_t read = 0;
+    while (read < num_bytes) {
+      const void* buffer = NULL;
+      uint32_t buffer_num_bytes = 0;
+      EXPECT_TRUE(consumer_->ConsumerBeginRead(&buffer, &buffer_num_bytes));
+      if (!buffer_num_bytes)
+        break;
+      buffer_num_bytes = std::min(buffer_num_bytes, num_bytes - read);
+      for (uint32_t i = 0; i < buffer_num_bytes; i++) {
+        EXPECT_EQ(static_cast<unsigned char>(first_value + read + i),
+                  static_cast<const unsigned char*>(buffer)[i]);
+      }
+      EXPECT_TRUE(consumer_->ConsumerEndRead(buffer_num_bytes));
+      read += buffer_num_bytes;
+    }
+    return read;
+  }
+
+  const size_t memory_size_;
+  scoped_ptr<char, base::AlignedFreeDeleter> memory_;
+  scoped_ptr<SharedDataPipeRing> producer_;
+  scoped_ptr<SharedDataPipeRing> consumer_;
+
+ private:
+  DISALLOW_COPY_AND_ASSIGN(SharedDataPipeRingTest);
+};
+
+TEST_F(SharedDataPipeRingTest, TwoPhaseWriteAndRead) {
+  uint32_t num_bytes = 0;
+  EXPECT_TRUE(consumer_->ConsumerQueryData(&num_bytes));
+  EXPECT_EQ(0u, num_bytes);
+  EXPECT_TRUE(producer_->ProducerQueryFreeSpace(&num_bytes));
+  EXPECT_EQ(kCapacity, num_bytes);
+
+  // The consumer sees the producer's buffer.
+  void* write_buffer = NULL;
+  EXPECT_TRUE(producer_->ProducerBeginWrite(&write_buffer, &num_bytes));
+  EXPECT_EQ(kCapacity, num_bytes);
+  EXPECT_EQ(0u, reinterpret_cast<uintptr_t>(write_buffer) %
+                    kDataPipeBufferAlignmentBytes);
+  memcpy(write_buffer, "hello", 5);
+  EXPECT_TRUE(producer_->ProducerEndWrite(5));
+
+  const void* read_buffer = NULL;
+  EXPECT_TRUE(consumer_->ConsumerBeginRead(&read_buffer, &num_bytes));
+  EXPECT_EQ(5u, num_bytes);
+  EXPECT_EQ(write_buffer, read_buffer);
+  EXPECT_EQ(0, memcmp(read_buffer, "hello", 5));
+  EXPECT_TRUE(consumer_->ConsumerEndRead(2));
+
+  EXPECT_TRUE(consumer_->ConsumerQueryData(&num_bytes));
+  EXPECT_EQ(3u, num_bytes);
+  EXPECT_TRUE(producer_->ProducerQueryFreeSpace(&num_bytes));
+  EXPECT_EQ(kCapacity - 3, num_bytes);
+  EXPECT_TRUE(consumer_->ConsumerBeginRead(&read_buffer, &num_bytes));
+  EXPECT_EQ(3u, num_bytes);
+  EXPECT_EQ(0, memcmp(read_buffer, "llo", 3));
+  EXPECT_TRUE(consumer_->ConsumerEndRead(3));
+}
+
+TEST_F(SharedDataPipeRingTest, WrapsAround) {
+  // Go around the ring (and the range of positions) a few times, with sizes
+  // that don't divide the capacity.
+  uint32_t value = 0;
+  for (int i = 0; i < 7; i++) {
+    EXPECT_EQ(700u, Write(700, value));
+    EXPECT_EQ(700u, ReadAndCheck(700, value));
+    value += 700;
+  }
+
+  // A full ring can't be written to, and is then available in at most two
+  // contiguous parts.
+  EXPECT_EQ(kCapacity, Write(kCapacity + 10, value));
+  void* buffer = NULL;
+  uint32_t num_bytes = 1;
+  EXPECT_TRUE(producer_->ProducerBeginWrite(&buffer, &num_bytes));
+  EXPECT_EQ(0u, num_bytes);
+  EXPECT_TRUE(producer_->ProducerEndWrite(0));
+
+  const void* read_buffer = NULL;
+  EXPECT_TRUE(consumer_->ConsumerBeginRead(&read_buffer, &num_bytes));
+  EXPECT_EQ(kCapacity - (7 * 700) % kCapacity, num_bytes);
+  EXPECT_TRUE(consumer_->ConsumerEndRead(0));
+  EXPECT_EQ(kCapacity, ReadAndCheck(kCapacity, value));
+}
+
+TEST_F(SharedDataPipeRingTest, RejectsInvalidPositions) {
+  EXPECT_EQ(10u, Write(10, 0));
+
+  // A compromised producer could store anything as its position.
+  memset(memory_.get(), 0x7f, 4);
+  uint32_t num_bytes = 0;
+  EXPECT_FALSE(consumer_->ConsumerQueryData(&num_bytes));
+  const void* buffer = NULL;
+  EXPECT_FALSE(consumer_->ConsumerBeginRead(&buffer, &num_bytes));
+
+  // Or a position that's valid, but further ahead than the capacity allows.
+  uint32_t position = kCapacity + 10 + 1;
+  memcpy(memory_.get(), &position, sizeof(position));
+  EXPECT_FALSE(consumer_->ConsumerBeginRead(&buffer, &num_bytes));
+
+  // Things are fine again once the position makes sense.
+  position = 10;
+  memcpy(memory_.get(), &position, sizeof(position));
+  EXPECT_EQ(10u, ReadAndCheck(10, 0));
+}
+
+class ProducerThread : public base::SimpleThread {
+ public:
+  ProducerThread(SharedDataPipeRing* producer, uint32_t total_num_bytes)
+      : base::SimpleThread("shared_data_pipe_ring_producer"),
+        producer_(producer),
+        total_num_bytes_(total_num_bytes) {
+  }
+  virtual ~ProducerThread() {}
+
+ private:
+  virtual void Run() OVERRIDE {
+    uint32_t written = 0;
+    while (written < total_num_bytes_) {
+      void* buffer = NULL;
+      uint32_t num_bytes = 0;
+      ASSERT_TRUE(producer_->ProducerBeginWrite(&buffer, &num_bytes));
+      num_bytes = std::min(num_bytes, total_num_bytes_ - written);
+      // Vary the sizes of the writes.
+      num_bytes = std::min(num_bytes, 1 + written % 300);
+      for (uint32_t i = 0; i < num_bytes; i++)
+        static_cast<char*>(buffer)[i] = static_cast<char>(written + i);
+      ASSERT_TRUE(producer_->ProducerEndWrite(num_bytes));
+      written += num_bytes;
+      if (!num_bytes)
+        base::PlatformThread::YieldCurrentThread();
+    }
+  }
+
+  SharedDataPipeRing* const producer_;
+  const uint32_t total_num_bytes_;
+
+  DISALLOW_COPY_AND_ASSIGN(ProducerThread);
+};
+
+TEST_F(SharedDataPipeRingTest, Threads) {
+  const uint32_t kTotalNumBytes = 1000 * 1000;
+  ProducerThread producer_thread(producer_.get(), kTotalNumBytes);
+  producer_thread.Start();
+
+  uint32_t read = 0;
+  while (read < kTotalNumBytes) {
+    const void* buffer = NULL;
+    uint32_t num_bytes = 0;
+    ASSERT_TRUE(consumer_->ConsumerBeginRead(&buffer, &num_bytes));
+    for (uint32_t i = 0; i < num_bytes; i++) {
+      ASSERT_EQ(static_cast<char>(read + i),
+                static_cast<const char*>(buffer)[i]);
+    }
+    ASSERT_TRUE(consumer_->ConsumerEndRead(num_bytes));
+    read += num_bytes;
+    if (!num_bytes)
+      base::PlatformThread::YieldCurrentThread();
+  }
+  producer_thread.Join();
+}
+
+}  // namespace
+}  // namespace system
+}  // namespace mojo
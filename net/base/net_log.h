@@ -133,6 +133,7 @@ class NET_EXPORT NetLog {
     EventType type() const { return type_; }
     Source source() const { return source_; }
     EventPhase phase() const { return phase_; }
+    base::TimeTicks time() const { return time_; }
 
     // Serializes the specified event to a Value.  The Value also includes the
     // current time.  Caller takes ownership of returned Value.  Takes in a time
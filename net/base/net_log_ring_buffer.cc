@@ -0,0 +1,163 @@
+// Copyright 2014 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "net/base/net_log_ring_buffer.h"
+
+#include <algorithm>
+
+#include "base/bind.h"
+#include "base/json/json_writer.h"
+#include "base/logging.h"
+#include "base/memory/scoped_ptr.h"
+#include "base/values.h"
+
+namespace net {
+
+namespace {
+
+base::Value* CopyParameters(const base::Value* parameters,
+                            NetLog::LogLevel /* log_level */) {
+  return parameters->DeepCopy();
+}
+
+}  // namespace
+
+NetLogRingBuffer::StoredEntry::StoredEntry()
+    : type(NetLog::TYPE_CANCELLED),
+      phase(NetLog::PHASE_NONE) {
+}
+
+NetLogRingBuffer::StoredEntry::~StoredEntry() {
+}
+
+NetLogRingBuffer::NetLogRingBuffer(size_t max_entries,
+                                   base::TimeDelta max_age)
+    : max_entries_(max_entries),
+      max_age_(max_age),
+      first_(0),
+      size_(0) {
+  DCHECK_GT(max_entries, 0u);
+  for (int i = 0; i < NetLog::EVENT_COUNT; ++i) {
+    sampling_intervals_[i] = 1;
+    sampling_counters_[i] = 0;
+  }
+}
+
+NetLogRingBuffer::~NetLogRingBuffer() {
+}
+
+void NetLogRingBuffer::StartObserving(NetLog* net_log,
+                                      NetLog::LogLevel log_level) {
+  net_log->AddThreadSafeObserver(this, log_level);
+}
+
+void NetLogRingBuffer::StopObserving() {
+  net_log()->RemoveThreadSafeObserver(this);
+}
+
+void NetLogRingBuffer::SetSamplingInterval(NetLog::EventType type,
+                                           int sampling_interval) {
+  DCHECK_GE(sampling_interval, 0);
+  base::AutoLock lock(lock_);
+  sampling_intervals_[type] = sampling_interval;
+  sampling_counters_[type] = 0;
+}
+
+size_t NetLogRingBuffer::GetSize() const {
+  base::AutoLock lock(lock_);
+  return size_;
+}
+
+base::ListValue* NetLogRingBuffer::GetEntriesAsValue() const {
+  base::ListValue* list = new base::ListValue();
+  base::TimeTicks cutoff = base::TimeTicks::Now() - max_age_;
+
+  base::AutoLock lock(lock_);
+  for (size_t i = 0; i < size_; ++i) {
+    const StoredEntry& stored = entries_[(first_ + i) % entries_.size()];
+    if (stored.time < cutoff)
+      continue;
+
+    NetLog::ParametersCallback parameters_callback;
+    if (stored.parameters.get()) {
+      parameters_callback =
+          base::Bind(&CopyParameters, stored.parameters.get());
+    }
+    NetLog::Entry entry(stored.type, stored.source, stored.phase, stored.time,
+                        stored.parameters.get() ? &parameters_callback : NULL,
+                        NetLog::LOG_ALL);
+    list->Append(entry.ToValue());
+  }
+  return list;
+}
+
+void NetLogRingBuffer::WriteToFile(FILE* file,
+                                   const base::Value& constants) const {
+  DCHECK(file);
+  scoped_ptr<base::ListValue> entries(GetEntriesAsValue());
+
+  // Like NetLogLogger, write one event per line, so that truncated files can
+  // still be loaded.
+  std::string json;
+  base::JSONWriter::Write(&constants, &json);
+  fprintf(file, "{\"constants\": %s,\n", json.c_str());
+  fprintf(file, "\"events\": [\n");
+  for (size_t i = 0; i < entries->GetSize(); ++i) {
+    const base::Value* value = NULL;
+    entries->Get(i, &value);
+    base::JSONWriter::Write(value, &json);
+    fprintf(file, "%s%s", (i ? ",\n" : ""), json.c_str());
+  }
+  fprintf(file, "]}");
+}
+
+void NetLogRingBuffer::OnAddEntry(const NetLog::Entry& entry) {
+  {
+    base::AutoLock lock(lock_);
+    int sampling_interval = sampling_intervals_[entry.type()];
+    if (sampling_interval != 1) {
+      if (sampling_interval == 0)
+        return;
+      int counter = sampling_counters_[entry.type()]++;
+      if (counter % sampling_interval != 0)
+        return;
+    }
+  }
+
+  // Build the parameters outside of the lock, as they're the expensive part.
+  StoredEntry stored;
+  stored.type = entry.type();
+  stored.source = entry.source();
+  stored.phase = entry.phase();
+  stored.time = entry.time();
+  stored.parameters.reset(entry.ParametersToValue());
+
+  base::AutoLock lock(lock_);
+  DropEntriesBefore(stored.time - max_age_);
+  if (size_ == entries_.size() && size_ < max_entries_) {
+    // Grow the ring, keeping its entries in order.
+    std::rotate(entries_.begin(), entries_.begin() + first_, entries_.end());
+    first_ = 0;
+    entries_.push_back(stored);
+    ++size_;
+  } else if (size_ < entries_.size()) {
+    entries_[(first_ + size_) % entries_.size()] = stored;
+    ++size_;
+  } else {
+    // The ring is full: overwrite the oldest entry.
+    entries_[first_] = stored;
+    first_ = (first_ + 1) % entries_.size();
+  }
+}
+
+void NetLogRingBuffer::DropEntriesBefore(base::TimeTicks cutoff) {
+  lock_.AssertAcquired();
+  while (size_ > 0 && entries_[first_].time < cutoff) {
+    entries_[first_].parameters.reset();
+    first_ = (first_ + 1) % entries_.size();
+    --size_;
+  }
+}
+
+}  // namespace net
@@ -0,0 +1,104 @@
+// Copyright 2014 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef NET_BASE_NET_LOG_RING_BUFFER_H_
+#define NET_BASE_NET_LOG_RING_BUFFER_H_
+
+#include <stdio.h>
+
+#include <vector>
+
+#include "base/memory/linked_ptr.h"
+#include "base/synchronization/lock.h"
+#include "base/time/time.h"
+#include "net/base/net_log.h"
+
+namespace base {
+class ListValue;
+class Value;
+}
+
+namespace net {
+
+// NetLogRingBuffer keeps the most recent entries of the NetLog it watches in
+// memory, so that logging can stay on and the last moments be dumped when
+// something goes wrong.
+//
+// Unlike NetLogLogger, which serializes every entry to JSON as it is added,
+// only the parameters of the entries are converted to Values as they are
+// added (the callbacks building them can't be kept), and the rest of the
+// conversion and the JSON serialization are done when the entries are
+// dumped. Entries are dropped once they are older than |max_age|, or when
+// more than |max_entries| of them are kept. Entries of chatty event types
+// can also be sampled.
+//
+// All methods can be called on any thread.
+class NET_EXPORT NetLogRingBuffer : public NetLog::ThreadSafeObserver {
+ public:
+  NetLogRingBuffer(size_t max_entries, base::TimeDelta max_age);
+  virtual ~NetLogRingBuffer();
+
+  // Starts observing |net_log| at |log_level|.  Must not already be watching a
+  // NetLog.
+  void StartObserving(NetLog* net_log, NetLog::LogLevel log_level);
+
+  // Stops observing net_log().  Must already be watching.
+  void StopObserving();
+
+  // Keeps one out of every |sampling_interval| entries of |type|, or none of
+  // them if it is 0.  All entries are kept by default.  Note that this can
+  // keep the end of an event without its beginning.
+  void SetSamplingInterval(NetLog::EventType type, int sampling_interval);
+
+  // Returns the number of entries kept.
+  size_t GetSize() const;
+
+  // Returns the entries kept, oldest first, as NetLog::Entry::ToValue() would.
+  // Caller takes ownership of returned value.
+  base::ListValue* GetEntriesAsValue() const;
+
+  // Writes the entries kept to |file|, in the format of NetLogLogger.
+  // |constants| is a legend for decoding constant values used in the log.
+  void WriteToFile(FILE* file, const base::Value& constants) const;
+
+  // net::NetLog::ThreadSafeObserver implementation:
+  virtual void OnAddEntry(const NetLog::Entry& entry) OVERRIDE;
+
+ private:
+  struct StoredEntry {
+    StoredEntry();
+    ~StoredEntry();
+
+    NetLog::EventType type;
+    NetLog::Source source;
+    NetLog::EventPhase phase;
+    base::TimeTicks time;
+    // NULL if the entry has no parameters.
+    linked_ptr<base::Value> parameters;
+  };
+
+  // Drops the entries added before |cutoff|.  |lock_| must be held.
+  void DropEntriesBefore(base::TimeTicks cutoff);
+
+  const size_t max_entries_;
+  const base::TimeDelta max_age_;
+
+  mutable base::Lock lock_;
+
+  // The entries kept, as a ring of up to |max_entries_| entries starting at
+  // |first_|.
+  std::vector<StoredEntry> entries_;
+  size_t first_;
+  size_t size_;
+
+  // Indexed by event type.
+  int sampling_intervals_[NetLog::EVENT_COUNT];
+  int sampling_counters_[NetLog::EVENT_COUNT];
+
+  DISALLOW_COPY_AND_ASSIGN(NetLogRingBuffer);
+};
+
+}  // namespace net
+
+#endif  // NET_BASE_NET_LOG_RING_BUFFER_H_
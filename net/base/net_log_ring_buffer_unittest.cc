@@ -0,0 +1,164 @@
+// Copyright 2014 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "net/base/net_log_ring_buffer.h"
+
+#include "base/callback.h"
+#include "base/file_util.h"
+#include "base/files/file_path.h"
+#include "base/files/scoped_temp_dir.h"
+#include "base/json/json_reader.h"
+#include "base/values.h"
+#include "testing/gtest/include/gtest/gtest.h"
+
+namespace net {
+
+namespace {
+
+const int kMaxEntries = 3;
+
+void AddEntry(NetLogRingBuffer* ring_buffer,
+              NetLog::EventType type,
+              int source_id,
+              base::TimeTicks time) {
+  NetLog::Source source(NetLog::SOURCE_URL_REQUEST, source_id);
+  NetLog::ParametersCallback callback =
+      NetLog::IntegerCallback("source_id", source_id);
+  NetLog::Entry entry(type, source, NetLog::PHASE_NONE, time, &callback,
+                      NetLog::LOG_BASIC);
+  ring_buffer->OnAddEntry(entry);
+}
+
+// Returns the source ids of the entries of |ring_buffer|, checking that they
+// match their parameters.
+std::vector<int> GetSourceIds(const NetLogRingBuffer& ring_buffer) {
+  std::vector<int> source_ids;
+  scoped_ptr<base::ListValue> entries(ring_buffer.GetEntriesAsValue());
+  for (size_t i = 0; i < entries->GetSize(); ++i) {
+    base::DictionaryValue* entry = NULL;
+    int source_id = -1;
+    int param = -2;
+    EXPECT_TRUE(entries->GetDictionary(i, &entry));
+    EXPECT_TRUE(entry->GetInteger("source.id", &source_id));
+    EXPECT_TRUE(entry->GetInteger("params.source_id", &param));
+    EXPECT_EQ(source_id, param);
+    source_ids.push_back(source_id);
+  }
+  return source_ids;
+}
+
+}  // namespace
+
+TEST(NetLogRingBufferTest, KeepsLatestEntries) {
+  NetLogRingBuffer ring_buffer(kMaxEntries, base::TimeDelta::FromHours(1));
+  base::TimeTicks now = base::TimeTicks::Now();
+  EXPECT_EQ(0u, ring_buffer.GetSize());
+  EXPECT_TRUE(GetSourceIds(ring_buffer).empty());
+
+  for (int i = 0; i < 5; ++i)
+    AddEntry(&ring_buffer, NetLog::TYPE_REQUEST_ALIVE, i, now);
+  EXPECT_EQ(static_cast<size_t>(kMaxEntries), ring_buffer.GetSize());
+
+  std::vector<int> source_ids = GetSourceIds(ring_buffer);
+  ASSERT_EQ(3u, source_ids.size());
+  EXPECT_EQ(2, source_ids[0]);
+  EXPECT_EQ(3, source_ids[1]);
+  EXPECT_EQ(4, source_ids[2]);
+}
+
+TEST(NetLogRingBufferTest, DropsOldEntries) {
+  NetLogRingBuffer ring_buffer(kMaxEntries, base::TimeDelta::FromMinutes(1));
+  base::TimeTicks now = base::TimeTicks::Now();
+  const base::TimeDelta kSecond = base::TimeDelta::FromSeconds(1);
+
+  AddEntry(&ring_buffer, NetLog::TYPE_REQUEST_ALIVE, 0, now - 100 * kSecond);
+  AddEntry(&ring_buffer, NetLog::TYPE_REQUEST_ALIVE, 1, now - 90 * kSecond);
+  AddEntry(&ring_buffer, NetLog::TYPE_REQUEST_ALIVE, 2, now - 50 * kSecond);
+  // Dropping the first two entries leaves room in the ring, which now wraps
+  // around.
+  AddEntry(&ring_buffer, NetLog::TYPE_REQUEST_ALIVE, 3, now - 20 * kSecond);
+  EXPECT_EQ(2u, ring_buffer.GetSize());
+  AddEntry(&ring_buffer, NetLog::TYPE_REQUEST_ALIVE, 4, now);
+  EXPECT_EQ(3u, ring_buffer.GetSize());
+
+  std::vector<int> source_ids = GetSourceIds(ring_buffer);
+  ASSERT_EQ(3u, source_ids.size());
+  EXPECT_EQ(2, source_ids[0]);
+  EXPECT_EQ(3, source_ids[1]);
+  EXPECT_EQ(4, source_ids[2]);
+}
+
+TEST(NetLogRingBufferTest, GrowsInOrder) {
+  NetLogRingBuffer ring_buffer(kMaxEntries, base::TimeDelta::FromMinutes(1));
+  base::TimeTicks now = base::TimeTicks::Now();
+  const base::TimeDelta kSecond = base::TimeDelta::FromSeconds(1);
+
+  AddEntry(&ring_buffer, NetLog::TYPE_REQUEST_ALIVE, 0, now - 90 * kSecond);
+  AddEntry(&ring_buffer, NetLog::TYPE_REQUEST_ALIVE, 1, now - 50 * kSecond);
+  // Drops the first entry, and reuses its slot.
+  AddEntry(&ring_buffer, NetLog::TYPE_REQUEST_ALIVE, 2, now - 20 * kSecond);
+  // The ring is full, but can still grow.
+  AddEntry(&ring_buffer, NetLog::TYPE_REQUEST_ALIVE, 3, now);
+
+  std::vector<int> source_ids = GetSourceIds(ring_buffer);
+  ASSERT_EQ(3u, source_ids.size());
+  EXPECT_EQ(1, source_ids[0]);
+  EXPECT_EQ(2, source_ids[1]);
+  EXPECT_EQ(3, source_ids[2]);
+}
+
+TEST(NetLogRingBufferTest, SamplesEventTypes) {
+  NetLogRingBuffer ring_buffer(10, base::TimeDelta::FromHours(1));
+  ring_buffer.SetSamplingInterval(NetLog::TYPE_SOCKET_BYTES_SENT, 0);
+  ring_buffer.SetSamplingInterval(NetLog::TYPE_SOCKET_BYTES_RECEIVED, 3);
+  base::TimeTicks now = base::TimeTicks::Now();
+
+  for (int i = 0; i < 7; ++i) {
+    AddEntry(&ring_buffer, NetLog::TYPE_SOCKET_BYTES_SENT, i, now);
+    AddEntry(&ring_buffer, NetLog::TYPE_SOCKET_BYTES_RECEIVED, 10 + i, now);
+    AddEntry(&ring_buffer, NetLog::TYPE_REQUEST_ALIVE, 20 + i, now);
+  }
+
+  std::vector<int> source_ids = GetSourceIds(ring_buffer);
+  const int kExpected[] = { 10, 20, 21, 22, 13, 23, 24, 25, 16, 26 };
+  ASSERT_EQ(arraysize(kExpected), source_ids.size());
+  for (size_t i = 0; i < arraysize(kExpected); ++i)
+    EXPECT_EQ(kExpected[i], source_ids[i]);
+}
+
+TEST(NetLogRingBufferTest, WritesValidJSON) {
+  base::ScopedTempDir temp_dir;
+  ASSERT_TRUE(temp_dir.CreateUniqueTempDir());
+  base::FilePath log_path = temp_dir.path().AppendASCII("NetLogFile");
+
+  NetLogRingBuffer ring_buffer(kMaxEntries, base::TimeDelta::FromHours(1));
+  base::TimeTicks now = base::TimeTicks::Now();
+  for (int i = 0; i < 2; ++i)
+    AddEntry(&ring_buffer, NetLog::TYPE_REQUEST_ALIVE, i, now);
+
+  FILE* file = base::OpenFile(log_path, "w");
+  ASSERT_TRUE(file);
+  base::DictionaryValue constants;
+  constants.SetInteger("logFormatVersion", 1);
+  ring_buffer.WriteToFile(file, constants);
+  base::CloseFile(file);
+
+  std::string input;
+  ASSERT_TRUE(base::ReadFileToString(log_path, &input));
+
+  base::JSONReader reader;
+  scoped_ptr<base::Value> root(reader.ReadToValue(input));
+  ASSERT_TRUE(root) << reader.GetErrorMessage();
+
+  base::DictionaryValue* dict;
+  ASSERT_TRUE(root->GetAsDictionary(&dict));
+  int version = 0;
+  EXPECT_TRUE(dict->GetInteger("constants.logFormatVersion", &version));
+  EXPECT_EQ(1, version);
+  base::ListValue* events;
+  ASSERT_TRUE(dict->GetList("events", &events));
+  ASSERT_EQ(2u, events->GetSize());
+}
+
+}  // namespace net
@@ -184,6 +184,10 @@ CertVerifyProc::CertVerifyProc() {}
 
 CertVerifyProc::~CertVerifyProc() {}
 
+bool CertVerifyProc::ChecksHostnameIndependently() const {
+  return false;
+}
+
 int CertVerifyProc::Verify(X509Certificate* cert,
                            const std::string& hostname,
                            int flags,
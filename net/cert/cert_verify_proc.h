@@ -66,6 +66,12 @@ class NET_EXPORT CertVerifyProc
   // passed to Verify() is ignored when this returns false.
   virtual bool SupportsAdditionalTrustAnchors() const = 0;
 
+  // Returns true if the |hostname| passed to Verify() only affects the
+  // result through X509Certificate::VerifyNameMatch() and the non-unique name
+  // check, so that a result for a chain that matched one hostname can be
+  // re-targeted to another hostname without building the chain again.
+  virtual bool ChecksHostnameIndependently() const;
+
  protected:
   CertVerifyProc();
   virtual ~CertVerifyProc();
@@ -18,6 +18,7 @@ class NET_EXPORT_PRIVATE CertVerifyProcNSS : public CertVerifyProc {
   CertVerifyProcNSS();
 
   virtual bool SupportsAdditionalTrustAnchors() const OVERRIDE;
+  virtual bool ChecksHostnameIndependently() const OVERRIDE;
 
  protected:
   virtual ~CertVerifyProcNSS();
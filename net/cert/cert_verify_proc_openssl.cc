@@ -183,6 +183,10 @@ bool CertVerifyProcOpenSSL::SupportsAdditionalTrustAnchors() const {
   return false;
 }
 
+bool CertVerifyProcOpenSSL::ChecksHostnameIndependently() const {
+  return true;
+}
+
 int CertVerifyProcOpenSSL::VerifyInternal(
     X509Certificate* cert,
     const std::string& hostname,
@@ -15,6 +15,7 @@ class CertVerifyProcOpenSSL : public CertVerifyProc {
   CertVerifyProcOpenSSL();
 
   virtual bool SupportsAdditionalTrustAnchors() const OVERRIDE;
+  virtual bool ChecksHostnameIndependently() const OVERRIDE;
 
  protected:
   virtual ~CertVerifyProcOpenSSL();
@@ -2,6 +2,8 @@
 // Use of this source code is governed by a BSD-style license that can be
 // found in the LICENSE file.
 
+#include <algorithm>
+
 #include "base/base64.h"
 #include "base/format_macros.h"
 #include "base/json/json_reader.h"
@@ -255,6 +257,7 @@ bool CRLSet::Parse(base::StringPiece data, scoped_refptr<CRLSet>* out_crl_set) {
   if (!crl_set->CopyBlockedSPKIsFromHeader(header_dict.get()))
     return false;
 
+  crl_set->BuildSerialIndexes();
   *out_crl_set = crl_set;
   return true;
 }
@@ -431,6 +434,7 @@ bool CRLSet::ApplyDelta(const base::StringPiece& in_data,
   if (i != crls_.size())
     return false;
 
+  crl_set->BuildSerialIndexes();
   *out_crl_set = crl_set;
   return true;
 }
@@ -533,6 +537,43 @@ CRLSet::Result CRLSet::CheckSPKI(const base::StringPiece& spki_hash) const {
   return GOOD;
 }
 
+namespace {
+
+// SerialIndexLess orders indexes into |serials| by the serial numbers at those
+// indexes.
+class SerialIndexLess {
+ public:
+  explicit SerialIndexLess(const std::vector<std::string>* serials)
+      : serials_(serials) {
+  }
+
+  bool operator()(uint32 a, uint32 b) const {
+    return (*serials_)[a] < (*serials_)[b];
+  }
+
+  bool operator()(uint32 a, const base::StringPiece& b) const {
+    return base::StringPiece((*serials_)[a]) < b;
+  }
+
+ private:
+  const std::vector<std::string>* serials_;
+};
+
+}  // namespace
+
+void CRLSet::BuildSerialIndexes() {
+  sorted_serial_indexes_.resize(crls_.size());
+  for (size_t i = 0; i < crls_.size(); ++i) {
+    const std::vector<std::string>& serials = crls_[i].second;
+    std::vector<uint32>& sorted_indexes = sorted_serial_indexes_[i];
+    sorted_indexes.resize(serials.size());
+    for (size_t j = 0; j < serials.size(); ++j)
+      sorted_indexes[j] = static_cast<uint32>(j);
+    std::sort(sorted_indexes.begin(), sorted_indexes.end(),
+              SerialIndexLess(&serials));
+  }
+}
+
 CRLSet::Result CRLSet::CheckSerial(
     const base::StringPiece& serial_number,
     const base::StringPiece& issuer_spki_hash) const {
@@ -553,12 +594,14 @@ CRLSet::Result CRLSet::CheckSerial(
   if (i == crls_index_by_issuer_.end())
     return UNKNOWN;
   const std::vector<std::string>& serials = crls_[i->second].second;
+  const std::vector<uint32>& sorted_indexes =
+      sorted_serial_indexes_[i->second];
 
-  for (std::vector<std::string>::const_iterator i = serials.begin();
-       i != serials.end(); ++i) {
-    if (base::StringPiece(*i) == serial)
-      return REVOKED;
-  }
+  std::vector<uint32>::const_iterator j = std::lower_bound(
+      sorted_indexes.begin(), sorted_indexes.end(), serial,
+      SerialIndexLess(&serials));
+  if (j != sorted_indexes.end() && base::StringPiece(serials[*j]) == serial)
+    return REVOKED;
 
   return GOOD;
 }
@@ -605,6 +648,7 @@ CRLSet* CRLSet::ForTesting(bool is_expired,
   if (!serial_number.empty())
     crl_set->crls_[0].second.push_back(serial_number);
 
+  crl_set->BuildSerialIndexes();
   return crl_set;
 }
 
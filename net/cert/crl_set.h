@@ -108,6 +108,10 @@ class NET_EXPORT CRLSet : public base::RefCountedThreadSafe<CRLSet> {
   // from "BlockedSPKIs" in |header_dict|.
   bool CopyBlockedSPKIsFromHeader(base::DictionaryValue* header_dict);
 
+  // BuildSerialIndexes sets |sorted_serial_indexes_| from |crls_|. It must be
+  // called once |crls_| is complete.
+  void BuildSerialIndexes();
+
   uint32 sequence_;
   CRLList crls_;
   // not_after_ contains the time, in UNIX epoch seconds, after which the
@@ -118,6 +122,11 @@ class NET_EXPORT CRLSet : public base::RefCountedThreadSafe<CRLSet> {
   // and |crls_index_by_issuer_| because, when applying a delta update, we need
   // to identify a CRL by index.
   std::map<std::string, size_t> crls_index_by_issuer_;
+  // sorted_serial_indexes_[i] contains the indexes of the serials of
+  // |crls_[i]|, in the order of the serials, so that CheckSerial can binary
+  // search them. The serials themselves are kept in their serialized order
+  // because delta updates refer to them by index.
+  std::vector<std::vector<uint32> > sorted_serial_indexes_;
   // blocked_spkis_ contains the SHA256 hashes of SPKIs which are to be blocked
   // no matter where in a certificate chain they might appear.
   std::vector<std::string> blocked_spkis_;
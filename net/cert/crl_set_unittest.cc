@@ -295,6 +295,35 @@ TEST(CRLSetTest, UpdateSerialsDelta) {
   EXPECT_EQ(45u, serials.size());
 }
 
+TEST(CRLSetTest, CheckSerialAfterDelta) {
+  base::StringPiece s(reinterpret_cast<const char*>(kGIACRLSet),
+                      sizeof(kGIACRLSet));
+  scoped_refptr<net::CRLSet> set;
+  EXPECT_TRUE(net::CRLSet::Parse(s, &set));
+  ASSERT_TRUE(set.get() != NULL);
+
+  scoped_refptr<net::CRLSet> delta_set;
+  base::StringPiece delta(reinterpret_cast<const char*>(kUpdateSerialsDelta),
+                          sizeof(kUpdateSerialsDelta));
+  EXPECT_TRUE(set->ApplyDelta(delta, &delta_set));
+  ASSERT_TRUE(delta_set.get() != NULL);
+
+  // Every serial of the updated CRL is found, whatever its position.
+  const std::string gia_spki_hash(
+      reinterpret_cast<const char*>(kGIASPKISHA256),
+      sizeof(kGIASPKISHA256));
+  const std::vector<std::string>& serials = delta_set->crls()[0].second;
+  for (size_t i = 0; i < serials.size(); ++i) {
+    const std::string& serial = serials[i];
+    if (serial.empty() || (serial[0] & 0x80) != 0 || serial[0] == 0x00)
+      continue;
+    EXPECT_EQ(net::CRLSet::REVOKED,
+              delta_set->CheckSerial(serial, gia_spki_hash)) << i;
+    EXPECT_EQ(net::CRLSet::GOOD,
+              delta_set->CheckSerial(serial + '\x01', gia_spki_hash)) << i;
+  }
+}
+
 TEST(CRLSetTest, BlockedSPKIs) {
   base::StringPiece s(reinterpret_cast<const char*>(kBlockedSPKICRLSet),
                       sizeof(kBlockedSPKICRLSet));
@@ -17,6 +17,8 @@
 #include "base/time/time.h"
 #include "net/base/net_errors.h"
 #include "net/base/net_log.h"
+#include "net/base/net_util.h"
+#include "net/cert/cert_status_flags.h"
 #include "net/cert/cert_trust_anchor_provider.h"
 #include "net/cert/cert_verify_proc.h"
 #include "net/cert/crl_set.h"
@@ -78,6 +80,25 @@ const unsigned kMaxCacheEntries = 256;
 // The number of seconds for which we'll cache a cache entry.
 const unsigned kTTLSecs = 1800;  // 30 minutes.
 
+// Returns the error that a CertVerifyProc returns for |cert_status| when
+// verification only failed because of certificate errors.
+int GetErrorForCertStatus(CertStatus cert_status) {
+  // CERT_STATUS_NON_UNIQUE_NAME is only a warning.
+  cert_status &= ~CERT_STATUS_NON_UNIQUE_NAME;
+  return IsCertStatusError(cert_status) ?
+      MapCertStatusToNetError(cert_status) : OK;
+}
+
+// Returns true if the result of verifying a chain for one hostname can be
+// re-targeted to another hostname: the chain matched the hostname, and the
+// error only reflects the certificate status (rather than, say, a failure of
+// the underlying library). Verification stops before the EV checks when the
+// name doesn't match, so results for mismatched names can't be re-targeted.
+bool CanRetargetResult(int error, const CertVerifyResult& verify_result) {
+  return !(verify_result.cert_status & CERT_STATUS_COMMON_NAME_INVALID) &&
+      error == GetErrorForCertStatus(verify_result.cert_status);
+}
+
 }  // namespace
 
 MultiThreadedCertVerifier::CachedResult::CachedResult() : error(ERR_FAILED) {}
@@ -391,8 +412,10 @@ class CertVerifierJob {
 MultiThreadedCertVerifier::MultiThreadedCertVerifier(
     CertVerifyProc* verify_proc)
     : cache_(kMaxCacheEntries),
+      chain_cache_(kMaxCacheEntries),
       requests_(0),
       cache_hits_(0),
+      chain_cache_hits_(0),
       inflight_joins_(0),
       verify_proc_(verify_proc),
       trust_anchor_provider_(NULL) {
@@ -443,6 +466,15 @@ int MultiThreadedCertVerifier::Verify(X509Certificate* cert,
     return cached_entry->error;
   }
 
+  CachedResult chain_result;
+  if (GetChainCacheResult(cert, hostname, flags, additional_trust_anchors,
+                          &chain_result)) {
+    ++chain_cache_hits_;
+    *out_req = NULL;
+    *verify_result = chain_result.result;
+    return chain_result.error;
+  }
+
   // No cache hit. See if an identical request is currently in flight.
   CertVerifierJob* job;
   std::map<RequestParams, CertVerifierJob*>::const_iterator j;
@@ -542,6 +574,16 @@ void MultiThreadedCertVerifier::HandleResult(
   cache_.Put(
       key, cached_result, CacheValidityPeriod(now),
       CacheValidityPeriod(now, now + base::TimeDelta::FromSeconds(kTTLSecs)));
+  if (verify_proc_->ChecksHostnameIndependently() &&
+      CanRetargetResult(error, verify_result)) {
+    const RequestParams chain_key(cert->fingerprint(), cert->ca_fingerprint(),
+                                  std::string(), flags,
+                                  additional_trust_anchors);
+    chain_cache_.Put(
+        chain_key, cached_result, CacheValidityPeriod(now),
+        CacheValidityPeriod(now,
+                            now + base::TimeDelta::FromSeconds(kTTLSecs)));
+  }
 
   std::map<RequestParams, CertVerifierJob*>::iterator j;
   j = inflight_.find(key);
@@ -556,6 +598,39 @@ void MultiThreadedCertVerifier::HandleResult(
   delete job;
 }
 
+bool MultiThreadedCertVerifier::GetChainCacheResult(
+    X509Certificate* cert,
+    const std::string& hostname,
+    int flags,
+    const CertificateList& additional_trust_anchors,
+    CachedResult* result) {
+  if (!verify_proc_->ChecksHostnameIndependently())
+    return false;
+
+  const RequestParams chain_key(cert->fingerprint(), cert->ca_fingerprint(),
+                                std::string(), flags,
+                                additional_trust_anchors);
+  const CertVerifierCache::value_type* cached_entry =
+      chain_cache_.Get(chain_key, CacheValidityPeriod(base::Time::Now()));
+  if (!cached_entry)
+    return false;
+
+  // Redo the hostname-dependent parts of CertVerifyProc::Verify().
+  result->result = cached_entry->result;
+  CertStatus cert_status =
+      result->result.cert_status & ~CERT_STATUS_NON_UNIQUE_NAME;
+  if (!cert->VerifyNameMatch(hostname,
+                             &result->result.common_name_fallback_used)) {
+    cert_status |= CERT_STATUS_COMMON_NAME_INVALID;
+    cert_status &= ~CERT_STATUS_IS_EV;
+  }
+  if (result->result.is_issued_by_known_root && IsHostnameNonUnique(hostname))
+    cert_status |= CERT_STATUS_NON_UNIQUE_NAME;
+  result->result.cert_status = cert_status;
+  result->error = GetErrorForCertStatus(cert_status);
+  return true;
+}
+
 void MultiThreadedCertVerifier::OnCACertChanged(
     const X509Certificate* cert) {
   DCHECK(CalledOnValidThread());
@@ -78,6 +78,8 @@ class NET_EXPORT_PRIVATE MultiThreadedCertVerifier
                            RequestParamsComparators);
   FRIEND_TEST_ALL_PREFIXES(MultiThreadedCertVerifierTest,
                            CertTrustAnchorProvider);
+  FRIEND_TEST_ALL_PREFIXES(MultiThreadedCertVerifierTest,
+                           ChainCacheSharedAcrossHostnames);
 
   // Input parameters of a certificate verification request.
   struct NET_EXPORT_PRIVATE RequestParams {
@@ -136,25 +138,45 @@ class NET_EXPORT_PRIVATE MultiThreadedCertVerifier
                     int error,
                     const CertVerifyResult& verify_result);
 
+  // If |verify_proc_| checks the hostname independently of the chain, looks
+  // for a result for |cert| that was verified for another hostname and, if
+  // one is found, re-targets it to |hostname| in |result| and returns true.
+  bool GetChainCacheResult(X509Certificate* cert,
+                           const std::string& hostname,
+                           int flags,
+                           const CertificateList& additional_trust_anchors,
+                           CachedResult* result);
+
   // CertDatabase::Observer methods:
   virtual void OnCACertChanged(const X509Certificate* cert) OVERRIDE;
 
   // For unit testing.
-  void ClearCache() { cache_.Clear(); }
+  void ClearCache() {
+    cache_.Clear();
+    chain_cache_.Clear();
+  }
   size_t GetCacheSize() const { return cache_.size(); }
   uint64 cache_hits() const { return cache_hits_; }
+  uint64 chain_cache_hits() const { return chain_cache_hits_; }
   uint64 requests() const { return requests_; }
   uint64 inflight_joins() const { return inflight_joins_; }
 
   // cache_ maps from a request to a cached result.
   CertVerifierCache cache_;
 
+  // chain_cache_ maps from a request without its hostname to the result of
+  // verifying the chain for a hostname that it matched. Certificates that
+  // chain to the same intermediates for many hostnames (or that have many
+  // names) then only need to be verified once per chain.
+  CertVerifierCache chain_cache_;
+
   // inflight_ maps from a request to an active verification which is taking
   // place.
   std::map<RequestParams, CertVerifierJob*> inflight_;
 
   uint64 requests_;
   uint64 cache_hits_;
+  uint64 chain_cache_hits_;
   uint64 inflight_joins_;
 
   scoped_refptr<CertVerifyProc> verify_proc_;
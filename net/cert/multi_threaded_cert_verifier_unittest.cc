@@ -56,6 +56,41 @@ class MockCertVerifyProc : public CertVerifyProc {
   }
 };
 
+// Verifies the name the way the platform CertVerifyProcs do, and accepts any
+// chain.
+class NameMatchingCertVerifyProc : public CertVerifyProc {
+ public:
+  NameMatchingCertVerifyProc() {}
+
+ private:
+  virtual ~NameMatchingCertVerifyProc() {}
+
+  // CertVerifyProc implementation
+  virtual bool SupportsAdditionalTrustAnchors() const OVERRIDE {
+    return false;
+  }
+
+  virtual bool ChecksHostnameIndependently() const OVERRIDE {
+    return true;
+  }
+
+  virtual int VerifyInternal(X509Certificate* cert,
+                             const std::string& hostname,
+                             int flags,
+                             CRLSet* crl_set,
+                             const CertificateList& additional_trust_anchors,
+                             CertVerifyResult* verify_result) OVERRIDE {
+    verify_result->Reset();
+    verify_result->verified_cert = cert;
+    if (!cert->VerifyNameMatch(hostname,
+                               &verify_result->common_name_fallback_used)) {
+      verify_result->cert_status = CERT_STATUS_COMMON_NAME_INVALID;
+      return ERR_CERT_COMMON_NAME_INVALID;
+    }
+    return OK;
+  }
+};
+
 class MockCertTrustAnchorProvider : public CertTrustAnchorProvider {
  public:
   MockCertTrustAnchorProvider() {}
@@ -482,4 +517,71 @@ TEST_F(MultiThreadedCertVerifierTest, CertTrustAnchorProvider) {
   ASSERT_EQ(1u, verifier_.cache_hits());
 }
 
+// Tests that a chain verified for one hostname isn't verified again for
+// another hostname, and that the name is still checked.
+TEST_F(MultiThreadedCertVerifierTest, ChainCacheSharedAcrossHostnames) {
+  MultiThreadedCertVerifier verifier(new NameMatchingCertVerifyProc());
+  base::FilePath certs_dir = GetTestCertsDirectory();
+  scoped_refptr<X509Certificate> test_cert(
+      ImportCertFromFile(certs_dir, "ok_cert.pem"));
+  ASSERT_NE(static_cast<X509Certificate*>(NULL), test_cert);
+
+  int error;
+  CertVerifyResult verify_result;
+  TestCompletionCallback callback;
+  CertVerifier::RequestHandle request_handle;
+
+  // ok_cert.pem is issued to 127.0.0.1.
+  error = verifier.Verify(test_cert.get(),
+                          "127.0.0.1",
+                          0,
+                          NULL,
+                          &verify_result,
+                          callback.callback(),
+                          &request_handle,
+                          BoundNetLog());
+  ASSERT_EQ(ERR_IO_PENDING, error);
+  EXPECT_EQ(OK, callback.WaitForResult());
+  EXPECT_EQ(0u, verifier.chain_cache_hits());
+
+  // Another hostname completes synchronously, with the name error.
+  error = verifier.Verify(test_cert.get(),
+                          "www.example.com",
+                          0,
+                          NULL,
+                          &verify_result,
+                          callback.callback(),
+                          &request_handle,
+                          BoundNetLog());
+  EXPECT_EQ(ERR_CERT_COMMON_NAME_INVALID, error);
+  EXPECT_TRUE(request_handle == NULL);
+  EXPECT_EQ(CERT_STATUS_COMMON_NAME_INVALID, verify_result.cert_status);
+  EXPECT_EQ(1u, verifier.chain_cache_hits());
+  EXPECT_EQ(0u, verifier.cache_hits());
+
+  // Results for mismatched names aren't shared: with different flags, the
+  // chain is verified for each name.
+  error = verifier.Verify(test_cert.get(),
+                          "www.example.com",
+                          CertVerifier::VERIFY_EV_CERT,
+                          NULL,
+                          &verify_result,
+                          callback.callback(),
+                          &request_handle,
+                          BoundNetLog());
+  ASSERT_EQ(ERR_IO_PENDING, error);
+  EXPECT_EQ(ERR_CERT_COMMON_NAME_INVALID, callback.WaitForResult());
+  error = verifier.Verify(test_cert.get(),
+                          "127.0.0.1",
+                          CertVerifier::VERIFY_EV_CERT,
+                          NULL,
+                          &verify_result,
+                          callback.callback(),
+                          &request_handle,
+                          BoundNetLog());
+  ASSERT_EQ(ERR_IO_PENDING, error);
+  EXPECT_EQ(OK, callback.WaitForResult());
+  EXPECT_EQ(1u, verifier.chain_cache_hits());
+}
+
 }  // namespace net
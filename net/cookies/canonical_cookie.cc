@@ -312,7 +312,7 @@ bool CanonicalCookie::IsOnPath(const std::string& url_path) const {
   // Make sure the cookie path is a prefix of the url path.  If the
   // url path is shorter than the cookie path, then the cookie path
   // can't be a prefix.
-  if (url_path.find(path_) != 0)
+  if (url_path.compare(0, path_.length(), path_) != 0)
     return false;
 
   // Now we know that url_path is >= cookie_path, and that cookie_path
@@ -367,19 +367,27 @@ bool CanonicalCookie::IsDomainMatch(const std::string& host) const {
 
 bool CanonicalCookie::IncludeForRequestURL(const GURL& url,
                                            const CookieOptions& options) const {
+  return IncludeForRequest(url.host(), url.path(), url.SchemeIsSecure(),
+                           options);
+}
+
+bool CanonicalCookie::IncludeForRequest(const std::string& url_host,
+                                        const std::string& url_path,
+                                        bool url_is_secure,
+                                        const CookieOptions& options) const {
   // Filter out HttpOnly cookies, per options.
   if (options.exclude_httponly() && IsHttpOnly())
     return false;
   // Secure cookies should not be included in requests for URLs with an
   // insecure scheme.
-  if (IsSecure() && !url.SchemeIsSecure())
+  if (IsSecure() && !url_is_secure)
     return false;
   // Don't include cookies for requests that don't apply to the cookie domain.
-  if (!IsDomainMatch(url.host()))
+  if (!IsDomainMatch(url_host))
     return false;
   // Don't include cookies for requests with a url path that does not path
   // match the cookie-path.
-  if (!IsOnPath(url.path()))
+  if (!IsOnPath(url_path))
     return false;
 
   return true;
@@ -123,6 +123,15 @@ class NET_EXPORT CanonicalCookie {
   bool IncludeForRequestURL(const GURL& url,
                             const CookieOptions& options) const;
 
+  // Same as IncludeForRequestURL(), for a request to |url_host| and
+  // |url_path| with a secure scheme if |url_is_secure|. This spares the
+  // callers that match many cookies against a URL getting its host and path
+  // for each of them.
+  bool IncludeForRequest(const std::string& url_host,
+                         const std::string& url_path,
+                         bool url_is_secure,
+                         const CookieOptions& options) const;
+
   std::string DebugString() const;
 
   // Returns the cookie source when cookies are set for |url|. This function
@@ -315,6 +315,10 @@ TEST(CanonicalCookieTest, IsOnPath) {
   EXPECT_TRUE(cookie->IsOnPath("/test"));
   EXPECT_TRUE(cookie->IsOnPath("/test/bar.html"));
   EXPECT_TRUE(cookie->IsOnPath("/test/sample/bar.html"));
+  // The cookie path must be a prefix of the URL path.
+  EXPECT_FALSE(cookie->IsOnPath("/foo/test"));
+  EXPECT_FALSE(cookie->IsOnPath("/testing"));
+  EXPECT_FALSE(cookie->IsOnPath("/tes"));
 }
 
 TEST(CanonicalCookieTest, IncludeForRequestURL) {
@@ -1699,6 +1699,12 @@ void CookieMonster::FindCookiesForKey(const std::string& key,
                                       std::vector<CanonicalCookie*>* cookies) {
   lock_.AssertAcquired();
 
+  // GURL returns copies of its components, so get them once for all of the
+  // cookies.
+  const std::string url_host(url.host());
+  const std::string url_path(url.path());
+  const bool url_is_secure = url.SchemeIsSecure();
+
   for (CookieMapItPair its = cookies_.equal_range(key);
        its.first != its.second; ) {
     CookieMap::iterator curit = its.first;
@@ -1714,7 +1720,7 @@ void CookieMonster::FindCookiesForKey(const std::string& key,
     // Filter out cookies that should not be included for a request to the
     // given |url|. HTTP only cookies are filtered depending on the passed
     // cookie |options|.
-    if (!cc->IncludeForRequestURL(url, options))
+    if (!cc->IncludeForRequest(url_host, url_path, url_is_secure, options))
       continue;
 
     // Add this cookie to the set of matching cookies. Update the access
@@ -19,6 +19,7 @@
 #include "net/disk_cache/disk_cache_test_util.h"
 #include "net/disk_cache/entry_impl.h"
 #include "net/disk_cache/mem_entry_impl.h"
+#include "net/disk_cache/simple/simple_backend_impl.h"
 #include "net/disk_cache/simple/simple_entry_format.h"
 #include "net/disk_cache/simple/simple_entry_impl.h"
 #include "net/disk_cache/simple/simple_synchronous_entry.h"
@@ -2523,6 +2524,41 @@ bool DiskCacheEntryTest::SimpleCacheMakeBadChecksumEntry(const std::string& key,
   return true;
 }
 
+// Checks that an entry held open by the backend is reopened without using its
+// files, and that it stops being held once doomed.
+TEST_F(DiskCacheEntryTest, SimpleCacheHotEntry) {
+  SetSimpleCacheMode();
+  InitCache();
+  simple_cache_impl_->SetMaxHotEntries(1);
+
+  const char key[] = "the first key";
+  const char data[] = "this is hot data";
+  const int kDataSize = arraysize(data);
+  scoped_refptr<net::IOBuffer> buffer(new net::IOBuffer(kDataSize));
+  base::strlcpy(buffer->data(), data, kDataSize);
+
+  disk_cache::Entry* entry = NULL;
+  ASSERT_EQ(net::OK, CreateEntry(key, &entry));
+  EXPECT_EQ(kDataSize, WriteData(entry, 1, 0, buffer.get(), kDataSize, false));
+  entry->Close();
+
+  // The entry isn't closed when it was only read.
+  ASSERT_EQ(net::OK, OpenEntry(key, &entry));
+  entry->Close();
+  EXPECT_TRUE(base::DeleteFile(cache_path_.AppendASCII(
+      disk_cache::simple_util::GetFilenameFromKeyAndFileIndex(key, 0)), false));
+
+  ASSERT_EQ(net::OK, OpenEntry(key, &entry));
+  scoped_refptr<net::IOBuffer> read_buffer(new net::IOBuffer(kDataSize));
+  EXPECT_EQ(kDataSize,
+            ReadData(entry, 1, 0, read_buffer.get(), kDataSize));
+  EXPECT_EQ(0, memcmp(data, read_buffer->data(), kDataSize));
+  entry->Close();
+
+  EXPECT_EQ(net::OK, DoomEntry(key));
+  EXPECT_NE(net::OK, OpenEntry(key, &entry));
+}
+
 // Tests that the simple cache can detect entries that have bad data.
 TEST_F(DiskCacheEntryTest, SimpleCacheBadChecksum) {
   SetSimpleCacheMode();
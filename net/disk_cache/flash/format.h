@@ -17,9 +17,11 @@ const int32 kFlashSmallEntrySize = 4 * 1024;
 const size_t kFlashMaxEntryCount = kFlashSegmentSize / kFlashSmallEntrySize - 1;
 
 // Segment summary consists of a fixed region at the end of the segment
-// containing a counter specifying the number of saved offsets followed by the
-// offsets.
-const int32 kFlashSummarySize = (1 + kFlashMaxEntryCount) * sizeof(int32);
+// containing the sequence number of the segment (zero if it holds no entries),
+// a counter specifying the number of saved offsets followed by the offsets.
+const int32 kFlashSummaryHeaderSize = 2;
+const int32 kFlashSummarySize =
+    (kFlashSummaryHeaderSize + kFlashMaxEntryCount) * sizeof(int32);
 const int32 kFlashSegmentFreeSpace = kFlashSegmentSize - kFlashSummarySize;
 
 // An entry consists of a fixed number of streams.
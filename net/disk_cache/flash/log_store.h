@@ -28,7 +28,9 @@ class NET_EXPORT_PRIVATE LogStore {
   ~LogStore();
 
   // Performs initialization.  Must be the first function called and further
-  // calls should be made only if it is successful.
+  // calls should be made only if it is successful.  The entries of a store
+  // that was closed can be opened again, and writing resumes after the most
+  // recently written segment, which overwrites the oldest one.
   bool Init();
 
   // Closes the store.  Should be the last function called before destruction.
@@ -62,10 +64,14 @@ class NET_EXPORT_PRIVATE LogStore {
   FRIEND_TEST_ALL_PREFIXES(FlashCacheTest, LogStoreSegmentSelectionIsFifo);
   FRIEND_TEST_ALL_PREFIXES(FlashCacheTest, LogStoreInUseSegmentIsSkipped);
   FRIEND_TEST_ALL_PREFIXES(FlashCacheTest, LogStoreReadFromCurrentAfterClose);
+  FRIEND_TEST_ALL_PREFIXES(FlashCacheTest, LogStoreResumesAfterReopen);
 
   int32 GetNextSegmentIndex();
   bool InUse(int32 segment_index) const;
 
+  // Creates and initializes the segment at |write_index_| for writing.
+  bool OpenWriteSegment();
+
   Storage storage_;
 
   int32 num_segments_;
@@ -78,6 +84,9 @@ class NET_EXPORT_PRIVATE LogStore {
   // |open_segments_| vector.
   int32 write_index_;
 
+  // The sequence number to give to the next segment written to.
+  int32 next_sequence_number_;
+
   // Ids of entries currently open, either CreatEntry'ed or OpenEntry'ed.
   std::set<int32> open_entries_;
 
@@ -125,6 +125,52 @@ TEST_F(FlashCacheTest, LogStoreReadFromCurrentAfterClose) {
   EXPECT_TRUE(log_store.Close());
 }
 
+TEST_F(FlashCacheTest, LogStoreResumesAfterReopen) {
+  const int32 kSize = disk_cache::kFlashSegmentFreeSpace;
+  const std::vector<char> expected(kSize, 'c');
+
+  // The first entry goes to segment 0, and the second one to segment 1.
+  int32 id1;
+  int32 id2;
+  {
+    LogStore log_store(path_, kStorageSize);
+    EXPECT_TRUE(log_store.Init());
+    EXPECT_TRUE(log_store.CreateEntry(kSize, &id1));
+    EXPECT_TRUE(log_store.WriteData(&expected[0], kSize));
+    log_store.CloseEntry(id1);
+    EXPECT_TRUE(log_store.CreateEntry(kSize, &id2));
+    EXPECT_EQ(1, log_store.write_index_);
+    EXPECT_TRUE(log_store.WriteData(&expected[0], kSize));
+    log_store.CloseEntry(id2);
+    EXPECT_TRUE(log_store.Close());
+  }
+
+  // Both entries can be read after reopening the store, which writes to the
+  // next segment.
+  LogStore log_store(path_, kStorageSize);
+  EXPECT_TRUE(log_store.Init());
+  EXPECT_EQ(2, log_store.write_index_);
+
+  std::vector<char> actual(kSize, 0);
+  EXPECT_TRUE(log_store.OpenEntry(id1));
+  EXPECT_TRUE(log_store.ReadData(id1, &actual[0], kSize, 0));
+  log_store.CloseEntry(id1);
+  EXPECT_EQ(expected, actual);
+
+  actual.assign(kSize, 0);
+  EXPECT_TRUE(log_store.OpenEntry(id2));
+  EXPECT_TRUE(log_store.ReadData(id2, &actual[0], kSize, 0));
+  log_store.CloseEntry(id2);
+  EXPECT_EQ(expected, actual);
+
+  int32 id3;
+  EXPECT_TRUE(log_store.CreateEntry(kSize, &id3));
+  EXPECT_EQ(2 * disk_cache::kFlashSegmentSize, id3);
+  EXPECT_TRUE(log_store.WriteData(&expected[0], kSize));
+  log_store.CloseEntry(id3);
+  EXPECT_TRUE(log_store.Close());
+}
+
 // TODO(agayev): Add a test that confirms that in-use segment is not selected as
 // the next write segment.
 
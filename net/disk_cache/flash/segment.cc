@@ -19,7 +19,8 @@ Segment::Segment(int32 index, bool read_only, Storage* storage)
       storage_(storage),
       offset_(index * kFlashSegmentSize),
       summary_offset_(offset_ + kFlashSegmentSize - kFlashSummarySize),
-      write_offset_(offset_) {
+      write_offset_(offset_),
+      sequence_number_(0) {
   DCHECK(storage);
   DCHECK(storage->size() % kFlashSegmentSize == 0);
 }
@@ -35,6 +36,12 @@ bool Segment::HaveOffset(int32 offset) const {
   return std::binary_search(offsets_.begin(), offsets_.end(), offset);
 }
 
+void Segment::set_sequence_number(int32 sequence_number) {
+  DCHECK(init_ && !read_only_);
+  DCHECK_GT(sequence_number, 0);
+  sequence_number_ = sequence_number;
+}
+
 void Segment::AddUser() {
   DCHECK(init_);
   ++num_users_;
@@ -56,20 +63,35 @@ bool Segment::Init() {
   if (offset_ < 0 || offset_ + kFlashSegmentSize > storage_->size())
     return false;
 
+  int32 summary[kFlashSummaryHeaderSize + kFlashMaxEntryCount];
   if (!read_only_) {
+    // The entries previously on this segment are about to be overwritten.
+    memset(summary, 0, kFlashSummarySize);
+    if (!storage_->Write(summary, kFlashSummarySize, summary_offset_))
+      return false;
     init_ = true;
     return true;
   }
 
-  int32 summary[kFlashMaxEntryCount + 1];
   if (!storage_->Read(summary, kFlashSummarySize, summary_offset_))
     return false;
 
-  size_t entry_count = summary[0];
-  DCHECK_LE(entry_count, kFlashMaxEntryCount);
+  // The summary is read back from disk, so it's validated.
+  const int32 sequence_number = summary[0];
+  const uint32 entry_count = summary[1];
+  if (sequence_number < 0 || entry_count > kFlashMaxEntryCount)
+    return false;
+  const int32* offsets = summary + kFlashSummaryHeaderSize;
+  for (uint32 i = 0; i < entry_count; ++i) {
+    if (offsets[i] < offset_ || offsets[i] >= summary_offset_ ||
+        (i > 0 && offsets[i] <= offsets[i - 1])) {
+      return false;
+    }
+  }
 
-  std::vector<int32> tmp(summary + 1, summary + 1 + entry_count);
+  std::vector<int32> tmp(offsets, offsets + entry_count);
   offsets_.swap(tmp);
+  sequence_number_ = sequence_number;
   init_ = true;
   return true;
 }
@@ -102,10 +124,12 @@ bool Segment::Close() {
 
   DCHECK(offsets_.size() <= kFlashMaxEntryCount);
 
-  int32 summary[kFlashMaxEntryCount + 1];
+  int32 summary[kFlashSummaryHeaderSize + kFlashMaxEntryCount];
   memset(summary, 0, kFlashSummarySize);
-  summary[0] = offsets_.size();
-  std::copy(offsets_.begin(), offsets_.end(), summary + 1);
+  summary[0] = sequence_number_;
+  summary[1] = offsets_.size();
+  std::copy(offsets_.begin(), offsets_.end(),
+            summary + kFlashSummaryHeaderSize);
   if (!storage_->Write(summary, kFlashSummarySize, summary_offset_))
     return false;
 
@@ -53,6 +53,13 @@ class Storage;
 // were stored in the Segment.  Before attempting to write an entry, the client
 // should call CanHold() to make sure that there is enough space in the segment.
 //
+// The metadata also holds the sequence number of the segment, which the client
+// increments for each segment it writes, so that the most recently written
+// segment can be found after a restart.  Initializing a segment for writing
+// erases its metadata first, so if the writing is interrupted before Close(),
+// the entries that were previously on the segment are not recovered in the
+// half-overwritten segment.
+//
 // ReadData can be called over the range that was previously written with
 // WriteData.  Reading from area that was not written will fail.
 
@@ -69,6 +76,11 @@ class NET_EXPORT_PRIVATE Segment {
   int32 index() const { return index_; }
   int32 write_offset() const { return write_offset_; }
 
+  // Zero if the segment holds no entries.  Must be set before a segment that
+  // is being written to is closed.
+  int32 sequence_number() const { return sequence_number_; }
+  void set_sequence_number(int32 sequence_number);
+
   bool HaveOffset(int32 offset) const;
   std::vector<int32> GetOffsets() const { return offsets_; }
 
@@ -78,7 +90,8 @@ class NET_EXPORT_PRIVATE Segment {
   bool HasNoUsers() const;
 
   // Performs segment initialization.  Must be the first function called on the
-  // segment and further calls should be made only if it is successful.
+  // segment and further calls should be made only if it is successful.  Fails
+  // for a read-only segment if its metadata is invalid.
   bool Init();
 
   // Writes |size| bytes of data from |buffer| to segment, returns false if
@@ -108,6 +121,7 @@ class NET_EXPORT_PRIVATE Segment {
   const int32 offset_;  // Offset of the segment on |storage_|.
   const int32 summary_offset_;  // Offset of the segment summary.
   int32 write_offset_;  // Current write offset.
+  int32 sequence_number_;
   std::vector<int32> offsets_;
 
   DISALLOW_COPY_AND_ASSIGN(Segment);
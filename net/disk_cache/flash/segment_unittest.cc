@@ -150,3 +150,37 @@ TEST_F(FlashCacheTest, SegmentFillWithLargeEntries) {
   EXPECT_LT(segment->GetOffsets().size(), disk_cache::kFlashMaxEntryCount);
   EXPECT_TRUE(segment->Close());
 }
+
+TEST_F(FlashCacheTest, SegmentRewriteErasesSummary) {
+  disk_cache::Storage storage(path_, kStorageSize);
+  ASSERT_TRUE(storage.Init());
+
+  int32 index = rand() % kNumTestSegments;
+  scoped_ptr<disk_cache::Segment> segment(
+      new disk_cache::Segment(index, false, &storage));
+  EXPECT_TRUE(segment->Init());
+  SmallEntry entry;
+  int32 offset = segment->write_offset();
+  EXPECT_TRUE(segment->WriteData(entry.data, entry.size));
+  segment->StoreOffset(offset);
+  segment->set_sequence_number(7);
+  EXPECT_TRUE(segment->Close());
+
+  segment.reset(new disk_cache::Segment(index, true, &storage));
+  EXPECT_TRUE(segment->Init());
+  EXPECT_EQ(7, segment->sequence_number());
+  EXPECT_TRUE(segment->HaveOffset(offset));
+  EXPECT_TRUE(segment->Close());
+
+  // Starting to write the segment again loses the previous entries, even
+  // before the segment is closed.
+  segment.reset(new disk_cache::Segment(index, false, &storage));
+  EXPECT_TRUE(segment->Init());
+  scoped_ptr<disk_cache::Segment> read_segment(
+      new disk_cache::Segment(index, true, &storage));
+  EXPECT_TRUE(read_segment->Init());
+  EXPECT_EQ(0, read_segment->sequence_number());
+  EXPECT_FALSE(read_segment->HaveOffset(offset));
+  EXPECT_TRUE(read_segment->Close());
+  EXPECT_TRUE(segment->Close());
+}
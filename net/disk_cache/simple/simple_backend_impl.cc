@@ -29,6 +29,7 @@
 #include "net/disk_cache/cache_util.h"
 #include "net/disk_cache/simple/simple_entry_format.h"
 #include "net/disk_cache/simple/simple_entry_impl.h"
+#include "net/disk_cache/simple/simple_frequency_sketch.h"
 #include "net/disk_cache/simple/simple_histogram_macros.h"
 #include "net/disk_cache/simple/simple_index.h"
 #include "net/disk_cache/simple/simple_index_file.h"
@@ -59,6 +60,9 @@ const char kThreadNamePrefix[] = "SimpleCache";
 // Maximum fraction of the cache that one entry can consume.
 const int kMaxFileRatio = 8;
 
+// Number of frequency sketch counters per hot entry held.
+const size_t kFrequencySketchWidthRatio = 16;
+
 // A global sequenced worker pool to use for launching all tasks.
 SequencedWorkerPool* g_sequenced_worker_pool = NULL;
 
@@ -79,6 +83,16 @@ void MaybeCreateSequencedWorkerPool() {
   }
 }
 
+// Entries are only held open by the backend when a field trial asks for it,
+// as each of them keeps its files open.
+size_t GetMaxHotEntriesFromFieldTrial() {
+  const std::string hot_entries_field_trial =
+      base::FieldTrialList::FindFullName("SimpleCacheHotEntries");
+  if (hot_entries_field_trial.empty())
+    return 0;
+  return std::max(0, std::atoi(hot_entries_field_trial.c_str()));
+}
+
 bool g_fd_limit_histogram_has_been_populated = false;
 
 void MaybeHistogramFdLimit(net::CacheType cache_type) {
@@ -210,11 +224,14 @@ SimpleBackendImpl::SimpleBackendImpl(const FilePath& path,
           cache_type == net::DISK_CACHE ?
               SimpleEntryImpl::OPTIMISTIC_OPERATIONS :
               SimpleEntryImpl::NON_OPTIMISTIC_OPERATIONS),
-      net_log_(net_log) {
+      net_log_(net_log),
+      max_hot_entries_(0) {
   MaybeHistogramFdLimit(cache_type_);
+  SetMaxHotEntries(GetMaxHotEntriesFromFieldTrial());
 }
 
 SimpleBackendImpl::~SimpleBackendImpl() {
+  SetMaxHotEntries(0);
   index_->WriteToDisk();
 }
 
@@ -254,6 +271,53 @@ void SimpleBackendImpl::OnDeactivated(const SimpleEntryImpl* entry) {
   active_entries_.erase(entry->entry_hash());
 }
 
+bool SimpleBackendImpl::HoldHotEntry(SimpleEntryImpl* entry) {
+  const uint64 entry_hash = entry->entry_hash();
+  DCHECK_EQ(0U, hot_entry_positions_.count(entry_hash));
+  if (!max_hot_entries_)
+    return false;
+
+  // Only the active entry for its hash can be reopened, not e.g. a duplicate
+  // created from the hash alone during an iteration.
+  EntryMap::const_iterator active_it = active_entries_.find(entry_hash);
+  if (active_it == active_entries_.end() || active_it->second.get() != entry)
+    return false;
+
+  if (hot_entries_.size() >= max_hot_entries_) {
+    SimpleEntryImpl* const victim = hot_entries_.back();
+    if (frequency_sketch_->Estimate(entry_hash) <=
+        frequency_sketch_->Estimate(victim->entry_hash())) {
+      return false;
+    }
+    ReleaseHotEntry(victim);
+  }
+  hot_entries_.push_front(entry);
+  hot_entry_positions_[entry_hash] = hot_entries_.begin();
+  return true;
+}
+
+void SimpleBackendImpl::ReleaseHotEntry(SimpleEntryImpl* entry) {
+  base::hash_map<uint64, HotEntryList::iterator>::iterator it =
+      hot_entry_positions_.find(entry->entry_hash());
+  if (it == hot_entry_positions_.end() || *it->second != entry)
+    return;
+  hot_entries_.erase(it->second);
+  hot_entry_positions_.erase(it);
+  entry->CloseHeldEntry();
+}
+
+void SimpleBackendImpl::SetMaxHotEntries(size_t max_hot_entries) {
+  max_hot_entries_ = max_hot_entries;
+  while (hot_entries_.size() > max_hot_entries_)
+    ReleaseHotEntry(hot_entries_.back());
+  if (!max_hot_entries_) {
+    frequency_sketch_.reset();
+    return;
+  }
+  frequency_sketch_.reset(new SimpleFrequencySketch(
+      kFrequencySketchWidthRatio * max_hot_entries_));
+}
+
 void SimpleBackendImpl::OnDoomStart(uint64 entry_hash) {
   // TODO(ttuttle): Revert to DCHECK once http://crbug.com/317138 is fixed.
   CHECK_EQ(0u, entries_pending_doom_.count(entry_hash));
@@ -363,6 +427,7 @@ int SimpleBackendImpl::OpenEntry(const std::string& key,
                                     operation, callback));
     return net::ERR_IO_PENDING;
   }
+  RecordEntryUse(entry_hash);
   scoped_refptr<SimpleEntryImpl> simple_entry =
       CreateOrFindActiveEntry(entry_hash, key);
   CompletionCallback backend_callback =
@@ -471,7 +536,9 @@ void SimpleBackendImpl::GetStats(
 }
 
 void SimpleBackendImpl::OnExternalCacheHit(const std::string& key) {
-  index_->UseIfExists(simple_util::GetEntryHashKey(key));
+  const uint64 entry_hash = simple_util::GetEntryHashKey(key);
+  RecordEntryUse(entry_hash);
+  index_->UseIfExists(entry_hash);
 }
 
 void SimpleBackendImpl::InitializeIndex(const CompletionCallback& callback,
@@ -506,6 +573,16 @@ SimpleBackendImpl::DiskStatResult SimpleBackendImpl::InitCacheStructureOnDisk(
   return result;
 }
 
+void SimpleBackendImpl::RecordEntryUse(uint64 entry_hash) {
+  if (!frequency_sketch_)
+    return;
+  frequency_sketch_->Increment(entry_hash);
+  base::hash_map<uint64, HotEntryList::iterator>::const_iterator it =
+      hot_entry_positions_.find(entry_hash);
+  if (it != hot_entry_positions_.end())
+    hot_entries_.splice(hot_entries_.begin(), hot_entries_, it->second);
+}
+
 scoped_refptr<SimpleEntryImpl> SimpleBackendImpl::CreateOrFindActiveEntry(
     const uint64 entry_hash,
     const std::string& key) {
@@ -5,6 +5,7 @@
 #ifndef NET_DISK_CACHE_SIMPLE_SIMPLE_BACKEND_IMPL_H_
 #define NET_DISK_CACHE_SIMPLE_SIMPLE_BACKEND_IMPL_H_
 
+#include <list>
 #include <string>
 #include <utility>
 #include <vector>
@@ -38,6 +39,7 @@ namespace disk_cache {
 // otherwise stated.
 
 class SimpleEntryImpl;
+class SimpleFrequencySketch;
 class SimpleIndex;
 
 class NET_EXPORT_PRIVATE SimpleBackendImpl : public Backend,
@@ -71,6 +73,22 @@ class NET_EXPORT_PRIVATE SimpleBackendImpl : public Backend,
   // Flush our SequencedWorkerPool.
   static void FlushWorkerPoolForTesting();
 
+  // Offers the backend to take over the last handle on |entry| as it is being
+  // closed, keeping it open so that reopening it later doesn't touch the
+  // disk. This is done for at most |max_hot_entries_| at a time, and when
+  // those are all held, only for an entry used more often than the least
+  // recently used held entry (which is closed in exchange). Returns true if
+  // the handle was taken over.
+  bool HoldHotEntry(SimpleEntryImpl* entry);
+
+  // Closes the handle on |entry| held by the backend, if any. Called when the
+  // entry gets doomed or written to.
+  void ReleaseHotEntry(SimpleEntryImpl* entry);
+
+  // Sets how many entries HoldHotEntry() may hold; zero disables it. Defaults
+  // to the "SimpleCacheHotEntries" field trial group, if any.
+  void SetMaxHotEntries(size_t max_hot_entries);
+
   // The entry for |entry_hash| is being doomed; the backend will not attempt
   // run new operations for this |entry_hash| until the Doom is completed.
   void OnDoomStart(uint64 entry_hash);
@@ -108,6 +126,7 @@ class NET_EXPORT_PRIVATE SimpleBackendImpl : public Backend,
 
  private:
   typedef base::hash_map<uint64, base::WeakPtr<SimpleEntryImpl> > EntryMap;
+  typedef std::list<SimpleEntryImpl*> HotEntryList;
 
   typedef base::Callback<void(base::Time mtime, uint64 max_size, int result)>
       InitializeIndexCallback;
@@ -135,6 +154,10 @@ class NET_EXPORT_PRIVATE SimpleBackendImpl : public Backend,
   static DiskStatResult InitCacheStructureOnDisk(const base::FilePath& path,
                                                  uint64 suggested_max_size);
 
+  // Counts a use of the entry for |entry_hash| towards its admission in the
+  // hot entries, and marks it most recently used if it is one of them.
+  void RecordEntryUse(uint64 entry_hash);
+
   // Searches |active_entries_| for the entry corresponding to |key|. If found,
   // returns the found entry. Otherwise, creates a new entry and returns that.
   scoped_refptr<SimpleEntryImpl> CreateOrFindActiveEntry(
@@ -211,6 +234,13 @@ class NET_EXPORT_PRIVATE SimpleBackendImpl : public Backend,
   // operations to be run at the completion of the Doom.
   base::hash_map<uint64, std::vector<base::Closure> > entries_pending_doom_;
 
+  // The entries the backend holds open, most recently used first, and where
+  // they are in that list. Only used if |max_hot_entries_| isn't zero.
+  size_t max_hot_entries_;
+  HotEntryList hot_entries_;
+  base::hash_map<uint64, HotEntryList::iterator> hot_entry_positions_;
+  scoped_ptr<SimpleFrequencySketch> frequency_sketch_;
+
   net::NetLog* const net_log_;
 };
 
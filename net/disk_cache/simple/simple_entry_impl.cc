@@ -176,6 +176,7 @@ SimpleEntryImpl::SimpleEntryImpl(net::CacheType cache_type,
       last_modified_(last_used_),
       sparse_data_size_(0),
       open_count_(0),
+      held_by_backend_(false),
       doomed_(false),
       state_(STATE_UNINITIALIZED),
       synchronous_entry_(NULL),
@@ -292,15 +293,38 @@ void SimpleEntryImpl::Doom() {
   DoomEntry(CompletionCallback());
 }
 
+void SimpleEntryImpl::CloseHeldEntry() {
+  DCHECK(held_by_backend_);
+  held_by_backend_ = false;
+  CloseHandle();
+}
+
 void SimpleEntryImpl::Close() {
   DCHECK(io_thread_checker_.CalledOnValidThread());
   DCHECK_LT(0, open_count_);
 
   net_log_.AddEvent(net::NetLog::TYPE_SIMPLE_CACHE_ENTRY_CLOSE_CALL);
 
+  // The last caller's handle can be taken over by the backend, which then
+  // serves later opens of a hot entry without any file IO.
+  if (open_count_ == 1 && !held_by_backend_ && backend_.get() &&
+      CanBeHeldByBackend() && backend_->HoldHotEntry(this)) {
+    held_by_backend_ = true;
+    return;
+  }
+  CloseHandle();
+}
+
+void SimpleEntryImpl::CloseHandle() {
   if (--open_count_ > 0) {
     DCHECK(!HasOneRef());
     Release();  // Balanced in ReturnEntryToCaller().
+    // An entry written to while held is not held any longer, so that what was
+    // written doesn't wait for the backend to let go of it to be completed.
+    if (open_count_ == 1 && held_by_backend_ && HasWrittenStreams() &&
+        backend_.get()) {
+      backend_->ReleaseHotEntry(this);
+    }
     return;
   }
 
@@ -567,6 +591,19 @@ void SimpleEntryImpl::ReturnEntryToCaller(Entry** out_entry) {
   *out_entry = this;
 }
 
+bool SimpleEntryImpl::HasWrittenStreams() const {
+  for (int i = 0; i < kSimpleEntryStreamCount; ++i) {
+    if (have_written_[i])
+      return true;
+  }
+  return false;
+}
+
+bool SimpleEntryImpl::CanBeHeldByBackend() const {
+  return !doomed_ && state_ == STATE_READY && pending_operations_.empty() &&
+         !HasWrittenStreams();
+}
+
 void SimpleEntryImpl::RemoveSelfFromBackend() {
   if (!backend_.get())
     return;
@@ -577,6 +614,8 @@ void SimpleEntryImpl::MarkAsDoomed() {
   doomed_ = true;
   if (!backend_.get())
     return;
+  if (held_by_backend_)
+    backend_->ReleaseHotEntry(this);
   backend_->index()->Remove(entry_hash_);
   RemoveSelfFromBackend();
 }
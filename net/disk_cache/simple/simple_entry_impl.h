@@ -70,6 +70,11 @@ class NET_EXPORT_PRIVATE SimpleEntryImpl : public Entry,
   uint64 entry_hash() const { return entry_hash_; }
   void SetKey(const std::string& key);
 
+  // Closes the handle on this entry which the backend took over from the last
+  // caller to close it, to keep it open as one of its hot entries. See
+  // SimpleBackendImpl::HoldHotEntry().
+  void CloseHeldEntry();
+
   // From Entry:
   virtual void Doom() OVERRIDE;
   virtual void Close() OVERRIDE;
@@ -150,6 +155,19 @@ class NET_EXPORT_PRIVATE SimpleEntryImpl : public Entry,
   // count.
   void ReturnEntryToCaller(Entry** out_entry);
 
+  // Closes one handle on this entry. This is Close(), without offering the
+  // last handle to the backend.
+  void CloseHandle();
+
+  // Whether any stream was written since this entry was opened, so closing
+  // it has to complete the entry files.
+  bool HasWrittenStreams() const;
+
+  // Whether this entry can stay open with no callers: it is open, idle and has
+  // nothing to write on close, so having crashed while holding it loses
+  // nothing.
+  bool CanBeHeldByBackend() const;
+
   // Ensures that |this| is no longer referenced by our |backend_|, this
   // guarantees that this entry cannot have OpenEntry/CreateEntry called again.
   void RemoveSelfFromBackend();
@@ -322,6 +340,10 @@ class NET_EXPORT_PRIVATE SimpleEntryImpl : public Entry,
   // notify the backend when this entry not used by any callers.
   int open_count_;
 
+  // Whether one of the |open_count_| handles is held by the backend rather
+  // than by a caller.
+  bool held_by_backend_;
+
   bool doomed_;
 
   State state_;
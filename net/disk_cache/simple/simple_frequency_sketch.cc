@@ -0,0 +1,76 @@
+// Copyright 2014 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "net/disk_cache/simple/simple_frequency_sketch.h"
+
+#include <algorithm>
+
+#include "base/logging.h"
+
+namespace {
+
+// Odd multipliers giving each row its own mix of the hash bits.
+const uint64 kRowSeeds[] = {
+  GG_UINT64_C(0x9e3779b97f4a7c15),
+  GG_UINT64_C(0xc2b2ae3d27d4eb4f),
+  GG_UINT64_C(0x165667b19e3779f9),
+  GG_UINT64_C(0xd6e8feb86659fd93),
+};
+
+}  // namespace
+
+namespace disk_cache {
+
+// static
+const int SimpleFrequencySketch::kMaxCount;
+const int SimpleFrequencySketch::kSampleFactor;
+const int SimpleFrequencySketch::kRows;
+
+SimpleFrequencySketch::SimpleFrequencySketch(size_t width) {
+  COMPILE_ASSERT(arraysize(kRowSeeds) == kRows, one_seed_per_row);
+  size_t rounded_width = 1;
+  while (rounded_width < width)
+    rounded_width <<= 1;
+  width_mask_ = rounded_width - 1;
+  counters_.resize(kRows * rounded_width, 0);
+  uses_until_aging_ = rounded_width * kSampleFactor;
+}
+
+SimpleFrequencySketch::~SimpleFrequencySketch() {
+}
+
+void SimpleFrequencySketch::Increment(uint64 entry_hash) {
+  // Only the smallest counters are incremented (a conservative update), which
+  // keeps the estimates of rare hashes from being inflated by collisions.
+  const int estimate = Estimate(entry_hash);
+  if (estimate < kMaxCount) {
+    for (int row = 0; row < kRows; ++row) {
+      uint8& counter = counters_[CounterIndex(entry_hash, row)];
+      if (counter == estimate)
+        ++counter;
+    }
+  }
+  if (--uses_until_aging_ == 0)
+    Age();
+}
+
+int SimpleFrequencySketch::Estimate(uint64 entry_hash) const {
+  int estimate = kMaxCount;
+  for (int row = 0; row < kRows; ++row)
+    estimate = std::min<int>(estimate, counters_[CounterIndex(entry_hash, row)]);
+  return estimate;
+}
+
+size_t SimpleFrequencySketch::CounterIndex(uint64 entry_hash, int row) const {
+  const uint64 mixed = entry_hash * kRowSeeds[row];
+  return row * (width_mask_ + 1) + ((mixed >> 32) & width_mask_);
+}
+
+void SimpleFrequencySketch::Age() {
+  for (size_t i = 0; i < counters_.size(); ++i)
+    counters_[i] >>= 1;
+  uses_until_aging_ = (width_mask_ + 1) * kSampleFactor;
+}
+
+}  // namespace disk_cache
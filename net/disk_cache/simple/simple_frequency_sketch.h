@@ -0,0 +1,48 @@
+// Copyright 2014 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef NET_DISK_CACHE_SIMPLE_SIMPLE_FREQUENCY_SKETCH_H_
+#define NET_DISK_CACHE_SIMPLE_SIMPLE_FREQUENCY_SKETCH_H_
+
+#include <vector>
+
+#include "base/basictypes.h"
+#include "net/base/net_export.h"
+
+namespace disk_cache {
+
+// An approximate count of how often each entry hash was used, for TinyLFU
+// style admission decisions: a count-min sketch of small saturating counters.
+// Every counter is halved once |width| * |kSampleFactor| uses have been
+// recorded, so that the estimates follow recent popularity. It never
+// underestimates a count, other than through that aging.
+class NET_EXPORT_PRIVATE SimpleFrequencySketch {
+ public:
+  static const int kMaxCount = 15;
+  static const int kSampleFactor = 10;
+
+  // |width| is the number of counters per row, rounded up to a power of two;
+  // it should be a few times larger than the number of hashes which matter.
+  explicit SimpleFrequencySketch(size_t width);
+  ~SimpleFrequencySketch();
+
+  void Increment(uint64 entry_hash);
+  int Estimate(uint64 entry_hash) const;
+
+ private:
+  static const int kRows = 4;
+
+  size_t CounterIndex(uint64 entry_hash, int row) const;
+  void Age();
+
+  size_t width_mask_;
+  std::vector<uint8> counters_;  // |kRows| rows of |width_mask_| + 1 each.
+  size_t uses_until_aging_;
+
+  DISALLOW_COPY_AND_ASSIGN(SimpleFrequencySketch);
+};
+
+}  // namespace disk_cache
+
+#endif  // NET_DISK_CACHE_SIMPLE_SIMPLE_FREQUENCY_SKETCH_H_
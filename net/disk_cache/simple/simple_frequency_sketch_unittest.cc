@@ -0,0 +1,70 @@
+// Copyright 2014 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "net/disk_cache/simple/simple_frequency_sketch.h"
+
+#include "net/disk_cache/simple/simple_util.h"
+#include "testing/gtest/include/gtest/gtest.h"
+
+namespace disk_cache {
+
+namespace {
+
+uint64 HashOf(int i) {
+  return simple_util::GetEntryHashKey(std::string("key") + char('a' + i % 26) +
+                                      char('a' + i / 26));
+}
+
+}  // namespace
+
+TEST(SimpleFrequencySketchTest, CountsUses) {
+  SimpleFrequencySketch sketch(64);
+  EXPECT_EQ(0, sketch.Estimate(HashOf(0)));
+
+  for (int i = 0; i < 5; ++i)
+    sketch.Increment(HashOf(0));
+  sketch.Increment(HashOf(1));
+  EXPECT_LE(5, sketch.Estimate(HashOf(0)));
+  EXPECT_LE(1, sketch.Estimate(HashOf(1)));
+  EXPECT_GT(sketch.Estimate(HashOf(0)), sketch.Estimate(HashOf(1)));
+
+  // The counters saturate.
+  for (int i = 0; i < 2 * SimpleFrequencySketch::kMaxCount; ++i)
+    sketch.Increment(HashOf(0));
+  EXPECT_EQ(SimpleFrequencySketch::kMaxCount, sketch.Estimate(HashOf(0)));
+}
+
+TEST(SimpleFrequencySketchTest, FewCollisions) {
+  SimpleFrequencySketch sketch(256);
+  for (int i = 0; i < 64; ++i)
+    sketch.Increment(HashOf(i));
+
+  // With a sketch much wider than the number of hashes, nearly all of them are
+  // counted exactly.
+  int exact = 0;
+  for (int i = 0; i < 64; ++i) {
+    EXPECT_LE(1, sketch.Estimate(HashOf(i)));
+    if (sketch.Estimate(HashOf(i)) == 1)
+      ++exact;
+  }
+  EXPECT_LE(60, exact);
+}
+
+TEST(SimpleFrequencySketchTest, Ages) {
+  const size_t kWidth = 16;
+  SimpleFrequencySketch sketch(kWidth);
+  for (int i = 0; i < 8; ++i)
+    sketch.Increment(HashOf(0));
+  EXPECT_LE(8, sketch.Estimate(HashOf(0)));
+
+  // Once enough uses were recorded, the old ones only count half.
+  const int kUsesUntilAging =
+      kWidth * SimpleFrequencySketch::kSampleFactor - 8;
+  for (int i = 0; i < kUsesUntilAging; ++i)
+    sketch.Increment(HashOf(1));
+  EXPECT_GE(sketch.Estimate(HashOf(0)), 4);
+  EXPECT_LT(sketch.Estimate(HashOf(0)), 8);
+}
+
+}  // namespace disk_cache
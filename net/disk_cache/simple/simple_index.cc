@@ -48,28 +48,21 @@ const uint32 kEvictionMarginDivisor = 20;
 
 const uint32 kBytesInKb = 1024;
 
-// Utility class used for timestamp comparisons in entry metadata while sorting.
-class CompareHashesForTimestamp {
-  typedef disk_cache::SimpleIndex SimpleIndex;
-  typedef disk_cache::SimpleIndex::EntrySet EntrySet;
- public:
-  explicit CompareHashesForTimestamp(const EntrySet& set);
-
-  bool operator()(uint64 hash1, uint64 hash2);
- private:
-  const EntrySet& entry_set_;
+// When selecting the entries to evict, the oldest entries are found in batches
+// of at least this many entries, or this fraction of the index.
+const size_t kMinEvictionBatchSize = 64;
+const size_t kEvictionBatchDivisor = 32;
+
+// A copy of what eviction needs to know about an entry, so that selecting the
+// entries doesn't need to look them up in the index.
+struct EvictionCandidate {
+  base::Time last_used_time;
+  uint64 entry_hash;
+  int entry_size;
 };
 
-CompareHashesForTimestamp::CompareHashesForTimestamp(const EntrySet& set)
-  : entry_set_(set) {
-}
-
-bool CompareHashesForTimestamp::operator()(uint64 hash1, uint64 hash2) {
-  EntrySet::const_iterator it1 = entry_set_.find(hash1);
-  DCHECK(it1 != entry_set_.end());
-  EntrySet::const_iterator it2 = entry_set_.find(hash2);
-  DCHECK(it2 != entry_set_.end());
-  return it1->second.GetLastUsedTime() < it2->second.GetLastUsedTime();
+bool IsUsedEarlier(const EvictionCandidate& a, const EvictionCandidate& b) {
+  return a.last_used_time < b.last_used_time;
 }
 
 }  // namespace
@@ -314,29 +307,45 @@ void SimpleIndex::StartEvictionIfNeeded() {
   SIMPLE_CACHE_UMA(MEMORY_KB,
                    "Eviction.MaxCacheSizeOnStart2", cache_type_,
                    max_size_ / kBytesInKb);
-  std::vector<uint64> entry_hashes;
-  entry_hashes.reserve(entries_set_.size());
+  std::vector<EvictionCandidate> candidates;
+  candidates.reserve(entries_set_.size());
   for (EntrySet::const_iterator it = entries_set_.begin(),
        end = entries_set_.end(); it != end; ++it) {
-    entry_hashes.push_back(it->first);
+    EvictionCandidate candidate = {
+      it->second.GetLastUsedTime(), it->first, it->second.GetEntrySize()
+    };
+    candidates.push_back(candidate);
   }
-  std::sort(entry_hashes.begin(), entry_hashes.end(),
-            CompareHashesForTimestamp(entries_set_));
 
-  // Remove as many entries from the index to get below |low_watermark_|.
-  std::vector<uint64>::iterator it = entry_hashes.begin();
+  // Remove as many entries from the index to get below |low_watermark_|. Only
+  // usually a small part of the index needs to go, so rather than sorting all
+  // of it, the oldest entries are partitioned out and sorted a batch at a time.
+  std::vector<uint64> entry_hashes;
+  const size_t batch_size = std::max(kMinEvictionBatchSize,
+                                     candidates.size() / kEvictionBatchDivisor);
+  std::vector<EvictionCandidate>::iterator batch_begin = candidates.begin();
   uint64 evicted_so_far_size = 0;
   while (evicted_so_far_size < cache_size_ - low_watermark_) {
-    DCHECK(it != entry_hashes.end());
-    EntrySet::iterator found_meta = entries_set_.find(*it);
-    DCHECK(found_meta != entries_set_.end());
-    uint64 to_evict_size = found_meta->second.GetEntrySize();
-    evicted_so_far_size += to_evict_size;
-    ++it;
+    DCHECK(batch_begin != candidates.end());
+    if (batch_begin == candidates.end())
+      break;
+    std::vector<EvictionCandidate>::iterator batch_end =
+        batch_begin + std::min(batch_size,
+                               static_cast<size_t>(candidates.end() -
+                                                   batch_begin));
+    std::nth_element(batch_begin, batch_end - 1, candidates.end(),
+                     &IsUsedEarlier);
+    std::sort(batch_begin, batch_end, &IsUsedEarlier);
+    for (std::vector<EvictionCandidate>::iterator it = batch_begin;
+         it != batch_end &&
+             evicted_so_far_size < cache_size_ - low_watermark_;
+         ++it) {
+      entry_hashes.push_back(it->entry_hash);
+      evicted_so_far_size += it->entry_size;
+    }
+    batch_begin = batch_end;
   }
 
-  // Take out the rest of hashes from the eviction list.
-  entry_hashes.erase(it, entry_hashes.end());
   SIMPLE_CACHE_UMA(COUNTS,
                    "Eviction.EntryCount", cache_type_, entry_hashes.size());
   SIMPLE_CACHE_UMA(TIMES,
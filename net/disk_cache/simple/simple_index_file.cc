@@ -77,7 +77,10 @@ bool WritePickleFile(Pickle* pickle, const base::FilePath& file_name) {
 
 // Called for each cache directory traversal iteration.
 void ProcessEntryFile(SimpleIndex::EntrySet* entries,
-                      const base::FilePath& file_path) {
+                      const base::FilePath& file_path,
+                      base::Time last_accessed,
+                      base::Time last_modified,
+                      int64 file_size) {
   static const size_t kEntryFilesLength =
       kEntryFilesHashLength + kEntryFilesSuffixLength;
   // Converting to std::string is OK since we never use UTF8 wide chars in our
@@ -95,21 +98,12 @@ void ProcessEntryFile(SimpleIndex::EntrySet* entries,
     return;
   }
 
-  base::File::Info file_info;
-  if (!base::GetFileInfo(file_path, &file_info)) {
-    LOG(ERROR) << "Could not get file info for " << file_path.value();
-    return;
-  }
-  base::Time last_used_time;
-#if defined(OS_POSIX)
-  // For POSIX systems, a last access time is available. However, it's not
+  // The last access time is only available on POSIX systems. It's not
   // guaranteed to be more accurate than mtime. It is no worse though.
-  last_used_time = file_info.last_accessed;
-#endif
+  base::Time last_used_time = last_accessed;
   if (last_used_time.is_null())
-    last_used_time = file_info.last_modified;
+    last_used_time = last_modified;
 
-  int64 file_size = file_info.size;
   SimpleIndex::EntrySet::iterator it = entries->find(hash_key);
   if (it == entries->end()) {
     SimpleIndex::InsertInEntrySet(
@@ -94,8 +94,13 @@ class NET_EXPORT_PRIVATE SimpleIndexFile {
  private:
   friend class WrappedSimpleIndexFile;
 
-  // Used for cache directory traversal.
-  typedef base::Callback<void (const base::FilePath&)> EntryFileCallback;
+  // Used for cache directory traversal. Gets the path of each file, with its
+  // last access time (which can be null), last modification time and size, as
+  // found while traversing.
+  typedef base::Callback<void (const base::FilePath& file_path,
+                               base::Time last_accessed,
+                               base::Time last_modified,
+                               int64 size)> EntryFileCallback;
 
   // When loading the entries from disk, add this many extra hash buckets to
   // prevent reallocation on the IO thread when merging in new live entries.
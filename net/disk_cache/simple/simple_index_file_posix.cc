@@ -13,6 +13,8 @@
 
 #include "base/logging.h"
 #include "base/memory/scoped_ptr.h"
+#include "base/time/time.h"
+#include "build/build_config.h"
 
 namespace disk_cache {
 namespace {
@@ -43,7 +45,24 @@ bool SimpleIndexFile::TraverseCacheDirectory(
       continue;
     const base::FilePath file_path = cache_path.Append(
         base::FilePath(file_name));
-    entry_file_callback.Run(file_path);
+    struct stat file_stat;
+#if defined(OS_MACOSX)
+    // fstatat() isn't available before Mac OS X 10.10.
+    int rv = stat(file_path.value().c_str(), &file_stat);
+#else
+    // Stat relative to the open directory, so that the kernel doesn't resolve
+    // the whole cache path again for each of the (possibly many thousands of)
+    // entry files.
+    int rv = fstatat(dirfd(dir.get()), result->d_name, &file_stat, 0);
+#endif
+    if (rv != 0) {
+      LOG(ERROR) << "Could not get file info for " << file_name;
+      continue;
+    }
+    entry_file_callback.Run(file_path,
+                            base::Time::FromTimeT(file_stat.st_atime),
+                            base::Time::FromTimeT(file_stat.st_mtime),
+                            file_stat.st_size);
   }
   PLOG(ERROR) << "readdir_r " << cache_path.value();
   return false;
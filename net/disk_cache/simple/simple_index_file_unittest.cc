@@ -263,6 +263,44 @@ TEST_F(SimpleIndexFileTest, LoadCorruptIndex) {
   EXPECT_TRUE(load_index_result.flush_required);
 }
 
+TEST_F(SimpleIndexFileTest, RestoreFromDirectory) {
+  base::ScopedTempDir cache_dir;
+  ASSERT_TRUE(cache_dir.CreateUniqueTempDir());
+
+  // Two files of the same entry, and a file that isn't an entry's.
+  const uint64 kHash = 0x0123456789abcdefULL;
+  const std::string kData0(100, 'a');
+  const std::string kData1(50, 'b');
+  const base::FilePath file_0 = cache_dir.path().AppendASCII(
+      simple_util::GetFilenameFromEntryHashAndFileIndex(kHash, 0));
+  const base::FilePath file_1 = cache_dir.path().AppendASCII(
+      simple_util::GetFilenameFromEntryHashAndFileIndex(kHash, 1));
+  ASSERT_EQ(implicit_cast<int>(kData0.size()),
+            file_util::WriteFile(file_0, kData0.data(), kData0.size()));
+  ASSERT_EQ(implicit_cast<int>(kData1.size()),
+            file_util::WriteFile(file_1, kData1.data(), kData1.size()));
+  ASSERT_EQ(3, file_util::WriteFile(cache_dir.path().AppendASCII("other"),
+                                    "xyz", 3));
+
+  // Without an index file, the entries are found by scanning the directory.
+  WrappedSimpleIndexFile simple_index_file(cache_dir.path());
+  SimpleIndexLoadResult load_index_result;
+  simple_index_file.LoadIndexEntries(base::Time::Now(),
+                                     GetCallback(),
+                                     &load_index_result);
+  base::RunLoop().RunUntilIdle();
+
+  ASSERT_TRUE(callback_called());
+  EXPECT_TRUE(load_index_result.did_load);
+  EXPECT_TRUE(load_index_result.flush_required);
+  ASSERT_EQ(1U, load_index_result.entries.size());
+  SimpleIndex::EntrySet::const_iterator it =
+      load_index_result.entries.find(kHash);
+  ASSERT_TRUE(it != load_index_result.entries.end());
+  EXPECT_EQ(kData0.size() + kData1.size(), it->second.GetEntrySize());
+  EXPECT_FALSE(it->second.GetLastUsedTime().is_null());
+}
+
 // Tests that after an upgrade the backend has the index file put in place.
 TEST_F(SimpleIndexFileTest, SimpleCacheUpgrade) {
   base::ScopedTempDir cache_dir;
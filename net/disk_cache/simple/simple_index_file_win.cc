@@ -8,6 +8,7 @@
 
 #include "base/files/file_enumerator.h"
 #include "base/files/file_path.h"
+#include "base/time/time.h"
 
 namespace disk_cache {
 
@@ -25,7 +26,12 @@ bool SimpleIndexFile::TraverseCacheDirectory(
        file_path = enumerator.Next()) {
     if (file_path == current_directory || file_path == parent_directory)
       continue;
-    entry_file_callback.Run(file_path);
+    // The enumerator already has the size and modification time, so there's
+    // no need to open each file for them. Windows doesn't reliably maintain
+    // last access times, which is why none is passed.
+    const base::FileEnumerator::FileInfo info = enumerator.GetInfo();
+    entry_file_callback.Run(file_path, base::Time(),
+                            info.GetLastModifiedTime(), info.GetSize());
   }
   return true;
 }
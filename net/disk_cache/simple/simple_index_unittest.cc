@@ -549,6 +549,36 @@ TEST_F(SimpleIndexTest, BasicEviction) {
   ASSERT_EQ(2u, last_doom_entry_hashes().size());
 }
 
+// Eviction of many entries takes the oldest ones, across several of the
+// batches it selects them in.
+TEST_F(SimpleIndexTest, EvictionOfManyEntries) {
+  const int kNumEntries = 2000;
+  const int kEntrySize = 48;
+  base::Time now(base::Time::Now());
+  index()->SetMaxSize(kNumEntries * kEntrySize + 4000);
+  for (int i = 0; i < kNumEntries; ++i) {
+    InsertIntoIndexFileReturn(static_cast<uint64>(i) * 7919 + 1,
+                              now - base::TimeDelta::FromMinutes(i + 1),
+                              kEntrySize);
+  }
+  ReturnIndexFile();
+  EXPECT_EQ(0, doom_entries_calls());
+
+  index()->Insert(hashes_.at<1>());
+  index()->UpdateEntrySize(hashes_.at<1>(), kEntrySize);
+  ASSERT_EQ(1, doom_entries_calls());
+
+  // 6048 bytes need to go to get below the low watermark.
+  const int kNumEvicted = 126;
+  ASSERT_EQ(static_cast<size_t>(kNumEvicted), last_doom_entry_hashes().size());
+  for (size_t i = 0; i < last_doom_entry_hashes().size(); ++i) {
+    uint64 entry = (last_doom_entry_hashes()[i] - 1) / 7919;
+    EXPECT_LE(static_cast<uint64>(kNumEntries - kNumEvicted), entry);
+  }
+  EXPECT_TRUE(index()->Has(hashes_.at<1>()));
+  EXPECT_EQ(kNumEntries + 1 - kNumEvicted, index()->GetEntryCount());
+}
+
 // Confirm all the operations queue a disk write at some point in the
 // future.
 TEST_F(SimpleIndexTest, DiskWriteQueued) {
@@ -29,6 +29,10 @@ using base::Time;
 
 namespace {
 
+// Files 0 up to this size are read in a single read when the entry is opened.
+// This covers most entries holding small resources.
+const int kMaxPrefetchedFileSize = 32 * 1024;
+
 // Used in histograms, please only add entries at the end.
 enum OpenEntryResult {
   OPEN_ENTRY_SUCCESS = 0,
@@ -623,16 +627,9 @@ void SimpleSynchronousEntry::Close(
     scoped_ptr<std::vector<CRCRecord> > crc32s_to_write,
     net::GrowableIOBuffer* stream_0_data) {
   DCHECK(stream_0_data);
-  // Write stream 0 data.
-  int stream_0_offset = entry_stat.GetOffsetInFile(key_, 0, 0);
-  if (files_[0].Write(stream_0_offset, stream_0_data->data(),
-                      entry_stat.data_size(0)) !=
-      entry_stat.data_size(0)) {
-    RecordCloseResult(cache_type_, CLOSE_RESULT_WRITE_FAILURE);
-    DVLOG(1) << "Could not write stream 0 data.";
-    Doom();
-  }
-
+  // Stream 0 is only rewritten along with its EOF record, when the entry
+  // changed it (writing stream 1 moves it, and counts as a change). Entries
+  // that were only read are closed without writing to them.
   for (std::vector<CRCRecord>::const_iterator it = crc32s_to_write->begin();
        it != crc32s_to_write->end(); ++it) {
     const int stream_index = it->index;
@@ -648,15 +645,34 @@ void SimpleSynchronousEntry::Close(
       eof_record.flags |= SimpleFileEOF::FLAG_HAS_CRC32;
     eof_record.data_crc32 = it->data_crc32;
     int eof_offset = entry_stat.GetEOFOffsetInFile(key_, stream_index);
-    // If stream 0 changed size, the file needs to be resized, otherwise the
-    // next open will yield wrong stream sizes. On stream 1 and stream 2 proper
-    // resizing of the file is handled in SimpleSynchronousEntry::WriteData().
-    if (stream_index == 0 &&
-        !files_[file_index].SetLength(eof_offset)) {
-      RecordCloseResult(cache_type_, CLOSE_RESULT_WRITE_FAILURE);
-      DVLOG(1) << "Could not truncate stream 0 file.";
-      Doom();
-      break;
+    if (stream_index == 0) {
+      // Stream 0 is right before its EOF record, at the end of file 0, so
+      // both are written at once. If stream 0 changed size, the file needs to
+      // be resized, otherwise the next open will yield wrong stream sizes. On
+      // stream 1 and stream 2 proper resizing of the file is handled in
+      // SimpleSynchronousEntry::WriteData().
+      const int stream_0_size = entry_stat.data_size(0);
+      std::vector<char> stream_0_and_eof(stream_0_size + sizeof(eof_record));
+      if (stream_0_size > 0)
+        std::memcpy(&stream_0_and_eof[0], stream_0_data->data(), stream_0_size);
+      std::memcpy(&stream_0_and_eof[stream_0_size], &eof_record,
+                  sizeof(eof_record));
+      const int stream_0_offset = entry_stat.GetOffsetInFile(key_, 0, 0);
+      const int bytes_to_write = stream_0_and_eof.size();
+      if (files_[file_index].Write(stream_0_offset, &stream_0_and_eof[0],
+                                   bytes_to_write) != bytes_to_write) {
+        RecordCloseResult(cache_type_, CLOSE_RESULT_WRITE_FAILURE);
+        DVLOG(1) << "Could not write stream 0 data and eof record.";
+        Doom();
+        break;
+      }
+      if (!files_[file_index].SetLength(eof_offset + sizeof(eof_record))) {
+        RecordCloseResult(cache_type_, CLOSE_RESULT_WRITE_FAILURE);
+        DVLOG(1) << "Could not truncate stream 0 file.";
+        Doom();
+        break;
+      }
+      continue;
     }
     if (files_[file_index].Write(eof_offset,
                                  reinterpret_cast<const char*>(&eof_record),
@@ -787,6 +803,11 @@ bool SimpleSynchronousEntry::OpenFiles(
 
   have_open_files_ = true;
 
+  // The modification time of |path_| is the same for all the files, so it's
+  // only looked up once.
+  base::Time file_last_modified;
+  const bool got_last_modified =
+      simple_util::GetMTime(path_, &file_last_modified);
   base::TimeDelta entry_age = base::Time::Now() - base::Time::UnixEpoch();
   for (int i = 0; i < kSimpleEntryFileCount; ++i) {
     if (empty_file_omitted_[i]) {
@@ -796,13 +817,12 @@ bool SimpleSynchronousEntry::OpenFiles(
 
     File::Info file_info;
     bool success = files_[i].GetInfo(&file_info);
-    base::Time file_last_modified;
     if (!success) {
       DLOG(WARNING) << "Could not get platform file info.";
       continue;
     }
     out_entry_stat->set_last_used(file_info.last_accessed);
-    if (simple_util::GetMTime(path_, &file_last_modified))
+    if (got_last_modified)
       out_entry_stat->set_last_modified(file_last_modified);
     else
       out_entry_stat->set_last_modified(file_info.last_modified);
@@ -904,13 +924,29 @@ int SimpleSynchronousEntry::InitializeForOpen(
     DLOG(WARNING) << "Could not open platform files for entry.";
     return net::ERR_FAILED;
   }
+
+  // The header, key, stream 0 and its EOF record are all read from file 0,
+  // in four reads. When the file is small, read it whole instead. The size of
+  // file 0 is temporarily kept in data_size(1) (see OpenFiles).
+  DCHECK(prefetched_file_0_data_.empty());
+  const int file_0_size = out_entry_stat->data_size(1);
+  if (file_0_size > 0 && file_0_size <= kMaxPrefetchedFileSize) {
+    prefetched_file_0_data_.resize(file_0_size);
+    if (files_[0].Read(0, &prefetched_file_0_data_[0], file_0_size) !=
+        file_0_size) {
+      prefetched_file_0_data_.clear();
+    }
+  }
+  SIMPLE_CACHE_UMA(BOOLEAN, "SyncOpenPrefetchedFile0", cache_type_,
+                   !prefetched_file_0_data_.empty());
+
   for (int i = 0; i < kSimpleEntryFileCount; ++i) {
     if (empty_file_omitted_[i])
       continue;
 
     SimpleFileHeader header;
-    int header_read_result =
-        files_[i].Read(0, reinterpret_cast<char*>(&header), sizeof(header));
+    int header_read_result = ReadFromFileOrPrefetched(
+        i, 0, reinterpret_cast<char*>(&header), sizeof(header));
     if (header_read_result != sizeof(header)) {
       DLOG(WARNING) << "Cannot read header from entry.";
       RecordSyncOpenResult(cache_type_, OPEN_ENTRY_CANT_READ_HEADER, had_index);
@@ -933,8 +969,9 @@ int SimpleSynchronousEntry::InitializeForOpen(
     }
 
     scoped_ptr<char[]> key(new char[header.key_length]);
-    int key_read_result = files_[i].Read(sizeof(header), key.get(),
-                                         header.key_length);
+    int key_read_result = ReadFromFileOrPrefetched(i, sizeof(header),
+                                                   key.get(),
+                                                   header.key_length);
     if (key_read_result != implicit_cast<int>(header.key_length)) {
       DLOG(WARNING) << "Cannot read key from entry.";
       RecordSyncOpenResult(cache_type_, OPEN_ENTRY_CANT_READ_KEY, had_index);
@@ -948,6 +985,8 @@ int SimpleSynchronousEntry::InitializeForOpen(
           GetDataSizeFromKeyAndFileSize(key_, out_entry_stat->data_size(1));
       int ret_value_stream_0 = ReadAndValidateStream0(
           total_data_size, out_entry_stat, stream_0_data, out_stream_0_crc32);
+      // Nothing else is read from file 0 while opening.
+      std::string().swap(prefetched_file_0_data_);
       if (ret_value_stream_0 != net::OK)
         return ret_value_stream_0;
     } else {
@@ -1075,9 +1114,8 @@ int SimpleSynchronousEntry::ReadAndValidateStream0(
   *stream_0_data = new net::GrowableIOBuffer();
   (*stream_0_data)->SetCapacity(stream_0_size);
   int file_offset = out_entry_stat->GetOffsetInFile(key_, 0, 0);
-  File* file = const_cast<File*>(&files_[0]);
-  int bytes_read =
-      file->Read(file_offset, (*stream_0_data)->data(), stream_0_size);
+  int bytes_read = ReadFromFileOrPrefetched(
+      0, file_offset, (*stream_0_data)->data(), stream_0_size);
   if (bytes_read != stream_0_size)
     return net::ERR_FAILED;
 
@@ -1106,9 +1144,9 @@ int SimpleSynchronousEntry::GetEOFRecordData(int index,
   SimpleFileEOF eof_record;
   int file_offset = entry_stat.GetEOFOffsetInFile(key_, index);
   int file_index = GetFileIndexFromStreamIndex(index);
-  File* file = const_cast<File*>(&files_[file_index]);
-  if (file->Read(file_offset, reinterpret_cast<char*>(&eof_record),
-                 sizeof(eof_record)) !=
+  if (ReadFromFileOrPrefetched(file_index, file_offset,
+                               reinterpret_cast<char*>(&eof_record),
+                               sizeof(eof_record)) !=
       sizeof(eof_record)) {
     RecordCheckEOFResult(cache_type_, CHECK_EOF_RESULT_READ_FAILURE);
     return net::ERR_CACHE_CHECKSUM_READ_FAILURE;
@@ -1128,6 +1166,22 @@ int SimpleSynchronousEntry::GetEOFRecordData(int index,
   return net::OK;
 }
 
+int SimpleSynchronousEntry::ReadFromFileOrPrefetched(int file_index,
+                                                     int offset,
+                                                     char* buf,
+                                                     int buf_len) const {
+  if (file_index != 0 || prefetched_file_0_data_.empty()) {
+    File* file = const_cast<File*>(&files_[file_index]);
+    return file->Read(offset, buf, buf_len);
+  }
+  const int prefetched_size = prefetched_file_0_data_.size();
+  if (offset < 0 || buf_len < 0 || offset > prefetched_size)
+    return -1;
+  const int bytes_read = std::min(buf_len, prefetched_size - offset);
+  std::memcpy(buf, prefetched_file_0_data_.data() + offset, bytes_read);
+  return bytes_read;
+}
+
 void SimpleSynchronousEntry::Doom() const {
   DeleteFilesForEntryHash(path_, entry_hash_);
 }
@@ -259,6 +259,14 @@ class SimpleSynchronousEntry {
                        bool* out_has_crc32,
                        uint32* out_crc32,
                        int* out_data_size) const;
+
+  // Reads like base::File::Read() from file |file_index|, but from
+  // |prefetched_file_0_data_| for file 0 when it holds the file.
+  int ReadFromFileOrPrefetched(int file_index,
+                               int offset,
+                               char* buf,
+                               int buf_len) const;
+
   void Doom() const;
 
   // Opens the sparse data file and scans it if it exists.
@@ -322,6 +330,10 @@ class SimpleSynchronousEntry {
   // was created to store it.
   bool empty_file_omitted_[kSimpleEntryFileCount];
 
+  // The whole contents of file 0 while the entry is being opened, if the file
+  // is small enough to be read at once. Empty otherwise.
+  std::string prefetched_file_0_data_;
+
   typedef std::map<int64, SparseRange> SparseRangeOffsetMap;
   typedef SparseRangeOffsetMap::iterator SparseRangeIterator;
   SparseRangeOffsetMap sparse_ranges_;
@@ -231,6 +231,11 @@ unsigned DnsResponse::answer_count() const {
   return base::NetToHost16(header()->ancount);
 }
 
+unsigned DnsResponse::authority_count() const {
+  DCHECK(parser_.IsValid());
+  return base::NetToHost16(header()->nscount);
+}
+
 unsigned DnsResponse::additional_answer_count() const {
   DCHECK(parser_.IsValid());
   return base::NetToHost16(header()->arcount);
@@ -324,7 +329,9 @@ DnsResponse::Result DnsResponse::ParseToAddressList(
     }
   }
 
-  // TODO(szym): Extract TTL for NODATA results. http://crbug.com/115051
+  // An empty answer keeps the maximum TTL, so that a NODATA AAAA answer
+  // doesn't shorten the TTL of the A records it's combined with. How long the
+  // empty answer itself can be cached comes from ParseNegativeTTL().
 
   // getcanonname in eglibc returns the first owner name of an A or AAAA RR.
   // If the response passed all the checks so far, then |expected_name| is it.
@@ -334,4 +341,43 @@ DnsResponse::Result DnsResponse::ParseToAddressList(
   return DNS_PARSE_OK;
 }
 
+bool DnsResponse::ParseNegativeTTL(base::TimeDelta* ttl) const {
+  DCHECK(IsValid());
+  DnsRecordParser parser = Parser();
+  DnsResourceRecord record;
+  unsigned ancount = answer_count();
+  for (unsigned i = 0; i < ancount; ++i) {
+    if (!parser.ReadRecord(&record))
+      return false;
+  }
+
+  unsigned nscount = authority_count();
+  for (unsigned i = 0; i < nscount; ++i) {
+    if (!parser.ReadRecord(&record))
+      return false;
+    if (record.type != dns_protocol::kTypeSOA)
+      continue;
+
+    // The RDATA is MNAME and RNAME, then SERIAL, REFRESH, RETRY, EXPIRE and
+    // MINIMUM.
+    size_t offset = 0;
+    for (int names = 0; names < 2; ++names) {
+      if (offset >= record.rdata.size())
+        return false;
+      unsigned consumed = parser.ReadName(record.rdata.data() + offset, NULL);
+      if (!consumed)
+        return false;
+      offset += consumed;
+    }
+    if (record.rdata.size() != offset + 5 * sizeof(uint32))
+      return false;
+    uint32 minimum;
+    ReadBigEndian<uint32>(record.rdata.data() + offset + 4 * sizeof(uint32),
+                          &minimum);
+    *ttl = base::TimeDelta::FromSeconds(std::min(record.ttl, minimum));
+    return true;
+  }
+  return false;
+}
+
 }  // namespace net
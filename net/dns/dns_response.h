@@ -132,6 +132,7 @@ class NET_EXPORT_PRIVATE DnsResponse {
   uint8 rcode() const;
 
   unsigned answer_count() const;
+  unsigned authority_count() const;
   unsigned additional_answer_count() const;
 
   // Accessors to the question. The qname is unparsed.
@@ -148,8 +149,16 @@ class NET_EXPORT_PRIVATE DnsResponse {
 
   // Extracts an AddressList from this response. Returns SUCCESS if succeeded.
   // Otherwise returns a detailed error number.
+  // For a negative answer, |ttl| is the maximum, and ParseNegativeTTL() gives
+  // the TTL of the answer itself.
   Result ParseToAddressList(AddressList* addr_list, base::TimeDelta* ttl) const;
 
+  // Extracts how long a negative (NXDOMAIN or NODATA) answer can be cached
+  // from the SOA record in the authority section: the smaller of its TTL and
+  // its MINIMUM field, as in RFC 2308. Returns false if there is no valid SOA
+  // record.
+  bool ParseNegativeTTL(base::TimeDelta* ttl) const;
+
  private:
   // Convenience for header access.
   const dns_protocol::Header* header() const;
@@ -457,6 +457,51 @@ TEST(DnsResponseTest, ParseToAddressList) {
   }
 }
 
+const uint8 kResponseNoData[] = {
+  // Header: 1 question, 1 authority RR
+  0x00, 0x00, 0x81, 0x80, 0x00, 0x01, 0x00, 0x00, 0x00, 0x01, 0x00, 0x00,
+  // Question: name = 'a', type = A (0x1)
+  0x01,  'a', 0x00, 0x00, 0x01, 0x00, 0x01,
+  // Authority: name = 'a', type = SOA, TTL = 0xE10 (3600 seconds)
+  0xc0, 0x0c, 0x00, 0x06, 0x00, 0x01, 0x00, 0x00, 0x0e, 0x10, 0x00, 0x1b,
+  // RDATA: MNAME = 'ns.a', RNAME = 'a', SERIAL = 1, REFRESH, RETRY and
+  // EXPIRE = 0, MINIMUM = 0x12C (300 seconds)
+  0x02,  'n',  's', 0xc0, 0x0c, 0xc0, 0x0c,
+  0x00, 0x00, 0x00, 0x01, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x01, 0x2c,
+};
+
+TEST(DnsResponseTest, ParseNegativeTTL) {
+  const size_t kQuerySize = 12 + 7;
+  DnsResponse response(kResponseNoData, arraysize(kResponseNoData),
+                       kQuerySize);
+  base::TimeDelta ttl;
+  EXPECT_TRUE(response.ParseNegativeTTL(&ttl));
+  EXPECT_EQ(base::TimeDelta::FromSeconds(300), ttl);
+
+  // The address list TTL of a NODATA answer is still the maximum, so that it
+  // doesn't shorten the TTL of the other address family.
+  AddressList addr_list;
+  ttl = base::TimeDelta();
+  EXPECT_EQ(DnsResponse::DNS_PARSE_OK,
+            response.ParseToAddressList(&addr_list, &ttl));
+  EXPECT_TRUE(addr_list.empty());
+  EXPECT_EQ(base::TimeDelta::FromSeconds(kuint32max), ttl);
+
+  // Without the SOA record, there is no negative TTL.
+  uint8 no_authority[arraysize(kResponseNoData)];
+  memcpy(no_authority, kResponseNoData, sizeof(no_authority));
+  no_authority[9] = 0;
+  DnsResponse response_no_authority(no_authority, sizeof(no_authority),
+                                    kQuerySize);
+  EXPECT_FALSE(response_no_authority.ParseNegativeTTL(&ttl));
+
+  // Nor with a truncated one.
+  DnsResponse response_truncated(kResponseNoData,
+                                 arraysize(kResponseNoData) - 4, kQuerySize);
+  EXPECT_FALSE(response_truncated.ParseNegativeTTL(&ttl));
+}
+
 const uint8 kResponseTruncatedRecord[] = {
   // Header: 1 question, 1 answer RR
   0x00, 0x00, 0x81, 0x80, 0x00, 0x01, 0x00, 0x01, 0x00, 0x00, 0x00, 0x00,
@@ -90,6 +90,7 @@ class MockTransaction : public DnsTransaction,
   void Finish() {
     switch (result_) {
       case MockDnsClientRule::EMPTY:
+      case MockDnsClientRule::NODATA:
       case MockDnsClientRule::OK: {
         std::string qname;
         DNSDomainFromDot(hostname_, &qname);
@@ -134,6 +135,35 @@ class MockTransaction : public DnsTransaction,
             writer.WriteBytes(kIPv6Loopback, sizeof(kIPv6Loopback));
           }
           nbytes += answer_size;
+        } else if (MockDnsClientRule::NODATA == result_) {
+          const uint16 kPointerToQueryName =
+              static_cast<uint16>(0xc000 | sizeof(*header));
+
+          // The negative TTL is the smaller of the SOA record's TTL and its
+          // MINIMUM field.
+          const uint32 kSOATTL = 86400;
+
+          // MNAME and RNAME point at the query name, followed by SERIAL,
+          // REFRESH, RETRY, EXPIRE and MINIMUM.
+          size_t rdata_size = 2 * sizeof(kPointerToQueryName) +
+                              5 * sizeof(uint32);
+          size_t authority_size = 12 + rdata_size;
+
+          header->nscount = base::HostToNet16(1);
+          BigEndianWriter writer(buffer + nbytes, authority_size);
+          writer.WriteU16(kPointerToQueryName);
+          writer.WriteU16(net::dns_protocol::kTypeSOA);
+          writer.WriteU16(net::dns_protocol::kClassIN);
+          writer.WriteU32(kSOATTL);
+          writer.WriteU16(rdata_size);
+          writer.WriteU16(kPointerToQueryName);
+          writer.WriteU16(kPointerToQueryName);
+          writer.WriteU32(1);
+          writer.WriteU32(0);
+          writer.WriteU32(0);
+          writer.WriteU32(0);
+          writer.WriteU32(kNoDataTTL);
+          nbytes += authority_size;
         }
         EXPECT_TRUE(response.InitParse(nbytes, query));
         callback_.Run(this, OK, &response);
@@ -175,6 +175,9 @@ static const int kT3TTL = 0x00000015;
 // +2 for the CNAME records, +1 for TXT record.
 static const unsigned kT3RecordCount = arraysize(kT3IpAddresses) + 3;
 
+// The negative TTL of MockDnsClientRule::NODATA responses.
+static const int kNoDataTTL = 60;
+
 class AddressSorter;
 class DnsClient;
 class MockTransactionFactory;
@@ -184,6 +187,7 @@ struct MockDnsClientRule {
     FAIL,     // Fail asynchronously with ERR_NAME_NOT_RESOLVED.
     TIMEOUT,  // Fail asynchronously with ERR_DNS_TIMEOUT.
     EMPTY,    // Return an empty response.
+    NODATA,   // Return an empty response with an SOA record.
     OK,       // Return a response with loopback address.
   };
 
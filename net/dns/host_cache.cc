@@ -8,10 +8,24 @@
 #include "base/metrics/field_trial.h"
 #include "base/metrics/histogram.h"
 #include "base/strings/string_number_conversions.h"
+#include "base/values.h"
 #include "net/base/net_errors.h"
+#include "net/base/net_util.h"
 
 namespace net {
 
+namespace {
+
+// Keys of the values of GetAsListValue().
+const char kHostnameKey[] = "hostname";
+const char kAddressFamilyKey[] = "address_family";
+const char kFlagsKey[] = "flags";
+const char kExpirationKey[] = "expiration";
+const char kAddressesKey[] = "addresses";
+const char kCanonicalNameKey[] = "canonical_name";
+
+}  // namespace
+
 //-----------------------------------------------------------------------------
 
 HostCache::Entry::Entry(int error, const AddressList& addrlist,
@@ -75,6 +89,94 @@ size_t HostCache::max_entries() const {
   return entries_.max_entries();
 }
 
+void HostCache::GetAsListValue(base::ListValue* entry_list) const {
+  DCHECK(CalledOnValidThread());
+  const base::TimeTicks now = base::TimeTicks::Now();
+  const base::Time wall_now = base::Time::Now();
+  for (EntryMap::Iterator it(entries_); it.HasNext(); it.Advance()) {
+    const Entry& entry = it.value();
+    if (entry.error != OK || entry.addrlist.empty() || it.expiration() <= now)
+      continue;
+
+    base::ListValue* addresses = new base::ListValue();
+    for (AddressList::const_iterator address = entry.addrlist.begin();
+         address != entry.addrlist.end(); ++address) {
+      addresses->AppendString(address->ToStringWithoutPort());
+    }
+
+    base::DictionaryValue* value = new base::DictionaryValue();
+    value->SetString(kHostnameKey, it.key().hostname);
+    value->SetInteger(kAddressFamilyKey, it.key().address_family);
+    value->SetInteger(kFlagsKey, it.key().host_resolver_flags);
+    // A base::Value can't hold an int64, so the time goes in a string.
+    value->SetString(
+        kExpirationKey,
+        base::Int64ToString(
+            (wall_now + (it.expiration() - now)).ToInternalValue()));
+    value->Set(kAddressesKey, addresses);
+    if (!entry.addrlist.canonical_name().empty())
+      value->SetString(kCanonicalNameKey, entry.addrlist.canonical_name());
+    entry_list->Append(value);
+  }
+}
+
+bool HostCache::RestoreFromListValue(const base::ListValue& old_cache) {
+  DCHECK(CalledOnValidThread());
+  const base::TimeTicks now = base::TimeTicks::Now();
+  const base::Time wall_now = base::Time::Now();
+  bool success = true;
+  for (size_t i = 0; i < old_cache.GetSize(); ++i) {
+    const base::DictionaryValue* value = NULL;
+    std::string hostname;
+    int address_family = 0;
+    int flags = 0;
+    std::string expiration_string;
+    int64 expiration = 0;
+    const base::ListValue* addresses = NULL;
+    if (!old_cache.GetDictionary(i, &value) ||
+        !value->GetString(kHostnameKey, &hostname) ||
+        !value->GetInteger(kAddressFamilyKey, &address_family) ||
+        address_family < ADDRESS_FAMILY_UNSPECIFIED ||
+        address_family > ADDRESS_FAMILY_LAST ||
+        !value->GetInteger(kFlagsKey, &flags) ||
+        !value->GetString(kExpirationKey, &expiration_string) ||
+        !base::StringToInt64(expiration_string, &expiration) ||
+        !value->GetList(kAddressesKey, &addresses)) {
+      success = false;
+      continue;
+    }
+
+    base::TimeDelta ttl =
+        base::Time::FromInternalValue(expiration) - wall_now;
+    if (ttl <= base::TimeDelta())
+      continue;
+
+    Key key(hostname, static_cast<AddressFamily>(address_family), flags);
+    if (Lookup(key, now))
+      continue;
+
+    AddressList addrlist;
+    for (size_t j = 0; j < addresses->GetSize(); ++j) {
+      std::string address_string;
+      IPAddressNumber address;
+      if (!addresses->GetString(j, &address_string) ||
+          !ParseIPLiteralToNumber(address_string, &address)) {
+        success = false;
+        continue;
+      }
+      addrlist.push_back(IPEndPoint(address, 0));
+    }
+    if (addrlist.empty())
+      continue;
+    std::string canonical_name;
+    if (value->GetString(kCanonicalNameKey, &canonical_name))
+      addrlist.set_canonical_name(canonical_name);
+
+    Set(key, Entry(OK, addrlist), now, ttl);
+  }
+  return success;
+}
+
 // Note that this map may contain expired entries.
 const HostCache::EntryMap& HostCache::entries() const {
   DCHECK(CalledOnValidThread());
@@ -17,6 +17,10 @@
 #include "net/base/expiring_cache.h"
 #include "net/base/net_export.h"
 
+namespace base {
+class ListValue;
+}
+
 namespace net {
 
 // Cache used by HostResolver to map hostnames to their resolved result.
@@ -93,6 +97,16 @@ class NET_EXPORT HostCache : NON_EXPORTED_BASE(public base::NonThreadSafe) {
   // Empties the cache
   void clear();
 
+  // Appends the successful entries that haven't expired yet to |entry_list|,
+  // in a form that can be saved and given to RestoreFromListValue(), possibly
+  // after a restart. Expirations are kept as wall clock times.
+  void GetAsListValue(base::ListValue* entry_list) const;
+
+  // Adds the entries of |old_cache|, which came from GetAsListValue(), that
+  // haven't expired since, without replacing any entry already in the cache.
+  // Returns false if |old_cache| is malformed, but still adds what it can.
+  bool RestoreFromListValue(const base::ListValue& old_cache);
+
   // Returns the number of entries in the cache.
   size_t size() const;
 
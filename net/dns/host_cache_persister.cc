@@ -0,0 +1,100 @@
+// Copyright 2014 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "net/dns/host_cache_persister.h"
+
+#include "base/bind.h"
+#include "base/file_util.h"
+#include "base/json/json_reader.h"
+#include "base/json/json_writer.h"
+#include "base/logging.h"
+#include "base/sequenced_task_runner.h"
+#include "base/task_runner_util.h"
+#include "base/values.h"
+#include "net/dns/host_cache.h"
+
+namespace {
+
+std::string LoadSnapshot(const base::FilePath& path) {
+  std::string result;
+  if (!base::ReadFileToString(path, &result))
+    return std::string();
+  return result;
+}
+
+}  // namespace
+
+namespace net {
+
+const int HostCachePersister::kWriteIntervalInSeconds = 10 * 60;
+
+HostCachePersister::HostCachePersister(
+    HostCache* cache,
+    const base::FilePath& data_path,
+    base::SequencedTaskRunner* background_runner)
+    : cache_(cache),
+      writer_(data_path.AppendASCII("HostCache"), background_runner),
+      background_runner_(background_runner),
+      writing_stopped_(false),
+      weak_ptr_factory_(this) {
+  DCHECK(cache_);
+  base::PostTaskAndReplyWithResult(
+      background_runner_,
+      FROM_HERE,
+      base::Bind(&LoadSnapshot, writer_.path()),
+      base::Bind(&HostCachePersister::CompleteLoad,
+                 weak_ptr_factory_.GetWeakPtr()));
+  write_timer_.Start(FROM_HERE,
+                     base::TimeDelta::FromSeconds(kWriteIntervalInSeconds),
+                     this, &HostCachePersister::ScheduleWrite);
+}
+
+HostCachePersister::~HostCachePersister() {
+  DCHECK(CalledOnValidThread());
+  if (writing_stopped_)
+    return;
+  writer_.ScheduleWrite(this);
+  writer_.DoScheduledWrite();
+}
+
+void HostCachePersister::ScheduleWrite() {
+  DCHECK(CalledOnValidThread());
+  if (writing_stopped_)
+    return;
+  writer_.ScheduleWrite(this);
+}
+
+void HostCachePersister::StopWriting() {
+  DCHECK(CalledOnValidThread());
+  if (writer_.HasPendingWrite())
+    writer_.DoScheduledWrite();
+  write_timer_.Stop();
+  writing_stopped_ = true;
+}
+
+bool HostCachePersister::SerializeData(std::string* data) {
+  DCHECK(CalledOnValidThread());
+  base::ListValue entries;
+  cache_->GetAsListValue(&entries);
+  return base::JSONWriter::Write(&entries, data);
+}
+
+bool HostCachePersister::LoadEntries(const std::string& serialized) {
+  DCHECK(CalledOnValidThread());
+  scoped_ptr<base::Value> value(base::JSONReader::Read(serialized));
+  base::ListValue* entries = NULL;
+  if (!value || !value->GetAsList(&entries))
+    return false;
+  return cache_->RestoreFromListValue(*entries);
+}
+
+void HostCachePersister::CompleteLoad(const std::string& serialized) {
+  DCHECK(CalledOnValidThread());
+  if (serialized.empty())
+    return;
+  if (!LoadEntries(serialized))
+    LOG(ERROR) << "Failed to restore the host cache snapshot";
+}
+
+}  // namespace net
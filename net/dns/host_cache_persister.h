@@ -0,0 +1,92 @@
+// Copyright 2014 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+// HostCachePersister saves the entries of a HostCache to disk, so that the
+// hosts resolved before a restart don't all have to be resolved again right
+// after it.
+//
+// At startup the file is read on the background task runner and, once it's
+// read, the entries that haven't expired yet are added to the cache (without
+// replacing the ones resolved meanwhile). Afterwards the cache is written out
+// periodically, and one last time when the persister is destroyed, unless
+// StopWriting() was called.
+
+#ifndef NET_DNS_HOST_CACHE_PERSISTER_H_
+#define NET_DNS_HOST_CACHE_PERSISTER_H_
+
+#include <string>
+
+#include "base/files/file_path.h"
+#include "base/files/important_file_writer.h"
+#include "base/memory/ref_counted.h"
+#include "base/memory/weak_ptr.h"
+#include "base/threading/non_thread_safe.h"
+#include "base/timer/timer.h"
+#include "net/base/net_export.h"
+
+namespace base {
+class SequencedTaskRunner;
+}
+
+namespace net {
+
+class HostCache;
+
+// Reads and updates the on-disk HostCache snapshot. Clients of this class
+// should create, destroy, and call into it from the thread of the cache.
+class NET_EXPORT HostCachePersister
+    : public base::ImportantFileWriter::DataSerializer,
+      NON_EXPORTED_BASE(public base::NonThreadSafe) {
+ public:
+  // |cache| must outlive the persister. The snapshot is kept in |data_path|,
+  // and |background_runner| is used for the file IO.
+  HostCachePersister(HostCache* cache,
+                     const base::FilePath& data_path,
+                     base::SequencedTaskRunner* background_runner);
+  virtual ~HostCachePersister();
+
+  // Schedules a write of the cache soon, for when it changed in a way that
+  // shouldn't wait for the next periodic write (like being cleared).
+  void ScheduleWrite();
+
+  // Writes out any pending change right away, and then never writes the cache
+  // again. For when the cache is about to get entries that must not be saved,
+  // like the hosts resolved for an off-the-record profile.
+  void StopWriting();
+
+  // ImportantFileWriter::DataSerializer:
+  //
+  // Serializes the cache as JSON, in the format of HostCache::GetAsListValue().
+  virtual bool SerializeData(std::string* data) OVERRIDE;
+
+  // Adds the entries of the JSON |serialized| to the cache. Returns false if
+  // it is malformed.
+  bool LoadEntries(const std::string& serialized);
+
+  // How often the cache is written out.
+  static const int kWriteIntervalInSeconds;
+
+ private:
+  void CompleteLoad(const std::string& serialized);
+
+  HostCache* const cache_;
+
+  // Helper for safely writing the data.
+  base::ImportantFileWriter writer_;
+
+  scoped_refptr<base::SequencedTaskRunner> background_runner_;
+
+  base::RepeatingTimer<HostCachePersister> write_timer_;
+
+  // Set by StopWriting().
+  bool writing_stopped_;
+
+  base::WeakPtrFactory<HostCachePersister> weak_ptr_factory_;
+
+  DISALLOW_COPY_AND_ASSIGN(HostCachePersister);
+};
+
+}  // namespace net
+
+#endif  // NET_DNS_HOST_CACHE_PERSISTER_H_
@@ -0,0 +1,133 @@
+// Copyright 2014 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "net/dns/host_cache_persister.h"
+
+#include <string>
+
+#include "base/files/scoped_temp_dir.h"
+#include "base/message_loop/message_loop.h"
+#include "base/values.h"
+#include "net/base/net_errors.h"
+#include "net/base/net_util.h"
+#include "net/dns/host_cache.h"
+#include "testing/gtest/include/gtest/gtest.h"
+
+namespace net {
+
+namespace {
+
+const size_t kMaxCacheEntries = 10;
+
+HostCache::Key Key(const std::string& hostname) {
+  return HostCache::Key(hostname, ADDRESS_FAMILY_UNSPECIFIED, 0);
+}
+
+AddressList MakeAddressList(const std::string& literal) {
+  IPAddressNumber address;
+  CHECK(ParseIPLiteralToNumber(literal, &address));
+  AddressList addrlist;
+  addrlist.push_back(IPEndPoint(address, 0));
+  return addrlist;
+}
+
+class HostCachePersisterTest : public testing::Test {
+ public:
+  HostCachePersisterTest() {}
+
+  virtual void SetUp() OVERRIDE {
+    ASSERT_TRUE(temp_dir_.CreateUniqueTempDir());
+  }
+
+ protected:
+  scoped_ptr<HostCachePersister> CreatePersister(HostCache* cache) {
+    return scoped_ptr<HostCachePersister>(new HostCachePersister(
+        cache, temp_dir_.path(), message_loop_.message_loop_proxy()));
+  }
+
+  base::MessageLoopForIO message_loop_;
+  base::ScopedTempDir temp_dir_;
+};
+
+TEST_F(HostCachePersisterTest, SerializeData) {
+  const base::TimeDelta kTTL = base::TimeDelta::FromSeconds(60);
+  HostCache cache(kMaxCacheEntries);
+  scoped_ptr<HostCachePersister> persister = CreatePersister(&cache);
+  message_loop_.RunUntilIdle();
+
+  cache.Set(Key("foobar1.com"),
+            HostCache::Entry(OK, MakeAddressList("1.1.1.1")),
+            base::TimeTicks::Now(), kTTL);
+  std::string data;
+  EXPECT_TRUE(persister->SerializeData(&data));
+
+  HostCache other_cache(kMaxCacheEntries);
+  scoped_ptr<HostCachePersister> other_persister =
+      CreatePersister(&other_cache);
+  EXPECT_TRUE(other_persister->LoadEntries(data));
+  EXPECT_TRUE(other_cache.Lookup(Key("foobar1.com"), base::TimeTicks::Now()));
+
+  EXPECT_FALSE(other_persister->LoadEntries("not json"));
+  EXPECT_FALSE(other_persister->LoadEntries("{}"));
+}
+
+// The cache is written when the persister goes away, and read back by the
+// next one.
+TEST_F(HostCachePersisterTest, RestoresAfterRestart) {
+  const base::TimeDelta kTTL = base::TimeDelta::FromSeconds(60);
+  {
+    HostCache cache(kMaxCacheEntries);
+    scoped_ptr<HostCachePersister> persister = CreatePersister(&cache);
+    message_loop_.RunUntilIdle();
+    cache.Set(Key("foobar1.com"),
+              HostCache::Entry(OK, MakeAddressList("1.1.1.1")),
+              base::TimeTicks::Now(), kTTL);
+  }
+  message_loop_.RunUntilIdle();
+
+  HostCache cache(kMaxCacheEntries);
+  // Resolved before the snapshot is read.
+  cache.Set(Key("foobar2.com"),
+            HostCache::Entry(OK, MakeAddressList("2.2.2.2")),
+            base::TimeTicks::Now(), kTTL);
+  scoped_ptr<HostCachePersister> persister = CreatePersister(&cache);
+  message_loop_.RunUntilIdle();
+
+  EXPECT_EQ(2u, cache.size());
+  EXPECT_TRUE(cache.Lookup(Key("foobar1.com"), base::TimeTicks::Now()));
+  EXPECT_TRUE(cache.Lookup(Key("foobar2.com"), base::TimeTicks::Now()));
+}
+
+// Nothing added to the cache after StopWriting() reaches the disk.
+TEST_F(HostCachePersisterTest, StopWriting) {
+  const base::TimeDelta kTTL = base::TimeDelta::FromSeconds(60);
+  {
+    HostCache cache(kMaxCacheEntries);
+    scoped_ptr<HostCachePersister> persister = CreatePersister(&cache);
+    message_loop_.RunUntilIdle();
+    cache.Set(Key("foobar1.com"),
+              HostCache::Entry(OK, MakeAddressList("1.1.1.1")),
+              base::TimeTicks::Now(), kTTL);
+    persister->ScheduleWrite();
+
+    // The pending write still goes out.
+    persister->StopWriting();
+    cache.Set(Key("foobar2.com"),
+              HostCache::Entry(OK, MakeAddressList("2.2.2.2")),
+              base::TimeTicks::Now(), kTTL);
+    persister->ScheduleWrite();
+  }
+  message_loop_.RunUntilIdle();
+
+  HostCache cache(kMaxCacheEntries);
+  scoped_ptr<HostCachePersister> persister = CreatePersister(&cache);
+  message_loop_.RunUntilIdle();
+
+  EXPECT_EQ(1u, cache.size());
+  EXPECT_TRUE(cache.Lookup(Key("foobar1.com"), base::TimeTicks::Now()));
+}
+
+}  // namespace
+
+}  // namespace net
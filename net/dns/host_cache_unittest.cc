@@ -8,7 +8,9 @@
 #include "base/stl_util.h"
 #include "base/strings/string_util.h"
 #include "base/strings/stringprintf.h"
+#include "base/values.h"
 #include "net/base/net_errors.h"
+#include "net/base/net_util.h"
 #include "testing/gtest/include/gtest/gtest.h"
 
 namespace net {
@@ -296,6 +298,61 @@ TEST(HostCacheTest, Clear) {
   EXPECT_EQ(0u, cache.size());
 }
 
+TEST(HostCacheTest, SerializeAndRestore) {
+  const base::TimeDelta kTTL = base::TimeDelta::FromSeconds(60);
+  const base::TimeTicks now = base::TimeTicks::Now();
+
+  IPAddressNumber address;
+  ASSERT_TRUE(ParseIPLiteralToNumber("1.2.3.4", &address));
+  AddressList addrlist;
+  addrlist.push_back(IPEndPoint(address, 0));
+  addrlist.set_canonical_name("canonical.foobar1.com");
+
+  HostCache cache(kMaxCacheEntries);
+  cache.Set(Key("foobar1.com"), HostCache::Entry(OK, addrlist), now, kTTL);
+  cache.Set(HostCache::Key("foobar1.com", ADDRESS_FAMILY_IPV4, 0),
+            HostCache::Entry(OK, addrlist), now, kTTL);
+  // Expired and failed entries aren't kept.
+  cache.Set(Key("foobar2.com"), HostCache::Entry(OK, addrlist),
+            now - 2 * kTTL, kTTL);
+  cache.Set(Key("foobar3.com"),
+            HostCache::Entry(ERR_NAME_NOT_RESOLVED, AddressList()), now, kTTL);
+
+  base::ListValue entries;
+  cache.GetAsListValue(&entries);
+  EXPECT_EQ(2u, entries.GetSize());
+
+  // Entries already in the cache win.
+  HostCache restored_cache(kMaxCacheEntries);
+  restored_cache.Set(HostCache::Key("foobar1.com", ADDRESS_FAMILY_IPV4, 0),
+                     HostCache::Entry(OK, AddressList()), now, kTTL);
+  EXPECT_TRUE(restored_cache.RestoreFromListValue(entries));
+  EXPECT_EQ(2u, restored_cache.size());
+
+  const HostCache::Entry* entry =
+      restored_cache.Lookup(Key("foobar1.com"), now);
+  ASSERT_TRUE(entry);
+  EXPECT_EQ(OK, entry->error);
+  ASSERT_EQ(1u, entry->addrlist.size());
+  EXPECT_EQ(addrlist[0], entry->addrlist[0]);
+  EXPECT_EQ("canonical.foobar1.com", entry->addrlist.canonical_name());
+  entry = restored_cache.Lookup(
+      HostCache::Key("foobar1.com", ADDRESS_FAMILY_IPV4, 0), now);
+  ASSERT_TRUE(entry);
+  EXPECT_TRUE(entry->addrlist.empty());
+
+  // The restored entries expire when the original ones would have.
+  EXPECT_TRUE(restored_cache.Lookup(Key("foobar1.com"), now + kTTL / 2));
+  EXPECT_FALSE(restored_cache.Lookup(Key("foobar1.com"), now + 2 * kTTL));
+
+  // Malformed entries are skipped.
+  base::ListValue malformed;
+  malformed.AppendString("foobar4.com");
+  HostCache malformed_cache(kMaxCacheEntries);
+  EXPECT_FALSE(malformed_cache.RestoreFromListValue(malformed));
+  EXPECT_EQ(0u, malformed_cache.size());
+}
+
 // Tests the less than and equal operators for HostCache::Key work.
 TEST(HostCacheTest, KeyComparators) {
   struct {
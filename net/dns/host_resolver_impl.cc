@@ -69,6 +69,10 @@ const unsigned kNegativeCacheEntryTTLSeconds = 0;
 // Minimum TTL for successful resolutions with DnsTask.
 const unsigned kMinimumTTLSeconds = kCacheEntryTTLSeconds;
 
+// Maximum TTL for unsuccessful resolutions with DnsTask, whose TTL comes from
+// the SOA record of the negative answer.
+const unsigned kMaxNegativeTTLSeconds = 5 * 60;
+
 // We use a separate histogram name for each platform to facilitate the
 // display of error codes by their symbolic name (since each platform has
 // different mappings).
@@ -970,6 +974,8 @@ class HostResolverImpl::DnsTask : public base::SupportsWeakPtr<DnsTask> {
  public:
   class Delegate {
    public:
+    // On failure, |ttl| is how long the failure can be cached if the server
+    // said the name doesn't exist and for how long, and negative otherwise.
     virtual void OnDnsTaskComplete(base::TimeTicks start_time,
                                    int net_error,
                                    const AddressList& addr_list,
@@ -994,6 +1000,7 @@ class HostResolverImpl::DnsTask : public base::SupportsWeakPtr<DnsTask> {
         delegate_(delegate),
         net_log_(job_net_log),
         num_completed_transactions_(0),
+        num_negative_answers_(0),
         task_start_time_(base::TimeTicks::Now()) {
     DCHECK(client);
     DCHECK(delegate_);
@@ -1056,6 +1063,8 @@ class HostResolverImpl::DnsTask : public base::SupportsWeakPtr<DnsTask> {
     base::TimeDelta duration = base::TimeTicks::Now() - start_time;
     if (net_error != OK) {
       DNS_HISTOGRAM("AsyncDNS.TransactionFailure", duration);
+      if (net_error == ERR_NAME_NOT_RESOLVED)
+        RecordNegativeAnswer(response);
       OnFailure(net_error, DnsResponse::DNS_PARSE_OK);
       return;
     }
@@ -1082,6 +1091,9 @@ class HostResolverImpl::DnsTask : public base::SupportsWeakPtr<DnsTask> {
       return;
     }
 
+    if (addr_list.empty())
+      RecordNegativeAnswer(response);
+
     ++num_completed_transactions_;
     if (num_completed_transactions_ == 1) {
       ttl_ = ttl;
@@ -1151,13 +1163,26 @@ class HostResolverImpl::DnsTask : public base::SupportsWeakPtr<DnsTask> {
     OnSuccess(addr_list);
   }
 
+  // Folds the negative TTL of |response| (which may be NULL) into
+  // |negative_ttl_|, which stays unknown if any negative answer had none.
+  void RecordNegativeAnswer(const DnsResponse* response) {
+    base::TimeDelta ttl = base::TimeDelta::FromSeconds(-1);
+    if (response)
+      response->ParseNegativeTTL(&ttl);
+    if (num_negative_answers_++ == 0 || ttl < negative_ttl_)
+      negative_ttl_ = ttl;
+  }
+
   void OnFailure(int net_error, DnsResponse::Result result) {
     DCHECK_NE(OK, net_error);
     net_log_.EndEvent(
         NetLog::TYPE_HOST_RESOLVER_IMPL_DNS_TASK,
         base::Bind(&NetLogDnsTaskFailedCallback, net_error, result));
+    base::TimeDelta negative_ttl = base::TimeDelta::FromSeconds(-1);
+    if (net_error == ERR_NAME_NOT_RESOLVED && num_negative_answers_ > 0)
+      negative_ttl = negative_ttl_;
     delegate_->OnDnsTaskComplete(task_start_time_, net_error, AddressList(),
-                                 base::TimeDelta());
+                                 negative_ttl);
   }
 
   void OnSuccess(const AddressList& addr_list) {
@@ -1180,6 +1205,9 @@ class HostResolverImpl::DnsTask : public base::SupportsWeakPtr<DnsTask> {
 
   // These are updated as each transaction completes.
   base::TimeDelta ttl_;
+  // The TTL of the NXDOMAIN or NODATA answers, negative if unknown.
+  base::TimeDelta negative_ttl_;
+  unsigned num_negative_answers_;
   // IPv6 addresses must appear first in the list.
   AddressList addr_list_;
 
@@ -1207,6 +1235,7 @@ class HostResolverImpl::Job : public PrioritizedDispatcher::Job,
         had_dns_config_(false),
         num_occupied_job_slots_(0),
         dns_task_error_(OK),
+        dns_task_negative_ttl_(base::TimeDelta::FromSeconds(-1)),
         creation_time_(base::TimeTicks::Now()),
         priority_change_time_(creation_time_),
         net_log_(BoundNetLog::Make(request_net_log.net_log(),
@@ -1529,8 +1558,7 @@ class HostResolverImpl::Job : public PrioritizedDispatcher::Job,
       }
     }
 
-    base::TimeDelta ttl =
-        base::TimeDelta::FromSeconds(kNegativeCacheEntryTTLSeconds);
+    base::TimeDelta ttl = GetNegativeCacheEntryTTL(net_error);
     if (net_error == OK)
       ttl = base::TimeDelta::FromSeconds(kCacheEntryTTLSeconds);
 
@@ -1561,13 +1589,15 @@ class HostResolverImpl::Job : public PrioritizedDispatcher::Job,
   // so we use it as indicator whether Job is still valid.
   void OnDnsTaskFailure(const base::WeakPtr<DnsTask>& dns_task,
                         base::TimeDelta duration,
-                        int net_error) {
+                        int net_error,
+                        base::TimeDelta negative_ttl) {
     DNS_HISTOGRAM("AsyncDNS.ResolveFail", duration);
 
     if (dns_task == NULL)
       return;
 
     dns_task_error_ = net_error;
+    dns_task_negative_ttl_ = negative_ttl;
 
     // TODO(szym): Run ServeFromHosts now if nsswitch.conf says so.
     // http://crbug.com/117655
@@ -1579,8 +1609,23 @@ class HostResolverImpl::Job : public PrioritizedDispatcher::Job,
       StartProcTask();
     } else {
       UmaAsyncDnsResolveStatus(RESOLVE_STATUS_FAIL);
-      CompleteRequestsWithError(net_error);
+      CompleteRequests(HostCache::Entry(net_error, AddressList(),
+                                        dns_task_negative_ttl_),
+                       GetNegativeCacheEntryTTL(net_error));
+    }
+  }
+
+  // Returns how long to cache a failure with |net_error|. As long as the
+  // nameserver said, if the DnsTask got an authoritative negative answer and
+  // nothing else found the name.
+  base::TimeDelta GetNegativeCacheEntryTTL(int net_error) const {
+    if (net_error == ERR_NAME_NOT_RESOLVED &&
+        dns_task_error_ == ERR_NAME_NOT_RESOLVED &&
+        dns_task_negative_ttl_ >= base::TimeDelta()) {
+      return std::min(dns_task_negative_ttl_,
+                      base::TimeDelta::FromSeconds(kMaxNegativeTTLSeconds));
     }
+    return base::TimeDelta::FromSeconds(kNegativeCacheEntryTTLSeconds);
   }
 
 
@@ -1594,7 +1639,7 @@ class HostResolverImpl::Job : public PrioritizedDispatcher::Job,
 
     base::TimeDelta duration = base::TimeTicks::Now() - start_time;
     if (net_error != OK) {
-      OnDnsTaskFailure(dns_task_->AsWeakPtr(), duration, net_error);
+      OnDnsTaskFailure(dns_task_->AsWeakPtr(), duration, net_error, ttl);
       return;
     }
     DNS_HISTOGRAM("AsyncDNS.ResolveSuccess", duration);
@@ -1755,6 +1800,9 @@ class HostResolverImpl::Job : public PrioritizedDispatcher::Job,
 
   // Result of DnsTask.
   int dns_task_error_;
+  // The TTL of the negative answer that made the DnsTask fail, negative if
+  // unknown.
+  base::TimeDelta dns_task_negative_ttl_;
 
   const base::TimeTicks creation_time_;
   base::TimeTicks priority_change_time_;
@@ -1326,6 +1326,13 @@ class HostResolverImplDnsTest : public HostResolverImplTest {
     AddDnsRule("empty", dns_protocol::kTypeA, MockDnsClientRule::EMPTY, false);
     AddDnsRule("empty", dns_protocol::kTypeAAAA, MockDnsClientRule::EMPTY,
                false);
+    AddDnsRule("nodata", dns_protocol::kTypeA, MockDnsClientRule::NODATA,
+               false);
+    AddDnsRule("nodata", dns_protocol::kTypeAAAA, MockDnsClientRule::NODATA,
+               false);
+    AddDnsRule("6nodata", dns_protocol::kTypeA, MockDnsClientRule::OK, false);
+    AddDnsRule("6nodata", dns_protocol::kTypeAAAA, MockDnsClientRule::NODATA,
+               false);
 
     AddDnsRule("slow_nx", dns_protocol::kTypeA, MockDnsClientRule::FAIL, true);
     AddDnsRule("slow_nx", dns_protocol::kTypeAAAA, MockDnsClientRule::FAIL,
@@ -1954,6 +1961,61 @@ TEST_F(HostResolverImplDnsTest, UnspecEmptyFallback) {
   EXPECT_TRUE(requests_[0]->HasOneAddress("192.168.0.1", 80));
 }
 
+// Tests that a negative answer with an SOA record is cached for the negative
+// TTL, whether or not the DnsTask falls back to ProcTask.
+TEST_F(HostResolverImplDnsTest, NegativeAnswerTTL) {
+  ChangeDnsConfig(CreateValidDnsConfig());
+  // All hostnames will fail in proc_.
+  proc_->SignalMultiple(2u);
+
+  EXPECT_EQ(ERR_IO_PENDING, CreateRequest("nodata_fallback", 80)->Resolve());
+  EXPECT_EQ(ERR_IO_PENDING, CreateRequest("nx_fallback", 80)->Resolve());
+  EXPECT_EQ(ERR_NAME_NOT_RESOLVED, requests_[0]->WaitForResult());
+  EXPECT_EQ(ERR_NAME_NOT_RESOLVED, requests_[1]->WaitForResult());
+
+  set_fallback_to_proctask(false);
+  EXPECT_EQ(ERR_IO_PENDING, CreateRequest("nodata_nofallback", 80)->Resolve());
+  EXPECT_EQ(ERR_NAME_NOT_RESOLVED, requests_[2]->WaitForResult());
+
+  HostCache* cache = resolver_->GetHostCache();
+  base::TimeTicks now = base::TimeTicks::Now();
+  base::TimeDelta negative_ttl = base::TimeDelta::FromSeconds(kNoDataTTL);
+
+  HostCache::Key key("nodata_fallback", ADDRESS_FAMILY_UNSPECIFIED, 0);
+  const HostCache::Entry* entry = cache->Lookup(key, now);
+  ASSERT_TRUE(entry);
+  EXPECT_EQ(ERR_NAME_NOT_RESOLVED, entry->error);
+  EXPECT_FALSE(cache->Lookup(key, now + negative_ttl));
+
+  key.hostname = "nodata_nofallback";
+  entry = cache->Lookup(key, now);
+  ASSERT_TRUE(entry);
+  EXPECT_EQ(ERR_NAME_NOT_RESOLVED, entry->error);
+  EXPECT_EQ(negative_ttl, entry->ttl);
+  EXPECT_FALSE(cache->Lookup(key, now + negative_ttl));
+
+  // Without an SOA record, the failure isn't cached.
+  key.hostname = "nx_fallback";
+  EXPECT_FALSE(cache->Lookup(key, now));
+}
+
+// Tests that a NODATA answer for AAAA doesn't shorten the TTL of the A
+// records.
+TEST_F(HostResolverImplDnsTest, NoDataKeepsPositiveTTL) {
+  ChangeDnsConfig(CreateValidDnsConfig());
+  EXPECT_EQ(ERR_IO_PENDING, CreateRequest("6nodata_4ok", 80)->Resolve());
+  EXPECT_EQ(OK, requests_[0]->WaitForResult());
+  EXPECT_TRUE(requests_[0]->HasOneAddress("127.0.0.1", 80));
+
+  HostCache::Key key("6nodata_4ok", ADDRESS_FAMILY_UNSPECIFIED, 0);
+  const HostCache::Entry* entry =
+      resolver_->GetHostCache()->Lookup(key, base::TimeTicks::Now());
+  ASSERT_TRUE(entry);
+  EXPECT_EQ(OK, entry->error);
+  // MockDnsClient's A records last a day.
+  EXPECT_EQ(base::TimeDelta::FromDays(1), entry->ttl);
+}
+
 // Tests getting a new invalid DnsConfig while there are active DnsTasks.
 TEST_F(HostResolverImplDnsTest, InvalidDnsConfigWithPendingRequests) {
   // At most 3 jobs active at once.  This number is important, since we want to
@@ -392,7 +392,28 @@ void Filter::InitBuffer(int buffer_size) {
   stream_buffer_size_ = buffer_size;
 }
 
+bool Filter::IsPassThrough() const {
+  return false;
+}
+
 void Filter::PushDataIntoNextFilter() {
+  // Rather than copying pass-through data, swap the stream buffers: the next
+  // filter gets ours with the data in it, and our (empty) one is to be filled
+  // by our caller. This needs all of our data to be pending, as it is when the
+  // buffer was just flushed, and both buffers to have the same size.
+  if (IsPassThrough() && stream_data_len_ > 0 &&
+      next_stream_data_ == stream_buffer_->data() &&
+      !next_filter_->stream_data_len() &&
+      next_filter_->stream_buffer_size() == stream_buffer_size_) {
+    const int data_len = stream_data_len_;
+    next_stream_data_ = NULL;
+    stream_data_len_ = 0;
+    stream_buffer_.swap(next_filter_->stream_buffer_);
+    next_filter_->FlushStreamBuffer(data_len);
+    last_status_ = FILTER_NEED_MORE_DATA;
+    return;
+  }
+
   IOBuffer* next_buffer = next_filter_->stream_buffer();
   int next_size = next_filter_->stream_buffer_size();
   last_status_ = ReadFilteredData(next_buffer->data(), &next_size);
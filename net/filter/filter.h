@@ -218,6 +218,11 @@ class NET_EXPORT_PRIVATE Filter {
   // Copy pre-filter data directly to destination buffer without decoding.
   FilterStatus CopyOut(char* dest_buffer, int* dest_len);
 
+  // Returns true if ReadFilteredData() now only copies out its input, so that
+  // PushDataIntoNextFilter() can hand stream_buffer_ over to the next filter
+  // instead.
+  virtual bool IsPassThrough() const;
+
   FilterStatus last_status() const { return last_status_; }
 
   // Buffer to hold the data to be filtered (the input queue).
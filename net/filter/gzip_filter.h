@@ -51,6 +51,11 @@ class GZipFilter : public Filter {
   virtual FilterStatus ReadFilteredData(char* dest_buffer,
                                         int* dest_len) OVERRIDE;
 
+ protected:
+  // True once a body that was possibly gzipped when helping SDCH turned out
+  // not to be.
+  virtual bool IsPassThrough() const OVERRIDE;
+
  private:
   enum DecodingStatus {
     DECODING_UNINITIALIZED,
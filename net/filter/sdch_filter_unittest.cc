@@ -902,6 +902,40 @@ TEST_F(SdchFilterTest, FilterChaining) {
   EXPECT_EQ(output, expanded_);
 }
 
+// Test that when the gzip filter helping sdch finds that the content isn't
+// gzipped, its input buffers are handed to the sdch filter rather than copied.
+TEST_F(SdchFilterTest, GzipPassThroughHandsOverBuffers) {
+  const std::string kSampleDomain = "sdchtest.com";
+  std::string dictionary(NewSdchDictionary(kSampleDomain));
+
+  std::string url_string = "http://" + kSampleDomain;
+
+  GURL url(url_string);
+  EXPECT_TRUE(sdch_manager_->AddSdchDictionary(dictionary, url));
+
+  std::string sdch_compressed(NewSdchCompressedData(dictionary));
+
+  std::vector<Filter::FilterType> filter_types;
+  filter_types.push_back(Filter::FILTER_TYPE_SDCH);
+  filter_types.push_back(Filter::FILTER_TYPE_GZIP_HELPING_SDCH);
+
+  MockFilterContext filter_context;
+  filter_context.SetURL(url);
+  const size_t kBufferSize = 30;
+  CHECK_GT(sdch_compressed.size(), 2 * kBufferSize);
+  scoped_ptr<Filter> filter(
+      SdchFilterChainingTest::Factory(filter_types, filter_context,
+                                      kBufferSize));
+  const IOBuffer* first_buffer = filter->stream_buffer();
+
+  std::string output;
+  EXPECT_TRUE(FilterTestData(sdch_compressed, kBufferSize, kBufferSize,
+                             filter.get(), &output));
+  EXPECT_EQ(output, expanded_);
+  EXPECT_NE(first_buffer, filter->stream_buffer());
+  EXPECT_EQ(static_cast<int>(kBufferSize), filter->stream_buffer_size());
+}
+
 TEST_F(SdchFilterTest, DefaultGzipIfSdch) {
   // Construct a valid SDCH dictionary from a VCDIFF dictionary.
   const std::string kSampleDomain = "sdchtest.com";
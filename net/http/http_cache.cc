@@ -5,6 +5,7 @@
 #include "net/http/http_cache.h"
 
 #include <algorithm>
+#include <vector>
 
 #include "base/compiler_specific.h"
 
@@ -1020,15 +1021,35 @@ void HttpCache::OnProcessPendingQueue(ActiveEntry* entry) {
 
   // Promote next transaction from the pending queue.
   Transaction* next = entry->pending_queue.front();
-  if ((next->mode() & Transaction::WRITE) && !entry->readers.empty())
-    return;  // Have to wait.
+  if (next->mode() & Transaction::WRITE) {
+    if (!entry->readers.empty())
+      return;  // Have to wait.
 
-  entry->pending_queue.erase(entry->pending_queue.begin());
+    entry->pending_queue.erase(entry->pending_queue.begin());
 
-  int rv = AddTransactionToEntry(entry, next);
-  if (rv != ERR_IO_PENDING) {
-    next->io_callback().Run(rv);
+    int rv = AddTransactionToEntry(entry, next);
+    if (rv != ERR_IO_PENDING) {
+      next->io_callback().Run(rv);
+    }
+    return;
   }
+
+  // Readers don't need exclusive access, so all the readers at the front of
+  // the queue are promoted at once rather than one per task. A writer behind
+  // them waits for them to be done.
+  std::vector<CompletionCallback> callbacks;
+  while (!entry->pending_queue.empty() &&
+         !(entry->pending_queue.front()->mode() & Transaction::WRITE)) {
+    Transaction* reader = entry->pending_queue.front();
+    entry->pending_queue.pop_front();
+    entry->readers.push_back(reader);
+    callbacks.push_back(reader->io_callback());
+  }
+
+  // Any of the callbacks may destroy the other transactions, the entry or the
+  // cache, so only the copies of the (weakly bound) callbacks are used.
+  for (size_t i = 0; i < callbacks.size(); ++i)
+    callbacks[i].Run(OK);
 }
 
 void HttpCache::OnIOComplete(int result, PendingOp* pending_op) {
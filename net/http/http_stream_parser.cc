@@ -187,6 +187,8 @@ HttpStreamParser::HttpStreamParser(ClientSocketHandle* connection,
       connection_(connection),
       net_log_(net_log),
       sent_last_chunk_(false),
+      request_body_read_ahead_pending_(false),
+      request_body_read_ahead_result_(ERR_IO_PENDING),
       weak_ptr_factory_(this) {
   io_callback_ = base::Bind(&HttpStreamParser::OnIOComplete,
                             weak_ptr_factory_.GetWeakPtr());
@@ -452,6 +454,7 @@ int HttpStreamParser::DoSendBody(int result) {
   // Send the remaining data in the request body buffer.
   request_body_send_buf_->DidConsume(result);
   if (request_body_send_buf_->BytesRemaining() > 0) {
+    MaybeStartRequestBodyReadAhead();
     return connection_->socket()
         ->Write(request_body_send_buf_.get(),
                 request_body_send_buf_->BytesRemaining(),
@@ -463,8 +466,14 @@ int HttpStreamParser::DoSendBody(int result) {
     return OK;
   }
 
-  request_body_read_buf_->Clear();
   io_state_ = STATE_SEND_REQUEST_READING_BODY;
+  // OnRequestBodyReadAheadComplete() resumes the loop.
+  if (request_body_read_ahead_pending_)
+    return ERR_IO_PENDING;
+  if (request_body_read_ahead_result_ != ERR_IO_PENDING)
+    return UseRequestBodyReadAhead();
+
+  request_body_read_buf_->Clear();
   return request_->upload_data_stream->Read(request_body_read_buf_.get(),
                                             request_body_read_buf_->capacity(),
                                             io_callback_);
@@ -503,6 +512,53 @@ int HttpStreamParser::DoSendRequestReadingBody(int result) {
   return result;
 }
 
+void HttpStreamParser::MaybeStartRequestBodyReadAhead() {
+  // Reading in-memory data takes no time, and chunks have to be encoded as
+  // they're read.
+  UploadDataStream* upload_data_stream = request_->upload_data_stream;
+  if (request_body_read_ahead_pending_ ||
+      request_body_read_ahead_result_ != ERR_IO_PENDING ||
+      upload_data_stream->is_chunked() || upload_data_stream->IsEOF() ||
+      upload_data_stream->IsInMemory()) {
+    return;
+  }
+
+  if (!request_body_read_ahead_buf_.get()) {
+    request_body_read_ahead_buf_ =
+        new SeekableIOBuffer(kRequestBodyBufferSize);
+  }
+  request_body_read_ahead_buf_->Clear();
+  int result = upload_data_stream->Read(
+      request_body_read_ahead_buf_.get(),
+      request_body_read_ahead_buf_->capacity(),
+      base::Bind(&HttpStreamParser::OnRequestBodyReadAheadComplete,
+                 weak_ptr_factory_.GetWeakPtr()));
+  if (result == ERR_IO_PENDING)
+    request_body_read_ahead_pending_ = true;
+  else
+    request_body_read_ahead_result_ = result;
+}
+
+void HttpStreamParser::OnRequestBodyReadAheadComplete(int result) {
+  DCHECK(request_body_read_ahead_pending_);
+  request_body_read_ahead_pending_ = false;
+  request_body_read_ahead_result_ = result;
+
+  // Otherwise the socket write is still in progress, and DoSendBody() will
+  // pick up the data.
+  if (io_state_ == STATE_SEND_REQUEST_READING_BODY)
+    OnIOComplete(UseRequestBodyReadAhead());
+}
+
+int HttpStreamParser::UseRequestBodyReadAhead() {
+  DCHECK_NE(ERR_IO_PENDING, request_body_read_ahead_result_);
+  int result = request_body_read_ahead_result_;
+  request_body_read_ahead_result_ = ERR_IO_PENDING;
+  request_body_send_buf_.swap(request_body_read_ahead_buf_);
+  request_body_read_buf_ = request_body_send_buf_;
+  return result;
+}
+
 int HttpStreamParser::DoReadHeaders() {
   io_state_ = STATE_READ_HEADERS_COMPLETE;
 
@@ -149,6 +149,14 @@ class NET_EXPORT_PRIVATE HttpStreamParser {
   int DoSendHeaders(int result);
   int DoSendBody(int result);
   int DoSendRequestReadingBody(int result);
+
+  // Starts reading the next part of the request body ahead of its send, if
+  // the body comes from files.
+  void MaybeStartRequestBodyReadAhead();
+  void OnRequestBodyReadAheadComplete(int result);
+  // Makes the read-ahead buffer the one to send, and returns the result of the
+  // read.
+  int UseRequestBodyReadAhead();
   int DoReadHeaders();
   int DoReadHeadersComplete(int result);
   int DoReadBody();
@@ -235,6 +243,15 @@ class NET_EXPORT_PRIVATE HttpStreamParser {
   scoped_refptr<SeekableIOBuffer> request_body_send_buf_;
   bool sent_last_chunk_;
 
+  // Buffer into which the next part of a request body that isn't in memory is
+  // read while |request_body_send_buf_| is being written to the socket.
+  scoped_refptr<SeekableIOBuffer> request_body_read_ahead_buf_;
+  // True while a read into |request_body_read_ahead_buf_| is in progress.
+  bool request_body_read_ahead_pending_;
+  // The result of the last read into |request_body_read_ahead_buf_|, or
+  // ERR_IO_PENDING if there is none to use.
+  int request_body_read_ahead_result_;
+
   base::WeakPtrFactory<HttpStreamParser> weak_ptr_factory_;
 
   DISALLOW_COPY_AND_ASSIGN(HttpStreamParser);
@@ -322,6 +322,84 @@ TEST(HttpStreamParser, AsyncChunkAndAsyncSocket) {
   ASSERT_EQ(kBodySize, rv);
 }
 
+// Test that a file body larger than the send buffer, which is read ahead of
+// the socket writes, is sent in order when the writes are asynchronous and
+// partial.
+TEST(HttpStreamParser, AsyncFileBodyAndAsyncSocket) {
+  std::string body;
+  for (int i = 0; body.size() < 40000; ++i)
+    body += base::StringPrintf("%d,", i);
+
+  base::ScopedTempDir temp_dir;
+  ASSERT_TRUE(temp_dir.CreateUniqueTempDir());
+  base::FilePath temp_file_path;
+  ASSERT_TRUE(base::CreateTemporaryFileInDir(temp_dir.path(),
+                                             &temp_file_path));
+  ASSERT_EQ(static_cast<int>(body.size()),
+            file_util::WriteFile(temp_file_path, body.data(), body.size()));
+
+  {
+    ScopedVector<UploadElementReader> element_readers;
+    element_readers.push_back(
+        new UploadFileElementReader(base::MessageLoopProxy::current().get(),
+                                    temp_file_path,
+                                    0,
+                                    kuint64max,
+                                    base::Time()));
+    UploadDataStream upload_stream(element_readers.Pass(), 0);
+    TestCompletionCallback callback;
+    ASSERT_EQ(ERR_IO_PENDING, upload_stream.Init(callback.callback()));
+    ASSERT_EQ(OK, callback.WaitForResult());
+
+    const std::string content_length = base::StringPrintf(
+        "%d", static_cast<int>(body.size()));
+    const std::string headers =
+        "POST / HTTP/1.1\r\nContent-Length: " + content_length + "\r\n\r\n";
+    std::vector<MockWrite> writes;
+    writes.push_back(MockWrite(ASYNC, headers.data(), headers.size()));
+    // Each buffer of the body takes several partial writes.
+    const size_t kWriteSize = 4096;
+    for (size_t offset = 0; offset < body.size(); offset += kWriteSize) {
+      writes.push_back(MockWrite(
+          ASYNC, body.data() + offset,
+          std::min(kWriteSize, body.size() - offset)));
+    }
+    MockRead reads[] = {
+      MockRead(SYNCHRONOUS, "HTTP/1.1 200 OK\r\nContent-Length: 0\r\n\r\n"),
+    };
+    StaticSocketDataProvider data(reads, arraysize(reads),
+                                  &writes[0], writes.size());
+    data.set_connect_data(MockConnect(SYNCHRONOUS, OK));
+    scoped_ptr<MockTCPClientSocket> transport(
+        new MockTCPClientSocket(AddressList(), NULL, &data));
+    ASSERT_EQ(OK, transport->Connect(callback.callback()));
+
+    ClientSocketHandle socket_handle;
+    socket_handle.SetSocket(transport.PassAs<StreamSocket>());
+
+    HttpRequestInfo request_info;
+    request_info.method = "POST";
+    request_info.url = GURL("http://localhost");
+    request_info.load_flags = LOAD_NORMAL;
+    request_info.upload_data_stream = &upload_stream;
+
+    scoped_refptr<GrowableIOBuffer> read_buffer(new GrowableIOBuffer);
+    HttpStreamParser parser(
+        &socket_handle, &request_info, read_buffer.get(), BoundNetLog());
+
+    HttpRequestHeaders request_headers;
+    request_headers.SetHeader("Content-Length", content_length);
+    HttpResponseInfo response_info;
+    int rv = parser.SendRequest("POST / HTTP/1.1\r\n", request_headers,
+                                &response_info, callback.callback());
+    EXPECT_EQ(OK, callback.GetResult(rv));
+    EXPECT_TRUE(data.at_write_eof());
+    EXPECT_TRUE(upload_stream.IsEOF());
+  }
+  // UploadFileElementReaders may post clean-up tasks on destruction.
+  base::RunLoop().RunUntilIdle();
+}
+
 TEST(HttpStreamParser, TruncatedHeaders) {
   MockRead truncated_status_reads[] = {
     MockRead(SYNCHRONOUS, 1, "HTTP/1.1 20"),
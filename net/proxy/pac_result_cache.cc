@@ -0,0 +1,106 @@
+// Copyright 2014 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "net/proxy/pac_result_cache.h"
+
+#include "base/logging.h"
+#include "net/proxy/proxy_server.h"
+#include "url/gurl.h"
+
+namespace net {
+
+// static
+const int PacResultCache::kHostOnlyObservations = 3;
+
+PacResultCache::OriginEntry::OriginEntry(const std::string& url_spec,
+                                         const ProxyList& result)
+    : url_spec(url_spec),
+      result(result) {
+}
+
+PacResultCache::OriginEntry::~OriginEntry() {
+}
+
+PacResultCache::PacResultCache(size_t max_entries, base::TimeDelta ttl)
+    : ttl_(ttl),
+      url_entries_(max_entries),
+      origin_entries_(max_entries),
+      behavior_(BEHAVIOR_UNKNOWN),
+      agreeing_results_(0) {
+}
+
+PacResultCache::~PacResultCache() {
+}
+
+bool PacResultCache::Lookup(const GURL& url,
+                            base::TimeTicks now,
+                            ProxyList* result) {
+  DCHECK(CalledOnValidThread());
+  const ProxyList* url_result = url_entries_.Get(url.spec(), now);
+  if (url_result) {
+    *result = *url_result;
+    return true;
+  }
+
+  if (behavior_ != BEHAVIOR_HOST_ONLY)
+    return false;
+  const OriginEntry* origin_entry =
+      origin_entries_.Get(url.GetOrigin().spec(), now);
+  if (!origin_entry)
+    return false;
+  *result = origin_entry->result;
+  return true;
+}
+
+void PacResultCache::Store(const GURL& url,
+                           const ProxyList& result,
+                           base::TimeTicks now) {
+  DCHECK(CalledOnValidThread());
+  url_entries_.Put(url.spec(), result, now, now + ttl_);
+  ObserveResult(url, result, now);
+}
+
+void PacResultCache::Clear() {
+  DCHECK(CalledOnValidThread());
+  url_entries_.Clear();
+  origin_entries_.Clear();
+  behavior_ = BEHAVIOR_UNKNOWN;
+  agreeing_results_ = 0;
+}
+
+void PacResultCache::ObserveResult(const GURL& url,
+                                   const ProxyList& result,
+                                   base::TimeTicks now) {
+  if (behavior_ == BEHAVIOR_URL_DEPENDENT)
+    return;
+
+  std::string origin = url.GetOrigin().spec();
+  const OriginEntry* origin_entry = origin_entries_.Get(origin, now);
+  if (!origin_entry) {
+    origin_entries_.Put(origin, OriginEntry(url.spec(), result), now,
+                        now + ttl_);
+    return;
+  }
+
+  // Only the results for other URLs of the origin tell something about the
+  // script.
+  if (origin_entry->url_spec == url.spec())
+    return;
+
+  if (!origin_entry->result.Equals(result)) {
+    DVLOG(1) << "PAC script results depend on more than the host of "
+             << url.possibly_invalid_spec();
+    behavior_ = BEHAVIOR_URL_DEPENDENT;
+    origin_entries_.Clear();
+    return;
+  }
+
+  if (behavior_ == BEHAVIOR_UNKNOWN &&
+      ++agreeing_results_ >= kHostOnlyObservations) {
+    DVLOG(1) << "PAC script results depend only on the host";
+    behavior_ = BEHAVIOR_HOST_ONLY;
+  }
+}
+
+}  // namespace net
@@ -0,0 +1,101 @@
+// Copyright 2014 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef NET_PROXY_PAC_RESULT_CACHE_H_
+#define NET_PROXY_PAC_RESULT_CACHE_H_
+
+#include <functional>
+#include <string>
+
+#include "base/basictypes.h"
+#include "base/threading/non_thread_safe.h"
+#include "base/time/time.h"
+#include "net/base/expiring_cache.h"
+#include "net/base/net_export.h"
+#include "net/proxy/proxy_list.h"
+
+class GURL;
+
+namespace net {
+
+// Cache of the results of a PAC script, used by ProxyService to avoid running
+// FindProxyForURL() again for the URLs it was just run for.
+//
+// Results are cached per URL. Most PAC scripts however only look at the host
+// of the URL, so the cache also watches the results for different URLs of the
+// same origin: once enough of them agreed, and none ever disagreed, the
+// script is deemed host-only and the results are shared by all the URLs of an
+// origin. A single disagreement makes the script URL-dependent until Clear().
+//
+// The entries expire after |ttl|, since scripts may depend on the time or on
+// DNS results, and the whole cache must be cleared when the script changes.
+class NET_EXPORT_PRIVATE PacResultCache
+    : NON_EXPORTED_BASE(public base::NonThreadSafe) {
+ public:
+  // The number of agreeing results for different URLs of an origin after
+  // which the script is deemed host-only.
+  static const int kHostOnlyObservations;
+
+  PacResultCache(size_t max_entries, base::TimeDelta ttl);
+  ~PacResultCache();
+
+  // Sets |result| to the cached result for |url|, if there is one valid at
+  // |now|. Returns false otherwise.
+  bool Lookup(const GURL& url, base::TimeTicks now, ProxyList* result);
+
+  // Caches |result|, which the PAC script returned for |url| at |now|.
+  void Store(const GURL& url, const ProxyList& result, base::TimeTicks now);
+
+  // Empties the cache, and forgets what was learned about the script.
+  void Clear();
+
+  bool is_host_only() const { return behavior_ == BEHAVIOR_HOST_ONLY; }
+
+  size_t size() const { return url_entries_.size(); }
+
+ private:
+  enum Behavior {
+    BEHAVIOR_UNKNOWN,
+    BEHAVIOR_HOST_ONLY,
+    BEHAVIOR_URL_DEPENDENT,
+  };
+
+  // The result of an origin, with the URL it was first returned for.
+  struct OriginEntry {
+    OriginEntry(const std::string& url_spec, const ProxyList& result);
+    ~OriginEntry();
+
+    std::string url_spec;
+    ProxyList result;
+  };
+
+  typedef ExpiringCache<std::string, ProxyList, base::TimeTicks,
+                        std::less<base::TimeTicks> > UrlEntryMap;
+  typedef ExpiringCache<std::string, OriginEntry, base::TimeTicks,
+                        std::less<base::TimeTicks> > OriginEntryMap;
+
+  // Updates |behavior_| and |origin_entries_| with |result|.
+  void ObserveResult(const GURL& url,
+                     const ProxyList& result,
+                     base::TimeTicks now);
+
+  const base::TimeDelta ttl_;
+
+  // Keyed by URL spec.
+  UrlEntryMap url_entries_;
+
+  // Keyed by origin spec.
+  OriginEntryMap origin_entries_;
+
+  Behavior behavior_;
+
+  // The number of agreeing results seen while |behavior_| is unknown.
+  int agreeing_results_;
+
+  DISALLOW_COPY_AND_ASSIGN(PacResultCache);
+};
+
+}  // namespace net
+
+#endif  // NET_PROXY_PAC_RESULT_CACHE_H_
@@ -0,0 +1,107 @@
+// Copyright 2014 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "net/proxy/pac_result_cache.h"
+
+#include "net/proxy/proxy_server.h"
+#include "testing/gtest/include/gtest/gtest.h"
+#include "url/gurl.h"
+
+namespace net {
+
+namespace {
+
+const size_t kMaxEntries = 10;
+
+ProxyList MakeProxyList(const std::string& pac_string) {
+  ProxyList list;
+  list.SetFromPacString(pac_string);
+  return list;
+}
+
+// Stores |pac_string| for |url| in |cache|.
+void Store(PacResultCache* cache,
+           const std::string& url,
+           const std::string& pac_string,
+           base::TimeTicks now) {
+  cache->Store(GURL(url), MakeProxyList(pac_string), now);
+}
+
+// Returns the cached PAC string for |url|, or "none".
+std::string Lookup(PacResultCache* cache,
+                   const std::string& url,
+                   base::TimeTicks now) {
+  ProxyList list;
+  if (!cache->Lookup(GURL(url), now, &list))
+    return "none";
+  return list.ToPacString();
+}
+
+}  // namespace
+
+TEST(PacResultCacheTest, CachesPerURL) {
+  PacResultCache cache(kMaxEntries, base::TimeDelta::FromMinutes(1));
+  base::TimeTicks now = base::TimeTicks::Now();
+
+  EXPECT_EQ("none", Lookup(&cache, "http://a.com/1", now));
+  Store(&cache, "http://a.com/1", "PROXY foo:80", now);
+  EXPECT_EQ("PROXY foo:80", Lookup(&cache, "http://a.com/1", now));
+  EXPECT_EQ("none", Lookup(&cache, "http://a.com/2", now));
+  EXPECT_EQ("none", Lookup(&cache, "https://a.com/1", now));
+  EXPECT_FALSE(cache.is_host_only());
+}
+
+TEST(PacResultCacheTest, Expires) {
+  PacResultCache cache(kMaxEntries, base::TimeDelta::FromMinutes(1));
+  base::TimeTicks now = base::TimeTicks::Now();
+
+  Store(&cache, "http://a.com/", "PROXY foo:80", now);
+  now += base::TimeDelta::FromSeconds(59);
+  EXPECT_EQ("PROXY foo:80", Lookup(&cache, "http://a.com/", now));
+  now += base::TimeDelta::FromSeconds(1);
+  EXPECT_EQ("none", Lookup(&cache, "http://a.com/", now));
+  EXPECT_EQ(0u, cache.size());
+}
+
+TEST(PacResultCacheTest, DetectsHostOnlyScript) {
+  PacResultCache cache(kMaxEntries, base::TimeDelta::FromMinutes(1));
+  base::TimeTicks now = base::TimeTicks::Now();
+
+  Store(&cache, "http://a.com/0", "PROXY foo:80", now);
+  // Storing the same URL again tells nothing about the script.
+  Store(&cache, "http://a.com/0", "PROXY foo:80", now);
+  for (int i = 1; i < PacResultCache::kHostOnlyObservations; ++i) {
+    Store(&cache, "http://a.com/" + std::string(1, '0' + i), "PROXY foo:80",
+          now);
+    EXPECT_FALSE(cache.is_host_only());
+  }
+  Store(&cache, "http://a.com/x", "PROXY foo:80", now);
+  EXPECT_TRUE(cache.is_host_only());
+
+  // The other URLs of the origin now share its result.
+  EXPECT_EQ("PROXY foo:80", Lookup(&cache, "http://a.com/y?q", now));
+  EXPECT_EQ("none", Lookup(&cache, "http://a.com:8080/", now));
+  EXPECT_EQ("none", Lookup(&cache, "http://b.com/", now));
+
+  cache.Clear();
+  EXPECT_FALSE(cache.is_host_only());
+  EXPECT_EQ("none", Lookup(&cache, "http://a.com/0", now));
+}
+
+TEST(PacResultCacheTest, DetectsURLDependentScript) {
+  PacResultCache cache(kMaxEntries, base::TimeDelta::FromMinutes(1));
+  base::TimeTicks now = base::TimeTicks::Now();
+
+  Store(&cache, "http://a.com/0", "PROXY foo:80", now);
+  Store(&cache, "http://a.com/1", "DIRECT", now);
+  for (int i = 0; i < PacResultCache::kHostOnlyObservations + 1; ++i) {
+    Store(&cache, "http://b.com/" + std::string(1, '0' + i), "PROXY foo:80",
+          now);
+  }
+  EXPECT_FALSE(cache.is_host_only());
+  EXPECT_EQ("PROXY foo:80", Lookup(&cache, "http://b.com/0", now));
+  EXPECT_EQ("none", Lookup(&cache, "http://b.com/9", now));
+}
+
+}  // namespace net
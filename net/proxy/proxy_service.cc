@@ -23,6 +23,7 @@
 #include "net/proxy/dhcp_proxy_script_fetcher.h"
 #include "net/proxy/multi_threaded_proxy_resolver.h"
 #include "net/proxy/network_delegate_error_observer.h"
+#include "net/proxy/pac_result_cache.h"
 #include "net/proxy/proxy_config_service_fixed.h"
 #include "net/proxy/proxy_resolver.h"
 #include "net/proxy/proxy_script_decider.h"
@@ -76,6 +77,11 @@ namespace {
 // sorts of problems.
 const int64 kDelayAfterNetworkChangesMs = 2000;
 
+// The PAC script results are cached as long as host resolutions, since
+// scripts commonly base their decisions on dnsResolve().
+const size_t kMaxPacResultCacheEntries = 1000;
+const int kPacResultCacheTTLSeconds = 60;
+
 // This is the default policy for polling the PAC script.
 //
 // In response to a failure, the poll intervals are:
@@ -746,6 +752,7 @@ class ProxyService::PacRequest
         resolve_job_(NULL),
         config_id_(ProxyConfig::kInvalidConfigID),
         config_source_(PROXY_CONFIG_SOURCE_UNKNOWN),
+        used_cached_result_(false),
         net_log_(net_log) {
     DCHECK(!user_callback.is_null());
   }
@@ -761,6 +768,16 @@ class ProxyService::PacRequest
     config_source_ = service_->config_.source();
     proxy_resolve_start_time_ = TimeTicks::Now();
 
+    PacResultCache* cache = service_->pac_result_cache_.get();
+    if (cache) {
+      ProxyList cached_result;
+      if (cache->Lookup(url_, proxy_resolve_start_time_, &cached_result)) {
+        results_->UseProxyList(cached_result);
+        used_cached_result_ = true;
+        return OK;
+      }
+    }
+
     return resolver()->GetProxyForURL(
         url_, results_,
         base::Bind(&PacRequest::QueryComplete, base::Unretained(this)),
@@ -812,6 +829,14 @@ class ProxyService::PacRequest
   int QueryDidComplete(int result_code) {
     DCHECK(!was_cancelled());
 
+    // Cache what the resolver returned, before it is fixed up. Results of a
+    // previous configuration were cleared along with the cache.
+    PacResultCache* cache = service_->pac_result_cache_.get();
+    if (cache && result_code == OK && !used_cached_result_ &&
+        config_id_ == service_->config_.id()) {
+      cache->Store(url_, results_->proxy_list_, proxy_resolve_start_time_);
+    }
+
     // Note that DidFinishResolvingProxy might modify |results_|.
     int rv = service_->DidFinishResolvingProxy(results_, result_code, net_log_);
 
@@ -827,6 +852,7 @@ class ProxyService::PacRequest
     resolve_job_ = NULL;
     config_id_ = ProxyConfig::kInvalidConfigID;
     config_source_ = PROXY_CONFIG_SOURCE_UNKNOWN;
+    used_cached_result_ = false;
 
     return rv;
   }
@@ -869,6 +895,7 @@ class ProxyService::PacRequest
   ProxyResolver::RequestHandle resolve_job_;
   ProxyConfig::ID config_id_;  // The config id when the resolve was started.
   ProxyConfigSource config_source_;  // The source of proxy settings.
+  bool used_cached_result_;  // Whether Start() used the PacResultCache.
   BoundNetLog net_log_;
   // Time when the PAC is started.  Cached here since resetting ProxyInfo also
   // clears the proxy times.
@@ -1317,12 +1344,25 @@ ProxyScriptFetcher* ProxyService::GetProxyScriptFetcher() const {
   return proxy_script_fetcher_.get();
 }
 
+void ProxyService::set_pac_result_cache_enabled(bool value) {
+  DCHECK(CalledOnValidThread());
+  if (!value) {
+    pac_result_cache_.reset();
+  } else if (!pac_result_cache_) {
+    pac_result_cache_.reset(new PacResultCache(
+        kMaxPacResultCacheEntries,
+        TimeDelta::FromSeconds(kPacResultCacheTTLSeconds)));
+  }
+}
+
 ProxyService::State ProxyService::ResetProxyConfig(bool reset_fetched_config) {
   DCHECK(CalledOnValidThread());
   State previous_state = current_state_;
 
   permanent_error_ = OK;
   proxy_retry_info_.clear();
+  if (pac_result_cache_)
+    pac_result_cache_->Clear();
   script_poller_.reset();
   init_proxy_resolver_.reset();
   SuspendAllPendingRequests();
@@ -35,6 +35,7 @@ namespace net {
 class DhcpProxyScriptFetcher;
 class HostResolver;
 class NetworkDelegate;
+class PacResultCache;
 class ProxyResolver;
 class ProxyResolverScriptData;
 class ProxyScriptDecider;
@@ -269,6 +270,14 @@ class NET_EXPORT ProxyService : public NetworkChangeNotifier::IPAddressObserver,
 
   bool quick_check_enabled() const { return quick_check_enabled_; }
 
+  // Enables caching the results of the PAC script, to not run it again for
+  // the URLs, or for scripts that only look at the host, the origins it was
+  // run for in the last minute. The cache is cleared whenever the proxy
+  // configuration is reset.
+  void set_pac_result_cache_enabled(bool value);
+
+  bool pac_result_cache_enabled() const { return !!pac_result_cache_; }
+
 #if defined(SPDY_PROXY_AUTH_ORIGIN)
   // Values of the UMA DataReductionProxy.BypassInfo{Primary|Fallback}
   // histograms. This enum must remain synchronized with the enum of the same
@@ -447,6 +456,9 @@ class NET_EXPORT ProxyService : public NetworkChangeNotifier::IPAddressObserver,
   // Whether child ProxyScriptDeciders should use QuickCheck
   bool quick_check_enabled_;
 
+  // The results of the PAC script. NULL unless enabled.
+  scoped_ptr<PacResultCache> pac_result_cache_;
+
   DISALLOW_COPY_AND_ASSIGN(ProxyService);
 };
 
@@ -246,6 +246,72 @@ TEST_F(ProxyServiceTest, PAC) {
 
 // Test that the proxy resolver does not see the URL's username/password
 // or its reference section.
+// Test that the results of the PAC script are reused when the result cache is
+// enabled, until the configuration changes.
+TEST_F(ProxyServiceTest, PAC_ResultCache) {
+  MockProxyConfigService* config_service =
+      new MockProxyConfigService("http://foopy/proxy.pac");
+
+  MockAsyncProxyResolver* resolver = new MockAsyncProxyResolver;
+
+  ProxyService service(config_service, resolver, NULL);
+  service.set_pac_result_cache_enabled(true);
+
+  GURL url("http://www.google.com/");
+
+  ProxyInfo info1;
+  TestCompletionCallback callback1;
+  int rv = service.ResolveProxy(
+      url, &info1, callback1.callback(), NULL, BoundNetLog());
+  EXPECT_EQ(ERR_IO_PENDING, rv);
+
+  resolver->pending_set_pac_script_request()->CompleteNow(OK);
+
+  ASSERT_EQ(1u, resolver->pending_requests().size());
+  resolver->pending_requests()[0]->results()->UseNamedProxy("foopy");
+  resolver->pending_requests()[0]->CompleteNow(OK);
+  EXPECT_EQ(OK, callback1.WaitForResult());
+  EXPECT_EQ("foopy:80", info1.proxy_server().ToURI());
+
+  // The same URL is resolved without the resolver.
+  ProxyInfo info2;
+  TestCompletionCallback callback2;
+  rv = service.ResolveProxy(
+      url, &info2, callback2.callback(), NULL, BoundNetLog());
+  EXPECT_EQ(OK, rv);
+  EXPECT_TRUE(resolver->pending_requests().empty());
+  EXPECT_EQ("foopy:80", info2.proxy_server().ToURI());
+  EXPECT_TRUE(info2.did_use_pac_script());
+  EXPECT_EQ(info1.config_id(), info2.config_id());
+
+  // Other URLs still go to the resolver.
+  ProxyInfo info3;
+  TestCompletionCallback callback3;
+  rv = service.ResolveProxy(GURL("http://www.google.com/other"), &info3,
+                            callback3.callback(), NULL, BoundNetLog());
+  EXPECT_EQ(ERR_IO_PENDING, rv);
+  ASSERT_EQ(1u, resolver->pending_requests().size());
+  resolver->pending_requests()[0]->results()->UseNamedProxy("foopy2");
+  resolver->pending_requests()[0]->CompleteNow(OK);
+  EXPECT_EQ(OK, callback3.WaitForResult());
+  EXPECT_EQ("foopy2:80", info3.proxy_server().ToURI());
+
+  // A new configuration clears the cache.
+  config_service->SetConfig(
+      ProxyConfig::CreateFromCustomPacURL(GURL("http://foopy/proxy2.pac")));
+  ProxyInfo info4;
+  TestCompletionCallback callback4;
+  rv = service.ResolveProxy(
+      url, &info4, callback4.callback(), NULL, BoundNetLog());
+  EXPECT_EQ(ERR_IO_PENDING, rv);
+  resolver->pending_set_pac_script_request()->CompleteNow(OK);
+  ASSERT_EQ(1u, resolver->pending_requests().size());
+  resolver->pending_requests()[0]->results()->UseNamedProxy("foopy3");
+  resolver->pending_requests()[0]->CompleteNow(OK);
+  EXPECT_EQ(OK, callback4.WaitForResult());
+  EXPECT_EQ("foopy3:80", info4.proxy_server().ToURI());
+}
+
 TEST_F(ProxyServiceTest, PAC_NoIdentityOrHash) {
   MockProxyConfigService* config_service =
       new MockProxyConfigService("http://foopy/proxy.pac");
@@ -0,0 +1,398 @@
+// Copyright 2014 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "net/quic/congestion_control/bbr_sender.h"
+
+#include <algorithm>
+
+#include "base/logging.h"
+#include "net/quic/congestion_control/tcp_cubic_sender.h"
+#include "net/quic/quic_clock.h"
+#include "net/quic/quic_config.h"
+
+using std::max;
+using std::min;
+
+namespace net {
+
+namespace {
+const QuicByteCount kMaxSegmentSize = kDefaultTCPMSS;
+const QuicByteCount kInitialCongestionWindow = 10 * kMaxSegmentSize;
+// Enough to keep acks coming back while in PROBE_RTT.
+const QuicByteCount kMinimumCongestionWindow = 4 * kMaxSegmentSize;
+// 2/ln(2), the smallest gain that doubles the sending rate every round trip.
+const float kStartupGain = 2.885f;
+// Keeps two bandwidth-delay products in flight, which covers delayed and
+// aggregated acks.
+const float kCongestionWindowGain = 2.0f;
+// The pacing gains of the PROBE_BW phases, each of which lasts about a
+// minimum RTT: probe for more bandwidth, drain the queue that built, and
+// cruise at the estimated bandwidth.
+const float kPacingGainCycle[] = { 1.25f, 0.75f, 1, 1, 1, 1, 1, 1 };
+const int kGainCycleLength = arraysize(kPacingGainCycle);
+// STARTUP ends after this many round trips without the bandwidth growing by
+// kStartupGrowthTarget.
+const int kRoundTripsWithoutGrowthBeforeExitingStartup = 3;
+const float kStartupGrowthTarget = 1.25f;
+const int64 kMinRttExpirySeconds = 10;
+const int64 kProbeRttTimeMs = 200;
+// Sending a packet a little early is cheaper than waking up for it.
+const int64 kAlarmGranularityMs = 1;
+// Constants used for RTT calculation.
+const int kInitialRttMs = 100;  // At a typical RTT 100 ms.
+const float kAlpha = 0.125f;
+const float kOneMinusAlpha = (1 - kAlpha);
+const float kBeta = 0.25f;
+const float kOneMinusBeta = (1 - kBeta);
+}  // namespace
+
+BbrSender::SentPacket::SentPacket(QuicByteCount bytes,
+                                  QuicTime sent_time,
+                                  QuicTime first_sent_time,
+                                  QuicByteCount delivered,
+                                  QuicTime delivered_time)
+    : bytes(bytes),
+      sent_time(sent_time),
+      first_sent_time(first_sent_time),
+      delivered(delivered),
+      delivered_time(delivered_time) {
+}
+
+BbrSender::BbrSender(const QuicClock* clock)
+    : clock_(clock),
+      mode_(STARTUP),
+      pacing_gain_(kStartupGain),
+      congestion_window_gain_(kStartupGain),
+      initial_congestion_window_(kInitialCongestionWindow),
+      bytes_in_flight_(0),
+      delivered_(0),
+      delivered_time_(QuicTime::Zero()),
+      last_acked_packet_sent_time_(QuicTime::Zero()),
+      round_count_(0),
+      next_round_delivered_(0),
+      round_max_bandwidth_(kBandwidthWindowRounds, QuicBandwidth::Zero()),
+      full_bandwidth_(QuicBandwidth::Zero()),
+      rounds_without_bandwidth_growth_(0),
+      found_full_bandwidth_(false),
+      cycle_index_(0),
+      cycle_start_(QuicTime::Zero()),
+      probe_rtt_done_time_(QuicTime::Zero()),
+      min_rtt_(QuicTime::Delta::Zero()),
+      min_rtt_timestamp_(QuicTime::Zero()),
+      min_rtt_expired_(false),
+      smoothed_rtt_(QuicTime::Delta::Zero()),
+      mean_deviation_(QuicTime::Delta::Zero()),
+      next_packet_send_time_(QuicTime::Zero()) {
+}
+
+BbrSender::~BbrSender() {
+}
+
+void BbrSender::SetFromConfig(const QuicConfig& config, bool is_server) {
+  if (is_server) {
+    // Set the initial window size.
+    initial_congestion_window_ =
+        config.server_initial_congestion_window() * kMaxSegmentSize;
+  }
+}
+
+void BbrSender::OnIncomingQuicCongestionFeedbackFrame(
+    const QuicCongestionFeedbackFrame& /*feedback*/,
+    QuicTime /*feedback_receive_time*/) {
+  // The model is built from acks alone.
+}
+
+void BbrSender::OnPacketAcked(QuicPacketSequenceNumber acked_sequence_number,
+                              QuicByteCount acked_bytes) {
+  SentPacketMap::iterator it = sent_packets_.find(acked_sequence_number);
+  if (it == sent_packets_.end()) {
+    return;
+  }
+  const SentPacket& packet = it->second;
+  const QuicTime now = clock_->ApproximateNow();
+  delivered_ += packet.bytes;
+  delivered_time_ = now;
+  last_acked_packet_sent_time_ = packet.sent_time;
+
+  // The delivery rate is measured over the longer of the send and ack
+  // intervals, so that acks arriving in a burst don't inflate it.
+  QuicTime::Delta send_interval = packet.sent_time.Subtract(
+      packet.first_sent_time);
+  QuicTime::Delta ack_interval = now.Subtract(packet.delivered_time);
+  QuicTime::Delta interval = max(send_interval, ack_interval);
+
+  bool new_round = false;
+  if (packet.delivered >= next_round_delivered_) {
+    new_round = true;
+    next_round_delivered_ = delivered_;
+    ++round_count_;
+    round_max_bandwidth_[round_count_ % kBandwidthWindowRounds] =
+        QuicBandwidth::Zero();
+  }
+  if (!interval.IsZero()) {
+    QuicBandwidth sample = QuicBandwidth::FromBytesAndTimeDelta(
+        delivered_ - packet.delivered, interval);
+    QuicBandwidth* round_max =
+        &round_max_bandwidth_[round_count_ % kBandwidthWindowRounds];
+    if (sample > *round_max) {
+      *round_max = sample;
+    }
+  }
+  RemovePacket(acked_sequence_number);
+
+  if (new_round) {
+    OnNewRound(now);
+  }
+  UpdateMode(now);
+}
+
+void BbrSender::OnPacketLost(QuicPacketSequenceNumber sequence_number,
+                             QuicTime /*ack_receive_time*/) {
+  // Losses don't change the model; the bandwidth filter sees the lower
+  // delivery rate if they were caused by congestion.
+  RemovePacket(sequence_number);
+}
+
+bool BbrSender::OnPacketSent(QuicTime sent_time,
+                             QuicPacketSequenceNumber sequence_number,
+                             QuicByteCount bytes,
+                             TransmissionType /*transmission_type*/,
+                             HasRetransmittableData is_retransmittable) {
+  // Only update bytes_in_flight_ for data packets.
+  if (is_retransmittable != HAS_RETRANSMITTABLE_DATA) {
+    return false;
+  }
+  if (bytes_in_flight_ == 0) {
+    // Don't count the time spent idle as part of the next delivery rate.
+    delivered_time_ = sent_time;
+    last_acked_packet_sent_time_ = sent_time;
+  }
+  sent_packets_.insert(std::make_pair(
+      sequence_number,
+      SentPacket(bytes, sent_time, last_acked_packet_sent_time_, delivered_,
+                 delivered_time_)));
+  bytes_in_flight_ += bytes;
+
+  // Collect the pacing delay of a packet sent late rather than bursting to
+  // catch up.
+  next_packet_send_time_ = max(next_packet_send_time_, sent_time).Add(
+      PacingRate().TransferTime(bytes));
+  return true;
+}
+
+void BbrSender::OnRetransmissionTimeout(bool /*packets_retransmitted*/) {
+  // Everything in flight is considered lost, and won't be acked or abandoned.
+  sent_packets_.clear();
+  bytes_in_flight_ = 0;
+}
+
+void BbrSender::OnPacketAbandoned(QuicPacketSequenceNumber sequence_number,
+                                  QuicByteCount /*abandoned_bytes*/) {
+  RemovePacket(sequence_number);
+}
+
+QuicTime::Delta BbrSender::TimeUntilSend(
+    QuicTime now,
+    TransmissionType transmission_type,
+    HasRetransmittableData has_retransmittable_data,
+    IsHandshake handshake) {
+  if (transmission_type == TLP_RETRANSMISSION ||
+      has_retransmittable_data == NO_RETRANSMITTABLE_DATA ||
+      handshake == IS_HANDSHAKE) {
+    // Acks, handshake packets and tail loss probes are sent immediately, as
+    // in TcpCubicSender.
+    return QuicTime::Delta::Zero();
+  }
+  if (bytes_in_flight_ >= GetCongestionWindow()) {
+    return QuicTime::Delta::Infinite();
+  }
+  if (next_packet_send_time_ > now.Add(
+          QuicTime::Delta::FromMilliseconds(kAlarmGranularityMs))) {
+    return next_packet_send_time_.Subtract(now);
+  }
+  return QuicTime::Delta::Zero();
+}
+
+QuicBandwidth BbrSender::BandwidthEstimate() const {
+  QuicBandwidth bandwidth = MaxBandwidth();
+  if (bandwidth.IsZero()) {
+    return QuicBandwidth::FromBytesAndTimeDelta(GetCongestionWindow(),
+                                                SmoothedRtt());
+  }
+  return bandwidth;
+}
+
+void BbrSender::UpdateRtt(QuicTime::Delta rtt) {
+  if (rtt.IsInfinite() || rtt.IsZero()) {
+    DVLOG(1) << "Ignoring rtt, because it's "
+             << (rtt.IsZero() ? "Zero" : "Infinite");
+    return;
+  }
+  const QuicTime now = clock_->ApproximateNow();
+  const bool expired = !min_rtt_.IsZero() && now > min_rtt_timestamp_.Add(
+      QuicTime::Delta::FromSeconds(kMinRttExpirySeconds));
+  if (min_rtt_.IsZero() || rtt <= min_rtt_ || expired) {
+    min_rtt_expired_ = expired && rtt > min_rtt_;
+    min_rtt_ = rtt;
+    min_rtt_timestamp_ = now;
+  }
+
+  if (smoothed_rtt_.IsZero()) {
+    smoothed_rtt_ = rtt;
+    mean_deviation_ = QuicTime::Delta::FromMicroseconds(
+        rtt.ToMicroseconds() / 2);
+  } else {
+    mean_deviation_ = QuicTime::Delta::FromMicroseconds(
+        kOneMinusBeta * mean_deviation_.ToMicroseconds() +
+        kBeta *
+            std::abs(smoothed_rtt_.ToMicroseconds() - rtt.ToMicroseconds()));
+    smoothed_rtt_ = QuicTime::Delta::FromMicroseconds(
+        kOneMinusAlpha * smoothed_rtt_.ToMicroseconds() +
+        kAlpha * rtt.ToMicroseconds());
+  }
+}
+
+QuicTime::Delta BbrSender::SmoothedRtt() const {
+  if (smoothed_rtt_.IsZero()) {
+    return QuicTime::Delta::FromMilliseconds(kInitialRttMs);
+  }
+  return smoothed_rtt_;
+}
+
+QuicTime::Delta BbrSender::RetransmissionDelay() const {
+  return QuicTime::Delta::FromMicroseconds(
+      SmoothedRtt().ToMicroseconds() + 4 * mean_deviation_.ToMicroseconds());
+}
+
+QuicByteCount BbrSender::GetCongestionWindow() const {
+  if (mode_ == PROBE_RTT) {
+    return kMinimumCongestionWindow;
+  }
+  return max(kMinimumCongestionWindow,
+             TargetCongestionWindow(congestion_window_gain_));
+}
+
+QuicBandwidth BbrSender::MaxBandwidth() const {
+  QuicBandwidth max_bandwidth = QuicBandwidth::Zero();
+  for (int i = 0; i < kBandwidthWindowRounds; ++i) {
+    if (round_max_bandwidth_[i] > max_bandwidth) {
+      max_bandwidth = round_max_bandwidth_[i];
+    }
+  }
+  return max_bandwidth;
+}
+
+QuicByteCount BbrSender::TargetCongestionWindow(float gain) const {
+  QuicBandwidth bandwidth = MaxBandwidth();
+  if (bandwidth.IsZero() || min_rtt_.IsZero()) {
+    return static_cast<QuicByteCount>(gain * initial_congestion_window_);
+  }
+  return static_cast<QuicByteCount>(
+      gain * bandwidth.ToBytesPerPeriod(min_rtt_));
+}
+
+QuicBandwidth BbrSender::PacingRate() const {
+  QuicBandwidth bandwidth = MaxBandwidth();
+  if (bandwidth.IsZero()) {
+    // Until there's a sample, pace the initial window over an RTT.
+    bandwidth = QuicBandwidth::FromBytesAndTimeDelta(
+        initial_congestion_window_, SmoothedRtt());
+  }
+  return bandwidth.Scale(pacing_gain_);
+}
+
+void BbrSender::RemovePacket(QuicPacketSequenceNumber sequence_number) {
+  SentPacketMap::iterator it = sent_packets_.find(sequence_number);
+  if (it == sent_packets_.end()) {
+    return;
+  }
+  DCHECK_GE(bytes_in_flight_, it->second.bytes);
+  bytes_in_flight_ -= it->second.bytes;
+  sent_packets_.erase(it);
+}
+
+void BbrSender::OnNewRound(QuicTime /*now*/) {
+  if (found_full_bandwidth_) {
+    return;
+  }
+  QuicBandwidth bandwidth = MaxBandwidth();
+  if (bandwidth >= full_bandwidth_.Scale(kStartupGrowthTarget)) {
+    full_bandwidth_ = bandwidth;
+    rounds_without_bandwidth_growth_ = 0;
+    return;
+  }
+  if (++rounds_without_bandwidth_growth_ >=
+      kRoundTripsWithoutGrowthBeforeExitingStartup) {
+    found_full_bandwidth_ = true;
+  }
+}
+
+void BbrSender::UpdateMode(QuicTime now) {
+  if (min_rtt_expired_ && mode_ != PROBE_RTT) {
+    DVLOG(1) << "Min RTT expired, entering PROBE_RTT";
+    min_rtt_expired_ = false;
+    mode_ = PROBE_RTT;
+    pacing_gain_ = 1;
+    probe_rtt_done_time_ = QuicTime::Zero();
+  }
+
+  switch (mode_) {
+    case STARTUP:
+      if (found_full_bandwidth_) {
+        DVLOG(1) << "Bandwidth stopped growing, entering DRAIN";
+        mode_ = DRAIN;
+        pacing_gain_ = 1 / kStartupGain;
+        congestion_window_gain_ = kStartupGain;
+      }
+      break;
+    case DRAIN:
+      if (bytes_in_flight_ <= TargetCongestionWindow(1)) {
+        EnterProbeBandwidth(now);
+      }
+      break;
+    case PROBE_BW: {
+      bool should_advance = now.Subtract(cycle_start_) > min_rtt_;
+      // Stop draining as soon as the queue is gone.
+      if (pacing_gain_ < 1 && bytes_in_flight_ <= TargetCongestionWindow(1)) {
+        should_advance = true;
+      }
+      if (should_advance) {
+        cycle_index_ = (cycle_index_ + 1) % kGainCycleLength;
+        cycle_start_ = now;
+        pacing_gain_ = kPacingGainCycle[cycle_index_];
+      }
+      break;
+    }
+    case PROBE_RTT:
+      if (probe_rtt_done_time_.IsInitialized()) {
+        if (now >= probe_rtt_done_time_) {
+          min_rtt_timestamp_ = now;
+          if (found_full_bandwidth_) {
+            EnterProbeBandwidth(now);
+          } else {
+            mode_ = STARTUP;
+            pacing_gain_ = kStartupGain;
+            congestion_window_gain_ = kStartupGain;
+          }
+        }
+      } else if (bytes_in_flight_ <= kMinimumCongestionWindow) {
+        probe_rtt_done_time_ = now.Add(
+            QuicTime::Delta::FromMilliseconds(kProbeRttTimeMs));
+      }
+      break;
+  }
+}
+
+void BbrSender::EnterProbeBandwidth(QuicTime now) {
+  DVLOG(1) << "Entering PROBE_BW";
+  mode_ = PROBE_BW;
+  congestion_window_gain_ = kCongestionWindowGain;
+  // Start in one of the cruising phases, so that the probing of different
+  // connections sharing a bottleneck isn't synchronized.
+  cycle_index_ = 2 + static_cast<int>(round_count_ % (kGainCycleLength - 2));
+  cycle_start_ = now;
+  pacing_gain_ = kPacingGainCycle[cycle_index_];
+}
+
+}  // namespace net
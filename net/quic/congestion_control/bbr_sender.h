@@ -0,0 +1,176 @@
+// Copyright 2014 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+//
+// Model based send side congestion algorithm, in the style of BBR.  It
+// estimates the bottleneck bandwidth from the delivery rate of acked packets
+// and the path's minimum RTT, paces packets at the estimated bandwidth, and
+// keeps about two bandwidth-delay products in flight.  Losses aren't used as
+// a congestion signal, so random loss on wireless links doesn't cut the
+// sending rate, and the queue built at the bottleneck stays small.
+
+#ifndef NET_QUIC_CONGESTION_CONTROL_BBR_SENDER_H_
+#define NET_QUIC_CONGESTION_CONTROL_BBR_SENDER_H_
+
+#include <map>
+#include <vector>
+
+#include "base/basictypes.h"
+#include "base/compiler_specific.h"
+#include "net/base/net_export.h"
+#include "net/quic/congestion_control/send_algorithm_interface.h"
+#include "net/quic/quic_bandwidth.h"
+#include "net/quic/quic_protocol.h"
+#include "net/quic/quic_time.h"
+
+namespace net {
+
+namespace test {
+class BbrSenderPeer;
+}  // namespace test
+
+class NET_EXPORT_PRIVATE BbrSender : public SendAlgorithmInterface {
+ public:
+  // The number of round trips over which the maximum bandwidth is kept.
+  static const int kBandwidthWindowRounds = 10;
+
+  explicit BbrSender(const QuicClock* clock);
+  virtual ~BbrSender();
+
+  // Start implementation of SendAlgorithmInterface.
+  virtual void SetFromConfig(const QuicConfig& config, bool is_server) OVERRIDE;
+  virtual void OnIncomingQuicCongestionFeedbackFrame(
+      const QuicCongestionFeedbackFrame& feedback,
+      QuicTime feedback_receive_time) OVERRIDE;
+  virtual void OnPacketAcked(QuicPacketSequenceNumber acked_sequence_number,
+                             QuicByteCount acked_bytes) OVERRIDE;
+  virtual void OnPacketLost(QuicPacketSequenceNumber sequence_number,
+                            QuicTime ack_receive_time) OVERRIDE;
+  virtual bool OnPacketSent(QuicTime sent_time,
+                            QuicPacketSequenceNumber sequence_number,
+                            QuicByteCount bytes,
+                            TransmissionType transmission_type,
+                            HasRetransmittableData is_retransmittable) OVERRIDE;
+  virtual void OnRetransmissionTimeout(bool packets_retransmitted) OVERRIDE;
+  virtual void OnPacketAbandoned(QuicPacketSequenceNumber sequence_number,
+                                 QuicByteCount abandoned_bytes) OVERRIDE;
+  virtual QuicTime::Delta TimeUntilSend(
+      QuicTime now,
+      TransmissionType transmission_type,
+      HasRetransmittableData has_retransmittable_data,
+      IsHandshake handshake) OVERRIDE;
+  virtual QuicBandwidth BandwidthEstimate() const OVERRIDE;
+  virtual void UpdateRtt(QuicTime::Delta rtt_sample) OVERRIDE;
+  virtual QuicTime::Delta SmoothedRtt() const OVERRIDE;
+  virtual QuicTime::Delta RetransmissionDelay() const OVERRIDE;
+  virtual QuicByteCount GetCongestionWindow() const OVERRIDE;
+  // End implementation of SendAlgorithmInterface.
+
+ private:
+  friend class test::BbrSenderPeer;
+
+  enum Mode {
+    // Doubles the sending rate every round trip until the bandwidth stops
+    // growing.
+    STARTUP,
+    // Drains the queue built during STARTUP.
+    DRAIN,
+    // Cycles the pacing rate around the bandwidth estimate to find out
+    // whether more bandwidth is available.
+    PROBE_BW,
+    // Cuts the bytes in flight to a few packets for a while, so that the
+    // queue empties and the minimum RTT can be measured again.
+    PROBE_RTT,
+  };
+
+  // What's known about a data packet in flight.
+  struct SentPacket {
+    SentPacket(QuicByteCount bytes,
+               QuicTime sent_time,
+               QuicTime first_sent_time,
+               QuicByteCount delivered,
+               QuicTime delivered_time);
+
+    QuicByteCount bytes;
+    QuicTime sent_time;
+    // The send time of the last packet acked when it was sent.
+    QuicTime first_sent_time;
+    // The totals of |delivered_| and |delivered_time_| when it was sent.
+    QuicByteCount delivered;
+    QuicTime delivered_time;
+  };
+
+  typedef std::map<QuicPacketSequenceNumber, SentPacket> SentPacketMap;
+
+  // Returns the maximum delivery rate seen over the last
+  // |kBandwidthWindowRounds| round trips.
+  QuicBandwidth MaxBandwidth() const;
+
+  // Returns |gain| times the estimated bandwidth-delay product, or the
+  // initial congestion window until there's an estimate.
+  QuicByteCount TargetCongestionWindow(float gain) const;
+
+  QuicBandwidth PacingRate() const;
+
+  // Forgets |sequence_number|, which is no longer in flight.
+  void RemovePacket(QuicPacketSequenceNumber sequence_number);
+
+  // Called at the start of each new round trip.
+  void OnNewRound(QuicTime now);
+
+  void UpdateMode(QuicTime now);
+  void EnterProbeBandwidth(QuicTime now);
+
+  const QuicClock* clock_;
+
+  Mode mode_;
+  float pacing_gain_;
+  float congestion_window_gain_;
+
+  QuicByteCount initial_congestion_window_;
+  QuicByteCount bytes_in_flight_;
+  SentPacketMap sent_packets_;
+
+  // The total of bytes acked, the time of the last ack, and the send time of
+  // the last packet acked.
+  QuicByteCount delivered_;
+  QuicTime delivered_time_;
+  QuicTime last_acked_packet_sent_time_;
+
+  // A round trip ends when a packet sent after it started is acked.
+  int64 round_count_;
+  QuicByteCount next_round_delivered_;
+
+  // The maximum delivery rate of each of the last round trips, indexed by
+  // round_count_ % kBandwidthWindowRounds.
+  std::vector<QuicBandwidth> round_max_bandwidth_;
+
+  // Used to tell when STARTUP stops finding more bandwidth.
+  QuicBandwidth full_bandwidth_;
+  int rounds_without_bandwidth_growth_;
+  bool found_full_bandwidth_;
+
+  // The position in the PROBE_BW gain cycle, and when it was entered.
+  int cycle_index_;
+  QuicTime cycle_start_;
+
+  // When PROBE_RTT can end, once the bytes in flight have come down.
+  QuicTime probe_rtt_done_time_;
+
+  QuicTime::Delta min_rtt_;
+  QuicTime min_rtt_timestamp_;
+  // Set when |min_rtt_| was replaced because it had expired, which is the
+  // signal to enter PROBE_RTT.
+  bool min_rtt_expired_;
+  QuicTime::Delta smoothed_rtt_;
+  QuicTime::Delta mean_deviation_;
+
+  // When the next data packet may be sent.
+  QuicTime next_packet_send_time_;
+
+  DISALLOW_COPY_AND_ASSIGN(BbrSender);
+};
+
+}  // namespace net
+
+#endif  // NET_QUIC_CONGESTION_CONTROL_BBR_SENDER_H_
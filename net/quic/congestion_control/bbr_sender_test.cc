@@ -0,0 +1,212 @@
+// Copyright 2014 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "net/quic/congestion_control/bbr_sender.h"
+
+#include <algorithm>
+#include <deque>
+
+#include "base/logging.h"
+#include "net/quic/congestion_control/tcp_cubic_sender.h"
+#include "net/quic/test_tools/mock_clock.h"
+#include "testing/gtest/include/gtest/gtest.h"
+
+namespace net {
+namespace test {
+
+class BbrSenderPeer {
+ public:
+  static bool InProbeRtt(const BbrSender& sender) {
+    return sender.mode_ == BbrSender::PROBE_RTT;
+  }
+
+  static bool InStartup(const BbrSender& sender) {
+    return sender.mode_ == BbrSender::STARTUP;
+  }
+
+  static QuicTime::Delta min_rtt(const BbrSender& sender) {
+    return sender.min_rtt_;
+  }
+
+ private:
+  DISALLOW_COPY_AND_ASSIGN(BbrSenderPeer);
+};
+
+namespace {
+
+const QuicByteCount kPacketSize = kDefaultTCPMSS;
+const int64 kRttMs = 100;
+// 10 packets per ms, or about 110 Mbit/s.
+const int64 kPacketsPerMs = 10;
+
+// A single bottleneck link, with an unlimited queue in front of it, and an
+// ack for each packet coming back after its propagation delay.
+class BbrSenderTest : public ::testing::Test {
+ protected:
+  BbrSenderTest()
+      : sender_(&clock_),
+        link_bandwidth_(QuicBandwidth::FromBytesAndTimeDelta(
+            kPacketsPerMs * kPacketSize,
+            QuicTime::Delta::FromMilliseconds(1))),
+        link_free_time_(QuicTime::Zero()),
+        sequence_number_(1),
+        lose_every_nth_packet_(0),
+        rtt_ms_(kRttMs),
+        max_queued_packets_(0) {
+    clock_.AdvanceTime(QuicTime::Delta::FromMilliseconds(1));
+  }
+
+  // Runs the connection, with the sender always having data to send, for
+  // |duration_ms| in steps of 1ms.
+  void Run(int64 duration_ms) {
+    for (int64 i = 0; i < duration_ms; ++i) {
+      SendPackets();
+      clock_.AdvanceTime(QuicTime::Delta::FromMilliseconds(1));
+      DeliverAcks();
+    }
+  }
+
+  void SendPackets() {
+    while (sender_.TimeUntilSend(clock_.Now(), NOT_RETRANSMISSION,
+                                 HAS_RETRANSMITTABLE_DATA,
+                                 NOT_HANDSHAKE).IsZero()) {
+      sender_.OnPacketSent(clock_.Now(), sequence_number_, kPacketSize,
+                           NOT_RETRANSMISSION, HAS_RETRANSMITTABLE_DATA);
+      // The packet leaves the link once the ones ahead of it have, and the
+      // |queue_delay| tells how many of them there were.
+      QuicTime start = link_free_time_ > clock_.Now() ?
+          link_free_time_ : clock_.Now();
+      int64 queued = start.Subtract(clock_.Now()).ToMicroseconds() *
+          kPacketsPerMs / 1000;
+      max_queued_packets_ = std::max(max_queued_packets_, queued);
+      link_free_time_ = start.Add(link_bandwidth_.TransferTime(kPacketSize));
+      InFlight packet;
+      packet.sequence_number = sequence_number_;
+      packet.sent_time = clock_.Now();
+      packet.ack_time = link_free_time_.Add(
+          QuicTime::Delta::FromMilliseconds(rtt_ms_));
+      packet.lost = lose_every_nth_packet_ > 0 &&
+          sequence_number_ % lose_every_nth_packet_ == 0;
+      in_flight_.push_back(packet);
+      ++sequence_number_;
+    }
+  }
+
+  void DeliverAcks() {
+    while (!in_flight_.empty() &&
+           in_flight_.front().ack_time <= clock_.Now()) {
+      const InFlight& packet = in_flight_.front();
+      if (packet.lost) {
+        sender_.OnPacketAbandoned(packet.sequence_number, kPacketSize);
+        sender_.OnPacketLost(packet.sequence_number, clock_.Now());
+      } else {
+        sender_.UpdateRtt(clock_.Now().Subtract(packet.sent_time));
+        sender_.OnPacketAcked(packet.sequence_number, kPacketSize);
+      }
+      in_flight_.pop_front();
+    }
+  }
+
+  QuicByteCount BandwidthDelayProduct() const {
+    return link_bandwidth_.ToBytesPerPeriod(
+        QuicTime::Delta::FromMilliseconds(kRttMs));
+  }
+
+  struct InFlight {
+    InFlight()
+        : sequence_number(0),
+          sent_time(QuicTime::Zero()),
+          ack_time(QuicTime::Zero()),
+          lost(false) {
+    }
+
+    QuicPacketSequenceNumber sequence_number;
+    QuicTime sent_time;
+    QuicTime ack_time;
+    bool lost;
+  };
+
+  MockClock clock_;
+  BbrSender sender_;
+  const QuicBandwidth link_bandwidth_;
+  QuicTime link_free_time_;
+  QuicPacketSequenceNumber sequence_number_;
+  std::deque<InFlight> in_flight_;
+  QuicPacketSequenceNumber lose_every_nth_packet_;
+  int64 rtt_ms_;
+  int64 max_queued_packets_;
+};
+
+TEST_F(BbrSenderTest, InitialWindowIsPaced) {
+  // Before any ack, the initial window is sent, but not in a single burst.
+  EXPECT_TRUE(sender_.TimeUntilSend(clock_.Now(), NOT_RETRANSMISSION,
+                                    HAS_RETRANSMITTABLE_DATA,
+                                    NOT_HANDSHAKE).IsZero());
+  SendPackets();
+  EXPECT_GT(10u, sequence_number_);
+  EXPECT_FALSE(sender_.TimeUntilSend(clock_.Now(), NOT_RETRANSMISSION,
+                                     HAS_RETRANSMITTABLE_DATA,
+                                     NOT_HANDSHAKE).IsInfinite());
+
+  // Acks and handshake packets are never delayed.
+  EXPECT_TRUE(sender_.TimeUntilSend(clock_.Now(), NOT_RETRANSMISSION,
+                                    NO_RETRANSMITTABLE_DATA,
+                                    NOT_HANDSHAKE).IsZero());
+  EXPECT_TRUE(sender_.TimeUntilSend(clock_.Now(), NOT_RETRANSMISSION,
+                                    HAS_RETRANSMITTABLE_DATA,
+                                    IS_HANDSHAKE).IsZero());
+  EXPECT_FALSE(sender_.OnPacketSent(clock_.Now(), 100, kPacketSize,
+                                    NOT_RETRANSMISSION,
+                                    NO_RETRANSMITTABLE_DATA));
+}
+
+TEST_F(BbrSenderTest, FindsBottleneckBandwidth) {
+  Run(3000);
+  EXPECT_FALSE(BbrSenderPeer::InStartup(sender_));
+  // The test's 1ms steps add up to 1ms.
+  EXPECT_GE(kRttMs + 1, BbrSenderPeer::min_rtt(sender_).ToMilliseconds());
+  QuicBandwidth estimate = sender_.BandwidthEstimate();
+  EXPECT_LE(link_bandwidth_.Scale(0.9f), estimate);
+  EXPECT_GE(link_bandwidth_.Scale(1.1f), estimate);
+  EXPECT_GE(BandwidthDelayProduct() * 5 / 2, sender_.GetCongestionWindow());
+
+  // Once STARTUP's queue drained, the queue stays under one BDP.
+  max_queued_packets_ = 0;
+  Run(3000);
+  EXPECT_GT(static_cast<int64>(BandwidthDelayProduct() / kPacketSize),
+            max_queued_packets_);
+}
+
+TEST_F(BbrSenderTest, RandomLossDoesNotReduceBandwidth) {
+  lose_every_nth_packet_ = 50;
+  Run(3000);
+  EXPECT_LE(link_bandwidth_.Scale(0.9f), sender_.BandwidthEstimate());
+}
+
+TEST_F(BbrSenderTest, ProbesMinRttAfterRouteChange) {
+  Run(3000);
+  EXPECT_FALSE(BbrSenderPeer::InProbeRtt(sender_));
+
+  // The old min RTT can't be measured anymore, and is given up on.
+  rtt_ms_ = 2 * kRttMs;
+  bool probed_rtt = false;
+  for (int i = 0; i < 12000 && !probed_rtt; ++i) {
+    Run(1);
+    probed_rtt = BbrSenderPeer::InProbeRtt(sender_);
+  }
+  ASSERT_TRUE(probed_rtt);
+  EXPECT_EQ(4 * kPacketSize, sender_.GetCongestionWindow());
+
+  // PROBE_RTT lasts for 200ms once the queue emptied, and then the bandwidth
+  // is still known.
+  Run(500);
+  EXPECT_FALSE(BbrSenderPeer::InProbeRtt(sender_));
+  EXPECT_LE(2 * kRttMs, BbrSenderPeer::min_rtt(sender_).ToMilliseconds());
+  EXPECT_FALSE(BbrSenderPeer::InStartup(sender_));
+  EXPECT_LE(link_bandwidth_.Scale(0.9f), sender_.BandwidthEstimate());
+}
+
+}  // namespace
+}  // namespace test
+}  // namespace net
@@ -12,6 +12,8 @@
 
 #if defined(USE_OPENSSL)
 #include "net/quic/crypto/scoped_evp_aead_ctx.h"
+#else
+#include "crypto/scoped_nss_types.h"
 #endif
 
 namespace net {
@@ -61,6 +63,10 @@ class NET_EXPORT_PRIVATE Aes128Gcm12Decrypter : public QuicDecrypter {
 
 #if defined(USE_OPENSSL)
   ScopedEVPAEADCtx ctx_;
+#else
+  // |key_| imported into NSS by SetKey(), so that importing it isn't paid for
+  // on every packet.
+  crypto::ScopedPK11SymKey aes_key_;
 #endif
 };
 
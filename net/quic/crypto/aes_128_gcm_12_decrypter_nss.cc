@@ -270,6 +270,25 @@ bool Aes128Gcm12Decrypter::SetKey(StringPiece key) {
     return false;
   }
   memcpy(key_, key.data(), key.size());
+
+  // Import key_ into NSS.
+  SECItem key_item;
+  key_item.type = siBuffer;
+  key_item.data = key_;
+  key_item.len = sizeof(key_);
+  PK11SlotInfo* slot = PK11_GetInternalSlot();
+  // The exact value of the |origin| argument doesn't matter to NSS as long as
+  // it's not PK11_OriginFortezzaHack, so pass PK11_OriginUnwrap as a
+  // placeholder.
+  aes_key_.reset(PK11_ImportSymKey(
+      slot, GcmSupportChecker::aes_key_mechanism(), PK11_OriginUnwrap,
+      CKA_DECRYPT, &key_item, NULL));
+  PK11_FreeSlot(slot);
+  slot = NULL;
+  if (!aes_key_) {
+    DVLOG(1) << "PK11_ImportSymKey failed";
+    return false;
+  }
   return true;
 }
 
@@ -299,22 +318,8 @@ bool Aes128Gcm12Decrypter::Decrypt(StringPiece nonce,
   // |ciphertext| on entry.
   size_t plaintext_size = ciphertext.length() - kAuthTagSize;
 
-  // Import key_ into NSS.
-  SECItem key_item;
-  key_item.type = siBuffer;
-  key_item.data = key_;
-  key_item.len = sizeof(key_);
-  PK11SlotInfo* slot = PK11_GetInternalSlot();
-  // The exact value of the |origin| argument doesn't matter to NSS as long as
-  // it's not PK11_OriginFortezzaHack, so pass PK11_OriginUnwrap as a
-  // placeholder.
-  crypto::ScopedPK11SymKey aes_key(PK11_ImportSymKey(
-      slot, GcmSupportChecker::aes_key_mechanism(), PK11_OriginUnwrap,
-      CKA_DECRYPT, &key_item, NULL));
-  PK11_FreeSlot(slot);
-  slot = NULL;
-  if (!aes_key) {
-    DVLOG(1) << "PK11_ImportSymKey failed";
+  if (!aes_key_) {
+    DVLOG(1) << "No key was set";
     return false;
   }
 
@@ -333,7 +338,7 @@ bool Aes128Gcm12Decrypter::Decrypt(StringPiece nonce,
   param.len = sizeof(gcm_params);
 
   unsigned int output_len;
-  if (My_Decrypt(aes_key.get(), CKM_AES_GCM, &param,
+  if (My_Decrypt(aes_key_.get(), CKM_AES_GCM, &param,
                  output, &output_len, ciphertext.length(),
                  reinterpret_cast<const unsigned char*>(ciphertext.data()),
                  ciphertext.length()) != SECSuccess) {
@@ -12,6 +12,8 @@
 
 #if defined(USE_OPENSSL)
 #include "net/quic/crypto/scoped_evp_aead_ctx.h"
+#else
+#include "crypto/scoped_nss_types.h"
 #endif
 
 namespace net {
@@ -46,6 +48,10 @@ class NET_EXPORT_PRIVATE Aes128Gcm12Encrypter : public QuicEncrypter {
   virtual QuicData* EncryptPacket(QuicPacketSequenceNumber sequence_number,
                                   base::StringPiece associated_data,
                                   base::StringPiece plaintext) OVERRIDE;
+  virtual bool EncryptPacketToBuffer(QuicPacketSequenceNumber sequence_number,
+                                     base::StringPiece associated_data,
+                                     base::StringPiece plaintext,
+                                     char* output) OVERRIDE;
   virtual size_t GetKeySize() const OVERRIDE;
   virtual size_t GetNoncePrefixSize() const OVERRIDE;
   virtual size_t GetMaxPlaintextSize(size_t ciphertext_size) const OVERRIDE;
@@ -61,6 +67,10 @@ class NET_EXPORT_PRIVATE Aes128Gcm12Encrypter : public QuicEncrypter {
 
 #if defined(USE_OPENSSL)
   ScopedEVPAEADCtx ctx_;
+#else
+  // |key_| imported into NSS by SetKey(), so that importing it isn't paid for
+  // on every packet.
+  crypto::ScopedPK11SymKey aes_key_;
 #endif
 };
 
@@ -262,6 +262,25 @@ bool Aes128Gcm12Encrypter::SetKey(StringPiece key) {
     return false;
   }
   memcpy(key_, key.data(), key.size());
+
+  // Import key_ into NSS.
+  SECItem key_item;
+  key_item.type = siBuffer;
+  key_item.data = key_;
+  key_item.len = sizeof(key_);
+  PK11SlotInfo* slot = PK11_GetInternalSlot();
+  // The exact value of the |origin| argument doesn't matter to NSS as long as
+  // it's not PK11_OriginFortezzaHack, so pass PK11_OriginUnwrap as a
+  // placeholder.
+  aes_key_.reset(PK11_ImportSymKey(
+      slot, GcmSupportChecker::aes_key_mechanism(), PK11_OriginUnwrap,
+      CKA_ENCRYPT, &key_item, NULL));
+  PK11_FreeSlot(slot);
+  slot = NULL;
+  if (!aes_key_) {
+    DVLOG(1) << "PK11_ImportSymKey failed";
+    return false;
+  }
   return true;
 }
 
@@ -285,22 +304,8 @@ bool Aes128Gcm12Encrypter::Encrypt(StringPiece nonce,
 
   size_t ciphertext_size = GetCiphertextSize(plaintext.length());
 
-  // Import key_ into NSS.
-  SECItem key_item;
-  key_item.type = siBuffer;
-  key_item.data = key_;
-  key_item.len = sizeof(key_);
-  PK11SlotInfo* slot = PK11_GetInternalSlot();
-  // The exact value of the |origin| argument doesn't matter to NSS as long as
-  // it's not PK11_OriginFortezzaHack, so we pass PK11_OriginUnwrap as a
-  // placeholder.
-  crypto::ScopedPK11SymKey aes_key(PK11_ImportSymKey(
-      slot, GcmSupportChecker::aes_key_mechanism(), PK11_OriginUnwrap,
-      CKA_ENCRYPT, &key_item, NULL));
-  PK11_FreeSlot(slot);
-  slot = NULL;
-  if (!aes_key) {
-    DVLOG(1) << "PK11_ImportSymKey failed";
+  if (!aes_key_) {
+    DVLOG(1) << "No key was set";
     return false;
   }
 
@@ -319,7 +324,7 @@ bool Aes128Gcm12Encrypter::Encrypt(StringPiece nonce,
   param.len = sizeof(gcm_params);
 
   unsigned int output_len;
-  if (My_Encrypt(aes_key.get(), CKM_AES_GCM, &param,
+  if (My_Encrypt(aes_key_.get(), CKM_AES_GCM, &param,
                  output, &output_len, ciphertext_size,
                  reinterpret_cast<const unsigned char*>(plaintext.data()),
                  plaintext.size()) != SECSuccess) {
@@ -341,20 +346,28 @@ QuicData* Aes128Gcm12Encrypter::EncryptPacket(
     StringPiece plaintext) {
   size_t ciphertext_size = GetCiphertextSize(plaintext.length());
   scoped_ptr<char[]> ciphertext(new char[ciphertext_size]);
+  if (!EncryptPacketToBuffer(sequence_number, associated_data, plaintext,
+                             ciphertext.get())) {
+    return NULL;
+  }
 
+  return new QuicData(ciphertext.release(), ciphertext_size, true);
+}
+
+bool Aes128Gcm12Encrypter::EncryptPacketToBuffer(
+    QuicPacketSequenceNumber sequence_number,
+    StringPiece associated_data,
+    StringPiece plaintext,
+    char* output) {
   // TODO(ianswett): Introduce a check to ensure that we don't encrypt with the
   // same sequence number twice.
   uint8 nonce[kNoncePrefixSize + sizeof(sequence_number)];
   COMPILE_ASSERT(sizeof(nonce) == kAESNonceSize, bad_sequence_number_size);
   memcpy(nonce, nonce_prefix_, kNoncePrefixSize);
   memcpy(nonce + kNoncePrefixSize, &sequence_number, sizeof(sequence_number));
-  if (!Encrypt(StringPiece(reinterpret_cast<char*>(nonce), sizeof(nonce)),
-               associated_data, plaintext,
-               reinterpret_cast<unsigned char*>(ciphertext.get()))) {
-    return NULL;
-  }
-
-  return new QuicData(ciphertext.release(), ciphertext_size, true);
+  return Encrypt(StringPiece(reinterpret_cast<char*>(nonce), sizeof(nonce)),
+                 associated_data, plaintext,
+                 reinterpret_cast<unsigned char*>(output));
 }
 
 size_t Aes128Gcm12Encrypter::GetKeySize() const { return kKeySize; }
@@ -45,6 +45,7 @@ const QuicTag kAESG = TAG('A', 'E', 'S', 'G');  // AES128 + GCM-12
 const QuicTag kQBIC = TAG('Q', 'B', 'I', 'C');  // TCP cubic
 const QuicTag kPACE = TAG('P', 'A', 'C', 'E');  // Paced TCP cubic
 const QuicTag kINAR = TAG('I', 'N', 'A', 'R');  // Inter arrival
+const QuicTag kTBBR = TAG('T', 'B', 'B', 'R');  // Bottleneck bandwidth and RTT
 
 // Proof types (i.e. certificate types)
 // NOTE: although it would be silly to do so, specifying both kX509 and kX59R
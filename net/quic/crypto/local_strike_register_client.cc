@@ -4,6 +4,8 @@
 
 #include "net/quic/crypto/local_strike_register_client.h"
 
+#include <algorithm>
+
 #include "net/quic/crypto/crypto_protocol.h"
 
 using base::StringPiece;
@@ -11,22 +13,48 @@ using std::string;
 
 namespace net {
 
+namespace {
+
+// The first random byte of a nonce, after the timestamp and the orbit.
+const size_t kNonceRandomOffset = 4 + kOrbitSize;
+
+}  // namespace
+
+// static
+const size_t LocalStrikeRegisterClient::kMaxShards;
+// static
+const unsigned LocalStrikeRegisterClient::kMinEntriesPerShard;
+
+LocalStrikeRegisterClient::Shard::Shard(unsigned max_entries,
+                                        uint32 current_time_external,
+                                        uint32 window_secs,
+                                        const uint8 orbit[8],
+                                        StrikeRegister::StartupType startup)
+    : strike_register(max_entries, current_time_external, window_secs, orbit,
+                      startup) {
+}
+
 LocalStrikeRegisterClient::LocalStrikeRegisterClient(
     unsigned max_entries,
     uint32 current_time_external,
     uint32 window_secs,
     const uint8 orbit[8],
-    StrikeRegister::StartupType startup)
-    : strike_register_(max_entries, current_time_external,  window_secs,
-                       orbit, startup) {
+    StrikeRegister::StartupType startup) {
+  memcpy(orbit_, orbit, sizeof(orbit_));
+  size_t num_shards = std::max<size_t>(
+      1, std::min<size_t>(kMaxShards, max_entries / kMinEntriesPerShard));
+  for (size_t i = 0; i < num_shards; ++i) {
+    shards_.push_back(new Shard(max_entries / num_shards,
+                                current_time_external, window_secs, orbit,
+                                startup));
+  }
 }
 
 bool LocalStrikeRegisterClient::IsKnownOrbit(StringPiece orbit) const {
-  base::AutoLock lock(m_);
   if (orbit.length() != kOrbitSize) {
     return false;
   }
-  return memcmp(orbit.data(), strike_register_.orbit(), kOrbitSize) == 0;
+  return memcmp(orbit.data(), orbit_, kOrbitSize) == 0;
 }
 
 void LocalStrikeRegisterClient::VerifyNonceIsValidAndUnique(
@@ -35,14 +63,25 @@ void LocalStrikeRegisterClient::VerifyNonceIsValidAndUnique(
   if (nonce.length() != kNonceSize) {
     nonce_is_valid_and_unique = false;
   } else {
-    base::AutoLock lock(m_);
-    nonce_is_valid_and_unique = strike_register_.Insert(
+    Shard* shard = ShardForNonce(nonce);
+    base::AutoLock lock(shard->m);
+    nonce_is_valid_and_unique = shard->strike_register.Insert(
         reinterpret_cast<const uint8*>(nonce.data()),
         static_cast<uint32>(now.ToUNIXSeconds()));
   }
 
-  // m_ must not be held when the ResultCallback runs.
+  // No shard's lock must be held when the ResultCallback runs.
   cb->Run(nonce_is_valid_and_unique);
 }
 
+LocalStrikeRegisterClient::Shard* LocalStrikeRegisterClient::ShardForNonce(
+    StringPiece nonce) {
+  if (shards_.size() == 1) {
+    return shards_[0];
+  }
+  uint32 random;
+  memcpy(&random, nonce.data() + kNonceRandomOffset, sizeof(random));
+  return shards_[random % shards_.size()];
+}
+
 }  // namespace net
@@ -6,6 +6,7 @@
 #define NET_QUIC_CRYPTO_LOCAL_STRIKE_REGISTER_CLIENT_H_
 
 #include "base/basictypes.h"
+#include "base/memory/scoped_vector.h"
 #include "base/strings/string_piece.h"
 #include "base/synchronization/lock.h"
 #include "net/base/net_export.h"
@@ -17,9 +18,19 @@ namespace net {
 
 // StrikeRegisterClient implementation that wraps a local in-memory
 // strike register.
+//
+// Large registers are split into shards, each with its own lock, so that
+// server threads verifying different nonces don't wait for each other. A
+// nonce always goes to the same shard (picked from its random bytes), so
+// replays are still caught. Each shard keeps its own horizon.
 class NET_EXPORT_PRIVATE LocalStrikeRegisterClient
     : public StrikeRegisterClient {
  public:
+  // The most shards a register is split into.
+  static const size_t kMaxShards = 16;
+  // Registers aren't split into shards of fewer entries than this.
+  static const unsigned kMinEntriesPerShard = 1024;
+
   LocalStrikeRegisterClient(unsigned max_entries,
                             uint32 current_time_external,
                             uint32 window_secs,
@@ -31,9 +42,26 @@ class NET_EXPORT_PRIVATE LocalStrikeRegisterClient
                                            QuicWallTime now,
                                            ResultCallback* cb) OVERRIDE;
 
+  size_t num_shards() const { return shards_.size(); }
+
  private:
-  mutable base::Lock m_;
-  StrikeRegister strike_register_;
+  struct Shard {
+    Shard(unsigned max_entries,
+          uint32 current_time_external,
+          uint32 window_secs,
+          const uint8 orbit[8],
+          StrikeRegister::StartupType startup);
+
+    base::Lock m;
+    StrikeRegister strike_register;
+  };
+
+  // Returns the shard that |nonce|, which is kNonceSize bytes, belongs to.
+  Shard* ShardForNonce(base::StringPiece nonce);
+
+  ScopedVector<Shard> shards_;
+  // Never changes, so it can be read without a lock.
+  uint8 orbit_[8];
 
   DISALLOW_COPY_AND_ASSIGN(LocalStrikeRegisterClient);
 };
@@ -121,6 +121,39 @@ TEST_F(LocalStrikeRegisterClientTest, IncorrectNonceLength) {
   }
 }
 
+TEST_F(LocalStrikeRegisterClientTest, Shards) {
+  // A small register isn't split.
+  EXPECT_EQ(1u, strike_register_->num_shards());
+
+  LocalStrikeRegisterClient sharded(
+      LocalStrikeRegisterClient::kMaxShards *
+          LocalStrikeRegisterClient::kMinEntriesPerShard,
+      kCurrentTimeExternalSecs, kWindowSecs, kOrbit,
+      net::StrikeRegister::NO_STARTUP_PERIOD_NEEDED);
+  EXPECT_EQ(LocalStrikeRegisterClient::kMaxShards, sharded.num_shards());
+  EXPECT_TRUE(sharded.IsKnownOrbit(
+      StringPiece(reinterpret_cast<const char*>(kOrbit), kOrbitSize)));
+
+  // Nonces that land in all the shards are accepted once, and replays of
+  // them are caught.
+  uint32 norder = htonl(kCurrentTimeExternalSecs);
+  for (int replay = 0; replay < 2; ++replay) {
+    for (uint32 i = 0; i < 4 * LocalStrikeRegisterClient::kMaxShards; ++i) {
+      string nonce(reinterpret_cast<const char*>(&norder), sizeof(norder));
+      nonce.append(string(reinterpret_cast<const char*>(kOrbit), kOrbitSize));
+      nonce.append(reinterpret_cast<const char*>(&i), sizeof(i));
+      nonce.append(string(16, '\x17'));
+      bool called;
+      bool is_valid;
+      sharded.VerifyNonceIsValidAndUnique(
+          nonce, QuicWallTime::FromUNIXSeconds(kCurrentTimeExternalSecs),
+          new RecordResultCallback(&called, &is_valid));
+      EXPECT_TRUE(called);
+      EXPECT_EQ(replay == 0, is_valid);
+    }
+  }
+}
+
 }  // namespace
 }  // namespace test
 }  // namespace net
@@ -44,6 +44,15 @@ QuicData* NullEncrypter::EncryptPacket(
   return new QuicData(reinterpret_cast<char*>(buffer), len, true);
 }
 
+bool NullEncrypter::EncryptPacketToBuffer(
+    QuicPacketSequenceNumber /*sequence_number*/,
+    StringPiece associated_data,
+    StringPiece plaintext,
+    char* output) {
+  return Encrypt(StringPiece(), associated_data, plaintext,
+                 reinterpret_cast<unsigned char*>(output));
+}
+
 size_t NullEncrypter::GetKeySize() const { return 0; }
 
 size_t NullEncrypter::GetNoncePrefixSize() const { return 0; }
@@ -33,6 +33,21 @@ TEST_F(NullEncrypterTest, Encrypt) {
       arraysize(expected));
 }
 
+TEST_F(NullEncrypterTest, EncryptPacketToBuffer) {
+  NullEncrypter encrypter;
+  scoped_ptr<QuicData> encrypted(
+      encrypter.EncryptPacket(0, "hello world!", "goodbye!"));
+  ASSERT_TRUE(encrypted.get());
+
+  char buffer[20];
+  ASSERT_EQ(arraysize(buffer), encrypter.GetCiphertextSize(8));
+  ASSERT_TRUE(encrypter.EncryptPacketToBuffer(0, "hello world!", "goodbye!",
+                                              buffer));
+  test::CompareCharArraysWithHexError(
+      "encrypted data", buffer, arraysize(buffer),
+      encrypted->data(), encrypted->length());
+}
+
 TEST_F(NullEncrypterTest, GetMaxPlaintextSize) {
   NullEncrypter encrypter;
   EXPECT_EQ(1000u, encrypter.GetMaxPlaintextSize(1012));
@@ -44,6 +44,25 @@ using std::vector;
 
 namespace net {
 
+namespace {
+
+// The number of compressed certificate chains kept. Each entry holds a chain,
+// which is typically a few KB, and its compressed form.
+const size_t kMaxCompressedCertsCacheEntries = 1024;
+
+// The number of proofs kept for each config.
+const size_t kMaxProofsPerConfig = 64;
+
+// AppendLengthPrefixed appends the length of |value|, followed by |value|, to
+// |out|, so that the concatenation of several values is unambiguous.
+void AppendLengthPrefixed(StringPiece value, string* out) {
+  const uint32 length = value.size();
+  out->append(reinterpret_cast<const char*>(&length), sizeof(length));
+  value.AppendToString(out);
+}
+
+}  // namespace
+
 // ClientHelloInfo contains information about a client hello message that is
 // only kept for as long as it's being processed.
 struct ClientHelloInfo {
@@ -178,6 +197,7 @@ QuicCryptoServerConfig::QuicCryptoServerConfig(
       primary_config_(NULL),
       next_config_promotion_time_(QuicWallTime::Zero()),
       server_nonce_strike_register_lock_(),
+      compressed_certs_cache_(kMaxCompressedCertsCacheEntries),
       strike_register_no_startup_period_(false),
       strike_register_max_entries_(1 << 10),
       strike_register_window_secs_(600),
@@ -948,10 +968,10 @@ void QuicCryptoServerConfig::BuildRejection(
     return;
   }
 
-  const vector<string>* certs;
+  vector<string> certs;
   string signature;
-  if (!proof_source_->GetProof(info.sni.as_string(), config->serialized,
-                               x509_ecdsa_supported, &certs, &signature)) {
+  if (!GetProof(config.get(), info.sni.as_string(), x509_ecdsa_supported,
+                &certs, &signature)) {
     return;
   }
 
@@ -960,8 +980,8 @@ void QuicCryptoServerConfig::BuildRejection(
   client_hello.GetStringPiece(kCCS, &their_common_set_hashes);
   client_hello.GetStringPiece(kCCRT, &their_cached_cert_hashes);
 
-  const string compressed = CertCompressor::CompressChain(
-      *certs, their_common_set_hashes, their_cached_cert_hashes,
+  const string compressed = CompressChain(
+      certs, their_common_set_hashes, their_cached_cert_hashes,
       config->common_cert_sets);
 
   // kREJOverheadBytes is a very rough estimate of how much of a REJ
@@ -990,6 +1010,75 @@ void QuicCryptoServerConfig::BuildRejection(
   }
 }
 
+bool QuicCryptoServerConfig::GetProof(Config* config,
+                                      const string& sni,
+                                      bool ecdsa_ok,
+                                      vector<string>* out_certs,
+                                      string* out_signature) const {
+  const string key = (ecdsa_ok ? "1" : "0") + sni;
+  {
+    base::AutoLock locked(config->proofs_lock);
+    base::MRUCache<string, Config::Proof>::iterator it =
+        config->proofs.Get(key);
+    if (it != config->proofs.end()) {
+      *out_certs = it->second.certs;
+      *out_signature = it->second.signature;
+      return true;
+    }
+  }
+
+  // The chain is copied because the ProofSource only keeps it for as long as
+  // it likes.
+  const vector<string>* certs;
+  if (!proof_source_->GetProof(sni, config->serialized, ecdsa_ok, &certs,
+                               out_signature)) {
+    return false;
+  }
+  *out_certs = *certs;
+
+  Config::Proof proof;
+  proof.certs = *certs;
+  proof.signature = *out_signature;
+  base::AutoLock locked(config->proofs_lock);
+  config->proofs.Put(key, proof);
+  return true;
+}
+
+string QuicCryptoServerConfig::CompressChain(
+    const vector<string>& certs,
+    StringPiece client_common_set_hashes,
+    StringPiece client_cached_cert_hashes,
+    const CommonCertSets* common_sets) const {
+  // The whole chain and the client's values make up the key, so that
+  // different inputs can't share an entry.
+  const uint32 num_certs = certs.size();
+  string key(reinterpret_cast<const char*>(&num_certs), sizeof(num_certs));
+  for (vector<string>::const_iterator it = certs.begin(); it != certs.end();
+       ++it) {
+    AppendLengthPrefixed(*it, &key);
+  }
+  key.append(reinterpret_cast<const char*>(&common_sets),
+             sizeof(common_sets));
+  AppendLengthPrefixed(client_common_set_hashes, &key);
+  AppendLengthPrefixed(client_cached_cert_hashes, &key);
+
+  {
+    base::AutoLock locked(compressed_certs_cache_lock_);
+    base::MRUCache<string, string>::iterator it =
+        compressed_certs_cache_.Get(key);
+    if (it != compressed_certs_cache_.end()) {
+      return it->second;
+    }
+  }
+
+  const string compressed = CertCompressor::CompressChain(
+      certs, client_common_set_hashes, client_cached_cert_hashes,
+      common_sets);
+  base::AutoLock locked(compressed_certs_cache_lock_);
+  compressed_certs_cache_.Put(key, compressed);
+  return compressed;
+}
+
 scoped_refptr<QuicCryptoServerConfig::Config>
 QuicCryptoServerConfig::ParseConfigProtobuf(
     QuicServerConfigProtobuf* protobuf) {
@@ -1329,7 +1418,8 @@ QuicCryptoServerConfig::Config::Config()
     : channel_id_enabled(false),
       is_primary(false),
       primary_time(QuicWallTime::Zero()),
-      priority(0) {}
+      priority(0),
+      proofs(kMaxProofsPerConfig) {}
 
 QuicCryptoServerConfig::Config::~Config() { STLDeleteElements(&key_exchanges); }
 
@@ -9,6 +9,7 @@
 #include <string>
 #include <vector>
 
+#include "base/containers/mru_cache.h"
 #include "base/memory/ref_counted.h"
 #include "base/memory/scoped_ptr.h"
 #include "base/strings/string_piece.h"
@@ -25,6 +26,7 @@ namespace net {
 class CryptoHandshakeMessage;
 class EphemeralKeySource;
 class KeyExchange;
+class CommonCertSets;
 class ProofSource;
 class QuicClock;
 class QuicDecrypter;
@@ -316,6 +318,19 @@ class NET_EXPORT_PRIVATE QuicCryptoServerConfig {
     // Smaller numbers mean higher priority.
     uint64 priority;
 
+    // A copy of a certificate chain from the ProofSource, and its signature
+    // of |serialized|.
+    struct Proof {
+      std::vector<std::string> certs;
+      std::string signature;
+    };
+
+    // proofs caches the proofs of |serialized|, keyed by SNI and whether
+    // ECDSA was acceptable, so that they aren't signed again for every
+    // client.
+    base::Lock proofs_lock;
+    base::MRUCache<std::string, Proof> proofs;
+
    private:
     friend class base::RefCounted<Config>;
     virtual ~Config();
@@ -325,6 +340,23 @@ class NET_EXPORT_PRIVATE QuicCryptoServerConfig {
 
   typedef std::map<ServerConfigID, scoped_refptr<Config> > ConfigMap;
 
+  // GetProof copies the certificate chain for |sni| from |proof_source_|
+  // and its signature of |config| to the out arguments, reusing the ones in
+  // |config->proofs| if possible.
+  bool GetProof(Config* config,
+                const std::string& sni,
+                bool ecdsa_ok,
+                std::vector<std::string>* out_certs,
+                std::string* out_signature) const;
+
+  // CompressChain returns the result of CertCompressor::CompressChain, from
+  // |compressed_certs_cache_| if the same chain was compressed for a client
+  // with the same common sets and cached certificates before.
+  std::string CompressChain(const std::vector<std::string>& certs,
+                            base::StringPiece client_common_set_hashes,
+                            base::StringPiece client_cached_cert_hashes,
+                            const CommonCertSets* common_sets) const;
+
   // ConfigPrimaryTimeLessThan returns true if a->primary_time <
   // b->primary_time.
   static bool ConfigPrimaryTimeLessThan(const scoped_refptr<Config>& a,
@@ -429,6 +461,11 @@ class NET_EXPORT_PRIVATE QuicCryptoServerConfig {
   // signatures.
   scoped_ptr<ProofSource> proof_source_;
 
+  mutable base::Lock compressed_certs_cache_lock_;
+  // compressed_certs_cache_ maps a certificate chain, and the common sets and
+  // cached certificates that a client has, to the compressed chain.
+  mutable base::MRUCache<std::string, std::string> compressed_certs_cache_;
+
   // ephemeral_key_source_ contains an object that caches ephemeral keys for a
   // short period of time.
   scoped_ptr<EphemeralKeySource> ephemeral_key_source_;
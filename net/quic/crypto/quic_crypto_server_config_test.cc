@@ -8,8 +8,10 @@
 
 #include "base/stl_util.h"
 #include "net/quic/crypto/aes_128_gcm_12_encrypter.h"
+#include "net/quic/crypto/cert_compressor.h"
 #include "net/quic/crypto/crypto_handshake_message.h"
 #include "net/quic/crypto/crypto_server_config_protobuf.h"
+#include "net/quic/crypto/proof_source.h"
 #include "net/quic/crypto/quic_random.h"
 #include "net/quic/crypto/strike_register_client.h"
 #include "net/quic/quic_time.h"
@@ -44,6 +46,32 @@ class QuicCryptoServerConfigPeer {
     return server_config_->ValidateSourceAddressToken(srct, ip, now);
   }
 
+  // GetProof gets a proof of the primary config.
+  bool GetProof(const string& sni,
+                bool ecdsa_ok,
+                vector<string>* out_certs,
+                string* out_signature) {
+    scoped_refptr<QuicCryptoServerConfig::Config> config;
+    {
+      base::AutoLock locked(server_config_->configs_lock_);
+      config = server_config_->primary_config_;
+    }
+    return server_config_->GetProof(config.get(), sni, ecdsa_ok, out_certs,
+                                    out_signature);
+  }
+
+  string CompressChain(const vector<string>& certs,
+                       StringPiece client_common_set_hashes,
+                       StringPiece client_cached_cert_hashes) {
+    return server_config_->CompressChain(certs, client_common_set_hashes,
+                                         client_cached_cert_hashes, NULL);
+  }
+
+  size_t CompressedCertsCacheSize() {
+    base::AutoLock locked(server_config_->compressed_certs_cache_lock_);
+    return server_config_->compressed_certs_cache_.size();
+  }
+
   base::Lock* GetStrikeRegisterClientLock() {
     return &server_config_->strike_register_client_lock_;
   }
@@ -183,6 +211,29 @@ class TestStrikeRegisterClient : public StrikeRegisterClient {
   mutable bool is_known_orbit_called_;
 };
 
+// CountingProofSource signs anything, and counts how often it's asked to.
+class CountingProofSource : public ProofSource {
+ public:
+  explicit CountingProofSource(int* num_proofs) : num_proofs_(num_proofs) {
+    certs_.push_back("certificate");
+  }
+
+  virtual bool GetProof(const string& hostname,
+                        const string& server_config,
+                        bool ecdsa_ok,
+                        const vector<string>** out_certs,
+                        string* out_signature) OVERRIDE {
+    ++*num_proofs_;
+    *out_certs = &certs_;
+    *out_signature = hostname + (ecdsa_ok ? " ecdsa" : " rsa");
+    return true;
+  }
+
+ private:
+  int* num_proofs_;
+  vector<string> certs_;
+};
+
 TEST(QuicCryptoServerConfigTest, ServerConfig) {
   QuicRandom* rand = QuicRandom::GetInstance();
   QuicCryptoServerConfig server(QuicCryptoServerConfig::TESTING, rand);
@@ -236,6 +287,85 @@ TEST(QuicCryptoServerConfigTest, SourceAddressTokens) {
   EXPECT_FALSE(peer.ValidateSourceAddressToken(token4, ip4, now));
 }
 
+TEST(QuicCryptoServerConfigTest, ProofsAreCached) {
+  QuicRandom* rand = QuicRandom::GetInstance();
+  QuicCryptoServerConfig server(QuicCryptoServerConfig::TESTING, rand);
+  int num_proofs = 0;
+  server.SetProofSource(new CountingProofSource(&num_proofs));
+  MockClock clock;
+  scoped_ptr<CryptoHandshakeMessage>(
+      server.AddDefaultConfig(rand, &clock,
+                              QuicCryptoServerConfig::ConfigOptions()));
+  QuicCryptoServerConfigPeer peer(&server);
+
+  vector<string> certs;
+  string signature;
+  ASSERT_TRUE(peer.GetProof("a.com", true, &certs, &signature));
+  EXPECT_EQ("a.com ecdsa", signature);
+  certs.clear();
+  ASSERT_TRUE(peer.GetProof("a.com", true, &certs, &signature));
+  EXPECT_EQ("a.com ecdsa", signature);
+  ASSERT_EQ(1u, certs.size());
+  EXPECT_EQ("certificate", certs[0]);
+  EXPECT_EQ(1, num_proofs);
+
+  // Another name, or an RSA only client, needs another proof.
+  ASSERT_TRUE(peer.GetProof("b.com", true, &certs, &signature));
+  EXPECT_EQ("b.com ecdsa", signature);
+  ASSERT_TRUE(peer.GetProof("a.com", false, &certs, &signature));
+  EXPECT_EQ("a.com rsa", signature);
+  EXPECT_EQ(3, num_proofs);
+}
+
+TEST(QuicCryptoServerConfigTest, CompressedCertsAreCached) {
+  QuicRandom* rand = QuicRandom::GetInstance();
+  QuicCryptoServerConfig server(QuicCryptoServerConfig::TESTING, rand);
+  QuicCryptoServerConfigPeer peer(&server);
+
+  vector<string> certs;
+  certs.push_back("leaf certificate");
+  certs.push_back("intermediate certificate");
+  const string cached_hashes(8, 'x');
+  const string compressed = CertCompressor::CompressChain(
+      certs, StringPiece(), cached_hashes, NULL);
+
+  EXPECT_EQ(compressed, peer.CompressChain(certs, StringPiece(),
+                                           cached_hashes));
+  EXPECT_EQ(compressed, peer.CompressChain(certs, StringPiece(),
+                                           cached_hashes));
+  EXPECT_EQ(1u, peer.CompressedCertsCacheSize());
+
+  // The client's cached certificates are part of the key.
+  EXPECT_EQ(CertCompressor::CompressChain(certs, StringPiece(), StringPiece(),
+                                          NULL),
+            peer.CompressChain(certs, StringPiece(), StringPiece()));
+  EXPECT_EQ(2u, peer.CompressedCertsCacheSize());
+
+  // So is the chain.
+  certs[1] = "another intermediate certificate";
+  EXPECT_EQ(CertCompressor::CompressChain(certs, StringPiece(), cached_hashes,
+                                          NULL),
+            peer.CompressChain(certs, StringPiece(), cached_hashes));
+  EXPECT_EQ(3u, peer.CompressedCertsCacheSize());
+
+  // Chains with the same bytes, split into certificates differently, don't
+  // share an entry.
+  vector<string> split_certs;
+  split_certs.push_back("ab");
+  split_certs.push_back("c");
+  vector<string> other_split_certs;
+  other_split_certs.push_back("a");
+  other_split_certs.push_back("bc");
+  EXPECT_EQ(CertCompressor::CompressChain(split_certs, StringPiece(),
+                                          StringPiece(), NULL),
+            peer.CompressChain(split_certs, StringPiece(), StringPiece()));
+  EXPECT_EQ(CertCompressor::CompressChain(other_split_certs, StringPiece(),
+                                          StringPiece(), NULL),
+            peer.CompressChain(other_split_certs, StringPiece(),
+                               StringPiece()));
+  EXPECT_EQ(5u, peer.CompressedCertsCacheSize());
+}
+
 class CryptoServerConfigsTest : public ::testing::Test {
  public:
   CryptoServerConfigsTest()
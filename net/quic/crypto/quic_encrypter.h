@@ -58,6 +58,16 @@ class NET_EXPORT_PRIVATE QuicEncrypter {
                                   base::StringPiece associated_data,
                                   base::StringPiece plaintext) = 0;
 
+  // Like EncryptPacket(), but writes the result to |output|, which must point
+  // to a buffer that is at least |GetCiphertextSize(plaintext.size())| bytes
+  // long, so that it can go straight into the packet being sent. Returns false
+  // if there is an error. The default implementation copies the result of
+  // EncryptPacket().
+  virtual bool EncryptPacketToBuffer(QuicPacketSequenceNumber sequence_number,
+                                     base::StringPiece associated_data,
+                                     base::StringPiece plaintext,
+                                     char* output);
+
   // GetKeySize() and GetNoncePrefixSize() tell the HKDF class how many bytes
   // of key material needs to be derived from the master secret.
   // NOTE: the sizes returned by GetKeySize() and GetNoncePrefixSize() are
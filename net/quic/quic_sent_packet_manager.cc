@@ -6,6 +6,7 @@
 
 #include "base/logging.h"
 #include "base/stl_util.h"
+#include "net/quic/congestion_control/bbr_sender.h"
 #include "net/quic/congestion_control/pacing_sender.h"
 #include "net/quic/crypto/crypto_protocol.h"
 #include "net/quic/quic_ack_notifier_manager.h"
@@ -31,6 +32,11 @@ bool FLAGS_track_retransmission_history = false;
 // request pacing for the server to enable it.
 bool FLAGS_enable_quic_pacing = false;
 
+// If true, QUIC connections will support BbrSender, which models the path's
+// bottleneck bandwidth and RTT instead of reacting to losses.  Like pacing, it
+// has to be requested by the client.
+bool FLAGS_enable_quic_bbr = false;
+
 namespace net {
 namespace {
 static const int kDefaultRetransmissionTimeMs = 500;
@@ -100,6 +106,9 @@ void QuicSentPacketManager::SetFromConfig(const QuicConfig& config) {
   if (config.congestion_control() == kPACE) {
     MaybeEnablePacing();
   }
+  if (config.congestion_control() == kTBBR) {
+    MaybeEnableBbr();
+  }
   send_algorithm_->SetFromConfig(config, is_server_);
 }
 
@@ -168,6 +177,10 @@ void QuicSentPacketManager::HandleAckForSentPackets(
     const ReceivedPacketInfo& received_info) {
   // Go through the packets we have not received an ack for and see if this
   // incoming_ack shows they've been seen by the peer.
+  // Both the unacked packets and the missing packets are in increasing
+  // sequence number order, so they're walked together.
+  SequenceNumberSet::const_iterator missing_it =
+      received_info.missing_packets.begin();
   QuicUnackedPacketMap::const_iterator it = unacked_packets_.begin();
   while (it != unacked_packets_.end()) {
     QuicPacketSequenceNumber sequence_number = it->first;
@@ -176,7 +189,12 @@ void QuicSentPacketManager::HandleAckForSentPackets(
       break;
     }
 
-    if (IsAwaitingPacket(received_info, sequence_number)) {
+    while (missing_it != received_info.missing_packets.end() &&
+           *missing_it < sequence_number) {
+      ++missing_it;
+    }
+    if (missing_it != received_info.missing_packets.end() &&
+        *missing_it == sequence_number) {
       ++it;
       continue;
     }
@@ -307,6 +325,18 @@ QuicSentPacketManager::MarkPacketHandled(
 
 
   SequenceNumberSet all_transmissions = *transmission_info.all_transmissions;
+
+  // Unacked packets are in increasing sequence number order.  Only the
+  // transmissions of this packet can be removed, so the first other packet
+  // after it stays where it is and bounds the search for the next unacked
+  // packet once this one is handled.
+  QuicUnackedPacketMap::const_iterator next_other =
+      unacked_packets_.Find(sequence_number);
+  while (next_other != unacked_packets_.end() &&
+         ContainsKey(all_transmissions, next_other->first)) {
+    ++next_other;
+  }
+
   SequenceNumberSet::reverse_iterator all_transmissions_it =
       all_transmissions.rbegin();
   QuicPacketSequenceNumber newest_transmission = *all_transmissions_it;
@@ -344,12 +374,19 @@ QuicSentPacketManager::MarkPacketHandled(
     ++all_transmissions_it;
   }
 
-  QuicUnackedPacketMap::const_iterator next_unacked = unacked_packets_.begin();
-  while (next_unacked != unacked_packets_.end() &&
-         next_unacked->first < sequence_number) {
-    ++next_unacked;
+  // Transmissions between this packet and |next_other| which were only
+  // neutered are still unacked, and come first.
+  for (SequenceNumberSet::const_iterator it =
+           all_transmissions.lower_bound(sequence_number);
+       it != all_transmissions.end(); ++it) {
+    if (next_other != unacked_packets_.end() && *it > next_other->first) {
+      break;
+    }
+    if (unacked_packets_.IsUnacked(*it)) {
+      return unacked_packets_.Find(*it);
+    }
   }
-  return next_unacked;
+  return next_other;
 }
 
 bool QuicSentPacketManager::IsUnacked(
@@ -770,4 +807,15 @@ void QuicSentPacketManager::MaybeEnablePacing() {
                        QuicTime::Delta::FromMicroseconds(1)));
 }
 
+void QuicSentPacketManager::MaybeEnableBbr() {
+  if (!FLAGS_enable_quic_bbr) {
+    return;
+  }
+
+  // The initial RTT isn't passed on, since it would be taken as the path's
+  // minimum RTT until real samples replace it.
+  DCHECK(!using_pacing_);
+  send_algorithm_.reset(new BbrSender(clock_));
+}
+
 }  // namespace net
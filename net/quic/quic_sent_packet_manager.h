@@ -23,6 +23,7 @@
 
 NET_EXPORT_PRIVATE extern bool FLAGS_track_retransmission_history;
 NET_EXPORT_PRIVATE extern bool FLAGS_enable_quic_pacing;
+NET_EXPORT_PRIVATE extern bool FLAGS_enable_quic_bbr;
 
 namespace net {
 
@@ -165,6 +166,10 @@ class NET_EXPORT_PRIVATE QuicSentPacketManager {
 
   bool using_pacing() const { return using_pacing_; }
 
+  // Replaces the send algorithm with a BbrSender if FLAGS_enable_quic_bbr is
+  // set.  BbrSender paces by itself.
+  void MaybeEnableBbr();
+
  private:
   friend class test::QuicConnectionPeer;
   friend class test::QuicSentPacketManagerPeer;
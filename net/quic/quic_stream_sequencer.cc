@@ -225,9 +225,7 @@ int QuicStreamSequencer::Readv(const struct iovec* iov, size_t iov_len) {
   }
   // We've finished copying.  If we have a partial frame, update it.
   if (frame_offset != 0) {
-    frames_.insert(make_pair(it->first + frame_offset,
-                             it->second.substr(frame_offset)));
-    frames_.erase(frames_.begin());
+    TrimFrame(it, frame_offset);
     RecordBytesConsumed(frame_offset);
   }
   return num_bytes_consumed_ - initial_bytes_consumed;
@@ -259,8 +257,7 @@ void QuicStreamSequencer::MarkConsumed(size_t num_bytes_consumed) {
     // Partially consume this frame.
     size_t delta = end_offset - it->first;
     RecordBytesConsumed(delta);
-    frames_.insert(make_pair(end_offset, it->second.substr(delta)));
-    frames_.erase(it);
+    TrimFrame(it, delta);
     break;
   }
 }
@@ -307,9 +304,7 @@ void QuicStreamSequencer::FlushBufferedFrames() {
       frames_.erase(it);
       it = frames_.find(num_bytes_consumed_);
     } else {
-      string new_data = it->second.substr(bytes_consumed);
-      frames_.erase(it);
-      frames_.insert(make_pair(num_bytes_consumed_, new_data));
+      TrimFrame(it, bytes_consumed);
       return;
     }
   }
@@ -321,4 +316,14 @@ void QuicStreamSequencer::RecordBytesConsumed(size_t bytes_consumed) {
   num_bytes_buffered_ -= bytes_consumed;
 }
 
+void QuicStreamSequencer::TrimFrame(FrameMap::iterator it, size_t num_bytes) {
+  DCHECK_LT(num_bytes, it->second.size());
+  QuicStreamOffset new_offset = it->first + num_bytes;
+  string data;
+  data.swap(it->second);
+  frames_.erase(it);
+  data.erase(0, num_bytes);
+  frames_[new_offset].swap(data);
+}
+
 }  // namespace net
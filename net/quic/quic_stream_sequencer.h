@@ -95,15 +95,21 @@ class NET_EXPORT_PRIVATE QuicStreamSequencer {
   // num_bytes_consumed_ and num_bytes_buffered_.
   void RecordBytesConsumed(size_t bytes_consumed);
 
+  // TODO(alyssar) use something better than strings.
+  typedef map<QuicStreamOffset, string> FrameMap;
+
+  // Removes the first |num_bytes| bytes of the frame at |it|, which have been
+  // consumed, and buffers the rest of the frame at its new offset.  The
+  // remaining data stays in the frame's string rather than being copied to a
+  // new one.
+  void TrimFrame(FrameMap::iterator it, size_t num_bytes);
+
   // The stream which owns this sequencer.
   ReliableQuicStream* stream_;
 
   // The last data consumed by the stream.
   QuicStreamOffset num_bytes_consumed_;
 
-  // TODO(alyssar) use something better than strings.
-  typedef map<QuicStreamOffset, string> FrameMap;
-
   // Stores buffered frames (maps from sequence number -> frame data as string).
   FrameMap frames_;
 
@@ -124,6 +124,12 @@ class NET_EXPORT_PRIVATE QuicUnackedPacketMap {
   const_iterator begin() const { return unacked_packets_.begin(); }
   const_iterator end() const { return unacked_packets_.end(); }
 
+  // Returns the unacked packet |sequence_number|, or end() if it isn't
+  // unacked.
+  const_iterator Find(QuicPacketSequenceNumber sequence_number) const {
+    return unacked_packets_.find(sequence_number);
+  }
+
   // Returns true if there are unacked packets that are pending.
   bool HasPendingPackets() const;
 
@@ -32,7 +32,8 @@ void HttpConnection::Send(const HttpServerResponseInfo& response) {
 HttpConnection::HttpConnection(HttpServer* server,
                                scoped_ptr<StreamListenSocket> sock)
     : server_(server),
-      socket_(sock.Pass()) {
+      socket_(sock.Pass()),
+      headers_end_search_start_(0) {
   id_ = last_id_++;
 }
 
@@ -41,7 +42,8 @@ HttpConnection::~HttpConnection() {
 }
 
 void HttpConnection::Shift(int num_bytes) {
-  recv_data_ = recv_data_.substr(num_bytes);
+  recv_data_.erase(0, num_bytes);
+  headers_end_search_start_ = 0;
 }
 
 }  // namespace net
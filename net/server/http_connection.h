@@ -41,6 +41,9 @@ class HttpConnection {
   scoped_ptr<StreamListenSocket> socket_;
   scoped_ptr<WebSocket> web_socket_;
   std::string recv_data_;
+  // The offset in |recv_data_| from which to look for the end of the headers
+  // of the next request, the data before it having been searched already.
+  size_t headers_end_search_start_;
   int id_;
   DISALLOW_COPY_AND_ASSIGN(HttpConnection);
 };
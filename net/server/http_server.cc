@@ -21,6 +21,24 @@
 
 namespace net {
 
+namespace {
+
+// Returns true if |data| may hold all the headers of a request, i.e. if the
+// parser could reach the end of an empty line. Only looks from
+// |*search_start| on, and updates it for the next call.
+bool MayHaveHeadersEnd(const std::string& data, size_t* search_start) {
+  // An empty line is a CR right after a LF, followed by the LF that the parser
+  // reads once done.
+  size_t pos = data.find("\n\r", *search_start);
+  if (pos != std::string::npos && pos + 2 < data.size())
+    return true;
+  // The end may straddle the data to come.
+  *search_start = data.size() > 2 ? data.size() - 2 : 0;
+  return false;
+}
+
+}  // namespace
+
 HttpServer::HttpServer(const StreamListenSocketFactory& factory,
                        HttpServer::Delegate* delegate)
     : delegate_(delegate),
@@ -127,6 +145,12 @@ void HttpServer::DidRead(StreamListenSocket* socket,
       continue;
     }
 
+    // Don't parse the headers again and again as they trickle in.
+    if (!MayHaveHeadersEnd(connection->recv_data_,
+                           &connection->headers_end_search_start_)) {
+      break;
+    }
+
     HttpServerRequestInfo request;
     size_t pos = 0;
     if (!ParseHeaders(connection, &request, &pos))
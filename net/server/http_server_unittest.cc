@@ -293,6 +293,22 @@ TEST_F(HttpServerTest, RequestWithBodySplitAcrossPackets) {
   ASSERT_EQ(body, requests_[0].data);
 }
 
+TEST_F(HttpServerTest, RequestSplitIntoSingleBytes) {
+  StreamListenSocket* socket =
+      new MockStreamListenSocket(server_.get());
+  server_->DidAccept(NULL, make_scoped_ptr(socket));
+  std::string request =
+      "GET /test HTTP/1.1\r\n"
+      "SomeHeader: 1\r\n\r\n"
+      "GET /test2 HTTP/1.1\r\n\r\n";
+  for (size_t i = 0; i < request.length(); ++i)
+    server_->DidRead(socket, request.c_str() + i, 1);
+  ASSERT_EQ(2u, requests_.size());
+  EXPECT_EQ("/test", requests_[0].path);
+  EXPECT_EQ("1", requests_[0].GetHeaderValue("someheader"));
+  EXPECT_EQ("/test2", requests_[1].path);
+}
+
 TEST_F(HttpServerTest, MultipleRequestsOnSameConnection) {
   // The idea behind this test is that requests with or without bodies should
   // not break parsing of the next request.
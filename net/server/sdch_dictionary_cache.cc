@@ -0,0 +1,111 @@
+// Copyright 2014 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "net/server/sdch_dictionary_cache.h"
+
+#include <vector>
+
+#include "base/logging.h"
+#include "base/strings/string_split.h"
+#include "base/strings/string_util.h"
+#include "net/base/sdch_manager.h"
+#include "sdch/open-vcdiff/src/google/vcencoder.h"
+
+namespace net {
+
+SdchDictionaryCache::Dictionary::Dictionary() {
+}
+
+SdchDictionaryCache::Dictionary::~Dictionary() {
+}
+
+SdchDictionaryCache::SdchDictionaryCache() {
+}
+
+SdchDictionaryCache::~SdchDictionaryCache() {
+}
+
+bool SdchDictionaryCache::AddDictionary(const std::string& dictionary_text,
+                                        std::string* client_hash,
+                                        std::string* server_hash) {
+  // Like SdchManager::Dictionary, only what follows the headers is used to
+  // encode, but the hashes cover it all.
+  size_t header_end = dictionary_text.find("\n\n");
+  if (header_end == std::string::npos) {
+    DVLOG(1) << "SDCH dictionary has no header";
+    return false;
+  }
+
+  std::string client;
+  std::string server;
+  SdchManager::GenerateHash(dictionary_text, &client, &server);
+  if (dictionaries_.find(server) != dictionaries_.end())
+    return false;
+
+  const char* contents = dictionary_text.data() + header_end + 2;
+  linked_ptr<open_vcdiff::HashedDictionary> hashed_dictionary(
+      new open_vcdiff::HashedDictionary(
+          contents, dictionary_text.size() - header_end - 2));
+  if (!hashed_dictionary->Init())
+    return false;
+
+  Dictionary& dictionary = dictionaries_[server];
+  dictionary.client_hash = client;
+  dictionary.hashed_dictionary = hashed_dictionary;
+  server_hashes_[client] = server;
+
+  if (client_hash)
+    client_hash->swap(client);
+  if (server_hash)
+    server_hash->swap(server);
+  return true;
+}
+
+bool SdchDictionaryCache::HasDictionary(const std::string& server_hash) const {
+  return dictionaries_.find(server_hash) != dictionaries_.end();
+}
+
+bool SdchDictionaryCache::PickDictionary(const std::string& avail_dictionary,
+                                         std::string* server_hash) const {
+  std::vector<std::string> client_hashes;
+  base::SplitString(avail_dictionary, ',', &client_hashes);
+  for (size_t i = 0; i < client_hashes.size(); ++i) {
+    std::map<std::string, std::string>::const_iterator it =
+        server_hashes_.find(client_hashes[i]);
+    if (it != server_hashes_.end()) {
+      *server_hash = it->second;
+      return true;
+    }
+  }
+  return false;
+}
+
+bool SdchDictionaryCache::Encode(const std::string& server_hash,
+                                 const base::StringPiece& data,
+                                 std::string* output) const {
+  DictionaryMap::const_iterator it = dictionaries_.find(server_hash);
+  if (it == dictionaries_.end())
+    return false;
+
+  // The body starts with the server hash of the dictionary, which SdchFilter
+  // looks up, and a null.
+  size_t initial_size = output->size();
+  output->append(server_hash);
+  output->push_back('\0');
+
+  // The encoders only keep the state of one response, and are cheap to make;
+  // the state built from the dictionary is shared.
+  open_vcdiff::VCDiffStreamingEncoder encoder(
+      it->second.hashed_dictionary.get(), open_vcdiff::VCD_STANDARD_FORMAT,
+      false /* look_for_target_matches */);
+  if (!encoder.StartEncoding(output) ||
+      !encoder.EncodeChunk(data.data(), data.size(), output) ||
+      !encoder.FinishEncoding(output)) {
+    output->resize(initial_size);
+    return false;
+  }
+  return true;
+}
+
+}  // namespace net
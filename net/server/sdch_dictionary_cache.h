@@ -0,0 +1,79 @@
+// Copyright 2014 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef NET_SERVER_SDCH_DICTIONARY_CACHE_H_
+#define NET_SERVER_SDCH_DICTIONARY_CACHE_H_
+
+#include <map>
+#include <string>
+
+#include "base/basictypes.h"
+#include "base/memory/linked_ptr.h"
+#include "base/strings/string_piece.h"
+
+namespace open_vcdiff {
+class HashedDictionary;
+}
+
+namespace net {
+
+// SdchDictionaryCache holds the SDCH dictionaries that a server offers, and
+// encodes responses with them for the clients that have them, as advertised
+// in their Avail-Dictionary request header.
+//
+// Each dictionary is hashed for the VCDIFF encoder once, when it is added,
+// rather than for every response. Once all the dictionaries are added, the
+// cache can be used to encode responses on any thread.
+class SdchDictionaryCache {
+ public:
+  SdchDictionaryCache();
+  ~SdchDictionaryCache();
+
+  // Adds a dictionary, as served to clients: headers, an empty line, and the
+  // dictionary contents. Sets |client_hash| and |server_hash| if they aren't
+  // NULL. Returns false if the dictionary has no headers or was already added.
+  bool AddDictionary(const std::string& dictionary_text,
+                     std::string* client_hash,
+                     std::string* server_hash);
+
+  // Returns true if there is a dictionary with |server_hash|.
+  bool HasDictionary(const std::string& server_hash) const;
+
+  // Sets |server_hash| to the hash of the first dictionary of the cache listed
+  // in |avail_dictionary|, the comma separated client hashes of the
+  // Avail-Dictionary header. Returns false if there is none.
+  bool PickDictionary(const std::string& avail_dictionary,
+                      std::string* server_hash) const;
+
+  // Encodes |data| with the dictionary with |server_hash|, as the body of a
+  // response with an "sdch" Content-Encoding, and appends it to |output|.
+  // Returns false if there is no such dictionary or the encoding fails.
+  bool Encode(const std::string& server_hash,
+              const base::StringPiece& data,
+              std::string* output) const;
+
+  size_t size() const { return dictionaries_.size(); }
+
+ private:
+  struct Dictionary {
+    Dictionary();
+    ~Dictionary();
+
+    std::string client_hash;
+    linked_ptr<open_vcdiff::HashedDictionary> hashed_dictionary;
+  };
+
+  // Keyed by server hash.
+  typedef std::map<std::string, Dictionary> DictionaryMap;
+  DictionaryMap dictionaries_;
+
+  // Maps the client hashes to the server hashes.
+  std::map<std::string, std::string> server_hashes_;
+
+  DISALLOW_COPY_AND_ASSIGN(SdchDictionaryCache);
+};
+
+}  // namespace net
+
+#endif  // NET_SERVER_SDCH_DICTIONARY_CACHE_H_
@@ -0,0 +1,95 @@
+// Copyright 2014 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "net/server/sdch_dictionary_cache.h"
+
+#include <string>
+
+#include "sdch/open-vcdiff/src/google/vcdecoder.h"
+#include "testing/gtest/include/gtest/gtest.h"
+
+namespace net {
+
+namespace {
+
+const char kDictionaryContents[] =
+    "<html><head><title>Dictionary</title></head><body>"
+    "The quick brown fox jumps over the lazy dog.</body></html>";
+
+std::string MakeDictionary(const std::string& domain) {
+  return "Domain: " + domain + "\nPath: /\n\n" + kDictionaryContents;
+}
+
+}  // namespace
+
+TEST(SdchDictionaryCacheTest, AddDictionary) {
+  SdchDictionaryCache cache;
+  std::string client_hash;
+  std::string server_hash;
+  EXPECT_TRUE(cache.AddDictionary(MakeDictionary("example.com"),
+                                  &client_hash, &server_hash));
+  EXPECT_EQ(8u, client_hash.size());
+  EXPECT_EQ(8u, server_hash.size());
+  EXPECT_TRUE(cache.HasDictionary(server_hash));
+  EXPECT_FALSE(cache.HasDictionary(client_hash));
+
+  // Already there.
+  EXPECT_FALSE(cache.AddDictionary(MakeDictionary("example.com"),
+                                   NULL, NULL));
+  // No headers.
+  EXPECT_FALSE(cache.AddDictionary(kDictionaryContents, NULL, NULL));
+  EXPECT_EQ(1u, cache.size());
+}
+
+TEST(SdchDictionaryCacheTest, PickDictionary) {
+  SdchDictionaryCache cache;
+  std::string client_hash1, server_hash1;
+  std::string client_hash2, server_hash2;
+  ASSERT_TRUE(cache.AddDictionary(MakeDictionary("a.com"),
+                                  &client_hash1, &server_hash1));
+  ASSERT_TRUE(cache.AddDictionary(MakeDictionary("b.com"),
+                                  &client_hash2, &server_hash2));
+
+  std::string server_hash;
+  EXPECT_FALSE(cache.PickDictionary(std::string(), &server_hash));
+  EXPECT_FALSE(cache.PickDictionary("AAAAAAAA,BBBBBBBB", &server_hash));
+
+  EXPECT_TRUE(cache.PickDictionary(client_hash2, &server_hash));
+  EXPECT_EQ(server_hash2, server_hash);
+  EXPECT_TRUE(cache.PickDictionary(
+      "AAAAAAAA, " + client_hash1 + ", " + client_hash2, &server_hash));
+  EXPECT_EQ(server_hash1, server_hash);
+}
+
+TEST(SdchDictionaryCacheTest, EncodeRoundTrip) {
+  SdchDictionaryCache cache;
+  std::string server_hash;
+  ASSERT_TRUE(cache.AddDictionary(MakeDictionary("example.com"),
+                                  NULL, &server_hash));
+
+  const std::string data =
+      "<html><head><title>Page</title></head><body>"
+      "The quick brown fox jumps over the lazy cat.</body></html>";
+  std::string encoded;
+  EXPECT_FALSE(cache.Encode("AAAAAAAA", data, &encoded));
+  EXPECT_TRUE(encoded.empty());
+  ASSERT_TRUE(cache.Encode(server_hash, data, &encoded));
+
+  // The body starts with the server hash, as SdchFilter expects.
+  ASSERT_GT(encoded.size(), server_hash.size() + 1);
+  EXPECT_EQ(server_hash, encoded.substr(0, server_hash.size()));
+  EXPECT_EQ('\0', encoded[server_hash.size()]);
+  std::string vcdiff = encoded.substr(server_hash.size() + 1);
+  EXPECT_LT(vcdiff.size(), data.size());
+
+  open_vcdiff::VCDiffStreamingDecoder decoder;
+  std::string decoded;
+  decoder.StartDecoding(kDictionaryContents,
+                        arraysize(kDictionaryContents) - 1);
+  ASSERT_TRUE(decoder.DecodeChunk(vcdiff.data(), vcdiff.size(), &decoded));
+  ASSERT_TRUE(decoder.FinishDecoding());
+  EXPECT_EQ(data, decoded);
+}
+
+}  // namespace net
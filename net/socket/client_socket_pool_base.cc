@@ -4,6 +4,8 @@
 
 #include "net/socket/client_socket_pool_base.h"
 
+#include <algorithm>
+
 #include "base/compiler_specific.h"
 #include "base/format_macros.h"
 #include "base/logging.h"
@@ -39,6 +41,20 @@ const int kCleanupInterval = 10;  // DO NOT INCREASE THIS TIMEOUT.
 // after a certain timeout has passed without receiving an ACK.
 bool g_connect_backup_jobs_enabled = true;
 
+// Whether pools that support it learn from the past use of their groups. See
+// ClientSocketPoolBaseHelper::EnablePredictiveWarming().
+bool g_predictive_warming_enabled = false;
+
+// The number of groups whose history is kept after they go away.
+const size_t kMaxGroupHistories = 256;
+
+// Idle socket timeouts aren't adjusted until this many idle sockets of the
+// group were reused or timed out.
+const int kMinIdleSocketOutcomes = 4;
+
+// The weight of the latest outcome in the idle socket reuse rate.
+const double kIdleSocketOutcomeWeight = 0.25;
+
 }  // namespace
 
 ConnectJob::ConnectJob(const std::string& group_name,
@@ -164,6 +180,8 @@ ClientSocketPoolBaseHelper::ClientSocketPoolBaseHelper(
       used_idle_socket_timeout_(used_idle_socket_timeout),
       connect_job_factory_(connect_job_factory),
       connect_backup_jobs_enabled_(false),
+      predictive_warming_enabled_(false),
+      group_histories_(kMaxGroupHistories),
       pool_generation_number_(0),
       pool_(pool),
       weak_factory_(this) {
@@ -476,6 +494,7 @@ bool ClientSocketPoolBaseHelper::AssignIdleSocketToRequest(
         base::TimeTicks::Now() - idle_socket_it->start_time;
     IdleSocket idle_socket = *idle_socket_it;
     idle_sockets->erase(idle_socket_it);
+    group->mutable_history()->RecordIdleSocketOutcome(true);
     HandOutSocket(
         scoped_ptr<StreamSocket>(idle_socket.socket),
         idle_socket.socket->WasEverUsed(),
@@ -670,6 +689,10 @@ void ClientSocketPoolBaseHelper::CleanupIdleSockets(bool force) {
       base::TimeDelta timeout =
           j->socket->WasEverUsed() ?
           used_idle_socket_timeout_ : unused_idle_socket_timeout_;
+      if (predictive_warming_enabled_)
+        timeout = group->history().AdjustIdleSocketTimeout(timeout);
+      if (!force && now - j->start_time >= timeout)
+        group->mutable_history()->RecordIdleSocketOutcome(false);
       if (force || j->ShouldCleanup(now, timeout)) {
         delete j->socket;
         j = group->mutable_idle_sockets()->erase(j);
@@ -694,6 +717,15 @@ ClientSocketPoolBaseHelper::Group* ClientSocketPoolBaseHelper::GetOrCreateGroup(
   if (it != group_map_.end())
     return it->second;
   Group* group = new Group;
+  if (predictive_warming_enabled_) {
+    base::MRUCache<std::string, GroupHistory>::iterator history =
+        group_histories_.Peek(group_name);
+    if (history != group_histories_.end()) {
+      *group->mutable_history() = history->second;
+      group->mutable_history()->ResetPeakActiveSocketCount();
+      group_histories_.Erase(history);
+    }
+  }
   group_map_[group_name] = group;
   return group;
 }
@@ -706,6 +738,8 @@ void ClientSocketPoolBaseHelper::RemoveGroup(const std::string& group_name) {
 }
 
 void ClientSocketPoolBaseHelper::RemoveGroup(GroupMap::iterator it) {
+  if (predictive_warming_enabled_)
+    group_histories_.Put(it->first, it->second->history());
   delete it->second;
   group_map_.erase(it);
 }
@@ -726,6 +760,34 @@ void ClientSocketPoolBaseHelper::EnableConnectBackupJobs() {
   connect_backup_jobs_enabled_ = g_connect_backup_jobs_enabled;
 }
 
+// static
+bool ClientSocketPoolBaseHelper::predictive_warming_enabled() {
+  return g_predictive_warming_enabled;
+}
+
+// static
+bool ClientSocketPoolBaseHelper::set_predictive_warming_enabled(bool enabled) {
+  bool old_value = g_predictive_warming_enabled;
+  g_predictive_warming_enabled = enabled;
+  return old_value;
+}
+
+void ClientSocketPoolBaseHelper::EnablePredictiveWarming() {
+  predictive_warming_enabled_ = g_predictive_warming_enabled;
+}
+
+int ClientSocketPoolBaseHelper::NumSocketsToWarm(
+    const std::string& group_name) const {
+  if (!predictive_warming_enabled_ || HasGroup(group_name))
+    return 0;
+  base::MRUCache<std::string, GroupHistory>::const_iterator history =
+      group_histories_.Peek(group_name);
+  if (history == group_histories_.end())
+    return 0;
+  return std::min(history->second.peak_active_socket_count(),
+                  max_sockets_per_group_);
+}
+
 void ClientSocketPoolBaseHelper::IncrementIdleCount() {
   if (++idle_socket_count_ == 1 && use_cleanup_timer_)
     StartIdleSocketTimer();
@@ -1132,6 +1194,40 @@ void ClientSocketPoolBaseHelper::TryToCloseSocketsInLayeredPools() {
   }
 }
 
+ClientSocketPoolBaseHelper::GroupHistory::GroupHistory()
+    : peak_active_socket_count_(0),
+      idle_socket_reuse_rate_(0),
+      idle_socket_outcome_count_(0) {}
+
+void ClientSocketPoolBaseHelper::GroupHistory::RecordActiveSocketCount(
+    int active_socket_count) {
+  peak_active_socket_count_ =
+      std::max(peak_active_socket_count_, active_socket_count);
+}
+
+void ClientSocketPoolBaseHelper::GroupHistory::RecordIdleSocketOutcome(
+    bool reused) {
+  const double outcome = reused ? 1 : 0;
+  if (idle_socket_outcome_count_ == 0) {
+    idle_socket_reuse_rate_ = outcome;
+  } else {
+    idle_socket_reuse_rate_ +=
+        kIdleSocketOutcomeWeight * (outcome - idle_socket_reuse_rate_);
+  }
+  if (idle_socket_outcome_count_ < kMinIdleSocketOutcomes)
+    idle_socket_outcome_count_++;
+}
+
+base::TimeDelta
+ClientSocketPoolBaseHelper::GroupHistory::AdjustIdleSocketTimeout(
+    base::TimeDelta timeout) const {
+  if (idle_socket_outcome_count_ < kMinIdleSocketOutcomes)
+    return timeout;
+  double scale = std::max(0.5, std::min(2.0, 2 * idle_socket_reuse_rate_));
+  return base::TimeDelta::FromMicroseconds(
+      static_cast<int64>(timeout.InMicroseconds() * scale));
+}
+
 ClientSocketPoolBaseHelper::Group::Group()
     : unassigned_job_count_(0),
       pending_requests_(NUM_PRIORITIES),
@@ -31,6 +31,7 @@
 #include <vector>
 
 #include "base/basictypes.h"
+#include "base/containers/mru_cache.h"
 #include "base/memory/ref_counted.h"
 #include "base/memory/scoped_ptr.h"
 #include "base/memory/weak_ptr.h"
@@ -325,6 +326,20 @@ class NET_EXPORT_PRIVATE ClientSocketPoolBaseHelper
 
   void EnableConnectBackupJobs();
 
+  static bool predictive_warming_enabled();
+  static bool set_predictive_warming_enabled(bool enabled);
+
+  // With predictive warming, the pool remembers how groups were used after
+  // they go away. When a request comes for a group that doesn't exist, as
+  // many sockets as the group last had in use are connected, and idle sockets
+  // are kept for longer in groups whose idle sockets usually get reused.
+  void EnablePredictiveWarming();
+
+  // Returns the number of sockets to connect ahead of demand, which is more
+  // than one only if |group_name| has no sockets and more were needed the last
+  // time it did.
+  int NumSocketsToWarm(const std::string& group_name) const;
+
   // ConnectJob::Delegate methods:
   virtual void OnConnectJobComplete(int result, ConnectJob* job) OVERRIDE;
 
@@ -355,6 +370,33 @@ class NET_EXPORT_PRIVATE ClientSocketPoolBaseHelper
   typedef PriorityQueue<const Request*> RequestQueue;
   typedef std::map<const ClientSocketHandle*, const Request*> RequestMap;
 
+  // What's known about how a group was used, kept after the group goes away
+  // when predictive warming is enabled.
+  class GroupHistory {
+   public:
+    GroupHistory();
+
+    void RecordActiveSocketCount(int active_socket_count);
+    void RecordIdleSocketOutcome(bool reused);
+
+    // Returns |timeout| scaled by how often idle sockets of the group were
+    // reused: up to twice as long if they always were, down to half as long
+    // if they never were.
+    base::TimeDelta AdjustIdleSocketTimeout(base::TimeDelta timeout) const;
+
+    int peak_active_socket_count() const { return peak_active_socket_count_; }
+
+    // Forgets the peak, before the group starts over.
+    void ResetPeakActiveSocketCount() { peak_active_socket_count_ = 0; }
+
+   private:
+    int peak_active_socket_count_;
+    // A moving average of whether idle sockets were reused (1) or timed out
+    // (0), over |idle_socket_outcome_count_| outcomes.
+    double idle_socket_reuse_rate_;
+    int idle_socket_outcome_count_;
+  };
+
   // A Group is allocated per group_name when there are idle sockets or pending
   // requests.  Otherwise, the Group object is removed from the map.
   // |active_socket_count| tracks the number of sockets held by clients.
@@ -438,7 +480,10 @@ class NET_EXPORT_PRIVATE ClientSocketPoolBaseHelper
     scoped_ptr<const Request> FindAndRemovePendingRequest(
         ClientSocketHandle* handle);
 
-    void IncrementActiveSocketCount() { active_socket_count_++; }
+    void IncrementActiveSocketCount() {
+      active_socket_count_++;
+      history_.RecordActiveSocketCount(active_socket_count_);
+    }
     void DecrementActiveSocketCount() { active_socket_count_--; }
 
     int unassigned_job_count() const { return unassigned_job_count_; }
@@ -447,6 +492,9 @@ class NET_EXPORT_PRIVATE ClientSocketPoolBaseHelper
     int active_socket_count() const { return active_socket_count_; }
     std::list<IdleSocket>* mutable_idle_sockets() { return &idle_sockets_; }
 
+    const GroupHistory& history() const { return history_; }
+    GroupHistory* mutable_history() { return &history_; }
+
    private:
     // Returns the iterator's pending request after removing it from
     // the queue.
@@ -474,6 +522,7 @@ class NET_EXPORT_PRIVATE ClientSocketPoolBaseHelper
     std::set<ConnectJob*> jobs_;
     RequestQueue pending_requests_;
     int active_socket_count_;  // number of active sockets used by clients
+    GroupHistory history_;
     // A timer for when to start the backup job.
     base::OneShotTimer<Group> backup_job_timer_;
   };
@@ -625,6 +674,11 @@ class NET_EXPORT_PRIVATE ClientSocketPoolBaseHelper
   // TODO(vandebo) Remove when backup jobs move to TransportClientSocketPool
   bool connect_backup_jobs_enabled_;
 
+  bool predictive_warming_enabled_;
+  // The histories of groups that went away, when predictive warming is
+  // enabled.
+  base::MRUCache<std::string, GroupHistory> group_histories_;
+
   // A unique id for the pool.  It gets incremented every time we
   // FlushWithError() the pool.  This is so that when sockets get released back
   // to the pool, we can make sure that they are discarded rather than reused.
@@ -735,10 +789,14 @@ class ClientSocketPoolBase {
                     internal::ClientSocketPoolBaseHelper::NORMAL,
                     params->ignore_limits(),
                     params, net_log));
-    return helper_.RequestSocket(
+    const int num_sockets_to_warm = helper_.NumSocketsToWarm(group_name);
+    int rv = helper_.RequestSocket(
         group_name,
         request.template PassAs<
             const internal::ClientSocketPoolBaseHelper::Request>());
+    if (num_sockets_to_warm > 1 && (rv == OK || rv == ERR_IO_PENDING))
+      RequestSockets(group_name, params, num_sockets_to_warm, net_log);
+    return rv;
   }
 
   // RequestSockets bundles up the parameters into a Request and then forwards
@@ -825,6 +883,8 @@ class ClientSocketPoolBase {
 
   void EnableConnectBackupJobs() { helper_.EnableConnectBackupJobs(); }
 
+  void EnablePredictiveWarming() { helper_.EnablePredictiveWarming(); }
+
   bool CloseOneIdleSocket() { return helper_.CloseOneIdleSocket(); }
 
   bool CloseOneIdleConnectionInHigherLayeredPool() {
@@ -591,6 +591,8 @@ class TestClientSocketPool : public ClientSocketPool {
 
   void EnableConnectBackupJobs() { base_.EnableConnectBackupJobs(); }
 
+  void EnablePredictiveWarming() { base_.EnablePredictiveWarming(); }
+
   bool CloseOneIdleConnectionInHigherLayeredPool() {
     return base_.CloseOneIdleConnectionInHigherLayeredPool();
   }
@@ -669,6 +671,9 @@ class ClientSocketPoolBaseTest : public testing::Test {
     internal::ClientSocketPoolBaseHelper::set_connect_backup_jobs_enabled(true);
     cleanup_timer_enabled_ =
         internal::ClientSocketPoolBaseHelper::cleanup_timer_enabled();
+    predictive_warming_enabled_ =
+        internal::ClientSocketPoolBaseHelper::set_predictive_warming_enabled(
+            true);
   }
 
   virtual ~ClientSocketPoolBaseTest() {
@@ -676,6 +681,8 @@ class ClientSocketPoolBaseTest : public testing::Test {
         connect_backup_jobs_enabled_);
     internal::ClientSocketPoolBaseHelper::set_cleanup_timer_enabled(
         cleanup_timer_enabled_);
+    internal::ClientSocketPoolBaseHelper::set_predictive_warming_enabled(
+        predictive_warming_enabled_);
   }
 
   void CreatePool(int max_sockets, int max_sockets_per_group) {
@@ -733,6 +740,7 @@ class ClientSocketPoolBaseTest : public testing::Test {
   CapturingNetLog net_log_;
   bool connect_backup_jobs_enabled_;
   bool cleanup_timer_enabled_;
+  bool predictive_warming_enabled_;
   MockClientSocketFactory client_socket_factory_;
   TestConnectJobFactory* connect_job_factory_;
   scoped_refptr<TestSocketParams> params_;
@@ -4062,6 +4070,37 @@ TEST_F(ClientSocketPoolBaseTest, IgnoreLimitsCancelOtherJob) {
   EXPECT_FALSE(request(1)->have_result());
 }
 
+// A group that needed several sockets gets that many connected as soon as it's
+// used again after going away.
+TEST_F(ClientSocketPoolBaseTest, PredictiveWarming) {
+  CreatePool(kDefaultMaxSockets, 4);
+  pool_->EnablePredictiveWarming();
+
+  EXPECT_EQ(OK, StartRequest("a", DEFAULT_PRIORITY));
+  EXPECT_EQ(OK, StartRequest("a", DEFAULT_PRIORITY));
+  EXPECT_EQ(OK, StartRequest("a", DEFAULT_PRIORITY));
+  EXPECT_EQ(OK, StartRequest("b", DEFAULT_PRIORITY));
+  ReleaseAllConnections(ClientSocketPoolTest::KEEP_ALIVE);
+  base::MessageLoop::current()->RunUntilIdle();
+  pool_->CloseIdleSockets();
+  ASSERT_FALSE(pool_->HasGroup("a"));
+  ASSERT_FALSE(pool_->HasGroup("b"));
+
+  connect_job_factory_->set_job_type(TestConnectJob::kMockPendingJob);
+  EXPECT_EQ(ERR_IO_PENDING, StartRequest("a", DEFAULT_PRIORITY));
+  EXPECT_EQ(3, pool_->NumConnectJobsInGroup("a"));
+  EXPECT_EQ(2, pool_->NumUnassignedConnectJobsInGroup("a"));
+
+  // A group that never had more than one socket only gets what's requested.
+  EXPECT_EQ(ERR_IO_PENDING, StartRequest("b", DEFAULT_PRIORITY));
+  EXPECT_EQ(1, pool_->NumConnectJobsInGroup("b"));
+
+  // Nor does a group that still exists.
+  EXPECT_EQ(ERR_IO_PENDING, StartRequest("a", DEFAULT_PRIORITY));
+  EXPECT_EQ(3, pool_->NumConnectJobsInGroup("a"));
+  EXPECT_EQ(1, pool_->NumUnassignedConnectJobsInGroup("a"));
+}
+
 }  // namespace
 
 }  // namespace net
@@ -140,7 +140,9 @@ void StreamListenSocket::SendInternal(const char* bytes, int len) {
 }
 
 void StreamListenSocket::Listen() {
-  int backlog = 10;  // TODO(erikkay): maybe don't allow any backlog?
+  // Servers like HttpServer can get bursts of hundreds of connections, which
+  // a short backlog would refuse.
+  int backlog = SOMAXCONN;
   if (listen(socket_, backlog) == -1) {
     // TODO(erikkay): error handling.
     LOG(ERROR) << "Could not listen on socket.";
@@ -5,6 +5,7 @@
 #include "net/socket/transport_client_socket_pool.h"
 
 #include <algorithm>
+#include <vector>
 
 #include "base/compiler_specific.h"
 #include "base/lazy_instance.h"
@@ -28,11 +29,15 @@ using base::TimeDelta;
 
 namespace net {
 
-// TODO(willchan): Base this off RTT instead of statically setting it. Note we
-// choose a timeout that is different from the backup connect job timer so they
-// don't synchronize.
+// This is only used until there is a connect time estimate. Note we choose a
+// timeout that is different from the backup connect job timer so they don't
+// synchronize.
 const int TransportConnectJob::kIPv6FallbackTimerInMs = 300;
 
+const int TransportConnectRaceHistory::kMinFallbackDelayInMs = 50;
+const int TransportConnectRaceHistory::kMaxFallbackDelayInMs =
+    TransportConnectJob::kIPv6FallbackTimerInMs;
+
 namespace {
 
 // Returns true iff all addresses in |list| are in the IPv6 family.
@@ -46,8 +51,56 @@ bool AddressListOnlyContainsIPv6(const AddressList& list) {
   return true;
 }
 
+// The weight of the latest connect time in the smoothed connect time.
+const double kConnectDurationWeight = 0.125;
+
 }  // namespace
 
+TransportConnectRaceHistory::TransportConnectRaceHistory()
+    : fallback_won_last_race_(false) {
+  NetworkChangeNotifier::AddIPAddressObserver(this);
+}
+
+TransportConnectRaceHistory::~TransportConnectRaceHistory() {
+  NetworkChangeNotifier::RemoveIPAddressObserver(this);
+}
+
+base::TimeDelta TransportConnectRaceHistory::GetFallbackDelay() const {
+  if (fallback_won_last_race_)
+    return base::TimeDelta();
+  if (smoothed_connect_duration_ == base::TimeDelta()) {
+    return base::TimeDelta::FromMilliseconds(
+        TransportConnectJob::kIPv6FallbackTimerInMs);
+  }
+  return std::max(
+      base::TimeDelta::FromMilliseconds(kMinFallbackDelayInMs),
+      std::min(base::TimeDelta::FromMilliseconds(kMaxFallbackDelayInMs),
+               smoothed_connect_duration_ * 2 +
+                   base::TimeDelta::FromMilliseconds(10)));
+}
+
+void TransportConnectRaceHistory::OnConnectSucceeded(
+    base::TimeDelta connect_duration) {
+  fallback_won_last_race_ = false;
+  if (smoothed_connect_duration_ == base::TimeDelta()) {
+    smoothed_connect_duration_ = connect_duration;
+    return;
+  }
+  smoothed_connect_duration_ +=
+      base::TimeDelta::FromMicroseconds(static_cast<int64>(
+          kConnectDurationWeight *
+          (connect_duration - smoothed_connect_duration_).InMicroseconds()));
+}
+
+void TransportConnectRaceHistory::OnFallbackWon() {
+  fallback_won_last_race_ = true;
+}
+
+void TransportConnectRaceHistory::OnIPAddressChanged() {
+  smoothed_connect_duration_ = base::TimeDelta();
+  fallback_won_last_race_ = false;
+}
+
 // This lock protects |g_last_connect_time|.
 static base::LazyInstance<base::Lock>::Leaky
     g_last_connect_time_lock = LAZY_INSTANCE_INITIALIZER;
@@ -88,6 +141,7 @@ TransportConnectJob::TransportConnectJob(
     base::TimeDelta timeout_duration,
     ClientSocketFactory* client_socket_factory,
     HostResolver* host_resolver,
+    TransportConnectRaceHistory* race_history,
     Delegate* delegate,
     NetLog* net_log)
     : ConnectJob(group_name, timeout_duration, priority, delegate,
@@ -95,6 +149,7 @@ TransportConnectJob::TransportConnectJob(
       params_(params),
       client_socket_factory_(client_socket_factory),
       resolver_(host_resolver),
+      race_history_(race_history),
       next_state_(STATE_NONE),
       interval_between_connects_(CONNECT_INTERVAL_GT_20MS) {
 }
@@ -129,6 +184,31 @@ void TransportConnectJob::MakeAddressListStartWithIPv4(AddressList* list) {
   }
 }
 
+// static
+void TransportConnectJob::InterleaveAddressFamilies(AddressList* list) {
+  if (list->empty())
+    return;
+  const AddressFamily first_family = list->front().GetFamily();
+  std::vector<IPEndPoint> first;
+  std::vector<IPEndPoint> others;
+  for (AddressList::const_iterator i = list->begin(); i != list->end(); ++i) {
+    if (i->GetFamily() == first_family)
+      first.push_back(*i);
+    else
+      others.push_back(*i);
+  }
+  if (others.empty())
+    return;
+
+  AddressList::iterator out = list->begin();
+  for (size_t i = 0; i < first.size() || i < others.size(); ++i) {
+    if (i < first.size())
+      *out++ = first[i];
+    if (i < others.size())
+      *out++ = others[i];
+  }
+}
+
 void TransportConnectJob::OnIOComplete(int result) {
   int rv = DoLoop(result);
   if (rv != ERR_IO_PENDING)
@@ -190,8 +270,10 @@ int TransportConnectJob::DoResolveHostComplete(int result) {
     if (!params_->host_resolution_callback().is_null())
       result = params_->host_resolution_callback().Run(addresses_, net_log());
 
-    if (result == OK)
+    if (result == OK) {
+      InterleaveAddressFamilies(&addresses_);
       next_state_ = STATE_TRANSPORT_CONNECT;
+    }
   }
   return result;
 }
@@ -224,8 +306,10 @@ int TransportConnectJob::DoTransportConnect() {
   if (rv == ERR_IO_PENDING &&
       addresses_.front().GetFamily() == ADDRESS_FAMILY_IPV6 &&
       !AddressListOnlyContainsIPv6(addresses_)) {
-    fallback_timer_.Start(FROM_HERE,
-        base::TimeDelta::FromMilliseconds(kIPv6FallbackTimerInMs),
+    base::TimeDelta fallback_delay = race_history_ ?
+        race_history_->GetFallbackDelay() :
+        base::TimeDelta::FromMilliseconds(kIPv6FallbackTimerInMs);
+    fallback_timer_.Start(FROM_HERE, fallback_delay,
         this, &TransportConnectJob::DoIPv6FallbackTransportConnect);
   }
   return rv;
@@ -303,8 +387,11 @@ int TransportConnectJob::DoTransportConnectComplete(int result) {
                                    100);
       }
     }
+    if (race_history_)
+      race_history_->OnConnectSucceeded(connect_duration);
     SetSocket(transport_socket_.Pass());
     fallback_timer_.Stop();
+    fallback_transport_socket_.reset();
   } else {
     // Be a bit paranoid and kill off the fallback members to prevent reuse.
     fallback_transport_socket_.reset();
@@ -374,6 +461,8 @@ void TransportConnectJob::DoIPv6FallbackTransportConnectComplete(int result) {
         base::TimeDelta::FromMilliseconds(1),
         base::TimeDelta::FromMinutes(10),
         100);
+    if (race_history_)
+      race_history_->OnFallbackWon();
     SetSocket(fallback_transport_socket_.Pass());
     next_state_ = STATE_NONE;
     transport_socket_.reset();
@@ -402,6 +491,7 @@ scoped_ptr<ConnectJob>
                               ConnectionTimeout(),
                               client_socket_factory_,
                               host_resolver_,
+                              race_history_.get(),
                               delegate,
                               net_log_));
 }
@@ -425,6 +515,7 @@ TransportClientSocketPool::TransportClientSocketPool(
             new TransportConnectJobFactory(client_socket_factory,
                                            host_resolver, net_log)) {
   base_.EnableConnectBackupJobs();
+  base_.EnablePredictiveWarming();
 }
 
 TransportClientSocketPool::~TransportClientSocketPool() {}
@@ -13,6 +13,7 @@
 #include "base/time/time.h"
 #include "base/timer/timer.h"
 #include "net/base/host_port_pair.h"
+#include "net/base/network_change_notifier.h"
 #include "net/dns/host_resolver.h"
 #include "net/dns/single_request_host_resolver.h"
 #include "net/socket/client_socket_pool.h"
@@ -55,22 +56,62 @@ class NET_EXPORT_PRIVATE TransportSocketParams
   DISALLOW_COPY_AND_ASSIGN(TransportSocketParams);
 };
 
+// TransportConnectRaceHistory remembers how the connects of a pool's
+// TransportConnectJobs went on the current network, and uses that to decide
+// how long a job waits for an IPv6 connect() before racing an IPv4 one: a bit
+// more than twice the usual connect time, and not at all if IPv4 won the last
+// race. Everything is forgotten when the IP address changes. Not thread-safe.
+class NET_EXPORT_PRIVATE TransportConnectRaceHistory
+    : public NetworkChangeNotifier::IPAddressObserver {
+ public:
+  TransportConnectRaceHistory();
+  virtual ~TransportConnectRaceHistory();
+
+  // Returns how long to give the connect to the first address a headstart.
+  base::TimeDelta GetFallbackDelay() const;
+
+  // Called when the connect to the first address succeeded, without or before
+  // the fallback one.
+  void OnConnectSucceeded(base::TimeDelta connect_duration);
+
+  // Called when the fallback connect won the race.
+  void OnFallbackWon();
+
+  // NetworkChangeNotifier::IPAddressObserver methods:
+  virtual void OnIPAddressChanged() OVERRIDE;
+
+  // The bounds of the delay, when there is a connect time estimate.
+  static const int kMinFallbackDelayInMs;
+  static const int kMaxFallbackDelayInMs;
+
+ private:
+  // A moving average of the successful connect times, or zero if there
+  // wasn't any yet.
+  base::TimeDelta smoothed_connect_duration_;
+  bool fallback_won_last_race_;
+
+  DISALLOW_COPY_AND_ASSIGN(TransportConnectRaceHistory);
+};
+
 // TransportConnectJob handles the host resolution necessary for socket creation
 // and the transport (likely TCP) connect. TransportConnectJob also has fallback
 // logic for IPv6 connect() timeouts (which may happen due to networks / routers
 // with broken IPv6 support). Those timeouts take 20s, so rather than make the
-// user wait 20s for the timeout to fire, we use a fallback timer
-// (kIPv6FallbackTimerInMs) and start a connect() to a IPv4 address if the timer
-// fires. Then we race the IPv4 connect() against the IPv6 connect() (which has
-// a headstart) and return the one that completes first to the socket pool.
+// user wait 20s for the timeout to fire, we use a fallback timer (whose delay
+// comes from the |race_history|, kIPv6FallbackTimerInMs without one) and start
+// a connect() to a IPv4 address if the timer fires. Then we race the IPv4
+// connect() against the IPv6 connect() (which has a headstart) and return the
+// one that completes first to the socket pool. The loser is cancelled.
 class NET_EXPORT_PRIVATE TransportConnectJob : public ConnectJob {
  public:
+  // |race_history| may be NULL, and must otherwise outlive the job.
   TransportConnectJob(const std::string& group_name,
                       RequestPriority priority,
                       const scoped_refptr<TransportSocketParams>& params,
                       base::TimeDelta timeout_duration,
                       ClientSocketFactory* client_socket_factory,
                       HostResolver* host_resolver,
+                      TransportConnectRaceHistory* race_history,
                       Delegate* delegate,
                       NetLog* net_log);
   virtual ~TransportConnectJob();
@@ -82,6 +123,12 @@ class NET_EXPORT_PRIVATE TransportConnectJob : public ConnectJob {
   // WARNING: this method should only be used to implement the prefer-IPv4 hack.
   static void MakeAddressListStartWithIPv4(AddressList* addrlist);
 
+  // Reorders |addrlist| so that the address families alternate, starting with
+  // the family of the first address and otherwise keeping the order of each
+  // family. When an address fails quickly, the next one |addrlist| connects
+  // to is then of the other family.
+  static void InterleaveAddressFamilies(AddressList* addrlist);
+
   static const int kIPv6FallbackTimerInMs;
 
  private:
@@ -121,6 +168,7 @@ class NET_EXPORT_PRIVATE TransportConnectJob : public ConnectJob {
   scoped_refptr<TransportSocketParams> params_;
   ClientSocketFactory* const client_socket_factory_;
   SingleRequestHostResolver resolver_;
+  TransportConnectRaceHistory* const race_history_;
   AddressList addresses_;
   State next_state_;
 
@@ -198,6 +246,7 @@ class NET_EXPORT_PRIVATE TransportClientSocketPool : public ClientSocketPool {
                          NetLog* net_log)
         : client_socket_factory_(client_socket_factory),
           host_resolver_(host_resolver),
+          race_history_(new TransportConnectRaceHistory),
           net_log_(net_log) {}
 
     virtual ~TransportConnectJobFactory() {}
@@ -214,6 +263,7 @@ class NET_EXPORT_PRIVATE TransportClientSocketPool : public ClientSocketPool {
    private:
     ClientSocketFactory* const client_socket_factory_;
     HostResolver* const host_resolver_;
+    const scoped_ptr<TransportConnectRaceHistory> race_history_;
     NetLog* net_log_;
 
     DISALLOW_COPY_AND_ASSIGN(TransportConnectJobFactory);
@@ -572,6 +572,91 @@ TEST(TransportConnectJobTest, MakeAddrListStartWithIPv4) {
   EXPECT_EQ(ADDRESS_FAMILY_IPV6, addrlist[3].GetFamily());
 }
 
+TEST(TransportConnectJobTest, InterleaveAddressFamilies) {
+  IPAddressNumber ip_number;
+  ASSERT_TRUE(ParseIPLiteralToNumber("192.168.1.1", &ip_number));
+  IPEndPoint addrlist_v4_1(ip_number, 80);
+  ASSERT_TRUE(ParseIPLiteralToNumber("192.168.1.2", &ip_number));
+  IPEndPoint addrlist_v4_2(ip_number, 80);
+  ASSERT_TRUE(ParseIPLiteralToNumber("2001:4860:b006::64", &ip_number));
+  IPEndPoint addrlist_v6_1(ip_number, 80);
+  ASSERT_TRUE(ParseIPLiteralToNumber("2001:4860:b006::66", &ip_number));
+  IPEndPoint addrlist_v6_2(ip_number, 80);
+  ASSERT_TRUE(ParseIPLiteralToNumber("2001:4860:b006::68", &ip_number));
+  IPEndPoint addrlist_v6_3(ip_number, 80);
+
+  AddressList addrlist;
+
+  // Test 1: IPv6 only.  Expect no change.
+  addrlist.push_back(addrlist_v6_1);
+  addrlist.push_back(addrlist_v6_2);
+  TransportConnectJob::InterleaveAddressFamilies(&addrlist);
+  ASSERT_EQ(2u, addrlist.size());
+  EXPECT_EQ(addrlist_v6_1, addrlist[0]);
+  EXPECT_EQ(addrlist_v6_2, addrlist[1]);
+
+  // Test 2: IPv6, IPv6, IPv6, IPv4, IPv4.  Expect the families to alternate
+  // until the IPv4 addresses run out.
+  addrlist.clear();
+  addrlist.push_back(addrlist_v6_1);
+  addrlist.push_back(addrlist_v6_2);
+  addrlist.push_back(addrlist_v6_3);
+  addrlist.push_back(addrlist_v4_1);
+  addrlist.push_back(addrlist_v4_2);
+  TransportConnectJob::InterleaveAddressFamilies(&addrlist);
+  ASSERT_EQ(5u, addrlist.size());
+  EXPECT_EQ(addrlist_v6_1, addrlist[0]);
+  EXPECT_EQ(addrlist_v4_1, addrlist[1]);
+  EXPECT_EQ(addrlist_v6_2, addrlist[2]);
+  EXPECT_EQ(addrlist_v4_2, addrlist[3]);
+  EXPECT_EQ(addrlist_v6_3, addrlist[4]);
+
+  // Test 3: IPv4, IPv4, IPv6.  Expect the first family to stay first.
+  addrlist.clear();
+  addrlist.push_back(addrlist_v4_1);
+  addrlist.push_back(addrlist_v4_2);
+  addrlist.push_back(addrlist_v6_1);
+  TransportConnectJob::InterleaveAddressFamilies(&addrlist);
+  ASSERT_EQ(3u, addrlist.size());
+  EXPECT_EQ(addrlist_v4_1, addrlist[0]);
+  EXPECT_EQ(addrlist_v6_1, addrlist[1]);
+  EXPECT_EQ(addrlist_v4_2, addrlist[2]);
+}
+
+TEST(TransportConnectRaceHistoryTest, FallbackDelay) {
+  TransportConnectRaceHistory history;
+  EXPECT_EQ(base::TimeDelta::FromMilliseconds(
+                TransportConnectJob::kIPv6FallbackTimerInMs),
+            history.GetFallbackDelay());
+
+  // The delay follows the connect times, within bounds.
+  history.OnConnectSucceeded(base::TimeDelta::FromMilliseconds(40));
+  EXPECT_EQ(base::TimeDelta::FromMilliseconds(90), history.GetFallbackDelay());
+  history.OnConnectSucceeded(base::TimeDelta::FromMilliseconds(40 + 8 * 100));
+  EXPECT_EQ(base::TimeDelta::FromMilliseconds(290), history.GetFallbackDelay());
+  history.OnConnectSucceeded(base::TimeDelta::FromSeconds(10));
+  EXPECT_EQ(base::TimeDelta::FromMilliseconds(
+                TransportConnectRaceHistory::kMaxFallbackDelayInMs),
+            history.GetFallbackDelay());
+
+  // Once the fallback won, the next race starts right away.
+  history.OnFallbackWon();
+  EXPECT_EQ(base::TimeDelta(), history.GetFallbackDelay());
+  history.OnConnectSucceeded(base::TimeDelta::FromMilliseconds(1));
+  EXPECT_LT(base::TimeDelta(), history.GetFallbackDelay());
+
+  // Nothing is kept across networks.
+  history.OnFallbackWon();
+  history.OnIPAddressChanged();
+  EXPECT_EQ(base::TimeDelta::FromMilliseconds(
+                TransportConnectJob::kIPv6FallbackTimerInMs),
+            history.GetFallbackDelay());
+  history.OnConnectSucceeded(base::TimeDelta::FromMilliseconds(1));
+  EXPECT_EQ(base::TimeDelta::FromMilliseconds(
+                TransportConnectRaceHistory::kMinFallbackDelayInMs),
+            history.GetFallbackDelay());
+}
+
 TEST_F(TransportClientSocketPoolTest, Basic) {
   TestCompletionCallback callback;
   ClientSocketHandle handle;
@@ -1303,6 +1388,53 @@ TEST_F(TransportClientSocketPoolTest, IPv6FallbackSocketIPv6FinishesFirst) {
   EXPECT_EQ(2, client_socket_factory_.allocation_count());
 }
 
+// Test that once IPv4 won a race, the next one doesn't give IPv6 a headstart.
+TEST_F(TransportClientSocketPoolTest, IPv6FallbackImmediatelyAfterIPv4Won) {
+  // Create a pool without backup jobs.
+  ClientSocketPoolBaseHelper::set_connect_backup_jobs_enabled(false);
+  TransportClientSocketPool pool(kMaxSockets,
+                                 kMaxSocketsPerGroup,
+                                 histograms_.get(),
+                                 host_resolver_.get(),
+                                 &client_socket_factory_,
+                                 NULL);
+
+  // Each race has a stalled IPv6 socket, then the IPv4 one.
+  MockClientSocketFactory::ClientSocketType case_types[] = {
+    MockClientSocketFactory::MOCK_STALLED_CLIENT_SOCKET,
+    MockClientSocketFactory::MOCK_PENDING_CLIENT_SOCKET,
+    MockClientSocketFactory::MOCK_STALLED_CLIENT_SOCKET,
+    MockClientSocketFactory::MOCK_PENDING_CLIENT_SOCKET
+  };
+
+  client_socket_factory_.set_client_socket_types(case_types, 4);
+
+  // Resolve an AddressList with a IPv6 address first and then a IPv4 address.
+  host_resolver_->rules()
+      ->AddIPLiteralRule("*", "2:abcd::3:4:ff,2.2.2.2", std::string());
+
+  TestCompletionCallback callback1;
+  ClientSocketHandle handle1;
+  EXPECT_EQ(ERR_IO_PENDING, handle1.Init("a", params_, LOW,
+                                         callback1.callback(), &pool,
+                                         BoundNetLog()));
+  EXPECT_EQ(OK, callback1.WaitForResult());
+  EXPECT_EQ(2, client_socket_factory_.allocation_count());
+
+  // The IPv4 connect starts without waiting for any timer.
+  TestCompletionCallback callback2;
+  ClientSocketHandle handle2;
+  EXPECT_EQ(ERR_IO_PENDING, handle2.Init("b", params_, LOW,
+                                         callback2.callback(), &pool,
+                                         BoundNetLog()));
+  base::MessageLoop::current()->RunUntilIdle();
+  EXPECT_EQ(4, client_socket_factory_.allocation_count());
+  EXPECT_EQ(OK, callback2.WaitForResult());
+  IPEndPoint endpoint;
+  handle2.socket()->GetLocalAddress(&endpoint);
+  EXPECT_EQ(kIPv4AddressSize, endpoint.address().size());
+}
+
 TEST_F(TransportClientSocketPoolTest, IPv6NoIPv4AddressesToFallbackTo) {
   // Create a pool without backup jobs.
   ClientSocketPoolBaseHelper::set_connect_backup_jobs_enabled(false);
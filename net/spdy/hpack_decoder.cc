@@ -12,6 +12,28 @@ namespace net {
 
 using base::StringPiece;
 
+namespace {
+
+// Copies the headers it is passed into a HpackHeaderPairVector.
+class HeaderListBuilder : public HpackDecoderVisitor {
+ public:
+  explicit HeaderListBuilder(HpackHeaderPairVector* header_list)
+      : header_list_(header_list) {}
+  virtual ~HeaderListBuilder() {}
+
+  virtual void OnHeader(StringPiece name, StringPiece value) OVERRIDE {
+    header_list_->push_back(
+        HpackHeaderPair(name.as_string(), value.as_string()));
+  }
+
+ private:
+  HpackHeaderPairVector* const header_list_;
+
+  DISALLOW_COPY_AND_ASSIGN(HeaderListBuilder);
+};
+
+}  // namespace
+
 HpackDecoder::HpackDecoder(uint32 max_string_literal_size)
     : max_string_literal_size_(max_string_literal_size) {}
 
@@ -19,10 +41,16 @@ HpackDecoder::~HpackDecoder() {}
 
 bool HpackDecoder::DecodeHeaderSet(StringPiece input,
                                    HpackHeaderPairVector* header_list) {
+  HeaderListBuilder builder(header_list);
+  return DecodeHeaderSet(input, &builder);
+}
+
+bool HpackDecoder::DecodeHeaderSet(StringPiece input,
+                                   HpackDecoderVisitor* visitor) {
   HpackInputStream input_stream(max_string_literal_size_, input);
   while (input_stream.HasMoreData()) {
-    // May add to |header_list|.
-    if (!ProcessNextHeaderRepresentation(&input_stream, header_list))
+    // May emit headers to |visitor|.
+    if (!ProcessNextHeaderRepresentation(&input_stream, visitor))
       return false;
   }
 
@@ -31,9 +59,7 @@ bool HpackDecoder::DecodeHeaderSet(StringPiece input,
   for (size_t i = 1; i <= context_.GetMutableEntryCount(); ++i) {
     if (context_.IsReferencedAt(i) &&
         (context_.GetTouchCountAt(i) == HpackEncodingContext::kUntouched)) {
-      header_list->push_back(
-          HpackHeaderPair(context_.GetNameAt(i).as_string(),
-                          context_.GetValueAt(i).as_string()));
+      visitor->OnHeader(context_.GetNameAt(i), context_.GetValueAt(i));
     }
     context_.ClearTouchesAt(i);
   }
@@ -42,7 +68,7 @@ bool HpackDecoder::DecodeHeaderSet(StringPiece input,
 }
 
 bool HpackDecoder::ProcessNextHeaderRepresentation(
-    HpackInputStream* input_stream, HpackHeaderPairVector* header_list) {
+    HpackInputStream* input_stream, HpackDecoderVisitor* visitor) {
   // Touches are used below to track which headers have been emitted.
 
   // Implements 4.2. Indexed Header Field Representation.
@@ -59,17 +85,15 @@ bool HpackDecoder::ProcessNextHeaderRepresentation(
       uint32 index = index_or_zero;
       // The index will be put into the reference set.
       if (!context_.IsReferencedAt(index)) {
-        header_list->push_back(
-            HpackHeaderPair(context_.GetNameAt(index).as_string(),
-                            context_.GetValueAt(index).as_string()));
+        visitor->OnHeader(context_.GetNameAt(index),
+                          context_.GetValueAt(index));
         emitted = true;
       }
     }
 
     uint32 new_index = 0;
-    std::vector<uint32> removed_referenced_indices;
     context_.ProcessIndexedHeader(
-        index_or_zero, &new_index, &removed_referenced_indices);
+        index_or_zero, &new_index, &removed_referenced_indices_);
 
     if (emitted && new_index > 0)
       context_.AddTouchesAt(new_index, 0);
@@ -87,8 +111,7 @@ bool HpackDecoder::ProcessNextHeaderRepresentation(
     if (!DecodeNextValue(input_stream, &value))
       return false;
 
-    header_list->push_back(
-        HpackHeaderPair(name.as_string(), value.as_string()));
+    visitor->OnHeader(name, value);
     return true;
   }
 
@@ -102,13 +125,13 @@ bool HpackDecoder::ProcessNextHeaderRepresentation(
     if (!DecodeNextValue(input_stream, &value))
       return false;
 
-    header_list->push_back(
-        HpackHeaderPair(name.as_string(), value.as_string()));
+    // |name| may point into the header table, so it must be emitted
+    // before the new entry evicts anything.
+    visitor->OnHeader(name, value);
 
     uint32 new_index = 0;
-    std::vector<uint32> removed_referenced_indices;
     context_.ProcessLiteralHeaderWithIncrementalIndexing(
-        name, value, &new_index, &removed_referenced_indices);
+        name, value, &new_index, &removed_referenced_indices_);
 
     if (new_index > 0)
       context_.AddTouchesAt(new_index, 0);
@@ -17,6 +17,16 @@
 
 namespace net {
 
+// Receives the headers decoded by an HpackDecoder, in order. The
+// StringPieces point into the input or into the decoder's encoding
+// context, and are only valid for the duration of the call.
+class NET_EXPORT_PRIVATE HpackDecoderVisitor {
+ public:
+  virtual ~HpackDecoderVisitor() {}
+
+  virtual void OnHeader(base::StringPiece name, base::StringPiece value) = 0;
+};
+
 // An HpackDecoder decodes header sets as outlined in
 // http://tools.ietf.org/html/draft-ietf-httpbis-header-compression-05
 // .
@@ -25,11 +35,14 @@ class NET_EXPORT_PRIVATE HpackDecoder {
   explicit HpackDecoder(uint32 max_string_literal_size);
   ~HpackDecoder();
 
-  // Decodes the given string into the given header set. Returns
-  // whether or not the decoding was successful.
-  //
-  // TODO(akalin): Emit the headers via a callback/delegate instead of
-  // putting them into a vector.
+  // Decodes the given string, passing each header of the header set
+  // to |visitor| without copying it. Returns whether or not the
+  // decoding was successful; |visitor| may have been passed some
+  // headers even if it wasn't.
+  bool DecodeHeaderSet(base::StringPiece input, HpackDecoderVisitor* visitor);
+
+  // Like the above, but appends copies of the headers to
+  // |header_list|.
   bool DecodeHeaderSet(base::StringPiece input,
                        HpackHeaderPairVector* header_list);
 
@@ -44,12 +57,16 @@ class NET_EXPORT_PRIVATE HpackDecoder {
   const uint32 max_string_literal_size_;
   HpackEncodingContext context_;
 
+  // Reused by each header representation, so that processing one
+  // doesn't allocate.
+  std::vector<uint32> removed_referenced_indices_;
+
   // Tries to process the next header representation and maybe emit
-  // headers into |header_list| according to it. Returns true if
-  // successful, or false if an error was encountered.
+  // headers to |visitor| according to it. Returns true if successful,
+  // or false if an error was encountered.
   bool ProcessNextHeaderRepresentation(
       HpackInputStream* input_stream,
-      HpackHeaderPairVector* header_list);
+      HpackDecoderVisitor* visitor);
 
   bool DecodeNextName(HpackInputStream* input_stream,
                       base::StringPiece* next_name);
@@ -6,6 +6,7 @@
 
 #include <map>
 #include <string>
+#include <vector>
 
 #include "base/basictypes.h"
 #include "base/strings/string_piece.h"
@@ -166,6 +167,48 @@ TEST(HpackDecoderTest, LiteralHeaderInvalidIndices) {
   EXPECT_FALSE(decoder.DecodeHeaderSet(StringPiece("\x00", 1), &header_list));
 }
 
+// Records the headers it is passed, and the StringPieces themselves.
+class RecordingVisitor : public HpackDecoderVisitor {
+ public:
+  RecordingVisitor() {}
+  virtual ~RecordingVisitor() {}
+
+  virtual void OnHeader(StringPiece name, StringPiece value) OVERRIDE {
+    header_list.push_back(HpackHeaderPair(name.as_string(),
+                                          value.as_string()));
+    names.push_back(name);
+    values.push_back(value);
+  }
+
+  HpackHeaderPairVector header_list;
+  std::vector<StringPiece> names;
+  std::vector<StringPiece> values;
+
+ private:
+  DISALLOW_COPY_AND_ASSIGN(RecordingVisitor);
+};
+
+// Decoding to a visitor should pass it literals as pieces of the
+// input, and emit the same headers as decoding into a vector.
+TEST(HpackDecoderTest, DecodeToVisitor) {
+  const StringPiece input("\x82\x40\x06:path2\x0e/sample/path/2");
+
+  HpackDecoder decoder(kuint32max);
+  RecordingVisitor visitor;
+  EXPECT_TRUE(decoder.DecodeHeaderSet(input, &visitor));
+  ASSERT_EQ(2u, visitor.header_list.size());
+  EXPECT_EQ(HpackHeaderPair(":method", "GET"), visitor.header_list[0]);
+  EXPECT_EQ(HpackHeaderPair(":path2", "/sample/path/2"),
+            visitor.header_list[1]);
+  EXPECT_EQ(input.data() + 3, visitor.names[1].data());
+  EXPECT_EQ(input.data() + 10, visitor.values[1].data());
+
+  HpackDecoder vector_decoder(kuint32max);
+  HpackHeaderPairVector header_list;
+  EXPECT_TRUE(vector_decoder.DecodeHeaderSet(input, &header_list));
+  EXPECT_EQ(visitor.header_list, header_list);
+}
+
 // Round-tripping the header set from E.2.1 should work.
 TEST(HpackDecoderTest, BasicE21) {
   HpackEncoder encoder(kuint32max);
@@ -1704,37 +1704,37 @@ size_t SpdyFramer::ParseHeaderBlockInBuffer(const char* header_data,
     }
   }
 
-  // Read each header.
+  // Read each header. The name and value are only copied once, into the
+  // block itself.
   for (uint32 index = 0; index < num_headers; ++index) {
-    base::StringPiece temp;
+    base::StringPiece name;
 
     // Read header name.
-    if ((spdy_version_ < 3) ? !reader.ReadStringPiece16(&temp)
-                            : !reader.ReadStringPiece32(&temp)) {
+    if ((spdy_version_ < 3) ? !reader.ReadStringPiece16(&name)
+                            : !reader.ReadStringPiece32(&name)) {
       DVLOG(1) << "Unable to read header name (" << index + 1 << " of "
                << num_headers << ").";
       return 0;
     }
-    std::string name = temp.as_string();
 
     // Read header value.
-    if ((spdy_version_ < 3) ? !reader.ReadStringPiece16(&temp)
-                            : !reader.ReadStringPiece32(&temp)) {
+    base::StringPiece value;
+    if ((spdy_version_ < 3) ? !reader.ReadStringPiece16(&value)
+                            : !reader.ReadStringPiece32(&value)) {
       DVLOG(1) << "Unable to read header value (" << index + 1 << " of "
                << num_headers << ").";
       return 0;
     }
-    std::string value = temp.as_string();
 
-    // Ensure no duplicates.
-    if (block->find(name) != block->end()) {
+    // Store header, ensuring no duplicates.
+    std::pair<SpdyHeaderBlock::iterator, bool> inserted =
+        block->insert(std::make_pair(name.as_string(), std::string()));
+    if (!inserted.second) {
       DVLOG(1) << "Duplicate header '" << name << "' (" << index + 1 << " of "
                << num_headers << ").";
       return 0;
     }
-
-    // Store header.
-    (*block)[name] = value;
+    value.CopyToString(&inserted.first->second);
   }
   return reader.GetBytesConsumed();
 }
@@ -46,8 +46,10 @@ void SpdyWriteQueue::Enqueue(RequestPriority priority,
                              const base::WeakPtr<SpdyStream>& stream) {
   CHECK_GE(priority, MINIMUM_PRIORITY);
   CHECK_LE(priority, MAXIMUM_PRIORITY);
-  if (stream.get())
+  if (stream.get()) {
     DCHECK_EQ(stream->priority(), priority);
+    ++pending_write_counts_[stream.get()];
+  }
   queue_[priority].push_back(
       PendingWrite(frame_type, frame_producer.release(), stream));
 }
@@ -62,8 +64,11 @@ bool SpdyWriteQueue::Dequeue(SpdyFrameType* frame_type,
       *frame_type = pending_write.frame_type;
       frame_producer->reset(pending_write.frame_producer);
       *stream = pending_write.stream;
-      if (pending_write.has_stream)
+      if (pending_write.has_stream) {
         DCHECK(stream->get());
+        if (stream->get())
+          DecrementPendingWriteCount(stream->get());
+      }
       return true;
     }
   }
@@ -90,6 +95,12 @@ void SpdyWriteQueue::RemovePendingWritesForStream(
     }
   }
 
+  std::map<SpdyStream*, int>::iterator count_it =
+      pending_write_counts_.find(stream.get());
+  if (count_it == pending_write_counts_.end())
+    return;
+  pending_write_counts_.erase(count_it);
+
   // Do the actual deletion and removal, preserving FIFO-ness.
   std::deque<PendingWrite>* queue = &queue_[priority];
   std::deque<PendingWrite>::iterator out_it = queue->begin();
@@ -115,6 +126,7 @@ void SpdyWriteQueue::RemovePendingWritesForStreamsAfter(
          it != queue->end(); ++it) {
       if (it->stream.get() && (it->stream->stream_id() > last_good_stream_id ||
                                it->stream->stream_id() == 0)) {
+        DecrementPendingWriteCount(it->stream.get());
         delete it->frame_producer;
       } else {
         *out_it = *it;
@@ -133,6 +145,15 @@ void SpdyWriteQueue::Clear() {
     }
     queue_[i].clear();
   }
+  pending_write_counts_.clear();
+}
+
+void SpdyWriteQueue::DecrementPendingWriteCount(SpdyStream* stream) {
+  std::map<SpdyStream*, int>::iterator it =
+      pending_write_counts_.find(stream);
+  DCHECK(it != pending_write_counts_.end());
+  if (it != pending_write_counts_.end() && --it->second == 0)
+    pending_write_counts_.erase(it);
 }
 
 }  // namespace net
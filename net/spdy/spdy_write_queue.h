@@ -6,6 +6,7 @@
 #define NET_SPDY_SPDY_WRITE_QUEUE_H_
 
 #include <deque>
+#include <map>
 
 #include "base/basictypes.h"
 #include "base/memory/scoped_ptr.h"
@@ -78,9 +79,17 @@ class NET_EXPORT_PRIVATE SpdyWriteQueue {
     ~PendingWrite();
   };
 
+  // Drops one pending write of |stream| from |pending_write_counts_|.
+  void DecrementPendingWriteCount(SpdyStream* stream);
+
   // The actual write queue, binned by priority.
   std::deque<PendingWrite> queue_[NUM_PRIORITIES];
 
+  // The number of writes in |queue_| for each stream that has any, so
+  // that removing the writes of a stream which has none (as most do
+  // when they are closed) doesn't have to go through the queue.
+  std::map<SpdyStream*, int> pending_write_counts_;
+
   DISALLOW_COPY_AND_ASSIGN(SpdyWriteQueue);
 };
 
@@ -184,6 +184,36 @@ TEST_F(SpdyWriteQueueTest, RemovePendingWritesForStream) {
   EXPECT_FALSE(write_queue.Dequeue(&frame_type, &frame_producer, &stream));
 }
 
+// RemovePendingWritesForStream() on a stream whose writes were all
+// dequeued already, or which never had any, shouldn't remove the
+// writes of other streams.
+TEST_F(SpdyWriteQueueTest, RemovePendingWritesForStreamWithoutWrites) {
+  SpdyWriteQueue write_queue;
+
+  scoped_ptr<SpdyStream> stream1(MakeTestStream(DEFAULT_PRIORITY));
+  scoped_ptr<SpdyStream> stream2(MakeTestStream(DEFAULT_PRIORITY));
+  scoped_ptr<SpdyStream> stream3(MakeTestStream(DEFAULT_PRIORITY));
+
+  write_queue.Enqueue(DEFAULT_PRIORITY, SYN_STREAM, IntToProducer(1),
+                      stream1->GetWeakPtr());
+  write_queue.Enqueue(DEFAULT_PRIORITY, SYN_STREAM, IntToProducer(2),
+                      stream2->GetWeakPtr());
+
+  SpdyFrameType frame_type = DATA;
+  scoped_ptr<SpdyBufferProducer> frame_producer;
+  base::WeakPtr<SpdyStream> stream;
+  ASSERT_TRUE(write_queue.Dequeue(&frame_type, &frame_producer, &stream));
+  EXPECT_EQ(1, ProducerToInt(frame_producer.Pass()));
+
+  write_queue.RemovePendingWritesForStream(stream1->GetWeakPtr());
+  write_queue.RemovePendingWritesForStream(stream3->GetWeakPtr());
+
+  ASSERT_TRUE(write_queue.Dequeue(&frame_type, &frame_producer, &stream));
+  EXPECT_EQ(2, ProducerToInt(frame_producer.Pass()));
+  EXPECT_EQ(stream2, stream.get());
+  EXPECT_TRUE(write_queue.IsEmpty());
+}
+
 // Enqueue a bunch of writes and then call
 // RemovePendingWritesForStreamsAfter(). No dequeued write should be for
 // those streams without a stream id, or with a stream_id after that
@@ -88,6 +88,10 @@ BalsaHeaders::iterator_base::iterator_base(const BalsaHeaders* headers,
 
 BalsaBuffer::~BalsaBuffer() {
   CleanupBlocksStartingFrom(0);
+  for (std::vector<char*>::iterator it = spare_blocks_.begin();
+       it != spare_blocks_.end(); ++it) {
+    delete[] *it;
+  }
 }
 
 // Returns the total amount of memory used by the buffer blocks.
@@ -146,6 +150,12 @@ char* BalsaBuffer::Reserve(size_t size,
   // contains nothing.
   DCHECK_GE(blocks_.size(), 1u);
   BufferBlock* block = NULL;
+  if (!can_write_to_contiguous_buffer_ && blocks_[0].buffer == NULL &&
+      size <= blocksize_) {
+    // The first block is allocated lazily; the framer didn't use it, so it's
+    // as good as any other block.
+    blocks_[0] = AllocBlock();
+  }
   Blocks::size_type block_idx = can_write_to_contiguous_buffer_ ? 1 : 0;
   for (; block_idx < blocks_.size(); ++block_idx) {
     if (blocks_[block_idx].bytes_free >= size) {
@@ -172,12 +182,20 @@ char* BalsaBuffer::Reserve(size_t size,
 
 void BalsaBuffer::Clear() {
   CHECK(!blocks_.empty());
+  // Keep the blocks of the default size around, so that the next message
+  // written to this buffer doesn't have to allocate them again.
+  for (Blocks::size_type i = 1; i < blocks_.size(); ++i) {
+    if (blocks_[i].buffer_size == blocksize_) {
+      spare_blocks_.push_back(blocks_[i].buffer);
+      blocks_[i].buffer = NULL;
+    }
+  }
   if (blocksize_ == blocks_[0].buffer_size) {
     CleanupBlocksStartingFrom(1);
     blocks_[0].bytes_free = blocks_[0].buffer_size;
   } else {
     CleanupBlocksStartingFrom(0);
-    blocks_.push_back(AllocBlock());
+    blocks_.push_back(BufferBlock());
   }
   DCHECK_GE(blocks_.size(), 1u);
   can_write_to_contiguous_buffer_ = true;
@@ -185,6 +203,7 @@ void BalsaBuffer::Clear() {
 
 void BalsaBuffer::Swap(BalsaBuffer* b) {
   blocks_.swap(b->blocks_);
+  spare_blocks_.swap(b->spare_blocks_);
   std::swap(can_write_to_contiguous_buffer_,
             b->can_write_to_contiguous_buffer_);
   std::swap(blocksize_, b->blocksize_);
@@ -200,17 +219,24 @@ void BalsaBuffer::CopyFrom(const BalsaBuffer& b) {
   can_write_to_contiguous_buffer_ = b.can_write_to_contiguous_buffer_;
 }
 
+// The first block is allocated when it is first written to, as headers that
+// aren't written by the framer may never use it.
 BalsaBuffer::BalsaBuffer()
     : blocksize_(kDefaultBlocksize), can_write_to_contiguous_buffer_(true) {
-  blocks_.push_back(AllocBlock());
+  blocks_.push_back(BufferBlock());
 }
 
 BalsaBuffer::BalsaBuffer(size_t blocksize) :
     blocksize_(blocksize), can_write_to_contiguous_buffer_(true) {
-  blocks_.push_back(AllocBlock());
+  blocks_.push_back(BufferBlock());
 }
 
 BalsaBuffer::BufferBlock BalsaBuffer::AllocBlock() {
+  if (!spare_blocks_.empty()) {
+    char* buffer = spare_blocks_.back();
+    spare_blocks_.pop_back();
+    return BufferBlock(buffer, blocksize_, blocksize_);
+  }
   return AllocCustomBlock(blocksize_);
 }
 
@@ -197,6 +197,10 @@ class BalsaBuffer {
   // A container of BufferBlocks
   Blocks blocks_;
 
+  // Buffers of blocksize_ bytes that were released by Clear(), and that
+  // AllocBlock() hands out again before allocating new ones.
+  std::vector<char*> spare_blocks_;
+
   // The default allocation size for a block.
   // In general, blocksize_ bytes will be allocated for
   // each buffer.
@@ -127,6 +127,19 @@ TEST_F(BalsaBufferTest, Clear) {
   ASSERT_EQ(1u, buffer_->num_blocks());
 }
 
+TEST_F(BalsaBufferTest, ClearReusesBlocks) {
+  // The first block isn't allocated until it is needed.
+  ASSERT_EQ(0u, buffer_->GetTotalBufferBlockSize());
+
+  StringPiece sp1 = buffer_->Write(StringPiece("hello"), NULL);
+  const char* block = sp1.data();
+  buffer_->Clear();
+  ASSERT_EQ(1u, buffer_->num_blocks());
+  StringPiece sp2 = buffer_->Write(StringPiece("world"), NULL);
+  ASSERT_EQ(block, sp2.data());
+  ASSERT_EQ("world", sp2);
+}
+
 TEST_F(BalsaBufferTest, Swap) {
   buffer_->Write("hello", NULL);
 
@@ -28,7 +28,8 @@ SMAcceptorThread::SMAcceptorThread(FlipAcceptor* acceptor,
       use_ssl_(false),
       idle_socket_timeout_s_(acceptor->idle_socket_timeout_s_),
       quitting_(false),
-      memory_cache_(memory_cache) {
+      memory_cache_(memory_cache),
+      oldest_time_(time(NULL)) {
   if (!acceptor->ssl_cert_filename_.empty() &&
       !acceptor->ssl_key_filename_.empty()) {
     ssl_state_ = new SSLState;
@@ -151,12 +152,10 @@ void SMAcceptorThread::AcceptFromListenFD() {
 }
 
 void SMAcceptorThread::HandleConnectionIdleTimeout() {
-  static time_t oldest_time = time(NULL);
-
   int cur_time = time(NULL);
   // Only iterate the list if we speculate that a connection is ready to be
   // expired
-  if ((cur_time - oldest_time) < idle_socket_timeout_s_)
+  if ((cur_time - oldest_time_) < idle_socket_timeout_s_)
     return;
 
   // TODO(mbelshe): This code could be optimized, active_server_connections_
@@ -170,12 +169,12 @@ void SMAcceptorThread::HandleConnectionIdleTimeout() {
       iter = active_server_connections_.erase(iter);
       continue;
     }
-    if (conn->last_read_time_ < oldest_time)
-      oldest_time = conn->last_read_time_;
+    if (conn->last_read_time_ < oldest_time_)
+      oldest_time_ = conn->last_read_time_;
     iter++;
   }
-  if ((cur_time - oldest_time) >= idle_socket_timeout_s_)
-    oldest_time = cur_time;
+  if ((cur_time - oldest_time_) >= idle_socket_timeout_s_)
+    oldest_time_ = cur_time;
 }
 
 void SMAcceptorThread::Run() {
@@ -90,6 +90,9 @@ class SMAcceptorThread : public base::SimpleThread,
   std::list<SMConnection*> active_server_connections_;
   Notification quitting_;
   MemoryCache* memory_cache_;
+  // The time of the last read of the connection that was idle the longest,
+  // as of the last time the connections were checked for idleness.
+  time_t oldest_time_;
 };
 
 }  // namespace net
@@ -43,6 +43,12 @@ int32 FLAGS_accept_backlog_size = 1024;
 //  SO_REUSEPORT);
 bool FLAGS_reuseport = false;
 
+// The number of accept threads, each with its own epoll server, that serve
+//  every proxy listen ip:port. With reuseport each thread gets its own
+//  listening socket and the kernel balances the connections between them;
+//  otherwise the threads share the listening socket.
+int32 FLAGS_proxy_threads = 1;
+
 // Flag to force spdy, even if NPN is not negotiated.
 bool FLAGS_force_spdy = false;
 
@@ -181,6 +187,8 @@ int main(int argc, char** argv) {
         " passed\n"
         "\t    through the proxy listen ip:port.\n"
         "\t--forward-ip-header=<header name>\n"
+        "\t--proxy-threads=<n> (default is 1)\n"
+        "\t  * The number of threads serving each proxy listen ip:port.\n"
         "\n  Server options:\n"
         "\t--spdy-server=\"<listen ip>,<listen port>,[ssl cert filename],"
         "\n\t               [ssl key filename]\"\n"
@@ -198,6 +206,10 @@ int main(int argc, char** argv) {
         "\t--ssl-session-expiry=<seconds> (default is 300)\n"
         "\t--ssl-disable-compression\n"
         "\t--idle-timeout=<seconds> (default is 300)\n"
+        "\t--reuseport\n"
+        "\t  * Give each accept thread its own listening socket. Requires a"
+        " kernel\n"
+        "\t    that supports SO_REUSEPORT.\n"
         "\t--pidfile=<filepath> (default /var/run/flip-server.pid)\n"
         "\t--help\n");
     exit(0);
@@ -260,6 +272,16 @@ int main(int argc, char** argv) {
         atoi(cl.GetSwitchValueASCII("idle-timeout").c_str());
   }
 
+  if (cl.HasSwitch("reuseport"))
+    FLAGS_reuseport = true;
+
+  if (cl.HasSwitch("proxy-threads")) {
+    FLAGS_proxy_threads =
+        atoi(cl.GetSwitchValueASCII("proxy-threads").c_str());
+    if (FLAGS_proxy_threads < 1)
+      LOG(FATAL) << "Invalid number of proxy threads: " << FLAGS_proxy_threads;
+  }
+
   if (cl.HasSwitch("force_spdy"))
     net::SMConnection::set_force_spdy(true);
 
@@ -284,6 +306,7 @@ int main(int argc, char** argv) {
                                                                     : "false");
   LOG(INFO) << "Reuseport               : " << (FLAGS_reuseport ? "true"
                                                                 : "false");
+  LOG(INFO) << "Proxy threads           : " << FLAGS_proxy_threads;
   LOG(INFO) << "Force SPDY              : " << (FLAGS_force_spdy ? "true"
                                                                  : "false");
   LOG(INFO) << "SSL session expiry      : "
@@ -305,24 +328,29 @@ int main(int argc, char** argv) {
     std::vector<std::string> valueArgs = split(value, ',');
     CHECK_EQ((unsigned int)9, valueArgs.size());
     int spdy_only = atoi(valueArgs[8].c_str());
-    // If wait_for_iface is enabled, then this call will block
-    // indefinitely until the interface is raised.
-    g_proxy_config.AddAcceptor(net::FLIP_HANDLER_PROXY,
-                               valueArgs[0],
-                               valueArgs[1],
-                               valueArgs[2],
-                               valueArgs[3],
-                               valueArgs[4],
-                               valueArgs[5],
-                               valueArgs[6],
-                               valueArgs[7],
-                               spdy_only,
-                               FLAGS_accept_backlog_size,
-                               FLAGS_disable_nagle,
-                               FLAGS_accepts_per_wake,
-                               FLAGS_reuseport,
-                               wait_for_iface,
-                               NULL);
+    // With reuseport, each proxy thread gets its own acceptor and thus its
+    // own listening socket.
+    int num_acceptors = FLAGS_reuseport ? FLAGS_proxy_threads : 1;
+    for (int j = 0; j < num_acceptors; ++j) {
+      // If wait_for_iface is enabled, then this call will block
+      // indefinitely until the interface is raised.
+      g_proxy_config.AddAcceptor(net::FLIP_HANDLER_PROXY,
+                                 valueArgs[0],
+                                 valueArgs[1],
+                                 valueArgs[2],
+                                 valueArgs[3],
+                                 valueArgs[4],
+                                 valueArgs[5],
+                                 valueArgs[6],
+                                 valueArgs[7],
+                                 spdy_only,
+                                 FLAGS_accept_backlog_size,
+                                 FLAGS_disable_nagle,
+                                 FLAGS_accepts_per_wake,
+                                 FLAGS_reuseport,
+                                 wait_for_iface,
+                                 NULL);
+    }
   }
 
   // Spdy Server Acceptor
@@ -382,18 +410,28 @@ int main(int argc, char** argv) {
   for (i = 0; i < g_proxy_config.acceptors_.size(); i++) {
     net::FlipAcceptor* acceptor = g_proxy_config.acceptors_[i];
 
-    sm_worker_threads_.push_back(new net::SMAcceptorThread(
-        acceptor, (net::MemoryCache*)acceptor->memory_cache_));
     // Note that spdy_memory_cache is not threadsafe, it is merely
     // thread compatible. Thus, if ever we are to spawn multiple threads,
     // we either must make the MemoryCache threadsafe, or use
     // a separate MemoryCache for each thread.
     //
     // The latter is what is currently being done as we spawn
-    // a separate thread for each http and spdy server acceptor.
-
-    sm_worker_threads_.back()->InitWorker();
-    sm_worker_threads_.back()->Start();
+    // a separate thread for each http and spdy server acceptor. The proxy
+    // acceptors don't use a MemoryCache, so several threads, each running
+    // its own epoll server, can share one of their listening sockets. The
+    // listening socket is registered edge-triggered, so each thread that is
+    // woken up accepts until the queue is drained.
+    int num_threads = 1;
+    if (acceptor->flip_handler_type_ == net::FLIP_HANDLER_PROXY &&
+        !FLAGS_reuseport) {
+      num_threads = FLAGS_proxy_threads;
+    }
+    for (int j = 0; j < num_threads; ++j) {
+      sm_worker_threads_.push_back(new net::SMAcceptorThread(
+          acceptor, (net::MemoryCache*)acceptor->memory_cache_));
+      sm_worker_threads_.back()->InitWorker();
+      sm_worker_threads_.back()->Start();
+    }
   }
 
   while (!wantExit) {
@@ -0,0 +1,99 @@
+// Copyright 2014 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "net/tools/quic/quic_packet_reader.h"
+
+#include <errno.h>
+#include <string.h>
+
+#include "base/logging.h"
+#include "net/base/ip_endpoint.h"
+#include "net/tools/quic/quic_dispatcher.h"
+#include "net/tools/quic/quic_socket_utils.h"
+
+namespace net {
+namespace tools {
+
+QuicPacketReader::QuicPacketReader() {
+#if MMSG_MORE
+  Initialize();
+#endif
+}
+
+QuicPacketReader::~QuicPacketReader() {
+}
+
+#if MMSG_MORE
+
+void QuicPacketReader::Initialize() {
+  for (int i = 0; i < kNumPacketsPerReadMmsgCall; ++i) {
+    packets_[i].iov.iov_base = packets_[i].buf;
+    packets_[i].iov.iov_len = sizeof(packets_[i].buf);
+    memset(&mmsg_hdr_[i], 0, sizeof(mmsg_hdr_[i]));
+    msghdr* hdr = &mmsg_hdr_[i].msg_hdr;
+    hdr->msg_name = &packets_[i].raw_address;
+    hdr->msg_iov = &packets_[i].iov;
+    hdr->msg_iovlen = 1;
+    hdr->msg_control = packets_[i].cbuf;
+  }
+}
+
+bool QuicPacketReader::ReadAndDispatchPackets(int fd,
+                                              int port,
+                                              QuicDispatcher* dispatcher,
+                                              uint32* packets_dropped) {
+  // The lengths are updated by each call, so they have to be reset.
+  for (int i = 0; i < kNumPacketsPerReadMmsgCall; ++i) {
+    msghdr* hdr = &mmsg_hdr_[i].msg_hdr;
+    hdr->msg_namelen = sizeof(sockaddr_storage);
+    memset(packets_[i].cbuf, 0, sizeof(packets_[i].cbuf));
+    hdr->msg_controllen = sizeof(packets_[i].cbuf);
+    hdr->msg_flags = 0;
+  }
+
+  int packets_read = recvmmsg(fd, mmsg_hdr_, kNumPacketsPerReadMmsgCall, 0,
+                              NULL);
+  if (packets_read <= 0) {
+    if (packets_read < 0 && errno != EAGAIN) {
+      LOG(ERROR) << "Error reading " << strerror(errno);
+    }
+    return false;  // We failed to read.
+  }
+
+  for (int i = 0; i < packets_read; ++i) {
+    msghdr* hdr = &mmsg_hdr_[i].msg_hdr;
+    IPEndPoint client_address;
+    if (!client_address.FromSockAddr(
+            reinterpret_cast<const sockaddr*>(&packets_[i].raw_address),
+            hdr->msg_namelen)) {
+      LOG(ERROR) << "Unable to get peer address";
+      continue;
+    }
+    IPAddressNumber server_ip = QuicSocketUtils::GetAddressFromMsghdr(hdr);
+    if (packets_dropped != NULL) {
+      QuicSocketUtils::GetOverflowFromMsghdr(hdr, packets_dropped);
+    }
+
+    QuicEncryptedPacket packet(packets_[i].buf, mmsg_hdr_[i].msg_len, false);
+    IPEndPoint server_address(server_ip, port);
+    dispatcher->ProcessPacket(server_address, client_address, packet);
+  }
+
+  return true;
+}
+
+#else  // MMSG_MORE
+
+bool QuicPacketReader::ReadAndDispatchPackets(int fd,
+                                              int port,
+                                              QuicDispatcher* dispatcher,
+                                              uint32* packets_dropped) {
+  LOG(FATAL) << "Unsupported";
+  return false;
+}
+
+#endif  // MMSG_MORE
+
+}  // namespace tools
+}  // namespace net
@@ -0,0 +1,74 @@
+// Copyright 2014 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+//
+// Reads packets from a socket in batches, with recvmmsg.
+
+#ifndef NET_TOOLS_QUIC_QUIC_PACKET_READER_H_
+#define NET_TOOLS_QUIC_QUIC_PACKET_READER_H_
+
+#include <features.h>
+#include <netinet/in.h>
+#include <sys/socket.h>
+
+#include "base/basictypes.h"
+#include "net/quic/quic_protocol.h"
+
+// recvmmsg is available from Linux 2.6.33 and glibc 2.12 on.
+#if defined(__linux__) && defined(__GLIBC__)
+#if __GLIBC_PREREQ(2, 12)
+#define MMSG_MORE 1
+#endif
+#endif
+#ifndef MMSG_MORE
+#define MMSG_MORE 0
+#endif
+
+namespace net {
+namespace tools {
+
+class QuicDispatcher;
+
+// The number of packets read with each recvmmsg call.
+const int kNumPacketsPerReadMmsgCall = 16;
+
+class QuicPacketReader {
+ public:
+  QuicPacketReader();
+  ~QuicPacketReader();
+
+  // Reads up to kNumPacketsPerReadMmsgCall packets from |fd| with a single
+  // system call, and passes them off to |dispatcher|.  Returns true if some
+  // packets were read, false otherwise.
+  // If packets_dropped is non-null, the socket is configured to track
+  // dropped packets, and some packets are read, it will be set to the number of
+  // dropped packets.
+  bool ReadAndDispatchPackets(int fd, int port, QuicDispatcher* dispatcher,
+                              uint32* packets_dropped);
+
+ private:
+#if MMSG_MORE
+  // Points |mmsg_hdr_| at the buffers of |packets_|.
+  void Initialize();
+
+  // Space for the packet's contents (with some extra, so we can send an
+  // error if the client goes over the limit), its peer address and the
+  // self address and overflow control messages.
+  struct PacketData {
+    iovec iov;
+    sockaddr_storage raw_address;
+    char cbuf[CMSG_SPACE(sizeof(int)) + CMSG_SPACE(sizeof(in6_pktinfo))];
+    char buf[2 * kMaxPacketSize];
+  };
+
+  PacketData packets_[kNumPacketsPerReadMmsgCall];
+  mmsghdr mmsg_hdr_[kNumPacketsPerReadMmsgCall];
+#endif
+
+  DISALLOW_COPY_AND_ASSIGN(QuicPacketReader);
+};
+
+}  // namespace tools
+}  // namespace net
+
+#endif  // NET_TOOLS_QUIC_QUIC_PACKET_READER_H_
@@ -0,0 +1,113 @@
+// Copyright 2014 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "net/tools/quic/quic_packet_reader.h"
+
+#include <netinet/in.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include "net/base/ip_endpoint.h"
+#include "net/base/net_util.h"
+#include "net/quic/crypto/quic_random.h"
+#include "net/tools/quic/quic_socket_utils.h"
+#include "net/tools/quic/test_tools/mock_quic_dispatcher.h"
+#include "testing/gtest/include/gtest/gtest.h"
+
+using ::testing::_;
+
+namespace net {
+namespace tools {
+namespace test {
+namespace {
+
+#if MMSG_MORE
+
+class QuicPacketReaderTest : public ::testing::Test {
+ public:
+  QuicPacketReaderTest()
+      : crypto_config_("blah", QuicRandom::GetInstance()),
+        dispatcher_(config_, crypto_config_, &eps_),
+        server_fd_(-1),
+        client_fd_(-1) {
+  }
+
+  virtual void SetUp() OVERRIDE {
+    IPAddressNumber loopback;
+    ASSERT_TRUE(ParseIPLiteralToNumber("127.0.0.1", &loopback));
+    server_fd_ = socket(AF_INET, SOCK_DGRAM | SOCK_NONBLOCK, IPPROTO_UDP);
+    ASSERT_LE(0, server_fd_);
+    ASSERT_EQ(0, QuicSocketUtils::SetGetAddressInfo(server_fd_, AF_INET));
+
+    SockaddrStorage bind_address;
+    ASSERT_TRUE(IPEndPoint(loopback, 0).ToSockAddr(bind_address.addr,
+                                                    &bind_address.addr_len));
+    ASSERT_EQ(0, bind(server_fd_, bind_address.addr, bind_address.addr_len));
+    SockaddrStorage storage;
+    ASSERT_EQ(0, getsockname(server_fd_, storage.addr, &storage.addr_len));
+    ASSERT_TRUE(server_address_.FromSockAddr(storage.addr, storage.addr_len));
+
+    client_fd_ = socket(AF_INET, SOCK_DGRAM, IPPROTO_UDP);
+    ASSERT_LE(0, client_fd_);
+  }
+
+  virtual void TearDown() OVERRIDE {
+    if (server_fd_ >= 0)
+      close(server_fd_);
+    if (client_fd_ >= 0)
+      close(client_fd_);
+  }
+
+  void SendPacket(const char* data) {
+    WriteResult result = QuicSocketUtils::WritePacket(
+        client_fd_, data, strlen(data), IPAddressNumber(), server_address_);
+    EXPECT_EQ(WRITE_STATUS_OK, result.status);
+  }
+
+ protected:
+  QuicConfig config_;
+  QuicCryptoServerConfig crypto_config_;
+  EpollServer eps_;
+  MockQuicDispatcher dispatcher_;
+  QuicPacketReader reader_;
+  IPEndPoint server_address_;
+  int server_fd_;
+  int client_fd_;
+};
+
+TEST_F(QuicPacketReaderTest, ReadsAllPacketsInOneCall) {
+  SendPacket("one");
+  SendPacket("two");
+  SendPacket("three");
+
+  EXPECT_CALL(dispatcher_, ProcessPacket(server_address_, _, _)).Times(3);
+  EXPECT_TRUE(reader_.ReadAndDispatchPackets(
+      server_fd_, server_address_.port(), &dispatcher_, NULL));
+
+  // The socket has no more data.
+  EXPECT_FALSE(reader_.ReadAndDispatchPackets(
+      server_fd_, server_address_.port(), &dispatcher_, NULL));
+}
+
+TEST_F(QuicPacketReaderTest, ReadsLargeBatchesInSeveralCalls) {
+  for (int i = 0; i < kNumPacketsPerReadMmsgCall + 1; ++i)
+    SendPacket("packet");
+
+  EXPECT_CALL(dispatcher_, ProcessPacket(_, _, _))
+      .Times(kNumPacketsPerReadMmsgCall);
+  EXPECT_TRUE(reader_.ReadAndDispatchPackets(
+      server_fd_, server_address_.port(), &dispatcher_, NULL));
+  ::testing::Mock::VerifyAndClearExpectations(&dispatcher_);
+
+  EXPECT_CALL(dispatcher_, ProcessPacket(_, _, _)).Times(1);
+  EXPECT_TRUE(reader_.ReadAndDispatchPackets(
+      server_fd_, server_address_.port(), &dispatcher_, NULL));
+}
+
+#endif  // MMSG_MORE
+
+}  // namespace
+}  // namespace test
+}  // namespace tools
+}  // namespace net
@@ -11,6 +11,8 @@
 #include <sys/epoll.h>
 #include <sys/socket.h>
 
+#include <vector>
+
 #include "net/base/ip_endpoint.h"
 #include "net/quic/crypto/crypto_handshake.h"
 #include "net/quic/crypto/quic_random.h"
@@ -21,12 +23,14 @@
 #include "net/tools/quic/quic_in_memory_cache.h"
 #include "net/tools/quic/quic_socket_utils.h"
 
-#define MMSG_MORE 0
-
 #ifndef SO_RXQ_OVFL
 #define SO_RXQ_OVFL 40
 #endif
 
+#ifndef SO_REUSEPORT
+#define SO_REUSEPORT 15
+#endif
+
 const int kEpollFlags = EPOLLIN | EPOLLOUT | EPOLLET;
 static const char kSourceAddressTokenSecret[] = "secret";
 
@@ -39,6 +43,7 @@ QuicServer::QuicServer()
       packets_dropped_(0),
       overflow_supported_(false),
       use_recvmmsg_(false),
+      reuse_port_(false),
       crypto_config_(kSourceAddressTokenSecret, QuicRandom::GetInstance()),
       supported_versions_(QuicSupportedVersions()) {
   // Use hardcoded crypto parameters for now.
@@ -56,6 +61,7 @@ QuicServer::QuicServer(const QuicConfig& config,
       packets_dropped_(0),
       overflow_supported_(false),
       use_recvmmsg_(false),
+      reuse_port_(false),
       config_(config),
       crypto_config_(kSourceAddressTokenSecret, QuicRandom::GetInstance()),
       supported_versions_(supported_versions) {
@@ -65,6 +71,7 @@ QuicServer::QuicServer(const QuicConfig& config,
 void QuicServer::Initialize() {
 #if MMSG_MORE
   use_recvmmsg_ = true;
+  packet_reader_.reset(new QuicPacketReader());
 #endif
   epoll_server_.set_timeout_in_us(50 * 1000);
   // Initialize the in memory cache now.
@@ -81,6 +88,12 @@ void QuicServer::Initialize() {
 QuicServer::~QuicServer() {
 }
 
+bool QuicServer::SetServerConfig(QuicServerConfigProtobuf* protobuf) {
+  QuicEpollClock clock(&epoll_server_);
+  std::vector<QuicServerConfigProtobuf*> protobufs(1, protobuf);
+  return crypto_config_.SetConfigs(protobufs, clock.WallNow());
+}
+
 bool QuicServer::Listen(const IPEndPoint& address) {
   port_ = address.port();
   int address_family = address.GetSockAddrFamily();
@@ -121,6 +134,16 @@ bool QuicServer::Listen(const IPEndPoint& address) {
     return false;
   }
 
+  if (reuse_port_) {
+    int reuse_port = 1;
+    rc = setsockopt(fd_, SOL_SOCKET, SO_REUSEPORT,
+                    &reuse_port, sizeof(reuse_port));
+    if (rc < 0) {
+      LOG(ERROR) << "SO_REUSEPORT not supported: " << strerror(errno);
+      return false;
+    }
+  }
+
   sockaddr_storage raw_addr;
   socklen_t raw_addr_len = sizeof(raw_addr);
   CHECK(address.ToSockAddr(reinterpret_cast<sockaddr*>(&raw_addr),
@@ -173,11 +196,16 @@ void QuicServer::OnEvent(int fd, EpollEvent* event) {
 
   if (event->in_events & EPOLLIN) {
     DVLOG(1) << "EPOLLIN";
+    uint32* packets_dropped = overflow_supported_ ? &packets_dropped_ : NULL;
     bool read = true;
     while (read) {
+      if (use_recvmmsg_) {
+        read = packet_reader_->ReadAndDispatchPackets(
+            fd_, port_, dispatcher_.get(), packets_dropped);
+      } else {
         read = ReadAndDispatchSinglePacket(
-            fd_, port_, dispatcher_.get(),
-            overflow_supported_ ? &packets_dropped_ : NULL);
+            fd_, port_, dispatcher_.get(), packets_dropped);
+      }
     }
   }
   if (event->in_events & EPOLLOUT) {
@@ -16,6 +16,7 @@
 #include "net/quic/quic_framer.h"
 #include "net/tools/epoll_server/epoll_server.h"
 #include "net/tools/quic/quic_dispatcher.h"
+#include "net/tools/quic/quic_packet_reader.h"
 
 namespace net {
 
@@ -68,6 +69,26 @@ class QuicServer : public EpollCallbackInterface {
     crypto_config_.set_strike_register_no_startup_period();
   }
 
+  // Replaces the server's randomly generated server config with |protobuf|.
+  // Servers which share a port (see set_reuse_port) should share their config
+  // too, so that a client's cached config is valid whichever of them gets its
+  // packets.  Returns false if |protobuf| is invalid.
+  bool SetServerConfig(QuicServerConfigProtobuf* protobuf);
+
+  // Makes the server check client nonces with |strike_register_client|, and
+  // takes ownership of it.  Servers which share a config must also share a
+  // strike register, or a client hello replayed to another one of them would
+  // be accepted.
+  void SetStrikeRegisterClient(StrikeRegisterClient* strike_register_client) {
+    crypto_config_.SetStrikeRegisterClient(strike_register_client);
+  }
+
+  // If true, Listen() sets SO_REUSEPORT on the socket, so that several servers
+  // (each on its own thread) can listen on the same port.  The kernel then
+  // spreads the clients among them by address.  Must be called before
+  // Listen().
+  void set_reuse_port(bool reuse_port) { reuse_port_ = reuse_port; }
+
   bool overflow_supported() { return overflow_supported_; }
 
   uint32 packets_dropped() { return packets_dropped_; }
@@ -103,6 +124,12 @@ class QuicServer : public EpollCallbackInterface {
   // If true, use recvmmsg for reading.
   bool use_recvmmsg_;
 
+  // If true, set SO_REUSEPORT on the listening socket.
+  bool reuse_port_;
+
+  // Reads a batch of packets per call when |use_recvmmsg_| is true.
+  scoped_ptr<QuicPacketReader> packet_reader_;
+
   // config_ contains non-crypto parameters that are negotiated in the crypto
   // handshake.
   QuicConfig config_;
@@ -11,8 +11,17 @@
 #include "base/basictypes.h"
 #include "base/command_line.h"
 #include "base/logging.h"
+#include "base/memory/scoped_ptr.h"
+#include "base/memory/scoped_vector.h"
 #include "base/strings/string_number_conversions.h"
+#include "base/threading/simple_thread.h"
 #include "net/base/ip_endpoint.h"
+#include "net/quic/crypto/crypto_protocol.h"
+#include "net/quic/crypto/crypto_server_config_protobuf.h"
+#include "net/quic/crypto/local_strike_register_client.h"
+#include "net/quic/crypto/quic_random.h"
+#include "net/quic/crypto/strike_register_client.h"
+#include "net/quic/quic_clock.h"
 #include "net/tools/quic/quic_in_memory_cache.h"
 #include "net/tools/quic/quic_server.h"
 
@@ -20,6 +29,57 @@
 
 int32 FLAGS_port = 6121;
 
+// The number of threads serving the port, each with its own socket.
+int32 FLAGS_num_threads = 1;
+
+namespace {
+
+// Runs an additional server listening on the same port as the main one.
+class QuicServerThread : public base::SimpleThread {
+ public:
+  explicit QuicServerThread(net::tools::QuicServer* server)
+      : base::SimpleThread("QuicServerThread"),
+        server_(server) {
+  }
+
+  virtual void Run() OVERRIDE {
+    while (1) {
+      server_->WaitForEvents();
+    }
+  }
+
+ private:
+  scoped_ptr<net::tools::QuicServer> server_;
+
+  DISALLOW_COPY_AND_ASSIGN(QuicServerThread);
+};
+
+// Forwards to the strike register that all the servers share, which outlives
+// them.
+class SharedStrikeRegisterClient : public net::StrikeRegisterClient {
+ public:
+  explicit SharedStrikeRegisterClient(net::StrikeRegisterClient* shared)
+      : shared_(shared) {
+  }
+
+  virtual bool IsKnownOrbit(base::StringPiece orbit) const OVERRIDE {
+    return shared_->IsKnownOrbit(orbit);
+  }
+
+  virtual void VerifyNonceIsValidAndUnique(base::StringPiece nonce,
+                                           net::QuicWallTime now,
+                                           ResultCallback* cb) OVERRIDE {
+    shared_->VerifyNonceIsValidAndUnique(nonce, now, cb);
+  }
+
+ private:
+  net::StrikeRegisterClient* shared_;
+
+  DISALLOW_COPY_AND_ASSIGN(SharedStrikeRegisterClient);
+};
+
+}  // namespace
+
 int main(int argc, char *argv[]) {
   CommandLine::Init(argc, argv);
   CommandLine* line = CommandLine::ForCurrentProcess();
@@ -35,6 +95,7 @@ int main(int argc, char *argv[]) {
         "Options:\n"
         "-h, --help                  show this help message and exit\n"
         "--port=<port>               specify the port to listen on\n"
+        "--num_threads=<n>           serve the port from n threads\n"
         "--quic_in_memory_cache_dir  directory containing response data\n"
         "                            to load\n";
     std::cout << help_str;
@@ -53,6 +114,14 @@ int main(int argc, char *argv[]) {
     }
   }
 
+  if (line->HasSwitch("num_threads")) {
+    int num_threads;
+    if (base::StringToInt(line->GetSwitchValueASCII("num_threads"),
+                          &num_threads) && num_threads > 0) {
+      FLAGS_num_threads = num_threads;
+    }
+  }
+
   base::AtExitManager exit_manager;
 
   net::IPAddressNumber ip;
@@ -60,10 +129,51 @@ int main(int argc, char *argv[]) {
 
   net::tools::QuicServer server;
 
+  // All the servers use the same server config, so that a client can resume
+  // with any of them. They also check client nonces against the same strike
+  // register, which is thread-safe, so that a client hello can't be replayed
+  // to another server.
+  scoped_ptr<net::QuicServerConfigProtobuf> server_config;
+  scoped_ptr<net::LocalStrikeRegisterClient> strike_register;
+  if (FLAGS_num_threads > 1) {
+    net::QuicClock clock;
+    net::QuicCryptoServerConfig::ConfigOptions options;
+    uint8 orbit[net::kOrbitSize];
+    net::QuicRandom::GetInstance()->RandBytes(orbit, sizeof(orbit));
+    options.orbit.assign(reinterpret_cast<const char*>(orbit), sizeof(orbit));
+    server_config.reset(net::QuicCryptoServerConfig::GenerateConfig(
+        net::QuicRandom::GetInstance(), &clock, options));
+    strike_register.reset(new net::LocalStrikeRegisterClient(
+        (1 << 10) * FLAGS_num_threads,
+        static_cast<uint32>(clock.WallNow().ToUNIXSeconds()),
+        600 /* window_secs */,
+        orbit,
+        net::StrikeRegister::DENY_REQUESTS_AT_STARTUP));
+    CHECK(server.SetServerConfig(server_config.get()));
+    server.SetStrikeRegisterClient(
+        new SharedStrikeRegisterClient(strike_register.get()));
+    server.set_reuse_port(true);
+  }
+
   if (!server.Listen(net::IPEndPoint(ip, FLAGS_port))) {
     return 1;
   }
 
+  ScopedVector<QuicServerThread> threads;
+  for (int i = 1; i < FLAGS_num_threads; ++i) {
+    net::tools::QuicServer* thread_server = new net::tools::QuicServer();
+    CHECK(thread_server->SetServerConfig(server_config.get()));
+    thread_server->SetStrikeRegisterClient(
+        new SharedStrikeRegisterClient(strike_register.get()));
+    thread_server->set_reuse_port(true);
+    if (!thread_server->Listen(net::IPEndPoint(ip, server.port()))) {
+      delete thread_server;
+      return 1;
+    }
+    threads.push_back(new QuicServerThread(thread_server));
+    threads.back()->Start();
+  }
+
   while (1) {
     server.WaitForEvents();
   }
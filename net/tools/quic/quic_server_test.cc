@@ -4,6 +4,7 @@
 
 #include "net/tools/quic/quic_server.h"
 
+#include "net/base/net_util.h"
 #include "net/quic/crypto/quic_random.h"
 #include "net/quic/quic_utils.h"
 #include "net/tools/quic/test_tools/mock_quic_dispatcher.h"
@@ -56,6 +57,22 @@ TEST_F(QuicServerDispatchPacketTest, DispatchPacket) {
   DispatchPacket(encrypted_valid_packet);
 }
 
+TEST(QuicServerTest, ServersShareAPortWithReusePort) {
+  IPAddressNumber ip;
+  ASSERT_TRUE(ParseIPLiteralToNumber("127.0.0.1", &ip));
+
+  QuicServer server1;
+  server1.set_reuse_port(true);
+  ASSERT_TRUE(server1.Listen(IPEndPoint(ip, 0)));
+
+  QuicServer server2;
+  server2.set_reuse_port(true);
+  EXPECT_TRUE(server2.Listen(IPEndPoint(ip, server1.port())));
+
+  server2.Shutdown();
+  server1.Shutdown();
+}
+
 }  // namespace
 }  // namespace test
 }  // namespace tools
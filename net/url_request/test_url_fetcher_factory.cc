@@ -42,6 +42,7 @@ TestURLFetcher::TestURLFetcher(int id,
       delegate_for_tests_(NULL),
       did_receive_last_chunk_(false),
       fake_load_flags_(0),
+      fake_priority_(DEFAULT_PRIORITY),
       fake_response_code_(-1),
       fake_response_destination_(STRING),
       fake_was_fetched_via_proxy_(false),
@@ -89,6 +90,10 @@ int TestURLFetcher::GetLoadFlags() const {
   return fake_load_flags_;
 }
 
+void TestURLFetcher::SetPriority(RequestPriority priority) {
+  fake_priority_ = priority;
+}
+
 void TestURLFetcher::SetReferrer(const std::string& referrer) {
 }
 
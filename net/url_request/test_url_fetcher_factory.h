@@ -103,6 +103,7 @@ class TestURLFetcher : public URLFetcher {
                                    bool is_last_chunk) OVERRIDE;
   virtual void SetLoadFlags(int load_flags) OVERRIDE;
   virtual int GetLoadFlags() const OVERRIDE;
+  virtual void SetPriority(RequestPriority priority) OVERRIDE;
   virtual void SetReferrer(const std::string& referrer) OVERRIDE;
   virtual void SetReferrerPolicy(
       URLRequest::ReferrerPolicy referrer_policy) OVERRIDE;
@@ -159,6 +160,9 @@ class TestURLFetcher : public URLFetcher {
   // Unique ID in our factory.
   int id() const { return id_; }
 
+  // Returns the priority set with SetPriority().
+  RequestPriority priority() const { return fake_priority_; }
+
   // Returns the data uploaded on this URLFetcher.
   const std::string& upload_data() const { return upload_data_; }
   const base::FilePath& upload_file_path() const { return upload_file_path_; }
@@ -210,6 +214,7 @@ class TestURLFetcher : public URLFetcher {
   // has no setters. The data is a private member of a class defined
   // in a .cc file, so we can't get at it with friendship.
   int fake_load_flags_;
+  RequestPriority fake_priority_;
   GURL fake_url_;
   URLRequestStatus fake_status_;
   int fake_response_code_;
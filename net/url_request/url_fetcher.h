@@ -13,6 +13,7 @@
 #include "base/memory/scoped_ptr.h"
 #include "base/supports_user_data.h"
 #include "net/base/net_export.h"
+#include "net/base/request_priority.h"
 #include "net/url_request/url_request.h"
 
 class GURL;
@@ -167,6 +168,11 @@ class NET_EXPORT URLFetcher {
   // Returns the current load flags.
   virtual int GetLoadFlags() const = 0;
 
+  // Sets the priority of the request, DEFAULT_PRIORITY by default. Background
+  // fetches should use IDLE, so that they yield sockets and streams to the
+  // loads of the user. If the request has been started, it is reprioritized.
+  virtual void SetPriority(RequestPriority priority) = 0;
+
   // The referrer URL for the request. Must be called before the request is
   // started.
   virtual void SetReferrer(const std::string& referrer) = 0;
@@ -75,6 +75,7 @@ URLFetcherCore::URLFetcherCore(URLFetcher* fetcher,
       delegate_(d),
       delegate_task_runner_(base::ThreadTaskRunnerHandle::Get()),
       load_flags_(LOAD_NORMAL),
+      priority_(DEFAULT_PRIORITY),
       response_code_(URLFetcher::RESPONSE_CODE_INVALID),
       buffer_(new IOBuffer(kBufferSize)),
       url_request_data_key_(NULL),
@@ -202,6 +203,18 @@ int URLFetcherCore::GetLoadFlags() const {
   return load_flags_;
 }
 
+void URLFetcherCore::SetPriority(RequestPriority priority) {
+  // Once started, |priority_| belongs to the network thread, which also
+  // reprioritizes the request in flight.
+  if (network_task_runner_.get()) {
+    network_task_runner_->PostTask(
+        FROM_HERE,
+        base::Bind(&URLFetcherCore::SetPriorityOnIOThread, this, priority));
+    return;
+  }
+  priority_ = priority;
+}
+
 void URLFetcherCore::SetReferrer(const std::string& referrer) {
   referrer_ = referrer;
 }
@@ -507,7 +520,7 @@ void URLFetcherCore::StartURLRequest() {
   g_registry.Get().AddURLFetcherCore(this);
   current_response_bytes_ = 0;
   request_ = request_context_getter_->GetURLRequestContext()->CreateRequest(
-      original_url_, DEFAULT_PRIORITY, this);
+      original_url_, priority_, this);
   request_->set_stack_trace(stack_trace_);
   int flags = request_->load_flags() | load_flags_;
   if (!g_interception_enabled)
@@ -784,6 +797,13 @@ base::TimeTicks URLFetcherCore::GetBackoffReleaseTime() {
   }
 }
 
+void URLFetcherCore::SetPriorityOnIOThread(RequestPriority priority) {
+  DCHECK(network_task_runner_->BelongsToCurrentThread());
+  priority_ = priority;
+  if (request_.get())
+    request_->SetPriority(priority);
+}
+
 void URLFetcherCore::CompleteAddingUploadDataChunk(
     const std::string& content, bool is_last_chunk) {
   if (was_cancelled_) {
@@ -76,6 +76,7 @@ class URLFetcherCore
   // one or more of the LOAD_* flags defined in net/base/load_flags.h.
   void SetLoadFlags(int load_flags);
   int GetLoadFlags() const;
+  void SetPriority(RequestPriority priority);
   void SetReferrer(const std::string& referrer);
   void SetReferrerPolicy(URLRequest::ReferrerPolicy referrer_policy);
   void SetExtraRequestHeaders(const std::string& extra_request_headers);
@@ -187,6 +188,8 @@ class URLFetcherCore
   void CompleteAddingUploadDataChunk(const std::string& data,
                                      bool is_last_chunk);
 
+  void SetPriorityOnIOThread(RequestPriority priority);
+
   // Writes all bytes stored in |data| with |response_writer_|.
   // Returns OK if all bytes in |data| get written synchronously. Otherwise,
   // returns ERR_IO_PENDING or a network error code.
@@ -219,6 +222,7 @@ class URLFetcherCore
   scoped_refptr<base::TaskRunner> upload_file_task_runner_;
   scoped_ptr<URLRequest> request_;   // The actual request this wraps
   int load_flags_;                   // Flags for the load operation
+  RequestPriority priority_;         // Priority of the load operation
   int response_code_;                // HTTP status code for the request
   scoped_refptr<IOBuffer> buffer_;
                                      // Read buffer
@@ -49,6 +49,7 @@ class NET_EXPORT_PRIVATE URLFetcherImpl : public URLFetcher {
                                    bool is_last_chunk) OVERRIDE;
   virtual void SetLoadFlags(int load_flags) OVERRIDE;
   virtual int GetLoadFlags() const OVERRIDE;
+  virtual void SetPriority(RequestPriority priority) OVERRIDE;
   virtual void SetReferrer(const std::string& referrer) OVERRIDE;
   virtual void SetReferrerPolicy(
       URLRequest::ReferrerPolicy referrer_policy) OVERRIDE;
@@ -11,6 +11,7 @@
 #include "base/file_util.h"
 #include "base/files/scoped_temp_dir.h"
 #include "base/message_loop/message_loop_proxy.h"
+#include "base/run_loop.h"
 #include "base/strings/stringprintf.h"
 #include "base/synchronization/waitable_event.h"
 #include "base/threading/thread.h"
@@ -22,6 +23,8 @@
 #include "net/test/spawned_test_server/spawned_test_server.h"
 #include "net/url_request/url_fetcher_delegate.h"
 #include "net/url_request/url_request_context_getter.h"
+#include "net/url_request/url_request_job_factory_impl.h"
+#include "net/url_request/url_request_test_job.h"
 #include "net/url_request/url_request_test_util.h"
 #include "net/url_request/url_request_throttler_manager.h"
 #include "testing/gtest/include/gtest/gtest.h"
@@ -77,6 +80,28 @@ class ThrottlingTestURLRequestContextGetter
   TestURLRequestContext* const context_;
 };
 
+// Serves requests with a URLRequestTestJob that waits to be advanced by hand,
+// and keeps a reference to the last job so that tests can inspect it.
+class TestJobProtocolHandler : public URLRequestJobFactory::ProtocolHandler {
+ public:
+  TestJobProtocolHandler() {}
+  virtual ~TestJobProtocolHandler() {}
+
+  // URLRequestJobFactory::ProtocolHandler:
+  virtual URLRequestJob* MaybeCreateJob(
+      URLRequest* request, NetworkDelegate* network_delegate) const OVERRIDE {
+    job_ = new URLRequestTestJob(request, network_delegate, false);
+    return job_.get();
+  }
+
+  URLRequestTestJob* job() const { return job_.get(); }
+
+ private:
+  mutable scoped_refptr<URLRequestTestJob> job_;
+
+  DISALLOW_COPY_AND_ASSIGN(TestJobProtocolHandler);
+};
+
 }  // namespace
 
 class URLFetcherTest : public testing::Test,
@@ -918,6 +943,36 @@ TEST_F(URLFetcherTest, DifferentThreadsTest) {
   base::MessageLoop::current()->Run();
 }
 
+// Make sure that SetPriority() reaches the URLRequest, and its job, while the
+// fetch is in flight.
+TEST_F(URLFetcherTest, SetPriorityWhileRunning) {
+  TestJobProtocolHandler* handler = new TestJobProtocolHandler;
+  URLRequestJobFactoryImpl job_factory;
+  job_factory.SetProtocolHandler("test", handler);
+  request_context()->set_job_factory(&job_factory);
+
+  fetcher_ = new URLFetcherImpl(URLRequestTestJob::test_url_1(),
+                                URLFetcher::GET, this);
+  fetcher_->SetRequestContext(new ThrottlingTestURLRequestContextGetter(
+      io_message_loop_proxy().get(), request_context()));
+  fetcher_->SetPriority(LOW);
+  fetcher_->Start();
+  base::RunLoop().RunUntilIdle();
+
+  // The job has sent its headers and waits to be advanced.
+  ASSERT_TRUE(handler->job());
+  EXPECT_EQ(LOW, handler->job()->priority());
+
+  fetcher_->SetPriority(IDLE);
+  base::RunLoop().RunUntilIdle();
+  EXPECT_EQ(IDLE, handler->job()->priority());
+
+  // Let the job finish; OnURLFetchComplete() checks the response.
+  while (URLRequestTestJob::ProcessOnePendingMessage())
+    base::RunLoop().RunUntilIdle();
+  EXPECT_EQ(0, GetNumFetcherCores());
+}
+
 void CancelAllOnIO() {
   EXPECT_EQ(1, URLFetcherTest::GetNumFetcherCores());
   URLFetcherImpl::CancelAll();
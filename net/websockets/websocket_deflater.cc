@@ -6,7 +6,6 @@
 
 #include <string.h>
 #include <algorithm>
-#include <deque>
 #include <vector>
 
 #include "base/logging.h"
@@ -15,8 +14,24 @@
 
 namespace net {
 
+namespace {
+
+// The amount of space added at the end of the output for each call to
+// deflate().
+const size_t kOutputChunkSize = 4096;
+
+}  // namespace
+
+const int WebSocketDeflater::kDefaultMemLevel;
+
 WebSocketDeflater::WebSocketDeflater(ContextTakeOverMode mode)
-    : mode_(mode), are_bytes_added_(false) {}
+    : mode_(mode), mem_level_(kDefaultMemLevel), are_bytes_added_(false) {}
+
+WebSocketDeflater::WebSocketDeflater(ContextTakeOverMode mode, int mem_level)
+    : mode_(mode), mem_level_(mem_level), are_bytes_added_(false) {
+  DCHECK_LE(1, mem_level);
+  DCHECK_GE(9, mem_level);
+}
 
 WebSocketDeflater::~WebSocketDeflater() {
   if (stream_) {
@@ -36,15 +51,13 @@ bool WebSocketDeflater::Initialize(int window_bits) {
                             Z_DEFAULT_COMPRESSION,
                             Z_DEFLATED,
                             -window_bits,  // Negative value for raw deflate
-                            8,  // default mem level
+                            mem_level_,
                             Z_DEFAULT_STRATEGY);
   if (result != Z_OK) {
     deflateEnd(stream_.get());
     stream_.reset();
     return false;
   }
-  const size_t kFixedBufferSize = 4096;
-  fixed_buffer_.resize(kFixedBufferSize);
   return true;
 }
 
@@ -97,12 +110,13 @@ void WebSocketDeflater::PushSyncMark() {
 }
 
 scoped_refptr<IOBufferWithSize> WebSocketDeflater::GetOutput(size_t size) {
-  std::deque<char>::iterator begin = buffer_.begin();
-  std::deque<char>::iterator end = begin + std::min(size, buffer_.size());
-
-  scoped_refptr<IOBufferWithSize> result = new IOBufferWithSize(end - begin);
-  std::copy(begin, end, result->data());
-  buffer_.erase(begin, end);
+  size = std::min(size, buffer_.size());
+  scoped_refptr<IOBufferWithSize> result = new IOBufferWithSize(size);
+  if (size) {
+    memcpy(result->data(), &buffer_[0], size);
+    // Usually all of the output is taken, which leaves nothing to move.
+    buffer_.erase(buffer_.begin(), buffer_.begin() + size);
+  }
   return result;
 }
 
@@ -115,11 +129,12 @@ void WebSocketDeflater::ResetContext() {
 int WebSocketDeflater::Deflate(int flush) {
   int result = Z_OK;
   do {
-    stream_->next_out = reinterpret_cast<Bytef*>(&fixed_buffer_[0]);
-    stream_->avail_out = fixed_buffer_.size();
+    const size_t used = buffer_.size();
+    buffer_.resize(used + kOutputChunkSize);
+    stream_->next_out = reinterpret_cast<Bytef*>(&buffer_[used]);
+    stream_->avail_out = kOutputChunkSize;
     result = deflate(stream_.get(), flush);
-    size_t size = fixed_buffer_.size() - stream_->avail_out;
-    buffer_.insert(buffer_.end(), &fixed_buffer_[0], &fixed_buffer_[0] + size);
+    buffer_.resize(buffer_.size() - stream_->avail_out);
   } while (result == Z_OK);
   return result;
 }
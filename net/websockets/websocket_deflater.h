@@ -5,7 +5,6 @@
 #ifndef NET_WEBSOCKETS_WEBSOCKET_DEFLATER_H_
 #define NET_WEBSOCKETS_WEBSOCKET_DEFLATER_H_
 
-#include <deque>
 #include <vector>
 
 #include "base/basictypes.h"
@@ -27,6 +26,10 @@ class NET_EXPORT_PRIVATE WebSocketDeflater {
   };
 
   explicit WebSocketDeflater(ContextTakeOverMode mode);
+  // |mem_level| is the zlib memLevel, which must be between 1 and 9 (both
+  // inclusive). Lower values use less memory per stream, at the expense of
+  // the compression ratio.
+  WebSocketDeflater(ContextTakeOverMode mode, int mem_level);
   ~WebSocketDeflater();
 
   // Returns true if there is no error and false otherwise.
@@ -56,14 +59,18 @@ class NET_EXPORT_PRIVATE WebSocketDeflater {
   // Returns the size of the current deflated output.
   size_t CurrentOutputSize() const { return buffer_.size(); }
 
+  static const int kDefaultMemLevel = 8;
+
  private:
   void ResetContext();
   int Deflate(int flush);
 
   scoped_ptr<z_stream_s> stream_;
   ContextTakeOverMode mode_;
-  std::deque<char> buffer_;
-  std::vector<char> fixed_buffer_;
+  int mem_level_;
+  // The deflated output. deflate() writes to its end directly, and its
+  // capacity is kept between messages.
+  std::vector<char> buffer_;
   // true if bytes were added after last Finish().
   bool are_bytes_added_;
 
@@ -133,6 +133,33 @@ TEST(WebSocketDeflaterTest, WindowBits10) {
       ToString(actual.get()));
 }
 
+TEST(WebSocketDeflaterTest, MemLevel1) {
+  WebSocketDeflater deflater(WebSocketDeflater::DO_NOT_TAKE_OVER_CONTEXT, 1);
+  ASSERT_TRUE(deflater.Initialize(15));
+  scoped_refptr<IOBufferWithSize> actual;
+
+  ASSERT_TRUE(deflater.AddBytes("Hello", 5));
+  ASSERT_TRUE(deflater.Finish());
+  actual = deflater.GetOutput(deflater.CurrentOutputSize());
+  EXPECT_EQ(std::string("\xf2\x48\xcd\xc9\xc9\x07\x00", 7),
+            ToString(actual.get()));
+}
+
+TEST(WebSocketDeflaterTest, GetPartialOutput) {
+  WebSocketDeflater deflater(WebSocketDeflater::TAKE_OVER_CONTEXT);
+  deflater.Initialize(15);
+  scoped_refptr<IOBufferWithSize> actual1, actual2;
+
+  ASSERT_TRUE(deflater.AddBytes("Hello", 5));
+  ASSERT_TRUE(deflater.Finish());
+  actual1 = deflater.GetOutput(3);
+  EXPECT_EQ(std::string("\xf2\x48\xcd", 3), ToString(actual1.get()));
+  ASSERT_EQ(4u, deflater.CurrentOutputSize());
+  actual2 = deflater.GetOutput(100);
+  EXPECT_EQ(std::string("\xc9\xc9\x07\x00", 4), ToString(actual2.get()));
+  ASSERT_EQ(0u, deflater.CurrentOutputSize());
+}
+
 }  // namespace
 
 }  // namespace net
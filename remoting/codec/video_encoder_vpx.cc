@@ -4,6 +4,8 @@
 
 #include "remoting/codec/video_encoder_vpx.h"
 
+#include <algorithm>
+
 #include "base/bind.h"
 #include "base/logging.h"
 #include "base/sys_info.h"
@@ -29,6 +31,30 @@ namespace {
 // map for the encoder.
 const int kMacroBlockSize = 16;
 
+// Desktops larger than this are encoded with more than 2 threads when there
+// are enough cores.
+const int kLargeDesktopArea = 1920 * 1200;
+
+// The maximum number of encoder threads.
+const int kMaxEncoderThreads = 4;
+
+int GetEncoderThreadCount(const webrtc::DesktopSize& size) {
+  // Using 2 threads gives a great boost in performance for most systems with
+  // adequate processing power. NB: Going to multiple threads on low end
+  // windows systems can really hurt performance.
+  // http://crbug.com/99179
+  int num_of_processors = base::SysInfo::NumberOfProcessors();
+  if (num_of_processors <= 2)
+    return 1;
+
+  // Large (e.g. multi-monitor) desktops can't be encoded within the frame
+  // interval on 2 threads. Use up to half the cores for them, leaving the rest
+  // for capturing and for the other processes on the host.
+  if (size.width() * size.height() > kLargeDesktopArea)
+    return std::max(2, std::min(num_of_processors / 2, kMaxEncoderThreads));
+  return 2;
+}
+
 ScopedVpxCodec CreateVP8Codec(const webrtc::DesktopSize& size) {
   ScopedVpxCodec codec(new vpx_codec_ctx_t);
 
@@ -51,11 +77,7 @@ ScopedVpxCodec CreateVP8Codec(const webrtc::DesktopSize& size) {
   // encoding.
   config.g_profile = 2;
 
-  // Using 2 threads gives a great boost in performance for most systems with
-  // adequate processing power. NB: Going to multiple threads on low end
-  // windows systems can really hurt performance.
-  // http://crbug.com/99179
-  config.g_threads = (base::SysInfo::NumberOfProcessors() > 2) ? 2 : 1;
+  config.g_threads = GetEncoderThreadCount(size);
   config.rc_min_quantizer = 20;
   config.rc_max_quantizer = 30;
   config.g_timebase.num = 1;
@@ -74,6 +96,19 @@ ScopedVpxCodec CreateVP8Codec(const webrtc::DesktopSize& size) {
   if (vpx_codec_control(codec.get(), VP8E_SET_NOISE_SENSITIVITY, 0))
     return ScopedVpxCodec();
 
+  // Split the token data in as many partitions as there are threads, so that
+  // the bitstream of each partition can be packed in parallel.
+  vp8e_token_partitions token_partitions = VP8_ONE_TOKENPARTITION;
+  if (config.g_threads >= 4) {
+    token_partitions = VP8_FOUR_TOKENPARTITION;
+  } else if (config.g_threads >= 2) {
+    token_partitions = VP8_TWO_TOKENPARTITION;
+  }
+  if (vpx_codec_control(codec.get(), VP8E_SET_TOKEN_PARTITIONS,
+                        token_partitions)) {
+    return ScopedVpxCodec();
+  }
+
   return codec.Pass();
 }
 
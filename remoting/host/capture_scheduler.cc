@@ -12,7 +12,7 @@
 
 namespace {
 
-// Number of samples to average the most recent capture and encode time
+// Number of samples to average the most recent capture, encode and send time
 // over.
 const int kStatisticsWindow = 3;
 
@@ -34,7 +34,8 @@ CaptureScheduler::CaptureScheduler()
           base::TimeDelta::FromMilliseconds(kDefaultMinimumIntervalMs)),
       num_of_processors_(base::SysInfo::NumberOfProcessors()),
       capture_time_(kStatisticsWindow),
-      encode_time_(kStatisticsWindow) {
+      encode_time_(kStatisticsWindow),
+      send_time_(kStatisticsWindow) {
   DCHECK(num_of_processors_);
 }
 
@@ -49,6 +50,13 @@ base::TimeDelta CaptureScheduler::NextCaptureDelay() {
       (capture_time_.Average() + encode_time_.Average()) /
       (kRecordingCpuConsumption * num_of_processors_));
 
+  // Capturing faster than the frames can be sent only makes them wait in the
+  // network, adding to the latency.
+  base::TimeDelta send_time =
+      base::TimeDelta::FromMilliseconds(send_time_.Average());
+  if (delay < send_time)
+    delay = send_time;
+
   if (delay < minimum_interval_)
     return minimum_interval_;
   return delay;
@@ -62,6 +70,10 @@ void CaptureScheduler::RecordEncodeTime(base::TimeDelta encode_time) {
   encode_time_.Record(encode_time.InMilliseconds());
 }
 
+void CaptureScheduler::RecordSendTime(base::TimeDelta send_time) {
+  send_time_.Record(send_time.InMilliseconds());
+}
+
 void CaptureScheduler::SetNumOfProcessorsForTest(int num_of_processors) {
   num_of_processors_ = num_of_processors;
 }
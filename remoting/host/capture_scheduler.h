@@ -4,7 +4,9 @@
 
 // This class chooses a capture interval so as to limit CPU usage to not exceed
 // a specified %age. It bases this on the CPU usage of recent capture and encode
-// operations, and on the number of available CPUs.
+// operations, and on the number of available CPUs. It also keeps the capture
+// interval above the time recently needed to send a frame to the client, so
+// that frames don't queue up in the network when the bandwidth drops.
 
 #ifndef REMOTING_HOST_CAPTURE_SCHEDULER_H_
 #define REMOTING_HOST_CAPTURE_SCHEDULER_H_
@@ -27,6 +29,10 @@ class CaptureScheduler {
   void RecordCaptureTime(base::TimeDelta capture_time);
   void RecordEncodeTime(base::TimeDelta encode_time);
 
+  // Records time spent on sending a frame to the client, not counting the
+  // time it waited for the previous frames to be sent.
+  void RecordSendTime(base::TimeDelta send_time);
+
   // Sets minimum interval between frames.
   void set_minimum_interval(base::TimeDelta minimum_interval) {
     minimum_interval_ = minimum_interval;
@@ -40,6 +46,7 @@ class CaptureScheduler {
   int num_of_processors_;
   RunningAverage capture_time_;
   RunningAverage encode_time_;
+  RunningAverage send_time_;
 
   DISALLOW_COPY_AND_ASSIGN(CaptureScheduler);
 };
@@ -84,4 +84,28 @@ TEST(CaptureSchedulerTest, RollingAverageDifferentTimes) {
   }
 }
 
+TEST(CaptureSchedulerTest, SendTimeLimitsFrameRate) {
+  CaptureScheduler scheduler;
+  scheduler.SetNumOfProcessorsForTest(1);
+  scheduler.set_minimum_interval(
+      base::TimeDelta::FromMilliseconds(kMinumumFrameIntervalMs));
+  scheduler.RecordCaptureTime(base::TimeDelta::FromMilliseconds(10));
+  scheduler.RecordEncodeTime(base::TimeDelta::FromMilliseconds(10));
+  EXPECT_EQ(kMinumumFrameIntervalMs,
+            scheduler.NextCaptureDelay().InMilliseconds());
+
+  // Sending slower than capturing and encoding delays the next capture.
+  scheduler.RecordSendTime(base::TimeDelta::FromMilliseconds(100));
+  EXPECT_EQ(100, scheduler.NextCaptureDelay().InMilliseconds());
+  scheduler.RecordSendTime(base::TimeDelta::FromMilliseconds(20));
+  EXPECT_EQ(60, scheduler.NextCaptureDelay().InMilliseconds());
+
+  // Fast sends don't get below the CPU based delay.
+  scheduler.RecordSendTime(base::TimeDelta::FromMilliseconds(0));
+  scheduler.RecordSendTime(base::TimeDelta::FromMilliseconds(0));
+  scheduler.RecordSendTime(base::TimeDelta::FromMilliseconds(0));
+  EXPECT_EQ(kMinumumFrameIntervalMs,
+            scheduler.NextCaptureDelay().InMilliseconds());
+}
+
 }  // namespace remoting
@@ -228,9 +228,11 @@ void VideoScheduler::CaptureNextFrame() {
   capturer_->Capture(webrtc::DesktopRegion());
 }
 
-void VideoScheduler::FrameCaptureCompleted() {
+void VideoScheduler::FrameCaptureCompleted(base::TimeDelta send_time) {
   DCHECK(capture_task_runner_->BelongsToCurrentThread());
 
+  scheduler_.RecordSendTime(send_time);
+
   // Decrement the pending capture count.
   pending_frames_--;
   DCHECK_GE(pending_frames_, 0);
@@ -250,17 +252,27 @@ void VideoScheduler::SendVideoPacket(scoped_ptr<VideoPacket> packet) {
     return;
 
   video_stub_->ProcessVideoPacket(
-      packet.Pass(), base::Bind(&VideoScheduler::VideoFrameSentCallback, this));
+      packet.Pass(), base::Bind(&VideoScheduler::VideoFrameSentCallback, this,
+                                base::TimeTicks::Now()));
 }
 
-void VideoScheduler::VideoFrameSentCallback() {
+void VideoScheduler::VideoFrameSentCallback(base::TimeTicks send_start_time) {
   DCHECK(network_task_runner_->BelongsToCurrentThread());
 
   if (!video_stub_)
     return;
 
+  // Frames are sent in order, so a frame passed to |video_stub_| while the
+  // previous one was still being sent only started sending once the previous
+  // one was done.
+  base::TimeTicks now = base::TimeTicks::Now();
+  base::TimeDelta send_time =
+      now - std::max(send_start_time, last_frame_sent_time_);
+  last_frame_sent_time_ = now;
+
   capture_task_runner_->PostTask(
-      FROM_HERE, base::Bind(&VideoScheduler::FrameCaptureCompleted, this));
+      FROM_HERE, base::Bind(&VideoScheduler::FrameCaptureCompleted, this,
+                            send_time));
 }
 
 void VideoScheduler::SendCursorShape(
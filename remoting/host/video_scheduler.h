@@ -131,7 +131,8 @@ class VideoScheduler : public base::RefCountedThreadSafe<VideoScheduler>,
   void CaptureNextFrame();
 
   // Called when a frame capture has been encoded & sent to the client.
-  void FrameCaptureCompleted();
+  // |send_time| is how long the network took to send it.
+  void FrameCaptureCompleted(base::TimeDelta send_time);
 
   // Network thread -----------------------------------------------------------
 
@@ -139,8 +140,9 @@ class VideoScheduler : public base::RefCountedThreadSafe<VideoScheduler>,
   void SendVideoPacket(scoped_ptr<VideoPacket> packet);
 
   // Callback passed to |video_stub_| for the last packet in each frame, to
-  // rate-limit frame captures to network throughput.
-  void VideoFrameSentCallback();
+  // rate-limit frame captures to network throughput. |send_start_time| is the
+  // time at which the frame was passed to |video_stub_|.
+  void VideoFrameSentCallback(base::TimeTicks send_start_time);
 
   // Send updated cursor shape to client.
   void SendCursorShape(scoped_ptr<protocol::CursorShapeInfo> cursor_shape);
@@ -170,6 +172,10 @@ class VideoScheduler : public base::RefCountedThreadSafe<VideoScheduler>,
   protocol::CursorShapeStub* cursor_stub_;
   protocol::VideoStub* video_stub_;
 
+  // Time at which the last frame finished sending. Always accessed on the
+  // network thread.
+  base::TimeTicks last_frame_sent_time_;
+
   // Timer used to schedule CaptureNextFrame().
   scoped_ptr<base::OneShotTimer<VideoScheduler> > capture_timer_;
 
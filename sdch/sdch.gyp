@@ -27,12 +27,17 @@
         'open-vcdiff/src/decodetable.h',
         'open-vcdiff/src/encodetable.cc',
         'open-vcdiff/src/encodetable.h',
+        'open-vcdiff/src/google/codetablewriter_interface.h',
+        'open-vcdiff/src/google/format_extension_flags.h',
+        'open-vcdiff/src/google/jsonwriter.h',
         'open-vcdiff/src/google/output_string.h',
         'open-vcdiff/src/google/vcdecoder.h',
+        'open-vcdiff/src/google/vcencoder.h',
         'open-vcdiff/src/headerparser.cc',
         'open-vcdiff/src/headerparser.h',
         'open-vcdiff/src/instruction_map.cc',
         'open-vcdiff/src/instruction_map.h',
+        'open-vcdiff/src/jsonwriter.cc',
         'open-vcdiff/src/rolling_hash.h',
         'open-vcdiff/src/testing.h',
         'open-vcdiff/src/varint_bigendian.cc',
@@ -41,6 +46,7 @@
         'open-vcdiff/src/vcdiff_defs.h',
         'open-vcdiff/src/vcdiffengine.cc',
         'open-vcdiff/src/vcdiffengine.h',
+        'open-vcdiff/src/vcencoder.cc',
         'open-vcdiff/vsprojects/config.h',
         'open-vcdiff/vsprojects/stdint.h',
       ],
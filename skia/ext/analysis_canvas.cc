@@ -16,6 +16,10 @@ namespace {
 
 const int kNoLayer = -1;
 
+// Glyphs above this size are drawn as paths by the GPU rasterizer, rather
+// than from its glyph cache.
+const SkScalar kMaxGpuRasterizationTextSize = SkIntToScalar(256);
+
 bool IsSolidColorPaint(const SkPaint& paint) {
   SkXfermode::Mode xfermode;
 
@@ -66,6 +70,19 @@ bool IsFullQuad(const SkDraw& draw,
          draw_bitmap_rect.contains(canvas_rect);
 }
 
+// The GPU rasterizer draws anti-aliased concave paths through software
+// masks, which is much slower than drawing them on the CPU.
+bool IsPathSuitableForGpuRasterization(const SkPath& path,
+                                       const SkPaint& paint) {
+  return !paint.isAntiAlias() || path.isConvex();
+}
+
+bool IsTextSuitableForGpuRasterization(const SkDraw& draw,
+                                       const SkPaint& paint) {
+  return draw.fMatrix->mapRadius(paint.getTextSize()) <=
+         kMaxGpuRasterizationTextSize;
+}
+
 } // namespace
 
 namespace skia {
@@ -76,7 +93,8 @@ AnalysisDevice::AnalysisDevice(const SkBitmap& bitmap)
       is_forced_not_transparent_(false),
       is_solid_color_(true),
       is_transparent_(true),
-      has_text_(false) {}
+      has_text_(false),
+      is_suitable_for_gpu_rasterization_(true) {}
 
 AnalysisDevice::~AnalysisDevice() {}
 
@@ -96,6 +114,10 @@ bool AnalysisDevice::HasText() const {
   return has_text_;
 }
 
+bool AnalysisDevice::IsSuitableForGpuRasterization() const {
+  return is_suitable_for_gpu_rasterization_;
+}
+
 void AnalysisDevice::SetForceNotSolid(bool flag) {
   is_forced_not_solid_ = flag;
   if (is_forced_not_solid_)
@@ -199,6 +221,8 @@ void AnalysisDevice::drawPath(const SkDraw& draw,
                               bool path_is_mutable) {
   is_solid_color_ = false;
   is_transparent_ = false;
+  is_suitable_for_gpu_rasterization_ &=
+      IsPathSuitableForGpuRasterization(path, paint);
 }
 
 void AnalysisDevice::drawBitmap(const SkDraw& draw,
@@ -239,6 +263,8 @@ void AnalysisDevice::drawText(const SkDraw& draw,
   is_solid_color_ = false;
   is_transparent_ = false;
   has_text_ = true;
+  is_suitable_for_gpu_rasterization_ &=
+      IsTextSuitableForGpuRasterization(draw, paint);
 }
 
 void AnalysisDevice::drawPosText(const SkDraw& draw,
@@ -251,6 +277,8 @@ void AnalysisDevice::drawPosText(const SkDraw& draw,
   is_solid_color_ = false;
   is_transparent_ = false;
   has_text_ = true;
+  is_suitable_for_gpu_rasterization_ &=
+      IsTextSuitableForGpuRasterization(draw, paint);
 }
 
 void AnalysisDevice::drawTextOnPath(const SkDraw& draw,
@@ -262,6 +290,8 @@ void AnalysisDevice::drawTextOnPath(const SkDraw& draw,
   is_solid_color_ = false;
   is_transparent_ = false;
   has_text_ = true;
+  is_suitable_for_gpu_rasterization_ &=
+      IsTextSuitableForGpuRasterization(draw, paint);
 }
 
 void AnalysisDevice::drawVertices(const SkDraw& draw,
@@ -303,6 +333,11 @@ bool AnalysisCanvas::HasText() const {
   return (static_cast<AnalysisDevice*>(getDevice()))->HasText();
 }
 
+bool AnalysisCanvas::IsSuitableForGpuRasterization() const {
+  return (static_cast<AnalysisDevice*>(getDevice()))
+      ->IsSuitableForGpuRasterization();
+}
+
 bool AnalysisCanvas::abortDrawing() {
   // Early out as soon as we have detected that the tile has text.
   return HasText();
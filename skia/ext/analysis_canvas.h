@@ -28,6 +28,11 @@ class SK_API AnalysisCanvas : public SkCanvas, public SkDrawPictureCallback {
   // Returns true when a SkColor can be used to represent result.
   bool GetColorIfSolid(SkColor* color) const;
   bool HasText() const;
+  // Returns false when some of the content is much slower to draw with the
+  // GPU rasterizer than on the CPU: anti-aliased concave paths, and very
+  // large text. Drawing stops as soon as there is text, so later content is
+  // not looked at.
+  bool IsSuitableForGpuRasterization() const;
 
   // SkDrawPictureCallback override.
   virtual bool abortDrawing() OVERRIDE;
@@ -68,6 +73,7 @@ class SK_API AnalysisDevice : public SkBitmapDevice {
 
   bool GetColorIfSolid(SkColor* color) const;
   bool HasText() const;
+  bool IsSuitableForGpuRasterization() const;
 
   void SetForceNotSolid(bool flag);
   void SetForceNotTransparent(bool flag);
@@ -154,6 +160,7 @@ class SK_API AnalysisDevice : public SkBitmapDevice {
   SkColor color_;
   bool is_transparent_;
   bool has_text_;
+  bool is_suitable_for_gpu_rasterization_;
 };
 
 }  // namespace skia
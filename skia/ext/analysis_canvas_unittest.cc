@@ -404,4 +404,49 @@ TEST(AnalysisCanvasTest, HasText) {
   }
 }
 
+TEST(AnalysisCanvasTest, IsSuitableForGpuRasterization) {
+  SkBitmap bitmap;
+  bitmap.setConfig(SkBitmap::kNo_Config, 200, 100);
+
+  // A concave path.
+  SkPath path;
+  path.moveTo(SkIntToScalar(0), SkIntToScalar(0));
+  path.lineTo(SkIntToScalar(50), SkIntToScalar(50));
+  path.lineTo(SkIntToScalar(100), SkIntToScalar(0));
+  path.lineTo(SkIntToScalar(50), SkIntToScalar(100));
+  path.close();
+
+  SkPaint paint;
+  paint.setColor(SK_ColorGRAY);
+
+  {
+    skia::AnalysisDevice device(bitmap);
+    skia::AnalysisCanvas canvas(&device);
+    EXPECT_TRUE(canvas.IsSuitableForGpuRasterization());
+    canvas.drawRect(SkRect::MakeWH(100, 100), paint);
+    canvas.drawPath(path, paint);
+    EXPECT_TRUE(canvas.IsSuitableForGpuRasterization());
+  }
+  {
+    skia::AnalysisDevice device(bitmap);
+    skia::AnalysisCanvas canvas(&device);
+    SkPaint anti_aliased_paint(paint);
+    anti_aliased_paint.setAntiAlias(true);
+    canvas.drawOval(SkRect::MakeWH(100, 100), anti_aliased_paint);
+    EXPECT_TRUE(canvas.IsSuitableForGpuRasterization());
+    canvas.drawPath(path, anti_aliased_paint);
+    EXPECT_FALSE(canvas.IsSuitableForGpuRasterization());
+  }
+  {
+    skia::AnalysisDevice device(bitmap);
+    skia::AnalysisCanvas canvas(&device);
+    paint.setTextSize(SkIntToScalar(16));
+    canvas.drawText("A", 1, SkIntToScalar(25), SkIntToScalar(25), paint);
+    EXPECT_TRUE(canvas.IsSuitableForGpuRasterization());
+    paint.setTextSize(SkIntToScalar(300));
+    canvas.drawText("A", 1, SkIntToScalar(25), SkIntToScalar(25), paint);
+    EXPECT_FALSE(canvas.IsSuitableForGpuRasterization());
+  }
+}
+
 }  // namespace skia
@@ -362,8 +362,11 @@ struct ConvolveProcs {
 
 void SetupSIMD(ConvolveProcs *procs) {
 #ifdef SIMD_SSE2
-  base::CPU cpu;
-  if (cpu.has_sse2()) {
+  // base::CPU runs several CPUID instructions and parses the brand string.
+  // Small resizes such as favicons would pay for that on every call, so the
+  // result is computed once.
+  static const bool has_sse2 = base::CPU().has_sse2();
+  if (has_sse2) {
     procs->extra_horizontal_reads = 3;
     procs->convolve_vertically = &ConvolveVertically_SSE2;
     procs->convolve_4rows_horizontally = &Convolve4RowsHorizontally_SSE2;
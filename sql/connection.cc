@@ -215,6 +215,7 @@ Connection::Connection()
       page_size_(0),
       cache_size_(0),
       exclusive_locking_(false),
+      wal_mode_(false),
       restrict_to_user_(false),
       transaction_nesting_(0),
       needs_rollback_(false),
@@ -376,6 +377,19 @@ void Connection::TrimMemory(bool aggressively) {
     DLOG(WARNING) << "Could not restore cache size: " << GetErrorMessage();
 }
 
+bool Connection::Checkpoint() {
+  if (!db_)
+    return false;
+
+  // Passing NULL checkpoints all of the attached databases.
+  int rc = sqlite3_wal_checkpoint(db_, NULL);
+  if (rc != SQLITE_OK) {
+    DLOG(WARNING) << "Could not checkpoint database " << GetErrorMessage();
+    return false;
+  }
+  return true;
+}
+
 // Create an in-memory database with the existing database's page
 // size, then backup that database over the existing database.
 bool Connection::Raze() {
@@ -552,13 +566,16 @@ bool Connection::Delete(const base::FilePath& path) {
 
   base::FilePath journal_path(path.value() + FILE_PATH_LITERAL("-journal"));
   base::FilePath wal_path(path.value() + FILE_PATH_LITERAL("-wal"));
+  base::FilePath shm_path(path.value() + FILE_PATH_LITERAL("-shm"));
 
   base::DeleteFile(journal_path, false);
   base::DeleteFile(wal_path, false);
+  base::DeleteFile(shm_path, false);
   base::DeleteFile(path, false);
 
   return !base::PathExists(journal_path) &&
       !base::PathExists(wal_path) &&
+      !base::PathExists(shm_path) &&
       !base::PathExists(path);
 }
 
@@ -969,17 +986,6 @@ bool Connection::OpenInternal(const std::string& file_name,
     ignore_result(Execute("PRAGMA locking_mode=EXCLUSIVE"));
   }
 
-  // http://www.sqlite.org/pragma.html#pragma_journal_mode
-  // DELETE (default) - delete -journal file to commit.
-  // TRUNCATE - truncate -journal file to commit.
-  // PERSIST - zero out header of -journal file to commit.
-  // journal_size_limit provides size to trim to in PERSIST.
-  // TODO(shess): Figure out if PERSIST and journal_size_limit really
-  // matter.  In theory, it keeps pages pre-allocated, so if
-  // transactions usually fit, it should be faster.
-  ignore_result(Execute("PRAGMA journal_mode = PERSIST"));
-  ignore_result(Execute("PRAGMA journal_size_limit = 16384"));
-
   const base::TimeDelta kBusyTimeout =
     base::TimeDelta::FromSeconds(kBusyTimeoutSeconds);
 
@@ -1000,6 +1006,26 @@ bool Connection::OpenInternal(const std::string& file_name,
     ignore_result(ExecuteWithTimeout(sql.c_str(), kBusyTimeout));
   }
 
+  // http://www.sqlite.org/pragma.html#pragma_journal_mode
+  // DELETE (default) - delete -journal file to commit.
+  // TRUNCATE - truncate -journal file to commit.
+  // PERSIST - zero out header of -journal file to commit.
+  // WAL - append to -wal file to commit.
+  // journal_size_limit provides size to trim to in PERSIST, and to truncate
+  // the -wal file to after a checkpoint in WAL.
+  // TODO(shess): Figure out if PERSIST and journal_size_limit really
+  // matter.  In theory, it keeps pages pre-allocated, so if
+  // transactions usually fit, it should be faster.
+  //
+  // Switching to WAL writes the database header of a new database, so this
+  // must come after setting |page_size_|.
+  if (wal_mode_) {
+    ignore_result(Execute("PRAGMA journal_mode = WAL"));
+  } else {
+    ignore_result(Execute("PRAGMA journal_mode = PERSIST"));
+  }
+  ignore_result(Execute("PRAGMA journal_size_limit = 16384"));
+
   if (!ExecuteWithTimeout("PRAGMA secure_delete=ON", kBusyTimeout)) {
     bool was_poisoned = poisoned_;
     Close();
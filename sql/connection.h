@@ -117,6 +117,16 @@ class SQL_EXPORT Connection {
   // This must be called before Open() to have an effect.
   void set_exclusive_locking() { exclusive_locking_ = true; }
 
+  // Call to open the database in write-ahead log mode, so that commits
+  // append to the -wal file instead of rewriting pages through a rollback
+  // journal.  This needs fewer syncs per transaction and lets readers proceed
+  // while a write is in progress.  The log is moved back into the database
+  // file when it grows past 1000 pages, or when Checkpoint() is called.
+  // Opening the database without this switches it back to a rollback journal.
+  //
+  // This must be called before Open() to have an effect.
+  void set_wal_mode() { wal_mode_ = true; }
+
   // Call to cause Open() to restrict access permissions of the
   // database file to only the owner.
   // TODO(shess): Currently only supported on OS_POSIX, is a noop on
@@ -206,6 +216,11 @@ class SQL_EXPORT Connection {
   // usage by half.
   void TrimMemory(bool aggressively);
 
+  // Copy the pages of the write-ahead log back into the database file, so
+  // that the log can be reset.  Useful at idle times for databases which use
+  // set_wal_mode(), and a no-op for the others.  Returns true on success.
+  bool Checkpoint();
+
   // Raze the database to the ground.  This approximates creating a
   // fresh database from scratch, within the constraints of SQLite's
   // locking protocol (locks and open handles can make doing this with
@@ -556,6 +571,7 @@ class SQL_EXPORT Connection {
   int page_size_;
   int cache_size_;
   bool exclusive_locking_;
+  bool wal_mode_;
   bool restrict_to_user_;
 
   // All cached statements. Keeping a reference to these statements means that
@@ -663,6 +663,41 @@ TEST_F(SQLConnectionTest, Delete) {
   EXPECT_FALSE(base::PathExists(journal));
 }
 
+TEST_F(SQLConnectionTest, WalMode) {
+  base::FilePath wal_db_path =
+      db_path().DirName().AppendASCII("SQLConnectionTestWal.db");
+  sql::Connection wal_db;
+  wal_db.set_wal_mode();
+  ASSERT_TRUE(wal_db.Open(wal_db_path));
+
+  {
+    sql::Statement s(wal_db.GetUniqueStatement("PRAGMA journal_mode"));
+    ASSERT_TRUE(s.Step());
+    EXPECT_EQ("wal", s.ColumnString(0));
+  }
+
+  // Committed data lives in the log until a checkpoint.
+  ASSERT_TRUE(wal_db.Execute("CREATE TABLE x (x)"));
+  ASSERT_TRUE(wal_db.Execute("INSERT INTO x VALUES (1)"));
+  base::FilePath wal(wal_db_path.value() + FILE_PATH_LITERAL("-wal"));
+  ASSERT_TRUE(base::PathExists(wal));
+  EXPECT_TRUE(wal_db.Checkpoint());
+
+  // The database stays in WAL mode when reopened.
+  wal_db.Close();
+  ASSERT_TRUE(wal_db.Open(wal_db_path));
+  {
+    sql::Statement s(wal_db.GetUniqueStatement("SELECT x FROM x"));
+    ASSERT_TRUE(s.Step());
+    EXPECT_EQ(1, s.ColumnInt(0));
+  }
+
+  wal_db.Close();
+  EXPECT_TRUE(sql::Connection::Delete(wal_db_path));
+  EXPECT_FALSE(base::PathExists(wal_db_path));
+  EXPECT_FALSE(base::PathExists(wal));
+}
+
 #if defined(OS_POSIX)
 // Test that set_restrict_to_user() trims database permissions so that
 // only the owner (and root) can read.
@@ -33,6 +33,8 @@
         'statement.h',
         'transaction.cc',
         'transaction.h',
+        'write_behind_batch.cc',
+        'write_behind_batch.h',
       ],
       'include_dirs': [
         '..',
@@ -92,6 +94,7 @@
         'sqlite_features_unittest.cc',
         'statement_unittest.cc',
         'transaction_unittest.cc',
+        'write_behind_batch_unittest.cc',
       ],
       'include_dirs': [
         '..',
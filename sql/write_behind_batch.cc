@@ -0,0 +1,101 @@
+// Copyright 2014 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "sql/write_behind_batch.h"
+
+#include "base/bind.h"
+#include "base/location.h"
+#include "base/logging.h"
+#include "base/sequenced_task_runner.h"
+#include "sql/connection.h"
+#include "sql/transaction.h"
+
+namespace sql {
+
+WriteBehindBatch::WriteBehindBatch(
+    Connection* db,
+    const scoped_refptr<base::SequencedTaskRunner>& task_runner,
+    base::TimeDelta max_delay,
+    size_t max_pending)
+    : db_(db),
+      task_runner_(task_runner),
+      max_delay_(max_delay),
+      max_pending_(max_pending),
+      commit_scheduled_(false),
+      weak_factory_(this) {
+  DCHECK(db_);
+  DCHECK_GT(max_pending_, 0u);
+}
+
+WriteBehindBatch::~WriteBehindBatch() {
+  DCHECK(task_runner_->RunsTasksOnCurrentThread());
+  ignore_result(Commit());
+}
+
+void WriteBehindBatch::Write(const std::string& key,
+                             const WriteCallback& write) {
+  DCHECK(task_runner_->RunsTasksOnCurrentThread());
+  DCHECK(!write.is_null());
+
+  pending_.push_back(std::make_pair(key, write));
+  if (!key.empty()) {
+    WriteList::iterator last = pending_.end();
+    --last;
+    std::pair<WriteMap::iterator, bool> inserted =
+        pending_by_key_.insert(std::make_pair(key, last));
+    if (!inserted.second) {
+      pending_.erase(inserted.first->second);
+      inserted.first->second = last;
+    }
+  }
+
+  if (pending_.size() >= max_pending_) {
+    ignore_result(Commit());
+    return;
+  }
+
+  if (!commit_scheduled_) {
+    commit_scheduled_ = true;
+    task_runner_->PostDelayedTask(
+        FROM_HERE,
+        base::Bind(&WriteBehindBatch::OnCommitTimer,
+                   weak_factory_.GetWeakPtr()),
+        max_delay_);
+  }
+}
+
+bool WriteBehindBatch::Commit() {
+  DCHECK(task_runner_->RunsTasksOnCurrentThread());
+
+  if (pending_.empty())
+    return true;
+
+  WriteList writes;
+  writes.swap(pending_);
+  pending_by_key_.clear();
+
+  if (!db_->is_open())
+    return false;
+
+  Transaction transaction(db_);
+  if (!transaction.Begin())
+    return false;
+
+  for (WriteList::const_iterator it = writes.begin(); it != writes.end();
+       ++it) {
+    if (!it->second.Run(db_)) {
+      DLOG(ERROR) << "Write failed, rolling back " << writes.size()
+                  << " writes";
+      return false;
+    }
+  }
+  return transaction.Commit();
+}
+
+void WriteBehindBatch::OnCommitTimer() {
+  commit_scheduled_ = false;
+  ignore_result(Commit());
+}
+
+}  // namespace sql
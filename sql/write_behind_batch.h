@@ -0,0 +1,91 @@
+// Copyright 2014 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef SQL_WRITE_BEHIND_BATCH_H_
+#define SQL_WRITE_BEHIND_BATCH_H_
+
+#include <list>
+#include <map>
+#include <string>
+#include <utility>
+
+#include "base/basictypes.h"
+#include "base/callback.h"
+#include "base/memory/ref_counted.h"
+#include "base/memory/weak_ptr.h"
+#include "base/time/time.h"
+#include "sql/sql_export.h"
+
+namespace base {
+class SequencedTaskRunner;
+}
+
+namespace sql {
+
+class Connection;
+
+// Accumulates writes to a database and commits them together in a single
+// transaction, instead of running a transaction for each of them.  Writes
+// queued for the same key replace each other, so a row that is updated
+// many times between commits is only written once.
+//
+// The pending writes are committed |max_delay| after the first of them was
+// queued, as soon as |max_pending| of them are queued, or when Commit() is
+// called.  They are also committed on destruction, so the owner should
+// destroy the batch before closing |db|.
+//
+// All the methods must be called on |task_runner|, which is the one the
+// database is used on.
+class SQL_EXPORT WriteBehindBatch {
+ public:
+  // Runs the statements of a single write.  Returns false on failure, which
+  // rolls back the whole batch.
+  typedef base::Callback<bool(Connection*)> WriteCallback;
+
+  WriteBehindBatch(Connection* db,
+                   const scoped_refptr<base::SequencedTaskRunner>& task_runner,
+                   base::TimeDelta max_delay,
+                   size_t max_pending);
+  ~WriteBehindBatch();
+
+  // Queues |write|.  If a write was already queued for |key| it is dropped,
+  // and |write| is queued after the writes for the other keys.  Writes with
+  // an empty |key| never replace each other.
+  void Write(const std::string& key, const WriteCallback& write);
+
+  // Runs the pending writes in a single transaction.  Returns false if the
+  // transaction couldn't be committed, in which case the writes are lost.
+  bool Commit();
+
+  size_t pending_count() const { return pending_.size(); }
+
+ private:
+  typedef std::list<std::pair<std::string, WriteCallback> > WriteList;
+  typedef std::map<std::string, WriteList::iterator> WriteMap;
+
+  // Runs Commit() once |max_delay_| has elapsed.
+  void OnCommitTimer();
+
+  Connection* db_;
+  scoped_refptr<base::SequencedTaskRunner> task_runner_;
+  const base::TimeDelta max_delay_;
+  const size_t max_pending_;
+
+  // The pending writes, in the order they are to be run.
+  WriteList pending_;
+
+  // The pending writes with a non-empty key, by key.
+  WriteMap pending_by_key_;
+
+  // True while a delayed commit is posted.
+  bool commit_scheduled_;
+
+  base::WeakPtrFactory<WriteBehindBatch> weak_factory_;
+
+  DISALLOW_COPY_AND_ASSIGN(WriteBehindBatch);
+};
+
+}  // namespace sql
+
+#endif  // SQL_WRITE_BEHIND_BATCH_H_
@@ -0,0 +1,148 @@
+// Copyright 2014 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "base/bind.h"
+#include "base/files/scoped_temp_dir.h"
+#include "base/test/test_simple_task_runner.h"
+#include "sql/connection.h"
+#include "sql/statement.h"
+#include "sql/write_behind_batch.h"
+#include "testing/gtest/include/gtest/gtest.h"
+
+namespace {
+
+const size_t kMaxPending = 4;
+
+// Sets the value of |key| in table "foo" to |value|.
+bool SetValue(const std::string& key, int value, sql::Connection* db) {
+  sql::Statement s(db->GetUniqueStatement(
+      "INSERT OR REPLACE INTO foo (key, value) VALUES (?, ?)"));
+  s.BindString(0, key);
+  s.BindInt(1, value);
+  return s.Run();
+}
+
+bool FailWrite(sql::Connection* db) {
+  return false;
+}
+
+class SQLWriteBehindBatchTest : public testing::Test {
+ public:
+  virtual void SetUp() {
+    ASSERT_TRUE(temp_dir_.CreateUniqueTempDir());
+    ASSERT_TRUE(db_.Open(
+        temp_dir_.path().AppendASCII("SQLWriteBehindBatchTest.db")));
+    ASSERT_TRUE(db_.Execute(
+        "CREATE TABLE foo (key TEXT PRIMARY KEY, value INTEGER)"));
+
+    task_runner_ = new base::TestSimpleTaskRunner();
+    batch_.reset(new sql::WriteBehindBatch(
+        &db_, task_runner_, base::TimeDelta::FromSeconds(10), kMaxPending));
+  }
+
+  virtual void TearDown() {
+    batch_.reset();
+    db_.Close();
+  }
+
+  void Write(const std::string& key, int value) {
+    batch_->Write(key, base::Bind(&SetValue, key, value));
+  }
+
+  // Returns the number of rows in table "foo".
+  int CountFoo() {
+    sql::Statement s(db_.GetUniqueStatement("SELECT count(*) FROM foo"));
+    s.Step();
+    return s.ColumnInt(0);
+  }
+
+  // Returns the value of |key|, or -1 if it isn't in table "foo".
+  int GetValue(const std::string& key) {
+    sql::Statement s(db_.GetUniqueStatement(
+        "SELECT value FROM foo WHERE key = ?"));
+    s.BindString(0, key);
+    return s.Step() ? s.ColumnInt(0) : -1;
+  }
+
+ protected:
+  base::ScopedTempDir temp_dir_;
+  sql::Connection db_;
+  scoped_refptr<base::TestSimpleTaskRunner> task_runner_;
+  scoped_ptr<sql::WriteBehindBatch> batch_;
+};
+
+TEST_F(SQLWriteBehindBatchTest, CommitsAfterDelay) {
+  Write("a", 1);
+  Write("b", 2);
+  EXPECT_EQ(2u, batch_->pending_count());
+  EXPECT_EQ(0, CountFoo());
+
+  // A single delayed commit is posted for the batch.
+  ASSERT_EQ(1u, task_runner_->GetPendingTasks().size());
+  EXPECT_EQ(base::TimeDelta::FromSeconds(10),
+            task_runner_->GetPendingTasks()[0].delay);
+
+  task_runner_->RunPendingTasks();
+  EXPECT_EQ(0u, batch_->pending_count());
+  EXPECT_EQ(1, GetValue("a"));
+  EXPECT_EQ(2, GetValue("b"));
+
+  // The next write posts a new commit.
+  Write("a", 3);
+  EXPECT_TRUE(task_runner_->HasPendingTask());
+  task_runner_->RunPendingTasks();
+  EXPECT_EQ(3, GetValue("a"));
+}
+
+TEST_F(SQLWriteBehindBatchTest, CollapsesWritesToSameKey) {
+  Write("a", 1);
+  Write("b", 2);
+  Write("a", 3);
+  Write("a", 4);
+  EXPECT_EQ(2u, batch_->pending_count());
+
+  EXPECT_TRUE(batch_->Commit());
+  EXPECT_EQ(2, CountFoo());
+  EXPECT_EQ(4, GetValue("a"));
+  EXPECT_EQ(2, GetValue("b"));
+}
+
+TEST_F(SQLWriteBehindBatchTest, EmptyKeyDoesNotCollapse) {
+  batch_->Write(std::string(), base::Bind(&SetValue, "a", 1));
+  batch_->Write(std::string(), base::Bind(&SetValue, "a", 2));
+  EXPECT_EQ(2u, batch_->pending_count());
+
+  // The writes run in order.
+  EXPECT_TRUE(batch_->Commit());
+  EXPECT_EQ(2, GetValue("a"));
+}
+
+TEST_F(SQLWriteBehindBatchTest, CommitsWhenFull) {
+  for (size_t i = 0; i < kMaxPending - 1; ++i)
+    Write(std::string(1, 'a' + i), i);
+  EXPECT_EQ(0, CountFoo());
+
+  Write("z", 0);
+  EXPECT_EQ(0u, batch_->pending_count());
+  EXPECT_EQ(static_cast<int>(kMaxPending), CountFoo());
+}
+
+TEST_F(SQLWriteBehindBatchTest, FailedWriteRollsBack) {
+  Write("a", 1);
+  batch_->Write("b", base::Bind(&FailWrite));
+  EXPECT_FALSE(batch_->Commit());
+  EXPECT_EQ(0u, batch_->pending_count());
+  EXPECT_EQ(0, CountFoo());
+}
+
+TEST_F(SQLWriteBehindBatchTest, CommitsOnDestruction) {
+  Write("a", 1);
+  batch_.reset();
+  EXPECT_EQ(1, GetValue("a"));
+
+  // The posted commit doesn't run once the batch is gone.
+  task_runner_->RunPendingTasks();
+}
+
+}  // namespace
@@ -60,13 +60,14 @@ void BindFields(const EntryKernel& entry,
   for ( ; i < STRING_FIELDS_END; ++i) {
     statement->BindString(index++, entry.ref(static_cast<StringField>(i)));
   }
+  // The blobs are copied when they are bound, so a single buffer is reused
+  // to serialize all of them.
+  std::string temp;
   for ( ; i < PROTO_FIELDS_END; ++i) {
-    std::string temp;
     entry.ref(static_cast<ProtoField>(i)).SerializeToString(&temp);
     statement->BindBlob(index++, temp.data(), temp.length());
   }
   for ( ; i < UNIQUE_POSITION_FIELDS_END; ++i) {
-    std::string temp;
     entry.ref(static_cast<UniquePositionField>(i)).SerializeToString(&temp);
     statement->BindBlob(index++, temp.data(), temp.length());
   }
@@ -102,11 +103,9 @@ scoped_ptr<EntryKernel> UnpackEntry(sql::Statement* statement) {
         statement->ColumnBlob(i), statement->ColumnByteLength(i));
   }
   for ( ; i < UNIQUE_POSITION_FIELDS_END; ++i) {
-    std::string temp;
-    statement->ColumnBlobAsString(i, &temp);
-
     sync_pb::UniquePosition proto;
-    if (!proto.ParseFromString(temp)) {
+    if (!proto.ParseFromArray(statement->ColumnBlob(i),
+                              statement->ColumnByteLength(i))) {
       DVLOG(1) << "Unpacked invalid position.  Assuming the DB is corrupt";
       return scoped_ptr<EntryKernel>();
     }
@@ -4,6 +4,7 @@
 
 #include "testing/perf/perf_test.h"
 
+#include <math.h>
 #include <stdio.h>
 
 #include "base/logging.h"
@@ -172,6 +173,33 @@ void AppendResultList(std::string& output,
                             "[", "]", units, important);
 }
 
+void PrintResultSamples(const std::string& measurement,
+                        const std::string& modifier,
+                        const std::string& trace,
+                        const std::vector<double>& samples,
+                        const std::string& units,
+                        bool important) {
+  DCHECK(!samples.empty());
+  double sum = 0;
+  for (size_t i = 0; i < samples.size(); ++i)
+    sum += samples[i];
+  double mean = sum / samples.size();
+
+  double sum_of_squares = 0;
+  for (size_t i = 0; i < samples.size(); ++i)
+    sum_of_squares += (samples[i] - mean) * (samples[i] - mean);
+  double std_dev = samples.size() > 1 ?
+      sqrt(sum_of_squares / (samples.size() - 1)) : 0;
+
+  PrintResultMeanAndError(measurement,
+                          modifier,
+                          trace,
+                          base::DoubleToString(mean) + "," +
+                              base::DoubleToString(std_dev),
+                          units,
+                          important);
+}
+
 void PrintSystemCommitCharge(const std::string& test_name,
                              size_t charge,
                              bool important) {
@@ -6,6 +6,7 @@
 #define TESTING_PERF_PERF_TEST_H_
 
 #include <string>
+#include <vector>
 
 namespace perf_test {
 
@@ -97,6 +98,16 @@ void AppendResultList(std::string& output,
                       const std::string& units,
                       bool important);
 
+// Like PrintResultMeanAndError(), but computes the mean and the sample
+// standard deviation of |samples|, e.g. the times taken by each of several
+// repetitions of a benchmark. |samples| must not be empty.
+void PrintResultSamples(const std::string& measurement,
+                        const std::string& modifier,
+                        const std::string& trace,
+                        const std::vector<double>& samples,
+                        const std::string& units,
+                        bool important);
+
 // Prints memory commit charge stats for use by perf graphs.
 void PrintSystemCommitCharge(const std::string& test_name,
                              size_t charge,
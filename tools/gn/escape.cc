@@ -8,6 +8,32 @@
 
 namespace {
 
+// Returns true if EscapeStringToString() might change |str| for |options|.
+// Most strings, e.g. paths without spaces, need no escaping and can be
+// copied as-is.
+bool MayNeedEscaping(const base::StringPiece& str,
+                     const EscapeOptions& options) {
+  for (size_t i = 0; i < str.size(); i++) {
+    switch (str[i]) {
+      case '$':
+      case '"':
+      case ' ':
+      case '\'':
+      case '\\':
+        return true;
+#if defined(OS_WIN)
+      case '/':
+        if (options.convert_slashes)
+          return true;
+        break;
+#endif
+      default:
+        break;
+    }
+  }
+  return false;
+}
+
 template<typename DestString>
 void EscapeStringToString(const base::StringPiece& str,
                           const EscapeOptions& options,
@@ -72,6 +98,9 @@ void EscapeStringToString(const base::StringPiece& str,
 std::string EscapeString(const base::StringPiece& str,
                          const EscapeOptions& options,
                          bool* needed_quoting) {
+  if (!MayNeedEscaping(str, options))
+    return str.as_string();
+
   std::string result;
   result.reserve(str.size() + 4);  // Guess we'll add a couple of extra chars.
   EscapeStringToString(str, options, &result, needed_quoting);
@@ -81,6 +110,11 @@ std::string EscapeString(const base::StringPiece& str,
 void EscapeStringToStream(std::ostream& out,
                           const base::StringPiece& str,
                           const EscapeOptions& options) {
+  if (!MayNeedEscaping(str, options)) {
+    out.write(str.data(), str.size());
+    return;
+  }
+
   // Escape to a stack buffer and then write out to the stream.
   base::StackVector<char, 256> result;
   result->reserve(str.size() + 4);  // Guess we'll add a couple of extra chars.
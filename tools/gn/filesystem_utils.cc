@@ -667,6 +667,21 @@ SourceDir SourceDirForCurrentDirectory(const base::FilePath& source_root) {
   return SourceDirForPath(source_root, cd);
 }
 
+bool WriteFileIfChanged(const base::FilePath& file_path,
+                        const std::string& data) {
+  // Only read the existing file when its size matches.
+  int64 existing_size;
+  if (base::GetFileSize(file_path, &existing_size) &&
+      existing_size == static_cast<int64>(data.size())) {
+    std::string existing;
+    if (base::ReadFileToString(file_path, &existing) && existing == data)
+      return true;
+  }
+
+  int size = static_cast<int>(data.size());
+  return file_util::WriteFile(file_path, data.c_str(), size) == size;
+}
+
 SourceDir GetToolchainOutputDir(const Settings* settings) {
   const OutputFile& toolchain_subdir = settings->toolchain_output_subdir();
 
@@ -156,6 +156,12 @@ SourceDir SourceDirForPath(const base::FilePath& source_root,
 // directory.
 SourceDir SourceDirForCurrentDirectory(const base::FilePath& source_root);
 
+// Writes |data| to the given file unless it already has exactly this content,
+// so that regenerating a file that didn't change leaves its timestamp alone.
+// Returns true on success (including when nothing needed to be written).
+bool WriteFileIfChanged(const base::FilePath& file_path,
+                        const std::string& data);
+
 // -----------------------------------------------------------------------------
 
 // These functions return the various flavors of output and gen directories.
@@ -2,8 +2,11 @@
 // Use of this source code is governed by a BSD-style license that can be
 // found in the LICENSE file.
 
+#include "base/file_util.h"
+#include "base/files/scoped_temp_dir.h"
 #include "base/strings/string_util.h"
 #include "base/strings/utf_string_conversions.h"
+#include "base/time/time.h"
 #include "build/build_config.h"
 #include "testing/gtest/include/gtest/gtest.h"
 #include "tools/gn/filesystem_utils.h"
@@ -376,3 +379,31 @@ TEST(FilesystemUtils, GetDirForEmptyBuildDir) {
   EXPECT_EQ("//gen/",
             GetGenDirForSourceDir(&settings, SourceDir("//")).value());
 }
+
+TEST(FilesystemUtils, WriteFileIfChanged) {
+  base::ScopedTempDir temp_dir;
+  ASSERT_TRUE(temp_dir.CreateUniqueTempDir());
+  base::FilePath file_path = temp_dir.path().AppendASCII("foo.ninja");
+
+  EXPECT_TRUE(WriteFileIfChanged(file_path, "hello"));
+  std::string contents;
+  EXPECT_TRUE(base::ReadFileToString(file_path, &contents));
+  EXPECT_EQ("hello", contents);
+
+  // Writing the same contents leaves the file alone.
+  base::Time old_time = base::Time::Now() - base::TimeDelta::FromDays(1);
+  ASSERT_TRUE(base::TouchFile(file_path, old_time, old_time));
+  base::File::Info info;
+  ASSERT_TRUE(base::GetFileInfo(file_path, &info));
+  base::Time written_time = info.last_modified;
+  EXPECT_TRUE(WriteFileIfChanged(file_path, "hello"));
+  ASSERT_TRUE(base::GetFileInfo(file_path, &info));
+  EXPECT_EQ(written_time, info.last_modified);
+
+  // Different contents of the same size are written.
+  EXPECT_TRUE(WriteFileIfChanged(file_path, "world"));
+  EXPECT_TRUE(base::ReadFileToString(file_path, &contents));
+  EXPECT_EQ("world", contents);
+  ASSERT_TRUE(base::GetFileInfo(file_path, &info));
+  EXPECT_NE(written_time, info.last_modified);
+}
@@ -10,6 +10,7 @@
 #include "base/file_util.h"
 #include "tools/gn/err.h"
 #include "tools/gn/file_template.h"
+#include "tools/gn/filesystem_utils.h"
 #include "tools/gn/ninja_binary_target_writer.h"
 #include "tools/gn/ninja_copy_target_writer.h"
 #include "tools/gn/ninja_group_target_writer.h"
@@ -77,9 +78,7 @@ void NinjaTargetWriter::RunAndWriteFile(const Target* target,
     CHECK(0);
   }
 
-  std::string contents = file.str();
-  file_util::WriteFile(ninja_file, contents.c_str(),
-                       static_cast<int>(contents.size()));
+  WriteFileIfChanged(ninja_file, file.str());
 }
 
 std::string NinjaTargetWriter::GetSourcesImplicitDeps() const {
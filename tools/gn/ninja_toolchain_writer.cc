@@ -4,11 +4,12 @@
 
 #include "tools/gn/ninja_toolchain_writer.h"
 
-#include <fstream>
+#include <sstream>
 
 #include "base/file_util.h"
 #include "base/strings/stringize_macros.h"
 #include "tools/gn/build_settings.h"
+#include "tools/gn/filesystem_utils.h"
 #include "tools/gn/settings.h"
 #include "tools/gn/target.h"
 #include "tools/gn/toolchain.h"
@@ -49,15 +50,10 @@ bool NinjaToolchainWriter::RunAndWriteFile(
 
   base::CreateDirectory(ninja_file.DirName());
 
-  std::ofstream file;
-  file.open(FilePathToUTF8(ninja_file).c_str(),
-            std::ios_base::out | std::ios_base::binary);
-  if (file.fail())
-    return false;
-
+  std::stringstream file;
   NinjaToolchainWriter gen(settings, toolchain, targets, file);
   gen.Run();
-  return true;
+  return WriteFileIfChanged(ninja_file, file.str());
 }
 
 void NinjaToolchainWriter::WriteRules() {
@@ -34,10 +34,13 @@ class TraceLog {
   }
 
   // Returns a copy for threadsafety.
-  std::vector<TraceItem*> events() const { return events_; }
+  std::vector<TraceItem*> events() const {
+    base::AutoLock lock(lock_);
+    return events_;
+  }
 
  private:
-  base::Lock lock_;
+  mutable base::Lock lock_;
 
   std::vector<TraceItem*> events_;
 
@@ -54,6 +57,29 @@ struct Coalesced {
   int count;
 };
 
+const char* TypeName(TraceItem::Type type) {
+  switch (type) {
+    case TraceItem::TRACE_FILE_LOAD:
+      return "load";
+    case TraceItem::TRACE_FILE_PARSE:
+      return "parse";
+    case TraceItem::TRACE_FILE_EXECUTE:
+      return "file_exec";
+    case TraceItem::TRACE_FILE_WRITE:
+      return "file_write";
+    case TraceItem::TRACE_SCRIPT_EXECUTE:
+      return "script_exec";
+    case TraceItem::TRACE_DEFINE_TARGET:
+      return "define";
+  }
+  NOTREACHED();
+  return "";
+}
+
+bool BeginLess(const TraceItem* a, const TraceItem* b) {
+  return a->begin() < b->begin();
+}
+
 bool DurationGreater(const TraceItem* a, const TraceItem* b) {
   return a->delta() > b->delta();
 }
@@ -62,6 +88,67 @@ bool CoalescedDurationGreater(const Coalesced& a, const Coalesced& b) {
   return a.total_duration > b.total_duration;
 }
 
+// Prints the total time spent in each phase, and how well the work was spread
+// over the threads. The thread that was busy the longest bounds how fast the
+// whole run could have been with this amount of parallelism.
+void SummarizePhases(const std::vector<TraceItem*>& events,
+                     std::ostream& out) {
+  if (events.empty())
+    return;
+
+  std::map<TraceItem::Type, Coalesced> phases;
+  std::map<base::PlatformThreadId, std::vector<const TraceItem*> > threads;
+  base::TimeTicks begin = events[0]->begin();
+  base::TimeTicks end = events[0]->end();
+  for (size_t i = 0; i < events.size(); i++) {
+    Coalesced& c = phases[events[i]->type()];
+    c.total_duration += events[i]->delta().InMillisecondsF();
+    c.count++;
+    threads[events[i]->thread_id()].push_back(events[i]);
+    begin = std::min(begin, events[i]->begin());
+    end = std::max(end, events[i]->end());
+  }
+
+  out << "Phase times: (total time in ms, # items, phase)\n";
+  for (std::map<TraceItem::Type, Coalesced>::iterator iter = phases.begin();
+       iter != phases.end(); ++iter) {
+    out << base::StringPrintf(" %8.2f  %d  %s\n",
+                              iter->second.total_duration, iter->second.count,
+                              TypeName(iter->first));
+  }
+
+  // Items nest (a file execution can load an import), so a thread is busy
+  // over the union of its items.
+  base::TimeDelta total_busy;
+  base::TimeDelta max_busy;
+  for (std::map<base::PlatformThreadId,
+                std::vector<const TraceItem*> >::iterator iter =
+           threads.begin();
+       iter != threads.end(); ++iter) {
+    std::vector<const TraceItem*>& items = iter->second;
+    std::sort(items.begin(), items.end(), &BeginLess);
+    base::TimeDelta busy;
+    base::TimeTicks busy_until = items[0]->begin();
+    for (size_t i = 0; i < items.size(); i++) {
+      base::TimeTicks item_begin = std::max(busy_until, items[i]->begin());
+      if (items[i]->end() > item_begin) {
+        busy += items[i]->end() - item_begin;
+        busy_until = items[i]->end();
+      }
+    }
+    total_busy += busy;
+    max_busy = std::max(max_busy, busy);
+  }
+
+  double wall_ms = (end - begin).InMillisecondsF();
+  out << base::StringPrintf(
+      "Traced wall time: %.2f ms, %d threads, %.2fx parallelism, busiest "
+      "thread %.2f ms\n",
+      wall_ms, static_cast<int>(threads.size()),
+      wall_ms > 0 ? total_busy.InMillisecondsF() / wall_ms : 0.0,
+      max_busy.InMillisecondsF());
+}
+
 void SummarizeParses(std::vector<const TraceItem*>& loads,
                      std::ostream& out) {
   out << "File parse times: (time in ms, name)\n";
@@ -206,6 +293,8 @@ std::string SummarizeTraces() {
   }
 
   std::ostringstream out;
+  SummarizePhases(events, out);
+  out << std::endl;
   SummarizeParses(parses, out);
   out << std::endl;
   SummarizeFileExecs(file_execs, out);
@@ -244,26 +333,7 @@ void SaveTraces(const base::FilePath& file_name) {
     base::EscapeJSONString(item.name(), true, &quote_buffer);
     out << ",\"name\":" << quote_buffer;
 
-    out << ",\"cat\":";
-    switch (item.type()) {
-      case TraceItem::TRACE_FILE_LOAD:
-        out << "\"load\"";
-        break;
-      case TraceItem::TRACE_FILE_PARSE:
-        out << "\"parse\"";
-        break;
-      case TraceItem::TRACE_FILE_EXECUTE:
-        out << "\"file_exec\"";
-        break;
-      case TraceItem::TRACE_FILE_WRITE:
-        out << "\"file_write\"";
-        break;
-      case TraceItem::TRACE_SCRIPT_EXECUTE:
-        out << "\"script_exec\"";
-        break;
-      case TraceItem::TRACE_DEFINE_TARGET:
-        out << "\"define\"";
-    }
+    out << ",\"cat\":\"" << TypeName(item.type()) << "\"";
 
     if (!item.toolchain().empty() || !item.cmdline().empty()) {
       out << ",\"args\":{";
@@ -4,9 +4,13 @@
 
 #include "ui/gfx/canvas.h"
 
+#include "base/containers/mru_cache.h"
 #include "base/i18n/rtl.h"
+#include "base/lazy_instance.h"
 #include "base/logging.h"
 #include "base/memory/scoped_ptr.h"
+#include "base/strings/stringprintf.h"
+#include "base/synchronization/lock.h"
 #include "ui/gfx/font_list.h"
 #include "ui/gfx/insets.h"
 #include "ui/gfx/range/range.h"
@@ -114,6 +118,36 @@ void ElideTextAndAdjustRange(const FontList& font_list,
   }
 }
 
+// The number of single-line string sizes kept by Canvas::SizeStringFloat.
+const size_t kMaxCachedStringSizes = 256;
+
+// Caches the sizes of single-line strings, so that labels and tab titles that
+// are measured again and again don't have to be shaped every time.  Measuring
+// can happen on any thread, so the cache is guarded by a lock.
+struct StringSizeCache {
+  StringSizeCache() : sizes(kMaxCachedStringSizes) {}
+
+  base::Lock lock;
+  base::MRUCache<std::string, SizeF> sizes;
+};
+
+base::LazyInstance<StringSizeCache>::Leaky g_string_size_cache =
+    LAZY_INSTANCE_INITIALIZER;
+
+// Returns the key of |text| in the StringSizeCache.
+std::string GetStringSizeCacheKey(const base::string16& text,
+                                  const FontList& font_list,
+                                  float width,
+                                  float height,
+                                  int flags) {
+  std::string key = base::StringPrintf(
+      "%s|%d|%a|%a|", font_list.GetFontDescriptionString().c_str(), flags,
+      width, height);
+  key.append(reinterpret_cast<const char*>(text.data()),
+             text.length() * sizeof(base::char16));
+  return key;
+}
+
 // Updates |render_text| from the specified parameters.
 void UpdateRenderText(const Rect& rect,
                       const base::string16& text,
@@ -205,14 +239,31 @@ void Canvas::SizeStringFloat(const base::string16& text,
       *width = font_list.GetExpectedTextWidth(adjusted_text.length());
       *height = font_list.GetHeight();
     } else {
+      StripAcceleratorChars(flags, &adjusted_text);
+      const std::string key = GetStringSizeCacheKey(
+          adjusted_text, font_list, *width, *height, flags);
+      StringSizeCache* cache = g_string_size_cache.Pointer();
+      {
+        base::AutoLock lock(cache->lock);
+        base::MRUCache<std::string, SizeF>::iterator it =
+            cache->sizes.Get(key);
+        if (it != cache->sizes.end()) {
+          *width = it->second.width();
+          *height = it->second.height();
+          return;
+        }
+      }
+
       scoped_ptr<RenderText> render_text(RenderText::CreateInstance());
       Rect rect(*width, *height);
-      StripAcceleratorChars(flags, &adjusted_text);
       UpdateRenderText(rect, adjusted_text, font_list, flags, 0,
                        render_text.get());
       const SizeF& string_size = render_text->GetStringSizeF();
       *width = string_size.width();
       *height = string_size.height();
+
+      base::AutoLock lock(cache->lock);
+      cache->sizes.Put(key, string_size);
     }
   }
 }
@@ -6,9 +6,11 @@
 
 #include <limits>
 
+#include "base/memory/scoped_ptr.h"
 #include "base/strings/utf_string_conversions.h"
 #include "testing/gtest/include/gtest/gtest.h"
 #include "ui/gfx/font_list.h"
+#include "ui/gfx/render_text.h"
 
 namespace gfx {
 
@@ -28,6 +30,29 @@ class CanvasTest : public testing::Test {
     return gfx::Size(width, height);
   }
 
+  // Measures |text| with Canvas::SizeStringFloat(), which may answer from its
+  // cache of single-line string sizes.
+  SizeF SizeStringFloat(const char* text,
+                        const FontList& font_list,
+                        float width,
+                        int flags) {
+    float height = 0;
+    Canvas::SizeStringFloat(base::UTF8ToUTF16(text), font_list, &width,
+                            &height, 0, flags);
+    return SizeF(width, height);
+  }
+
+  // Measures |text| with a new RenderText, bypassing the cache.
+  SizeF MeasureString(const char* text, const FontList& font_list) {
+    scoped_ptr<RenderText> render_text(RenderText::CreateInstance());
+    render_text->SetFontList(font_list);
+    render_text->SetText(base::UTF8ToUTF16(text));
+    render_text->SetCursorEnabled(false);
+    return render_text->GetStringSizeF();
+  }
+
+  const FontList& font_list() const { return font_list_; }
+
  private:
   FontList font_list_;
 };
@@ -60,4 +85,35 @@ TEST_F(CanvasTest, MAYBE_StringSizeWithLineHeight) {
   EXPECT_EQ(3 * 1000 + one_line_size.height(), four_line_size.height());
 }
 
+TEST_F(CanvasTest, StringSizeCacheHit) {
+  const SizeF fresh_size = MeasureString("Cached string", font_list());
+  const SizeF first_size = SizeStringFloat("Cached string", font_list(), 0, 0);
+  const SizeF cached_size = SizeStringFloat("Cached string", font_list(), 0, 0);
+  EXPECT_EQ(fresh_size.ToString(), first_size.ToString());
+  EXPECT_EQ(fresh_size.ToString(), cached_size.ToString());
+}
+
+// Measurements that differ only in their font, flags or bounds must not be
+// answered with each other's cached sizes.
+TEST_F(CanvasTest, StringSizeCacheKeys) {
+  const FontList large_font_list = font_list().DeriveWithSizeDelta(10);
+  const SizeF size = SizeStringFloat("&Open", font_list(), 0, 0);
+  const SizeF large_size = SizeStringFloat("&Open", large_font_list, 0, 0);
+  EXPECT_EQ(MeasureString("&Open", font_list()).ToString(), size.ToString());
+  EXPECT_EQ(MeasureString("&Open", large_font_list).ToString(),
+            large_size.ToString());
+  EXPECT_GT(large_size.width(), size.width());
+
+  // HIDE_PREFIX strips the accelerator before the string is measured.
+  const SizeF hidden_prefix_size =
+      SizeStringFloat("&Open", font_list(), 0, Canvas::HIDE_PREFIX);
+  EXPECT_EQ(MeasureString("Open", font_list()).ToString(),
+            hidden_prefix_size.ToString());
+  EXPECT_LT(hidden_prefix_size.width(), size.width());
+
+  // The bounds of a single line don't change its size.
+  EXPECT_EQ(size.ToString(),
+            SizeStringFloat("&Open", font_list(), 1000, 0).ToString());
+}
+
 }  // namespace gfx
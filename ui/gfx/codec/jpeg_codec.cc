@@ -6,6 +6,8 @@
 
 #include <setjmp.h>
 
+#include <algorithm>
+
 #include "base/logging.h"
 #include "base/memory/scoped_ptr.h"
 #include "third_party/skia/include/core/SkBitmap.h"
@@ -460,6 +462,16 @@ class DecompressDestroyer {
 bool JPEGCodec::Decode(const unsigned char* input, size_t input_size,
                        ColorFormat format, std::vector<unsigned char>* output,
                        int* w, int* h) {
+  return DecodeAtLeastSize(input, input_size, format, 0, 0, output, w, h);
+}
+
+// static
+bool JPEGCodec::DecodeAtLeastSize(const unsigned char* input,
+                                  size_t input_size,
+                                  ColorFormat format,
+                                  int min_width, int min_height,
+                                  std::vector<unsigned char>* output,
+                                  int* w, int* h) {
   jpeg_decompress_struct cinfo;
   DecompressDestroyer destroyer;
   destroyer.SetManagedObject(&cinfo);
@@ -542,6 +554,23 @@ bool JPEGCodec::Decode(const unsigned char* input, size_t input_size,
   cinfo.output_components = 3;
 #endif
 
+  // Pick the largest downscaling factor supported by the library that keeps
+  // the decoded image at least as large as requested. Scaled dimensions are
+  // rounded up, as jpeg_calc_output_dimensions() does. Without a minimum size
+  // the image is decoded at full size.
+  if (min_width > 0 || min_height > 0) {
+    for (unsigned int denom = 8; denom > 1; denom /= 2) {
+      if ((cinfo.image_width + denom - 1) / denom >=
+              static_cast<unsigned int>(std::max(min_width, 1)) &&
+          (cinfo.image_height + denom - 1) / denom >=
+              static_cast<unsigned int>(std::max(min_height, 1))) {
+        cinfo.scale_num = 1;
+        cinfo.scale_denom = denom;
+        break;
+      }
+    }
+  }
+
   jpeg_calc_output_dimensions(&cinfo);
   *w = cinfo.output_width;
   *h = cinfo.output_height;
@@ -613,9 +642,17 @@ bool JPEGCodec::Decode(const unsigned char* input, size_t input_size,
 
 // static
 SkBitmap* JPEGCodec::Decode(const unsigned char* input, size_t input_size) {
+  return DecodeAtLeastSize(input, input_size, 0, 0);
+}
+
+// static
+SkBitmap* JPEGCodec::DecodeAtLeastSize(const unsigned char* input,
+                                       size_t input_size,
+                                       int min_width, int min_height) {
   int w, h;
   std::vector<unsigned char> data_vector;
-  if (!Decode(input, input_size, FORMAT_SkBitmap, &data_vector, &w, &h))
+  if (!DecodeAtLeastSize(input, input_size, FORMAT_SkBitmap,
+                         min_width, min_height, &data_vector, &w, &h))
     return NULL;
 
   // Skia only handles 32 bit images.
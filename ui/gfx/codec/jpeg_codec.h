@@ -72,6 +72,21 @@ class GFX_EXPORT JPEGCodec {
   // successful, a SkBitmap is created and returned. It is up to the caller
   // to delete the returned bitmap.
   static SkBitmap* Decode(const unsigned char* input, size_t input_size);
+
+  // Same as Decode(), but lets the JPEG library scale the image down by 1/2,
+  // 1/4 or 1/8 while decoding it. The largest factor that keeps the image at
+  // least min_width x min_height is used, so callers that are going to shrink
+  // the image anyway never decode more pixels than they need. The image is
+  // never scaled up, and is decoded at full size if it is already smaller or
+  // if neither minimum is positive.
+  static bool DecodeAtLeastSize(const unsigned char* input, size_t input_size,
+                                ColorFormat format,
+                                int min_width, int min_height,
+                                std::vector<unsigned char>* output,
+                                int* w, int* h);
+  static SkBitmap* DecodeAtLeastSize(const unsigned char* input,
+                                     size_t input_size,
+                                     int min_width, int min_height);
 };
 
 }  // namespace gfx
@@ -164,6 +164,55 @@ TEST(JPEGCodec, EncodeDecodeRGBA) {
   ASSERT_GE(jpeg_equality_threshold, AveragePixelDelta(original, decoded));
 }
 
+TEST(JPEGCodec, DecodeAtLeastSize) {
+  int w = 80, h = 40;
+
+  std::vector<unsigned char> original;
+  MakeRGBImage(w, h, &original);
+  std::vector<unsigned char> encoded;
+  EXPECT_TRUE(JPEGCodec::Encode(&original[0], JPEGCodec::FORMAT_RGB, w, h,
+                                w * 3, jpeg_quality, &encoded));
+
+  // The largest scaling factor that keeps the requested size is used.
+  std::vector<unsigned char> decoded;
+  int outw, outh;
+  EXPECT_TRUE(JPEGCodec::DecodeAtLeastSize(&encoded[0], encoded.size(),
+                                           JPEGCodec::FORMAT_RGB, 20, 10,
+                                           &decoded, &outw, &outh));
+  EXPECT_EQ(20, outw);
+  EXPECT_EQ(10, outh);
+  EXPECT_EQ(20u * 10 * 3, decoded.size());
+
+  EXPECT_TRUE(JPEGCodec::DecodeAtLeastSize(&encoded[0], encoded.size(),
+                                           JPEGCodec::FORMAT_RGB, 21, 5,
+                                           &decoded, &outw, &outh));
+  EXPECT_EQ(40, outw);
+  EXPECT_EQ(20, outh);
+
+  // A minimum for only one dimension scales down as much as it allows.
+  EXPECT_TRUE(JPEGCodec::DecodeAtLeastSize(&encoded[0], encoded.size(),
+                                           JPEGCodec::FORMAT_RGBA, 0, 5,
+                                           &decoded, &outw, &outh));
+  EXPECT_EQ(10, outw);
+  EXPECT_EQ(5, outh);
+  EXPECT_EQ(10u * 5 * 4, decoded.size());
+
+  // Without a minimum size the image is decoded at full size, like Decode().
+  EXPECT_TRUE(JPEGCodec::DecodeAtLeastSize(&encoded[0], encoded.size(),
+                                           JPEGCodec::FORMAT_RGB, 0, 0,
+                                           &decoded, &outw, &outh));
+  EXPECT_EQ(w, outw);
+  EXPECT_EQ(h, outh);
+
+  // Images are never scaled up.
+  EXPECT_TRUE(JPEGCodec::DecodeAtLeastSize(&encoded[0], encoded.size(),
+                                           JPEGCodec::FORMAT_RGB, 100, 100,
+                                           &decoded, &outw, &outh));
+  EXPECT_EQ(w, outw);
+  EXPECT_EQ(h, outh);
+  ASSERT_GE(jpeg_equality_threshold, AveragePixelDelta(original, decoded));
+}
+
 // Test that corrupted data decompression causes failures.
 TEST(JPEGCodec, DecodeCorrupted) {
   int w = 20, h = 20;
@@ -671,6 +671,18 @@ void View::ConvertPointToTarget(const View* source,
   if (source == target)
     return;
 
+  // Converting between a view and one of its children is the common case,
+  // e.g. for every level of event targeting.  Apply the child's transform
+  // directly instead of going through the root of the hierarchy.
+  if (target->parent() == source) {
+    target->ConvertPointFromAncestor(source, point);
+    return;
+  }
+  if (source->parent() == target) {
+    source->ConvertPointForAncestor(target, point);
+    return;
+  }
+
   const View* root = GetHierarchyRoot(target);
   CHECK_EQ(GetHierarchyRoot(source), root);
 
@@ -690,6 +702,16 @@ void View::ConvertRectToTarget(const View* source,
   if (source == target)
     return;
 
+  // Same fast path as in ConvertPointToTarget().
+  if (target->parent() == source) {
+    target->ConvertRectFromAncestor(source, rect);
+    return;
+  }
+  if (source->parent() == target) {
+    source->ConvertRectForAncestor(target, rect);
+    return;
+  }
+
   const View* root = GetHierarchyRoot(target);
   CHECK_EQ(GetHierarchyRoot(source), root);
 
@@ -778,7 +800,8 @@ void View::SchedulePaintInRect(const gfx::Rect& rect) {
 void View::Paint(gfx::Canvas* canvas) {
   TRACE_EVENT1("views", "View::Paint", "class", GetClassName());
 
-  gfx::ScopedCanvas scoped_canvas(canvas);
+  if (!visible_)
+    return;
 
   // Paint this View and its children, setting the clip rect to the bounds
   // of this View and translating the origin to the local bounds' top left
@@ -791,6 +814,14 @@ void View::Paint(gfx::Canvas* canvas) {
   clip_rect.Inset(clip_insets_);
   if (parent_)
     clip_rect.set_x(parent_->GetMirroredXForRect(clip_rect));
+
+  // Most views are outside the area being repainted, e.g. the rest of the
+  // toolbar when only a throbber changed.  Skip them before saving the canvas
+  // state.
+  if (canvas->sk_canvas()->quickReject(gfx::RectToSkRect(clip_rect)))
+    return;
+
+  gfx::ScopedCanvas scoped_canvas(canvas);
   if (!canvas->ClipRect(clip_rect))
     return;
 
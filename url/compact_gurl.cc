@@ -0,0 +1,270 @@
+// Copyright 2014 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "url/compact_gurl.h"
+
+#include <string.h>
+
+#include <algorithm>
+
+#include "base/logging.h"
+#include "base/memory/scoped_ptr.h"
+
+namespace {
+
+const size_t kNumComponents = 8;
+
+// The components of url_parse::Parsed, in the order they're stored.
+url_parse::Component url_parse::Parsed::* const kComponents[kNumComponents] = {
+  &url_parse::Parsed::scheme,
+  &url_parse::Parsed::username,
+  &url_parse::Parsed::password,
+  &url_parse::Parsed::host,
+  &url_parse::Parsed::port,
+  &url_parse::Parsed::path,
+  &url_parse::Parsed::query,
+  &url_parse::Parsed::ref,
+};
+
+// Stored instead of the -1 length of invalid components. Specs and offsets
+// must be shorter than this to be stored as 16 bits.
+const uint16 kInvalidLength = 0xffff;
+
+bool FitsIn16Bits(const std::string& spec, const url_parse::Parsed& parsed) {
+  if (spec.length() >= kInvalidLength || parsed.inner_parsed())
+    return false;
+  for (size_t i = 0; i < kNumComponents; ++i) {
+    const url_parse::Component& component = parsed.*kComponents[i];
+    if (component.begin < 0 || component.begin >= kInvalidLength ||
+        component.len < -1 || component.len >= kInvalidLength) {
+      return false;
+    }
+  }
+  return true;
+}
+
+// Returns the length of the part of |spec| that's shared between the URLs of
+// a same origin: up to the port, the host or the scheme.
+size_t GetPrefixLength(const std::string& spec,
+                       const url_parse::Parsed& parsed) {
+  size_t length = 0;
+  if (parsed.port.is_valid())
+    length = parsed.port.end();
+  else if (parsed.host.is_valid())
+    length = parsed.host.end();
+  else if (parsed.scheme.is_valid())
+    length = parsed.scheme.end() + 1;  // Include the colon.
+  return std::min(length, spec.length());
+}
+
+}  // namespace
+
+class CompactGURL::Rep : public base::RefCountedThreadSafe<Rep> {
+ public:
+  // For URLs that fit in 16 bits. |prefix| can be NULL.
+  Rep(base::RefCountedString* prefix,
+      const base::StringPiece& suffix,
+      const url_parse::Parsed& parsed,
+      bool is_valid)
+      : prefix_(prefix),
+        suffix_(suffix.data(), suffix.size()),
+        is_valid_(is_valid) {
+    for (size_t i = 0; i < kNumComponents; ++i) {
+      const url_parse::Component& component = parsed.*kComponents[i];
+      components_[2 * i] = static_cast<uint16>(component.begin);
+      components_[2 * i + 1] = component.len < 0 ?
+          kInvalidLength : static_cast<uint16>(component.len);
+    }
+  }
+
+  // For the others.
+  explicit Rep(const GURL& url)
+      : is_valid_(url.is_valid()),
+        url_(new GURL(url)) {
+  }
+
+  GURL ToGURL() const {
+    if (url_)
+      return *url_;
+
+    url_parse::Parsed parsed;
+    for (size_t i = 0; i < kNumComponents; ++i) {
+      int len = components_[2 * i + 1] == kInvalidLength ?
+          -1 : components_[2 * i + 1];
+      parsed.*kComponents[i] = url_parse::Component(components_[2 * i], len);
+    }
+    std::string spec;
+    spec.reserve((prefix_ ? prefix_->data().size() : 0) + suffix_.size());
+    if (prefix_)
+      spec = prefix_->data();
+    spec.append(suffix_);
+    return GURL(spec, parsed, is_valid_);
+  }
+
+  void GetSpecPieces(base::StringPiece* prefix,
+                     base::StringPiece* suffix) const {
+    if (url_) {
+      prefix->clear();
+      *suffix = url_->possibly_invalid_spec();
+      return;
+    }
+    if (prefix_)
+      *prefix = prefix_->data();
+    else
+      prefix->clear();
+    *suffix = suffix_;
+  }
+
+  bool is_valid() const { return is_valid_; }
+
+ private:
+  friend class base::RefCountedThreadSafe<Rep>;
+
+  ~Rep() {}
+
+  scoped_refptr<base::RefCountedString> prefix_;
+  std::string suffix_;
+  // The begin and length of each of |kComponents|.
+  uint16 components_[2 * kNumComponents];
+  bool is_valid_;
+
+  // Set instead of the above for URLs that don't fit in 16 bits.
+  scoped_ptr<GURL> url_;
+
+  DISALLOW_COPY_AND_ASSIGN(Rep);
+};
+
+CompactGURL::PrefixTable::PrefixTable() {
+}
+
+CompactGURL::PrefixTable::~PrefixTable() {
+}
+
+void CompactGURL::PrefixTable::Purge() {
+  for (PrefixMap::iterator it = prefixes_.begin(); it != prefixes_.end();) {
+    if (it->second->HasOneRef())
+      prefixes_.erase(it++);
+    else
+      ++it;
+  }
+}
+
+base::RefCountedString* CompactGURL::PrefixTable::Intern(
+    const base::StringPiece& prefix) {
+  PrefixMap::const_iterator it = prefixes_.find(prefix);
+  if (it != prefixes_.end())
+    return it->second.get();
+
+  scoped_refptr<base::RefCountedString> shared(new base::RefCountedString);
+  prefix.CopyToString(&shared->data());
+  prefixes_[base::StringPiece(shared->data())] = shared;
+  return shared.get();
+}
+
+CompactGURL::CompactGURL() {
+}
+
+CompactGURL::CompactGURL(const GURL& url, PrefixTable* prefix_table) {
+  const std::string& spec = url.possibly_invalid_spec();
+  if (spec.empty() && !url.is_valid())
+    return;
+
+  const url_parse::Parsed& parsed = url.parsed_for_possibly_invalid_spec();
+  if (!FitsIn16Bits(spec, parsed)) {
+    rep_ = new Rep(url);
+    return;
+  }
+
+  base::StringPiece suffix(spec);
+  base::RefCountedString* prefix = NULL;
+  size_t prefix_length = GetPrefixLength(spec, parsed);
+  if (prefix_table && prefix_length) {
+    prefix = prefix_table->Intern(suffix.substr(0, prefix_length));
+    suffix.remove_prefix(prefix_length);
+  }
+  rep_ = new Rep(prefix, suffix, parsed, url.is_valid());
+}
+
+CompactGURL::CompactGURL(const CompactGURL& other) : rep_(other.rep_) {
+}
+
+CompactGURL::~CompactGURL() {
+}
+
+CompactGURL& CompactGURL::operator=(const CompactGURL& other) {
+  rep_ = other.rep_;
+  return *this;
+}
+
+GURL CompactGURL::ToGURL() const {
+  return rep_ ? rep_->ToGURL() : GURL();
+}
+
+std::string CompactGURL::spec() const {
+  base::StringPiece prefix, suffix;
+  GetSpecPieces(&prefix, &suffix);
+  std::string spec;
+  spec.reserve(prefix.size() + suffix.size());
+  prefix.AppendToString(&spec);
+  suffix.AppendToString(&spec);
+  return spec;
+}
+
+bool CompactGURL::is_valid() const {
+  return rep_ && rep_->is_valid();
+}
+
+bool CompactGURL::is_empty() const {
+  base::StringPiece prefix, suffix;
+  GetSpecPieces(&prefix, &suffix);
+  return prefix.empty() && suffix.empty();
+}
+
+bool CompactGURL::operator==(const CompactGURL& other) const {
+  return rep_ == other.rep_ || Compare(other) == 0;
+}
+
+bool CompactGURL::operator!=(const CompactGURL& other) const {
+  return !(*this == other);
+}
+
+bool CompactGURL::operator<(const CompactGURL& other) const {
+  return Compare(other) < 0;
+}
+
+void CompactGURL::GetSpecPieces(base::StringPiece* prefix,
+                                base::StringPiece* suffix) const {
+  if (rep_) {
+    rep_->GetSpecPieces(prefix, suffix);
+  } else {
+    prefix->clear();
+    suffix->clear();
+  }
+}
+
+int CompactGURL::Compare(const CompactGURL& other) const {
+  base::StringPiece pieces[2];
+  base::StringPiece other_pieces[2];
+  GetSpecPieces(&pieces[0], &pieces[1]);
+  other.GetSpecPieces(&other_pieces[0], &other_pieces[1]);
+
+  // Compare the concatenations of the pieces without building them.
+  size_t i = 0;
+  size_t j = 0;
+  for (;;) {
+    while (i < 2 && pieces[i].empty())
+      ++i;
+    while (j < 2 && other_pieces[j].empty())
+      ++j;
+    if (i == 2 || j == 2)
+      return (i == 2 ? 0 : 1) - (j == 2 ? 0 : 1);
+
+    size_t length = std::min(pieces[i].size(), other_pieces[j].size());
+    int result = memcmp(pieces[i].data(), other_pieces[j].data(), length);
+    if (result)
+      return result;
+    pieces[i].remove_prefix(length);
+    other_pieces[j].remove_prefix(length);
+  }
+}
@@ -0,0 +1,99 @@
+// Copyright 2014 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef URL_COMPACT_GURL_H_
+#define URL_COMPACT_GURL_H_
+
+#include <string>
+
+#include "base/basictypes.h"
+#include "base/containers/hash_tables.h"
+#include "base/memory/ref_counted.h"
+#include "base/memory/ref_counted_memory.h"
+#include "base/strings/string_piece.h"
+#include "url/gurl.h"
+#include "url/url_export.h"
+
+// CompactGURL holds the same information as a GURL in less memory, for the
+// large collections of URLs kept by history, bookmarks and the autocomplete
+// indexes. It is immutable and refcounted, so copying one only takes a
+// reference, and it can be shared across threads.
+//
+// The component offsets are stored as 16 bits, and the "scheme://host:port"
+// part of the spec can be shared with the other CompactGURLs made with the
+// same PrefixTable. URLs that don't fit (very long ones, and filesystem: URLs
+// which have an inner URL) are kept as a GURL, so any URL can be stored.
+//
+// Use ToGURL() to get a GURL back to work with; this doesn't canonicalize the
+// URL again.
+class URL_EXPORT CompactGURL {
+ public:
+  // PrefixTable shares the prefixes of the spec of the CompactGURLs made with
+  // it. It is not thread-safe, although the CompactGURLs made with it are, and
+  // they can outlive it.
+  class URL_EXPORT PrefixTable {
+   public:
+    PrefixTable();
+    ~PrefixTable();
+
+    // Drops the prefixes that no CompactGURL uses anymore.
+    void Purge();
+
+    // Returns the number of distinct prefixes in the table.
+    size_t size() const { return prefixes_.size(); }
+
+   private:
+    friend class CompactGURL;
+
+    // Returns the shared copy of |prefix|.
+    base::RefCountedString* Intern(const base::StringPiece& prefix);
+
+    // The keys point into the values.
+    typedef base::hash_map<base::StringPiece,
+                           scoped_refptr<base::RefCountedString> > PrefixMap;
+    PrefixMap prefixes_;
+
+    DISALLOW_COPY_AND_ASSIGN(PrefixTable);
+  };
+
+  // Creates an empty, invalid URL.
+  CompactGURL();
+
+  // Stores |url|, sharing its prefix through |prefix_table| if it isn't NULL.
+  CompactGURL(const GURL& url, PrefixTable* prefix_table);
+
+  CompactGURL(const CompactGURL& other);
+  ~CompactGURL();
+
+  CompactGURL& operator=(const CompactGURL& other);
+
+  // Returns the URL as a GURL.
+  GURL ToGURL() const;
+
+  // Returns the spec of the URL, as GURL::possibly_invalid_spec() would.
+  std::string spec() const;
+
+  bool is_valid() const;
+  bool is_empty() const;
+
+  // Compares the specs, as the corresponding GURL operators do.
+  bool operator==(const CompactGURL& other) const;
+  bool operator!=(const CompactGURL& other) const;
+  bool operator<(const CompactGURL& other) const;
+
+ private:
+  class Rep;
+
+  // Returns the spec as two pieces, which are to be concatenated.
+  void GetSpecPieces(base::StringPiece* prefix,
+                     base::StringPiece* suffix) const;
+
+  // Compares the specs like std::string::compare().
+  int Compare(const CompactGURL& other) const;
+
+  // NULL for empty URLs.
+  scoped_refptr<const Rep> rep_;
+};
+
+#endif  // URL_COMPACT_GURL_H_
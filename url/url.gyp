@@ -20,6 +20,8 @@
         '../third_party/icu/icu.gyp:icuuc',
       ],
       'sources': [
+        'compact_gurl.cc',
+        'compact_gurl.h',
         'gurl.cc',
         'gurl.h',
         'third_party/mozilla/url_parse.cc',
@@ -72,6 +74,7 @@
         'url_lib',
       ],
       'sources': [
+        'compact_gurl_unittest.cc',
         'gurl_unittest.cc',
         'url_canon_unittest.cc',
         'url_parse_unittest.cc',
@@ -336,6 +336,19 @@ void AppendInvalidNarrowString(const char* spec, int begin, int end,
 void AppendInvalidNarrowString(const base::char16* spec, int begin, int end,
                                CanonOutput* output);
 
+// Appends the substring |spec[begin, end)|, which must only contain 7-bit
+// characters, to the output unchanged. This is used to copy runs of characters
+// that need no canonicalization, which narrow input can copy all at once.
+inline void AppendASCIIRun(const char* spec, int begin, int end,
+                           CanonOutput* output) {
+  output->Append(&spec[begin], end - begin);
+}
+inline void AppendASCIIRun(const base::char16* spec, int begin, int end,
+                           CanonOutput* output) {
+  for (int i = begin; i < end; i++)
+    output->push_back(static_cast<char>(spec[i]));
+}
+
 // Misc canonicalization helpers ----------------------------------------------
 
 // Converts between UTF-8 and UTF-16, returning true on successful conversion.
@@ -75,6 +75,13 @@ const unsigned char kPathCharLookup[0x100] = {
      ESCAPE,  ESCAPE,  ESCAPE,  ESCAPE,  ESCAPE,  ESCAPE,  ESCAPE,  ESCAPE,  ESCAPE,  ESCAPE,  ESCAPE,  ESCAPE,  ESCAPE,  ESCAPE,  ESCAPE,  ESCAPE,
      ESCAPE,  ESCAPE,  ESCAPE,  ESCAPE,  ESCAPE,  ESCAPE,  ESCAPE,  ESCAPE,  ESCAPE,  ESCAPE,  ESCAPE,  ESCAPE,  ESCAPE,  ESCAPE,  ESCAPE,  ESCAPE};
 
+// Returns true if |uch| needs no special handling in DoPartialPath, and is just
+// copied to the output.
+template<typename UCHAR>
+inline bool IsPlainPathChar(UCHAR uch) {
+  return uch < 0x80 && !(kPathCharLookup[uch] & SPECIAL);
+}
+
 enum DotDisposition {
   // The given dot is just part of a filename and is not special.
   NOT_A_DIRECTORY,
@@ -285,8 +292,15 @@ bool DoPartialPath(const CHAR* spec,
           AppendEscapedChar(out_ch, output);
         }
       } else {
-        // Nothing special about this character, just append it.
-        output->push_back(out_ch);
+        // Nothing special about this character, append it along with the
+        // following characters that aren't special either (which is usually
+        // most of the path).
+        int run_end = i + 1;
+        while (run_end < end &&
+               IsPlainPathChar(static_cast<UCHAR>(spec[run_end])))
+          run_end++;
+        AppendASCIIRun(spec, i, run_end, output);
+        i = run_end - 1;
       }
     }
   }
@@ -59,10 +59,18 @@ template<typename CHAR>
 void AppendRaw8BitQueryString(const CHAR* source, int length,
                               CanonOutput* output) {
   for (int i = 0; i < length; i++) {
-    if (!IsQueryChar(static_cast<unsigned char>(source[i])))
+    if (!IsQueryChar(static_cast<unsigned char>(source[i]))) {
       AppendEscapedChar(static_cast<unsigned char>(source[i]), output);
-    else  // Doesn't need escaping.
-      output->push_back(static_cast<char>(source[i]));
+    } else {
+      // Doesn't need escaping, and neither do the following characters
+      // usually, so append the whole run at once.
+      int run_end = i + 1;
+      while (run_end < length &&
+             IsQueryChar(static_cast<unsigned char>(source[run_end])))
+        run_end++;
+      AppendASCIIRun(source, i, run_end, output);
+      i = run_end - 1;
+    }
   }
 }
 
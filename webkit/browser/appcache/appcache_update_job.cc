@@ -23,7 +23,9 @@
 namespace appcache {
 
 static const int kBufferSize = 32768;
-static const size_t kMaxConcurrentUrlFetches = 2;
+// Matches the network stack's default limit of connections per host, so a
+// large manifest served from one origin keeps all of them busy.
+static const size_t kMaxConcurrentUrlFetches = 6;
 static const int kMax503Retries = 3;
 
 static std::string FormatUrlErrorMessage(
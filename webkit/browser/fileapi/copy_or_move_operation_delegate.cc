@@ -351,8 +351,12 @@ class SnapshotCopyOrMoveImpl
   DISALLOW_COPY_AND_ASSIGN(SnapshotCopyOrMoveImpl);
 };
 
-// The size of buffer for StreamCopyHelper.
-const int kReadBufferSize = 32768;
+// The size of buffer for StreamCopyHelper. Each chunk costs a read and a
+// write round trip to the file threads, so large files are copied in chunks
+// big enough to keep the number of those round trips low. At most
+// kMaxInflightOperations copies (see RecursiveOperationDelegate) hold a
+// buffer at the same time.
+const int kReadBufferSize = 256 * 1024;
 
 // To avoid too many progress callbacks, it should be called less
 // frequently than 50ms.
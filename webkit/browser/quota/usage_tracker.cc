@@ -357,12 +357,13 @@ void ClientUsageTracker::UpdateUsageCache(
     if (!IsUsageCacheEnabledForOrigin(origin))
       return;
 
-    cached_usage_by_host_[host][origin] += delta;
+    int64* usage = &cached_usage_by_host_[host][origin];
+    *usage += delta;
     if (IsStorageUnlimited(origin))
       global_unlimited_usage_ += delta;
     else
       global_limited_usage_ += delta;
-    DCHECK_GE(cached_usage_by_host_[host][origin], 0);
+    DCHECK_GE(*usage, 0);
     DCHECK_GE(global_limited_usage_, 0);
     return;
   }
@@ -376,8 +377,13 @@ void ClientUsageTracker::GetCachedHostsUsage(
   DCHECK(host_usage);
   for (HostUsageMap::const_iterator host_iter = cached_usage_by_host_.begin();
        host_iter != cached_usage_by_host_.end(); host_iter++) {
-    const std::string& host = host_iter->first;
-    (*host_usage)[host] += GetCachedHostUsage(host);
+    const UsageMap& origin_map = host_iter->second;
+    int64 usage = 0;
+    for (UsageMap::const_iterator origin_iter = origin_map.begin();
+         origin_iter != origin_map.end(); origin_iter++) {
+      usage += origin_iter->second;
+    }
+    (*host_usage)[host_iter->first] += usage;
   }
 }
 